@@ -1,8 +1,11 @@
 #include <ATen/DLConvertor.h>
 #include <ATen/Functions.h>
+#include <ATen/TensorUtils.h>
 
+#include <atomic>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 using namespace std;
 namespace at {
@@ -180,6 +183,156 @@ DLManagedTensor* toDLPack(const Tensor& src) {
   return &(atDLMTensor->tensor);
 }
 
+// Note [Batched DLPack conversion]
+// toDLPack/fromDLPack pay one heap allocation per tensor for the manager
+// struct (resp. the std::function deleter context inside from_blob). For
+// workloads that convert hundreds of small tensors per request this
+// dominates the conversion cost, so the batched variants below share a
+// single arena per batch: the arena refcounts its live members and frees
+// itself when the last one's deleter runs. Ownership semantics per tensor
+// are unchanged - in particular each ingested DLManagedTensor's own deleter
+// still runs as soon as the tensor wrapping it dies.
+
+struct ATenDLMTensorBatch;
+
+struct ATenDLMTensorBatchMember {
+  Tensor handle;
+  ATenDLMTensorBatch* batch;
+  DLManagedTensor tensor;
+};
+
+struct ATenDLMTensorBatch {
+  std::vector<ATenDLMTensorBatchMember> members;
+  std::atomic<size_t> remaining;
+};
+
+static void batchDeleter(DLManagedTensor* arg) {
+  auto* member = static_cast<ATenDLMTensorBatchMember*>(arg->manager_ctx);
+  // release this member's tensor right away; only the arena itself waits
+  // for the rest of the batch
+  member->handle = Tensor();
+  auto* batch = member->batch;
+  if (batch->remaining.fetch_sub(1) == 1) {
+    delete batch;
+  }
+}
+
+std::vector<DLManagedTensor*> toDLPackBatch(TensorList srcs) {
+  std::vector<DLManagedTensor*> out;
+  out.reserve(srcs.size());
+  if (srcs.empty()) {
+    return out;
+  }
+  // validate before allocating so an unsupported dtype can't leak the arena
+  for (const Tensor& src : srcs) {
+    getDLDataType(src);
+  }
+  auto* batch = new ATenDLMTensorBatch;
+  batch->members.resize(srcs.size());
+  batch->remaining.store(srcs.size(), std::memory_order_relaxed);
+  for (size_t i = 0; i < srcs.size(); ++i) {
+    const Tensor& src = srcs[i];
+    ATenDLMTensorBatchMember& member = batch->members[i];
+    member.handle = src;
+    member.batch = batch;
+    member.tensor.manager_ctx = &member;
+    member.tensor.deleter = &batchDeleter;
+    member.tensor.dl_tensor.data = src.data_ptr();
+    int64_t device_id = 0;
+    if (src.is_cuda()) {
+      device_id = src.get_device();
+    }
+    member.tensor.dl_tensor.ctx = getDLContext(src, device_id);
+    member.tensor.dl_tensor.ndim = src.dim();
+    member.tensor.dl_tensor.dtype = getDLDataType(src);
+    member.tensor.dl_tensor.shape = const_cast<int64_t*>(src.sizes().data());
+    member.tensor.dl_tensor.strides =
+        const_cast<int64_t*>(src.strides().data());
+    member.tensor.dl_tensor.byte_offset = 0;
+    out.push_back(&member.tensor);
+  }
+  return out;
+}
+
+namespace {
+
+struct DLPackIngestBatch;
+
+struct DLPackIngestSlot {
+  const DLManagedTensor* src;
+  DLPackIngestBatch* batch;
+};
+
+struct DLPackIngestBatch {
+  std::vector<DLPackIngestSlot> slots;
+  std::atomic<size_t> remaining;
+};
+
+// DataPtr deleter for one ingested tensor: releases its DLPack source right
+// away and frees the shared arena once the whole batch is dead. Being a
+// plain function pointer, it needs no per-tensor closure allocation.
+void releaseIngestSlot(void* ptr) {
+  auto* slot = static_cast<DLPackIngestSlot*>(ptr);
+  if (slot->src->deleter) {
+    slot->src->deleter(const_cast<DLManagedTensor*>(slot->src));
+  }
+  auto* batch = slot->batch;
+  if (batch->remaining.fetch_sub(1) == 1) {
+    delete batch;
+  }
+}
+
+} // namespace
+
+std::vector<Tensor> fromDLPackBatch(ArrayRef<const DLManagedTensor*> srcs) {
+  std::vector<Tensor> out;
+  out.reserve(srcs.size());
+  if (srcs.empty()) {
+    return out;
+  }
+  // validate before allocating so an unsupported dtype or device can't
+  // leak the arena
+  for (const DLManagedTensor* src : srcs) {
+    getATenDevice(src->dl_tensor.ctx);
+    toScalarType(src->dl_tensor.dtype);
+  }
+  auto* batch = new DLPackIngestBatch;
+  batch->slots.resize(srcs.size());
+  batch->remaining.store(srcs.size(), std::memory_order_relaxed);
+  AutoNonVariableTypeMode guard;
+  for (size_t i = 0; i < srcs.size(); ++i) {
+    const DLManagedTensor* src = srcs[i];
+    batch->slots[i] = DLPackIngestSlot{src, batch};
+    Device device = getATenDevice(src->dl_tensor.ctx);
+    ScalarType stype = toScalarType(src->dl_tensor.dtype);
+    auto options = at::device(device).dtype(stype);
+    IntArrayRef sizes(src->dl_tensor.shape, src->dl_tensor.ndim);
+    std::vector<int64_t> default_strides;
+    IntArrayRef strides;
+    if (src->dl_tensor.strides) {
+      strides = IntArrayRef(src->dl_tensor.strides, src->dl_tensor.ndim);
+    } else {
+      default_strides = detail::defaultStrides(sizes);
+      strides = default_strides;
+    }
+    // same construction as from_blob, with a function-pointer DataPtr
+    // releasing into the shared arena instead of a per-tensor
+    // std::function context
+    auto data_device =
+        globalContext().getDeviceFromPtr(src->dl_tensor.data, device.type());
+    auto storage = Storage(
+        options.dtype(),
+        detail::computeStorageSize(sizes, strides),
+        DataPtr(
+            src->dl_tensor.data, &batch->slots[i], &releaseIngestSlot,
+            data_device),
+        /*allocator=*/nullptr,
+        /*resizable=*/false);
+    out.push_back(at::empty({0}, options).set_(storage, 0, sizes, strides));
+  }
+  return out;
+}
+
 Tensor fromDLPack(const DLManagedTensor* src) {
   Device device = getATenDevice(src->dl_tensor.ctx);
   ScalarType stype = toScalarType(src->dl_tensor.dtype);
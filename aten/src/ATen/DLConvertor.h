@@ -13,6 +13,16 @@ namespace at {
 CAFFE2_API ScalarType toScalarType(const DLDataType& dtype);
 CAFFE2_API DLManagedTensor* toDLPack(const Tensor& src);
 CAFFE2_API Tensor fromDLPack(const DLManagedTensor* src);
+
+// Batched variants for callers that convert many small tensors at once
+// (e.g. per-request feature ingestion). The per-tensor versions above pay a
+// heap allocation per manager struct / deleter context; the batched ones
+// allocate a single arena for the whole batch, released when the last
+// tensor (resp. DLManagedTensor) from the batch is freed. Each source's
+// own deleter still runs as soon as its tensor dies.
+CAFFE2_API std::vector<DLManagedTensor*> toDLPackBatch(TensorList srcs);
+CAFFE2_API std::vector<Tensor> fromDLPackBatch(
+    ArrayRef<const DLManagedTensor*> srcs);
 CAFFE2_API DLDataType getDLDataType(const Tensor& t);
 CAFFE2_API DLContext getDLContext(const Tensor& tensor, const int64_t& device_id);
 
@@ -2,12 +2,17 @@
 
 namespace at {
 
+namespace {
+
 // NOTE: are_expandable did a similar check, please keep them sync if change is needed
-std::vector<int64_t> infer_size(IntArrayRef a, IntArrayRef b) {
+// Templated on the result container so that hot callers can request a
+// DimVector and avoid the heap allocation of std::vector.
+template <typename Container>
+Container infer_size_impl(IntArrayRef a, IntArrayRef b) {
   size_t dimsA = a.size();
   size_t dimsB = b.size();
   size_t ndim = dimsA > dimsB ? dimsA : dimsB;
-  std::vector<int64_t> expandedSizes(ndim);
+  Container expandedSizes(ndim);
 
   // Use ptrdiff_t to ensure signed comparison.
   for (ptrdiff_t i = (ptrdiff_t)ndim - 1; i >= 0; --i) {
@@ -30,7 +35,8 @@ std::vector<int64_t> infer_size(IntArrayRef a, IntArrayRef b) {
   return expandedSizes;
 }
 
-std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
+template <typename Container>
+std::tuple<Container, Container> inferExpandGeometryImpl(
     IntArrayRef tensor_sizes,
     IntArrayRef tensor_strides,
     IntArrayRef sizes) {
@@ -38,12 +44,12 @@ std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
   int64_t tensor_dim = tensor_sizes.size();
 
   if (tensor_dim == 0) {
-    std::vector<int64_t> expandedStrides(ndim, 0);
-    return std::tuple<std::vector<int64_t>, std::vector<int64_t>>(
-        sizes.vec(), expandedStrides);
+    Container expandedStrides(ndim, 0);
+    return std::tuple<Container, Container>(
+        Container(sizes.begin(), sizes.end()), expandedStrides);
   }
-  std::vector<int64_t> expandedSizes(ndim);
-  std::vector<int64_t> expandedStrides(ndim);
+  Container expandedSizes(ndim);
+  Container expandedStrides(ndim);
 
   // create a new geometry for the tensors
   for (int64_t i = ndim - 1; i >= 0; --i) {
@@ -81,8 +87,34 @@ std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
     expandedSizes[i] = size;
     expandedStrides[i] = stride;
   }
-  return std::tuple<std::vector<int64_t>, std::vector<int64_t>>(
-      expandedSizes, expandedStrides);
+  return std::tuple<Container, Container>(
+      std::move(expandedSizes), std::move(expandedStrides));
+}
+
+} // namespace
+
+std::vector<int64_t> infer_size(IntArrayRef a, IntArrayRef b) {
+  return infer_size_impl<std::vector<int64_t>>(a, b);
+}
+
+DimVector infer_size_dimvector(IntArrayRef a, IntArrayRef b) {
+  return infer_size_impl<DimVector>(a, b);
+}
+
+std::tuple<std::vector<int64_t>, std::vector<int64_t>> inferExpandGeometry(
+    IntArrayRef tensor_sizes,
+    IntArrayRef tensor_strides,
+    IntArrayRef sizes) {
+  return inferExpandGeometryImpl<std::vector<int64_t>>(
+      tensor_sizes, tensor_strides, sizes);
+}
+
+std::tuple<DimVector, DimVector> inferExpandGeometry_dimvector(
+    IntArrayRef tensor_sizes,
+    IntArrayRef tensor_strides,
+    IntArrayRef sizes) {
+  return inferExpandGeometryImpl<DimVector>(
+      tensor_sizes, tensor_strides, sizes);
 }
 
 } // namespace at
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ATen/Tensor.h>
+#include <ATen/core/DimVector.h>
 #include <c10/util/Exception.h>
 
 #include <functional>
@@ -10,11 +11,21 @@
 namespace at {
 
 CAFFE2_API std::vector<int64_t> infer_size(IntArrayRef a, IntArrayRef b);
+// Variant of infer_size that avoids heap allocations for tensors with at
+// most kDimVectorStaticSize dimensions.
+CAFFE2_API DimVector infer_size_dimvector(IntArrayRef a, IntArrayRef b);
 CAFFE2_API std::tuple<std::vector<int64_t>, std::vector<int64_t>>
 inferExpandGeometry(
     IntArrayRef tensor_sizes,
     IntArrayRef tensor_strides,
     IntArrayRef sizes);
+// Variant of inferExpandGeometry that avoids heap allocations for tensors
+// with at most kDimVectorStaticSize dimensions; used on hot paths like
+// Tensor::expand.
+CAFFE2_API std::tuple<DimVector, DimVector> inferExpandGeometry_dimvector(
+    IntArrayRef tensor_sizes,
+    IntArrayRef tensor_strides,
+    IntArrayRef sizes);
 
 // True if input shapes are expandable
 // NOTE: infer_size did a similar check, please keep them sync if change is needed
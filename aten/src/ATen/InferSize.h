@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ATen/core/DimVector.h>
 #include <c10/core/ScalarType.h>
 #include <c10/util/Optional.h>
 #include <sstream>
@@ -9,8 +10,12 @@ namespace at {
 
 // Infers the size of a dim with size -1, if it exists. Also checks that new
 // shape is compatible with the number of elements.
-inline std::vector<int64_t> infer_size(IntArrayRef shape, int64_t numel) {
-  auto res = shape.vec();
+//
+// Templated on the result container so that hot callers (e.g. view) can
+// request a DimVector and avoid the heap allocation of std::vector.
+template <typename ResultVec>
+inline ResultVec infer_size_impl(IntArrayRef shape, int64_t numel) {
+  ResultVec res(shape.begin(), shape.end());
   int64_t newsize = 1;
   auto infer_dim = c10::optional<int64_t>();
   for (int64_t dim = 0, ndim = shape.size(); dim != ndim; dim++) {
@@ -49,4 +54,12 @@ inline std::vector<int64_t> infer_size(IntArrayRef shape, int64_t numel) {
   throw std::runtime_error(ss.str());
 }
 
+inline std::vector<int64_t> infer_size(IntArrayRef shape, int64_t numel) {
+  return infer_size_impl<std::vector<int64_t>>(shape, numel);
+}
+
+inline DimVector infer_size_dimvector(IntArrayRef shape, int64_t numel) {
+  return infer_size_impl<DimVector>(shape, numel);
+}
+
 }
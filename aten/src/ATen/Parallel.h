@@ -2,6 +2,12 @@
 #include <ATen/ATen.h>
 #include <ATen/core/ivalue.h>
 
+#include <cstdint>
+
+namespace c10 {
+enum class TaskPriority : uint8_t;
+}
+
 namespace at {
 namespace internal {
 // This parameter is heuristically chosen to determine the minimum number of
@@ -10,6 +16,39 @@ namespace internal {
 // no parallel algorithm (such as parallel_reduce) should split work into
 // smaller than GRAIN_SIZE chunks.
 constexpr int64_t GRAIN_SIZE = 32768;
+
+// Partial results written concurrently by reduction workers are laid out
+// this many bytes apart so that no two workers store into the same cache
+// line.
+constexpr int64_t CACHE_LINE_SIZE = 64;
+
+// Number of scalar_t elements spanning at least one cache line; used as
+// the slot stride for parallel_reduce's partial-result buffer.
+template <typename scalar_t>
+constexpr int64_t reduce_partial_stride() {
+  return (CACHE_LINE_SIZE + sizeof(scalar_t) - 1) / sizeof(scalar_t);
+}
+
+// Folds `n` partial results, laid out `stride` elements apart, with a
+// pairwise tree: neighbours first, then neighbouring pairs, and so on.
+// For a big fp32 sum this keeps the round-off growth of the combine at
+// O(log n) - matching the cascade summation the vectorized reduction
+// kernels use within a chunk - where a serial left fold grows as O(n),
+// and it stops the combine from scaling linearly with the chunk count.
+template <typename scalar_t, typename SF>
+inline scalar_t tree_combine(
+    scalar_t* partials,
+    int64_t n,
+    int64_t stride,
+    const SF& sf) {
+  for (int64_t gap = 1; gap < n; gap *= 2) {
+    for (int64_t i = 0; i + gap < n; i += 2 * gap) {
+      partials[i * stride] =
+          sf(partials[i * stride], partials[(i + gap) * stride]);
+    }
+  }
+  return partials[0];
+}
 } // namespace internal
 
 inline int64_t divup(int64_t x, int64_t y) {
@@ -25,6 +64,10 @@ CAFFE2_API void set_num_threads(int);
 // Returns the maximum number of threads that may be used in a parallel region
 CAFFE2_API int get_num_threads();
 
+// Returns the calling thread's intra-op thread budget (see
+// ThreadBudgetGuard), or 0 when unrestricted
+CAFFE2_API int get_thread_budget();
+
 // Returns the current thread number (starting from 0)
 // in the current parallel region, or 0 in the sequential region
 CAFFE2_API int get_thread_num();
@@ -32,6 +75,30 @@ CAFFE2_API int get_thread_num();
 // Checks whether the code runs in parallel region
 CAFFE2_API bool in_parallel_region();
 
+// Thread-local, nestable cap on the number of threads that parallel_for and
+// parallel_reduce may fan out to from the current thread. Unlike
+// set_num_threads, which sizes the shared pool once and for the whole
+// process, the guard only narrows how work submitted by this thread is
+// partitioned, so concurrent callers with different budgets do not fight
+// over a global setting: a latency-critical request can run under a budget
+// of 1-2 while a batch job on another thread fans out to the whole pool.
+// Nested guards narrow the budget further (the effective budget is the
+// minimum of the enclosing ones). When ATen is built with MKL, the budget
+// is also applied to MKL calls made while the guard is alive, via
+// mkl_set_num_threads_local().
+class CAFFE2_API ThreadBudgetGuard {
+ public:
+  explicit ThreadBudgetGuard(int budget);
+  ~ThreadBudgetGuard();
+
+  ThreadBudgetGuard(const ThreadBudgetGuard&) = delete;
+  ThreadBudgetGuard& operator=(const ThreadBudgetGuard&) = delete;
+
+ private:
+  int prev_budget_;
+  int prev_mkl_local_ = 0;
+};
+
 /*
 parallel_for
 
@@ -115,6 +182,14 @@ CAFFE2_API int get_num_interop_threads();
 // Launches inter-op parallel task
 CAFFE2_API void launch(std::function<void()> func);
 
+// Launches inter-op parallel task at the given priority; higher tiers are
+// drained first, so background work cannot delay latency-critical tasks
+CAFFE2_API void launch(std::function<void()> func, c10::TaskPriority priority);
+
+// Returns the number of inter-op tasks queued at the given priority but not
+// yet picked up by a worker thread
+CAFFE2_API size_t launch_queue_depth(c10::TaskPriority priority);
+
 // Launches intra-op parallel task
 CAFFE2_API void intraop_launch(std::function<void()> func);
 
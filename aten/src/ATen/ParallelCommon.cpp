@@ -40,8 +40,35 @@ size_t get_env_num_threads(const char* var_name, size_t def_value = 0) {
   return def_value;
 }
 
+// intra-op thread budget of the current thread (see ThreadBudgetGuard);
+// 0 means unrestricted
+thread_local int thread_budget_ = 0;
+
 } // namespace
 
+int get_thread_budget() {
+  return thread_budget_;
+}
+
+ThreadBudgetGuard::ThreadBudgetGuard(int budget)
+    : prev_budget_(thread_budget_) {
+  TORCH_CHECK(budget > 0, "Expected positive thread budget, got ", budget);
+  thread_budget_ =
+      prev_budget_ > 0 ? std::min(prev_budget_, budget) : budget;
+#ifdef TH_BLAS_MKL
+  prev_mkl_local_ = mkl_set_num_threads_local(thread_budget_);
+#endif
+}
+
+ThreadBudgetGuard::~ThreadBudgetGuard() {
+#ifdef TH_BLAS_MKL
+  mkl_set_num_threads_local(prev_mkl_local_);
+#else
+  (void)prev_mkl_local_;
+#endif
+  thread_budget_ = prev_budget_;
+}
+
 std::string get_parallel_info() {
   std::ostringstream ss;
 
@@ -4,12 +4,19 @@
 
 #ifndef C10_MOBILE
 #include <c10/core/thread_pool.h>
+#include <c10/util/numa.h>
+#include <c10/util/thread_affinity.h>
 #else
 #include <caffe2/utils/threadpool/ThreadPool.h>
 #include <caffe2/utils/threadpool/ThreadPoolMobile.h>
 #endif // C10_MOBILE
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -65,13 +72,182 @@ int _num_pool_threads(int nthreads) {
   return nthreads - 1;
 }
 
+bool _use_numa_binding() {
+  const auto* value = std::getenv("ATEN_NATIVE_NUMA_BIND");
+  return value && std::string(value) != "0" && c10::IsNUMAEnabled();
+}
+
+// Note [Work-stealing intra-op scheduler]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The default intra-op pool funnels every task through a single queue
+// protected by one mutex. With many small concurrent parallel_for regions
+// (e.g. one per server request thread) that lock becomes the bottleneck on
+// high core counts. WorkStealingTaskPool keeps a deque per worker: a worker
+// pops from the back of its own deque and only touches other deques (from
+// the front) when its own is empty. External submitters distribute tasks
+// round-robin. Each deque has its own mutex, so there is no central lock on
+// the hot path. The mode is selected at pool creation time (i.e. before any
+// parallel work, typically at at::init_num_threads()) with the environment
+// variable ATEN_NATIVE_WORK_STEALING=1.
+//
+// On NUMA machines, setting ATEN_NATIVE_NUMA_BIND=1 additionally binds
+// workers to NUMA nodes in contiguous blocks (workers [0, n/k) to node 0,
+// and so on). Because external submitters fill deques round-robin,
+// consecutive chunks of a parallel_for range land on consecutive workers
+// and hence mostly on one node; with the default first-touch allocation
+// policy (see NUMAPlacementPolicy in c10/core/CPUAllocator.h) the pages a
+// worker touches are local to its node. Stealing then prefers same-node
+// victims so a queued chunk stays on the node its data lives on.
+class WorkStealingTaskPool : public TaskThreadPoolBase {
+ public:
+  explicit WorkStealingTaskPool(int pool_size)
+      : deques_(pool_size), worker_node_(pool_size, -1) {
+    for (auto& deque : deques_) {
+      deque = std::make_unique<TaskDeque>();
+    }
+    const int num_nodes = _use_numa_binding() ? c10::GetNumNUMANodes() : -1;
+    threads_.reserve(pool_size);
+    for (int i = 0; i < pool_size; ++i) {
+      if (num_nodes > 1) {
+        worker_node_[i] = (int)(((int64_t)i * num_nodes) / pool_size);
+      }
+      threads_.emplace_back([this, i]() {
+        c10::setThreadName("pt_native_steal");
+        c10::NUMABind(worker_node_[i]);
+        c10::ApplyThreadAffinity();
+        current_pool_ = this;
+        worker_loop(i);
+      });
+    }
+  }
+
+  ~WorkStealingTaskPool() override {
+    running_ = false;
+    {
+      std::lock_guard<std::mutex> lock(idle_mutex_);
+      idle_cv_.notify_all();
+    }
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void run(const std::function<void()>& func) override {
+    if (deques_.empty()) {
+      func();
+      return;
+    }
+    size_t queue_idx = next_queue_++ % deques_.size();
+    {
+      std::lock_guard<std::mutex> lock(deques_[queue_idx]->mutex);
+      deques_[queue_idx]->tasks.push_back(func);
+    }
+    num_pending_++;
+    if (num_idle_.load() > 0) {
+      std::lock_guard<std::mutex> lock(idle_mutex_);
+      idle_cv_.notify_one();
+    }
+  }
+
+  size_t size() const override {
+    return threads_.size();
+  }
+
+  size_t numAvailable() const override {
+    return num_idle_.load();
+  }
+
+  bool inThreadPool() const override {
+    return current_pool_ == this;
+  }
+
+ private:
+  struct TaskDeque {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  bool try_pop(size_t worker_id, std::function<void()>& task) {
+    // own deque first (LIFO for locality), then steal FIFO from the others;
+    // with NUMA binding, same-node victims are tried before remote ones
+    {
+      auto& own = *deques_[worker_id];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+    const int own_node = worker_node_[worker_id];
+    for (int pass = 0; pass < (own_node >= 0 ? 2 : 1); ++pass) {
+      for (size_t i = 1; i < deques_.size(); ++i) {
+        size_t victim_id = (worker_id + i) % deques_.size();
+        if (own_node >= 0 &&
+            (worker_node_[victim_id] == own_node) != (pass == 0)) {
+          continue;
+        }
+        auto& victim = *deques_[victim_id];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+          task = std::move(victim.tasks.front());
+          victim.tasks.pop_front();
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  void worker_loop(size_t worker_id) {
+    while (running_) {
+      std::function<void()> task;
+      if (try_pop(worker_id, task)) {
+        num_pending_--;
+        task();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(idle_mutex_);
+      num_idle_++;
+      idle_cv_.wait(lock, [this]() {
+        return !running_ || num_pending_.load() > 0;
+      });
+      num_idle_--;
+    }
+  }
+
+  std::vector<std::unique_ptr<TaskDeque>> deques_;
+  // NUMA node each worker is bound to, or -1 when binding is disabled
+  std::vector<int> worker_node_;
+  std::vector<std::thread> threads_;
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+  std::atomic<size_t> next_queue_{0};
+  std::atomic<int64_t> num_pending_{0};
+  std::atomic<int64_t> num_idle_{0};
+  std::atomic<bool> running_{true};
+
+  // identifies the pool owning the current thread, for inThreadPool()
+  static thread_local WorkStealingTaskPool* current_pool_;
+};
+
+thread_local WorkStealingTaskPool* WorkStealingTaskPool::current_pool_ = nullptr;
+
+bool _use_work_stealing_pool() {
+  const auto* value = std::getenv("ATEN_NATIVE_WORK_STEALING");
+  return value && std::string(value) != "0";
+}
+
 TaskThreadPoolBase& _get_intraop_pool() {
   static std::shared_ptr<TaskThreadPoolBase> pool =
-      ThreadPoolRegistry()->Create(
-          "C10",
-          /* device_id */ 0,
-          /* pool_size */ _num_pool_threads(num_intraop_threads.exchange(CONSUMED)),
-          /* create_new */ true); // create a separate thread pool for intra-op
+      _use_work_stealing_pool()
+          ? std::make_shared<WorkStealingTaskPool>(
+                _num_pool_threads(num_intraop_threads.exchange(CONSUMED)))
+          : ThreadPoolRegistry()->Create(
+                "C10",
+                /* device_id */ 0,
+                /* pool_size */ _num_pool_threads(num_intraop_threads.exchange(CONSUMED)),
+                /* create_new */ true); // create a separate thread pool for intra-op
   return *pool;
 }
 
@@ -14,8 +14,14 @@ inline std::tuple<size_t, size_t> calc_num_tasks_and_chunk_size(
   if ((end - begin) < grain_size) {
     return std::make_tuple(1, std::max((int64_t)0, end - begin));
   }
-  // Choose number of tasks based on grain size and number of threads.
-  size_t chunk_size = divup((end - begin), get_num_threads());
+  // Choose number of tasks based on grain size and number of threads,
+  // capped by the submitting thread's budget (if any).
+  int num_threads = get_num_threads();
+  const int budget = get_thread_budget();
+  if (budget > 0) {
+    num_threads = std::min(num_threads, budget);
+  }
+  size_t chunk_size = divup((end - begin), num_threads);
   // Make sure each task is at least grain_size size.
   chunk_size = std::max((size_t)grain_size, chunk_size);
   size_t num_tasks = divup((end - begin), chunk_size);
@@ -72,21 +78,21 @@ inline scalar_t parallel_reduce(
   size_t num_tasks, chunk_size;
   std::tie(num_tasks, chunk_size) =
       internal::calc_num_tasks_and_chunk_size(begin, end, grain_size);
-  std::vector<scalar_t> results(num_tasks);
+  // one partial per cache line, so the workers' stores don't false-share
+  const int64_t stride = internal::reduce_partial_stride<scalar_t>();
+  std::vector<scalar_t> results(num_tasks * stride);
   scalar_t* results_data = results.data();
   internal::_parallel_run(
       begin,
       end,
       grain_size,
-      [f, ident, results_data](int64_t start, int64_t end, size_t task_id) {
-        results_data[task_id] = f(start, end, ident);
+      [f, ident, results_data, stride](
+          int64_t start, int64_t end, size_t task_id) {
+        results_data[task_id * stride] = f(start, end, ident);
       }
   );
-  scalar_t result = ident;
-  for (auto partial_result : results) {
-    result = sf(result, partial_result);
-  }
-  return result;
+  return internal::tree_combine(
+      results_data, static_cast<int64_t>(num_tasks), stride, sf);
 }
 
 } // namespace at
@@ -25,13 +25,20 @@ inline void parallel_for(
   if (begin >= end) {
     return;
   }
-  if ((end - begin) < grain_size || get_num_threads() == 1) {
+  if ((end - begin) < grain_size || get_num_threads() == 1 ||
+      get_thread_budget() == 1) {
     f(begin, end);
     return;
   }
 
-  // Choose number of tasks based on grain size and number of threads.
-  int64_t chunk_size = divup((end - begin), get_num_threads());
+  // Choose number of tasks based on grain size and number of threads,
+  // capped by the submitting thread's budget (if any).
+  int64_t num_threads = get_num_threads();
+  const int64_t budget = get_thread_budget();
+  if (budget > 0) {
+    num_threads = std::min(num_threads, budget);
+  }
+  int64_t chunk_size = divup((end - begin), num_threads);
   // Make sure each task is at least grain_size size.
   chunk_size = std::max(grain_size, chunk_size);
 
@@ -64,12 +71,19 @@ inline scalar_t parallel_reduce(
   if (begin >= end) {
     return ident;
   }
-  if ((end - begin) < grain_size || get_num_threads() == 1) {
+  if ((end - begin) < grain_size || get_num_threads() == 1 ||
+      get_thread_budget() == 1) {
     return f(begin, end, ident);
   }
 
-  // Choose number of tasks based on grain size and number of threads.
-  int64_t chunk_size = divup((end - begin), get_num_threads());
+  // Choose number of tasks based on grain size and number of threads,
+  // capped by the submitting thread's budget (if any).
+  int64_t num_threads = get_num_threads();
+  const int64_t budget = get_thread_budget();
+  if (budget > 0) {
+    num_threads = std::min(num_threads, budget);
+  }
+  int64_t chunk_size = divup((end - begin), num_threads);
   // Make sure each task is at least grain_size size.
   chunk_size = std::max(grain_size, chunk_size);
 
@@ -25,12 +25,18 @@ inline void parallel_for(
 #ifdef _OPENMP
   std::atomic_flag err_flag = ATOMIC_FLAG_INIT;
   std::exception_ptr eptr;
+  // Read the budget before the region: the workers' thread-local state is
+  // their own. Threads beyond the cap fall out via the begin_tid check.
+  const int64_t budget = get_thread_budget();
 
-#pragma omp parallel if (!omp_in_parallel() && ((end - begin) > grain_size))
+#pragma omp parallel if (!omp_in_parallel() && budget != 1 && ((end - begin) > grain_size))
   {
     // choose number of tasks based on grain size and number of threads
     // can't use num_threads clause due to bugs in GOMP's thread pool (See #32008)
     int64_t num_threads = omp_get_num_threads();
+    if (budget > 0) {
+      num_threads = std::min(num_threads, budget);
+    }
     if (grain_size > 0) {
       num_threads = std::min(num_threads, divup((end - begin), grain_size));
     }
@@ -67,11 +73,14 @@ inline scalar_t parallel_reduce(
   TORCH_CHECK(grain_size >= 0);
   if (begin >= end) {
     return ident;
-  } else if (in_parallel_region() || get_num_threads() == 1) {
+  } else if (in_parallel_region() || get_num_threads() == 1 ||
+             get_thread_budget() == 1) {
     return f(begin, end, ident);
   } else {
     const int64_t num_results = divup((end - begin), grain_size);
-    std::vector<scalar_t> results(num_results);
+    // one partial per cache line, so the workers' stores don't false-share
+    const int64_t stride = internal::reduce_partial_stride<scalar_t>();
+    std::vector<scalar_t> results(num_results * stride);
     scalar_t* results_data = results.data();
     std::atomic_flag err_flag = ATOMIC_FLAG_INIT;
     std::exception_ptr eptr;
@@ -79,7 +88,8 @@ inline scalar_t parallel_reduce(
     for (int64_t id = 0; id < num_results; id++) {
       int64_t i = begin + id * grain_size;
       try {
-        results_data[id] = f(i, i + std::min(end - i, grain_size), ident);
+        results_data[id * stride] =
+            f(i, i + std::min(end - i, grain_size), ident);
       } catch (...) {
         if (!err_flag.test_and_set()) {
           eptr = std::current_exception();
@@ -89,11 +99,7 @@ inline scalar_t parallel_reduce(
     if (eptr) {
       std::rethrow_exception(eptr);
     }
-    scalar_t result = ident;
-    for (auto partial_result : results) {
-      result = sf(result, partial_result);
-    }
-    return result;
+    return internal::tree_combine(results_data, num_results, stride, sf);
   }
 }
 
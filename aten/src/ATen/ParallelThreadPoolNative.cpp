@@ -68,6 +68,10 @@ int get_num_interop_threads() {
 }
 
 void launch(std::function<void()> func) {
+  launch(std::move(func), c10::TaskPriority::DEFAULT);
+}
+
+void launch(std::function<void()> func, c10::TaskPriority priority) {
   auto fn = std::bind([](
     std::function<void()> f, std::shared_ptr<ThreadLocalDebugInfoBase> info) {
       DebugInfoGuard guard(std::move(info));
@@ -78,9 +82,19 @@ void launch(std::function<void()> func) {
   );
 
 #if AT_EXPERIMENTAL_SINGLE_THREAD_POOL
+  // the intra-op pool has no priority tiers; fall back to FIFO ordering
+  (void)priority;
   intraop_launch(fn);
 #else
-  get_pool().run(fn);
+  get_pool().run(fn, priority);
+#endif
+}
+
+size_t launch_queue_depth(c10::TaskPriority priority) {
+#if AT_EXPERIMENTAL_SINGLE_THREAD_POOL
+  return 0;
+#else
+  return get_pool().queueDepth(priority);
 #endif
 }
 
@@ -109,6 +109,7 @@ void SparseTensorImpl::set_indices_and_values_unsafe(const Tensor& indices, cons
 
   indices_ = indices;
   values_ = values;
+  invalidate_csr_indices();
   AT_ASSERT(device() == values_.device());
   AT_ASSERT(values_.device() == indices_.device());
 
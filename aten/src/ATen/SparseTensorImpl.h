@@ -29,6 +29,13 @@ struct CAFFE2_API SparseTensorImpl : public TensorImpl {
   // because many algorithms proceed by merging two sorted lists (of indices).
   bool coalesced_ = false;
 
+  // Lazily computed CSR row pointers (shape: (size(0) + 1,)) for the first
+  // sparse dimension of a 2-dim coalesced tensor, so repeated spmm against
+  // the same sparse tensor (e.g. GNN adjacency matrices) converts only once.
+  // Undefined when not computed yet; invalidated whenever indices_ or the
+  // sparse sizes change.
+  Tensor csr_indices_;
+
 public:
   // Public for now...
   explicit SparseTensorImpl(at::DispatchKeySet, const caffe2::TypeMeta&);
@@ -40,6 +47,12 @@ public:
   Tensor indices() const { return indices_; }
   Tensor values() const { return values_; }
 
+  // Cached CSR row pointers; undefined if none have been computed since the
+  // indices last changed.
+  Tensor csr_indices() const { return csr_indices_; }
+  void set_csr_indices(const Tensor& csr) { csr_indices_ = csr; }
+  void invalidate_csr_indices() { csr_indices_ = Tensor(); }
+
   IntArrayRef strides() const override;
   bool is_contiguous(at::MemoryFormat memory_format=at::MemoryFormat::Contiguous) const override;
   int64_t stride(int64_t d) const override;
@@ -59,6 +72,7 @@ public:
     sizes_ = size.vec();
     sparse_dim_ = sparse_dim;
     dense_dim_ = dense_dim;
+    invalidate_csr_indices();
     refresh_numel();
   }
 
@@ -138,6 +152,7 @@ public:
     sizes_ = size.vec();
     sparse_dim_ = sparse_dim;
     dense_dim_ = dense_dim;
+    invalidate_csr_indices();
     refresh_numel();
   }
 
@@ -170,6 +185,7 @@ public:
     AT_ASSERT(new_nnz <= nnz());
     indices_ = indices_.narrow(1, 0, new_nnz);
     values_ = values_.narrow(0, 0, new_nnz);
+    invalidate_csr_indices();
   }
 
   // Takes indices and values and directly puts them into the sparse tensor, no copy.
@@ -238,6 +254,8 @@ private:
     dest_sparse_impl->indices_ = src_sparse_impl->indices();
     dest_sparse_impl->values_ = src_sparse_impl->values();
     dest_sparse_impl->coalesced_ = src_sparse_impl->coalesced();
+    // shallow copies share indices_, so the cached CSR form stays valid
+    dest_sparse_impl->csr_indices_ = src_sparse_impl->csr_indices();
   }
 };
 
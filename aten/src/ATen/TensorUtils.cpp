@@ -311,6 +311,8 @@ int64_t computeStorageSize(IntArrayRef sizes, IntArrayRef strides) {
   return size;
 }
 
+namespace {
+
 // On a high level,
 // 1. separate `oldshape` into chunks of dimensions, where the dimensions are
 //    ``contiguous'' in each chunk, i.e., oldstride[i] = oldshape[i+1] *
@@ -319,12 +321,16 @@ int64_t computeStorageSize(IntArrayRef sizes, IntArrayRef strides) {
 //    `oldshape` was separated into, where each chunk of newshape has matching
 //    ``numel'', i.e., number of subspaces, as the corresponding chunk of
 //    `oldshape`.
-c10::optional<std::vector<int64_t>> computeStride(
+//
+// Templated on the result container so that the view hot path can use a
+// DimVector and avoid heap allocations (see computeStride_dimvector).
+template <typename ResultVec>
+c10::optional<ResultVec> computeStride_impl(
     IntArrayRef oldshape,
     IntArrayRef oldstride,
     IntArrayRef newshape) {
   if (oldshape.empty()) {
-    return std::vector<int64_t>(newshape.size(), 1);
+    return ResultVec(newshape.size(), 1);
   }
 
   // NOTE: stride is arbitrary in the numel() == 0 case;
@@ -335,10 +341,10 @@ c10::optional<std::vector<int64_t>> computeStride(
   int64_t numel = std::accumulate(oldshape.begin(), oldshape.end(), 1,
                                   std::multiplies<int64_t>());
   if (numel == 0 && oldshape.equals(newshape)) {
-    return oldstride.vec();
+    return ResultVec(oldstride.begin(), oldstride.end());
   }
 
-  std::vector<int64_t> newstride(newshape.size());
+  ResultVec newstride(newshape.size());
   if (numel == 0) {
     for (int64_t view_d = newshape.size() - 1; view_d >= 0; view_d--) {
       if (view_d == (int64_t)(newshape.size() - 1)) {
@@ -385,5 +391,21 @@ c10::optional<std::vector<int64_t>> computeStride(
   return newstride;
 }
 
+} // namespace
+
+c10::optional<std::vector<int64_t>> computeStride(
+    IntArrayRef oldshape,
+    IntArrayRef oldstride,
+    IntArrayRef newshape) {
+  return computeStride_impl<std::vector<int64_t>>(oldshape, oldstride, newshape);
+}
+
+c10::optional<DimVector> computeStride_dimvector(
+    IntArrayRef oldshape,
+    IntArrayRef oldstride,
+    IntArrayRef newshape) {
+  return computeStride_impl<DimVector>(oldshape, oldstride, newshape);
+}
+
 }  // namespace detail
 }  // namespace at
@@ -3,6 +3,7 @@
 #include <ATen/Tensor.h>
 #include <ATen/TensorGeometry.h>
 #include <ATen/Utils.h>
+#include <ATen/core/DimVector.h>
 
 // These functions are NOT in Utils.h, because this file has a dep on Tensor.h
 
@@ -149,5 +150,11 @@ CAFFE2_API c10::optional<std::vector<int64_t>> computeStride(
     IntArrayRef oldshape,
     IntArrayRef oldstride,
     IntArrayRef newshape);
+// Variant of computeStride that avoids heap allocations for tensors with at
+// most kDimVectorStaticSize dimensions; used on the view hot path.
+CAFFE2_API c10::optional<DimVector> computeStride_dimvector(
+    IntArrayRef oldshape,
+    IntArrayRef oldstride,
+    IntArrayRef newshape);
 } // namespace detail
 } // namespace at
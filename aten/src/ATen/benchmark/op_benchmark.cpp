@@ -0,0 +1,415 @@
+// Per-layer operator microbenchmarks.
+//
+// The Python suite under benchmarks/operator_benchmark measures end to end
+// latency through the Python bindings, which hides where the time goes. The
+// benchmarks in this file call a set of frequently used operators at each
+// layer of the C++ stack so that per-layer overhead regressions show up in
+// isolation:
+//
+//  - Kernel:  the DispatchStub invoked directly on a prebuilt TensorIterator.
+//             No dispatch, no iterator construction, no output allocation;
+//             this is the floor the other layers are compared against.
+//  - Unboxed: the public at:: function, i.e. a regular unboxed trip through
+//             the dispatcher, including output allocation.
+//  - Boxed:   the boxed calling path via the JIT operator registry, as taken
+//             by the interpreter and by boxed fallbacks. Operator lookup is
+//             hoisted out of the timed loop; only the per-call cost (stack
+//             manipulation plus the boxed kernel) is measured.
+//
+// The Python binding layer itself remains covered by the Python suite.
+// Tensors are deliberately tiny so that per-call overhead dominates over
+// actual compute.
+
+#include <benchmark/benchmark.h>
+
+#include <ATen/ATen.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <ATen/native/BinaryOps.h>
+#include <ATen/native/TensorIterator.h>
+#include <ATen/native/UnaryOps.h>
+#include <torch/csrc/jit/operator.h>
+
+using namespace at;
+
+namespace {
+
+constexpr int64_t kNumel = 16;
+constexpr int64_t kMatDim = 32;
+
+Tensor make_arg() {
+  return at::ones({kNumel});
+}
+
+Tensor make_mat() {
+  return at::ones({kMatDim, kMatDim});
+}
+
+// Resolves the JIT operator whose schema matches the given dispatcher
+// entry. This mirrors callBoxedWorkaround in backend_fallback_test.cpp:
+// OperatorHandle::callBoxed does not work for all ops from
+// native_functions.yaml yet, so the boxed layer is exercised through the
+// JIT operator registry, like the interpreter does.
+std::shared_ptr<torch::jit::Operator> findJitOperator(
+    const char* name,
+    const char* overload_name) {
+  const auto& schema =
+      c10::Dispatcher::singleton().findSchemaOrThrow(name, overload_name)
+          .schema();
+  for (const auto& candidate :
+       torch::jit::getAllOperatorsFor(Symbol::fromQualString(name))) {
+    if (candidate->schema() == schema) {
+      return candidate;
+    }
+  }
+  TORCH_INTERNAL_ASSERT(false, "No JIT operator found for ", schema);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Kernel layer: DispatchStub on a prebuilt TensorIterator.
+// ---------------------------------------------------------------------------
+
+#define FORALL_UNARY_STUB_OPS(_) \
+  _(abs)                         \
+  _(neg)                         \
+  _(exp)                         \
+  _(log)                         \
+  _(sqrt)                        \
+  _(sigmoid)                     \
+  _(tanh)
+
+#define DEFINE_UNARY_KERNEL_BENCH(op)                       \
+  static void BM_Kernel_##op(benchmark::State& state) {     \
+    auto a = make_arg();                                    \
+    auto out = at::empty_like(a);                           \
+    auto iter = TensorIterator::unary_op(out, a);           \
+    while (state.KeepRunning()) {                           \
+      native::op##_stub(kCPU, iter);                        \
+    }                                                       \
+  }                                                         \
+  BENCHMARK(BM_Kernel_##op);
+FORALL_UNARY_STUB_OPS(DEFINE_UNARY_KERNEL_BENCH)
+#undef DEFINE_UNARY_KERNEL_BENCH
+
+static void BM_Kernel_add(benchmark::State& state) {
+  auto a = make_arg();
+  auto b = make_arg();
+  auto out = at::empty_like(a);
+  auto iter = TensorIterator::binary_op(out, a, b);
+  while (state.KeepRunning()) {
+    native::add_stub(kCPU, iter, 1);
+  }
+}
+BENCHMARK(BM_Kernel_add);
+
+static void BM_Kernel_sub(benchmark::State& state) {
+  auto a = make_arg();
+  auto b = make_arg();
+  auto out = at::empty_like(a);
+  auto iter = TensorIterator::binary_op(out, a, b);
+  while (state.KeepRunning()) {
+    native::sub_stub(kCPU, iter, 1);
+  }
+}
+BENCHMARK(BM_Kernel_sub);
+
+static void BM_Kernel_mul(benchmark::State& state) {
+  auto a = make_arg();
+  auto b = make_arg();
+  auto out = at::empty_like(a);
+  auto iter = TensorIterator::binary_op(out, a, b);
+  while (state.KeepRunning()) {
+    native::mul_stub(kCPU, iter);
+  }
+}
+BENCHMARK(BM_Kernel_mul);
+
+static void BM_Kernel_div(benchmark::State& state) {
+  auto a = make_arg();
+  auto b = make_arg();
+  auto out = at::empty_like(a);
+  auto iter = TensorIterator::binary_op(out, a, b);
+  while (state.KeepRunning()) {
+    native::div_stub(kCPU, iter);
+  }
+}
+BENCHMARK(BM_Kernel_div);
+
+// ---------------------------------------------------------------------------
+// Unboxed layer: the public at:: functions.
+// ---------------------------------------------------------------------------
+
+#define FORALL_UNARY_OPS(_) \
+  FORALL_UNARY_STUB_OPS(_)  \
+  _(relu)
+
+#define DEFINE_UNARY_UNBOXED_BENCH(op)                      \
+  static void BM_Unboxed_##op(benchmark::State& state) {    \
+    auto a = make_arg();                                    \
+    while (state.KeepRunning()) {                           \
+      auto out = at::op(a);                                 \
+      benchmark::DoNotOptimize(out);                        \
+    }                                                       \
+  }                                                         \
+  BENCHMARK(BM_Unboxed_##op);
+FORALL_UNARY_OPS(DEFINE_UNARY_UNBOXED_BENCH)
+#undef DEFINE_UNARY_UNBOXED_BENCH
+
+#define DEFINE_BINARY_UNBOXED_BENCH(op)                     \
+  static void BM_Unboxed_##op(benchmark::State& state) {    \
+    auto a = make_arg();                                    \
+    auto b = make_arg();                                    \
+    while (state.KeepRunning()) {                           \
+      auto out = at::op(a, b);                              \
+      benchmark::DoNotOptimize(out);                        \
+    }                                                       \
+  }                                                         \
+  BENCHMARK(BM_Unboxed_##op);
+DEFINE_BINARY_UNBOXED_BENCH(add)
+DEFINE_BINARY_UNBOXED_BENCH(sub)
+DEFINE_BINARY_UNBOXED_BENCH(mul)
+DEFINE_BINARY_UNBOXED_BENCH(div)
+#undef DEFINE_BINARY_UNBOXED_BENCH
+
+static void BM_Unboxed_mm(benchmark::State& state) {
+  auto a = make_mat();
+  auto b = make_mat();
+  while (state.KeepRunning()) {
+    auto out = at::mm(a, b);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_Unboxed_mm);
+
+static void BM_Unboxed_matmul(benchmark::State& state) {
+  auto a = make_mat();
+  auto b = make_mat();
+  while (state.KeepRunning()) {
+    auto out = at::matmul(a, b);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_Unboxed_matmul);
+
+static void BM_Unboxed_sum(benchmark::State& state) {
+  auto a = make_arg();
+  while (state.KeepRunning()) {
+    auto out = at::sum(a);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_Unboxed_sum);
+
+static void BM_Unboxed_mean(benchmark::State& state) {
+  auto a = make_arg();
+  while (state.KeepRunning()) {
+    auto out = at::mean(a);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_Unboxed_mean);
+
+static void BM_Unboxed_softmax(benchmark::State& state) {
+  auto a = make_arg();
+  while (state.KeepRunning()) {
+    auto out = at::softmax(a, 0);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_Unboxed_softmax);
+
+static void BM_Unboxed_clone(benchmark::State& state) {
+  auto a = make_arg();
+  while (state.KeepRunning()) {
+    auto out = a.clone();
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_Unboxed_clone);
+
+static void BM_Unboxed_cat(benchmark::State& state) {
+  auto a = make_arg();
+  while (state.KeepRunning()) {
+    auto out = at::cat({a, a}, 0);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_Unboxed_cat);
+
+static void BM_Unboxed_reshape(benchmark::State& state) {
+  auto a = make_arg();
+  while (state.KeepRunning()) {
+    auto out = a.reshape({kNumel / 2, 2});
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_Unboxed_reshape);
+
+// ---------------------------------------------------------------------------
+// Boxed layer: stack-based call via the JIT operator registry.
+// ---------------------------------------------------------------------------
+
+#define DEFINE_UNARY_BOXED_BENCH(op)                                 \
+  static void BM_Boxed_##op(benchmark::State& state) {               \
+    auto operation = findJitOperator("aten::" #op, "")->getOperation(); \
+    auto a = make_arg();                                             \
+    torch::jit::Stack stack;                                         \
+    while (state.KeepRunning()) {                                    \
+      stack.clear();                                                 \
+      torch::jit::push(stack, a);                                    \
+      operation(stack);                                              \
+      benchmark::DoNotOptimize(torch::jit::pop(stack));              \
+    }                                                                \
+  }                                                                  \
+  BENCHMARK(BM_Boxed_##op);
+FORALL_UNARY_OPS(DEFINE_UNARY_BOXED_BENCH)
+#undef DEFINE_UNARY_BOXED_BENCH
+
+#define DEFINE_BINARY_BOXED_BENCH(op)                                \
+  static void BM_Boxed_##op(benchmark::State& state) {               \
+    auto operation =                                                 \
+        findJitOperator("aten::" #op, "Tensor")->getOperation();     \
+    auto a = make_arg();                                             \
+    auto b = make_arg();                                             \
+    torch::jit::Stack stack;                                         \
+    while (state.KeepRunning()) {                                    \
+      stack.clear();                                                 \
+      torch::jit::push(stack, a, b, 1);                              \
+      operation(stack);                                              \
+      benchmark::DoNotOptimize(torch::jit::pop(stack));              \
+    }                                                                \
+  }                                                                  \
+  BENCHMARK(BM_Boxed_##op);
+DEFINE_BINARY_BOXED_BENCH(add)
+DEFINE_BINARY_BOXED_BENCH(sub)
+#undef DEFINE_BINARY_BOXED_BENCH
+
+#define DEFINE_BINARY_BOXED_BENCH_NO_ALPHA(op)                       \
+  static void BM_Boxed_##op(benchmark::State& state) {               \
+    auto operation =                                                 \
+        findJitOperator("aten::" #op, "Tensor")->getOperation();     \
+    auto a = make_arg();                                             \
+    auto b = make_arg();                                             \
+    torch::jit::Stack stack;                                         \
+    while (state.KeepRunning()) {                                    \
+      stack.clear();                                                 \
+      torch::jit::push(stack, a, b);                                 \
+      operation(stack);                                              \
+      benchmark::DoNotOptimize(torch::jit::pop(stack));              \
+    }                                                                \
+  }                                                                  \
+  BENCHMARK(BM_Boxed_##op);
+DEFINE_BINARY_BOXED_BENCH_NO_ALPHA(mul)
+DEFINE_BINARY_BOXED_BENCH_NO_ALPHA(div)
+#undef DEFINE_BINARY_BOXED_BENCH_NO_ALPHA
+
+static void BM_Boxed_mm(benchmark::State& state) {
+  auto operation = findJitOperator("aten::mm", "")->getOperation();
+  auto a = make_mat();
+  auto b = make_mat();
+  torch::jit::Stack stack;
+  while (state.KeepRunning()) {
+    stack.clear();
+    torch::jit::push(stack, a, b);
+    operation(stack);
+    benchmark::DoNotOptimize(torch::jit::pop(stack));
+  }
+}
+BENCHMARK(BM_Boxed_mm);
+
+static void BM_Boxed_matmul(benchmark::State& state) {
+  auto operation = findJitOperator("aten::matmul", "")->getOperation();
+  auto a = make_mat();
+  auto b = make_mat();
+  torch::jit::Stack stack;
+  while (state.KeepRunning()) {
+    stack.clear();
+    torch::jit::push(stack, a, b);
+    operation(stack);
+    benchmark::DoNotOptimize(torch::jit::pop(stack));
+  }
+}
+BENCHMARK(BM_Boxed_matmul);
+
+static void BM_Boxed_sum(benchmark::State& state) {
+  auto operation = findJitOperator("aten::sum", "")->getOperation();
+  auto a = make_arg();
+  torch::jit::Stack stack;
+  while (state.KeepRunning()) {
+    stack.clear();
+    torch::jit::push(stack, a, IValue());
+    operation(stack);
+    benchmark::DoNotOptimize(torch::jit::pop(stack));
+  }
+}
+BENCHMARK(BM_Boxed_sum);
+
+static void BM_Boxed_mean(benchmark::State& state) {
+  auto operation = findJitOperator("aten::mean", "")->getOperation();
+  auto a = make_arg();
+  torch::jit::Stack stack;
+  while (state.KeepRunning()) {
+    stack.clear();
+    torch::jit::push(stack, a, IValue());
+    operation(stack);
+    benchmark::DoNotOptimize(torch::jit::pop(stack));
+  }
+}
+BENCHMARK(BM_Boxed_mean);
+
+static void BM_Boxed_softmax(benchmark::State& state) {
+  auto operation = findJitOperator("aten::softmax", "int")->getOperation();
+  auto a = make_arg();
+  torch::jit::Stack stack;
+  while (state.KeepRunning()) {
+    stack.clear();
+    torch::jit::push(stack, a, 0, IValue());
+    operation(stack);
+    benchmark::DoNotOptimize(torch::jit::pop(stack));
+  }
+}
+BENCHMARK(BM_Boxed_softmax);
+
+static void BM_Boxed_clone(benchmark::State& state) {
+  auto operation = findJitOperator("aten::clone", "")->getOperation();
+  auto a = make_arg();
+  torch::jit::Stack stack;
+  while (state.KeepRunning()) {
+    stack.clear();
+    torch::jit::push(stack, a, IValue());
+    operation(stack);
+    benchmark::DoNotOptimize(torch::jit::pop(stack));
+  }
+}
+BENCHMARK(BM_Boxed_clone);
+
+static void BM_Boxed_cat(benchmark::State& state) {
+  auto operation = findJitOperator("aten::cat", "")->getOperation();
+  auto a = make_arg();
+  auto tensors = c10::List<Tensor>({a, a});
+  torch::jit::Stack stack;
+  while (state.KeepRunning()) {
+    stack.clear();
+    torch::jit::push(stack, tensors, 0);
+    operation(stack);
+    benchmark::DoNotOptimize(torch::jit::pop(stack));
+  }
+}
+BENCHMARK(BM_Boxed_cat);
+
+static void BM_Boxed_reshape(benchmark::State& state) {
+  auto operation = findJitOperator("aten::reshape", "")->getOperation();
+  auto a = make_arg();
+  auto shape = std::vector<int64_t>{kNumel / 2, 2};
+  torch::jit::Stack stack;
+  while (state.KeepRunning()) {
+    stack.clear();
+    torch::jit::push(stack, a, shape);
+    operation(stack);
+    benchmark::DoNotOptimize(torch::jit::pop(stack));
+  }
+}
+BENCHMARK(BM_Boxed_reshape);
+
+BENCHMARK_MAIN();
@@ -12,6 +12,7 @@
 #include <c10/core/ScalarType.h>
 #include <c10/util/Exception.h>
 #include <ATen/core/LegacyDeviceTypeInit.h>
+#include <ATen/core/grad_mode.h>
 #include <c10/core/impl/LocalDispatchKeySet.h>
 #include <c10/core/TensorImpl.h>
 #include <ATen/core/TensorBody.h>
@@ -89,4 +90,22 @@ struct CAFFE2_API AutoNonVariableTypeMode {
   c10::impl::ExcludeDispatchKeyGuard guard_;
 };
 
+// RAII guard for inference-only regions. Disables gradient recording AND
+// excludes VariableTensorId from dispatch, so every op inside the guard
+// skips the VariableType wrapper (the shallow copies, requires_grad checks
+// and version-counter bumps NoGradGuard alone still pays for) and goes
+// straight to the backend kernel. The exclusion is a thread-local key-set
+// test, so the cost is one check per call.
+//
+// The restrictions follow from what is skipped: inside the guard nothing is
+// profiled or traced, and in-place ops do not bump version counters, so do
+// not mutate tensors that autograd may have saved for a backward pass that
+// runs later. Intended for eager inference loops; see the note above for
+// why NoGradGuard cannot do this by itself.
+struct CAFFE2_API AutoInferenceMode {
+  AutoInferenceMode() : grad_mode_(/*enabled=*/false) {}
+  AutoGradMode grad_mode_;
+  AutoNonVariableTypeMode non_variable_type_mode_;
+};
+
 } // namespace at
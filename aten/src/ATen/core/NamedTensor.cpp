@@ -5,13 +5,6 @@
 
 namespace at {
 
-bool NamedTensorMeta::has_names() const {
-  return !std::all_of(
-      names_.begin(), names_.end(), [](const Dimname& n) {
-        return n.type() == NameType::WILDCARD;
-      });
-}
-
 thread_local bool NamesMode_enabled = true;
 
 bool NamesMode::is_enabled() {
@@ -135,11 +128,6 @@ DimnameList get_names(const TensorImpl* impl) {
   return default_names(impl->dim());
 }
 
-bool has_names(const TensorImpl* impl) {
-  const auto* named_tensor_meta = get_named_tensor_meta(impl);
-  return named_tensor_meta != nullptr && named_tensor_meta->has_names();
-}
-
 } // namespace impl
 
 } // namespace at
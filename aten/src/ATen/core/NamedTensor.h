@@ -4,6 +4,8 @@
 #include <c10/core/TensorImpl.h>
 #include <c10/util/C++17.h>
 
+#include <algorithm>
+
 namespace at {
 
 // XXX: This file exists because TensorImpl is in c10, but Dimname is in ATen.
@@ -18,18 +20,28 @@ namespace at {
 // XXX: Ideally we would just put optional<vector<Dimname>> into TensorImpl.
 struct CAFFE2_API NamedTensorMeta : public c10::NamedTensorMetaInterface {
   explicit NamedTensorMeta(int64_t num_names)
-    : names_(std::vector<Dimname>(num_names, Dimname::wildcard())) {}
+    : names_(std::vector<Dimname>(num_names, Dimname::wildcard())),
+      has_non_wildcard_names_(false) {}
 
   explicit NamedTensorMeta(DimnameList names)
-    : names_(names.vec()) {}
+    : names_(names.vec()) {
+    refresh_has_non_wildcard_names();
+  }
   explicit NamedTensorMeta(std::vector<Dimname>&& names)
-    : names_(std::move(names)) {}
+    : names_(std::move(names)) {
+    refresh_has_non_wildcard_names();
+  }
 
   std::unique_ptr<c10::NamedTensorMetaInterface> clone() const override {
     return std::make_unique<NamedTensorMeta>(names_);
   }
 
-  bool has_names() const;
+  // Whether any name is something other than 'None'. This is precomputed on
+  // every mutation of names_ so that the hot has_names() checks don't have to
+  // rescan the names.
+  bool has_names() const {
+    return has_non_wildcard_names_;
+  }
   DimnameList names() const { return names_; }
 
   // Used for an assertion in TensorImpl.h
@@ -40,15 +52,25 @@ struct CAFFE2_API NamedTensorMeta : public c10::NamedTensorMetaInterface {
   void set_names(DimnameList new_names) {
     TORCH_INTERNAL_ASSERT(new_names.size() == names_.size());
     std::copy(new_names.begin(), new_names.end(), names_.begin());
+    refresh_has_non_wildcard_names();
   }
 
   void set_names(std::vector<Dimname>&& new_names) {
     TORCH_INTERNAL_ASSERT(new_names.size() == names_.size());
     names_ = std::move(new_names);
+    refresh_has_non_wildcard_names();
   }
 
  private:
+  void refresh_has_non_wildcard_names() {
+    has_non_wildcard_names_ = !std::all_of(
+        names_.begin(), names_.end(), [](const Dimname& n) {
+          return n.type() == NameType::WILDCARD;
+        });
+  }
+
   std::vector<Dimname> names_;
+  bool has_non_wildcard_names_;
 };
 
 // When NamesMode is disabled, then all operations ignore tensors' names fields.
@@ -103,7 +125,19 @@ void check_names_valid_for(TensorImpl* impl, DimnameList names);
 // Returns false if the tensor's names don't exist (were not allocated),
 // or if all names are 'None'.
 // We treat not-allocated-names the same as allocated names that are all 'None'.
-CAFFE2_API bool has_names(const TensorImpl* impl);
+//
+// The overwhelmingly common case is a tensor with no NamedTensorMeta allocated
+// at all, and every op checks this on all of its inputs and outputs, so this
+// is written to be a single inlineable branch on the meta pointer before
+// consulting NamesMode (a TLS read) or the names themselves.
+inline bool has_names(const TensorImpl* impl) {
+  if (C10_LIKELY(!impl->has_named_tensor_meta())) {
+    return false;
+  }
+  return NamesMode::is_enabled() &&
+      static_cast<const NamedTensorMeta*>(impl->named_tensor_meta())
+          ->has_names();
+}
 
 // Returns the names of the tensor's dimensions.
 // Unnamed tensors are treated as having 'None' in all dimension; this method
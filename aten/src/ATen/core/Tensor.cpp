@@ -26,6 +26,32 @@ void Tensor::enforce_invariants() {
   }
 }
 
+DataPtr Tensor::release_storage() {
+  TORCH_CHECK(defined(), "cannot release the storage of an undefined tensor");
+  TORCH_CHECK(
+      !requires_grad(),
+      "cannot release the storage of a tensor that requires grad");
+  TORCH_CHECK(impl_->has_storage(), "release_storage: tensor has no storage");
+  TORCH_CHECK(
+      use_count() == 1,
+      "release_storage: tensor is shared (use_count=",
+      use_count(),
+      "); the buffer can only be donated by its sole owner");
+  TORCH_CHECK(
+      impl_->storage().use_count() == 1,
+      "release_storage: storage is shared with another tensor or view");
+  TORCH_CHECK(
+      is_contiguous() && impl_->storage_offset() == 0,
+      "release_storage: tensor must be contiguous and start at the "
+      "beginning of its storage");
+  StorageImpl* storage_impl = impl_->storage().unsafeGetStorageImpl();
+  DataPtr data_ptr =
+      storage_impl->set_data_ptr(DataPtr(nullptr, storage_impl->device()));
+  storage_impl->set_numel(0);
+  reset();
+  return data_ptr;
+}
+
 void Tensor::print() const {
   if (defined()) {
     std::cerr << "[" << toString() << " " << sizes() << "]" << std::endl;
@@ -10,3 +10,47 @@
  */
 #include <ATen/core/TensorBody.h>
 #include <ATen/core/TensorMethods.h>
+
+namespace at {
+
+// A non-owning view of a Tensor. Copying a Tensor bumps two atomic counters
+// over its lifetime (refcount on copy, refcount and possibly weakcount on
+// destruction), which shows up in framework-overhead profiles of small eager
+// ops. TensorRef wraps a caller-owned Tensor without touching the refcount:
+// it borrows the TensorImpl pointer on construction and defuses the borrow
+// on destruction, so the full Tensor interface is available through
+// operator* / operator-> at zero refcounting cost.
+//
+// Only use TensorRef where the borrowed Tensor is guaranteed to outlive it,
+// e.g. function-local use of an argument the caller keeps alive. It is
+// deliberately neither copyable nor movable so a borrow cannot escape the
+// frame it was created in. (TensorList is already a non-owning
+// ArrayRef<Tensor> span, so no equivalent is needed for lists.)
+class TensorRef final {
+ public:
+  /* implicit */ TensorRef(const Tensor& src)
+      : ref_(c10::intrusive_ptr<TensorImpl, UndefinedTensorImpl>(
+            c10::intrusive_ptr<TensorImpl, UndefinedTensorImpl>::
+                unsafe_borrow_t{},
+            src.unsafeGetTensorImpl())) {}
+  ~TensorRef() {
+    ref_.unsafeReleaseTensorImpl();
+  }
+
+  TensorRef(const TensorRef&) = delete;
+  TensorRef& operator=(const TensorRef&) = delete;
+  TensorRef(TensorRef&&) = delete;
+  TensorRef& operator=(TensorRef&&) = delete;
+
+  const Tensor& operator*() const {
+    return ref_;
+  }
+  const Tensor* operator->() const {
+    return &ref_;
+  }
+
+ private:
+  Tensor ref_;
+};
+
+} // namespace at
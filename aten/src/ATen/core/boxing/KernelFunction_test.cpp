@@ -309,6 +309,20 @@ TEST(KernelFunctionTest, givenUnboxedLambda_withoutReturn_whenCallingUnboxed_the
   kernels::expectUnboxedCallingWithoutReturnWorks(func);
 }
 
+TEST(KernelFunctionTest, givenPooledStack_whenBorrowedAgain_thenReusesCapacity) {
+  const IValue* buffer = nullptr;
+  {
+    torch::jit::PooledStack stack;
+    stack->push_back(3);
+    buffer = stack->data();
+  }
+  // the freelist is LIFO, so the next borrow on this thread gets the same
+  // vector back, emptied but with its buffer intact
+  torch::jit::PooledStack stack;
+  EXPECT_EQ(0, stack->size());
+  EXPECT_EQ(buffer, stack->data());
+}
+
 }
 
 // TODO Also test different variants of calling unboxed with wrong signatures
@@ -57,27 +57,25 @@ Result boxAndCallBoxedFunc(KernelFunction::InternalBoxedKernelFunction* boxed_ke
 template<class Result, class... Args>
 std::enable_if_t<supports_boxing<Result, Args...>::value && !std::is_same<void, Result>::value, Result>
 boxAndCallBoxedFunc(KernelFunction::InternalBoxedKernelFunction* boxed_kernel_func, OperatorKernel* functor, const OperatorHandle& opHandle, Args... args) {
-  // TODO Reuse stack vector instead of allocating?
-  torch::jit::Stack stack;
-  torch::jit::push(stack, std::forward<Args>(args)...);
+  torch::jit::PooledStack stack;
+  torch::jit::push(*stack, std::forward<Args>(args)...);
 
-  (*boxed_kernel_func)(functor, opHandle, &stack);
+  (*boxed_kernel_func)(functor, opHandle, &*stack);
 
-  TORCH_INTERNAL_ASSERT(stack.size() == 1, "A boxed kernel should only push one return to the stack");
-  return std::move(stack[0]).to<Result>();
+  TORCH_INTERNAL_ASSERT(stack->size() == 1, "A boxed kernel should only push one return to the stack");
+  return std::move((*stack)[0]).to<Result>();
 }
 
 // SFINAE version for ops without returns
 template<class Result, class... Args>
 std::enable_if_t<supports_boxing<Result, Args...>::value && std::is_same<void, Result>::value, Result>
 boxAndCallBoxedFunc(KernelFunction::InternalBoxedKernelFunction* boxed_kernel_func, OperatorKernel* functor, const OperatorHandle& opHandle, Args... args) {
-  // TODO Reuse stack vector instead of allocating?
-  torch::jit::Stack stack;
-  torch::jit::push(stack, std::forward<Args>(args)...);
+  torch::jit::PooledStack stack;
+  torch::jit::push(*stack, std::forward<Args>(args)...);
 
-  (*boxed_kernel_func)(functor, opHandle, &stack);
+  (*boxed_kernel_func)(functor, opHandle, &*stack);
 
-  TORCH_INTERNAL_ASSERT(stack.size() == 0, "A boxed kernel returned a value but when we called it with KernelFunction::callUnboxed, we expected it to return void.");
+  TORCH_INTERNAL_ASSERT(stack->size() == 0, "A boxed kernel returned a value but when we called it with KernelFunction::callUnboxed, we expected it to return void.");
 }
 
 }
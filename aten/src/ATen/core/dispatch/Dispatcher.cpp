@@ -28,9 +28,18 @@ private:
 
 OpRegistrationListener::~OpRegistrationListener() {}
 
+// starts at 1 so that a zero-initialized DispatchCache is never valid
+std::atomic<uint64_t> Dispatcher::registrationEpoch_{1};
+
+void Dispatcher::bumpRegistrationEpoch() {
+  registrationEpoch_.fetch_add(1, std::memory_order_acq_rel);
+}
+
 Dispatcher::Dispatcher()
 : operators_()
 , operatorLookupTable_()
+, hashedOperatorLookupTable_()
+, collidingOperatorNameHashes_()
 , backendFallbackKernels_()
 , backendsWithoutFallthrough_(DispatchKeySet::FULL)
 , listeners_(std::make_unique<detail::RegistrationListenerList>())
@@ -57,6 +66,26 @@ OperatorHandle Dispatcher::findSchemaOrThrow(const char* name, const char* overl
   return findSchema({name, overload_name}).value();
 }
 
+c10::optional<OperatorHandle> Dispatcher::findSchemaByHash(uint64_t operator_name_hash) {
+  return hashedOperatorLookupTable_.read([&] (const ska::flat_hash_map<uint64_t, OperatorHandle>& hashedOperatorLookupTable) -> c10::optional<OperatorHandle> {
+    auto found = hashedOperatorLookupTable.find(operator_name_hash);
+    if (found == hashedOperatorLookupTable.end()) {
+      return c10::nullopt;
+    }
+    return found->second;
+  });
+}
+
+OperatorHandle Dispatcher::findSchemaByHashOrThrow(uint64_t operator_name_hash, const char* dotted_name) {
+  auto found = findSchemaByHash(operator_name_hash);
+  TORCH_CHECK(
+      found.has_value(),
+      "Could not find schema for ", dotted_name, " by hash. ",
+      "Either no such operator is registered, or its name hash collides ",
+      "with another operator's; use findSchema in the latter case.");
+  return *found;
+}
+
 OperatorHandle Dispatcher::findOrRegisterSchema_(FunctionSchema&& schema, OperatorOptions&& options) {
   const auto found = findSchema(schema.operator_name());
   if (found != c10::nullopt) {
@@ -82,6 +111,23 @@ OperatorHandle Dispatcher::findOrRegisterSchema_(FunctionSchema&& schema, Operat
     operatorLookupTable.emplace(op_name, handle);
   });
 
+  const uint64_t name_hash = operatorNameHash(op_name);
+  if (collidingOperatorNameHashes_.count(name_hash) == 0) {
+    bool collision = false;
+    hashedOperatorLookupTable_.write([&] (ska::flat_hash_map<uint64_t, OperatorHandle>& hashedOperatorLookupTable) {
+      auto inserted = hashedOperatorLookupTable.emplace(name_hash, handle);
+      if (!inserted.second) {
+        // Two distinct operator names hashed identically; lookup by hash
+        // would be ambiguous, so neither operator is findable by hash.
+        hashedOperatorLookupTable.erase(inserted.first);
+        collision = true;
+      }
+    });
+    if (collision) {
+      collidingOperatorNameHashes_.insert(name_hash);
+    }
+  }
+
   return handle;
 }
 
@@ -123,6 +169,15 @@ void Dispatcher::deregisterSchema_(const OperatorHandle& op, const OperatorName&
     operatorLookupTable_.write([&] (ska::flat_hash_map<OperatorName, OperatorHandle>& operatorLookupTable) {
       operatorLookupTable.erase(op_name);
     });
+    const uint64_t name_hash = operatorNameHash(op_name);
+    if (collidingOperatorNameHashes_.count(name_hash) == 0) {
+      hashedOperatorLookupTable_.write([&] (ska::flat_hash_map<uint64_t, OperatorHandle>& hashedOperatorLookupTable) {
+        hashedOperatorLookupTable.erase(name_hash);
+      });
+    }
+
+    // DispatchCache entries may point into the erased OperatorEntry
+    bumpRegistrationEpoch();
   }
 }
 
@@ -132,6 +187,7 @@ RegistrationHandleRAII Dispatcher::registerBackendFallbackKernel(DispatchKey dis
   if (kernel.isFallthrough()) {
     backendsWithoutFallthrough_ = backendsWithoutFallthrough_.remove(dispatchKey);
   }
+  bumpRegistrationEpoch();
 
   return RegistrationHandleRAII([this, dispatchKey] {
     deregisterBackendFallbackKernel_(dispatchKey);
@@ -142,6 +198,7 @@ void Dispatcher::deregisterBackendFallbackKernel_(DispatchKey dispatchKey) {
   auto result = backendFallbackKernels_.removeKernelIfExists(dispatchKey);
   backendsWithoutFallthrough_ = backendsWithoutFallthrough_.add(dispatchKey);
   TORCH_INTERNAL_ASSERT(result == impl::KernelFunctionTable::RemoveKernelIfExistsResult::REMOVED_KERNEL, "Tried to deregister a backend fallback kernel for ", dispatchKey, " but there was none registered.");
+  bumpRegistrationEpoch();
 }
 
 RegistrationHandleRAII Dispatcher::registerKernel(const OperatorHandle& op, DispatchKey dispatch_key, KernelFunction kernel) {
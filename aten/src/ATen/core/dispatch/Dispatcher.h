@@ -4,6 +4,7 @@
 #include <ATen/core/dispatch/RegistrationHandleRAII.h>
 #include <c10/util/Exception.h>
 #include <c10/util/LeftRight.h>
+#include <atomic>
 #include <mutex>
 #include <list>
 
@@ -29,6 +30,22 @@ class RegistrationListenerList;
 }
 class SchemaRegistrationHandleRAII;
 
+/**
+ * A per-callsite memo of the most recently resolved kernel, used by
+ * Dispatcher::callUnboxedWithCache(). As long as the arguments produce the
+ * same DispatchKey and no kernel has been (de)registered since (tracked via
+ * Dispatcher::registrationEpoch()), the dispatch table walk and the backend
+ * fallback / catch-all chain are skipped entirely.
+ *
+ * The cache is not synchronized; declare it `static thread_local` at the
+ * callsite, next to the `static OperatorHandle op = findSchemaOrThrow(...)`.
+ */
+struct DispatchCache final {
+  const KernelFunction* kernel = nullptr;
+  uint64_t epoch = 0;
+  DispatchKey dispatchKey = DispatchKey::Undefined;
+};
+
 /**
  * Top-level dispatch interface for dispatching via the dynamic dispatcher.
  */
@@ -87,6 +104,32 @@ public:
    */
   OperatorHandle findSchemaOrThrow(const char* name, const char* overload_name);
 
+  /**
+   * Zero-allocation schema lookup keyed by the FNV hash of the dotted
+   * operator name ("name.overload", or just "name" without an overload).
+   * The hash can be computed at compile time with the _opname_hash literal
+   * from operator_name.h, so no std::strings are constructed or hashed at
+   * the call site:
+   *
+   *   static auto op = c10::Dispatcher::singleton().findSchemaByHashOrThrow(
+   *       "my::op.overload"_opname_hash, "my::op.overload");
+   *
+   * Capture the handle in a function-local static as above; repeated
+   * invocation through it is then pointer-indirection cheap.
+   *
+   * If two registered operator names ever hash identically, both hashes are
+   * evicted from the hashed table and lookup by hash reports the operators
+   * as not found; callers needing to handle that (so far theoretical) case
+   * must fall back to findSchema.
+   */
+  c10::optional<OperatorHandle> findSchemaByHash(uint64_t operator_name_hash);
+
+  /**
+   * Variant of findSchemaByHash that throws when the operator is not
+   * findable by hash; dotted_name is only used for the error message.
+   */
+  OperatorHandle findSchemaByHashOrThrow(uint64_t operator_name_hash, const char* dotted_name);
+
   /**
    * Register a kernel to the dispatch table for an operator.
    * If dispatch_key is nullopt, then this registers a fallback kernel.
@@ -120,8 +163,28 @@ public:
   template<class Return, class... Args>
   Return callUnboxedWithDispatchKey(const OperatorHandle& op, DispatchKey dispatchKey, Args... args) const;
 
+  // Same as callUnboxed, but memoizes the resolved kernel in the given
+  // DispatchCache and reuses it while the dispatch key and registration epoch
+  // still match. See the comment on DispatchCache.
+  template<class Return, class... Args>
+  Return callUnboxedWithCache(const OperatorHandle& op, DispatchCache& cache, Args... args) const;
+
   void callBoxed(const OperatorHandle& op, Stack* stack) const;
 
+  /**
+   * A counter that is bumped whenever any dispatch table changes (kernel or
+   * backend fallback registration/deregistration, operator removal).
+   * DispatchCache entries carry the epoch they were resolved under and are
+   * discarded when it no longer matches.
+   */
+  static uint64_t registrationEpoch() {
+    return registrationEpoch_.load(std::memory_order_acquire);
+  }
+
+  // Invalidates all DispatchCache entries. Called from the registration paths;
+  // not intended for use outside of the dispatcher.
+  static void bumpRegistrationEpoch();
+
   /**
    * Add a listener that gets called whenever a new op is registered or an existing
    * op is deregistered. Immediately after registering, this listener gets called
@@ -143,6 +206,12 @@ private:
 
   std::list<OperatorDef> operators_;
   LeftRight<ska::flat_hash_map<OperatorName, OperatorHandle>> operatorLookupTable_;
+  // Secondary lookup table for findSchemaByHash, keyed by
+  // operatorNameHash(). Hashes that ever collided live in
+  // collidingOperatorNameHashes_ (guarded by mutex_) and stay out of the
+  // table for good.
+  LeftRight<ska::flat_hash_map<uint64_t, OperatorHandle>> hashedOperatorLookupTable_;
+  ska::flat_hash_set<uint64_t> collidingOperatorNameHashes_;
   impl::KernelFunctionTable backendFallbackKernels_;
   // Set of backends which have specified they do NOT want fallthrough behavior
   // (we store the inverse because it avoids a negation when we use this for
@@ -150,6 +219,7 @@ private:
   DispatchKeySet backendsWithoutFallthrough_;
   std::unique_ptr<detail::RegistrationListenerList> listeners_;
   std::mutex mutex_;
+  static std::atomic<uint64_t> registrationEpoch_;
 };
 
 /**
@@ -182,6 +252,11 @@ public:
     return c10::Dispatcher::singleton().callUnboxedWithDispatchKey<Return, Args...>(*this, dispatchKey, std::forward<Args>(args)...);
   }
 
+  template<class Return, class... Args>
+  Return callUnboxedWithCache(DispatchCache& cache, Args... args) const {
+    return c10::Dispatcher::singleton().callUnboxedWithCache<Return, Args...>(*this, cache, std::forward<Args>(args)...);
+  }
+
   void callBoxed(Stack* stack) const {
     c10::Dispatcher::singleton().callBoxed(*this, stack);
   }
@@ -214,6 +289,26 @@ inline Return Dispatcher::callUnboxed(const OperatorHandle& op, Args... args) co
   return callUnboxedWithDispatchKey<Return, Args...>(op, dispatchKey, args...);
 }
 
+template<class Return, class... Args>
+inline Return Dispatcher::callUnboxedWithCache(const OperatorHandle& op, DispatchCache& cache, Args... args) const {
+  detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
+  const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
+  auto dispatchKey = dispatchTable.dispatchKeyExtractor().getDispatchKeyUnboxed<Args...>(backendsWithoutFallthrough_, args...);
+  // note: the epoch is read before resolving, so that a registration racing
+  // with the resolution below leaves a stale epoch in the cache and forces
+  // revalidation on the next call. Reading the table itself without a lock
+  // has the same guarantees as the uncached path above.
+  const uint64_t epoch = registrationEpoch();
+  if (C10_LIKELY(cache.kernel != nullptr && cache.dispatchKey == dispatchKey && cache.epoch == epoch)) {
+    return cache.kernel->template callUnboxed<Return, Args...>(op, std::forward<Args>(args)...);
+  }
+  const KernelFunction& kernel = dispatch_(dispatchTable, dispatchKey);
+  cache.kernel = &kernel;
+  cache.dispatchKey = dispatchKey;
+  cache.epoch = epoch;
+  return kernel.template callUnboxed<Return, Args...>(op, std::forward<Args>(args)...);
+}
+
 inline void Dispatcher::callBoxed(const OperatorHandle& op, Stack* stack) const {
   // note: this doesn't need the mutex because write operations on the list keep iterators intact.
   const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
@@ -1,4 +1,5 @@
 #include <ATen/core/dispatch/OperatorEntry.h>
+#include <ATen/core/dispatch/Dispatcher.h>
 
 namespace c10 {
 namespace impl {
@@ -103,6 +104,9 @@ void OperatorEntry::updateDispatchTable_(DispatchKey dispatch_key) {
   } else {
     dispatchTable_.setKernel(dispatch_key, k->second.front());
   }
+
+  // invalidate inline dispatch caches that may have memoized the old kernel
+  Dispatcher::bumpRegistrationEpoch();
 }
 
 void OperatorEntry::updateCatchallDispatchTable_() {
@@ -113,6 +117,9 @@ void OperatorEntry::updateCatchallDispatchTable_() {
   } else {
     dispatchTable_.setCatchallKernel(catchAllKernels_.front());
   }
+
+  // invalidate inline dispatch caches that may have memoized the old kernel
+  Dispatcher::bumpRegistrationEpoch();
 }
 
 }
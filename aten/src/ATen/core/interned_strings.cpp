@@ -48,12 +48,17 @@ Symbol InternedStrings::ns(Symbol sym) {
 #undef DEFINE_CASE
     default: {
       std::lock_guard<std::mutex> guard(mutex_);
-      return sym_to_info_.at(sym).ns;
+      return sym_to_info_.at(sym - static_cast<unique_t>(_keys::num_symbols))
+          .ns;
     }
   }
 }
 
 Symbol InternedStrings::_symbol(const std::string& s) {
+  if (auto builtin = detail::builtin_symbol(s)) {
+    return *builtin;
+  }
+
   auto it = string_to_sym_.find(s);
   if (it != string_to_sym_.end())
     return it->second;
@@ -66,7 +71,9 @@ Symbol InternedStrings::_symbol(const std::string& s) {
   }
   Symbol ns = _symbol("namespaces::" + s.substr(0, pos));
 
-  Symbol sym(sym_to_info_.size());
+  // custom symbols are numbered after the builtins, whose info lives in the
+  // static table in register_symbols.cpp rather than in sym_to_info_
+  Symbol sym(static_cast<unique_t>(_keys::num_symbols) + sym_to_info_.size());
   string_to_sym_[s] = sym;
   sym_to_info_.push_back({ns, s, s.substr(pos + strlen("::"))});
   return sym;
@@ -74,7 +81,8 @@ Symbol InternedStrings::_symbol(const std::string& s) {
 
 std::pair<const char*, const char*> InternedStrings::customString(Symbol sym) {
   std::lock_guard<std::mutex> guard(mutex_);
-  SymbolInfo& s = sym_to_info_.at(sym);
+  SymbolInfo& s =
+      sym_to_info_.at(sym - static_cast<unique_t>(_keys::num_symbols));
   return {s.qual_name.c_str(), s.unqual_name.c_str()};
 }
 
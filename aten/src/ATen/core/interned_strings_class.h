@@ -8,6 +8,7 @@
 #include <vector>
 #include <ATen/core/interned_strings.h>
 #include <c10/util/Exception.h>
+#include <c10/util/Optional.h>
 
 namespace c10 {
 
@@ -21,6 +22,9 @@ struct CAFFE2_API InternedStrings {
   // prereq - holding mutex_
   Symbol _symbol(const std::string& s);
   std::pair<const char*, const char*> customString(Symbol sym);
+  // Custom (runtime-registered) symbols only. Builtin symbols live in the
+  // static entries table in register_symbols.cpp, which is part of the
+  // binary image and needs no construction at startup; see builtin_symbol.
   std::unordered_map<std::string, Symbol> string_to_sym_;
 
   struct SymbolInfo {
@@ -28,9 +32,16 @@ struct CAFFE2_API InternedStrings {
     std::string qual_name;
     std::string unqual_name;
   };
+  // info for custom symbols, indexed by sym - _keys::num_symbols
   std::vector<SymbolInfo> sym_to_info_;
 
   std::mutex mutex_;
 };
 
+namespace detail {
+// Resolves a qualified string against the compile-time symbol table in
+// register_symbols.cpp; returns nullopt for strings that are not builtins.
+c10::optional<Symbol> builtin_symbol(const std::string& qual_name);
+} // namespace detail
+
 } // namespace c10
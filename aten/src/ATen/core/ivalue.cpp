@@ -3,13 +3,50 @@
 #include <ATen/core/Formatting.h>
 #include <c10/util/StringUtil.h>
 #include <cmath>
+#include <mutex>
+#include <unordered_map>
 #include <ATen/core/Dict.h>
 
 namespace c10 {
 namespace ivalue {
 
+// Note [Interned small strings]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// String-valued IValues always point at a heap-allocated ConstantString, so
+// interpreted code that churns through short strings (attribute names, dict
+// keys, format pieces) pays one allocation per string even when the same few
+// values recur. ConstantString is immutable and isSameIdentity() compares
+// strings by value, so handing out a shared instance is observationally
+// equivalent to allocating a fresh one. We exploit that here by interning
+// strings up to a small size cap in a bounded cache; anything longer (or
+// anything arriving after the cache fills up) takes the ordinary allocation
+// path. The cache is never evicted -- short strings are cheap to keep alive
+// and eviction would reintroduce allocator traffic on exactly the values we
+// are trying to make cheap.
+namespace {
+// Cap chosen to cover typical identifier-like strings while keeping hashing
+// on the create path trivially cheap.
+constexpr size_t kMaxInternedStringSize = 16;
+constexpr size_t kMaxInternedStrings = 4096;
+} // namespace
+
 CAFFE2_API c10::intrusive_ptr<ConstantString> ConstantString::create(
     std::string str_) {
+  if (str_.size() <= kMaxInternedStringSize) {
+    static std::mutex cache_mutex;
+    static std::unordered_map<std::string, c10::intrusive_ptr<ConstantString>>
+        cache;
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(str_);
+    if (it != cache.end()) {
+      return it->second;
+    }
+    auto interned = c10::make_intrusive<ConstantString>(std::move(str_));
+    if (cache.size() < kMaxInternedStrings) {
+      cache.emplace(interned->string(), interned);
+    }
+    return interned;
+  }
   return c10::make_intrusive<ConstantString>(std::move(str_));
 }
 
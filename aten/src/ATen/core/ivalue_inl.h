@@ -252,6 +252,11 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
     completed_ = true;
     value_ = std::move(value);
 
+    // Drop the lock before firing callbacks: a callback may call back into
+    // this future (e.g. value() from the gather step of aten::collect_all),
+    // which would self-deadlock. Once completed_ is set the callback list can
+    // no longer grow, so iterating it unlocked is safe.
+    lock.unlock();
     fireCallbacks();
     finished_cv_.notify_all();
   }
@@ -267,6 +272,8 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
     has_error = true;
     error = std::move(error_);
 
+    // See the comment in markCompleted(IValue) above.
+    lock.unlock();
     fireCallbacks();
     finished_cv_.notify_all();
   }
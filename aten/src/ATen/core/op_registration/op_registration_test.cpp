@@ -77,6 +77,45 @@ TEST(OperatorRegistrationTest, whenRegisteringSameSchemaWithNoAliasAnalysis_then
   EXPECT_EQ(op->options().aliasAnalysis(), at::AliasAnalysisKind::CONSERVATIVE);
 }
 
+TEST(OperatorRegistrationTest, whenLookingUpByHash_thenFindsOperator) {
+  bool called = false;
+  auto registrar = c10::RegisterOperators().op(c10::RegisterOperators::options().schema("_test::dummy(Tensor dummy) -> ()").catchAllKernel<MockKernel>(&called));
+
+  using c10::operator"" _opname_hash;
+  constexpr uint64_t hash = "_test::dummy"_opname_hash;
+  auto op = Dispatcher::singleton().findSchemaByHash(hash);
+  ASSERT_TRUE(op.has_value());
+  EXPECT_EQ(c10::operatorNameHash(op->schema().operator_name()), hash);
+  callOp(*op, dummyTensor(c10::DispatchKey::CPUTensorId));
+  EXPECT_TRUE(called);
+}
+
+TEST(OperatorRegistrationTest, whenLookingUpOverloadByHash_thenFindsOperator) {
+  auto registrar = c10::RegisterOperators().op("_test::dummy.overload1(Tensor dummy) -> ()", c10::RegisterOperators::options().catchAllKernel<DummyKernel>());
+
+  using c10::operator"" _opname_hash;
+  auto op = Dispatcher::singleton().findSchemaByHash("_test::dummy.overload1"_opname_hash);
+  ASSERT_TRUE(op.has_value());
+  EXPECT_EQ("overload1", op->schema().overload_name());
+}
+
+TEST(OperatorRegistrationTest, whenLookingUpMissingOperatorByHash_thenDoesNotFindOperator) {
+  using c10::operator"" _opname_hash;
+  EXPECT_FALSE(Dispatcher::singleton().findSchemaByHash("_test::not_registered"_opname_hash).has_value());
+  expectThrows<c10::Error>([] {
+    Dispatcher::singleton().findSchemaByHashOrThrow("_test::not_registered"_opname_hash, "_test::not_registered");
+  }, "Could not find schema for _test::not_registered by hash");
+}
+
+TEST(OperatorRegistrationTest, whenOperatorDeregistered_thenHashLookupDoesNotFindOperator) {
+  using c10::operator"" _opname_hash;
+  {
+    auto registrar = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options().catchAllKernel<DummyKernel>());
+    EXPECT_TRUE(Dispatcher::singleton().findSchemaByHash("_test::dummy"_opname_hash).has_value());
+  }
+  EXPECT_FALSE(Dispatcher::singleton().findSchemaByHash("_test::dummy"_opname_hash).has_value());
+}
+
 TEST(OperatorRegistrationTest, whenRegisteringSameSchemaWithDifferentAliasAnalysis_thenShouldThrow) {
   expectThrows<c10::Error>([] {
     auto registrar1 = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options().kernel<DummyKernel>(c10::DispatchKey::CPUTensorId).aliasAnalysis(at::AliasAnalysisKind::PURE_FUNCTION));
@@ -865,6 +904,49 @@ TEST(OperatorRegistrationTest, whenRegisteringAutogradKernelWithCatchAllKernel_t
   EXPECT_FALSE(called_autograd);
 }
 
+TEST(OperatorRegistrationTest, whenCallingWithDispatchCache_thenCachedKernelIsReusedAndInvalidatedOnReregistration) {
+  auto registrar = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options()
+    .impl_unboxedOnlyKernel<decltype(nonautograd_kernel), nonautograd_kernel>(DispatchKey::CPUTensorId));
+
+  auto op = Dispatcher::singleton().findSchema({"_test::dummy", ""});
+  ASSERT_TRUE(op.has_value());
+
+  at::AutoNonVariableTypeMode _var_guard(true);
+  c10::DispatchCache cache;
+
+  called_nonautograd = false;
+  c10::Dispatcher::singleton().callUnboxedWithCache<void, Tensor>(*op, cache, dummyTensor(DispatchKey::CPUTensorId));
+  EXPECT_TRUE(called_nonautograd);
+  EXPECT_NE(nullptr, cache.kernel);
+  EXPECT_EQ(DispatchKey::CPUTensorId, cache.dispatchKey);
+
+  // second call hits the memoized kernel
+  const c10::KernelFunction* cached_kernel = cache.kernel;
+  called_nonautograd = false;
+  c10::Dispatcher::singleton().callUnboxedWithCache<void, Tensor>(*op, cache, dummyTensor(DispatchKey::CPUTensorId));
+  EXPECT_TRUE(called_nonautograd);
+  EXPECT_EQ(cached_kernel, cache.kernel);
+
+  // registering another kernel bumps the epoch and forces revalidation,
+  // which resolves to the newly registered kernel
+  {
+    auto registrar2 = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options()
+      .impl_unboxedOnlyKernel<decltype(autograd_kernel), autograd_kernel>(DispatchKey::CPUTensorId));
+    EXPECT_NE(c10::Dispatcher::singleton().registrationEpoch(), cache.epoch);
+
+    called_nonautograd = called_autograd = false;
+    c10::Dispatcher::singleton().callUnboxedWithCache<void, Tensor>(*op, cache, dummyTensor(DispatchKey::CPUTensorId));
+    EXPECT_FALSE(called_nonautograd);
+    EXPECT_TRUE(called_autograd);
+  }
+
+  // deregistration invalidates again and falls back to the original kernel
+  called_nonautograd = called_autograd = false;
+  c10::Dispatcher::singleton().callUnboxedWithCache<void, Tensor>(*op, cache, dummyTensor(DispatchKey::CPUTensorId));
+  EXPECT_TRUE(called_nonautograd);
+  EXPECT_FALSE(called_autograd);
+}
+
 TEST(OperatorRegistrationTest, xlaPreAutogradOverridesAutogradKernel) {
   auto registrar = c10::RegisterOperators().op("_test::dummy(Tensor dummy) -> ()", c10::RegisterOperators::options()
     .impl_unboxedOnlyKernel<decltype(nonautograd_kernel), &nonautograd_kernel>(DispatchKey::XLAPreAutograd)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <utility>
 
@@ -28,6 +29,44 @@ inline std::string toString(const OperatorName& opName) {
   return result;
 }
 
+namespace detail {
+
+// 64 bit FNV-1a, usable in constant expressions. This is the hash behind
+// Dispatcher::findSchemaByHash; operatorNameHash and the _opname_hash
+// literal below must keep producing identical values for the same name.
+constexpr uint64_t kOperatorNameHashOffsetBasis = 0xcbf29ce484222325ull;
+constexpr uint64_t kOperatorNameHashPrime = 0x100000001b3ull;
+
+constexpr uint64_t operator_name_hash_append(uint64_t hash, const char* str, size_t size) {
+  for (size_t i = 0; i != size; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(str[i])) * kOperatorNameHashPrime;
+  }
+  return hash;
+}
+
+} // namespace detail
+
+// Hash of the dotted form of an operator name ("name.overload", or just
+// "name" when the overload is empty), i.e. of what toString() produces.
+// Operator names cannot contain '.', so the dotted form is unambiguous.
+inline uint64_t operatorNameHash(const OperatorName& opName) {
+  uint64_t hash = detail::operator_name_hash_append(
+      detail::kOperatorNameHashOffsetBasis, opName.name.data(), opName.name.size());
+  if (opName.overload_name.size() != 0) {
+    hash = detail::operator_name_hash_append(hash, ".", 1);
+    hash = detail::operator_name_hash_append(
+        hash, opName.overload_name.data(), opName.overload_name.size());
+  }
+  return hash;
+}
+
+// Compile-time hash of a dotted operator name:
+//   constexpr uint64_t hash = "aten::add.Tensor"_opname_hash;
+constexpr uint64_t operator"" _opname_hash(const char* str, size_t size) {
+  return detail::operator_name_hash_append(
+      detail::kOperatorNameHashOffsetBasis, str, size);
+}
+
 }
 
 namespace std {
@@ -1,5 +1,9 @@
 #include <ATen/core/interned_strings_class.h>
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
 namespace c10 {
 
 namespace {
@@ -18,21 +22,46 @@ constexpr Entry entries[] = {
 #undef SYMBOL_ENTRY
 };
 
+constexpr size_t num_entries = sizeof(entries) / sizeof(entries[0]);
+
 } // namespace
 
-InternedStrings::InternedStrings()
-    : sym_to_info_(static_cast<size_t>(_keys::num_symbols)) {
-  // Instead of a loop, this could be done by expanding the
-  // assignments directly into FORALL_NS_SYMBOLS, but it would create
-  // a huge function (thanks to all the std::string constructors and
-  // operator[]s) which would take several minutes to optimize. A
-  // static C array of constexpr-constructible structs takes instead
-  // no time to compile.
-  for (const auto& entry : entries) {
-    string_to_sym_[entry.qual_name] = entry.sym;
-    sym_to_info_[entry.sym] = {
-        entry.ns_sym, entry.qual_name, entry.unqual_name};
+namespace detail {
+
+c10::optional<Symbol> builtin_symbol(const std::string& qual_name) {
+  // The entries table above is constexpr-constructible, so it sits in the
+  // read-only image of the binary and costs nothing to "load". All lookup
+  // needs on top of it is an index sorted by qualified name; building that
+  // once is a sort of ~num_entries integers with no string allocations,
+  // a fraction of what populating a hash map of owned strings used to cost
+  // at startup.
+  static const std::vector<uint32_t> sorted_index = []() {
+    std::vector<uint32_t> index(num_entries);
+    std::iota(index.begin(), index.end(), 0);
+    std::sort(index.begin(), index.end(), [](uint32_t a, uint32_t b) {
+      return std::strcmp(entries[a].qual_name, entries[b].qual_name) < 0;
+    });
+    return index;
+  }();
+  auto it = std::lower_bound(
+      sorted_index.begin(),
+      sorted_index.end(),
+      qual_name.c_str(),
+      [](uint32_t a, const char* b) {
+        return std::strcmp(entries[a].qual_name, b) < 0;
+      });
+  if (it != sorted_index.end() && qual_name == entries[*it].qual_name) {
+    return entries[*it].sym;
   }
+  return c10::nullopt;
+}
+
+} // namespace detail
+
+InternedStrings::InternedStrings() {
+  // Builtin symbols resolve through the static entries table, so there is
+  // nothing to copy into the maps here; they only ever hold symbols
+  // registered at runtime.
 }
 
 } // namespace c10
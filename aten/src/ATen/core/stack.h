@@ -24,6 +24,69 @@ using Operation = std::function<int(Stack&)>;
 //   pc += 1 + offset
 // so a return value of 0 goes to the next instruction
 
+namespace detail {
+// Per-thread freelist backing borrow_stack_from_pool(). Hot boxed-call
+// paths materialize a fresh Stack per invocation; recycling a few
+// pre-sized vectors keeps those calls off the allocator.
+struct StackPool {
+  // More than kMaxPooledStacks simultaneously borrowed stacks (deeply
+  // nested boxed calls) just fall back to plain allocation.
+  static constexpr size_t kMaxPooledStacks = 8;
+  // Covers the argument count of virtually every op schema.
+  static constexpr size_t kPresizedCapacity = 16;
+  std::vector<Stack> freelist;
+};
+inline StackPool& stackPool() {
+  thread_local StackPool pool;
+  return pool;
+}
+} // namespace detail
+
+// Returns an empty Stack, reusing capacity from a previously returned one
+// when available. Pair with return_stack_to_pool (or use PooledStack).
+static inline Stack borrow_stack_from_pool() {
+  auto& pool = detail::stackPool();
+  if (!pool.freelist.empty()) {
+    Stack stack = std::move(pool.freelist.back());
+    pool.freelist.pop_back();
+    return stack;
+  }
+  Stack stack;
+  stack.reserve(detail::StackPool::kPresizedCapacity);
+  return stack;
+}
+
+static inline void return_stack_to_pool(Stack&& stack) {
+  auto& pool = detail::stackPool();
+  if (pool.freelist.size() >= detail::StackPool::kMaxPooledStacks) {
+    return;
+  }
+  // drop the IValues now, keep the capacity for the next borrower
+  stack.clear();
+  pool.freelist.push_back(std::move(stack));
+}
+
+// RAII borrow of a pooled Stack; must stay on the borrowing thread.
+class PooledStack final {
+ public:
+  PooledStack() : stack_(borrow_stack_from_pool()) {}
+  ~PooledStack() {
+    return_stack_to_pool(std::move(stack_));
+  }
+  PooledStack(const PooledStack&) = delete;
+  PooledStack& operator=(const PooledStack&) = delete;
+
+  Stack& operator*() {
+    return stack_;
+  }
+  Stack* operator->() {
+    return &stack_;
+  }
+
+ private:
+  Stack stack_;
+};
+
 // treat the last N elements of the stack as a list, looking up
 // element i
 static inline IValue& peek(Stack& stack, size_t i, size_t N) {
@@ -4,7 +4,10 @@
 
 #include <ATen/cpu/vec256/vec256_base.h>
 #include <ATen/cpu/vec256/vec256_float.h>
+#include <ATen/cpu/vec256/vec512_float.h>
+#include <ATen/cpu/vec256/vec256_bfloat16.h>
 #include <ATen/cpu/vec256/vec256_double.h>
+#include <ATen/cpu/vec256/vec512_double.h>
 #include <ATen/cpu/vec256/vec256_int.h>
 #include <ATen/cpu/vec256/vec256_qint.h>
 #include <ATen/cpu/vec256/vec256_complex_float.h>
@@ -46,7 +49,10 @@ std::ostream& operator<<(std::ostream& stream, const Vec256<T>& vec) {
 }
 
 
-#if defined(__AVX__) && !defined(_MSC_VER)
+// These specializations assume Vec256<float> / Vec256<double> wrap __m256 /
+// __m256d, which is not the case in AVX512 translation units (see
+// vec512_float.h); those fall back to the generic implementations.
+#if defined(__AVX__) && !defined(_MSC_VER) && !defined(CPU_CAPABILITY_AVX512)
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ CAST (AVX) ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
@@ -223,6 +229,6 @@ inline deinterleave2<float>(const Vec256<float>& a, const Vec256<float>& b) {
 
 #endif  // defined(__AVX2__)
 
-#endif // defined(__AVX__) && !defined(_MSC_VER)
+#endif // defined(__AVX__) && !defined(_MSC_VER) && !defined(CPU_CAPABILITY_AVX512)
 
 }}}
@@ -11,7 +11,8 @@ namespace vec256 {
 // See Note [Acceptable use of anonymous namespace in header]
 namespace {
 
-#if defined(__AVX__) && !defined(_MSC_VER)
+// In AVX512 translation units Vec256<double> is 512 bits wide; see vec512_double.h.
+#if defined(__AVX__) && !defined(_MSC_VER) && !defined(CPU_CAPABILITY_AVX512)
 
 template <> class Vec256<double> {
 private:
@@ -269,11 +269,14 @@ inline void convert(const int32_t *src, float *dst, int64_t n) {
 template <>
 inline void convert(const int32_t *src, double *dst, int64_t n) {
   int64_t i;
-  // int32_t has half the size of double
+  // This loop converts 4 elements at a time (128-bit int load, 256-bit double
+  // store) regardless of Vec256<double>::size(), which is wider in AVX512
+  // translation units.
+  constexpr int64_t step = 4;
 #ifndef _MSC_VER
 # pragma unroll
 #endif
-  for (i = 0; i <= (n - Vec256<double>::size()); i += Vec256<double>::size()) {
+  for (i = 0; i <= (n - step); i += step) {
     auto input_128_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
     auto output_vec = _mm256_cvtepi32_pd(input_128_vec);
     _mm256_storeu_pd(reinterpret_cast<double*>(dst + i), output_vec);
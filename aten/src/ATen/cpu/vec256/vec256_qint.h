@@ -9,6 +9,7 @@
 
 
 #include <array>
+#include <limits>
 
 // This file defines Vec256<> for the quantized types.
 //
@@ -37,7 +38,10 @@ namespace at {
 namespace vec256 {
 namespace {
 
-#if defined(__AVX__) && !defined(_MSC_VER)
+// The AVX implementations below hand vectors back and forth as __m256-based
+// Vec256<float>, so AVX512 translation units (where Vec256<float> is 512 bits
+// wide) use the scalar fallback instead.
+#if defined(__AVX__) && !defined(_MSC_VER) && !defined(CPU_CAPABILITY_AVX512)
 
 #if defined(__AVX2__) && defined(__FMA__)
 template <typename T>
@@ -283,6 +287,49 @@ struct Vec256<c10::qint8> {
 #endif
     }
 
+  // Integer-domain addition for operands that share this vector's scale and
+  // zero point: clamp(a + b - zero_point). The intermediate sum is computed
+  // in 16 bits so it cannot overflow before the saturating pack.
+  Vec256<c10::qint8> shifted_add(
+      Vec256<c10::qint8> b,
+      Vec256<c10::qint8> zero_point) const {
+#ifdef __AVX2__
+      __m256i a16_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(vals));
+      __m256i a16_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(vals, 1));
+      __m256i b16_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(b.vals));
+      __m256i b16_hi =
+          _mm256_cvtepi8_epi16(_mm256_extracti128_si256(b.vals, 1));
+      __m256i z16_lo =
+          _mm256_cvtepi8_epi16(_mm256_castsi256_si128(zero_point.vals));
+      __m256i z16_hi =
+          _mm256_cvtepi8_epi16(_mm256_extracti128_si256(zero_point.vals, 1));
+      __m256i sum_lo =
+          _mm256_sub_epi16(_mm256_add_epi16(a16_lo, b16_lo), z16_lo);
+      __m256i sum_hi =
+          _mm256_sub_epi16(_mm256_add_epi16(a16_hi, b16_hi), z16_hi);
+      // packs interleaves the 128-bit lanes; permute them back in order
+      return _mm256_permute4x64_epi64(
+          _mm256_packs_epi16(sum_lo, sum_hi), 0xd8);
+#else
+      // Pray the compiler can autovectorize this
+      int8_t int_vals[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(&int_vals), vals);
+      int8_t b_vals[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(&b_vals), b.vals);
+      int8_t zero_point_vals[size()];
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(&zero_point_vals), zero_point.vals);
+      int8_t result_vals[size()];
+      for (size_t i = 0; i < size(); ++i) {
+        int32_t c = int32_t(int_vals[i]) + b_vals[i] - zero_point_vals[i];
+        result_vals[i] = std::min<int32_t>(
+            std::max<int32_t>(c, std::numeric_limits<int8_t>::min()),
+            std::numeric_limits<int8_t>::max());
+      }
+      return _mm256_loadu_si256(reinterpret_cast<__m256i*>(&result_vals));
+#endif
+    }
+
     Vec256<c10::qint8> relu(Vec256<c10::qint8> zero_point) const {
         return maximum(zero_point);
     }
@@ -471,6 +518,49 @@ struct Vec256<c10::quint8> {
 #endif
     }
 
+  // Integer-domain addition for operands that share this vector's scale and
+  // zero point: clamp(a + b - zero_point). The intermediate sum is computed
+  // in 16 bits so it cannot overflow before the saturating pack.
+  Vec256<c10::quint8> shifted_add(
+      Vec256<c10::quint8> b,
+      Vec256<c10::quint8> zero_point) const {
+#ifdef __AVX2__
+      __m256i a16_lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(vals));
+      __m256i a16_hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(vals, 1));
+      __m256i b16_lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(b.vals));
+      __m256i b16_hi =
+          _mm256_cvtepu8_epi16(_mm256_extracti128_si256(b.vals, 1));
+      __m256i z16_lo =
+          _mm256_cvtepu8_epi16(_mm256_castsi256_si128(zero_point.vals));
+      __m256i z16_hi =
+          _mm256_cvtepu8_epi16(_mm256_extracti128_si256(zero_point.vals, 1));
+      __m256i sum_lo =
+          _mm256_sub_epi16(_mm256_add_epi16(a16_lo, b16_lo), z16_lo);
+      __m256i sum_hi =
+          _mm256_sub_epi16(_mm256_add_epi16(a16_hi, b16_hi), z16_hi);
+      // packus interleaves the 128-bit lanes; permute them back in order
+      return _mm256_permute4x64_epi64(
+          _mm256_packus_epi16(sum_lo, sum_hi), 0xd8);
+#else
+      // Pray the compiler can autovectorize this
+      uint8_t int_vals[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(&int_vals), vals);
+      uint8_t b_vals[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(&b_vals), b.vals);
+      uint8_t zero_point_vals[size()];
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(&zero_point_vals), zero_point.vals);
+      uint8_t result_vals[size()];
+      for (size_t i = 0; i < size(); ++i) {
+        int32_t c = int32_t(int_vals[i]) + b_vals[i] - zero_point_vals[i];
+        result_vals[i] = std::min<int32_t>(
+            std::max<int32_t>(c, std::numeric_limits<uint8_t>::min()),
+            std::numeric_limits<uint8_t>::max());
+      }
+      return _mm256_loadu_si256(reinterpret_cast<__m256i*>(&result_vals));
+#endif
+    }
+
     Vec256<c10::quint8> relu(Vec256<c10::quint8> zero_point) const {
         return maximum(zero_point);
     }
@@ -616,6 +706,32 @@ struct Vec256<c10::qint32> {
 #endif
     }
 
+  // Integer-domain addition for operands that share this vector's scale and
+  // zero point: a + b - zero_point. Unlike the 8-bit variants this does not
+  // saturate; realistic qint32 activations leave ample headroom in 32 bits.
+  Vec256<c10::qint32> shifted_add(
+      Vec256<c10::qint32> b,
+      Vec256<c10::qint32> zero_point) const {
+#ifdef __AVX2__
+      return _mm256_sub_epi32(
+          _mm256_add_epi32(vals, b.vals), zero_point.vals);
+#else
+      // Pray the compiler can autovectorize this
+      int32_t int_vals[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(&int_vals), vals);
+      int32_t b_vals[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(&b_vals), b.vals);
+      int32_t zero_point_vals[size()];
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(&zero_point_vals), zero_point.vals);
+      int32_t result_vals[size()];
+      for (size_t i = 0; i < size(); ++i) {
+        result_vals[i] = int_vals[i] + b_vals[i] - zero_point_vals[i];
+      }
+      return _mm256_loadu_si256(reinterpret_cast<__m256i*>(&result_vals));
+#endif
+    }
+
     Vec256<c10::qint32> relu(Vec256<c10::qint32> zero_point) const {
         return maximum(zero_point);
     }
@@ -784,6 +900,21 @@ struct Vec256<c10::qint8> : public Vec256QuantizedConverter<
     return retval;
   }
 
+  // Integer-domain addition for operands that share this vector's scale and
+  // zero point: clamp(a + b - zero_point).
+  Vec256<c10::qint8> shifted_add(
+      Vec256<c10::qint8> b,
+      Vec256<c10::qint8> zero_point) const {
+    Vec256<c10::qint8> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      int32_t c = int32_t(vals[i]) + b.vals[i] - zero_point.vals[i];
+      retval.vals[i] = std::min<int32_t>(
+          std::max<int32_t>(c, std::numeric_limits<value_type>::min()),
+          std::numeric_limits<value_type>::max());
+    }
+    return retval;
+  }
+
   Vec256<c10::qint8> relu(Vec256<c10::qint8> zero_point) const {
     return maximum(zero_point);
   }
@@ -862,6 +993,21 @@ struct Vec256<c10::quint8> : public Vec256QuantizedConverter<
     return retval;
   }
 
+  // Integer-domain addition for operands that share this vector's scale and
+  // zero point: clamp(a + b - zero_point).
+  Vec256<c10::quint8> shifted_add(
+      Vec256<c10::quint8> b,
+      Vec256<c10::quint8> zero_point) const {
+    Vec256<c10::quint8> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      int32_t c = int32_t(vals[i]) + b.vals[i] - zero_point.vals[i];
+      retval.vals[i] = std::min<int32_t>(
+          std::max<int32_t>(c, std::numeric_limits<value_type>::min()),
+          std::numeric_limits<value_type>::max());
+    }
+    return retval;
+  }
+
   Vec256<c10::quint8> relu(Vec256<c10::quint8> zero_point) const {
     return maximum(zero_point);
   }
@@ -941,6 +1087,18 @@ struct Vec256<c10::qint32> : public Vec256QuantizedConverter<
     return retval;
   }
 
+  // Integer-domain addition for operands that share this vector's scale and
+  // zero point: a + b - zero_point (no saturation, matching the AVX2 path).
+  Vec256<c10::qint32> shifted_add(
+      Vec256<c10::qint32> b,
+      Vec256<c10::qint32> zero_point) const {
+    Vec256<c10::qint32> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = vals[i] + b.vals[i] - zero_point.vals[i];
+    }
+    return retval;
+  }
+
   Vec256<c10::qint32> relu(Vec256<c10::qint32> zero_point) const  {
     return maximum(zero_point);
   }
@@ -966,6 +1124,6 @@ Vec256<c10::qint32> inline maximum(const Vec256<c10::qint32>& a, const Vec256<c1
   return a.maximum(b);
 }
 
-#endif // defined(__AVX__) && !defined(_MSC_VER)
+#endif // defined(__AVX__) && !defined(_MSC_VER) && !defined(CPU_CAPABILITY_AVX512)
 
 }}}
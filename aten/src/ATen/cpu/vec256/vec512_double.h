@@ -0,0 +1,330 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+#include <sleef.h>
+#endif
+
+// 512-bit Vec256<double> for AVX512 translation units; see the comment at
+// the top of vec512_float.h.
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+template <> class Vec256<double> {
+private:
+  __m512d values;
+public:
+  using value_type = double;
+  static constexpr int size() {
+    return 8;
+  }
+  Vec256() {}
+  Vec256(__m512d v) : values(v) {}
+  Vec256(double val) {
+    values = _mm512_set1_pd(val);
+  }
+  Vec256(double val1, double val2, double val3, double val4,
+         double val5, double val6, double val7, double val8) {
+    values = _mm512_setr_pd(val1, val2, val3, val4, val5, val6, val7, val8);
+  }
+  operator __m512d() const {
+    return values;
+  }
+  template <int64_t mask>
+  static Vec256<double> blend(const Vec256<double>& a, const Vec256<double>& b) {
+    return _mm512_mask_blend_pd(static_cast<__mmask8>(mask), a.values, b.values);
+  }
+  static Vec256<double> blendv(const Vec256<double>& a, const Vec256<double>& b,
+                               const Vec256<double>& mask) {
+    // Like _mm256_blendv_pd, select on the most significant bit of each lane.
+    auto msb = _mm512_movepi64_mask(_mm512_castpd_si512(mask.values));
+    return _mm512_mask_blend_pd(msb, a.values, b.values);
+  }
+  static Vec256<double> arange(double base = 0., double step = 1.) {
+    return Vec256<double>(
+      base,            base +     step, base + 2 * step, base + 3 * step,
+      base + 4 * step, base + 5 * step, base + 6 * step, base + 7 * step);
+  }
+  static Vec256<double> set(const Vec256<double>& a, const Vec256<double>& b,
+                            int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    auto mask = static_cast<__mmask8>((1ULL << count) - 1);
+    return _mm512_mask_blend_pd(mask, a.values, b.values);
+  }
+  static Vec256<double> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size())
+      return _mm512_loadu_pd(reinterpret_cast<const double*>(ptr));
+    auto mask = static_cast<__mmask8>((1ULL << count) - 1);
+    return _mm512_maskz_loadu_pd(mask, reinterpret_cast<const double*>(ptr));
+  }
+  void store(void* ptr, int64_t count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_pd(reinterpret_cast<double*>(ptr), values);
+    } else if (count > 0) {
+      auto mask = static_cast<__mmask8>((1ULL << count) - 1);
+      _mm512_mask_storeu_pd(reinterpret_cast<double*>(ptr), mask, values);
+    }
+  }
+  const double& operator[](int idx) const  = delete;
+  double& operator[](int idx) = delete;
+  int zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    return static_cast<int>(_mm512_cmp_pd_mask(values, _mm512_set1_pd(0.0), _CMP_EQ_OQ));
+  }
+  Vec256<double> map(double (*f)(double)) const {
+    __at_align32__ double tmp[8];
+    store(tmp);
+    for (int64_t i = 0; i < 8; i++) {
+      tmp[i] = f(tmp[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec256<double> abs() const {
+    auto mask = _mm512_set1_pd(-0.);
+    return _mm512_andnot_pd(mask, values);
+  }
+  Vec256<double> angle() const {
+    return _mm512_set1_pd(0);
+  }
+  Vec256<double> real() const {
+    return *this;
+  }
+  Vec256<double> imag() const {
+    return _mm512_set1_pd(0);
+  }
+  Vec256<double> conj() const {
+    return *this;
+  }
+  Vec256<double> acos() const {
+    return Vec256<double>(Sleef_acosd8_u10(values));
+  }
+  Vec256<double> asin() const {
+    return Vec256<double>(Sleef_asind8_u10(values));
+  }
+  Vec256<double> atan() const {
+    return Vec256<double>(Sleef_atand8_u10(values));
+  }
+  Vec256<double> atan2(const Vec256<double> &b) const {
+    return Vec256<double>(Sleef_atan2d8_u10(values, b));
+  }
+  Vec256<double> erf() const {
+    return Vec256<double>(Sleef_erfd8_u10(values));
+  }
+  Vec256<double> erfc() const {
+    return Vec256<double>(Sleef_erfcd8_u15(values));
+  }
+  Vec256<double> erfinv() const {
+    return map(calc_erfinv);
+  }
+  Vec256<double> exp() const {
+    return Vec256<double>(Sleef_expd8_u10(values));
+  }
+  Vec256<double> expm1() const {
+    return Vec256<double>(Sleef_expm1d8_u10(values));
+  }
+  Vec256<double> fmod(const Vec256<double>& q) const {
+    return Vec256<double>(Sleef_fmodd8(values, q));
+  }
+  Vec256<double> log() const {
+    return Vec256<double>(Sleef_logd8_u10(values));
+  }
+  Vec256<double> log2() const {
+    return Vec256<double>(Sleef_log2d8_u10(values));
+  }
+  Vec256<double> log10() const {
+    return Vec256<double>(Sleef_log10d8_u10(values));
+  }
+  Vec256<double> log1p() const {
+    return Vec256<double>(Sleef_log1pd8_u10(values));
+  }
+  Vec256<double> sin() const {
+    return Vec256<double>(Sleef_sind8_u10(values));
+  }
+  Vec256<double> sinh() const {
+    return Vec256<double>(Sleef_sinhd8_u10(values));
+  }
+  Vec256<double> cos() const {
+    return Vec256<double>(Sleef_cosd8_u10(values));
+  }
+  Vec256<double> cosh() const {
+    return Vec256<double>(Sleef_coshd8_u10(values));
+  }
+  Vec256<double> ceil() const {
+    return _mm512_ceil_pd(values);
+  }
+  Vec256<double> floor() const {
+    return _mm512_floor_pd(values);
+  }
+  Vec256<double> frac() const;
+  Vec256<double> neg() const {
+    return _mm512_xor_pd(_mm512_set1_pd(-0.), values);
+  }
+  Vec256<double> round() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Vec256<double> tan() const {
+    return Vec256<double>(Sleef_tand8_u10(values));
+  }
+  Vec256<double> tanh() const {
+    return Vec256<double>(Sleef_tanhd8_u10(values));
+  }
+  Vec256<double> trunc() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+  }
+  Vec256<double> lgamma() const {
+    return Vec256<double>(Sleef_lgammad8_u10(values));
+  }
+  Vec256<double> sqrt() const {
+    return _mm512_sqrt_pd(values);
+  }
+  Vec256<double> reciprocal() const {
+    return _mm512_div_pd(_mm512_set1_pd(1), values);
+  }
+  Vec256<double> rsqrt() const {
+    return _mm512_div_pd(_mm512_set1_pd(1), _mm512_sqrt_pd(values));
+  }
+  Vec256<double> pow(const Vec256<double> &b) const {
+    return Vec256<double>(Sleef_powd8_u10(values, b));
+  }
+  // Comparison using the _CMP_**_OQ predicate.
+  //   `O`: get false if an operand is NaN
+  //   `Q`: do not raise if an operand is NaN
+  // AVX512 compares produce a bit mask; expand it back to a vector of
+  // all-ones / all-zeros lanes to keep the Vec256 convention.
+  Vec256<double> operator==(const Vec256<double>& other) const {
+    auto mask = _mm512_cmp_pd_mask(values, other.values, _CMP_EQ_OQ);
+    return _mm512_castsi512_pd(_mm512_movm_epi64(mask));
+  }
+
+  Vec256<double> operator!=(const Vec256<double>& other) const {
+    auto mask = _mm512_cmp_pd_mask(values, other.values, _CMP_NEQ_OQ);
+    return _mm512_castsi512_pd(_mm512_movm_epi64(mask));
+  }
+
+  Vec256<double> operator<(const Vec256<double>& other) const {
+    auto mask = _mm512_cmp_pd_mask(values, other.values, _CMP_LT_OQ);
+    return _mm512_castsi512_pd(_mm512_movm_epi64(mask));
+  }
+
+  Vec256<double> operator<=(const Vec256<double>& other) const {
+    auto mask = _mm512_cmp_pd_mask(values, other.values, _CMP_LE_OQ);
+    return _mm512_castsi512_pd(_mm512_movm_epi64(mask));
+  }
+
+  Vec256<double> operator>(const Vec256<double>& other) const {
+    auto mask = _mm512_cmp_pd_mask(values, other.values, _CMP_GT_OQ);
+    return _mm512_castsi512_pd(_mm512_movm_epi64(mask));
+  }
+
+  Vec256<double> operator>=(const Vec256<double>& other) const {
+    auto mask = _mm512_cmp_pd_mask(values, other.values, _CMP_GE_OQ);
+    return _mm512_castsi512_pd(_mm512_movm_epi64(mask));
+  }
+};
+
+template <>
+Vec256<double> inline operator+(const Vec256<double>& a, const Vec256<double>& b) {
+  return _mm512_add_pd(a, b);
+}
+
+template <>
+Vec256<double> inline operator-(const Vec256<double>& a, const Vec256<double>& b) {
+  return _mm512_sub_pd(a, b);
+}
+
+template <>
+Vec256<double> inline operator*(const Vec256<double>& a, const Vec256<double>& b) {
+  return _mm512_mul_pd(a, b);
+}
+
+template <>
+Vec256<double> inline operator/(const Vec256<double>& a, const Vec256<double>& b) {
+  return _mm512_div_pd(a, b);
+}
+
+// frac. Implement this here so we can use subtraction.
+Vec256<double> Vec256<double>::frac() const {
+  return *this - this->trunc();
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec256<double> inline maximum(const Vec256<double>& a, const Vec256<double>& b) {
+  Vec256<double> max = _mm512_max_pd(a, b);
+  auto unord = _mm512_cmp_pd_mask(a, b, _CMP_UNORD_Q);
+  Vec256<double> isnan = _mm512_castsi512_pd(_mm512_movm_epi64(unord));
+  // Exploit the fact that all-ones is a NaN.
+  return _mm512_or_pd(max, isnan);
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec256<double> inline minimum(const Vec256<double>& a, const Vec256<double>& b) {
+  Vec256<double> min = _mm512_min_pd(a, b);
+  auto unord = _mm512_cmp_pd_mask(a, b, _CMP_UNORD_Q);
+  Vec256<double> isnan = _mm512_castsi512_pd(_mm512_movm_epi64(unord));
+  // Exploit the fact that all-ones is a NaN.
+  return _mm512_or_pd(min, isnan);
+}
+
+template <>
+Vec256<double> inline clamp(const Vec256<double>& a, const Vec256<double>& min, const Vec256<double>& max) {
+  return _mm512_min_pd(max, _mm512_max_pd(min, a));
+}
+
+template <>
+Vec256<double> inline clamp_min(const Vec256<double>& a, const Vec256<double>& min) {
+  return _mm512_max_pd(min, a);
+}
+
+template <>
+Vec256<double> inline clamp_max(const Vec256<double>& a, const Vec256<double>& max) {
+  return _mm512_min_pd(max, a);
+}
+
+template <>
+Vec256<double> inline operator&(const Vec256<double>& a, const Vec256<double>& b) {
+  return _mm512_and_pd(a, b);
+}
+
+template <>
+Vec256<double> inline operator|(const Vec256<double>& a, const Vec256<double>& b) {
+  return _mm512_or_pd(a, b);
+}
+
+template <>
+Vec256<double> inline operator^(const Vec256<double>& a, const Vec256<double>& b) {
+  return _mm512_xor_pd(a, b);
+}
+
+template <>
+inline void convert(const double* src, double* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vec256<double>::size()); i += Vec256<double>::size()) {
+    _mm512_storeu_pd(dst + i, _mm512_loadu_pd(src + i));
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = src[i];
+  }
+}
+
+template <>
+Vec256<double> inline fmadd(const Vec256<double>& a, const Vec256<double>& b, const Vec256<double>& c) {
+  return _mm512_fmadd_pd(a, b, c);
+}
+
+#endif
+
+}}}
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+#include <sleef.h>
+#endif
+
+// 512-bit Vec256<float>, used only in translation units compiled for the
+// opt-in AVX512 capability (see Note [Per-op AVX512 opt-in] in
+// native/DispatchStub.h). The class keeps the Vec256 name because all of the
+// kernel machinery (Loops.h, Reduce.h, functional.h) is written against
+// Vec256<T> and is width-agnostic via Vec256<T>::size(); inside an AVX512
+// translation unit the "256" in the name is historical.
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+template <> class Vec256<float> {
+private:
+  __m512 values;
+public:
+  using value_type = float;
+  static constexpr int size() {
+    return 16;
+  }
+  Vec256() {}
+  Vec256(__m512 v) : values(v) {}
+  Vec256(float val) {
+    values = _mm512_set1_ps(val);
+  }
+  Vec256(float val1, float val2, float val3, float val4,
+         float val5, float val6, float val7, float val8,
+         float val9, float val10, float val11, float val12,
+         float val13, float val14, float val15, float val16) {
+    values = _mm512_setr_ps(val1, val2, val3, val4, val5, val6, val7, val8,
+                            val9, val10, val11, val12, val13, val14, val15, val16);
+  }
+  operator __m512() const {
+    return values;
+  }
+  template <int64_t mask>
+  static Vec256<float> blend(const Vec256<float>& a, const Vec256<float>& b) {
+    return _mm512_mask_blend_ps(static_cast<__mmask16>(mask), a.values, b.values);
+  }
+  static Vec256<float> blendv(const Vec256<float>& a, const Vec256<float>& b,
+                              const Vec256<float>& mask) {
+    // Like _mm256_blendv_ps, select on the most significant bit of each lane.
+    auto msb = _mm512_movepi32_mask(_mm512_castps_si512(mask.values));
+    return _mm512_mask_blend_ps(msb, a.values, b.values);
+  }
+  static Vec256<float> arange(float base = 0.f, float step = 1.f) {
+    return Vec256<float>(
+      base,             base +      step, base +  2 * step, base +  3 * step,
+      base +  4 * step, base +  5 * step, base +  6 * step, base +  7 * step,
+      base +  8 * step, base +  9 * step, base + 10 * step, base + 11 * step,
+      base + 12 * step, base + 13 * step, base + 14 * step, base + 15 * step);
+  }
+  static Vec256<float> set(const Vec256<float>& a, const Vec256<float>& b,
+                           int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    // Unlike AVX2, blending with a runtime mask needs no template dispatch.
+    auto mask = static_cast<__mmask16>((1ULL << count) - 1);
+    return _mm512_mask_blend_ps(mask, a.values, b.values);
+  }
+  static Vec256<float> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size())
+      return _mm512_loadu_ps(reinterpret_cast<const float*>(ptr));
+    // The masked lanes never touch memory, so there is no need to stage the
+    // tail through a zeroed buffer the way the AVX2 version does.
+    auto mask = static_cast<__mmask16>((1ULL << count) - 1);
+    return _mm512_maskz_loadu_ps(mask, reinterpret_cast<const float*>(ptr));
+  }
+  void store(void* ptr, int64_t count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_ps(reinterpret_cast<float*>(ptr), values);
+    } else if (count > 0) {
+      auto mask = static_cast<__mmask16>((1ULL << count) - 1);
+      _mm512_mask_storeu_ps(reinterpret_cast<float*>(ptr), mask, values);
+    }
+  }
+  const float& operator[](int idx) const  = delete;
+  float& operator[](int idx) = delete;
+  int zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    return static_cast<int>(_mm512_cmp_ps_mask(values, _mm512_set1_ps(0.0f), _CMP_EQ_OQ));
+  }
+  Vec256<float> map(float (*f)(float)) const {
+    __at_align32__ float tmp[16];
+    store(tmp);
+    for (int64_t i = 0; i < 16; i++) {
+      tmp[i] = f(tmp[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec256<float> abs() const {
+    auto mask = _mm512_set1_ps(-0.f);
+    return _mm512_andnot_ps(mask, values);
+  }
+  Vec256<float> angle() const {
+    return _mm512_set1_ps(0);
+  }
+  Vec256<float> real() const {
+    return *this;
+  }
+  Vec256<float> imag() const {
+    return _mm512_set1_ps(0);
+  }
+  Vec256<float> conj() const {
+    return *this;
+  }
+  Vec256<float> acos() const {
+    return Vec256<float>(Sleef_acosf16_u10(values));
+  }
+  Vec256<float> asin() const {
+    return Vec256<float>(Sleef_asinf16_u10(values));
+  }
+  Vec256<float> atan() const {
+    return Vec256<float>(Sleef_atanf16_u10(values));
+  }
+  Vec256<float> atan2(const Vec256<float> &b) const {
+    return Vec256<float>(Sleef_atan2f16_u10(values, b));
+  }
+  Vec256<float> erf() const {
+    return Vec256<float>(Sleef_erff16_u10(values));
+  }
+  Vec256<float> erfc() const {
+    return Vec256<float>(Sleef_erfcf16_u15(values));
+  }
+  Vec256<float> erfinv() const {
+    return map(calc_erfinv);
+  }
+  Vec256<float> exp() const {
+    return Vec256<float>(Sleef_expf16_u10(values));
+  }
+  Vec256<float> expm1() const {
+    return Vec256<float>(Sleef_expm1f16_u10(values));
+  }
+  Vec256<float> fmod(const Vec256<float>& q) const {
+    return Vec256<float>(Sleef_fmodf16(values, q));
+  }
+  Vec256<float> log() const {
+    return Vec256<float>(Sleef_logf16_u10(values));
+  }
+  Vec256<float> log2() const {
+    return Vec256<float>(Sleef_log2f16_u10(values));
+  }
+  Vec256<float> log10() const {
+    return Vec256<float>(Sleef_log10f16_u10(values));
+  }
+  Vec256<float> log1p() const {
+    return Vec256<float>(Sleef_log1pf16_u10(values));
+  }
+  Vec256<float> frac() const;
+  Vec256<float> sin() const {
+    return Vec256<float>(Sleef_sinf16_u10(values));
+  }
+  Vec256<float> sinh() const {
+    return Vec256<float>(Sleef_sinhf16_u10(values));
+  }
+  Vec256<float> cos() const {
+    return Vec256<float>(Sleef_cosf16_u10(values));
+  }
+  Vec256<float> cosh() const {
+    return Vec256<float>(Sleef_coshf16_u10(values));
+  }
+  Vec256<float> ceil() const {
+    return _mm512_ceil_ps(values);
+  }
+  Vec256<float> floor() const {
+    return _mm512_floor_ps(values);
+  }
+  Vec256<float> neg() const {
+    return _mm512_xor_ps(_mm512_set1_ps(-0.f), values);
+  }
+  Vec256<float> round() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Vec256<float> tan() const {
+    return Vec256<float>(Sleef_tanf16_u10(values));
+  }
+  Vec256<float> tanh() const {
+    return Vec256<float>(Sleef_tanhf16_u10(values));
+  }
+  Vec256<float> trunc() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+  }
+  Vec256<float> lgamma() const {
+    return Vec256<float>(Sleef_lgammaf16_u10(values));
+  }
+  Vec256<float> sqrt() const {
+    return _mm512_sqrt_ps(values);
+  }
+  Vec256<float> reciprocal() const {
+    return _mm512_div_ps(_mm512_set1_ps(1), values);
+  }
+  Vec256<float> rsqrt() const {
+    return _mm512_div_ps(_mm512_set1_ps(1), _mm512_sqrt_ps(values));
+  }
+  Vec256<float> pow(const Vec256<float> &b) const {
+    return Vec256<float>(Sleef_powf16_u10(values, b));
+  }
+  // Comparison using the _CMP_**_OQ predicate.
+  //   `O`: get false if an operand is NaN
+  //   `Q`: do not raise if an operand is NaN
+  // AVX512 compares produce a bit mask; expand it back to a vector of
+  // all-ones / all-zeros lanes to keep the Vec256 convention.
+  Vec256<float> operator==(const Vec256<float>& other) const {
+    auto mask = _mm512_cmp_ps_mask(values, other.values, _CMP_EQ_OQ);
+    return _mm512_castsi512_ps(_mm512_movm_epi32(mask));
+  }
+
+  Vec256<float> operator!=(const Vec256<float>& other) const {
+    auto mask = _mm512_cmp_ps_mask(values, other.values, _CMP_NEQ_OQ);
+    return _mm512_castsi512_ps(_mm512_movm_epi32(mask));
+  }
+
+  Vec256<float> operator<(const Vec256<float>& other) const {
+    auto mask = _mm512_cmp_ps_mask(values, other.values, _CMP_LT_OQ);
+    return _mm512_castsi512_ps(_mm512_movm_epi32(mask));
+  }
+
+  Vec256<float> operator<=(const Vec256<float>& other) const {
+    auto mask = _mm512_cmp_ps_mask(values, other.values, _CMP_LE_OQ);
+    return _mm512_castsi512_ps(_mm512_movm_epi32(mask));
+  }
+
+  Vec256<float> operator>(const Vec256<float>& other) const {
+    auto mask = _mm512_cmp_ps_mask(values, other.values, _CMP_GT_OQ);
+    return _mm512_castsi512_ps(_mm512_movm_epi32(mask));
+  }
+
+  Vec256<float> operator>=(const Vec256<float>& other) const {
+    auto mask = _mm512_cmp_ps_mask(values, other.values, _CMP_GE_OQ);
+    return _mm512_castsi512_ps(_mm512_movm_epi32(mask));
+  }
+};
+
+template <>
+Vec256<float> inline operator+(const Vec256<float>& a, const Vec256<float>& b) {
+  return _mm512_add_ps(a, b);
+}
+
+template <>
+Vec256<float> inline operator-(const Vec256<float>& a, const Vec256<float>& b) {
+  return _mm512_sub_ps(a, b);
+}
+
+template <>
+Vec256<float> inline operator*(const Vec256<float>& a, const Vec256<float>& b) {
+  return _mm512_mul_ps(a, b);
+}
+
+template <>
+Vec256<float> inline operator/(const Vec256<float>& a, const Vec256<float>& b) {
+  return _mm512_div_ps(a, b);
+}
+
+// frac. Implement this here so we can use subtraction
+Vec256<float> Vec256<float>::frac() const {
+  return *this - this->trunc();
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec256<float> inline maximum(const Vec256<float>& a, const Vec256<float>& b) {
+  Vec256<float> max = _mm512_max_ps(a, b);
+  auto unord = _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q);
+  Vec256<float> isnan = _mm512_castsi512_ps(_mm512_movm_epi32(unord));
+  // Exploit the fact that all-ones is a NaN.
+  return _mm512_or_ps(max, isnan);
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec256<float> inline minimum(const Vec256<float>& a, const Vec256<float>& b) {
+  Vec256<float> min = _mm512_min_ps(a, b);
+  auto unord = _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q);
+  Vec256<float> isnan = _mm512_castsi512_ps(_mm512_movm_epi32(unord));
+  // Exploit the fact that all-ones is a NaN.
+  return _mm512_or_ps(min, isnan);
+}
+
+template <>
+Vec256<float> inline clamp(const Vec256<float>& a, const Vec256<float>& min, const Vec256<float>& max) {
+  return _mm512_min_ps(max, _mm512_max_ps(min, a));
+}
+
+template <>
+Vec256<float> inline clamp_max(const Vec256<float>& a, const Vec256<float>& max) {
+  return _mm512_min_ps(max, a);
+}
+
+template <>
+Vec256<float> inline clamp_min(const Vec256<float>& a, const Vec256<float>& min) {
+  return _mm512_max_ps(min, a);
+}
+
+template <>
+Vec256<float> inline operator&(const Vec256<float>& a, const Vec256<float>& b) {
+  return _mm512_and_ps(a, b);
+}
+
+template <>
+Vec256<float> inline operator|(const Vec256<float>& a, const Vec256<float>& b) {
+  return _mm512_or_ps(a, b);
+}
+
+template <>
+Vec256<float> inline operator^(const Vec256<float>& a, const Vec256<float>& b) {
+  return _mm512_xor_ps(a, b);
+}
+
+template <>
+inline void convert(const float* src, float* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vec256<float>::size()); i += Vec256<float>::size()) {
+    _mm512_storeu_ps(dst + i, _mm512_loadu_ps(src + i));
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = src[i];
+  }
+}
+
+template <>
+Vec256<float> inline fmadd(const Vec256<float>& a, const Vec256<float>& b, const Vec256<float>& c) {
+  return _mm512_fmadd_ps(a, b, c);
+}
+
+#endif
+
+}}}
@@ -67,6 +67,25 @@ inline void vrsqrt(scalar_t* out, scalar_t* in, int64_t size) {
   });
 }
 
+// Not a single cmath function, so it cannot go through the IMPLEMENT_VML
+// macros below; with MKL the exp (the expensive part) is replaced by a
+// batched VML call, see IMPLEMENT_VML_MKL_SIGMOID.
+template <typename scalar_t>
+inline void vsigmoid(scalar_t* out, const scalar_t* in, int64_t size) {
+  DL_RUNTIME_BUG(exp, scalar_t)
+  parallel_for(0, size, 2048, [out, in](int64_t begin, int64_t end) {
+    map(
+        [](const Vec256<scalar_t>& x) {
+          auto one = Vec256<scalar_t>((scalar_t)(1));
+          return (one + (Vec256<scalar_t>((scalar_t)(0)) - x).exp())
+              .reciprocal();
+        },
+        out + begin,
+        in + begin,
+        end - begin);
+  });
+}
+
 // NB: We ignore numerical errors by convention and leave them to the user
 
 // We unfortunately need to duplicate code here to deal with the SSE-AVX
@@ -193,6 +212,43 @@ IMPLEMENT_VML_MKL(trunc, Trunc)
 IMPLEMENT_VML_MKL(log2, Log2)
 #endif
 
+// MKL has no sigmoid entry point, so stage through a chunk buffer: negate
+// with Vec256, hand the chunk to batched VML exp, finish with Vec256. The
+// chunk size matches the buffered strided loop in UnaryOpsKernel.cpp and
+// stays well within MKL_INT.
+#define IMPLEMENT_VML_MKL_SIGMOID(type, mkltype)                          \
+  template <>                                                             \
+  inline void vsigmoid(type* out, const type* in, int64_t size) {         \
+    parallel_for(0, size, 2048, [out, in](int64_t begin, int64_t end) {   \
+      static constexpr int64_t WIDTH = 131072 / sizeof(type);             \
+      for (int64_t i = begin; i < end; i += WIDTH) {                      \
+        type buffer[WIDTH];                                               \
+        int64_t width = WIDTH;                                            \
+        width = std::min(width, end - i);                                 \
+        map(                                                              \
+            [](const Vec256<type>& x) {                                   \
+              return Vec256<type>((type)(0)) - x;                         \
+            },                                                            \
+            buffer,                                                       \
+            in + i,                                                       \
+            width);                                                       \
+        vm##mkltype##Exp(                                                 \
+            width, buffer, buffer,                                        \
+            VML_HA | VML_FTZDAZ_OFF | VML_ERRMODE_IGNORE);                \
+        map(                                                              \
+            [](const Vec256<type>& x) {                                   \
+              return (Vec256<type>((type)(1)) + x).reciprocal();          \
+            },                                                            \
+            out + i,                                                      \
+            buffer,                                                       \
+            width);                                                       \
+      }                                                                   \
+    });                                                                   \
+  }
+
+IMPLEMENT_VML_MKL_SIGMOID(float, s)
+IMPLEMENT_VML_MKL_SIGMOID(double, d)
+
 #endif
 
 } // namespace
@@ -10,7 +10,10 @@
 #include <cuda_runtime_api.h>
 
 #include <cstdint>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace at { namespace cuda {
 
@@ -115,12 +118,19 @@ struct TORCH_CUDA_API CUDAEvent {
     CUDAGuard guard(device_index_);
     AT_CUDA_CHECK(cudaEventRecord(event_, stream));
     was_recorded_ = true;
+    last_recorded_stream_id_ = stream.id();
   }
 
   // Note: cudaStreamWaitEvent must be called on the same device as the stream.
   // The event has no actual GPU resources associated with it.
   void block(const CUDAStream& stream) {
     if (is_created_) {
+      // Waiting on an event that was last recorded on this very stream is
+      // already guaranteed by stream ordering; skip the driver call.
+      if (was_recorded_ && stream.device_index() == device_index_ &&
+          stream.id() == last_recorded_stream_id_) {
+        return;
+      }
       CUDAGuard guard(stream.device_index());
       AT_CUDA_CHECK(cudaStreamWaitEvent(stream, event_, 0));
     }
@@ -163,6 +173,7 @@ private:
   bool is_created_ = false;
   bool was_recorded_ = false;
   DeviceIndex device_index_ = -1;
+  c10::StreamId last_recorded_stream_id_ = -1;
   cudaEvent_t event_;
 
   void createEvent(DeviceIndex device_index) {
@@ -177,9 +188,99 @@ private:
     std::swap(is_created_, other.is_created_);
     std::swap(was_recorded_, other.was_recorded_);
     std::swap(device_index_, other.device_index_);
+    std::swap(last_recorded_stream_id_, other.last_recorded_stream_id_);
     std::swap(event_, other.event_);
   }
 };
 
+/*
+* A per-device freelist of recycled CUDAEvents.
+*
+* cudaEventCreate/cudaEventDestroy cost a couple of microseconds each, which
+* dominates fine-grained cross-stream synchronization such as the two events
+* recorded per cross-device copy. acquire() hands out a previously created
+* event for the device when one is available; the handle returns it to the
+* freelist when it goes out of scope, so steady-state use creates no events.
+*
+* Returning a still-pending event to the pool is fine: the next record()
+* simply overwrites the event's state, and waits that were already enqueued
+* against the old state are unaffected.
+*
+* The pool only manages events created with the default flags
+* (cudaEventDisableTiming); callers that need timing must construct their
+* own CUDAEvent.
+*/
+class CUDAEventPool {
+public:
+  class Handle {
+  public:
+    Handle(CUDAEventPool* pool, CUDAEvent event)
+        : pool_(pool), event_(std::move(event)) {}
+
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+
+    Handle(Handle&& other)
+        : pool_(other.pool_), event_(std::move(other.event_)) {
+      other.pool_ = nullptr;
+    }
+
+    ~Handle() {
+      if (pool_) {
+        pool_->release(std::move(event_));
+      }
+    }
+
+    CUDAEvent& event() {
+      return event_;
+    }
+
+  private:
+    CUDAEventPool* pool_;
+    CUDAEvent event_;
+  };
+
+  // Returns an event for the given device, recycled if possible. The event
+  // may have been recorded before; record() overwrites its state.
+  Handle acquire(DeviceIndex device_index) {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      auto it = free_lists_.find(device_index);
+      if (it != free_lists_.end() && !it->second.empty()) {
+        CUDAEvent event = std::move(it->second.back());
+        it->second.pop_back();
+        return Handle(this, std::move(event));
+      }
+    }
+    // The event is created lazily on first record(), which must happen on
+    // device_index for it to land back in that device's freelist.
+    return Handle(this, CUDAEvent());
+  }
+
+private:
+  // Bounds the number of idle events retained per device; events released
+  // beyond the cap are destroyed as before.
+  constexpr static size_t kMaxIdleEventsPerDevice = 64;
+
+  void release(CUDAEvent event) {
+    if (!event.isCreated()) {
+      return;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto& free_list = free_lists_[event.device_index()];
+    if (free_list.size() < kMaxIdleEventsPerDevice) {
+      free_list.push_back(std::move(event));
+    }
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<DeviceIndex, std::vector<CUDAEvent>> free_lists_;
+};
+
+inline CUDAEventPool& getCUDAEventPool() {
+  static CUDAEventPool pool;
+  return pool;
+}
+
 } // namespace cuda
 } // namespace at
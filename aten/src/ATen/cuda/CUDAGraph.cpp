@@ -0,0 +1,87 @@
+#include <ATen/cuda/CUDAGraph.h>
+
+#include <ATen/cuda/Exceptions.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/util/Exception.h>
+
+namespace at { namespace cuda {
+
+void CUDAGraph::capture_begin() {
+#if AT_CUDA_GRAPHS_SUPPORTED()
+  TORCH_CHECK(!capturing_, "CUDAGraph::capture_begin: capture is already in progress");
+  TORCH_CHECK(
+      !has_graph_exec_,
+      "CUDAGraph::capture_begin: this CUDAGraph already holds a captured graph; call reset() first");
+  auto stream = getCurrentCUDAStream();
+  TORCH_CHECK(
+      stream != getDefaultCUDAStream(),
+      "CUDAGraph::capture_begin: capture must run on a non-default stream "
+      "(the default stream synchronizes implicitly and cannot be captured)");
+  capture_stream_ = stream;
+  capture_device_ = stream.device_index();
+  // ThreadLocal mode: only work submitted by this thread is captured, so
+  // other threads can keep launching on their own streams during capture.
+  AT_CUDA_CHECK(cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal));
+  capturing_ = true;
+#else
+  AT_ERROR("CUDA graphs require CUDA >= 10.1");
+#endif
+}
+
+void CUDAGraph::capture_end() {
+#if AT_CUDA_GRAPHS_SUPPORTED()
+  TORCH_CHECK(capturing_, "CUDAGraph::capture_end: no capture in progress");
+  AT_CUDA_CHECK(cudaStreamEndCapture(*capture_stream_, &graph_));
+  capturing_ = false;
+  TORCH_CHECK(graph_ != nullptr, "CUDAGraph::capture_end: capture produced an empty graph");
+  AT_CUDA_CHECK(cudaGraphInstantiate(
+      &graph_exec_, graph_, /*pErrorNode=*/nullptr, /*pLogBuffer=*/nullptr, /*bufferSize=*/0));
+  has_graph_exec_ = true;
+#else
+  AT_ERROR("CUDA graphs require CUDA >= 10.1");
+#endif
+}
+
+void CUDAGraph::replay() {
+#if AT_CUDA_GRAPHS_SUPPORTED()
+  TORCH_CHECK(
+      has_graph_exec_,
+      "CUDAGraph::replay: no graph has been captured; call capture_begin/capture_end first");
+  CUDAGuard guard(capture_device_);
+  AT_CUDA_CHECK(cudaGraphLaunch(graph_exec_, getCurrentCUDAStream()));
+#else
+  AT_ERROR("CUDA graphs require CUDA >= 10.1");
+#endif
+}
+
+void CUDAGraph::reset() {
+#if AT_CUDA_GRAPHS_SUPPORTED()
+  TORCH_CHECK(!capturing_, "CUDAGraph::reset: cannot reset while a capture is in progress");
+  if (has_graph_exec_) {
+    CUDAGuard guard(capture_device_);
+    AT_CUDA_CHECK(cudaGraphExecDestroy(graph_exec_));
+    AT_CUDA_CHECK(cudaGraphDestroy(graph_));
+    graph_exec_ = nullptr;
+    graph_ = nullptr;
+    has_graph_exec_ = false;
+  }
+  capture_stream_ = c10::nullopt;
+  capture_device_ = -1;
+#endif
+}
+
+// Note: graph destruction done on the capturing device to avoid creating a
+// CUDA context on other devices (cf. ~CUDAEvent).
+CUDAGraph::~CUDAGraph() {
+#if AT_CUDA_GRAPHS_SUPPORTED()
+  try {
+    if (has_graph_exec_) {
+      CUDAGuard guard(capture_device_);
+      cudaGraphExecDestroy(graph_exec_);
+      cudaGraphDestroy(graph_);
+    }
+  } catch (...) { /* No throw */ }
+#endif
+}
+
+}} // namespace at::cuda
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <ATen/cuda/ATenCUDAGeneral.h>
+#include <c10/core/Device.h>
+#include <c10/cuda/CUDAStream.h>
+#include <c10/util/Optional.h>
+
+#include <cuda_runtime_api.h>
+
+namespace at { namespace cuda {
+
+// CUDA graphs need the capture API introduced in CUDA 10.1
+#if !defined(__HIP_PLATFORM_HCC__) && defined(CUDA_VERSION) && \
+    CUDA_VERSION >= 10010
+#define AT_CUDA_GRAPHS_SUPPORTED() 1
+#else
+#define AT_CUDA_GRAPHS_SUPPORTED() 0
+#endif
+
+/*
+* CUDAGraph records every kernel launched on a stream between capture_begin()
+* and capture_end() into a CUDA graph, and replay() re-submits the whole
+* batch with a single cudaGraphLaunch. For workloads that launch hundreds of
+* tiny kernels per iteration (e.g. a scripted forward at batch size 1),
+* this removes per-kernel launch latency from the critical path.
+*
+* Replay re-issues the captured kernels with their captured arguments, so
+* every device address the work reads or writes is frozen at capture time.
+* The intended pattern for repeated inference is therefore:
+*
+*   1. Allocate persistent input/output tensors ("placeholders") and run the
+*      forward once normally so lazily-initialized state (cuDNN plans,
+*      allocator blocks) exists before capture.
+*   2. On a non-default stream: capture_begin(); run the forward on the
+*      placeholder inputs; capture_end().
+*   3. Per request: copy the new batch into the input placeholders (their
+*      addresses are baked into the graph), call replay() on the stream the
+*      work should run on, and read the results from the output placeholders.
+*
+* Capture must run on a non-default stream, and nothing else may use that
+* stream while a capture is open. CUDAGraph requires CUDA >= 10.1; the
+* methods raise errors on older toolkits and on HIP.
+*/
+struct TORCH_CUDA_API CUDAGraph {
+  CUDAGraph() = default;
+  ~CUDAGraph();
+
+  CUDAGraph(const CUDAGraph&) = delete;
+  CUDAGraph& operator=(const CUDAGraph&) = delete;
+
+  // Starts capturing work submitted to the current stream.
+  void capture_begin();
+  // Ends capture and instantiates the executable graph.
+  void capture_end();
+  // Launches the captured graph on the current stream.
+  void replay();
+  // Discards the captured graph so the object can capture again.
+  void reset();
+
+  bool has_graph() const {
+    return has_graph_exec_;
+  }
+
+ private:
+#if AT_CUDA_GRAPHS_SUPPORTED()
+  cudaGraph_t graph_ = nullptr;
+  cudaGraphExec_t graph_exec_ = nullptr;
+#endif
+  bool capturing_ = false;
+  bool has_graph_exec_ = false;
+  c10::optional<CUDAStream> capture_stream_;
+  DeviceIndex capture_device_ = -1;
+};
+
+}} // namespace at::cuda
@@ -0,0 +1,102 @@
+#include <ATen/cuda/ScalarReadback.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/PinnedMemoryAllocator.h>
+#include <THC/THCCachingHostAllocator.h>
+
+namespace at {
+namespace cuda {
+
+namespace {
+// Every slot is 8-byte aligned; scalars are at most 8 bytes.
+constexpr size_t kSlotSize = 8;
+} // namespace
+
+bool ScalarFuture::ready() const {
+  return waited_ || event_.query();
+}
+
+void ScalarFuture::wait() {
+  if (!waited_) {
+    event_.synchronize();
+    waited_ = true;
+  }
+}
+
+Scalar ScalarFuture::get(size_t i) {
+  wait();
+  TORCH_CHECK(
+      i < dtypes_.size(),
+      "ScalarFuture holds ",
+      dtypes_.size(),
+      " scalars, but index ",
+      i,
+      " was requested");
+  Scalar r;
+  const void* src = static_cast<const char*>(staging_.get()) + offsets_[i];
+  AT_DISPATCH_ALL_TYPES_AND3(
+      at::ScalarType::Half,
+      at::ScalarType::Bool,
+      at::ScalarType::BFloat16,
+      dtypes_[i],
+      "scalar_future_get",
+      [&] { r = Scalar(*static_cast<const scalar_t*>(src)); });
+  return r;
+}
+
+std::vector<Scalar> ScalarFuture::values() {
+  std::vector<Scalar> result;
+  result.reserve(size());
+  for (size_t i = 0; i < size(); ++i) {
+    result.push_back(get(i));
+  }
+  return result;
+}
+
+ScalarFuture items_async(TensorList tensors) {
+  TORCH_CHECK(!tensors.empty(), "items_async expects at least one tensor");
+  ScalarFuture future;
+  future.dtypes_.reserve(tensors.size());
+  future.offsets_.reserve(tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    const auto& t = tensors[i];
+    TORCH_CHECK(
+        t.is_cuda(), "items_async expects CUDA tensors, got ", t.device());
+    TORCH_CHECK(
+        t.numel() == 1,
+        "items_async expects one-element tensors, but tensor ",
+        i,
+        " has ",
+        t.numel(),
+        " elements");
+    future.dtypes_.push_back(t.scalar_type());
+    future.offsets_.push_back(i * kSlotSize);
+  }
+
+  future.staging_ =
+      getPinnedMemoryAllocator()->allocate(tensors.size() * kSlotSize);
+  auto stream = getCurrentCUDAStream();
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    void* dst = static_cast<char*>(future.staging_.get()) + future.offsets_[i];
+    AT_CUDA_CHECK(cudaMemcpyAsync(
+        dst,
+        tensors[i].data_ptr(),
+        tensors[i].element_size(),
+        cudaMemcpyDeviceToHost,
+        stream));
+  }
+  // Keep the caching host allocator from recycling the staging buffer
+  // until the copies are done, even if the future is dropped early.
+  AT_CUDA_CHECK(
+      THCCachingHostAllocator_recordEvent(future.staging_.get(), stream));
+  future.event_.record(stream);
+  return future;
+}
+
+ScalarFuture item_async(const Tensor& self) {
+  return items_async(self);
+}
+
+} // namespace cuda
+} // namespace at
@@ -0,0 +1,65 @@
+#pragma once
+
+// Asynchronous scalar readback for training-loop telemetry.
+//
+// Tensor::item() on a CUDA tensor synchronizes the current stream for every
+// scalar, so reading a loss and a couple of metrics each step serializes
+// the pipeline. item_async()/items_async() instead enqueue the D2H copies
+// into a pinned staging buffer on the current stream, record an event, and
+// return a ScalarFuture. The stream keeps running; get() blocks the host
+// only until the event completes - typically not at all if the future is
+// consumed a step later:
+//
+//   auto loss_f = at::cuda::item_async(loss);
+//   auto metrics_f = at::cuda::items_async({correct, total});
+//   ... launch the next step ...
+//   double loss_val = loss_f.get().toDouble();
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAEvent.h>
+
+#include <vector>
+
+namespace at {
+namespace cuda {
+
+class TORCH_CUDA_API ScalarFuture {
+ public:
+  ScalarFuture(ScalarFuture&&) = default;
+  ScalarFuture& operator=(ScalarFuture&&) = default;
+  ScalarFuture(const ScalarFuture&) = delete;
+  ScalarFuture& operator=(const ScalarFuture&) = delete;
+
+  // True once the copies have completed and get() will not block.
+  bool ready() const;
+  // Blocks the host (never the stream) until the copies have completed.
+  void wait();
+  // Returns the i-th scalar, waiting if necessary.
+  Scalar get(size_t i = 0);
+  // Returns all scalars, waiting if necessary.
+  std::vector<Scalar> values();
+
+  size_t size() const {
+    return dtypes_.size();
+  }
+
+ private:
+  ScalarFuture() = default;
+  friend TORCH_CUDA_API ScalarFuture items_async(TensorList tensors);
+
+  DataPtr staging_;
+  CUDAEvent event_;
+  std::vector<ScalarType> dtypes_;
+  std::vector<size_t> offsets_;
+  bool waited_ = false;
+};
+
+// Begins an asynchronous read of a one-element CUDA tensor.
+TORCH_CUDA_API ScalarFuture item_async(const Tensor& self);
+
+// Begins an asynchronous read of several one-element CUDA tensors through
+// a single staging buffer and event.
+TORCH_CUDA_API ScalarFuture items_async(TensorList tensors);
+
+} // namespace cuda
+} // namespace at
@@ -11,6 +11,7 @@
 #include <ATen/cuda/nvrtc_stub/ATenNVRTC.h>
 #include <ATen/detail/CUDAHooksInterface.h>
 #include <ATen/native/cuda/CuFFTPlanCache.h>
+#include <c10/cuda/CUDAStream.h>
 #include <c10/util/Exception.h>
 
 #include <THC/THC.h>
@@ -151,6 +152,11 @@ int64_t CUDAHooks::current_device() const {
   return -1;
 }
 
+c10::Stream CUDAHooks::getStreamFromPool(DeviceIndex device_index) const {
+  return c10::cuda::getStreamFromPool(/*isHighPriority=*/false, device_index)
+      .unwrap();
+}
+
 bool CUDAHooks::hasPrimaryContext(int64_t device_index) const {
   TORCH_CHECK(device_index >= 0 && device_index < at::cuda::device_count(),
               "hasPrimaryContext expects a valid device index, but got device_index=", device_index);
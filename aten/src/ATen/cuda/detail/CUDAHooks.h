@@ -20,6 +20,7 @@ struct CUDAHooks : public at::CUDAHooksInterface {
   bool hasCuDNN() const override;
   const at::cuda::NVRTC& nvrtc() const override;
   int64_t current_device() const override;
+  c10::Stream getStreamFromPool(DeviceIndex device_index = -1) const override;
   bool hasPrimaryContext(int64_t device_index) const override;
   c10::optional<int64_t> getDevceIndexWithPrimaryContext() const override;
   Allocator* getPinnedMemoryAllocator() const override;
@@ -1,6 +1,11 @@
 #include <ATen/cudnn/Handle.h>
 #include <ATen/cuda/detail/DeviceThreadHandles.h>
+#include <ATen/native/cudnn/BenchmarkCachePersistence.h>
 #include <c10/cuda/CUDAStream.h>
+#include <c10/util/Exception.h>
+
+#include <cstdlib>
+#include <mutex>
 
 namespace at { namespace native {
 namespace {
@@ -38,6 +43,23 @@ cudnnHandle_t getCudnnHandle()
   int device;
   AT_CUDA_CHECK(cudaGetDevice(&device));
 
+  // Pre-warm the convolution benchmark caches from a saved profile once
+  // per process. See Note [Persistent benchmark cache] in
+  // native/cudnn/Conv.cpp.
+  static std::once_flag benchmark_cache_prewarm_flag;
+  std::call_once(benchmark_cache_prewarm_flag, [] {
+    const char* path = std::getenv("TORCH_CUDNN_BENCHMARK_CACHE_PATH");
+    if (path != nullptr && *path != '\0') {
+      if (!load_cudnn_benchmark_cache(path)) {
+        TORCH_WARN(
+            "Could not pre-warm the cuDNN benchmark cache from ",
+            path,
+            "; the file is missing or was written for a different "
+            "cuDNN version or GPU model.");
+      }
+    }
+  });
+
   if (!myPoolWindow)
     myPoolWindow.reset(pool.newPoolWindow());
 
@@ -2,6 +2,7 @@
 
 #include <c10/core/Allocator.h>
 #include <ATen/core/Generator.h>
+#include <c10/core/Stream.h>
 #include <c10/util/Exception.h>
 #include <c10/util/Optional.h>
 #include <c10/util/Registry.h>
@@ -95,6 +96,13 @@ struct CAFFE2_API CUDAHooksInterface {
     return -1;
   }
 
+  // Returns a stream from the per-device CUDA stream pool, wrapped as a
+  // generic c10::Stream so CPU-only code (e.g. the JIT interpreter) can
+  // assign streams without linking against the CUDA library.
+  virtual c10::Stream getStreamFromPool(DeviceIndex device_index = -1) const {
+    TORCH_CHECK(false, "Cannot get a CUDA stream without ATen_cuda library. ", CUDA_HELP);
+  }
+
   virtual bool hasPrimaryContext(int64_t device_index) const {
     TORCH_CHECK(false, "Cannot call hasPrimaryContext(", device_index, ") without ATen_cuda library. ", CUDA_HELP);
   }
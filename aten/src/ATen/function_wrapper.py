@@ -138,7 +138,8 @@ inline ${return_type} Tensor::${api_name}(${method_formals}) const {
     ${static_dispatch_method_body}
 #else
     static c10::OperatorHandle op = c10::Dispatcher::singleton().findSchemaOrThrow("aten::${operator_name}", "${overload_name}");
-    return op.callUnboxed<${formals_types_with_return}>(${method_actuals});
+    static thread_local c10::DispatchCache dispatch_cache;
+    return op.callUnboxedWithCache<${formals_types_with_return}>(dispatch_cache, ${method_actuals});
 #endif
 }
 """)
@@ -158,7 +159,8 @@ static inline ${return_type} ${api_name}(${formals}) {
 #else
     static c10::OperatorHandle op = c10::Dispatcher::singleton()
         .findSchemaOrThrow("aten::${operator_name}", "${overload_name}");
-    return op.callUnboxed<${formals_types_with_return}>(${native_actuals});
+    static thread_local c10::DispatchCache dispatch_cache;
+    return op.callUnboxedWithCache<${formals_types_with_return}>(dispatch_cache, ${native_actuals});
 #endif
 }
 """)
@@ -203,7 +205,8 @@ static inline ${return_type} ${api_name}(${formals}) {
     globalLegacyTypeDispatch().initForDispatchKeySet(${inferred_key_set});
     static c10::OperatorHandle op = c10::Dispatcher::singleton()
         .findSchemaOrThrow("aten::${operator_name}", "${overload_name}");
-    return op.callUnboxed<${formals_types_with_return}>(${native_actuals});
+    static thread_local c10::DispatchCache dispatch_cache;
+    return op.callUnboxedWithCache<${formals_types_with_return}>(dispatch_cache, ${native_actuals});
 #endif
 }
 """)
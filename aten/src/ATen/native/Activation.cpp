@@ -26,6 +26,7 @@ DEFINE_DISPATCH(softshrink_stub);
 DEFINE_DISPATCH(shrink_backward_stub);
 DEFINE_DISPATCH(leaky_relu_stub);
 DEFINE_DISPATCH(leaky_relu_backward_stub);
+DEFINE_DISPATCH(addmm_activation_stub);
 
 Tensor hardtanh(const Tensor& self, Scalar min, Scalar max) {
   return at::clamp(self, min, max);
@@ -625,6 +626,23 @@ Tensor softshrink_backward(const Tensor & grad, const Tensor & self, Scalar lamb
   return iter.output();
 }
 
+// Computes activation(beta * self + alpha * mat1 @ mat2) with the bias add
+// and the activation applied in one pass over the gemm output. addmm instead
+// broadcast-copies the bias into the output before the gemm, and a separate
+// activation costs another full read-modify-write of the output.
+Tensor _addmm_activation(
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    Scalar beta,
+    Scalar alpha,
+    bool use_gelu) {
+  Tensor result = at::mm(mat1, mat2);
+  auto iter = TensorIterator::binary_op(result, result, self);
+  addmm_activation_stub(iter.device_type(), iter, alpha, beta, use_gelu);
+  return result;
+}
+
 Tensor gelu_cpu(const Tensor& self) {
   Tensor Y = at::native::empty_like(self, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
   auto it = TensorIterator::unary_op(Y, self);
@@ -22,6 +22,7 @@ using elu_fn = void (*)(TensorIterator&, Scalar, Scalar, Scalar);
 using leaky_relu_fn = void (*)(TensorIterator&, Scalar);
 using leaky_relu_backward_fn = void (*)(TensorIterator&, Scalar);
 using log_sigmoid_cpu_fn = void (*)(Tensor& , Tensor&, const Tensor& );
+using addmm_activation_fn = void (*)(TensorIterator&, Scalar, Scalar, bool);
 
 DECLARE_DISPATCH(elu_fn, elu_stub);
 DECLARE_DISPATCH(elu_fn, elu_backward_stub);
@@ -38,6 +39,7 @@ DECLARE_DISPATCH(shrink_fn, softshrink_stub);
 DECLARE_DISPATCH(shrink_backward_fn, shrink_backward_stub);
 DECLARE_DISPATCH(leaky_relu_fn, leaky_relu_stub);
 DECLARE_DISPATCH(leaky_relu_backward_fn, leaky_relu_backward_stub);
+DECLARE_DISPATCH(addmm_activation_fn, addmm_activation_stub);
 
 } // namespace native
 
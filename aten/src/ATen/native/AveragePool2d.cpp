@@ -87,6 +87,79 @@ static void avg_pool2d_out_frame(
   });
 }
 
+// Channels-last variant: channels are innermost, so each output pixel is the
+// mean of kH*kW contiguous runs of nInputPlane values and the inner loop
+// vectorizes over channels instead of striding through planes.
+template <typename scalar_t>
+static void avg_pool2d_out_frame_channels_last(
+          const scalar_t *input_data,
+          scalar_t *output_data,
+          int64_t nbatch,
+          int64_t nInputPlane,
+          int64_t inputWidth,
+          int64_t inputHeight,
+          int64_t outputWidth,
+          int64_t outputHeight,
+          int kW,
+          int kH,
+          int dW,
+          int dH,
+          int padW,
+          int padH,
+          bool count_include_pad,
+          c10::optional<int64_t> divisor_override)
+{
+  at::parallel_for(0, nbatch * outputHeight, 0, [&](int64_t start, int64_t end) {
+    for (auto idx = start; idx < end; idx++)
+    {
+      int64_t p = idx / outputHeight;
+      int64_t yy = idx % outputHeight;
+      const scalar_t *ptr_input = input_data + p*inputHeight*inputWidth*nInputPlane;
+      scalar_t *ptr_output = output_data + idx*outputWidth*nInputPlane;
+
+      for(int64_t xx = 0; xx < outputWidth; xx++)
+      {
+        int64_t hstart = yy * dH - padH;
+        int64_t wstart = xx * dW - padW;
+        int64_t hend = std::min(hstart + kH, inputHeight + padH);
+        int64_t wend = std::min(wstart + kW, inputWidth + padW);
+        int pool_size = (hend - hstart) * (wend - wstart);
+        hstart = std::max(hstart, (int64_t) 0);
+        wstart = std::max(wstart, (int64_t) 0);
+        hend = std::min(hend, inputHeight);
+        wend = std::min(wend, inputWidth);
+
+        int divide_factor;
+        if (divisor_override.has_value()) {
+          divide_factor = divisor_override.value();
+        } else {
+          if(count_include_pad) {
+            divide_factor = pool_size;
+          } else {
+            divide_factor = (hend - hstart) * (wend - wstart);
+          }
+        }
+
+        scalar_t *out_pixel = ptr_output + xx*nInputPlane;
+        for(int64_t c = 0; c < nInputPlane; c++)
+          out_pixel[c] = 0;
+
+        for(int64_t ky = hstart; ky < hend; ky++)
+        {
+          for(int64_t kx = wstart; kx < wend; kx++)
+          {
+            const scalar_t *in_pixel = ptr_input + (ky*inputWidth + kx)*nInputPlane;
+            for(int64_t c = 0; c < nInputPlane; c++)
+              out_pixel[c] += in_pixel[c];
+          }
+        }
+        for(int64_t c = 0; c < nInputPlane; c++)
+          out_pixel[c] /= divide_factor;
+      }
+    }
+  });
+}
+
 void avg_pool2d_out_cpu_template(
           Tensor &output,
           const Tensor &input_,
@@ -136,6 +209,32 @@ void avg_pool2d_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth);
 
+  if (input_.ndimension() == 4 &&
+      input_.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    // Keep the channels-last layout through pooling so NHWC convolutions on
+    // either side don't pay a transpose.
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+                   at::MemoryFormat::ChannelsLast);
+    AT_DISPATCH_FLOATING_TYPES_AND(at::ScalarType::Long, input_.scalar_type(),
+      "avg_pool2d_out_frame_channels_last",
+      [&] {
+        avg_pool2d_out_frame_channels_last<scalar_t>(
+          input_.data_ptr<scalar_t>(),
+          output.data_ptr<scalar_t>(),
+          nbatch,
+          nInputPlane,
+          inputWidth, inputHeight,
+          outputWidth, outputHeight,
+          kW, kH,
+          dW, dH,
+          padW, padH,
+          count_include_pad,
+          divisor_override);
+      }
+    );
+    return;
+  }
+
   if (input_.ndimension() == 3) {
     output.resize_({nInputPlane, outputHeight, outputWidth});
   }
@@ -5,6 +5,7 @@
 #include <ATen/ExpandUtils.h>
 
 #include <ATen/native/LinearAlgebraUtils.h>
+#include <ATen/native/Workspace.h>
 #include <ATen/native/cpu/zmath.h>
 #include <ATen/Parallel.h>
 
@@ -393,8 +394,8 @@ static void apply_inverse(Tensor& self, std::vector<int64_t>& infos) {
   scalar_t wkopt;
   lapackGetri<scalar_t>(n, self_data, n, ipiv_data, &wkopt, lwork, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
-  auto work_data = work.data_ptr<scalar_t>();
+  Workspace workspace;
+  auto work_data = workspace.get<scalar_t>(lwork);
 
   for (int64_t i = 0; i < batch_size; i++) {
     scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
@@ -414,8 +415,152 @@ static void apply_inverse(Tensor& self, std::vector<int64_t>& infos) {
 #endif
 }
 
+// Fully unrolled Cramer-rule inverses for tiny matrices. Batched geometry
+// workloads (camera poses, rigid transforms) invert millions of 2x2/3x3/4x4
+// matrices, where the per-matrix LAPACK round trip (getrf + getri, pivoting,
+// workspace) costs far more than the arithmetic itself. These run one fused
+// pass per matrix and let _inverse_helper_cpu parallelize over the batch.
+//
+// The cofactor formulas are major-order agnostic: inv(A^T) = inv(A)^T, so
+// applying them to row-major data yields the row-major inverse directly and
+// no column-major working copy is needed.
+template <typename scalar_t, int64_t n>
+struct SmallMatrixInverse;
+
+template <typename scalar_t>
+struct SmallMatrixInverse<scalar_t, 2> {
+  static bool run(const scalar_t* a, scalar_t* out) {
+    scalar_t det = a[0] * a[3] - a[1] * a[2];
+    if (det == scalar_t(0)) {
+      return false;
+    }
+    scalar_t s = scalar_t(1) / det;
+    out[0] = a[3] * s;
+    out[1] = -a[1] * s;
+    out[2] = -a[2] * s;
+    out[3] = a[0] * s;
+    return true;
+  }
+};
+
+template <typename scalar_t>
+struct SmallMatrixInverse<scalar_t, 3> {
+  static bool run(const scalar_t* a, scalar_t* out) {
+    scalar_t c00 = a[4] * a[8] - a[5] * a[7];
+    scalar_t c01 = a[5] * a[6] - a[3] * a[8];
+    scalar_t c02 = a[3] * a[7] - a[4] * a[6];
+    scalar_t det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+    if (det == scalar_t(0)) {
+      return false;
+    }
+    scalar_t s = scalar_t(1) / det;
+    out[0] = c00 * s;
+    out[1] = (a[2] * a[7] - a[1] * a[8]) * s;
+    out[2] = (a[1] * a[5] - a[2] * a[4]) * s;
+    out[3] = c01 * s;
+    out[4] = (a[0] * a[8] - a[2] * a[6]) * s;
+    out[5] = (a[2] * a[3] - a[0] * a[5]) * s;
+    out[6] = c02 * s;
+    out[7] = (a[1] * a[6] - a[0] * a[7]) * s;
+    out[8] = (a[0] * a[4] - a[1] * a[3]) * s;
+    return true;
+  }
+};
+
+template <typename scalar_t>
+struct SmallMatrixInverse<scalar_t, 4> {
+  static bool run(const scalar_t* a, scalar_t* out) {
+    scalar_t inv[16];
+    inv[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15]
+           + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+    inv[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15]
+           - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+    inv[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15]
+           + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+    inv[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14]
+            - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+    inv[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15]
+           - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+    inv[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15]
+           + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+    inv[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15]
+           - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+    inv[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14]
+            + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+    inv[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15]
+           + a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+    inv[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15]
+           - a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+    inv[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15]
+            + a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+    inv[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14]
+            - a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+    inv[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11]
+           - a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+    inv[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11]
+           + a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+    inv[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11]
+            - a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+    inv[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10]
+            + a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+    scalar_t det = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+    if (det == scalar_t(0)) {
+      return false;
+    }
+    scalar_t s = scalar_t(1) / det;
+    for (int64_t i = 0; i < 16; i++) {
+      out[i] = inv[i] * s;
+    }
+    return true;
+  }
+};
+
+template <typename scalar_t, int64_t n>
+static void apply_inverse_small(const Tensor& self, Tensor& result, std::vector<int64_t>& infos) {
+  auto self_data = self.data_ptr<scalar_t>();
+  auto result_data = result.data_ptr<scalar_t>();
+  auto batch_size = batchCount(self);
+  constexpr int64_t matrix_stride = n * n;
+  int64_t grain_size = std::max(internal::GRAIN_SIZE / (n * n * n), (int64_t)1);
+  parallel_for(0, batch_size, grain_size, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      if (!SmallMatrixInverse<scalar_t, n>::run(
+              &self_data[i * matrix_stride], &result_data[i * matrix_stride])) {
+        infos[i] = n;  // reported like a zero pivot from getrf
+      }
+    }
+  });
+}
+
 Tensor _inverse_helper_cpu(const Tensor& self) {
   std::vector<int64_t> infos(batchCount(self), 0);
+  auto n = self.size(-1);
+  // Sizes 2-4 take the unrolled Cramer path; no LU factorization, pivoting
+  // or workspace, and the batch loop parallelizes.
+  if (n >= 2 && n <= 4 &&
+      (self.scalar_type() == kFloat || self.scalar_type() == kDouble)) {
+    auto self_contiguous = self.contiguous();
+    auto result = at::empty_like(self_contiguous, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+    AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "inverse_cpu", [&]{
+      switch (n) {
+        case 2:
+          apply_inverse_small<scalar_t, 2>(self_contiguous, result, infos);
+          break;
+        case 3:
+          apply_inverse_small<scalar_t, 3>(self_contiguous, result, infos);
+          break;
+        default:
+          apply_inverse_small<scalar_t, 4>(self_contiguous, result, infos);
+          break;
+      }
+    });
+    if (self.dim() > 2) {
+      batchCheckErrors(infos, "inverse_cpu");
+    } else {
+      singleCheckErrors(infos[0], "inverse_cpu");
+    }
+    return result;
+  }
   auto self_working_copy = cloneBatchedColumnMajor(self);
   AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES(self.scalar_type(), "inverse_cpu", [&]{
     apply_inverse<scalar_t>(self_working_copy, infos);
@@ -710,14 +855,15 @@ static void apply_geqrf(Tensor& self, Tensor& tau, int64_t m, int64_t n,
   scalar_t wkopt;
   lapackGeqrf<scalar_t>(m, n, self_data, m, tau_data, &wkopt, lwork, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
+  Workspace workspace;
+  auto work_data = workspace.get<scalar_t>(lwork);
 
   for (int64_t i = 0; i < batch_size; i++) {
     scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
     scalar_t* tau_working_ptr = &tau_data[i * tau_stride];
 
     // now compute the actual R and TAU
-    lapackGeqrf<scalar_t>(m, n, self_working_ptr, m, tau_working_ptr, work.data_ptr<scalar_t>(), lwork, &info);
+    lapackGeqrf<scalar_t>(m, n, self_working_ptr, m, tau_working_ptr, work_data, lwork, &info);
     infos[i] = info;
     if (info != 0) {
       return;
@@ -748,14 +894,15 @@ static void apply_orgqr(Tensor& self, const Tensor& tau, int64_t m, int64_t n_co
   scalar_t wkopt;
   lapackOrgqr<scalar_t>(m, n_columns, k, self_data, m, tau_data, &wkopt, lwork, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
+  Workspace workspace;
+  auto work_data = workspace.get<scalar_t>(lwork);
 
   for (int64_t i = 0; i < batch_size; i++) {
     scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
     scalar_t* tau_working_ptr = &tau_data[i * tau_stride];
 
     // now compute the actual Q
-    lapackOrgqr<scalar_t>(m, n_columns, k, self_working_ptr, m, tau_working_ptr, work.data_ptr<scalar_t>(), lwork, &info);
+    lapackOrgqr<scalar_t>(m, n_columns, k, self_working_ptr, m, tau_working_ptr, work_data, lwork, &info);
     infos[i] = info;
     if (info != 0) {
       return;
@@ -868,14 +1015,15 @@ static void apply_symeig(Tensor& self, Tensor& eigvals, bool eigenvectors, bool
   scalar_t wkopt;
   lapackSymeig<scalar_t>(jobz, uplo, n, self_data, n, eigvals_data, &wkopt, lwork, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
+  Workspace workspace;
+  auto work_data = workspace.get<scalar_t>(lwork);
 
   for (int64_t i = 0; i < batch_size; i++) {
     scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
     scalar_t* eigvals_working_ptr = &eigvals_data[i * eigvals_stride];
 
     // now compute the eigenvalues and the eigenvectors (optionally)
-    lapackSymeig<scalar_t>(jobz, uplo, n, self_working_ptr, n, eigvals_working_ptr, work.data_ptr<scalar_t>(), lwork, &info);
+    lapackSymeig<scalar_t>(jobz, uplo, n, self_working_ptr, n, eigvals_working_ptr, work_data, lwork, &info);
     infos[i] = info;
     if (info != 0) {
       return;
@@ -949,9 +1097,8 @@ static void apply_svd(Tensor& self, Tensor& U, Tensor& S, Tensor& VT,
   auto m = self.size(-2);
   auto n = self.size(-1);
   auto mn = std::min(m, n);
-  Tensor iwork = at::empty({8*mn}, at::kInt);
-  auto iwork_data = iwork.data_ptr<int>();
-  Tensor rwork;
+  Workspace workspace;
+  auto iwork_data = workspace.get<int>(8 * mn);
   int* rwork_data = nullptr;
   if (isComplexType(at::typeMetaToScalarType(self.dtype()))) {
     auto mx = std::max(m, n);
@@ -963,8 +1110,7 @@ static void apply_svd(Tensor& self, Tensor& U, Tensor& S, Tensor& VT,
     } else {
       lrwork = std::max(7 * mn * mn + 7 * mn, 2 * mx * mn + 2 *mn * mn + mn);
     }
-    rwork = at::empty({std::max(int64_t(1), lrwork)}, at::kInt);
-    rwork_data = rwork.data_ptr<int>();
+    rwork_data = workspace.get<int>(std::max(int64_t(1), lrwork));
   }
 
   // Run once, first to get the optimum work size.
@@ -975,8 +1121,7 @@ static void apply_svd(Tensor& self, Tensor& U, Tensor& S, Tensor& VT,
   scalar_t wkopt;
   lapackSvd<scalar_t, value_t>(jobz, m, n, self_data, m, S_data, U_data, m, VT_data, n, &wkopt, lwork, rwork_data, iwork_data, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
-  auto work_data = work.data_ptr<scalar_t>();
+  auto work_data = workspace.get<scalar_t>(lwork);
 
   for (int64_t i = 0; i < batchsize; i++) {
     scalar_t* self_working_ptr = &self_data[i * self_stride];
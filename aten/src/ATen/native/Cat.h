@@ -0,0 +1,17 @@
+// Fused copy kernel for concatenating contiguous tensors. The kernel is in
+// cpu/CatKernel.cpp; callers are in TensorShape.cpp.
+
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Requires: every input and the result are contiguous and share a dtype,
+// the result is already resized for the concatenation, and no input has
+// a zero-size dimension other than possibly `dim` itself.
+using cat_contig_fn = void (*)(Tensor&, TensorList, int64_t);
+DECLARE_DISPATCH(cat_contig_fn, cat_contig_stub);
+
+}} // namespace at::native
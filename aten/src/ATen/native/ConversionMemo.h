@@ -0,0 +1,17 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+namespace at {
+namespace native {
+
+// Toggles the conversion memo cache, an opt-in op-level memoization of
+// aten::to for tensors whose storage has not been written since a previous
+// identical conversion. See Note [Conversion memo cache] in
+// TensorConversions.cpp for the exact semantics and the aliasing caveats.
+// Disabling the cache also clears it.
+CAFFE2_API bool conversion_memo_enabled();
+CAFFE2_API void set_conversion_memo_enabled(bool enabled);
+
+} // namespace native
+} // namespace at
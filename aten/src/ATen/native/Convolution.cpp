@@ -2,6 +2,8 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
+#include <ATen/native/cpu/DirectConvKernel.h>
+#include <c10/core/GradMode.h>
 #include <ATen/native/utils/ParamUtils.h>
 #include <ATen/native/ConvUtils.h>
 
@@ -15,6 +17,7 @@ constexpr int MIOPEN_DIM_MAX = 5;
 namespace at { namespace native {
 
 DEFINE_DISPATCH(convolution_depthwise3x3_winograd_stub);
+DEFINE_DISPATCH(convolution_direct2d_stub);
 
 struct ConvParams {
   std::vector<int64_t> stride;
@@ -36,6 +39,7 @@ struct ConvParams {
   bool is_stride_nonpos() const;
   void view1d_as_2d();
   bool use_cpu_depthwise3x3_winograd(const at::Tensor& input, const at::Tensor& weight) const;
+  bool use_cpu_direct(const at::Tensor& input, const at::Tensor& weight) const;
   bool needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
@@ -149,6 +153,50 @@ auto ConvParams::use_cpu_depthwise3x3_winograd(
 #endif
 }
 
+auto ConvParams::use_cpu_direct(
+    const at::Tensor& input, const at::Tensor& weight) const -> bool {
+  // im2col+gemm materializes a (C_in * kH * kW) x (H_out * W_out) buffer.
+  // For small feature maps with many channels that buffer blows out the
+  // cache and most of the time goes into filling it, so compute the
+  // convolution directly instead. The budget is a rough L2 size.
+  constexpr int64_t kIm2colCacheBudget = 256 * 1024;
+  // Only small spatial extents benefit; for larger maps the gemm's better
+  // register blocking wins despite the unfolding cost.
+  constexpr int64_t kMaxSpatialSize = 256;
+  if (transposed || groups != 1 || is_strided() || is_dilated()) {
+    return false;
+  }
+  if (input.ndimension() != 4 || weight.ndimension() != 4) {
+    return false;
+  }
+  if ((input.device().type() != c10::DeviceType::CPU) ||
+      (input.scalar_type() != at::kFloat) ||
+      (weight.device().type() != c10::DeviceType::CPU) ||
+      (weight.scalar_type() != at::kFloat)) {
+    return false;
+  }
+  // The direct kernel has no autograd support; fall back to im2col+gemm
+  // when gradients are needed.
+  if (at::GradMode::is_enabled() &&
+      (input.requires_grad() || weight.requires_grad())) {
+    return false;
+  }
+  const int64_t k_h = weight.size(2);
+  const int64_t k_w = weight.size(3);
+  if (k_h == 1 && k_w == 1) {
+    // 1x1 convolutions are a plain gemm; there is no unfolded matrix to save.
+    return false;
+  }
+  const int64_t out_h = input.size(2) - k_h + 2 * padding[0] + 1;
+  const int64_t out_w = input.size(3) - k_w + 2 * padding[1] + 1;
+  if (out_h <= 0 || out_w <= 0 || out_h * out_w > kMaxSpatialSize) {
+    return false;
+  }
+  const int64_t im2col_bytes =
+      input.size(1) * k_h * k_w * out_h * out_w * static_cast<int64_t>(sizeof(float));
+  return im2col_bytes > kIm2colCacheBudget;
+}
+
 auto ConvParams::needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const -> bool {
   constexpr int64_t int_max = std::numeric_limits<int>::max();
   int64_t numel_input = input.numel();
@@ -710,6 +758,10 @@ at::Tensor _convolution(
     if (params.use_cpu_depthwise3x3_winograd(input, weight)) {
       output = convolution_depthwise3x3_winograd_stub(
         input.device().type(), input, weight, bias, params.stride, params.padding, params.groups);
+    } else if (params.use_cpu_direct(input, weight)) {
+      output = convolution_direct2d_stub(
+        input.device().type(), input.contiguous(), weight.contiguous(),
+        bias.defined() ? bias.contiguous() : bias, params.stride, params.padding);
     } else if (params.groups == 1) {
       output = at::_convolution_nogroup(
           input.contiguous(), weight, bias, params.stride, params.padding, params.dilation, params.transposed, params.output_padding);
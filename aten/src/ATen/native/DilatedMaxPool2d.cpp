@@ -118,6 +118,80 @@ static void max_pool2d_with_indices_out_frame(
   });
 }
 
+// Channels-last variant: channels are innermost, so the max (and its plane
+// offset, stored in indices with the same meaning as the NCHW kernel) is
+// tracked for all channels of an output pixel while the window's input
+// pixels stream through contiguously.
+template <typename scalar_t>
+static void max_pool2d_with_indices_out_frame_channels_last(
+          const scalar_t *input_data,
+          scalar_t *output_data,
+          int64_t *indices_data,
+          int64_t nbatch,
+          int64_t nInputPlane,
+          int64_t inputWidth,
+          int64_t inputHeight,
+          int64_t outputWidth,
+          int64_t outputHeight,
+          int kW,
+          int kH,
+          int dW,
+          int dH,
+          int padW,
+          int padH,
+          int dilationW,
+          int dilationH)
+{
+  at::parallel_for(0, nbatch * outputHeight, 0, [&](int64_t start, int64_t end) {
+    for (auto idx = start; idx < end; idx++)
+    {
+      int64_t p = idx / outputHeight;
+      int64_t i = idx % outputHeight;
+      const scalar_t *ip = input_data + p*inputHeight*inputWidth*nInputPlane;
+      scalar_t *op = output_data + idx*outputWidth*nInputPlane;
+      int64_t *indp = indices_data + idx*outputWidth*nInputPlane;
+
+      for(int64_t j = 0; j < outputWidth; j++)
+      {
+        int64_t hstart = i * dH - padH;
+        int64_t wstart = j * dW - padW;
+        int64_t hend = std::min(hstart + (kH - 1) * dilationH + 1, inputHeight);
+        int64_t wend = std::min(wstart + (kW - 1) * dilationW + 1, inputWidth);
+        while(hstart < 0)
+          hstart += dilationH;
+        while(wstart < 0)
+          wstart += dilationW;
+
+        scalar_t *out_pixel = op + j*nInputPlane;
+        int64_t *ind_pixel = indp + j*nInputPlane;
+        for(int64_t c = 0; c < nInputPlane; c++)
+        {
+          out_pixel[c] = -std::numeric_limits<scalar_t>::infinity();
+          ind_pixel[c] = hstart*inputWidth + wstart;
+        }
+
+        for(int64_t y = hstart; y < hend; y += dilationH)
+        {
+          for(int64_t x = wstart; x < wend; x += dilationW)
+          {
+            int64_t tcntr = y*inputWidth + x;
+            const scalar_t *in_pixel = ip + tcntr*nInputPlane;
+            for(int64_t c = 0; c < nInputPlane; c++)
+            {
+              scalar_t val = in_pixel[c];
+              if ((val > out_pixel[c]) || std::isnan(val))
+              {
+                out_pixel[c] = val;
+                ind_pixel[c] = tcntr;
+              }
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
 void max_pool2d_with_indices_out_cpu_template(
           Tensor& output,
           Tensor& indices,
@@ -171,6 +245,34 @@ void max_pool2d_with_indices_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth);
 
+  if (input_.ndimension() == 4 &&
+      input_.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    // Keep the channels-last layout through pooling so NHWC convolutions on
+    // either side don't pay a transpose.
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+                   at::MemoryFormat::ChannelsLast);
+    indices.resize_({nbatch, nInputPlane, outputHeight, outputWidth},
+                    at::MemoryFormat::ChannelsLast);
+
+    AT_DISPATCH_FLOATING_TYPES(input_.scalar_type(),
+      "max_pool2d_with_indices_cpu_channels_last",
+      [&] {
+        max_pool2d_with_indices_out_frame_channels_last<scalar_t>(
+          input_.data_ptr<scalar_t>(),
+          output.data_ptr<scalar_t>(),
+          indices.data_ptr<int64_t>(),
+          nbatch,
+          nInputPlane,
+          inputWidth, inputHeight,
+          outputWidth, outputHeight,
+          kW, kH, dW, dH,
+          padW, padH,
+          dilationW, dilationH);
+      }
+    );
+    return;
+  }
+
   /* get contiguous input */
   Tensor input = input_.contiguous();
 
@@ -333,8 +435,11 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
   TORCH_CHECK((input.ndimension() == 3 || input.ndimension() == 4),
     "non-empty 3D or 4D (batch mode) tensor expected for input");
 
-  /* get contiguous gradOutput */
+  /* get contiguous gradOutput; also reorders channels-last tensors from the
+     forward's NHWC path into the NCHW layout this kernel walks (the stored
+     index values are plane offsets in both layouts) */
   const Tensor gradOutput = gradOutput_.contiguous();
+  const Tensor indices_ = indices.contiguous();
 
   /* resize */
   gradInput.resize_as_(input);
@@ -371,7 +476,7 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
         /* get raw pointers */
         scalar_t *gradInput_data = gradInput.data_ptr<scalar_t>();
         scalar_t *gradOutput_data = gradOutput.data_ptr<scalar_t>();
-        int64_t *indices_data = indices.data_ptr<int64_t>();
+        int64_t *indices_data = indices_.data_ptr<int64_t>();
 
         max_pool2d_with_indices_backward_single_out_frame(
           gradInput_data, gradOutput_data,
@@ -391,7 +496,7 @@ Tensor& max_pool2d_with_indices_backward_out_cpu_template(
         /* get raw pointers */
         scalar_t *gradInput_data = gradInput.data_ptr<scalar_t>();
         scalar_t *gradOutput_data = gradOutput.data_ptr<scalar_t>();
-        int64_t *indices_data = indices.data_ptr<int64_t>();
+        int64_t *indices_data = indices_.data_ptr<int64_t>();
 
         max_pool2d_with_indices_backward_out_frame<scalar_t>(
           gradInput_data, gradOutput_data,
@@ -11,6 +11,9 @@ namespace at { namespace native {
 static CPUCapability compute_cpu_capability() {
   auto envar = std::getenv("ATEN_CPU_CAPABILITY");
   if (envar) {
+    if (strcmp(envar, "avx512") == 0) {
+      return CPUCapability::AVX512;
+    }
     if (strcmp(envar, "avx2") == 0) {
       return CPUCapability::AVX2;
     }
@@ -25,6 +28,12 @@ static CPUCapability compute_cpu_capability() {
 
 #if !defined(__powerpc__) && !defined(__s390x__)
   if (cpuinfo_initialize()) {
+    // The compiled AVX512 kernels assume the F/VL/BW/DQ subsets, which every
+    // AVX512 server part so far (Skylake-SP onwards) provides.
+    if (cpuinfo_has_x86_avx512f() && cpuinfo_has_x86_avx512vl() &&
+        cpuinfo_has_x86_avx512bw() && cpuinfo_has_x86_avx512dq()) {
+      return CPUCapability::AVX512;
+    }
     if (cpuinfo_has_x86_avx2() && cpuinfo_has_x86_fma3()) {
       return CPUCapability::AVX2;
     }
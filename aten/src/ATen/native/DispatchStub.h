@@ -35,7 +35,8 @@
 // TODO: CPU instruction set selection should be folded into whatever
 // the main dispatch mechanism is.
 
-// ignore warnings about DispatchStub::DEFAULT, AVX, AVX2 defined elsewhere
+// ignore warnings about DispatchStub::DEFAULT, AVX, AVX2, AVX512 defined
+// elsewhere
 #if defined(__clang__)
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wundefined-var-template"
@@ -47,9 +48,20 @@ enum class CPUCapability {
   DEFAULT = 0,
   AVX = 1,
   AVX2 = 2,
+  AVX512 = 3,
   NUM_OPTIONS
 };
 
+// Note [Per-op AVX512 opt-in]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Unlike DEFAULT/AVX/AVX2, kernels are not compiled for AVX512 wholesale:
+// executing 512-bit instructions lowers the core's licensed frequency on
+// current Intel parts, which makes the wider vectors a net loss for
+// compute-bound kernels. Only kernels that are close to pure memory
+// bandwidth opt in, via the list in cmake/Codegen.cmake. Stubs without an
+// AVX512 registration keep a null AVX512 slot and fall back to their AVX2
+// kernel at runtime, so opting in is purely additive.
+
 CPUCapability get_cpu_capability();
 
 template <typename FnPtr, typename T>
@@ -88,6 +100,15 @@ struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
   FnPtr choose_cpu_impl() {
     auto capability = static_cast<int>(get_cpu_capability());
     (void)capability;
+#ifdef HAVE_AVX512_CPU_DEFINITION
+    if (capability >= static_cast<int>(CPUCapability::AVX512)) {
+      // See Note [Per-op AVX512 opt-in]: a missing AVX512 kernel is not an
+      // error, it just means this op did not opt in; use the AVX2 kernel.
+      if (AVX512) {
+        return AVX512;
+      }
+    }
+#endif
 #ifdef HAVE_AVX2_CPU_DEFINITION
     if (capability >= static_cast<int>(CPUCapability::AVX2)) {
       AT_ASSERTM(AVX2, "DispatchStub: missing AVX2 kernel");
@@ -122,8 +143,20 @@ struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
 #ifdef HAVE_AVX2_CPU_DEFINITION
   static FnPtr AVX2;
 #endif
+#ifdef HAVE_AVX512_CPU_DEFINITION
+  static FnPtr AVX512;
+#endif
 };
 
+#ifdef HAVE_AVX512_CPU_DEFINITION
+// Default definition so that stubs which never opt in to AVX512 (see Note
+// [Per-op AVX512 opt-in]) still link; REGISTER_AVX512_DISPATCH provides an
+// explicit specialization that overrides this for opted-in kernels.
+template <typename rT, typename T, typename... Args>
+typename DispatchStub<rT (*)(Args...), T>::FnPtr
+    DispatchStub<rT (*)(Args...), T>::AVX512 = nullptr;
+#endif
+
 namespace {
 template <typename FnPtr, typename T>
 struct RegisterCUDADispatch {
@@ -171,6 +204,12 @@ struct RegisterHIPDispatch {
 #define REGISTER_AVX2_DISPATCH(name, fn)
 #endif
 
+#ifdef HAVE_AVX512_CPU_DEFINITION
+#define REGISTER_AVX512_DISPATCH(name, fn) REGISTER_ARCH_DISPATCH(name, AVX512, fn)
+#else
+#define REGISTER_AVX512_DISPATCH(name, fn)
+#endif
+
 #define REGISTER_NO_CPU_DISPATCH(name, fn_type)                                \
   REGISTER_ARCH_DISPATCH(name, DEFAULT, static_cast<fn_type>(nullptr))         \
   REGISTER_AVX_DISPATCH(name, static_cast<fn_type>(nullptr))                   \
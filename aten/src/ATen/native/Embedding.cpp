@@ -2,15 +2,106 @@
 #include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/native/cpu/EmbeddingKernel.h>
 
 #include <cstring>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <vector>
 
 
 namespace at { namespace native {
 
+DEFINE_DISPATCH(embedding_sorted_backward_stub);
+
+namespace {
+
+// Stable parallel LSD radix sort of (key, position) pairs by key. Keys must
+// be in [0, max_key]. Grouping equal indices into contiguous runs lets the
+// backward reduce each weight row exactly once without locking.
+void radix_sort_index_pairs(Tensor& keys, Tensor& positions, int64_t max_key) {
+  constexpr int64_t RADIX_BITS = 8;
+  constexpr int64_t RADIX = 1 << RADIX_BITS;
+  int64_t n = keys.numel();
+
+  auto tmp_keys = at::empty_like(keys);
+  auto tmp_positions = at::empty_like(positions);
+  int64_t* keys_in = keys.data_ptr<int64_t>();
+  int64_t* positions_in = positions.data_ptr<int64_t>();
+  int64_t* keys_out = tmp_keys.data_ptr<int64_t>();
+  int64_t* positions_out = tmp_positions.data_ptr<int64_t>();
+
+  int64_t n_chunks = std::max<int64_t>(at::get_num_threads(), 1);
+  n_chunks = std::min(n_chunks, std::max<int64_t>(n, 1));
+  int64_t chunk_size = (n + n_chunks - 1) / n_chunks;
+  std::vector<int64_t> histograms(n_chunks * RADIX);
+
+  for (int64_t shift = 0; shift == 0 || (max_key >> shift) > 0;
+       shift += RADIX_BITS) {
+    std::fill(histograms.begin(), histograms.end(), 0);
+    at::parallel_for(0, n_chunks, 1, [&](int64_t c_begin, int64_t c_end) {
+      for (int64_t c = c_begin; c < c_end; c++) {
+        int64_t* hist = histograms.data() + c * RADIX;
+        int64_t end = std::min((c + 1) * chunk_size, n);
+        for (int64_t i = c * chunk_size; i < end; i++) {
+          hist[(keys_in[i] >> shift) & (RADIX - 1)]++;
+        }
+      }
+    });
+    // An exclusive scan in (digit, chunk) order hands every chunk its write
+    // offsets; chunks then scatter independently while staying stable.
+    int64_t offset = 0;
+    for (int64_t d = 0; d < RADIX; d++) {
+      for (int64_t c = 0; c < n_chunks; c++) {
+        int64_t count = histograms[c * RADIX + d];
+        histograms[c * RADIX + d] = offset;
+        offset += count;
+      }
+    }
+    at::parallel_for(0, n_chunks, 1, [&](int64_t c_begin, int64_t c_end) {
+      for (int64_t c = c_begin; c < c_end; c++) {
+        int64_t* hist = histograms.data() + c * RADIX;
+        int64_t end = std::min((c + 1) * chunk_size, n);
+        for (int64_t i = c * chunk_size; i < end; i++) {
+          int64_t pos = hist[(keys_in[i] >> shift) & (RADIX - 1)]++;
+          keys_out[pos] = keys_in[i];
+          positions_out[pos] = positions_in[i];
+        }
+      }
+    });
+    std::swap(keys_in, keys_out);
+    std::swap(positions_in, positions_out);
+  }
+
+  if (keys_in != keys.data_ptr<int64_t>()) {
+    // odd number of passes: the sorted data ended up in the scratch buffers
+    std::memcpy(keys.data_ptr<int64_t>(), keys_in, n * sizeof(int64_t));
+    std::memcpy(
+        positions.data_ptr<int64_t>(), positions_in, n * sizeof(int64_t));
+  }
+}
+
+// Offsets of the contiguous equal-index runs in a sorted index array,
+// terminated by n (so run r spans [starts[r], starts[r + 1])).
+Tensor build_run_starts(const int64_t* sorted, int64_t n, const TensorOptions& options) {
+  std::vector<int64_t> starts;
+  for (int64_t i = 0; i < n; i++) {
+    if (i == 0 || sorted[i] != sorted[i - 1]) {
+      starts.push_back(i);
+    }
+  }
+  starts.push_back(n);
+  auto result = at::empty({static_cast<int64_t>(starts.size())}, options);
+  std::memcpy(
+      result.data_ptr<int64_t>(),
+      starts.data(),
+      starts.size() * sizeof(int64_t));
+  return result;
+}
+
+} // anonymous namespace
+
 Tensor embedding(const Tensor & weight, const Tensor & indices,
                  int64_t padding_idx, bool scale_grad_by_freq, bool sparse) {
   auto indices_arg = TensorArg(indices, "indices", 1);
@@ -74,6 +165,40 @@ Tensor embedding_sparse_backward(
 
   auto index = indices.reshape({1, -1});
   auto values = grad.reshape({-1, num_features});
+
+  if (!grad.is_cuda() &&
+      (values.scalar_type() == kFloat || values.scalar_type() == kDouble)) {
+    // Emit the gradient already coalesced: sort the indices once here and
+    // segment-reduce duplicate rows, instead of paying for the sort inside
+    // SparseTensor coalesce() on every gradient accumulation.
+    auto values_contig = values.contiguous();
+    auto sorted = index.reshape(-1).clone();
+    auto positions = at::empty_like(sorted);
+    auto positions_data = positions.data_ptr<int64_t>();
+    std::iota(positions_data, positions_data + positions.numel(), 0);
+    radix_sort_index_pairs(sorted, positions, num_weights - 1);
+
+    auto run_starts =
+        build_run_starts(sorted.data_ptr<int64_t>(), sorted.numel(), sorted.options());
+    int64_t n_runs = run_starts.numel() - 1;
+    auto out_indices = at::empty({1, n_runs}, indices.options());
+    auto out_indices_data = out_indices.data_ptr<int64_t>();
+    auto sorted_data = sorted.data_ptr<int64_t>();
+    auto run_starts_data = run_starts.data_ptr<int64_t>();
+    for (int64_t r = 0; r < n_runs; r++) {
+      out_indices_data[r] = sorted_data[run_starts_data[r]];
+    }
+    auto out_values = at::zeros({n_runs, num_features}, dense_options);
+    embedding_sorted_backward_stub(
+        kCPU, out_values, values_contig, sorted, positions, run_starts,
+        /*packed=*/true, /*padding_idx=*/-1, /*counts=*/nullptr);
+
+    auto result =
+        at::_sparse_coo_tensor_unsafe(out_indices, out_values, weight_size);
+    result._coalesced_(true);
+    return result;
+  }
+
   return at::_sparse_coo_tensor_unsafe(index, values, weight_size);
 }
 
@@ -102,6 +227,26 @@ Tensor embedding_dense_backward_cpu(
   auto grad = grad_.contiguous().view({numel, grad_.size(-1)});
   auto grad_weight = at::zeros({num_weights, grad_.size(-1)}, grad_.options());
 
+  if (numel > 0 &&
+      (grad.scalar_type() == kFloat || grad.scalar_type() == kDouble)) {
+    // Sort the indices once so all updates to a weight row form one
+    // contiguous run, then reduce each run with a single vectorized pass.
+    // Unlike the scatter strategy below, no thread re-traverses the whole
+    // input and no two threads ever touch the same row.
+    auto sorted = indices_contig.reshape(-1).clone();
+    auto positions = at::empty_like(sorted);
+    auto positions_data = positions.data_ptr<int64_t>();
+    std::iota(positions_data, positions_data + numel, 0);
+    radix_sort_index_pairs(sorted, positions, num_weights - 1);
+
+    auto run_starts =
+        build_run_starts(sorted.data_ptr<int64_t>(), numel, sorted.options());
+    embedding_sorted_backward_stub(
+        kCPU, grad_weight, grad, sorted, positions, run_starts,
+        /*packed=*/false, padding_idx, counts.get());
+    return grad_weight;
+  }
+
   auto parallel_section = [&](int64_t start, int64_t end) {
     for (int64_t i = 0; i < numel; i++) {
       if (indices_data[i] != padding_idx) {
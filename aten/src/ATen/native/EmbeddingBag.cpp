@@ -2,6 +2,7 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
+#include <ATen/cpu/vec256/vec256.h>
 
 #include <TH/THBlasUtils.h>
 
@@ -34,11 +35,95 @@ static void make_offset2bag(const Tensor &offsets, const Tensor &indices, Tensor
 namespace {
 
 bool isFastPathIndexSelect(const Tensor& src, Tensor& output) {
-  return src.scalar_type() == kFloat && src.stride(1) == 1 && output.stride(1) == 1;
+  return (src.scalar_type() == kFloat || src.scalar_type() == kDouble) &&
+      src.stride(1) == 1 && output.stride(1) == 1;
 }
 
 bool isFastPathIndexSelectScale(const Tensor& src, const Tensor& scale, Tensor& output) {
-  return src.scalar_type() == kFloat && src.stride(1) == 1 && output.stride(1) == 1 && scale.stride(0) == 1;
+  return (src.scalar_type() == kFloat || src.scalar_type() == kDouble) &&
+      src.stride(1) == 1 && output.stride(1) == 1 && scale.stride(0) == 1;
+}
+
+// Note [Blocked embedding bag accumulation]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// For large embedding tables the working set does not fit in cache, so bag
+// accumulation is dominated by DRAM latency on the gathered rows. The float
+// fast path hides that latency inside caffe2's EmbeddingLookupIdx perfkernels
+// (which prefetch upcoming rows), but those kernels only exist for float,
+// half and uint8 inputs, so the double path used to walk every index serially
+// through THBlas_axpy. The helpers below give double the same treatment:
+// bags are partitioned across at::parallel_for (each bag owns its output row,
+// so no synchronization is needed), the row for an upcoming index is software
+// prefetched while the current row is accumulated, and the accumulation
+// itself runs through Vec256.
+
+// How many indices ahead of the current one to prefetch. Matches the
+// distance used by the perfkernels embedding lookups: far enough to cover
+// DRAM latency, close enough that the line is still resident when we get
+// there.
+constexpr int64_t kEmbeddingBagPrefetchDistance = 16;
+
+inline void prefetch_embedding_row(const void* row) {
+#if defined(__GNUC__)
+  __builtin_prefetch(row, /*rw=*/0, /*locality=*/3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char*>(row), _MM_HINT_T0);
+#else
+  (void)row;
+#endif
+}
+
+// Accumulates the bags in [start_bag, end_bag) into their output rows.
+// `weights` is optional per-sample scaling (nullptr for a plain sum). The
+// output rows are expected to be zero-initialized, which `embedding_bag`
+// guarantees via at::zeros.
+static void embedding_bag_blocked_acc(
+    const double* src_data,
+    const double* weights,
+    const int64_t* select_indices_data,
+    const int64_t* offsets_data,
+    double* output_data,
+    int64_t ddim,
+    int64_t start_bag,
+    int64_t end_bag) {
+  using Vec = vec256::Vec256<double>;
+  for (int64_t bag = start_bag; bag < end_bag; ++bag) {
+    double* output_row = output_data + bag * ddim;
+    const int64_t begin = offsets_data[bag];
+    const int64_t end = offsets_data[bag + 1];
+    for (int64_t i = begin; i < end; ++i) {
+      const double* src_row = src_data + select_indices_data[i] * ddim;
+      // Prefetch the row we will need kEmbeddingBagPrefetchDistance indices
+      // from now, one cache line per Vec256 chunk processed below. Prefetch
+      // never faults, so no bounds check on the upcoming index is needed.
+      const int64_t prefetch_i =
+          std::min(i + kEmbeddingBagPrefetchDistance, end - 1);
+      const double* prefetch_row =
+          src_data + select_indices_data[prefetch_i] * ddim;
+      int64_t d = 0;
+      if (weights != nullptr) {
+        const Vec scale(weights[i]);
+        for (; d + Vec::size() <= ddim; d += Vec::size()) {
+          prefetch_embedding_row(prefetch_row + d);
+          auto sum =
+              vec256::fmadd(Vec::loadu(src_row + d), scale, Vec::loadu(output_row + d));
+          sum.store(output_row + d);
+        }
+        for (; d < ddim; ++d) {
+          output_row[d] += src_row[d] * weights[i];
+        }
+      } else {
+        for (; d + Vec::size() <= ddim; d += Vec::size()) {
+          prefetch_embedding_row(prefetch_row + d);
+          auto sum = Vec::loadu(output_row + d) + Vec::loadu(src_row + d);
+          sum.store(output_row + d);
+        }
+        for (; d < ddim; ++d) {
+          output_row[d] += src_row[d];
+        }
+      }
+    }
+  }
 }
 
 // This function combines index_select (using select_indices as the index) and
@@ -135,6 +220,67 @@ void index_select_add<float>(const Tensor &select_indices,
   }
 }
 
+// See Note [Blocked embedding bag accumulation].
+template<>
+void index_select_add<double>(const Tensor &select_indices,
+                              const Tensor &add_indices,
+                              const Tensor &src,
+                              Tensor &output,
+                              const Tensor& offsets,
+                              bool include_last_offset) {
+  int64_t ddim = src.size(1);
+  auto* src_data = src.data_ptr<double>();
+  auto* select_indices_data = select_indices.data_ptr<int64_t>();
+  auto* output_data = output.data_ptr<double>();
+
+  if (isFastPathIndexSelect(src, output)) {
+    int64_t output_size = offsets.numel() - 1;
+    auto* offsets_data = offsets.data_ptr<int64_t>();
+    std::vector<int64_t> offsets_include_last;
+
+    if (!include_last_offset) {
+      output_size = offsets.numel();
+      offsets_include_last.resize(offsets.numel() + 1);
+      std::memcpy(
+          offsets_include_last.data(),
+          offsets.data_ptr<int64_t>(),
+          sizeof(int64_t) * offsets.numel());
+      offsets_include_last[offsets.numel()] = select_indices.numel();
+      offsets_data = offsets_include_last.data();
+    }
+
+    at::parallel_for(
+        0, output_size, 1, [&](int64_t start_idx, int64_t end_idx) {
+          embedding_bag_blocked_acc(
+              src_data,
+              /*weights=*/nullptr,
+              select_indices_data,
+              offsets_data,
+              output_data,
+              ddim,
+              start_idx,
+              end_idx);
+        });
+  } else {
+    AT_ASSERT(select_indices.numel() == add_indices.numel());
+    auto* add_indices_data = add_indices.data_ptr<int64_t>();
+    auto src_stride0 = src.stride(0);
+    auto src_stride1 = src.stride(1);
+    auto output_stride0 = output.stride(0);
+    auto output_stride1 = output.stride(1);
+    auto numel = add_indices.numel();
+    for (int64_t i = 0; i < numel; i++) {
+      THBlas_axpy<double>(
+          ddim,
+          1,
+          src_data + src_stride0 * select_indices_data[i],
+          src_stride1,
+          output_data + output_stride0 * add_indices_data[i],
+          output_stride1);
+    }
+  }
+}
+
 // This function fuses the following three fns:
 // index_select (using select_indices as the index)
 // mul (scaling by per_sample_weights)
@@ -241,6 +387,70 @@ void index_select_scale_add<float>(const Tensor &select_indices,
   }
 }
 
+// See Note [Blocked embedding bag accumulation].
+template<>
+void index_select_scale_add<double>(const Tensor &select_indices,
+                                    const Tensor &add_indices,
+                                    const Tensor &scale,
+                                    const Tensor &src,
+                                    Tensor &output,
+                                    const Tensor& offsets,
+                                    bool include_last_offset) {
+  int64_t ddim = src.size(1);
+  auto* scale_data = scale.data_ptr<double>();
+  auto* select_indices_data = select_indices.data_ptr<int64_t>();
+  auto* src_data = src.data_ptr<double>();
+  auto* output_data = output.data_ptr<double>();
+
+  if (isFastPathIndexSelectScale(src, scale, output)) {
+    int64_t output_size = offsets.numel() - 1;
+    auto* offsets_data = offsets.data_ptr<int64_t>();
+    std::vector<int64_t> offsets_include_last;
+
+    if (!include_last_offset) {
+      output_size = offsets.numel();
+      offsets_include_last.resize(offsets.numel() + 1);
+      std::memcpy(
+          offsets_include_last.data(),
+          offsets.data_ptr<int64_t>(),
+          sizeof(int64_t) * offsets.numel());
+      offsets_include_last[offsets.numel()] = select_indices.numel();
+      offsets_data = offsets_include_last.data();
+    }
+
+    at::parallel_for(
+        0, output_size, 1, [&](int64_t start_idx, int64_t end_idx) {
+          embedding_bag_blocked_acc(
+              src_data,
+              /*weights=*/scale_data,
+              select_indices_data,
+              offsets_data,
+              output_data,
+              ddim,
+              start_idx,
+              end_idx);
+        });
+  } else {
+    AT_ASSERT(select_indices.numel() == add_indices.numel());
+    auto* add_indices_data = add_indices.data_ptr<int64_t>();
+    auto src_stride0 = src.stride(0);
+    auto src_stride1 = src.stride(1);
+    auto output_stride0 = output.stride(0);
+    auto output_stride1 = output.stride(1);
+    auto scale_stride = scale.stride(0);
+    auto numel = add_indices.numel();
+
+    for (int64_t i = 0; i < numel; i++) {
+      auto* src_base = src_data + src_stride0 * select_indices_data[i];
+      auto* output_base = output_data + output_stride0 * add_indices_data[i];
+      auto scale = scale_data[i * scale_stride];
+      for (int64_t j = 0; j < ddim; j++) {
+        output_base[j * output_stride1] += src_base[j * src_stride1] * scale;
+      }
+    }
+  }
+}
+
 }  // namespace
 
 static at::Tensor make_bag_size(
@@ -0,0 +1,60 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+void check_foreach_args(TensorList self, TensorList other) {
+  TORCH_CHECK(self.size() > 0, "Tensor list must have at least one tensor.");
+  TORCH_CHECK(
+      self.size() == other.size(),
+      "Tensor lists must have the same number of tensors, got ",
+      self.size(),
+      " and ",
+      other.size());
+}
+
+} // anonymous namespace
+
+// These loop over the lists inside one dispatched call and invoke the
+// at::native kernels directly, so each pair pays only TensorIterator setup
+// rather than a full dispatch plus autograd node creation. The native
+// binary kernels select the backend via their DispatchStubs, so a single
+// implementation covers CPU and CUDA.
+
+void _foreach_add_(TensorList self, TensorList other, Scalar alpha) {
+  check_foreach_args(self, other);
+  for (size_t i = 0; i < self.size(); i++) {
+    Tensor t = self[i];
+    at::native::add_(t, other[i], alpha);
+  }
+}
+
+void _foreach_sub_(TensorList self, TensorList other, Scalar alpha) {
+  check_foreach_args(self, other);
+  for (size_t i = 0; i < self.size(); i++) {
+    Tensor t = self[i];
+    at::native::sub_(t, other[i], alpha);
+  }
+}
+
+void _foreach_mul_(TensorList self, TensorList other) {
+  check_foreach_args(self, other);
+  for (size_t i = 0; i < self.size(); i++) {
+    Tensor t = self[i];
+    at::native::mul_(t, other[i]);
+  }
+}
+
+void _foreach_div_(TensorList self, TensorList other) {
+  check_foreach_args(self, other);
+  for (size_t i = 0; i < self.size(); i++) {
+    Tensor t = self[i];
+    at::native::div_(t, other[i]);
+  }
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,79 @@
+// Fused single-pass optimizer update steps
+#include <ATen/native/FusedOptimizerOps.h>
+
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(fused_adam_stub);
+DEFINE_DISPATCH(fused_sgd_momentum_stub);
+
+namespace {
+
+// The fused kernels walk the raw buffers in lockstep, so every operand must
+// be a dense, contiguous strided tensor of the same floating type and shape.
+void check_fused_step_args(
+    const char* name,
+    const Tensor& param,
+    TensorList others) {
+  TORCH_CHECK(
+      param.layout() == kStrided && param.is_contiguous(),
+      name, ": expected a contiguous parameter tensor");
+  TORCH_CHECK(
+      param.scalar_type() == kFloat || param.scalar_type() == kDouble,
+      name, ": only float and double parameters are supported, got ",
+      param.scalar_type());
+  for (const auto& t : others) {
+    TORCH_CHECK(
+        t.layout() == kStrided && t.is_contiguous(),
+        name, ": expected contiguous gradient and state tensors");
+    TORCH_CHECK(
+        t.scalar_type() == param.scalar_type(),
+        name, ": expected all tensors to have type ", param.scalar_type(),
+        " but got ", t.scalar_type());
+    TORCH_CHECK(
+        t.sizes().equals(param.sizes()),
+        name, ": expected all tensors to have shape ", param.sizes(),
+        " but got ", t.sizes());
+  }
+}
+
+} // anonymous namespace
+
+void _fused_adam_step_cpu_(
+    Tensor& self,
+    const Tensor& grad,
+    Tensor& exp_avg,
+    Tensor& exp_avg_sq,
+    int64_t step,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps) {
+  check_fused_step_args("_fused_adam_step_", self, {grad, exp_avg, exp_avg_sq});
+  TORCH_CHECK(step > 0, "_fused_adam_step_: expected step to be positive");
+  fused_adam_stub(
+      kCPU, self, grad, exp_avg, exp_avg_sq, step, lr, beta1, beta2,
+      weight_decay, eps);
+}
+
+void _fused_sgd_momentum_step_cpu_(
+    Tensor& self,
+    const Tensor& grad,
+    Tensor& momentum_buffer,
+    double lr,
+    double momentum,
+    double dampening,
+    double weight_decay,
+    bool nesterov) {
+  check_fused_step_args("_fused_sgd_momentum_step_", self, {grad, momentum_buffer});
+  fused_sgd_momentum_stub(
+      kCPU, self, grad, momentum_buffer, lr, momentum, dampening,
+      weight_decay, nesterov);
+}
+
+} // namespace native
+} // namespace at
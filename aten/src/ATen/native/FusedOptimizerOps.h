@@ -0,0 +1,36 @@
+// Fused single-pass optimizer update steps
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+using fused_adam_fn = void (*)(
+    Tensor& param,
+    const Tensor& grad,
+    Tensor& exp_avg,
+    Tensor& exp_avg_sq,
+    int64_t step,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps);
+
+using fused_sgd_momentum_fn = void (*)(
+    Tensor& param,
+    const Tensor& grad,
+    Tensor& momentum_buffer,
+    double lr,
+    double momentum,
+    double dampening,
+    double weight_decay,
+    bool nesterov);
+
+DECLARE_DISPATCH(fused_adam_fn, fused_adam_stub);
+DECLARE_DISPATCH(fused_sgd_momentum_fn, fused_sgd_momentum_stub);
+
+} // namespace native
+} // namespace at
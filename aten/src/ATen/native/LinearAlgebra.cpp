@@ -199,14 +199,22 @@ inline void baddbmm_cpu_kernel(const Tensor& result, const Tensor& self, const T
 }
 
 // This tries to apply some optimizations to bmm/baddbmm:
-// - When the operand size is small, computation are parallelized over the batch
-//   dimension using OMP and naive matrix multiplication is applied.
-// - When the operand size is larger than the threshold, if compiled with MKL, MKL's batch gemm is used.
+// - When the operand size is small and the batch is small, computation are
+//   parallelized over the batch dimension using OMP and naive matrix
+//   multiplication is applied.
+// - When the operand size is larger than the threshold, or when the batch is
+//   large enough that a single grouped gemm amortizes the per-matrix dispatch
+//   overhead (think transformer heads: hundreds of 64x64 multiplications), if
+//   compiled with MKL, MKL's batch gemm is used.
 // - Otherwise, we use a series of matrix multiplications.
 // The threshold of 400 for the first has not been thoroughly benchmarked yet and may have room for further
 // optimization, it likely depends on the characteristics of the CPU, MKL will be different from non-MKL etc.,
 // but this seems to be a first starting point.
 
+// Minimum batch size for which a single MKL batched gemm call is preferred
+// over the naive small-matrix kernel above.
+constexpr int64_t kMklBatchedGemmMinBatch = 64;
+
 static inline Tensor& bmm_out_or_baddbmm_(Tensor& self_or_result, const Tensor& batch1, const Tensor& batch2, Scalar beta, Scalar alpha, bool is_bmm_out) {
   // is_bmm_out: true for bmm_out, false for baddbmm_
   // self_or_result is "self" for baddbmm_ and "result" for bmm_out
@@ -245,7 +253,13 @@ static inline Tensor& bmm_out_or_baddbmm_(Tensor& self_or_result, const Tensor&
             || (t.stride(1) == 1 && t.stride(2) >= t.size(1));
   };
 
-  if (contraction_size * res_rows * res_cols < 400) {
+  const bool apply_mkl_batched = at::hasMKL() && at::native::is_floating_point(self_or_result)
+            && batch_items_contiguous_or_transposed(batch1)
+            && batch_items_contiguous_or_transposed(batch2)
+            && self_or_result.is_contiguous();
+
+  if (contraction_size * res_rows * res_cols < 400
+      && !(apply_mkl_batched && bs >= kMklBatchedGemmMinBatch)) {
     if (is_bmm_out) {
       AT_DISPATCH_ALL_TYPES(batch1.scalar_type(), "bmm", [&] {
           baddbmm_cpu_kernel<scalar_t, true>(self_or_result, batch1, batch2, beta, alpha);
@@ -255,10 +269,7 @@ static inline Tensor& bmm_out_or_baddbmm_(Tensor& self_or_result, const Tensor&
           baddbmm_cpu_kernel<scalar_t, false>(self_or_result, batch1, batch2, beta, alpha);
         });
     }
-  } else if (at::hasMKL() && at::native::is_floating_point(self_or_result)
-            && batch_items_contiguous_or_transposed(batch1)
-            && batch_items_contiguous_or_transposed(batch2)
-            && self_or_result.is_contiguous()) {
+  } else if (apply_mkl_batched) {
     at::native::_baddbmm_mkl_(self_or_result, batch1, batch2, beta, alpha);
   } else { // split along batch dimension
     if (is_bmm_out) {
@@ -516,7 +527,9 @@ Tensor frobenius_norm(const Tensor& self, IntArrayRef dim, bool keepdim) {
   if (self.is_complex()){
     return at::sqrt(at::sum((self.conj() * self).real(), dim, keepdim));
   } else {
-    return at::sqrt(at::sum((self * self), dim, keepdim));
+    // A single fused norm reduction; going through sum(self * self) would
+    // materialize the squares and read the input twice.
+    return at::norm(self, 2, dim, keepdim, self.scalar_type());
   }
 }
 
@@ -536,7 +549,7 @@ Tensor &frobenius_norm_out(
   if (self.is_complex()){
     return at::sqrt_out(result, at::sum((self.conj() * self).real(), dim, keepdim));
   } else {
-    return at::sqrt_out(result, at::sum((self * self), dim, keepdim));
+    return at::norm_out(result, self, 2, dim, keepdim, self.scalar_type());
   }
 }
 
@@ -3,6 +3,7 @@
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
+#include <ATen/native/cpu/CrossEntropyKernel.h>
 
 namespace at {
 namespace native {
@@ -393,5 +394,35 @@ Tensor nll_loss_backward_cpu(
   return grad_input;
 }
 
+DEFINE_DISPATCH(cross_entropy_fused_kernel);
+
+Tensor _cross_entropy_fused_cpu(
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  TORCH_CHECK(
+      self.dim() == 2,
+      "_cross_entropy_fused: expected 2-D input (batch, classes), got input of size: ",
+      self.sizes());
+  TORCH_CHECK(
+      target.dim() == 1 && target.size(0) == self.size(0),
+      "_cross_entropy_fused: expected 1-D target of size ",
+      self.size(0),
+      ", got target of size: ",
+      target.sizes());
+  TORCH_CHECK(
+      !weight.defined() || weight.numel() == self.size(1),
+      "_cross_entropy_fused: weight tensor should be defined either for all ",
+      self.size(1),
+      " classes or no classes but got weight tensor of shape: ",
+      weight.sizes());
+
+  auto output = at::empty({0}, self.options());
+  cross_entropy_fused_kernel(kCPU, output, self, target, weight, reduction, ignore_index);
+  return output;
+}
+
 } // namespace native
 } // namespace at
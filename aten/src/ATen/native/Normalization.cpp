@@ -284,25 +284,24 @@ std::tuple<Tensor,Tensor> batch_norm_cpu_update_stats_template(
     for (int64_t f = b_begin; f < b_end; ++f) {
       Tensor in = input.select(1, f);
 
-      // compute mean per input
+      // compute mean and variance per input in a single pass over the data
+      // (Welford's algorithm), instead of one pass for the mean and a second
+      // one for the variance
       auto iter = TensorIterator();
       iter.add_input(in);
       iter.build();
-      accscalar_t sum = 0;
+      accscalar_t running_avg = 0;
+      accscalar_t m2 = 0;
+      int64_t count = 0;
       cpu_serial_kernel(iter, [&](const scalar_t i) -> void {
-        sum += i;
+        count++;
+        accscalar_t delta = i - running_avg;
+        running_avg += delta / count;
+        m2 += delta * (i - running_avg);
       });
-      scalar_t mean = sum / n;
+      scalar_t mean = running_avg;
+      accscalar_t var_sum = m2;
       save_mean_a[f] = mean;
-
-      // compute variance per input
-      iter = TensorIterator();
-      iter.add_input(in);
-      iter.build();
-      accscalar_t var_sum = 0;
-      cpu_serial_kernel(iter, [&](const scalar_t i) -> void {
-        var_sum += (i - mean) * (i - mean);
-      });
       save_var_transform_a[f] = VarTransform<accscalar_t>{}(var_sum / n, eps);
 
       // update running averages
@@ -0,0 +1,148 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/native/cpu/SoftmaxKernel.h>
+
+// Ragged batches represent variable-length sequences without padding: a
+// `values` tensor of shape [total, ...] holds the concatenated segments and
+// a `offsets` tensor of shape [n_segments + 1] delimits them, in the same
+// way embedding_bag consumes (indices, offsets) pairs. Position-independent
+// ops (embedding lookup of the flat values, linear over the trailing
+// dimension) already work on `values` unchanged; the ops here cover the
+// cases that need to know where segments begin and end.
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(ragged_softmax_kernel);
+
+namespace {
+
+// Returns the number of segments after validating the offsets tensor
+// against the ragged dimension of `values`.
+int64_t check_ragged_offsets(const Tensor& offsets, int64_t total) {
+  TORCH_CHECK(
+      offsets.dim() == 1 && offsets.device().type() == at::kCPU &&
+          offsets.scalar_type() == at::kLong,
+      "'offsets' argument should be a 1D CPU int64 tensor");
+  TORCH_CHECK(offsets.numel() >= 1, "'offsets' can not be empty");
+  auto offsets_c = offsets.contiguous();
+  const int64_t* data = offsets_c.data_ptr<int64_t>();
+  int64_t n_segments = offsets.numel() - 1;
+  TORCH_CHECK(data[0] == 0, "'offsets' must start with 0");
+  for (int64_t i = 0; i < n_segments; i++) {
+    TORCH_CHECK(
+        data[i] <= data[i + 1], "'offsets' must be nondecreasing");
+  }
+  TORCH_CHECK(
+      data[n_segments] == total,
+      "last element of 'offsets' (",
+      data[n_segments],
+      ") must equal the length of the ragged dimension (",
+      total,
+      ")");
+  return n_segments;
+}
+
+} // namespace
+
+Tensor ragged_softmax_cpu(const Tensor& self, const Tensor& offsets) {
+  TORCH_CHECK(
+      self.dim() == 1 || self.dim() == 2,
+      "ragged_softmax: expected a 1D or 2D values tensor, got ",
+      self.dim(),
+      "D");
+  check_ragged_offsets(offsets, self.size(0));
+  auto values = self.contiguous();
+  auto offsets_c = offsets.contiguous();
+  Tensor output = at::empty_like(values);
+  if (values.numel() > 0) {
+    ragged_softmax_kernel(kCPU, output, values, offsets_c);
+  }
+  return output;
+}
+
+Tensor ragged_to_padded_cpu(
+    const Tensor& self,
+    const Tensor& offsets,
+    Scalar padding_value) {
+  TORCH_CHECK(
+      self.dim() >= 1,
+      "ragged_to_padded: values tensor must have at least one dimension");
+  int64_t n_segments = check_ragged_offsets(offsets, self.size(0));
+  auto offsets_c = offsets.contiguous();
+  const int64_t* offs = offsets_c.data_ptr<int64_t>();
+
+  int64_t max_len = 0;
+  for (int64_t b = 0; b < n_segments; b++) {
+    max_len = std::max(max_len, offs[b + 1] - offs[b]);
+  }
+
+  std::vector<int64_t> sizes = {n_segments, max_len};
+  for (int64_t d = 1; d < self.dim(); d++) {
+    sizes.push_back(self.size(d));
+  }
+  Tensor padded = at::full(sizes, padding_value, self.options());
+  for (int64_t b = 0; b < n_segments; b++) {
+    int64_t length = offs[b + 1] - offs[b];
+    if (length > 0) {
+      padded.select(0, b).narrow(0, 0, length).copy_(
+          self.narrow(0, offs[b], length));
+    }
+  }
+  return padded;
+}
+
+std::tuple<Tensor, Tensor> padded_to_ragged_cpu(
+    const Tensor& self,
+    const Tensor& lengths) {
+  TORCH_CHECK(
+      self.dim() >= 2,
+      "padded_to_ragged: expected a [batch, max_len, ...] tensor, got ",
+      self.dim(),
+      "D");
+  TORCH_CHECK(
+      lengths.dim() == 1 && lengths.device().type() == at::kCPU &&
+          lengths.scalar_type() == at::kLong,
+      "'lengths' argument should be a 1D CPU int64 tensor");
+  int64_t batch_size = self.size(0);
+  int64_t max_len = self.size(1);
+  TORCH_CHECK(
+      lengths.numel() == batch_size,
+      "expected `len(lengths)` to be equal to batch_size, but got ",
+      lengths.numel(),
+      " (batch_size=",
+      batch_size,
+      ")");
+  auto lengths_c = lengths.contiguous();
+  const int64_t* lens = lengths_c.data_ptr<int64_t>();
+
+  Tensor offsets = at::empty({batch_size + 1}, lengths.options());
+  int64_t* offs = offsets.data_ptr<int64_t>();
+  offs[0] = 0;
+  for (int64_t b = 0; b < batch_size; b++) {
+    TORCH_CHECK(
+        lens[b] >= 0 && lens[b] <= max_len,
+        "length ",
+        lens[b],
+        " at position ",
+        b,
+        " is out of range [0, ",
+        max_len,
+        "]");
+    offs[b + 1] = offs[b] + lens[b];
+  }
+
+  std::vector<int64_t> sizes = {offs[batch_size]};
+  for (int64_t d = 2; d < self.dim(); d++) {
+    sizes.push_back(self.size(d));
+  }
+  Tensor values = at::empty(sizes, self.options());
+  for (int64_t b = 0; b < batch_size; b++) {
+    if (lens[b] > 0) {
+      values.narrow(0, offs[b], lens[b]).copy_(
+          self.select(0, b).narrow(0, 0, lens[b]));
+    }
+  }
+  return std::make_tuple(values, offsets);
+}
+
+}} // namespace at::native
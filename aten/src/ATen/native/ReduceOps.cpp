@@ -33,6 +33,7 @@ DEFINE_DISPATCH(and_stub);
 DEFINE_DISPATCH(or_stub);
 DEFINE_DISPATCH(min_values_stub);
 DEFINE_DISPATCH(max_values_stub);
+DEFINE_DISPATCH(min_max_stub);
 DEFINE_DISPATCH(argmax_stub);
 DEFINE_DISPATCH(argmin_stub);
 DEFINE_DISPATCH(cumsum_stub);
@@ -711,6 +712,19 @@ Tensor &any_out(Tensor &result, const Tensor &self, int64_t dim, bool keepdim) {
   }
 }
 
+// Computes min and max over all elements in a single pass over the data.
+std::tuple<Tensor, Tensor> _min_max(const Tensor& self) {
+  TORCH_CHECK(self.numel() > 0,
+              "_min_max on a tensor with no elements is not defined.");
+  Tensor min_result = at::empty({0}, self.options());
+  Tensor max_result = at::empty({0}, self.options());
+  ScalarType dtype = get_dtype(min_result, self, {}, true);
+  auto iter = make_reduction(
+      "_min_max", min_result, max_result, self, {}, false, dtype);
+  min_max_stub(iter.device_type(), iter);
+  return std::make_tuple(min_result, max_result);
+}
+
 Tensor min_values(const Tensor& self, IntArrayRef dims, bool keepdim) {
   if (dims.size() == 1) {
     return std::get<0>(self.min(dims[0], keepdim));
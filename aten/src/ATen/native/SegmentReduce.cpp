@@ -0,0 +1,107 @@
+#include <ATen/native/SegmentReduce.h>
+
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(segment_reduce_stub);
+DEFINE_DISPATCH(segment_reduce_backward_stub);
+
+namespace {
+
+SegmentReduceOp parse_segment_reduce_op(const std::string& reduce) {
+  if (reduce == "sum") {
+    return SegmentReduceOp::SUM;
+  }
+  if (reduce == "mean") {
+    return SegmentReduceOp::MEAN;
+  }
+  if (reduce == "max") {
+    return SegmentReduceOp::MAX;
+  }
+  TORCH_CHECK(
+      false,
+      "segment_reduce: unsupported reduction \"",
+      reduce,
+      "\", expected one of \"sum\", \"mean\" or \"max\"");
+}
+
+void check_segment_reduce_inputs(
+    const Tensor& values,
+    const Tensor& offsets,
+    SegmentReduceOp op) {
+  TORCH_CHECK(
+      values.dim() >= 1,
+      "segment_reduce: values must have at least one dimension, got ",
+      values.dim());
+  TORCH_CHECK(
+      offsets.dim() == 1 && offsets.numel() >= 1,
+      "segment_reduce: offsets must be a 1-D tensor with at least one "
+      "element (segment i covers rows [offsets[i], offsets[i + 1]))");
+  TORCH_CHECK(
+      offsets.scalar_type() == ScalarType::Long,
+      "segment_reduce: offsets must have scalar type Long, got ",
+      offsets.scalar_type());
+  TORCH_CHECK(
+      offsets.device() == values.device(),
+      "segment_reduce: expected offsets on the same device as values (",
+      values.device(),
+      "), got ",
+      offsets.device());
+  TORCH_CHECK(
+      op != SegmentReduceOp::MEAN || values.is_floating_point(),
+      "segment_reduce: \"mean\" requires a floating point values tensor, "
+      "got ",
+      values.scalar_type());
+}
+
+} // namespace
+
+Tensor segment_reduce(
+    const Tensor& values,
+    const Tensor& offsets,
+    std::string reduce) {
+  const auto op = parse_segment_reduce_op(reduce);
+  check_segment_reduce_inputs(values, offsets, op);
+
+  const int64_t num_segments = offsets.numel() - 1;
+  auto output_sizes = values.sizes().vec();
+  output_sizes[0] = num_segments;
+  Tensor output = at::empty(output_sizes, values.options());
+  if (output.numel() > 0) {
+    segment_reduce_stub(
+        values.device().type(),
+        output,
+        values.contiguous(),
+        offsets.contiguous(),
+        op);
+  }
+  return output;
+}
+
+Tensor _segment_reduce_backward(
+    const Tensor& grad,
+    const Tensor& output,
+    const Tensor& values,
+    const Tensor& offsets,
+    std::string reduce) {
+  const auto op = parse_segment_reduce_op(reduce);
+  check_segment_reduce_inputs(values, offsets, op);
+
+  // Rows not covered by any segment receive no gradient.
+  Tensor grad_values = at::zeros_like(values);
+  if (grad_values.numel() > 0 && grad.numel() > 0) {
+    segment_reduce_backward_stub(
+        values.device().type(),
+        grad_values,
+        grad.contiguous(),
+        output.contiguous(),
+        values.contiguous(),
+        offsets.contiguous(),
+        op);
+  }
+  return grad_values;
+}
+
+}} // namespace at::native
@@ -0,0 +1,29 @@
+// Sorted-segment reductions for neighborhood aggregation. Implementations
+// are in SegmentReduce.cpp and the per-device kernel files.
+
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+enum class SegmentReduceOp : uint8_t { SUM, MEAN, MAX };
+
+using segment_reduce_fn = void (*)(
+    Tensor& /* output */,
+    const Tensor& /* values */,
+    const Tensor& /* offsets */,
+    SegmentReduceOp);
+DECLARE_DISPATCH(segment_reduce_fn, segment_reduce_stub);
+
+using segment_reduce_backward_fn = void (*)(
+    Tensor& /* grad_values */,
+    const Tensor& /* grad */,
+    const Tensor& /* output */,
+    const Tensor& /* values */,
+    const Tensor& /* offsets */,
+    SegmentReduceOp);
+DECLARE_DISPATCH(segment_reduce_backward_fn, segment_reduce_backward_stub);
+
+}} // namespace at::native
@@ -374,6 +374,38 @@ struct ArgMinOps :
   public detail::ArgReductionOps<detail::LessOrNan<scalar_t>> {
 };
 
+// Multi-output reduction computing the minimum and the maximum in a single
+// pass over the data. NaNs propagate to both outputs, matching min/max.
+template <typename scalar_t, typename acc_scalar_t, typename res_t>
+struct MinMaxOps {
+  using acc_t = detail::pair<acc_scalar_t, acc_scalar_t>;
+  inline C10_DEVICE acc_t reduce(acc_t acc, scalar_t data, int64_t /*idx*/) const {
+    return combine(acc, {data, data});
+  }
+
+  inline C10_DEVICE acc_t combine(acc_t a, acc_t b) const {
+    auto min_val = (at::_isnan(a.first) || a.first < b.first) ? a.first : b.first;
+    auto max_val = (at::_isnan(a.second) || a.second > b.second) ? a.second : b.second;
+    return {min_val, max_val};
+  }
+
+  inline C10_DEVICE res_t project(acc_t acc) const {
+    return res_t((scalar_t) acc.first, (scalar_t) acc.second);
+  }
+
+  static C10_DEVICE acc_t translate_idx(acc_t acc, int64_t /*base_idx*/) {
+    return acc;
+  }
+
+#if defined(__CUDACC__) || defined(__HIPCC__)
+  inline C10_DEVICE acc_t warp_shfl_down(acc_t acc, int offset) const {
+    return {
+      WARP_SHFL_DOWN(acc.first, offset), WARP_SHFL_DOWN(acc.second, offset)
+    };
+  }
+#endif
+};
+
 }} // namespace at::native
 
 #undef MAX
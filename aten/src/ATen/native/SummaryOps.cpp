@@ -2,11 +2,15 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/native/SummaryOps.h>
 
 #include <tuple>
 
 namespace at { namespace native {
 
+DEFINE_DISPATCH(histc_add_stub);
+DEFINE_DISPATCH(histc_min_max_stub);
+
 ///////////////// bincount /////////////////
 namespace {
 
@@ -64,4 +68,46 @@ _bincount_cpu(const Tensor& self, const Tensor& weights, int64_t minlength) {
   });
 }
 
+///////////////// histogram observer helpers /////////////////
+
+// Accumulates the histogram of `values` over [min, max] into `self` in place,
+// with the same bin semantics as histc. Used by the quantization calibration
+// observers to update a running histogram without reallocating it.
+Tensor& _histc_add__cpu(
+    Tensor& self,
+    const Tensor& values,
+    Scalar min,
+    Scalar max) {
+  TORCH_CHECK(
+      self.dim() == 1 && self.is_contiguous(),
+      "_histc_add_: expected a contiguous 1-d histogram tensor");
+  TORCH_CHECK(
+      self.scalar_type() == values.scalar_type(),
+      "_histc_add_: histogram and values must have the same dtype, but got ",
+      self.scalar_type(), " and ", values.scalar_type());
+  if (values.numel() == 0) {
+    return self;
+  }
+  auto input = values.contiguous();
+  histc_add_stub(kCPU, self, input, min, max);
+  return self;
+}
+
+// Computes the min, max and histogram of `self` in a single fused pass.
+// Equivalent to (histc(self, bins, self.min(), self.max()), self.min(),
+// self.max()) but with one traversal for the range and one for the bins.
+std::tuple<Tensor, Tensor, Tensor> _histc_with_min_max_cpu(
+    const Tensor& self,
+    int64_t bins) {
+  TORCH_CHECK(bins > 0, "bins must be > 0");
+  TORCH_CHECK(
+      self.numel() > 0, "_histc_with_min_max: input tensor must be non-empty");
+  auto input = self.contiguous();
+  Tensor hist = native::zeros({bins}, input.options());
+  Tensor min = at::empty({}, input.options());
+  Tensor max = at::empty({}, input.options());
+  histc_min_max_stub(kCPU, hist, min, max, input, bins);
+  return std::make_tuple(hist, min, max);
+}
+
 }} // namespace at::native
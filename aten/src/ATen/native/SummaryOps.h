@@ -0,0 +1,15 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+using histc_add_fn = void (*)(Tensor&, const Tensor&, Scalar, Scalar);
+DECLARE_DISPATCH(histc_add_fn, histc_add_stub);
+
+using histc_min_max_fn =
+    void (*)(Tensor&, Tensor&, Tensor&, const Tensor&, int64_t);
+DECLARE_DISPATCH(histc_min_max_fn, histc_min_max_stub);
+
+}} // namespace at::native
@@ -14,6 +14,7 @@ namespace at { namespace native {
 DEFINE_DISPATCH(where_kernel);
 DEFINE_DISPATCH(max_kernel);
 DEFINE_DISPATCH(min_kernel);
+DEFINE_DISPATCH(filter_kernel);
 
 bool allclose(const Tensor& self, const Tensor& other, double rtol, double atol, bool equal_nan) {
   return at::isclose(self, other, rtol, atol, equal_nan).all().item<uint8_t>();
@@ -137,6 +138,17 @@ Tensor _s_where(const Tensor& condition, const Tensor& self, const Tensor& other
   return ret;
 }
 
+Tensor filter_cpu(const Tensor& self, Scalar threshold) {
+  TORCH_CHECK(
+      self.layout() == Layout::Strided,
+      "filter only supports strided tensors, got: ",
+      self.layout());
+  Tensor result = at::empty({0}, self.options());
+  auto self_c = self.contiguous();
+  filter_kernel(kCPU, result, self_c, threshold);
+  return result;
+}
+
 std::tuple<Tensor, Tensor> mode(const Tensor& self, int64_t dim, bool keepdim) {
   Tensor values = at::empty({0}, self.options());
   Tensor indices = at::empty({0}, self.options().dtype(kLong));
@@ -1,12 +1,111 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/core/grad_mode.h>
+#include <ATen/native/ConversionMemo.h>
 #include <c10/util/Optional.h>
 
 #include <c10/core/impl/DeviceGuardImplInterface.h>
 
+#include <atomic>
+#include <list>
+#include <mutex>
+
 namespace at {
 namespace native {
 
+namespace {
+
+// Note [Conversion memo cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Feature pipelines often call to(kFloat) or to(memory_format) on the same
+// unchanged tensors over and over, re-copying identical data each time. When
+// enabled, to() memoizes its result keyed on the source view (storage,
+// offset, sizes, strides) and the storage's write generation
+// (StorageImpl::generation), which is bumped whenever a tensor backed by the
+// storage is written in-place through the dispatcher. A hit returns the
+// previously converted tensor without touching the data; any intervening
+// write changes the generation and turns the lookup into a miss.
+//
+// Because a hit returns an *alias* of an earlier result, the cache is
+// strictly opt-in (set_conversion_memo_enabled) and callers must treat
+// converted tensors as read-only while it is on. Lookups are also bypassed
+// under GradMode (a shared result's autograd history would be rewritten on
+// every call) and when copy=True explicitly asks for a fresh tensor. The
+// cache holds strong references to at most kConversionMemoMaxEntries
+// source/result pairs, evicted in LRU order; holding the source guarantees
+// its StorageImpl cannot be freed and reallocated at the same address with a
+// colliding generation.
+struct ConversionMemoEntry {
+  Tensor src;
+  uint64_t generation;
+  caffe2::TypeMeta dst_dtype;
+  Device dst_device;
+  c10::optional<MemoryFormat> memory_format;
+  Tensor result;
+};
+
+constexpr size_t kConversionMemoMaxEntries = 64;
+std::atomic<bool> conversion_memo_enabled_{false};
+std::mutex conversion_memo_mutex;
+std::list<ConversionMemoEntry> conversion_memo_cache;
+
+bool same_source_view(const Tensor& a, const Tensor& b) {
+  return a.storage().unsafeGetStorageImpl() ==
+      b.storage().unsafeGetStorageImpl() &&
+      a.storage_offset() == b.storage_offset() &&
+      a.sizes().equals(b.sizes()) && a.strides().equals(b.strides()) &&
+      a.dtype() == b.dtype();
+}
+
+c10::optional<Tensor> conversion_memo_lookup(
+    const Tensor& self,
+    const TensorOptions& options,
+    c10::optional<MemoryFormat> memory_format) {
+  std::lock_guard<std::mutex> lock(conversion_memo_mutex);
+  for (auto it = conversion_memo_cache.begin();
+       it != conversion_memo_cache.end();
+       ++it) {
+    if (it->dst_dtype == options.dtype() &&
+        it->dst_device == options.device() &&
+        it->memory_format == memory_format && same_source_view(it->src, self) &&
+        it->generation == self.storage().unsafeGetStorageImpl()->generation()) {
+      conversion_memo_cache.splice(
+          conversion_memo_cache.begin(), conversion_memo_cache, it);
+      return conversion_memo_cache.front().result;
+    }
+  }
+  return c10::nullopt;
+}
+
+void conversion_memo_insert(
+    const Tensor& self,
+    uint64_t generation,
+    const TensorOptions& options,
+    c10::optional<MemoryFormat> memory_format,
+    const Tensor& result) {
+  std::lock_guard<std::mutex> lock(conversion_memo_mutex);
+  conversion_memo_cache.push_front(ConversionMemoEntry{
+      self, generation, options.dtype(), options.device(), memory_format,
+      result});
+  if (conversion_memo_cache.size() > kConversionMemoMaxEntries) {
+    conversion_memo_cache.pop_back();
+  }
+}
+
+} // namespace
+
+bool conversion_memo_enabled() {
+  return conversion_memo_enabled_.load(std::memory_order_relaxed);
+}
+
+void set_conversion_memo_enabled(bool enabled) {
+  conversion_memo_enabled_.store(enabled, std::memory_order_relaxed);
+  if (!enabled) {
+    std::lock_guard<std::mutex> lock(conversion_memo_mutex);
+    conversion_memo_cache.clear();
+  }
+}
+
 // Take a Device that may not have device_index set (i.e., having it as -1
 // representing the current device) and return the corresponding Device
 // according to the actual device at the time of this function call.  No-op
@@ -30,18 +129,37 @@ static inline Tensor to_impl(const Tensor& self, const TensorOptions& options, b
     return self;
   }
 
-  if (memory_format == MemoryFormat::Preserve) {
-    if (self.is_non_overlapping_and_dense()) {
-      // Copy all strides
-      auto r = at::empty_strided(self.sizes(), self.strides(), options);
-      r.copy_(self);
-      return r;
-    } else {
+  // See Note [Conversion memo cache]. The generation is snapshotted before
+  // the copy, so a write racing with the conversion makes the cached entry
+  // stale rather than hiding the new data.
+  const bool use_memo = conversion_memo_enabled() && !copy &&
+      !GradMode::is_enabled() && self.has_storage() &&
+      self.layout() == kStrided;
+  uint64_t generation = 0;
+  if (use_memo) {
+    generation = self.storage().unsafeGetStorageImpl()->generation();
+    auto cached = conversion_memo_lookup(self, options, optional_memory_format);
+    if (cached.has_value()) {
+      return std::move(*cached);
+    }
+  }
+
+  Tensor r;
+  if (memory_format == MemoryFormat::Preserve &&
+      self.is_non_overlapping_and_dense()) {
+    // Copy all strides
+    r = at::empty_strided(self.sizes(), self.strides(), options);
+    r.copy_(self);
+  } else {
+    if (memory_format == MemoryFormat::Preserve) {
       memory_format = self.suggest_memory_format();
     }
+    r = at::empty(self.sizes(), options, memory_format);
+    r.copy_(self, non_blocking);
+  }
+  if (use_memo) {
+    conversion_memo_insert(self, generation, options, optional_memory_format, r);
   }
-  auto r = at::empty(self.sizes(), options, memory_format);
-  r.copy_(self, non_blocking);
   return r;
 }
 
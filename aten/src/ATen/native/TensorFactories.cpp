@@ -17,6 +17,7 @@
 #include <ATen/native/TensorFactories.h>
 #include <c10/core/TensorOptions.h>
 #include <TH/THAllocator.h>
+#include <c10/core/MappedAllocator.h>
 #include <ATen/detail/CUDAHooksInterface.h>
 #include <c10/util/Exception.h>
 #include <ATen/NamedTensorUtils.h>
@@ -941,16 +942,34 @@ Tensor tensor_backend(ArrayRef<T> values, const TensorOptions& options) {
 AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, TENSOR)
 #undef TENSOR
 
-Tensor from_file(std::string filename, c10::optional<bool> shared, c10::optional<int64_t> size, const TensorOptions& options) {
+Tensor from_file(std::string filename, c10::optional<bool> shared, c10::optional<int64_t> size,
+                 c10::optional<bool> hugepages, c10::optional<bool> populate, const TensorOptions& options) {
     TORCH_CHECK(!options.pinned_memory(), "tensors constructed from a file cannot be pinned");
     size_t my_size = size.value_or(0);
-    int flags = shared.value_or(false) ? TH_ALLOCATOR_MAPPED_SHARED : 0;
     auto dtype = options.dtype();
+    at::DataPtr data_ptr;
+    if (hugepages.value_or(false) || populate.value_or(false)) {
+      // Large read-mostly tables want huge pages (and possibly prefaulting);
+      // that path lives in c10::MappedAllocator rather than THMapAllocator.
+      c10::MappedAllocatorOptions map_options;
+      map_options.shared = shared.value_or(false);
+      map_options.hugepages = hugepages.value_or(false);
+      map_options.populate = populate.value_or(false);
+      size_t actual_size = 0;
+      data_ptr = c10::MappedAllocator::makeDataPtr(
+          filename, my_size * dtype.itemsize(), map_options, &actual_size);
+      if (my_size == 0) {
+        my_size = actual_size / dtype.itemsize();
+      }
+    } else {
+      int flags = shared.value_or(false) ? TH_ALLOCATOR_MAPPED_SHARED : 0;
+      data_ptr = THMapAllocator::makeDataPtr(
+          filename.c_str(), flags, my_size * dtype.itemsize(), nullptr);
+    }
     auto storage_impl = c10::make_intrusive<at::StorageImpl>(
       dtype,
       my_size,
-      THMapAllocator::makeDataPtr(
-          filename.c_str(), flags, my_size * dtype.itemsize(), nullptr),
+      std::move(data_ptr),
       /*allocator=*/nullptr,
       /*resizable=*/false);
     auto tensor = detail::make_tensor<at::TensorImpl>(storage_impl, at::DispatchKey::CPUTensorId);
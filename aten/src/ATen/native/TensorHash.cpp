@@ -0,0 +1,127 @@
+// Stable content fingerprints for tensors, for use as cache keys.
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// 64-bit finalizer from splitmix64; good avalanche, cheap enough to run
+// once per element.
+inline uint64_t mix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+// Two independently keyed 64-bit lanes making up the 128-bit digest.
+// Not cryptographic; built for speed and stability.
+struct Digest {
+  uint64_t lo = 0x243f6a8885a308d3ull;
+  uint64_t hi = 0x13198a2e03707344ull;
+
+  void update(uint64_t word) {
+    const uint64_t mixed = mix64(word);
+    lo = (lo ^ mixed) * 0x100000001b3ull;
+    hi = (hi ^ ((mixed >> 32) | (mixed << 32))) * 0xc2b2ae3d27d4eb4full;
+  }
+};
+
+// Hash elements [start, end) of the flattened logical view, walking the
+// (possibly non-contiguous) memory through sizes/strides so no copy is
+// made. Elements are hashed by their raw byte pattern, so the digest
+// distinguishes NaN payloads and +0.0 from -0.0.
+template <typename scalar_t>
+Digest hash_chunk(
+    const scalar_t* data,
+    IntArrayRef sizes,
+    IntArrayRef strides,
+    int64_t start,
+    int64_t end) {
+  const int64_t ndim = sizes.size();
+  std::vector<int64_t> counter(ndim, 0);
+  int64_t offset = 0;
+  int64_t remaining = start;
+  for (int64_t dim = ndim - 1; dim >= 0; --dim) {
+    counter[dim] = remaining % sizes[dim];
+    remaining /= sizes[dim];
+    offset += counter[dim] * strides[dim];
+  }
+
+  Digest digest;
+  for (int64_t i = start; i < end; ++i) {
+    uint64_t word = 0;
+    const scalar_t value = data[offset];
+    std::memcpy(&word, &value, sizeof(scalar_t));
+    digest.update(word);
+    for (int64_t dim = ndim - 1; dim >= 0; --dim) {
+      if (++counter[dim] < sizes[dim]) {
+        offset += strides[dim];
+        break;
+      }
+      counter[dim] = 0;
+      offset -= strides[dim] * (sizes[dim] - 1);
+    }
+  }
+  return digest;
+}
+
+} // namespace
+
+// Returns a 128-bit digest of dtype, shape, and element bytes as a CPU
+// long tensor of shape [2]. The digest covers the logical elements in
+// row-major order, so two tensors with equal content hash alike no matter
+// how they are laid out in memory. Chunks are a fixed size and combined
+// in order, so the result does not depend on the number of threads and is
+// stable across processes of the same build.
+Tensor hash_tensor_cpu(const Tensor& self) {
+  constexpr int64_t kChunkSize = 1 << 16;
+
+  Digest digest;
+  digest.update(static_cast<uint64_t>(self.scalar_type()));
+  digest.update(static_cast<uint64_t>(self.dim()));
+  for (int64_t size : self.sizes()) {
+    digest.update(static_cast<uint64_t>(size));
+  }
+
+  const int64_t numel = self.numel();
+  if (numel > 0) {
+    const int64_t num_chunks = (numel + kChunkSize - 1) / kChunkSize;
+    std::vector<Digest> chunk_digests(num_chunks);
+    AT_DISPATCH_ALL_TYPES_AND3(
+        kHalf, kBool, kBFloat16, self.scalar_type(), "hash_tensor_cpu", [&] {
+          const scalar_t* data = self.data_ptr<scalar_t>();
+          at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+            for (int64_t chunk = begin; chunk < end; ++chunk) {
+              chunk_digests[chunk] = hash_chunk(
+                  data,
+                  self.sizes(),
+                  self.strides(),
+                  chunk * kChunkSize,
+                  std::min(numel, (chunk + 1) * kChunkSize));
+            }
+          });
+        });
+    for (const Digest& chunk_digest : chunk_digests) {
+      digest.update(chunk_digest.lo);
+      digest.update(chunk_digest.hi);
+    }
+  }
+
+  auto result = at::empty({2}, self.options().dtype(kLong));
+  auto* result_data = result.data_ptr<int64_t>();
+  result_data[0] = static_cast<int64_t>(digest.lo);
+  result_data[1] = static_cast<int64_t>(digest.hi);
+  return result;
+}
+
+} // namespace native
+} // namespace at
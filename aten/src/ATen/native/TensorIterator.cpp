@@ -1,6 +1,7 @@
 #include <ATen/native/TensorIterator.h>
 
 #include <array>
+#include <unordered_map>
 #include <ATen/ExpandUtils.h>
 #include <ATen/Parallel.h>
 #include <ATen/native/TypeProperties.h>
@@ -522,18 +523,18 @@ int TensorIterator::num_reduce_dims() const {
     }                                                                     \
   }
 
-void TensorIterator::for_each(loop_t loop) {
-  for_each(LOOP_WRAPPER(ntensors(), loop));
+void TensorIterator::for_each(loop_t loop, int64_t grain_size) {
+  for_each(LOOP_WRAPPER(ntensors(), loop), grain_size);
 }
 
-void TensorIterator::for_each(loop2d_t loop) {
+void TensorIterator::for_each(loop2d_t loop, int64_t grain_size) {
   int64_t numel = this->numel();
   if (numel == 0) {
     return;
-  } else if (numel < internal::GRAIN_SIZE || at::get_num_threads() == 1) {
+  } else if (numel < grain_size || at::get_num_threads() == 1) {
     return serial_for_each(loop, {0, numel});
   } else {
-    at::parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
       serial_for_each(loop, {begin, end});
     });
   }
@@ -1027,7 +1028,148 @@ FastSetupType TensorIterator::compute_fast_setup_type() {
   return FastSetupType::NONE;
 }
 
+// Note [TensorIterator plan cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Workloads that repeatedly execute the same elementwise op on
+// identically-shaped tensors (e.g. inference servers) pay for the full
+// shape/stride/dimension-reorder analysis in build() on every call, which
+// dominates wall time for small tensors. The analysis only depends on the
+// operands' devices, dtypes, sizes and strides plus a few configuration
+// flags, so its result can be memoized.
+//
+// The cache is thread-local to avoid locking on hot paths. An iterator is
+// only eligible for caching when the replayed portion of build() is free of
+// observable side effects: all operands defined and unnamed, a single common
+// dtype and device (so no cast copies are made), no reduction, no memory
+// overlap checking (which depends on data pointers, not on the key) and no
+// output resizing (checked after the miss build; a resize is a side effect
+// that a cache hit would not replay).
+
+namespace {
+
+struct IterationPlan {
+  DimVector shape;
+  SmallVector<TensorIterator::StrideVector, 4> stride_bytes;
+  ScalarType common_dtype;
+  bool has_coalesced_dimensions;
+  bool all_ops_same_shape;
+};
+
+struct PlanKeyHash {
+  size_t operator()(const TensorIterator::PlanKey& key) const {
+    // FNV-1a over the fingerprint words
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int64_t value : key) {
+      hash = (hash ^ static_cast<uint64_t>(value)) * 0x100000001b3ULL;
+    }
+    return static_cast<size_t>(hash);
+  }
+};
+
+struct PlanKeyEqual {
+  bool operator()(const TensorIterator::PlanKey& a, const TensorIterator::PlanKey& b) const {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+  }
+};
+
+using PlanCache = std::unordered_map<TensorIterator::PlanKey, IterationPlan, PlanKeyHash, PlanKeyEqual>;
+
+// Bound the cache so that highly dynamic workloads don't grow it without
+// limit; a full clear is cheap relative to the builds it saved.
+constexpr size_t kMaxCachedPlans = 256;
+
+PlanCache& plan_cache() {
+  static thread_local PlanCache cache;
+  return cache;
+}
+
+} // namespace
+
+bool TensorIterator::build_plan_key(PlanKey& key) const {
+  if (is_reduction_ || check_mem_overlap_) {
+    return false;
+  }
+  Device common_device = kCPU;
+  ScalarType common_dtype = ScalarType::Undefined;
+  bool first = true;
+  for (auto& op : operands_) {
+    if (!op.tensor.defined() || op.tensor.has_names()) {
+      return false;
+    }
+    if (first) {
+      common_device = op.tensor.device();
+      common_dtype = op.current_dtype;
+      first = false;
+    } else if (op.tensor.device() != common_device || op.current_dtype != common_dtype) {
+      return false;
+    }
+  }
+  key.push_back(static_cast<int64_t>(common_device.type()) << 16 | (common_device.index() & 0xffff));
+  key.push_back(static_cast<int64_t>(common_dtype));
+  key.push_back(static_cast<int64_t>(common_dtype_strategy_));
+  key.push_back(num_outputs_ | (static_cast<int64_t>(resize_outputs_) << 8));
+  for (auto& op : operands_) {
+    auto sizes = op.tensor.sizes();
+    auto strides = op.tensor.strides();
+    key.push_back(sizes.size());
+    key.append(sizes.begin(), sizes.end());
+    key.append(strides.begin(), strides.end());
+  }
+  return true;
+}
+
+bool TensorIterator::try_reuse_cached_plan(const PlanKey& key) {
+  auto& cache = plan_cache();
+  auto it = cache.find(key);
+  if (it == cache.end()) {
+    return false;
+  }
+  const auto& plan = it->second;
+  shape_ = plan.shape;
+  common_dtype_ = plan.common_dtype;
+  has_coalesced_dimensions_ = plan.has_coalesced_dimensions;
+  all_ops_same_shape_ = plan.all_ops_same_shape;
+  for (int i = 0; i < ntensors(); i++) {
+    operands_[i].stride_bytes = plan.stride_bytes[i];
+    operands_[i].is_output = i < num_outputs_;
+  }
+  return true;
+}
+
+void TensorIterator::cache_plan(const PlanKey& key) {
+  auto& cache = plan_cache();
+  if (cache.size() >= kMaxCachedPlans) {
+    cache.clear();
+  }
+  IterationPlan plan;
+  plan.shape = shape_;
+  plan.common_dtype = common_dtype_;
+  plan.has_coalesced_dimensions = has_coalesced_dimensions_;
+  plan.all_ops_same_shape = all_ops_same_shape_;
+  for (auto& op : operands_) {
+    plan.stride_bytes.push_back(op.stride_bytes);
+  }
+  cache.emplace(key, std::move(plan));
+}
+
 void TensorIterator::build() {
+  // try to reuse a memoized iteration plan for repeated identical shapes
+  // (see Note [TensorIterator plan cache])
+  PlanKey plan_key;
+  bool plan_cacheable = build_plan_key(plan_key);
+  if (plan_cacheable && try_reuse_cached_plan(plan_key)) {
+    for (auto& op : operands_) {
+      op.data = op.tensor.data_ptr();
+    }
+    view_offsets_ = DimVector(ndim(), 0);
+    return;
+  }
+  SmallVector<DimVector, 2> output_sizes;
+  if (plan_cacheable) {
+    for (int i = 0; i < num_outputs_; i++) {
+      output_sizes.emplace_back(operands_[i].tensor.sizes());
+    }
+  }
   // check input tensors memory format to use it during output allocation
   analyze_memory_format();
   // set is_output and is_read_write flags on appropriate tensors
@@ -1062,6 +1204,19 @@ void TensorIterator::build() {
 
   // zero out offsets
   view_offsets_ = DimVector(ndim(), 0);
+
+  if (plan_cacheable) {
+    // a resized output is a side effect that replaying the plan would skip
+    for (int i = 0; i < num_outputs_; i++) {
+      if (!operands_[i].tensor.sizes().equals(output_sizes[i])) {
+        plan_cacheable = false;
+        break;
+      }
+    }
+    if (plan_cacheable) {
+      cache_plan(plan_key);
+    }
+  }
 }
 
 SplitUntil32Bit TensorIterator::with_32bit_indexing() const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ATen/ATen.h>
+#include <ATen/Parallel.h>
 #include <c10/util/FunctionRef.h>
 #include <c10/util/SmallVector.h>
 #include <c10/util/TypeCast.h>
@@ -263,8 +264,14 @@ struct CAFFE2_API TensorIterator {
     return c10::fetch_and_cast<T>(op.tensor.scalar_type(), op.data);
   }
 
-  void for_each(loop_t loop);
-  void for_each(loop2d_t loop);
+  /// `grain_size` is the minimum number of elements each parallel chunk
+  /// should process, and also the threshold below which the loop stays
+  /// serial. Kernels with expensive per-element work should pass a smaller
+  /// value than the at::internal::GRAIN_SIZE default and very cheap ones
+  /// (e.g. fill) a larger one, to balance scheduling overhead against
+  /// undersubscription.
+  void for_each(loop_t loop, int64_t grain_size = at::internal::GRAIN_SIZE);
+  void for_each(loop2d_t loop, int64_t grain_size = at::internal::GRAIN_SIZE);
 
   void parallel_reduce(loop2d_t loop);
 
@@ -358,6 +365,21 @@ struct CAFFE2_API TensorIterator {
 
   void build();
 
+  /// Key identifying a cached iteration plan. See
+  /// Note [TensorIterator plan cache] in TensorIterator.cpp.
+  using PlanKey = SmallVector<int64_t, 32>;
+
+protected:
+  /// Computes a fingerprint of the operands (device, dtype, sizes, strides)
+  /// and configuration flags. Returns false if this iterator is not eligible
+  /// for plan caching (e.g. mixed dtypes, undefined operands, reductions).
+  bool build_plan_key(PlanKey& key) const;
+  /// Restores a previously computed iteration plan for `key`, skipping shape,
+  /// stride and dimension-order computation. Returns false on cache miss.
+  bool try_reuse_cached_plan(const PlanKey& key);
+  /// Records the iteration plan computed by build() under `key`.
+  void cache_plan(const PlanKey& key);
+
 protected:
   void mark_outputs();
   void check_mem_overlaps();
@@ -34,9 +34,26 @@ static void two_pass_reduction(TensorIterator& iter, loop2d_t loop) {
   int max_threads = at::get_num_threads();
 
   auto dst = iter.output(0);
+
+  // Pad each thread's partial slice out to whole cache lines: for the
+  // common single-element output the partials would otherwise be adjacent
+  // in one line and every accumulating store in the first pass would
+  // false-share across threads.
+  const int64_t line_elems = std::max<int64_t>(
+      1, at::internal::CACHE_LINE_SIZE / dst.element_size());
+  const int64_t padded_numel = divup(dst.numel(), line_elems) * line_elems;
+
   auto buffer_shape = DimVector(dst.sizes());
   buffer_shape.insert(buffer_shape.begin(), max_threads);
-  auto buffer = at::empty(buffer_shape, dst.options());
+  auto buffer_strides = DimVector(dst.sizes());
+  int64_t acc = 1;
+  for (int64_t dim = dst.dim() - 1; dim >= 0; dim--) {
+    buffer_strides[dim] = acc;
+    acc *= dst.sizes()[dim];
+  }
+  buffer_strides.insert(buffer_strides.begin(), padded_numel);
+  auto buffer = at::empty({max_threads * padded_numel}, dst.options())
+                    .as_strided(buffer_shape, buffer_strides);
 
   std::unique_ptr<bool[]> written(new bool[max_threads]);
   std::fill(written.get(), written.get() + max_threads, false);
@@ -15,11 +15,15 @@
 #include <ATen/NamedTensorUtils.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/Copy.h>
+#include <ATen/native/Cat.h>
+#include <ATen/Parallel.h>
 #include <ATen/MemoryOverlap.h>
 
 namespace at {
 namespace native {
 
+DEFINE_DISPATCH(cat_contig_stub);
+
 Tensor _reshape_from_tensor(const Tensor& self, const Tensor& shape_tensor) {
   TORCH_CHECK(shape_tensor.dim() == 1);
   std::vector<int64_t> shape;
@@ -135,6 +139,45 @@ Tensor & _cat_out_cpu(Tensor& result, TensorList tensors, int64_t dim) {
   result_size[dim] = cat_dim_size;
   result.resize_(result_size);
 
+  // When every input and the result are contiguous and share a dtype,
+  // concatenation is a batch of memcpys; a single dispatch hands the whole
+  // input list to the kernel, which parallelizes across inputs.  This wins
+  // when catting many small tensors, where per-input TensorIterator setup
+  // dominates; a few large inputs keep the iterator paths below, which
+  // parallelize within each copy.
+  constexpr int64_t kMinCatInputsForFusedCopy = 8;
+  if (result.numel() > 0 && result.is_contiguous() &&
+      (tensors.size() >= kMinCatInputsForFusedCopy ||
+       result.numel() <= at::internal::GRAIN_SIZE)) {
+    bool use_fused_copy = true;
+    bool any_skipped = false;
+    for (auto const &tensor : tensors) {
+      if (should_skip(tensor)) {
+        any_skipped = true;
+        continue;
+      }
+      if (!tensor.is_contiguous() || tensor.scalar_type() != result.scalar_type()) {
+        use_fused_copy = false;
+        break;
+      }
+    }
+    if (use_fused_copy) {
+      if (any_skipped) {
+        std::vector<Tensor> inputs;
+        inputs.reserve(tensors.size());
+        for (auto const &tensor : tensors) {
+          if (!should_skip(tensor)) {
+            inputs.push_back(tensor);
+          }
+        }
+        cat_contig_stub(kCPU, result, inputs, dim);
+      } else {
+        cat_contig_stub(kCPU, result, tensors, dim);
+      }
+      return result;
+    }
+  }
+
   int64_t offset = 0;
   if (reuse_iterator && result.is_contiguous()) {
     auto source_slice = notSkippedTensor;
@@ -186,6 +229,30 @@ Tensor _cat_cpu(TensorList tensors, int64_t dim) {
   return _cat_out_cpu(result, tensors, dim);
 }
 
+Tensor & _cat_presized__cpu(Tensor& result, TensorList tensors, int64_t dim) {
+  // Trusted variant of _cat_out_cpu: the caller guarantees that `result` is
+  // already sized for the concatenation and that the inputs have matching
+  // shapes with no legacy size-[0] placeholders, so the per-input shape,
+  // overlap and skip scans (and the resize) are elided.  Falls back to the
+  // checked path when the layout does not admit the fused copy.
+  TORCH_CHECK(tensors.size() > 0, "expected a non-empty list of Tensors");
+  dim = maybe_wrap_dim(dim, result.dim());
+  bool use_fused_copy = result.numel() > 0 && result.is_contiguous();
+  if (use_fused_copy) {
+    for (auto const &tensor : tensors) {
+      if (!tensor.is_contiguous() || tensor.scalar_type() != result.scalar_type()) {
+        use_fused_copy = false;
+        break;
+      }
+    }
+  }
+  if (use_fused_copy) {
+    cat_contig_stub(kCPU, result, tensors, dim);
+    return result;
+  }
+  return _cat_out_cpu(result, tensors, dim);
+}
+
 static void check_cat_no_zero_dim(TensorList tensors) {
   for(size_t i = 0; i < tensors.size(); ++i) {
     auto& t = tensors[i];
@@ -474,9 +541,9 @@ Tensor expand(const Tensor& self, IntArrayRef size, bool implicit) {
            "must be greater or equal to the number of dimensions in the tensor (",
            self.dim(), ")");
 
-  std::vector<int64_t> expandedSizes;
-  std::vector<int64_t> expandedStrides;
-  std::tie(expandedSizes, expandedStrides) = inferExpandGeometry(self.sizes(), self.strides(), size);
+  DimVector expandedSizes;
+  DimVector expandedStrides;
+  std::tie(expandedSizes, expandedStrides) = inferExpandGeometry_dimvector(self.sizes(), self.strides(), size);
 
   auto result = self.as_strided(expandedSizes, expandedStrides);
   namedinference::propagate_names_for_expand(result, self);
@@ -656,14 +723,14 @@ Tensor reshape(const Tensor& self, IntArrayRef proposed_shape) {
   if (self.is_sparse()) {
     AT_ERROR("reshape is not implemented for sparse tensors");
   }
-  auto shape = infer_size(proposed_shape, self.numel());
+  auto shape = infer_size_dimvector(proposed_shape, self.numel());
 
   if (self.is_mkldnn()) {
     return at::_mkldnn_reshape(self, shape);
   }
 
   auto stride =
-      at::detail::computeStride(self.sizes(), self.strides(), shape);
+      at::detail::computeStride_dimvector(self.sizes(), self.strides(), shape);
     // `computeStride` returns the proper strides to use if this
     // `reshape` can be just a view.
     //
@@ -1320,15 +1387,14 @@ Tensor numpy_T(const Tensor &self) {
 }
 
 Tensor view(const Tensor& self, IntArrayRef size) {
-  auto inferred_size = at::infer_size(size, self.numel());
-  auto stride = at::detail::computeStride(self.sizes(),
-                                          self.strides(),
-                                          inferred_size);
+  auto inferred_size = at::infer_size_dimvector(size, self.numel());
+  auto stride = at::detail::computeStride_dimvector(self.sizes(),
+                                                    self.strides(),
+                                                    inferred_size);
   TORCH_CHECK(stride.has_value(), "view size is "
     "not compatible with input tensor's size and stride (at least one dimension"
     " spans across two contiguous subspaces). Use .reshape(...) instead.");
-  auto stride_value = *stride;
-  return alias_with_sizes_and_strides(self, inferred_size, stride_value);
+  return alias_with_sizes_and_strides(self, inferred_size, *stride);
 }
 
 Tensor alias(const Tensor& self) {
@@ -3,12 +3,52 @@
 
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/UpSample.h>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 namespace at {
 namespace native {
 namespace {
 
+// Interpolation weights are accumulated in float (double for double
+// inputs); recomputing source coordinates in the inner loops was both
+// slower and, for half inputs, less accurate than tabulating them once.
+template <typename scalar_t>
+using interp_weight_t =
+    typename std::conditional<std::is_same<scalar_t, double>::value, double, float>::type;
+
+// Precompute the source indices and interpolation weights for one axis.
+// Every output row (or column) uses the same tables, so this hoists all
+// coordinate math out of the per-pixel loops.
+template <typename weight_t>
+static void upsample_bilinear2d_axis_table(
+    int64_t input_size,
+    int64_t output_size,
+    weight_t scale,
+    bool align_corners,
+    std::vector<int64_t>& index0,
+    std::vector<int64_t>& index1,
+    std::vector<weight_t>& lambda0,
+    std::vector<weight_t>& lambda1) {
+  index0.resize(output_size);
+  index1.resize(output_size);
+  lambda0.resize(output_size);
+  lambda1.resize(output_size);
+  for (int64_t i = 0; i < output_size; ++i) {
+    const weight_t real_index = area_pixel_compute_source_index<weight_t>(
+        scale, i, align_corners, /*cubic=*/false);
+    const int64_t idx = real_index;
+    index0[i] = idx;
+    index1[i] = idx + ((idx < input_size - 1) ? 1 : 0);
+    lambda1[i] = real_index - idx;
+    lambda0[i] = static_cast<weight_t>(1.) - lambda1[i];
+  }
+}
+
 template <typename scalar_t>
 static void upsample_bilinear2d_out_frame(
     scalar_t* odata,
@@ -26,61 +66,128 @@ static void upsample_bilinear2d_out_frame(
 
   // special case: just copy
   if (input_height == output_height && input_width == output_width) {
-    for (int64_t h2 = 0; h2 < output_height; ++h2) {
-      const int64_t h1 = h2;
-
-      for (int64_t w2 = 0; w2 < output_width; ++w2) {
-        const int64_t w1 = w2;
-        const scalar_t* pos1 = &idata[h1 * input_width + w1];
-        scalar_t* pos2 = &odata[h2 * output_width + w2];
-
-        for (int64_t c = 0; c < channels; ++c) {
-          pos2[0] = pos1[0];
-          pos1 += input_width * input_height;
-          pos2 += output_width * output_height;
-        }
-      }
-    }
+    std::memcpy(
+        odata, idata, channels * input_height * input_width * sizeof(scalar_t));
     return;
   }
-  const scalar_t rheight = area_pixel_compute_scale<scalar_t>(
-      input_height, output_height, align_corners, scales_h);
-
-  const scalar_t rwidth = area_pixel_compute_scale<scalar_t>(
-       input_width, output_width, align_corners, scales_w);
-
-  for (int64_t h2 = 0; h2 < output_height; ++h2) {
-    const scalar_t h1r = area_pixel_compute_source_index<scalar_t>(
-        rheight, h2, align_corners, /*cubic=*/false);
-
-    const int64_t h1 = h1r;
-    const int64_t h1p = (h1 < input_height - 1) ? 1 : 0;
 
-    const scalar_t h1lambda = h1r - h1;
-    const scalar_t h0lambda = static_cast<scalar_t>(1.) - h1lambda;
+  using weight_t = interp_weight_t<scalar_t>;
+  const weight_t rheight = area_pixel_compute_scale<weight_t>(
+      input_height, output_height, align_corners, scales_h);
+  const weight_t rwidth = area_pixel_compute_scale<weight_t>(
+      input_width, output_width, align_corners, scales_w);
 
-    for (int64_t w2 = 0; w2 < output_width; ++w2) {
-      const scalar_t w1r = area_pixel_compute_source_index<scalar_t>(
-          rwidth, w2, align_corners, /*cubic=*/false);
+  std::vector<int64_t> h0_index, h1_index, w0_index, w1_index;
+  std::vector<weight_t> h0_lambda, h1_lambda, w0_lambda, w1_lambda;
+  upsample_bilinear2d_axis_table(
+      input_height, output_height, rheight, align_corners,
+      h0_index, h1_index, h0_lambda, h1_lambda);
+  upsample_bilinear2d_axis_table(
+      input_width, output_width, rwidth, align_corners,
+      w0_index, w1_index, w0_lambda, w1_lambda);
+
+  // One iteration per (plane, output row): writes are contiguous and the
+  // two source rows stay hot across the width loop.
+  const int64_t grain =
+      std::max(int64_t(1), at::internal::GRAIN_SIZE / output_width);
+  at::parallel_for(
+      0, channels * output_height, grain, [&](int64_t begin, int64_t end) {
+        for (int64_t idx = begin; idx < end; ++idx) {
+          const int64_t c = idx / output_height;
+          const int64_t h2 = idx % output_height;
+          const scalar_t* i_plane = idata + c * input_height * input_width;
+          const scalar_t* row0 = i_plane + h0_index[h2] * input_width;
+          const scalar_t* row1 = i_plane + h1_index[h2] * input_width;
+          const weight_t h0lambda = h0_lambda[h2];
+          const weight_t h1lambda = h1_lambda[h2];
+          scalar_t* dst =
+              odata + c * output_height * output_width + h2 * output_width;
+
+          for (int64_t w2 = 0; w2 < output_width; ++w2) {
+            dst[w2] = static_cast<scalar_t>(
+                h0lambda *
+                    (w0_lambda[w2] * row0[w0_index[w2]] +
+                     w1_lambda[w2] * row0[w1_index[w2]]) +
+                h1lambda *
+                    (w0_lambda[w2] * row1[w0_index[w2]] +
+                     w1_lambda[w2] * row1[w1_index[w2]]));
+          }
+        }
+      });
+}
 
-      const int64_t w1 = w1r;
-      const int64_t w1p = (w1 < input_width - 1) ? 1 : 0;
+// Channels-last variant: each output pixel blends four contiguous
+// channel runs, so the inner loop vectorizes over channels.
+template <typename scalar_t>
+static void upsample_bilinear2d_out_frame_channels_last(
+    scalar_t* odata,
+    const scalar_t* idata,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t output_height,
+    int64_t output_width,
+    int64_t nbatch,
+    int64_t channels,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  // special case: just copy
+  if (input_height == output_height && input_width == output_width) {
+    std::memcpy(
+        odata,
+        idata,
+        nbatch * channels * input_height * input_width * sizeof(scalar_t));
+    return;
+  }
 
-      const scalar_t w1lambda = w1r - w1;
-      const scalar_t w0lambda = static_cast<scalar_t>(1.) - w1lambda;
-      const scalar_t* pos1 = &idata[h1 * input_width + w1];
-      scalar_t* pos2 = &odata[h2 * output_width + w2];
+  using weight_t = interp_weight_t<scalar_t>;
+  const weight_t rheight = area_pixel_compute_scale<weight_t>(
+      input_height, output_height, align_corners, scales_h);
+  const weight_t rwidth = area_pixel_compute_scale<weight_t>(
+      input_width, output_width, align_corners, scales_w);
 
-      for (int64_t c = 0; c < channels; ++c) {
-        pos2[0] = h0lambda * (w0lambda * pos1[0] + w1lambda * pos1[w1p]) +
-            h1lambda *
-                (w0lambda * pos1[h1p * input_width] +
-                 w1lambda * pos1[h1p * input_width + w1p]);
-        pos1 += input_width * input_height;
-        pos2 += output_width * output_height;
-      }
-    }
-  }
+  std::vector<int64_t> h0_index, h1_index, w0_index, w1_index;
+  std::vector<weight_t> h0_lambda, h1_lambda, w0_lambda, w1_lambda;
+  upsample_bilinear2d_axis_table(
+      input_height, output_height, rheight, align_corners,
+      h0_index, h1_index, h0_lambda, h1_lambda);
+  upsample_bilinear2d_axis_table(
+      input_width, output_width, rwidth, align_corners,
+      w0_index, w1_index, w0_lambda, w1_lambda);
+
+  const int64_t grain =
+      std::max(int64_t(1), at::internal::GRAIN_SIZE / (output_width * channels));
+  at::parallel_for(
+      0, nbatch * output_height, grain, [&](int64_t begin, int64_t end) {
+        for (int64_t idx = begin; idx < end; ++idx) {
+          const int64_t n = idx / output_height;
+          const int64_t h2 = idx % output_height;
+          const scalar_t* in_batch =
+              idata + n * input_height * input_width * channels;
+          const scalar_t* row0 = in_batch + h0_index[h2] * input_width * channels;
+          const scalar_t* row1 = in_batch + h1_index[h2] * input_width * channels;
+          scalar_t* out_row = odata +
+              (n * output_height + h2) * output_width * channels;
+
+          for (int64_t w2 = 0; w2 < output_width; ++w2) {
+            const scalar_t* pos00 = row0 + w0_index[w2] * channels;
+            const scalar_t* pos01 = row0 + w1_index[w2] * channels;
+            const scalar_t* pos10 = row1 + w0_index[w2] * channels;
+            const scalar_t* pos11 = row1 + w1_index[w2] * channels;
+            const weight_t w00 = h0_lambda[h2] * w0_lambda[w2];
+            const weight_t w01 = h0_lambda[h2] * w1_lambda[w2];
+            const weight_t w10 = h1_lambda[h2] * w0_lambda[w2];
+            const weight_t w11 = h1_lambda[h2] * w1_lambda[w2];
+            scalar_t* dst = out_row + w2 * channels;
+
+            for (int64_t c = 0; c < channels; ++c) {
+              dst[c] = static_cast<scalar_t>(
+                  w00 * pos00[c] + w01 * pos01[c] +
+                  w10 * pos10[c] + w11 * pos11[c]);
+            }
+          }
+        }
+      });
 }
 
 template <typename scalar_t>
@@ -188,10 +295,36 @@ static void upsample_bilinear2d_out_cpu_template(
       output_height,
       output_width);
 
+  if (input_.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    // Keep the channels-last layout so NHWC convolutions on either side
+    // don't pay a transpose.
+    output.resize_({nbatch, channels, output_height, output_width},
+                   at::MemoryFormat::ChannelsLast);
+
+    AT_ASSERT(
+        input_height > 0 && input_width > 0 && output_height > 0 &&
+        output_width > 0);
+
+    AT_DISPATCH_FLOATING_TYPES_AND_HALF(input_.scalar_type(), "upsample_bilinear2d", [&] {
+      upsample_bilinear2d_out_frame_channels_last<scalar_t>(
+          output.data_ptr<scalar_t>(),
+          input_.data_ptr<scalar_t>(),
+          input_height,
+          input_width,
+          output_height,
+          output_width,
+          nbatch,
+          channels,
+          align_corners,
+          scales_h,
+          scales_w);
+    });
+    return;
+  }
+
   auto input = input_.contiguous();
 
   output.resize_({nbatch, channels, output_height, output_width});
-  output.zero_();
 
   AT_ASSERT(
       input_height > 0 && input_width > 0 && output_height > 0 &&
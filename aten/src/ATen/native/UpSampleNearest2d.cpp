@@ -2,6 +2,8 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/UpSample.h>
 
+#include <cstring>
+
 namespace at {
 namespace native {
 namespace {
@@ -63,6 +65,43 @@ static void upsample_nearest2d_out_frame(
   }
 }
 
+// Channels-last variant: every output pixel is a contiguous run of
+// `channels` values copied from its nearest source pixel.
+template <typename scalar_t>
+static void upsample_nearest2d_out_frame_channels_last(
+    scalar_t* odata,
+    const scalar_t* idata,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t output_height,
+    int64_t output_width,
+    int64_t nbatch,
+    int64_t channels,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  const float height_scale = compute_scales_value<float>(scales_h, input_height, output_height);
+  const float width_scale = compute_scales_value<float>(scales_w, input_width, output_width);
+
+  for (int64_t n = 0; n < nbatch; ++n) {
+    const scalar_t* in_batch = idata + n * input_height * input_width * channels;
+    scalar_t* out_batch = odata + n * output_height * output_width * channels;
+
+    for (int64_t h2 = 0; h2 < output_height; ++h2) {
+      const int64_t h1 =
+          nearest_neighbor_compute_source_index(height_scale, h2, input_height);
+
+      for (int64_t w2 = 0; w2 < output_width; ++w2) {
+        const int64_t w1 =
+            nearest_neighbor_compute_source_index(width_scale, w2, input_width);
+
+        const scalar_t* pos1 = &in_batch[(h1 * input_width + w1) * channels];
+        scalar_t* pos2 = &out_batch[(h2 * output_width + w2) * channels];
+        std::memcpy(pos2, pos1, channels * sizeof(scalar_t));
+      }
+    }
+  }
+}
+
 template <typename scalar_t>
 static void upsample_nearest2d_backward_out_frame(
     scalar_t* odata,
@@ -149,6 +188,30 @@ static void upsample_nearest2d_out_cpu_template(
       output_height,
       output_width);
 
+  if (input_.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    // Keep the channels-last layout so NHWC convolutions on either side
+    // don't pay a transpose.
+    output.resize_({nbatch, channels, output_height, output_width},
+                   at::MemoryFormat::ChannelsLast);
+
+    AT_ASSERT(input_width > 0 && output_width > 0);
+
+    AT_DISPATCH_FLOATING_TYPES_AND_HALF(input_.scalar_type(), "upsample_nearest2d", [&] {
+      upsample_nearest2d_out_frame_channels_last<scalar_t>(
+          output.data_ptr<scalar_t>(),
+          input_.data_ptr<scalar_t>(),
+          input_height,
+          input_width,
+          output_height,
+          output_width,
+          nbatch,
+          channels,
+          scales_h,
+          scales_w);
+    });
+    return;
+  }
+
   auto input = input_.contiguous();
 
   output.resize_({nbatch, channels, output_height, output_width});
@@ -0,0 +1,122 @@
+#include <ATen/native/Workspace.h>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+constexpr size_t kWorkspaceAlignment = 64;
+
+size_t round_up(size_t nbytes) {
+  return (nbytes + kWorkspaceAlignment - 1) & ~(kWorkspaceAlignment - 1);
+}
+
+struct Chunk {
+  at::DataPtr data;
+  size_t size = 0;
+  size_t used = 0;
+};
+
+struct ThreadWorkspace {
+  std::vector<Chunk> chunks;
+  size_t used = 0; // total bytes live across all chunks
+  size_t depth = 0; // nesting depth of live Workspace handles
+  size_t high_water = 0;
+  int64_t requests = 0;
+
+  size_t capacity() const {
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+      total += chunk.size;
+    }
+    return total;
+  }
+
+  void* get(size_t nbytes) {
+    nbytes = round_up(std::max(nbytes, size_t(1)));
+    ++requests;
+    if (chunks.empty() || chunks.back().size - chunks.back().used < nbytes) {
+      // Grow to at least the high-water mark so that after one warm-up pass
+      // a single chunk covers the whole workspace.
+      Chunk chunk;
+      chunk.size = std::max(nbytes, std::max(high_water, capacity()));
+      chunk.data = c10::GetCPUAllocator()->allocate(chunk.size);
+      chunks.push_back(std::move(chunk));
+    }
+    Chunk& chunk = chunks.back();
+    void* ptr = static_cast<char*>(chunk.data.get()) + chunk.used;
+    chunk.used += nbytes;
+    used += nbytes;
+    high_water = std::max(high_water, used);
+    return ptr;
+  }
+
+  void reset() {
+    // A request that overflowed the current chunk left the workspace spread
+    // over several blocks; consolidate into one high-water-mark sized block
+    // so the next Workspace bump-allocates out of a single chunk.
+    if (chunks.size() > 1 ||
+        (chunks.size() == 1 && chunks[0].size < high_water)) {
+      chunks.clear();
+      Chunk chunk;
+      chunk.size = high_water;
+      chunk.data = c10::GetCPUAllocator()->allocate(chunk.size);
+      chunks.push_back(std::move(chunk));
+    }
+    for (auto& chunk : chunks) {
+      chunk.used = 0;
+    }
+    used = 0;
+  }
+};
+
+ThreadWorkspace& threadWorkspace() {
+  static thread_local ThreadWorkspace workspace;
+  return workspace;
+}
+
+} // namespace
+
+Workspace::Workspace() {
+  ++threadWorkspace().depth;
+}
+
+Workspace::~Workspace() {
+  auto& workspace = threadWorkspace();
+  if (--workspace.depth == 0) {
+    workspace.reset();
+  }
+}
+
+void* Workspace::get(size_t nbytes) {
+  return threadWorkspace().get(nbytes);
+}
+
+WorkspaceStats workspace_stats() {
+  const auto& workspace = threadWorkspace();
+  WorkspaceStats stats;
+  stats.capacity = static_cast<int64_t>(workspace.capacity());
+  stats.high_water_mark = static_cast<int64_t>(workspace.high_water);
+  stats.requests = workspace.requests;
+  return stats;
+}
+
+void release_workspace() {
+  auto& workspace = threadWorkspace();
+  TORCH_CHECK(
+      workspace.depth == 0,
+      "release_workspace() called while a Workspace is in use");
+  workspace.chunks.clear();
+  workspace.used = 0;
+  workspace.high_water = 0;
+}
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <c10/core/Allocator.h>
+#include <c10/macros/Export.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace at {
+namespace native {
+
+// Summary of the calling thread's workspace arena.
+struct WorkspaceStats {
+  // bytes currently held by the arena
+  int64_t capacity = 0;
+  // largest number of bytes live at once
+  int64_t high_water_mark = 0;
+  // total number of get() calls
+  int64_t requests = 0;
+};
+
+// RAII handle onto the calling thread's scratch arena.
+//
+// Operators that need transient scratch memory (LAPACK work arrays, im2col
+// buffers, ...) would otherwise allocate and free a large buffer on every
+// invocation, thrashing the allocator when the op runs in a loop. The arena
+// is grow-only: requests bump-allocate out of a block that is sized to the
+// thread's high-water mark, so steady-state invocations perform no
+// allocations at all.
+//
+// Pointers returned by get() remain valid until the outermost Workspace on
+// the thread is destroyed; the memory is then recycled (not freed) for the
+// next Workspace. Contents are not preserved between Workspaces.
+//
+//   Workspace workspace;
+//   scalar_t* work = workspace.get<scalar_t>(lwork);
+class CAFFE2_API Workspace {
+ public:
+  Workspace();
+  ~Workspace();
+  Workspace(const Workspace&) = delete;
+  Workspace& operator=(const Workspace&) = delete;
+
+  // Returns a 64-byte-aligned uninitialized buffer of at least `nbytes`.
+  void* get(size_t nbytes);
+
+  template <typename T>
+  T* get(int64_t numel) {
+    return static_cast<T*>(get(numel * sizeof(T)));
+  }
+};
+
+// Returns the statistics of the calling thread's arena.
+CAFFE2_API WorkspaceStats workspace_stats();
+
+// Frees the memory held by the calling thread's arena. May only be called
+// while no Workspace is live on the thread.
+CAFFE2_API void release_workspace();
+
+} // namespace native
+} // namespace at
@@ -280,6 +280,47 @@ void GeluKernelImpl(TensorIterator& it) {
   }
 }
 
+void AddmmActivationKernelImpl(
+    TensorIterator& it,
+    Scalar alpha,
+    Scalar beta,
+    bool use_gelu) {
+  AT_DISPATCH_FLOATING_TYPES(it.dtype(), "AddmmActivationKernelImpl", [&]() {
+    using Vec = vec256::Vec256<scalar_t>;
+    const scalar_t alpha_val = alpha.to<scalar_t>();
+    const scalar_t beta_val = beta.to<scalar_t>();
+    const Vec alpha_vec(alpha_val);
+    const Vec beta_vec(beta_val);
+    if (use_gelu) {
+      const Vec kAlphaVec(M_SQRT1_2);
+      const Vec kOneVec(1);
+      const Vec kPointFiveVec(0.5);
+      cpu_kernel_vec(
+          it,
+          [=](scalar_t a, scalar_t b) {
+            constexpr scalar_t kAlpha = M_SQRT1_2;
+            const scalar_t x = alpha_val * a + beta_val * b;
+            return x * scalar_t(0.5) * (scalar_t(1) + std::erf(x * kAlpha));
+          },
+          [&](Vec a, Vec b) {
+            const Vec x = alpha_vec * a + beta_vec * b;
+            return x * kPointFiveVec * (kOneVec + (x * kAlphaVec).erf());
+          });
+    } else {
+      const Vec zero_vec(0);
+      cpu_kernel_vec(
+          it,
+          [=](scalar_t a, scalar_t b) {
+            const scalar_t x = alpha_val * a + beta_val * b;
+            return x > scalar_t(0) ? x : scalar_t(0);
+          },
+          [&](Vec a, Vec b) {
+            return vec256::maximum(alpha_vec * a + beta_vec * b, zero_vec);
+          });
+    }
+  });
+}
+
 void GeluBackwardKernelImpl(TensorIterator& it) {
   if (hasMKL() && it.is_contiguous()) {
     AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluBackwardKernelImpl", [&]() {
@@ -457,6 +498,7 @@ REGISTER_DISPATCH(elu_stub, &elu_kernel);
 REGISTER_DISPATCH(elu_backward_stub, &elu_backward_kernel);
 REGISTER_DISPATCH(GeluKernel, &GeluKernelImpl);
 REGISTER_DISPATCH(GeluBackwardKernel, &GeluBackwardKernelImpl);
+REGISTER_DISPATCH(addmm_activation_stub, &AddmmActivationKernelImpl);
 REGISTER_DISPATCH(hardtanh_backward_stub, &hardtanh_backward_kernel);
 REGISTER_DISPATCH(hardshrink_stub, &hardshrink_kernel);
 REGISTER_DISPATCH(softshrink_stub, &softshrink_kernel);
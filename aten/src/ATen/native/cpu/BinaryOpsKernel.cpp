@@ -81,7 +81,22 @@ void div_kernel(TensorIterator& iter) {
             return a / b;
           });
       });
-    } else {
+    } else if (iter.is_cpu_scalar(2)) {
+    // When the divisor is a scalar, multiply by its reciprocal instead:
+    // division throughput is several times worse than multiplication. The
+    // product can differ from the division in the last bit.
+    AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, iter.dtype(), "div_cpu", [&]() {
+      auto inv_b = scalar_t(1.0) / iter.scalar_value<scalar_t>(2);
+      iter.remove_operand(2);
+      cpu_kernel_vec(iter,
+        [=](scalar_t a) -> scalar_t {
+           return a * inv_b;
+        },
+        [=](Vec256<scalar_t> a) {
+          return a * Vec256<scalar_t>(inv_b);
+        });
+    });
+  } else {
     AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, iter.dtype(), "div_cpu", [&]() {
       cpu_kernel_vec(iter,
         [=](scalar_t a, scalar_t b) __ubsan_ignore_float_divide_by_zero__ -> scalar_t {
@@ -0,0 +1,64 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+
+#include <ATen/native/Cat.h>
+
+#include <cstring>
+#include <vector>
+
+namespace at { namespace native {
+namespace {
+
+void cat_contig_kernel(Tensor& result, TensorList tensors, int64_t dim) {
+  // With every input and the result contiguous and sharing a dtype,
+  // concatenation is a batch of memcpys: a "row" is the contiguous slice
+  // covering the cat dimension and everything after it, and each input
+  // contributes one row segment per outer index.  When dim == 0 there is a
+  // single outer index, so each input is one memcpy.
+  if (result.numel() == 0) {
+    return;
+  }
+  int64_t outer = 1;
+  for (int64_t i = 0; i < dim; i++) {
+    outer *= result.size(i);
+  }
+  int64_t inner = 1;
+  for (int64_t i = dim + 1; i < result.dim(); i++) {
+    inner *= result.size(i);
+  }
+  const int64_t elem_bytes = result.element_size();
+  const int64_t result_row_bytes = result.size(dim) * inner * elem_bytes;
+
+  // Byte offset of each input's segment within a result row.
+  std::vector<int64_t> segment_offsets(tensors.size());
+  int64_t offset_bytes = 0;
+  for (size_t i = 0; i < tensors.size(); i++) {
+    segment_offsets[i] = offset_bytes;
+    offset_bytes += tensors[i].size(dim) * inner * elem_bytes;
+  }
+
+  char* result_data = static_cast<char*>(result.data_ptr());
+  at::parallel_for(0, tensors.size(), 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      auto const &tensor = tensors[i];
+      const int64_t segment_bytes = tensor.size(dim) * inner * elem_bytes;
+      if (segment_bytes == 0) {
+        continue;
+      }
+      auto source_data = static_cast<const char*>(tensor.data_ptr());
+      char* dest_data = result_data + segment_offsets[i];
+      for (int64_t o = 0; o < outer; o++) {
+        std::memcpy(
+            dest_data + o * result_row_bytes,
+            source_data + o * segment_bytes,
+            segment_bytes);
+      }
+    }
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(cat_contig_stub, &cat_contig_kernel);
+
+}} // namespace at::native
@@ -1,6 +1,9 @@
 #include <ATen/ATen.h>
 
+#include <algorithm>
+
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/Copy.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
@@ -10,9 +13,88 @@ namespace at {
 namespace native {
 namespace {
 
+// Note [Blocked copy for transposed layouts]
+// TensorIterator's loops walk the innermost dimension of the *output*, so
+// when the source is the transpose of a contiguous tensor every consecutive
+// source access lands a full row stride apart: each source cache line is
+// loaded, yields one element, and is evicted long before its neighbors are
+// needed. Instead of walking the full output row, the blocked path copies
+// 64-element blocks of the output's inner dimension at a time. Within a
+// block, successive iterations of the outer dimension revisit the same 64
+// source cache lines while they are still resident, so each line is used to
+// completion before eviction. The working set per block is a few KB,
+// comfortably inside L1.
+constexpr int64_t kTransposedCopyBlockSize = 64;
+
+template <typename T>
+void transposed_copy_kernel_impl(TensorIterator& iter) {
+  constexpr int64_t kBlock = kTransposedCopyBlockSize;
+  const int64_t n0 = iter.shape()[0];
+  const int64_t n1 = iter.shape()[1];
+  char* dst_data = static_cast<char*>(iter.data_ptr(0));
+  const char* src_data = static_cast<const char*>(iter.data_ptr(1));
+  const int64_t dst_stride1 = iter.strides(0)[1];
+  const int64_t src_stride0 = iter.strides(1)[0];
+  const int64_t grain = std::max(
+      internal::GRAIN_SIZE / std::max(n0, static_cast<int64_t>(1)),
+      static_cast<int64_t>(1));
+  at::parallel_for(0, n1, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t i0 = 0; i0 < n0; i0 += kBlock) {
+      const int64_t i1 = std::min(i0 + kBlock, n0);
+      for (int64_t j = begin; j < end; ++j) {
+        // dst is contiguous along dim 0, src along dim 1, so these stores
+        // are sequential and the strided loads reuse the block's lines.
+        T* dst = reinterpret_cast<T*>(dst_data + j * dst_stride1) + i0;
+        const char* src = src_data + j * sizeof(T) + i0 * src_stride0;
+        for (int64_t i = i0; i < i1; ++i, src += src_stride0) {
+          *dst++ = *reinterpret_cast<const T*>(src);
+        }
+      }
+    }
+  });
+}
+
+// True for same-dtype 2D iterators whose output is contiguous along dim 0
+// and whose input is contiguous along dim 1 only, i.e. a permuted layout
+// that the 1D loops would traverse with a large per-element stride.
+bool is_transposed_copy(TensorIterator& iter) {
+  if (iter.ntensors() != 2 || iter.ndim() != 2 ||
+      iter.dtype(0) != iter.dtype(1)) {
+    return false;
+  }
+  const int64_t es = iter.element_size(0);
+  return iter.strides(0)[0] == es && iter.strides(1)[0] != es &&
+      iter.strides(1)[1] == es;
+}
+
+static void transposed_copy_kernel(TensorIterator& iter) {
+  switch (iter.element_size(0)) {
+    case 1:
+      return transposed_copy_kernel_impl<uint8_t>(iter);
+    case 2:
+      return transposed_copy_kernel_impl<uint16_t>(iter);
+    case 4:
+      return transposed_copy_kernel_impl<uint32_t>(iter);
+    case 8:
+      return transposed_copy_kernel_impl<uint64_t>(iter);
+    default:
+      TORCH_INTERNAL_ASSERT(false, "unexpected element size in copy");
+  }
+}
+
+bool has_blocked_copy_element_size(TensorIterator& iter) {
+  const int64_t es = iter.element_size(0);
+  return es == 1 || es == 2 || es == 4 || es == 8;
+}
+
 static void copy_kernel(TensorIterator& iter, bool non_blocking) {
   ScalarType dtype = iter.dtype(0);
-  if (dtype == iter.dtype(1)) {
+  if (dtype == iter.dtype(1) && is_transposed_copy(iter) &&
+      has_blocked_copy_element_size(iter)) {
+    // See Note [Blocked copy for transposed layouts]. A plain copy moves
+    // bits, so dispatching on element size covers every dtype at once.
+    transposed_copy_kernel(iter);
+  } else if (dtype == iter.dtype(1)) {
     if (dtype == ScalarType::Half) {
       cpu_kernel(iter, [=](at::Half a) -> at::Half { return a; });
     } else if (dtype == ScalarType::BFloat16) {
@@ -0,0 +1,117 @@
+#include <ATen/native/cpu/CrossEntropyKernel.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <cmath>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Fused log_softmax + NLL loss forward. Instead of materializing the full
+// [batch, classes] log-probability matrix and then gathering one column per
+// row, each row is streamed twice through the cache: one vectorized pass
+// for the max and one for sum(exp(x - max)). The loss for row i is then
+//   weight[t] * (max_i + log(sumexp_i) - x[i][t]),  t = target[i]
+// which touches each input element at most twice and writes only one
+// scalar per row.
+template <typename scalar_t>
+void cross_entropy_fused_kernel_frame(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  using Vec = vec256::Vec256<scalar_t>;
+
+  const int64_t batch_size = input.size(0);
+  const int64_t n_classes = input.size(1);
+
+  auto input_contiguous = input.contiguous();
+  auto target_contiguous = target.contiguous();
+  auto weight_contiguous = weight.defined() ? weight.contiguous() : weight;
+
+  const scalar_t* input_data = input_contiguous.data_ptr<scalar_t>();
+  const int64_t* target_data = target_contiguous.data_ptr<int64_t>();
+  const scalar_t* weight_data =
+      weight_contiguous.defined() ? weight_contiguous.data_ptr<scalar_t>() : nullptr;
+
+  // per-row losses and weights; reduced below if requested
+  Tensor losses = at::empty({batch_size}, input.options());
+  Tensor weights = at::empty({batch_size}, input.options());
+  scalar_t* losses_data = losses.data_ptr<scalar_t>();
+  scalar_t* weights_data = weights.data_ptr<scalar_t>();
+
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      const int64_t cur_target = target_data[i];
+      if (cur_target == ignore_index) {
+        losses_data[i] = 0;
+        weights_data[i] = 0;
+        continue;
+      }
+      TORCH_CHECK_INDEX(
+          cur_target >= 0 && cur_target < n_classes,
+          "Target ", cur_target, " is out of bounds.");
+
+      scalar_t* row = const_cast<scalar_t*>(input_data) + i * n_classes;
+      scalar_t max = vec256::reduce_all<scalar_t>(
+          [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+          row,
+          n_classes);
+      scalar_t sumexp = vec256::map_reduce_all<scalar_t>(
+          [max](Vec x) { return (x - Vec(max)).exp(); },
+          [](Vec x, Vec y) { return x + y; },
+          row,
+          n_classes);
+
+      scalar_t cur_weight = weight_data != nullptr
+          ? weight_data[cur_target]
+          : static_cast<scalar_t>(1);
+      losses_data[i] =
+          cur_weight * (max + std::log(sumexp) - row[cur_target]);
+      weights_data[i] = cur_weight;
+    }
+  });
+
+  if (reduction == Reduction::None) {
+    output.resize_({batch_size});
+    output.copy_(losses);
+    return;
+  }
+
+  output.resize_({});
+  if (reduction == Reduction::Mean) {
+    auto total_weight = weights.sum();
+    output.fill_(losses.sum() / total_weight);
+  } else {
+    output.fill_(losses.sum());
+  }
+}
+
+static void cross_entropy_fused_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  AT_DISPATCH_FLOATING_TYPES(
+      input.scalar_type(), "cross_entropy_fused", [&] {
+        cross_entropy_fused_kernel_frame<scalar_t>(
+            output, input, target, weight, reduction, ignore_index);
+      });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(cross_entropy_fused_kernel, &cross_entropy_fused_kernel_impl);
+
+} // namespace native
+} // namespace at
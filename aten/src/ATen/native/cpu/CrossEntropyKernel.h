@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+using cross_entropy_fn = void(*)(
+    Tensor& /* output */,
+    const Tensor& /* input */,
+    const Tensor& /* target */,
+    const Tensor& /* weight */,
+    int64_t /* reduction */,
+    int64_t /* ignore_index */);
+
+DECLARE_DISPATCH(cross_entropy_fn, cross_entropy_fused_kernel);
+
+}
+}
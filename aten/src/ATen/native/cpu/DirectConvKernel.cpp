@@ -0,0 +1,151 @@
+#include <ATen/native/cpu/DirectConvKernel.h>
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at {
+namespace native {
+namespace {
+
+inline std::vector<int64_t> calculate_conv_output_size(
+    const IntArrayRef input_size,
+    const IntArrayRef weight_size,
+    const IntArrayRef stride,
+    const IntArrayRef padding) {
+  const auto calc_output_dimension = [](
+    const int64_t input, const int64_t kernel, const int64_t stride, const int64_t padding) {
+    return 1 + (input - kernel + 2 * padding) / stride;
+  };
+
+  return std::vector<int64_t> {
+    input_size[0],
+    weight_size[0],
+    calc_output_dimension(input_size[2], weight_size[2], stride[0], padding[0]),
+    calc_output_dimension(input_size[3], weight_size[3], stride[1], padding[1]),
+  };
+}
+
+// Computes one (batch, output channel) plane directly, without unfolding the
+// input. The inner loop accumulates a whole row of output in registers
+// (Vec256 blocks) per kernel tap; the caller guarantees stride 1 along the
+// width so input rows can be loaded contiguously.
+void direct_conv2d_plane(
+    float* out_plane,
+    const float* in_batch,
+    const float* w_oc,
+    const float bias_val,
+    const int64_t in_ch,
+    const int64_t in_h,
+    const int64_t in_w,
+    const int64_t out_h,
+    const int64_t out_w,
+    const int64_t k_h,
+    const int64_t k_w,
+    const int64_t stride_h,
+    const int64_t pad_h,
+    const int64_t pad_w) {
+  using Vec = vec256::Vec256<float>;
+  for (int64_t oh = 0; oh < out_h; ++oh) {
+    float* out_row = out_plane + oh * out_w;
+
+    const Vec bias_vec(bias_val);
+    int64_t ow = 0;
+    for (; ow + Vec::size() <= out_w; ow += Vec::size()) {
+      bias_vec.store(out_row + ow);
+    }
+    for (; ow < out_w; ++ow) {
+      out_row[ow] = bias_val;
+    }
+
+    const int64_t ih0 = oh * stride_h - pad_h;
+    for (int64_t ic = 0; ic < in_ch; ++ic) {
+      const float* in_c = in_batch + ic * in_h * in_w;
+      const float* w_ic = w_oc + ic * k_h * k_w;
+      for (int64_t kh = 0; kh < k_h; ++kh) {
+        const int64_t ih = ih0 + kh;
+        if (ih < 0 || ih >= in_h) {
+          continue;
+        }
+        const float* in_row = in_c + ih * in_w;
+        for (int64_t kw = 0; kw < k_w; ++kw) {
+          // Restrict the output columns to those whose input column
+          // (ow + kw - pad_w) is in bounds; everything outside is padding.
+          const int64_t ow_begin = std::max<int64_t>(0, pad_w - kw);
+          const int64_t ow_end = std::min(out_w, in_w + pad_w - kw);
+          if (ow_begin >= ow_end) {
+            continue;
+          }
+          const float* in_col = in_row + ow_begin + kw - pad_w;
+          float* out_col = out_row + ow_begin;
+          const int64_t len = ow_end - ow_begin;
+          const Vec w_vec(w_ic[kh * k_w + kw]);
+          int64_t d = 0;
+          for (; d + Vec::size() <= len; d += Vec::size()) {
+            auto acc = Vec::loadu(out_col + d) + w_vec * Vec::loadu(in_col + d);
+            acc.store(out_col + d);
+          }
+          for (; d < len; ++d) {
+            out_col[d] += w_ic[kh * k_w + kw] * in_col[d];
+          }
+        }
+      }
+    }
+  }
+}
+
+Tensor _convolution_direct2d(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias,
+    const IntArrayRef stride,
+    const IntArrayRef padding) {
+  auto output = at::empty(
+      calculate_conv_output_size(input.sizes(), weight.sizes(), stride, padding),
+      input.options());
+
+  const int64_t batch = input.size(0);
+  const int64_t in_ch = input.size(1);
+  const int64_t in_h = input.size(2);
+  const int64_t in_w = input.size(3);
+  const int64_t out_ch = weight.size(0);
+  const int64_t k_h = weight.size(2);
+  const int64_t k_w = weight.size(3);
+  const int64_t out_h = output.size(2);
+  const int64_t out_w = output.size(3);
+
+  const float* input_p = input.data_ptr<float>();
+  const float* weight_p = weight.data_ptr<float>();
+  const float* bias_p = bias.defined() ? bias.data_ptr<float>() : nullptr;
+  float* output_p = output.data_ptr<float>();
+
+  at::parallel_for(0, batch * out_ch, 0, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t n = i / out_ch;
+      const int64_t oc = i % out_ch;
+      direct_conv2d_plane(
+          output_p + i * out_h * out_w,
+          input_p + n * in_ch * in_h * in_w,
+          weight_p + oc * in_ch * k_h * k_w,
+          bias_p ? bias_p[oc] : 0.f,
+          in_ch,
+          in_h,
+          in_w,
+          out_h,
+          out_w,
+          k_h,
+          k_w,
+          stride[0],
+          padding[0],
+          padding[1]);
+    }
+  });
+
+  return output;
+}
+
+}  // namespace
+
+REGISTER_DISPATCH(convolution_direct2d_stub, &_convolution_direct2d);
+
+}  // namespace native
+}  // namespace at
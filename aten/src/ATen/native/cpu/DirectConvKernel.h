@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+/*
+  Direct 2d convolution operator for small spatial sizes, where
+  im2col+gemm spends most of its time materializing the unfolded matrix.
+*/
+
+namespace at {
+namespace native {
+
+using convolution_direct2d_fn =
+    Tensor (*)(const Tensor &, const Tensor &, const Tensor &, IntArrayRef, IntArrayRef);
+
+DECLARE_DISPATCH(convolution_direct2d_fn, convolution_direct2d_stub);
+
+}  // namespace native
+}  // namespace at
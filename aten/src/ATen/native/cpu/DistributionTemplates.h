@@ -1,9 +1,16 @@
 #pragma once
 
+#include <ATen/CPUGenerator.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Utils.h>
+#include <ATen/Parallel.h>
 #include <ATen/core/DistributionsHelper.h>
+#include <ATen/core/PhiloxRNGEngine.h>
+#include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
+#include <cstdlib>
+#include <cstring>
 #include <mutex>
 
 namespace at { namespace native { namespace templates {
@@ -19,4 +26,126 @@ void cauchy_kernel(TensorIterator& iter, double median, double sigma, RNG* gener
   });
 }
 
+// Note [Batched Philox CPU fills]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The default CPU path draws one value at a time from CPUGenerator's MT19937,
+// under the generator mutex, which serializes large fills (dropout masks,
+// weight init). The helpers below instead run the counter-based Philox engine
+// (see Note [Philox Engine implementation]) over the output in chunks:
+//
+//  - one fresh 64-bit Philox seed is drawn from the generator per fill, so a
+//    fill consumes exactly one MT19937 sample and results are reproducible
+//    under torch.manual_seed regardless of the number of threads;
+//  - each chunk is an independent Philox subsequence, so chunks can be
+//    generated in parallel without sharing state;
+//  - within a chunk, four engines advance interleaved counters so four
+//    independent Philox dependency chains are in flight at once, and the
+//    Box-Muller transform for normal_ runs on Vec256 lanes.
+//
+// Since Philox produces a different stream than MT19937, this path is opt-in
+// via the ATEN_CPU_PHILOX_RNG environment variable; flipping it changes the
+// values produced for a given seed, but not their distribution.
+
+inline bool philox_rng_enabled() {
+  static const bool enabled = std::getenv("ATEN_CPU_PHILOX_RNG") != nullptr;
+  return enabled;
+}
+
+// chunk length in floats; a multiple of 16 so Box-Muller pairs and the
+// four-engine interleave below never straddle a chunk boundary
+constexpr int64_t PHILOX_FILL_CHUNK = 1024;
+
+// Fills data[0, n) with uniforms in [0, 1) from the given subsequence.
+// n must be a multiple of 16. Engine j owns counter blocks j, j+4, j+8, ...
+// (a block is the 4 outputs of one 128-bit counter), so the four engines
+// together produce the subsequence's stream in order while each advances
+// its own counter chain.
+inline void philox_uniform_fill_chunk(
+    float* data,
+    int64_t n,
+    uint64_t seed,
+    uint64_t subsequence) {
+  at::Philox4_32_10 engines[4] = {
+      at::Philox4_32_10(seed, subsequence, 0),
+      at::Philox4_32_10(seed, subsequence, 1),
+      at::Philox4_32_10(seed, subsequence, 2),
+      at::Philox4_32_10(seed, subsequence, 3)};
+  for (int64_t i = 0; i < n; i += 16) {
+    for (int j = 0; j < 4; ++j) {
+      for (int k = 0; k < 4; ++k) {
+        data[i + 4 * j + k] = (engines[j]() & FLOAT_MASK) * FLOAT_DIVISOR;
+      }
+    }
+    // each engine consumed one block; skip over the other three engines'
+    // blocks to its next one
+    for (int j = 0; j < 4; ++j) {
+      engines[j].incr_n(3);
+    }
+  }
+}
+
+// Box-Muller on 16 uniforms in-place, 8 lanes at a time (cf. the scalar
+// normal_fill_16 in UnaryOpsKernel.cpp)
+inline void philox_normal_transform_16(
+    float* data,
+    const vec256::Vec256<float>& mean,
+    const vec256::Vec256<float>& std) {
+  using Vec = vec256::Vec256<float>;
+  const Vec one(1.0f);
+  const Vec minus_two(-2.0f);
+  const Vec two_pi(2.0f * M_PI);
+  const Vec u1 = one - Vec::loadu(data); // [0, 1) -> (0, 1] for log
+  const Vec u2 = Vec::loadu(data + 8);
+  const Vec radius = (minus_two * u1.log()).sqrt();
+  const Vec theta = two_pi * u2;
+  (radius * theta.cos() * std + mean).store(data);
+  (radius * theta.sin() * std + mean).store(data + 8);
+}
+
+inline void philox_normal_fill(
+    Tensor& self,
+    const float mean,
+    const float std,
+    Generator* gen) {
+  float* data = self.data_ptr<float>();
+  const int64_t size = self.numel();
+  CPUGenerator* generator =
+      get_generator_or_default<CPUGenerator>(gen, detail::getDefaultCPUGenerator());
+  uint64_t seed;
+  {
+    // the generator is only touched to derive the per-fill seed; generation
+    // itself runs outside the lock
+    std::lock_guard<std::mutex> lock(generator->mutex_);
+    seed = generator->random64();
+  }
+  const vec256::Vec256<float> mean_v(mean);
+  const vec256::Vec256<float> std_v(std);
+  const int64_t num_chunks = (size + PHILOX_FILL_CHUNK - 1) / PHILOX_FILL_CHUNK;
+  const int64_t grain =
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / PHILOX_FILL_CHUNK);
+  at::parallel_for(0, num_chunks, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; ++chunk) {
+      const int64_t chunk_begin = chunk * PHILOX_FILL_CHUNK;
+      const int64_t n = std::min(PHILOX_FILL_CHUNK, size - chunk_begin);
+      if (n == PHILOX_FILL_CHUNK) {
+        float* out = data + chunk_begin;
+        philox_uniform_fill_chunk(out, n, seed, chunk);
+        for (int64_t i = 0; i < n; i += 16) {
+          philox_normal_transform_16(out + i, mean_v, std_v);
+        }
+      } else {
+        // tail chunk: generate into a buffer rounded up to a multiple of 16
+        // and copy out only what is needed
+        float buf[PHILOX_FILL_CHUNK];
+        const int64_t rounded = (n + 15) / 16 * 16;
+        philox_uniform_fill_chunk(buf, rounded, seed, chunk);
+        for (int64_t i = 0; i < rounded; i += 16) {
+          philox_normal_transform_16(buf + i, mean_v, std_v);
+        }
+        std::memcpy(data + chunk_begin, buf, n * sizeof(float));
+      }
+    }
+  });
+}
+
 }}}
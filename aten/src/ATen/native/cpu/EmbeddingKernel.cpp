@@ -0,0 +1,93 @@
+#include <ATen/native/cpu/EmbeddingKernel.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+
+namespace at {
+namespace native {
+namespace {
+
+template <typename scalar_t>
+void segment_reduce_runs(
+    scalar_t* out,
+    const scalar_t* grad,
+    int64_t stride,
+    const int64_t* sorted_indices,
+    const int64_t* orig_positions,
+    const int64_t* run_starts,
+    int64_t n_runs,
+    bool packed,
+    int64_t padding_idx,
+    const int64_t* counts) {
+  using Vec = vec256::Vec256<scalar_t>;
+  // every run writes a distinct output row, so runs can be reduced in
+  // parallel without synchronization
+  int64_t grain_size =
+      std::max(internal::GRAIN_SIZE / std::max(stride, (int64_t)1), (int64_t)1);
+  at::parallel_for(0, n_runs, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++) {
+      int64_t k = sorted_indices[run_starts[r]];
+      if (k == padding_idx) {
+        continue;
+      }
+      scalar_t scale =
+          counts ? scalar_t(1.0) / counts[k] : static_cast<scalar_t>(1);
+      Vec scale_vec(scale);
+      scalar_t* out_row = out + (packed ? r : k) * stride;
+      for (int64_t j = run_starts[r]; j < run_starts[r + 1]; j++) {
+        const scalar_t* grad_row = grad + orig_positions[j] * stride;
+        int64_t d = 0;
+        for (; d + Vec::size() <= stride; d += Vec::size()) {
+          auto sum =
+              Vec::loadu(out_row + d) + Vec::loadu(grad_row + d) * scale_vec;
+          sum.store(out_row + d);
+        }
+        for (; d < stride; d++) {
+          out_row[d] += grad_row[d] * scale;
+        }
+      }
+    }
+  });
+}
+
+void embedding_sorted_backward_kernel_impl(
+    Tensor& output,
+    const Tensor& grad,
+    const Tensor& sorted_indices,
+    const Tensor& orig_positions,
+    const Tensor& run_starts,
+    bool packed,
+    int64_t padding_idx,
+    const int64_t* counts) {
+  int64_t n_runs = run_starts.numel() - 1;
+  if (n_runs <= 0) {
+    return;
+  }
+  AT_DISPATCH_FLOATING_TYPES(
+      grad.scalar_type(), "embedding_sorted_backward", [&] {
+        segment_reduce_runs<scalar_t>(
+            output.data_ptr<scalar_t>(),
+            grad.data_ptr<scalar_t>(),
+            grad.size(1),
+            sorted_indices.data_ptr<int64_t>(),
+            orig_positions.data_ptr<int64_t>(),
+            run_starts.data_ptr<int64_t>(),
+            n_runs,
+            packed,
+            padding_idx,
+            counts);
+      });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(
+    embedding_sorted_backward_stub,
+    &embedding_sorted_backward_kernel_impl);
+
+} // namespace native
+} // namespace at
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+// (output, grad, sorted_indices, orig_positions, run_starts, packed,
+// padding_idx, counts): reduces each contiguous run of equal sorted indices
+// into one output row. With packed == false run r accumulates into
+// output[sorted_indices[run_starts[r]]] (dense gradient); with packed == true
+// it accumulates into output[r] (coalesced sparse values). `counts` holds
+// per-index occurrence counts for scale_grad_by_freq, or nullptr.
+// See embedding_dense_backward_cpu.
+using embedding_sorted_backward_fn = void (*)(
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    bool,
+    int64_t,
+    const int64_t*);
+DECLARE_DISPATCH(embedding_sorted_backward_fn, embedding_sorted_backward_stub);
+
+} // namespace native
+} // namespace at
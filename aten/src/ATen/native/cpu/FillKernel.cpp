@@ -7,9 +7,93 @@
 
 #include <ATen/native/Fill.h>
 
+#if defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2) || \
+    defined(CPU_CAPABILITY_AVX512)
+#include <immintrin.h>
+#endif
+
 namespace at { namespace native {
 namespace {
 
+// Fills at or above this many bytes bypass the cache with non-temporal
+// stores. A buffer this large (a conservative stand-in for half a typical
+// L3) cannot stay resident anyway, and regular stores would evict the
+// caller's working set while filling it.
+constexpr int64_t kStreamingFillThreshold = 8 * 1024 * 1024;
+
+#if defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2) || \
+    defined(CPU_CAPABILITY_AVX512)
+#if defined(CPU_CAPABILITY_AVX512)
+using fill_block_t = __m512i;
+#else
+using fill_block_t = __m256i;
+#endif
+
+inline void fill_stream_store(fill_block_t* out, fill_block_t pattern) {
+#if defined(CPU_CAPABILITY_AVX512)
+  _mm512_stream_si512(out, pattern);
+#else
+  _mm256_stream_si256(out, pattern);
+#endif
+}
+
+template <typename scalar_t>
+void fill_stream(scalar_t* data, scalar_t value, int64_t numel) {
+  constexpr int64_t kBlockBytes = sizeof(fill_block_t);
+  constexpr int64_t kBlockElems = kBlockBytes / sizeof(scalar_t);
+  // Head: regular stores up to a block boundary (or the end).
+  int64_t i = 0;
+  while (i < numel &&
+         (reinterpret_cast<uintptr_t>(data + i) & (kBlockBytes - 1)) != 0) {
+    data[i++] = value;
+  }
+  alignas(kBlockBytes) scalar_t pattern_buf[kBlockElems];
+  for (int64_t j = 0; j < kBlockElems; ++j) {
+    pattern_buf[j] = value;
+  }
+  const fill_block_t pattern =
+      *reinterpret_cast<const fill_block_t*>(pattern_buf);
+  scalar_t* aligned = data + i;
+  const int64_t num_blocks = (numel - i) / kBlockElems;
+  at::parallel_for(
+      0,
+      num_blocks,
+      internal::GRAIN_SIZE / kBlockElems,
+      [aligned, pattern](int64_t begin, int64_t end) {
+        fill_block_t* out = reinterpret_cast<fill_block_t*>(aligned);
+        for (int64_t b = begin; b < end; ++b) {
+          fill_stream_store(out + b, pattern);
+        }
+        // Each thread orders its own streaming stores.
+        _mm_sfence();
+      });
+  // Tail: regular stores for the remainder.
+  for (i += num_blocks * kBlockElems; i < numel; ++i) {
+    data[i] = value;
+  }
+}
+#endif
+
+// Streams the fill past the cache for large contiguous outputs; returns
+// false when the regular vectorized path should run instead.
+template <typename scalar_t>
+bool fill_stream_if_large(TensorIterator& iter, scalar_t value) {
+#if defined(CPU_CAPABILITY_AVX) || defined(CPU_CAPABILITY_AVX2) || \
+    defined(CPU_CAPABILITY_AVX512)
+  if (!iter.is_contiguous() ||
+      iter.numel() * static_cast<int64_t>(sizeof(scalar_t)) <
+          kStreamingFillThreshold) {
+    return false;
+  }
+  fill_stream(
+      static_cast<scalar_t*>(iter.data_ptr(0)), value, iter.numel());
+  return true;
+#else
+  (void)iter;
+  (void)value;
+  return false;
+#endif
+}
 
 template <typename scalar_t>
 static void fill_non_native_type(TensorIterator& iter, Scalar value_scalar) {
@@ -17,10 +101,16 @@ static void fill_non_native_type(TensorIterator& iter, Scalar value_scalar) {
   using H = typename std::make_signed<decltype(value)>::type;  // Signed type has more acceleration
   // Reserve the representation of value. static_cast<H>(value) is implementation defined.
   H val = *reinterpret_cast<H*>(std::addressof(value));
+  if (fill_stream_if_large(iter, val)) {
+    return;
+  }
+  // Fill does almost no work per element; larger chunks keep the
+  // scheduling overhead below the cost of the stores themselves.
   cpu_kernel_vec(
       iter,
       [val]() -> H { return val; },
-      [val]() { return Vec256<H>(val); });
+      [val]() { return Vec256<H>(val); },
+      4 * internal::GRAIN_SIZE);
 }
 
 void fill_kernel(TensorIterator& iter, Scalar value_scalar) {
@@ -33,15 +123,20 @@ void fill_kernel(TensorIterator& iter, Scalar value_scalar) {
       scalar_t value = value_scalar.to<scalar_t>();
       cpu_kernel(
           iter,
-          [=]() -> scalar_t { return value; });
+          [=]() -> scalar_t { return value; },
+          4 * internal::GRAIN_SIZE);
     });
   } else {
     AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, iter.dtype(), "fill_cpu", [&]() {
       scalar_t value = value_scalar.to<scalar_t>();
+      if (fill_stream_if_large(iter, value)) {
+        return;
+      }
       cpu_kernel_vec(
           iter,
           [=]() -> scalar_t { return value; },
-          [=]() { return Vec256<scalar_t>(value); });
+          [=]() { return Vec256<scalar_t>(value); },
+          4 * internal::GRAIN_SIZE);
     });
   }
 }
@@ -0,0 +1,178 @@
+#include <ATen/native/FusedOptimizerOps.h>
+
+#include <cmath>
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+template <typename scalar_t>
+void fused_adam_kernel_impl(
+    scalar_t* param,
+    const scalar_t* grad,
+    scalar_t* exp_avg,
+    scalar_t* exp_avg_sq,
+    int64_t numel,
+    int64_t step,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const scalar_t bias_correction1 = 1 - std::pow(beta1, step);
+  const scalar_t bias_correction2 = 1 - std::pow(beta2, step);
+  const scalar_t step_size = lr / bias_correction1;
+  const scalar_t inv_bias_correction2 = 1 / bias_correction2;
+  const scalar_t wd = weight_decay;
+  at::parallel_for(
+      0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        const Vec beta1_vec(static_cast<scalar_t>(beta1));
+        const Vec beta2_vec(static_cast<scalar_t>(beta2));
+        const Vec one_minus_beta1(static_cast<scalar_t>(1 - beta1));
+        const Vec one_minus_beta2(static_cast<scalar_t>(1 - beta2));
+        const Vec wd_vec(wd);
+        const Vec inv_bias_correction2_vec(inv_bias_correction2);
+        const Vec step_size_vec(step_size);
+        const Vec eps_vec(static_cast<scalar_t>(eps));
+        int64_t d = begin;
+        for (; d + Vec::size() <= end; d += Vec::size()) {
+          Vec p = Vec::loadu(param + d);
+          Vec g = Vec::loadu(grad + d);
+          if (wd != 0) {
+            g = g + wd_vec * p;
+          }
+          Vec m = Vec::loadu(exp_avg + d) * beta1_vec + one_minus_beta1 * g;
+          Vec v =
+              Vec::loadu(exp_avg_sq + d) * beta2_vec + one_minus_beta2 * g * g;
+          Vec denom = (v * inv_bias_correction2_vec).sqrt() + eps_vec;
+          p = p - step_size_vec * m / denom;
+          m.store(exp_avg + d);
+          v.store(exp_avg_sq + d);
+          p.store(param + d);
+        }
+        for (; d < end; d++) {
+          scalar_t g = grad[d];
+          if (wd != 0) {
+            g += wd * param[d];
+          }
+          scalar_t m = exp_avg[d] * beta1 + (1 - beta1) * g;
+          scalar_t v = exp_avg_sq[d] * beta2 + (1 - beta2) * g * g;
+          scalar_t denom = std::sqrt(v * inv_bias_correction2) + eps;
+          exp_avg[d] = m;
+          exp_avg_sq[d] = v;
+          param[d] -= step_size * m / denom;
+        }
+      });
+}
+
+void fused_adam_kernel(
+    Tensor& param,
+    const Tensor& grad,
+    Tensor& exp_avg,
+    Tensor& exp_avg_sq,
+    int64_t step,
+    double lr,
+    double beta1,
+    double beta2,
+    double weight_decay,
+    double eps) {
+  AT_DISPATCH_FLOATING_TYPES(param.scalar_type(), "_fused_adam_step_", [&] {
+    fused_adam_kernel_impl<scalar_t>(
+        param.data_ptr<scalar_t>(),
+        grad.data_ptr<scalar_t>(),
+        exp_avg.data_ptr<scalar_t>(),
+        exp_avg_sq.data_ptr<scalar_t>(),
+        param.numel(),
+        step,
+        lr,
+        beta1,
+        beta2,
+        weight_decay,
+        eps);
+  });
+}
+
+template <typename scalar_t>
+void fused_sgd_momentum_kernel_impl(
+    scalar_t* param,
+    const scalar_t* grad,
+    scalar_t* momentum_buffer,
+    int64_t numel,
+    double lr,
+    double momentum,
+    double dampening,
+    double weight_decay,
+    bool nesterov) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const scalar_t wd = weight_decay;
+  at::parallel_for(
+      0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        const Vec momentum_vec(static_cast<scalar_t>(momentum));
+        const Vec one_minus_dampening(static_cast<scalar_t>(1 - dampening));
+        const Vec wd_vec(wd);
+        const Vec lr_vec(static_cast<scalar_t>(lr));
+        int64_t d = begin;
+        for (; d + Vec::size() <= end; d += Vec::size()) {
+          Vec p = Vec::loadu(param + d);
+          Vec g = Vec::loadu(grad + d);
+          if (wd != 0) {
+            g = g + wd_vec * p;
+          }
+          Vec buf = Vec::loadu(momentum_buffer + d) * momentum_vec +
+              one_minus_dampening * g;
+          Vec update = nesterov ? g + momentum_vec * buf : buf;
+          p = p - lr_vec * update;
+          buf.store(momentum_buffer + d);
+          p.store(param + d);
+        }
+        for (; d < end; d++) {
+          scalar_t g = grad[d];
+          if (wd != 0) {
+            g += wd * param[d];
+          }
+          scalar_t buf =
+              momentum_buffer[d] * momentum + (1 - dampening) * g;
+          scalar_t update = nesterov ? g + momentum * buf : buf;
+          momentum_buffer[d] = buf;
+          param[d] -= lr * update;
+        }
+      });
+}
+
+void fused_sgd_momentum_kernel(
+    Tensor& param,
+    const Tensor& grad,
+    Tensor& momentum_buffer,
+    double lr,
+    double momentum,
+    double dampening,
+    double weight_decay,
+    bool nesterov) {
+  AT_DISPATCH_FLOATING_TYPES(
+      param.scalar_type(), "_fused_sgd_momentum_step_", [&] {
+        fused_sgd_momentum_kernel_impl<scalar_t>(
+            param.data_ptr<scalar_t>(),
+            grad.data_ptr<scalar_t>(),
+            momentum_buffer.data_ptr<scalar_t>(),
+            param.numel(),
+            lr,
+            momentum,
+            dampening,
+            weight_decay,
+            nesterov);
+      });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(fused_adam_stub, &fused_adam_kernel);
+REGISTER_DISPATCH(fused_sgd_momentum_stub, &fused_sgd_momentum_kernel);
+
+} // namespace native
+} // namespace at
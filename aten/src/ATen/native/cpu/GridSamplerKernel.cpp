@@ -764,12 +764,16 @@ struct ApplyGridSample<scalar_t, 2, GridSamplerInterpolation::Nearest,
 
 // ~~~~~~~~~~~~~~~~~~ grid_sample_2d_grid_slice_iterator ~~~~~~~~~~~~~~~~~~~~~~
 // Function to apply a vectorized function on a grid slice tensor (without batch
-// dimension).
+// dimension), restricted to the rows [h_begin, h_end). The restriction lets
+// callers tile work over (N, H) instead of N only, which matters for small
+// batches with large spatial extents (e.g. warping frames with a flow grid).
+// Spatial offsets passed to apply_fn are relative to the full slice.
 // See NOTE [ Grid Sample CPU Kernels ] for details.
 
 template<typename scalar_t, typename ApplyFn>
 static inline void grid_sample_2d_grid_slice_iterator(
-    const TensorAccessor<scalar_t, 3>& grid_slice, const ApplyFn &apply_fn) {
+    const TensorAccessor<scalar_t, 3>& grid_slice,
+    int64_t h_begin, int64_t h_end, const ApplyFn &apply_fn) {
   int64_t out_H = grid_slice.size(0);
   int64_t out_W = grid_slice.size(1);
   int64_t grid_sH = grid_slice.stride(0);
@@ -792,8 +796,10 @@ static inline void grid_sample_2d_grid_slice_iterator(
     // Strategy: Sequentially load two vectors at the same time, and get,
     //           e.g.,  {x0, y0, x1, y1}, {x2, y2, x3, y3}. Then we use
     //           at::vec256::deinterleave2 to get x and y vectors.
-    auto total_size = out_H * out_W;
-    for (int64_t spatial_offset = 0; spatial_offset < total_size; spatial_offset += step) {
+    // The row range is a contiguous sub-block, so iterate it flattened.
+    auto base_offset = h_begin * out_W;
+    auto total_size = base_offset + (h_end - h_begin) * out_W;
+    for (int64_t spatial_offset = base_offset; spatial_offset < total_size; spatial_offset += step) {
       auto grid_offset = spatial_offset * 2;
       auto len = std::min(step, total_size - spatial_offset);
       auto vec1 = Vec::loadu(grid_ptr + grid_offset,
@@ -838,12 +844,15 @@ static inline void grid_sample_2d_grid_slice_iterator(
     };
 
     if (at::geometry_is_contiguous({out_H, out_W}, {grid_sH, grid_sW})) {
-      // If [H, W] is contiguous, apply line_fn once.
-      line_fn(grid_ptr, grid_ptr + grid_sCoor, 0, out_H * out_W);
+      // If [H, W] is contiguous, apply line_fn once over the (also
+      // contiguous) row range.
+      line_fn(grid_ptr + h_begin * grid_sH,
+              grid_ptr + h_begin * grid_sH + grid_sCoor,
+              h_begin * out_W, (h_end - h_begin) * out_W);
     } else {
       // If only [W] is contiguous, apply line_fn once for each h slice.
-      auto grid_ptr_NH = grid_ptr;
-      for (int64_t h = 0; h < out_H; h++) {
+      auto grid_ptr_NH = grid_ptr + h_begin * grid_sH;
+      for (int64_t h = h_begin; h < h_end; h++) {
         line_fn(grid_ptr_NH, grid_ptr_NH + grid_sCoor, h * out_W, out_W);
         grid_ptr_NH += grid_sH;
       }
@@ -853,13 +862,13 @@ static inline void grid_sample_2d_grid_slice_iterator(
     // General case.
     // Strategy: Do a for-loop over H, for each W slice, use
     //           at::vec256::gather to load the x and y vectors.
-    auto spatial_offset = 0;
+    int64_t spatial_offset = h_begin * out_W;
     auto i_offsets_delta = iVec(grid_sW * step);
 
     #ifndef _MSC_VER
     # pragma unroll
     #endif
-    for (int64_t h = 0; h < out_H; h++) {
+    for (int64_t h = h_begin; h < h_end; h++) {
       auto grid_ptr_x = grid_ptr + h * grid_sH;
       auto grid_ptr_y = grid_ptr_x + grid_sCoor;
       auto i_offsets = iVec::arange(0, grid_sW);
@@ -883,6 +892,14 @@ static inline void grid_sample_2d_grid_slice_iterator(
   }
 }
 
+// Convenience overload iterating the whole slice.
+template<typename scalar_t, typename ApplyFn>
+static inline void grid_sample_2d_grid_slice_iterator(
+    const TensorAccessor<scalar_t, 3>& grid_slice, const ApplyFn &apply_fn) {
+  grid_sample_2d_grid_slice_iterator(
+      grid_slice, 0, grid_slice.size(0), apply_fn);
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ Grid Sample Kernels ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // Use the structs & functions defined above to calculate grid sample forward
 // and backward.
@@ -895,25 +912,31 @@ Tensor grid_sampler_2d_cpu_kernel_impl(const Tensor& input, const Tensor& grid,
   auto H = grid.size(1);
   auto W = grid.size(2);
   auto output = at::empty({N, input.size(1), H, W}, input.options());
-  auto spatial_size = H * W;
-  auto grain_size = spatial_size == 0 ? (N + 1)
-                                      : at::divup(at::internal::GRAIN_SIZE, spatial_size * 4 /* 2d * 2 tensors*/);
+  // Tile over (N, H) rather than N so that small batches with large spatial
+  // extents still parallelize; output rows are disjoint, so row ranges can
+  // be processed independently.
+  auto grain_size = W == 0 ? (N * H + 1)
+                           : at::divup(at::internal::GRAIN_SIZE, W * 4 /* 2d * 2 tensors*/);
 
 #define HANDLE_CASE(interp, padding, align_corners)                            \
   case padding: {                                                              \
     ApplyGridSample<scalar_t, 2, interp, padding, align_corners>               \
     grid_sample(inp_acc);                                                      \
-    parallel_for(0, N, grain_size, [&](int64_t begin, int64_t end) {           \
-      for (int64_t n = begin; n < end; n++) {                                  \
+    parallel_for(0, N * H, grain_size, [&](int64_t begin, int64_t end) {       \
+      for (int64_t idx = begin; idx < end;) {                                  \
+        int64_t n = idx / H;                                                   \
+        int64_t h_begin = idx - n * H;                                         \
+        int64_t h_end = std::min(H, h_begin + (end - idx));                    \
         auto out_slice = out_acc[n];                                           \
         auto inp_slice = inp_acc[n];                                           \
         grid_sample_2d_grid_slice_iterator(                                    \
-          grid_acc[n],                                                         \
+          grid_acc[n], h_begin, h_end,                                         \
           [&](const Vec256<scalar_t>& grid_x, const Vec256<scalar_t>& grid_y,  \
               int64_t spatial_offset, int64_t len) {                           \
             grid_sample.forward(out_slice, inp_slice, spatial_offset,          \
                                 grid_x, grid_y, len);                          \
           });                                                                  \
+        idx += h_end - h_begin;                                                \
         }                                                                      \
       });                                                                      \
     return;                                                                    \
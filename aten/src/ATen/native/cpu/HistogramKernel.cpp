@@ -0,0 +1,171 @@
+#include <ATen/native/SummaryOps.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace at { namespace native {
+namespace {
+
+using namespace vec256;
+
+// Histogram kernels backing the quantization calibration observers.
+//
+// Binning is a scatter and does not vectorize, but it parallelizes well with
+// per-thread privatized bins that are merged at the end. The min/max pass is
+// vectorized with Vec256. Bin semantics match TH histc: values in
+// [min, max] are counted, the top edge lands in the last bin, and everything
+// outside the range is ignored.
+
+template <typename scalar_t>
+void histc_add_serial(
+    scalar_t* hist_data,
+    int64_t nbins,
+    const scalar_t* data,
+    int64_t numel,
+    scalar_t minval,
+    scalar_t maxval) {
+  const scalar_t range = maxval - minval;
+  for (int64_t i = 0; i < numel; i++) {
+    scalar_t value = data[i];
+    if (value >= minval && value <= maxval) {
+      auto bin = static_cast<int64_t>((value - minval) / range * nbins);
+      hist_data[std::min(bin, nbins - 1)] += 1;
+    }
+  }
+}
+
+template <typename scalar_t>
+void histc_add_parallel(
+    Tensor& hist,
+    const Tensor& self,
+    scalar_t minval,
+    scalar_t maxval) {
+  int64_t nbins = hist.numel();
+  int64_t numel = self.numel();
+  const scalar_t* data = self.data_ptr<scalar_t>();
+  int num_threads = at::get_num_threads();
+  if (numel < at::internal::GRAIN_SIZE || num_threads == 1) {
+    histc_add_serial(
+        hist.data_ptr<scalar_t>(), nbins, data, numel, minval, maxval);
+    return;
+  }
+  Tensor local_hists = at::zeros({num_threads, nbins}, hist.options());
+  scalar_t* local_data = local_hists.data_ptr<scalar_t>();
+  at::parallel_for(
+      0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        scalar_t* local = local_data + at::get_thread_num() * nbins;
+        histc_add_serial(
+            local, nbins, data + begin, end - begin, minval, maxval);
+      });
+  hist.add_(local_hists.sum(0));
+}
+
+template <typename scalar_t>
+std::pair<scalar_t, scalar_t> vec_min_max(
+    const scalar_t* data,
+    int64_t numel) {
+  using Vec = Vec256<scalar_t>;
+  scalar_t min_val = data[0];
+  scalar_t max_val = data[0];
+  int64_t d = 0;
+  if (numel >= Vec::size()) {
+    Vec min_vec(data[0]);
+    Vec max_vec(data[0]);
+    for (; d + Vec::size() <= numel; d += Vec::size()) {
+      Vec values = Vec::loadu(data + d);
+      min_vec = minimum(min_vec, values);
+      max_vec = maximum(max_vec, values);
+    }
+    scalar_t buffer[Vec::size()];
+    min_vec.store(buffer);
+    for (int i = 0; i < Vec::size(); i++) {
+      min_val = std::min(min_val, buffer[i]);
+    }
+    max_vec.store(buffer);
+    for (int i = 0; i < Vec::size(); i++) {
+      max_val = std::max(max_val, buffer[i]);
+    }
+  }
+  for (; d < numel; d++) {
+    min_val = std::min(min_val, data[d]);
+    max_val = std::max(max_val, data[d]);
+  }
+  return {min_val, max_val};
+}
+
+void histc_add_kernel(
+    Tensor& hist,
+    const Tensor& self,
+    Scalar min,
+    Scalar max) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_add_cpu", [&]() {
+    auto minval = min.to<scalar_t>();
+    auto maxval = max.to<scalar_t>();
+    if (minval == maxval) {
+      minval = minval - 1;
+      maxval = maxval + 1;
+    }
+    TORCH_CHECK(
+        !(std::isinf(static_cast<double>(minval)) ||
+          std::isinf(static_cast<double>(maxval)) || std::isnan(minval) ||
+          std::isnan(maxval)),
+        "range of [", minval, ", ", maxval, "] is not finite");
+    TORCH_CHECK(minval < maxval, "max must be larger than min");
+    histc_add_parallel<scalar_t>(hist, self, minval, maxval);
+  });
+}
+
+void histc_min_max_kernel(
+    Tensor& hist,
+    Tensor& min,
+    Tensor& max,
+    const Tensor& self,
+    int64_t nbins) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_min_max_cpu", [&]() {
+    const scalar_t* data = self.data_ptr<scalar_t>();
+    int64_t numel = self.numel();
+    auto minmax = at::parallel_reduce(
+        0,
+        numel,
+        at::internal::GRAIN_SIZE,
+        std::pair<scalar_t, scalar_t>(data[0], data[0]),
+        [&](int64_t begin, int64_t end, std::pair<scalar_t, scalar_t> init) {
+          auto local = vec_min_max(data + begin, end - begin);
+          return std::make_pair(
+              std::min(init.first, local.first),
+              std::max(init.second, local.second));
+        },
+        [](std::pair<scalar_t, scalar_t> a, std::pair<scalar_t, scalar_t> b) {
+          return std::make_pair(
+              std::min(a.first, b.first), std::max(a.second, b.second));
+        });
+    auto minval = minmax.first;
+    auto maxval = minmax.second;
+    min.fill_(minval);
+    max.fill_(maxval);
+    // match histc on a constant input: spread the range by one on each side
+    if (minval == maxval) {
+      minval = minval - 1;
+      maxval = maxval + 1;
+    }
+    TORCH_CHECK(
+        !(std::isinf(static_cast<double>(minval)) ||
+          std::isinf(static_cast<double>(maxval)) || std::isnan(minval) ||
+          std::isnan(maxval)),
+        "range of [", minval, ", ", maxval, "] is not finite");
+    histc_add_parallel<scalar_t>(hist, self, minval, maxval);
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(histc_add_stub, &histc_add_kernel);
+REGISTER_DISPATCH(histc_min_max_stub, &histc_min_max_kernel);
+
+}} // namespace at::native
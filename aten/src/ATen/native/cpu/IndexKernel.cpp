@@ -1,6 +1,8 @@
 #include <ATen/native/TensorAdvancedIndexing.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <ATen/Dispatch.h>
 #include <ATen/native/TensorIterator.h>
@@ -57,9 +59,12 @@ static bool is_constant_index(int ntensor, const int64_t* strides) {
   return true;
 }
 
-template <typename scalar_t, typename func_t>
+// `f` applies a single element; `vf` applies a run of `n` elements that all
+// use the same index and are contiguous in both operands, so implementations
+// can use memcpy or vectorized loops.
+template <typename scalar_t, typename func_t, typename vec_func_t>
 void cpu_index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride,
-                      const func_t& f, bool serial_execution=false)
+                      const func_t& f, const vec_func_t& vf, bool serial_execution=false)
 {
   int ntensor = iter.ntensors();
   auto loop = [&](char** data, const int64_t* strides, int64_t n) {
@@ -70,9 +75,7 @@ void cpu_index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
       // specialization for when every element uses the same index
       int64_t offset = indexer.get(0);
       if (strides[0] == sizeof(scalar_t) && strides[1] == sizeof(scalar_t)) {
-        for (int64_t i = 0; i < n; i++) {
-          f(dst + strides[0] * i, src + strides[1] * i, offset);
-        }
+        vf(dst, src, offset, n);
       } else {
         for (int64_t i = 0; i < n; i++) {
           f(dst + strides[0] * i, src + strides[1] * i, offset);
@@ -92,11 +95,54 @@ void cpu_index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
   }
 }
 
+// Note [Parallel index_put_ accumulation]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// With accumulate=true, duplicate indices must add up, so the element list
+// cannot simply be split across threads. Instead every thread scans the full
+// list and only applies the updates whose destination address falls into its
+// contiguous byte-slice of self's storage. Writes are therefore disjoint
+// across threads (duplicates always land on the same thread) without atomics
+// and without privatized copies of self, at the cost of each thread reading
+// the whole index list.
+template <typename scalar_t, typename func_t>
+void cpu_index_put_accum_parallel_kernel(TensorIterator& iter, IntArrayRef index_size,
+                                         IntArrayRef index_stride, const func_t& f)
+{
+  const auto& dst_tensor = iter.tensor(0);
+  char* base = static_cast<char*>(dst_tensor.storage().data());
+  int64_t total_bytes = dst_tensor.storage().capacity();
+  int num_threads = at::get_num_threads();
+  int64_t chunk_bytes = divup(total_bytes, static_cast<int64_t>(num_threads));
+  int ntensor = iter.ntensors();
+
+  at::parallel_for(0, num_threads, 1, [&](int64_t thread_begin, int64_t thread_end) {
+    for (int64_t t = thread_begin; t < thread_end; t++) {
+      char* slice_begin = base + t * chunk_bytes;
+      char* slice_end = std::min(base + total_bytes, slice_begin + chunk_bytes);
+      auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+        auto indexer = Indexer(ntensor - 2, &data[2], &strides[2], index_size, index_stride);
+        char* dst = data[0];
+        char* src = data[1];
+        for (int64_t i = 0; i < n; i++) {
+          int64_t offset = indexer.get(i);
+          char* addr = dst + strides[0] * i + offset;
+          if (addr >= slice_begin && addr < slice_end) {
+            f(dst + strides[0] * i, src + strides[1] * i, offset);
+          }
+        }
+      };
+      iter.serial_for_each(loop, {0, iter.numel()});
+    }
+  });
+}
+
 void index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride) {
   AT_DISPATCH_ALL_TYPES_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
     iter.dtype(), "index_cpu", [&] {
     cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
       *(scalar_t*)dst = *(scalar_t*)(src + offset);
+    }, [](char* dst, char* src, int64_t offset, int64_t n) {
+      memcpy(dst, src + offset, n * sizeof(scalar_t));
     });
   });
 }
@@ -106,14 +152,28 @@ void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
   AT_DISPATCH_ALL_TYPES_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
     iter.dtype(), "index_put", [&] {
     if (accumulate) {
-      // TODO: investigate parallelization of the accumulate kernel. Unlike the non-accumulate case,
-      // this needs to be thread-safe.
-      cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
+      auto f = [](char* dst, char* src, int64_t offset) {
         *(scalar_t*)(dst + offset) += *(scalar_t*)src;
-      }, /*serial_execution=*/true);
+      };
+      if (iter.numel() >= internal::GRAIN_SIZE && at::get_num_threads() > 1 &&
+          !at::in_parallel_region()) {
+        // See Note [Parallel index_put_ accumulation]
+        cpu_index_put_accum_parallel_kernel<scalar_t>(iter, index_size, index_stride, f);
+      } else {
+        cpu_index_kernel<scalar_t>(iter, index_size, index_stride, f,
+            [](char* dst, char* src, int64_t offset, int64_t n) {
+          auto* out = (scalar_t*)(dst + offset);
+          auto* in = (scalar_t*)src;
+          for (int64_t i = 0; i < n; i++) {
+            out[i] += in[i];
+          }
+        }, /*serial_execution=*/true);
+      }
     } else {
       cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
         *(scalar_t*)(dst + offset) = *(scalar_t*)src;
+      }, [](char* dst, char* src, int64_t offset, int64_t n) {
+        memcpy(dst + offset, src, n * sizeof(scalar_t));
       });
     }
   });
@@ -43,6 +43,37 @@ static inline bool is_contiguous(const int64_t* strides) {
   return IsContiguous<traits::arity, traits::arity, traits>::eval(strides);
 }
 
+// Fills `strides` with the byte strides a fully contiguous chunk would
+// have (sizeof the result followed by sizeof each argument), all known at
+// compile time. Running IsContiguous once against the iterator's element
+// sizes is then equivalent to running it on every chunk, which lets
+// callers hoist the contiguity branch out of the per-chunk callback; see
+// cpu_kernel in Loops.h.
+template <typename traits, std::size_t OFFSET, std::size_t... INDEX>
+static inline void fill_contiguous_strides_impl(
+    int64_t* strides,
+    std::index_sequence<INDEX...>) {
+  (void)std::initializer_list<int>{
+      (strides[INDEX + OFFSET] =
+           sizeof(typename traits::template arg<INDEX>::type),
+       0)...};
+}
+
+template <typename traits,
+    typename std::enable_if<std::is_void<typename traits::result_type>::value>::type* = nullptr>
+static inline void fill_contiguous_strides(int64_t* strides) {
+  fill_contiguous_strides_impl<traits, 0>(
+      strides, std::make_index_sequence<traits::arity>{});
+}
+
+template <typename traits,
+    typename std::enable_if<!std::is_void<typename traits::result_type>::value>::type* = nullptr>
+static inline void fill_contiguous_strides(int64_t* strides) {
+  strides[0] = sizeof(typename traits::result_type);
+  fill_contiguous_strides_impl<traits, 1>(
+      strides, std::make_index_sequence<traits::arity>{});
+}
+
 // input at `s` is scalar (stride 0); output and other inputs are contiguous
 // NB: output is typically at strides[0] so first input corresponds to s=1
 template <typename traits, int s,
@@ -28,6 +28,7 @@
 
 #include <stdint.h>
 #include <c10/util/C++17.h>
+#include <ATen/Parallel.h>
 #include <ATen/detail/FunctionTraits.h>
 #include <ATen/native/cpu/IsContiguous.h>
 #include <ATen/native/TensorIterator.h>
@@ -126,6 +127,38 @@ basic_loop(char* C10_RESTRICT data[], const int64_t* strides_, int64_t i, int64_
   execute_op(data, strides, i, n, std::forward<func_t>(op));
 }
 
+// Like basic_loop, but for chunks known to be contiguous: the strides are
+// compile-time constants, so the hot loop carries no stride loads and the
+// address arithmetic folds into the induction variable.
+template <typename func_t>
+static inline void
+contiguous_loop(char* C10_RESTRICT data[], int64_t i, int64_t n, func_t&& op) {
+  using traits = function_traits<func_t>;
+  constexpr int ntensors = traits::arity + 1;
+
+  int64_t strides[ntensors];
+  fill_contiguous_strides<traits>(strides);
+
+  execute_op(data, strides, i, n, std::forward<func_t>(op));
+}
+
+// Returns true when every chunk for_each will hand out is contiguous with
+// strides equal to the operand element sizes, which allows the contiguity
+// decision to be made once per op instead of once per 32k-element chunk.
+// Requires iter.ntensors() >= traits::arity + 1 (checked by the callers).
+template <typename traits>
+static inline bool is_contiguous_iteration(TensorIterator& iter) {
+  if (!iter.is_contiguous()) {
+    return false;
+  }
+  constexpr int ntensors = traits::arity + 1;
+  int64_t strides[ntensors];
+  for (int arg = 0; arg < ntensors; arg++) {
+    strides[arg] = iter.element_size(arg);
+  }
+  return is_contiguous<traits>(strides);
+}
+
 // Explicitly vectorized loop implementation. All inputs and outputs must be
 // the same type and contiguous with one exception: a single input may be
 // a scalar (stride 0). It's position is indicated by the argument `S`. If `S`
@@ -183,11 +216,25 @@ static inline void unroll_contiguous_scalar_checks(
   }
 }
 
+// `grain_size` is forwarded to TensorIterator::for_each; kernels whose
+// per-element cost deviates a lot from typical arithmetic should pass a hint
+// (smaller for expensive element functions, larger for trivial ones).
 template <typename func_t>
-void cpu_kernel(TensorIterator& iter, func_t&& op) {
+void cpu_kernel(
+    TensorIterator& iter,
+    func_t&& op,
+    int64_t grain_size = at::internal::GRAIN_SIZE) {
   using traits = function_traits<func_t>;
   TORCH_INTERNAL_ASSERT(iter.ntensors() >= traits::arity + 1);
 
+  if (is_contiguous_iteration<traits>(iter)) {
+    iter.for_each([&](char** data, const int64_t* /*strides*/, int64_t n) {
+      contiguous_loop(data, 0, n, std::forward<func_t>(op));
+    }, grain_size);
+    iter.cast_outputs();
+    return;
+  }
+
   iter.for_each([&](char** data, const int64_t* strides, int64_t n) {
     if (is_contiguous<traits>(strides)) {
       basic_loop(data, strides, 0, n, std::forward<func_t>(op));
@@ -197,15 +244,28 @@ void cpu_kernel(TensorIterator& iter, func_t&& op) {
         basic_loop(data, strides, 0, n, std::forward<func_t>(op));
       });
     }
-  });
+  }, grain_size);
   iter.cast_outputs();
 }
 
 template <typename func_t, typename vec_func_t>
-void cpu_kernel_vec(TensorIterator& iter, func_t&& op, vec_func_t&& vop) {
+void cpu_kernel_vec(
+    TensorIterator& iter,
+    func_t&& op,
+    vec_func_t&& vop,
+    int64_t grain_size = at::internal::GRAIN_SIZE) {
   using traits = function_traits<func_t>;
   TORCH_INTERNAL_ASSERT(iter.ntensors() >= traits::arity + 1);
 
+  if (is_contiguous_iteration<traits>(iter)) {
+    iter.for_each([&](char** data, const int64_t* /*strides*/, int64_t n) {
+      vectorized_loop(
+          data, n, 0, std::forward<func_t>(op), std::forward<vec_func_t>(vop));
+    }, grain_size);
+    iter.cast_outputs();
+    return;
+  }
+
   iter.for_each([&](char** data, const int64_t* strides, int64_t n) {
     if (is_contiguous<traits>(strides)) {
       return vectorized_loop(data, n, 0, std::forward<func_t>(op), std::forward<vec_func_t>(vop));
@@ -219,7 +279,7 @@ void cpu_kernel_vec(TensorIterator& iter, func_t&& op, vec_func_t&& vop) {
         }
       });
     }
-  });
+  }, grain_size);
   iter.cast_outputs();
 }
 
@@ -275,4 +275,95 @@ void binary_kernel_reduce_vec(TensorIterator& iter, func_t op, vec_func_t vop, d
   });
 }
 
+// Runs two reductions over the same input in a single traversal, writing the
+// result of op1 to output 0 and the result of op2 to output 1 (e.g. fused
+// min+max). Each element is loaded once and folded into both accumulators;
+// when the reduced data is contiguous the inner loop keeps one Vec256
+// accumulator per reduction. The ops must also be valid for combining two
+// partial accumulators (true for min, max, sum, prod, ...) and the identities
+// seed the accumulators, so unlike binary_kernel_reduce_vec this does not
+// read back the output values during the reduction.
+template <typename func1_t, typename vec_func1_t,
+          typename func2_t, typename vec_func2_t>
+void binary_kernel_reduce_vec_pair(
+    TensorIterator& iter,
+    func1_t op1, vec_func1_t vop1,
+    func2_t op2, vec_func2_t vop2,
+    typename binary_function_traits<func1_t>::result_type ident1,
+    typename binary_function_traits<func1_t>::result_type ident2) {
+  using traits = binary_function_traits<func1_t>;
+  using scalar_t = typename traits::result_type;
+  using Vec = Vec256<scalar_t>;
+  static_assert(
+    all_same<
+      scalar_t,
+      typename traits::arg1_t,
+      typename traits::arg2_t,
+      typename binary_function_traits<func2_t>::result_type,
+      typename binary_function_traits<func2_t>::arg1_t,
+      typename binary_function_traits<func2_t>::arg2_t>::value,
+    "all types must match");
+  AT_ASSERT(iter.noutputs() == 2);
+
+  using acc_t = std::pair<scalar_t, scalar_t>;
+  const acc_t init(ident1, ident2);
+  iter.foreach_reduced_elt([&](TensorIterator& sub_iter) {
+    auto reduction_body = [&](acc_t acc, int64_t begin, int64_t end) -> acc_t {
+      int ntensors = sub_iter.ntensors();
+      sub_iter.serial_for_each([&](char** data, const int64_t* strides, int64_t size) {
+        AT_ASSERT(ntensors - sub_iter.noutputs() == 1);
+        const char* in = data[ntensors - 1];
+        int64_t stride = strides[ntensors - 1];
+        int64_t i = 0;
+        if (stride == sizeof(scalar_t) && size >= (int64_t)Vec::size()) {
+          Vec vacc1(ident1);
+          Vec vacc2(ident2);
+          for (; i <= size - (int64_t)Vec::size(); i += Vec::size()) {
+            Vec val = Vec::loadu(in + i * sizeof(scalar_t));
+            vacc1 = vop1(vacc1, val);
+            vacc2 = vop2(vacc2, val);
+          }
+          scalar_t buffer[Vec::size()];
+          vacc1.store(buffer);
+          for (int j = 0; j < Vec::size(); j++) {
+            acc.first = op1(acc.first, buffer[j]);
+          }
+          vacc2.store(buffer);
+          for (int j = 0; j < Vec::size(); j++) {
+            acc.second = op2(acc.second, buffer[j]);
+          }
+        }
+        for (; i < size; i++) {
+          scalar_t val = *(const scalar_t*)(in + i * stride);
+          acc.first = op1(acc.first, val);
+          acc.second = op2(acc.second, val);
+        }
+      }, {begin, end});
+      return acc;
+    };
+    acc_t total_acc = init;
+    auto numel = sub_iter.numel();
+    if (numel < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
+        at::in_parallel_region()) {
+      total_acc = reduction_body(total_acc, 0, numel);
+    } else {
+      int max_threads = at::get_num_threads();
+      AT_ASSERT(max_threads > 0);
+      std::vector<acc_t> buffer((unsigned)max_threads, init);
+      at::parallel_for(0, numel, internal::GRAIN_SIZE,
+        [&](int64_t begin, int64_t end) {
+          auto& acc = buffer[at::get_thread_num()];
+          acc = reduction_body(acc, begin, end);
+        }
+      );
+      for (int i = 0; i < max_threads; ++i) {
+        total_acc.first = op1(total_acc.first, buffer[i].first);
+        total_acc.second = op2(total_acc.second, buffer[i].second);
+      }
+    }
+    set_results<traits>(
+        std::make_tuple(total_acc.first, total_acc.second), sub_iter, 2);
+  });
+}
+
 }}}  // namespace at::native::<anonymous>
@@ -278,6 +278,21 @@ constexpr scalar_t lower_bound() {
   return lim::has_infinity ? -lim::infinity() : lim::lowest();
 }
 
+static void min_max_kernel_impl(TensorIterator& iter) {
+  AT_DISPATCH_ALL_TYPES(iter.dtype(), "min_max_cpu", [&iter] {
+    binary_kernel_reduce_vec_pair(
+      iter,
+      // NaN-aware like the vectorized minimum/maximum, so NaNs propagate to
+      // both outputs no matter which code path sees them.
+      [](scalar_t a, scalar_t b) -> scalar_t { return (at::_isnan(a) || a < b) ? a : b; },
+      [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return minimum(a, b); },
+      [](scalar_t a, scalar_t b) -> scalar_t { return (at::_isnan(a) || a > b) ? a : b; },
+      [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return maximum(a, b); },
+      /*ident1=*/upper_bound<scalar_t>(),
+      /*ident2=*/lower_bound<scalar_t>());
+  });
+}
+
 static void argmax_kernel_impl(TensorIterator &iter) {
   AT_DISPATCH_ALL_TYPES(iter.dtype(1), "argmax_cpu", [&] {
     binary_kernel_reduce(
@@ -307,6 +322,7 @@ REGISTER_DISPATCH(and_stub, &and_kernel_impl);
 REGISTER_DISPATCH(or_stub, &or_kernel_impl);
 REGISTER_DISPATCH(min_values_stub, &min_values_kernel_impl);
 REGISTER_DISPATCH(max_values_stub, &max_values_kernel_impl);
+REGISTER_DISPATCH(min_max_stub, &min_max_kernel_impl);
 REGISTER_DISPATCH(argmax_stub, &argmax_kernel_impl);
 REGISTER_DISPATCH(argmin_stub, &argmin_kernel_impl);
 REGISTER_DISPATCH(cumprod_stub, &cumprod_cpu_kernel);
@@ -2,6 +2,9 @@
 #include <ATen/native/ReduceOpsUtils.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/intrinsics.h>
+
+#include <limits>
 
 namespace at { namespace native {
 
@@ -147,6 +150,83 @@ void cpu_scatter_gather_base_kernel(
   );
 }
 
+#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+// Vectorized row gather for the embedding-style case: float data, the
+// gathered dimension contiguous in both result and index. Eight int64
+// indices are bounds-checked with 64-bit compares, narrowed to int32
+// offsets (the caller guarantees every reachable offset fits) and fed to
+// the AVX2 hardware gather. Returns false to fall back to the scalar loop,
+// which also reproduces the exact out-of-bounds error message.
+bool gather_contig_inner_dim(
+  float* result_data, int64_t result_dim_stride,
+  const int64_t* index_data, int64_t index_dim_stride,
+  const float* self_data, int64_t self_dim_stride,
+  int64_t index_dim_size, int64_t self_dim_size
+) {
+  if (result_dim_stride != 1 || index_dim_stride != 1) {
+    return false;
+  }
+  // every gathered offset must fit an int32 lane
+  if (self_dim_size > 0 &&
+      (self_dim_size - 1) * self_dim_stride >
+          static_cast<int64_t>(std::numeric_limits<int32_t>::max())) {
+    return false;
+  }
+
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i max_index = _mm256_set1_epi64x(self_dim_size - 1);
+  const __m256i stride = _mm256_set1_epi32(static_cast<int32_t>(self_dim_stride));
+  // picks the low 32 bits of each 64-bit lane into the low 128 bits
+  const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+  int64_t i = 0;
+  for (; i + 8 <= index_dim_size; i += 8) {
+    const __m256i idx_lo = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(index_data + i));
+    const __m256i idx_hi = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(index_data + i + 4));
+    const __m256i bad = _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_cmpgt_epi64(idx_lo, max_index),
+            _mm256_cmpgt_epi64(zero, idx_lo)),
+        _mm256_or_si256(
+            _mm256_cmpgt_epi64(idx_hi, max_index),
+            _mm256_cmpgt_epi64(zero, idx_hi)));
+    if (!_mm256_testz_si256(bad, bad)) {
+      return false;
+    }
+    const __m128i lo32 = _mm256_castsi256_si128(
+        _mm256_permutevar8x32_epi32(idx_lo, low_halves));
+    const __m128i hi32 = _mm256_castsi256_si128(
+        _mm256_permutevar8x32_epi32(idx_hi, low_halves));
+    const __m256i idx32 =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(lo32), hi32, 1);
+    const __m256i offsets = _mm256_mullo_epi32(idx32, stride);
+    _mm256_storeu_ps(
+        result_data + i, _mm256_i32gather_ps(self_data, offsets, 4));
+  }
+  for (; i < index_dim_size; ++i) {
+    int64_t idx_dim = index_data[i];
+    if (idx_dim < 0 || idx_dim >= self_dim_size) {
+      return false;
+    }
+    result_data[i] = self_data[idx_dim * self_dim_stride];
+  }
+  return true;
+}
+#endif
+
+// Fallback for dtypes and layouts the vectorized gather does not handle.
+template <typename scalar_t>
+bool gather_contig_inner_dim(
+  scalar_t* /* result_data */, int64_t /* result_dim_stride */,
+  const int64_t* /* index_data */, int64_t /* index_dim_stride */,
+  const scalar_t* /* self_data */, int64_t /* self_dim_stride */,
+  int64_t /* index_dim_size */, int64_t /* self_dim_size */
+) {
+  return false;
+}
+
 void gather_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim, const Tensor& index) {
   if (index.numel() == 0) {
     return;
@@ -166,6 +246,13 @@ void gather_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim, const Te
       const auto* index_data, auto index_dim_stride,
       const auto* self_data, auto self_dim_stride
     ) {
+      if (gather_contig_inner_dim(
+            result_data, result_dim_stride,
+            index_data, index_dim_stride,
+            self_data, self_dim_stride,
+            index_dim_size, self_dim_size)) {
+        return;
+      }
       for (int64_t i = 0; i < index_dim_size; ++i) {
         int64_t idx_dim = index_data[i * index_dim_stride];
         // we are not putting idx_dim in the error message because it disables
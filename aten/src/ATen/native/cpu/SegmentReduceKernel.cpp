@@ -0,0 +1,180 @@
+#include <ATen/native/SegmentReduce.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <limits>
+
+namespace at { namespace native {
+namespace {
+
+using namespace vec256;
+
+// values is treated as a contiguous (rows, inner) matrix; segment i reduces
+// rows [offsets[i], offsets[i + 1]) elementwise across the inner dimension.
+// Segments are independent, so the parallelism is over segments and Vec256
+// covers the inner dimension.
+
+template <typename scalar_t>
+inline void accumulate_row(
+    scalar_t* acc,
+    const scalar_t* row,
+    int64_t inner_size,
+    SegmentReduceOp op) {
+  using Vec = Vec256<scalar_t>;
+  int64_t d = 0;
+  if (op == SegmentReduceOp::MAX) {
+    for (; d + Vec::size() <= inner_size; d += Vec::size()) {
+      maximum(Vec::loadu(acc + d), Vec::loadu(row + d)).store(acc + d);
+    }
+    for (; d < inner_size; ++d) {
+      acc[d] = std::max(acc[d], row[d]);
+    }
+  } else {
+    for (; d + Vec::size() <= inner_size; d += Vec::size()) {
+      (Vec::loadu(acc + d) + Vec::loadu(row + d)).store(acc + d);
+    }
+    for (; d < inner_size; ++d) {
+      acc[d] += row[d];
+    }
+  }
+}
+
+template <typename scalar_t>
+void segment_reduce_cpu_impl(
+    Tensor& output,
+    const Tensor& values,
+    const Tensor& offsets,
+    SegmentReduceOp op) {
+  const int64_t num_segments = offsets.numel() - 1;
+  const int64_t inner_size = values.numel() / std::max<int64_t>(values.size(0), 1);
+  const scalar_t* values_data = values.data_ptr<scalar_t>();
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+
+  const scalar_t init = op == SegmentReduceOp::MAX
+      ? std::numeric_limits<scalar_t>::lowest()
+      : static_cast<scalar_t>(0);
+  const int64_t grain =
+      std::max<int64_t>(internal::GRAIN_SIZE / std::max<int64_t>(inner_size, 1), 1);
+
+  at::parallel_for(0, num_segments, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t s = begin; s < end; ++s) {
+      const int64_t row_begin = offsets_data[s];
+      const int64_t row_end = offsets_data[s + 1];
+      scalar_t* out_row = output_data + s * inner_size;
+      for (int64_t d = 0; d < inner_size; ++d) {
+        out_row[d] = row_end > row_begin ? init : static_cast<scalar_t>(0);
+      }
+      for (int64_t row = row_begin; row < row_end; ++row) {
+        accumulate_row(out_row, values_data + row * inner_size, inner_size, op);
+      }
+      if (op == SegmentReduceOp::MEAN && row_end > row_begin) {
+        const scalar_t scale =
+            static_cast<scalar_t>(1) / static_cast<scalar_t>(row_end - row_begin);
+        using Vec = Vec256<scalar_t>;
+        const Vec scale_vec(scale);
+        int64_t d = 0;
+        for (; d + Vec::size() <= inner_size; d += Vec::size()) {
+          (Vec::loadu(out_row + d) * scale_vec).store(out_row + d);
+        }
+        for (; d < inner_size; ++d) {
+          out_row[d] *= scale;
+        }
+      }
+    }
+  });
+}
+
+void segment_reduce_kernel(
+    Tensor& output,
+    const Tensor& values,
+    const Tensor& offsets,
+    SegmentReduceOp op) {
+  AT_DISPATCH_ALL_TYPES(values.scalar_type(), "segment_reduce_cpu", [&] {
+    segment_reduce_cpu_impl<scalar_t>(output, values, offsets, op);
+  });
+}
+
+template <typename scalar_t>
+void segment_reduce_backward_cpu_impl(
+    Tensor& grad_values,
+    const Tensor& grad,
+    const Tensor& output,
+    const Tensor& values,
+    const Tensor& offsets,
+    SegmentReduceOp op) {
+  const int64_t num_segments = offsets.numel() - 1;
+  const int64_t inner_size = values.numel() / std::max<int64_t>(values.size(0), 1);
+  const scalar_t* grad_data = grad.data_ptr<scalar_t>();
+  const scalar_t* output_data = output.data_ptr<scalar_t>();
+  const scalar_t* values_data = values.data_ptr<scalar_t>();
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+  scalar_t* grad_values_data = grad_values.data_ptr<scalar_t>();
+
+  const int64_t grain =
+      std::max<int64_t>(internal::GRAIN_SIZE / std::max<int64_t>(inner_size, 1), 1);
+
+  at::parallel_for(0, num_segments, grain, [&](int64_t begin, int64_t end) {
+    using Vec = Vec256<scalar_t>;
+    for (int64_t s = begin; s < end; ++s) {
+      const int64_t row_begin = offsets_data[s];
+      const int64_t row_end = offsets_data[s + 1];
+      const scalar_t* grad_row = grad_data + s * inner_size;
+      const scalar_t* out_row = output_data + s * inner_size;
+      const scalar_t scale = op == SegmentReduceOp::MEAN
+          ? static_cast<scalar_t>(1) / static_cast<scalar_t>(row_end - row_begin)
+          : static_cast<scalar_t>(1);
+      const Vec scale_vec(scale);
+      for (int64_t row = row_begin; row < row_end; ++row) {
+        const scalar_t* in_row = values_data + row * inner_size;
+        scalar_t* grad_in_row = grad_values_data + row * inner_size;
+        int64_t d = 0;
+        if (op == SegmentReduceOp::MAX) {
+          // Every element equal to the segment max receives the full
+          // gradient, mirroring how ties behave in the forward reduction.
+          for (; d + Vec::size() <= inner_size; d += Vec::size()) {
+            const Vec mask = Vec::loadu(in_row + d) == Vec::loadu(out_row + d);
+            (Vec::loadu(grad_row + d) & mask).store(grad_in_row + d);
+          }
+          for (; d < inner_size; ++d) {
+            grad_in_row[d] = in_row[d] == out_row[d]
+                ? grad_row[d]
+                : static_cast<scalar_t>(0);
+          }
+        } else {
+          for (; d + Vec::size() <= inner_size; d += Vec::size()) {
+            (Vec::loadu(grad_row + d) * scale_vec).store(grad_in_row + d);
+          }
+          for (; d < inner_size; ++d) {
+            grad_in_row[d] = grad_row[d] * scale;
+          }
+        }
+      }
+    }
+  });
+}
+
+void segment_reduce_backward_kernel(
+    Tensor& grad_values,
+    const Tensor& grad,
+    const Tensor& output,
+    const Tensor& values,
+    const Tensor& offsets,
+    SegmentReduceOp op) {
+  AT_DISPATCH_FLOATING_TYPES(
+      values.scalar_type(), "segment_reduce_backward_cpu", [&] {
+        segment_reduce_backward_cpu_impl<scalar_t>(
+            grad_values, grad, output, values, offsets, op);
+      });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(segment_reduce_stub, &segment_reduce_kernel);
+REGISTER_DISPATCH(
+    segment_reduce_backward_stub,
+    &segment_reduce_backward_kernel);
+
+}} // namespace at::native
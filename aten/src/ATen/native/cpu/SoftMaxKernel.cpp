@@ -261,6 +261,89 @@ static void log_softmax_backward_lastdim_kernel_impl(
       });
 }
 
+// Softmax over the segment dimension of a ragged batch: values is a
+// [total, inner] matrix whose rows belong to segments delimited by
+// offsets, and each of the inner columns is normalized over the rows of
+// its segment. Columns are vectorized; rows are walked serially, so a
+// segment never has to be materialized as a padded block.
+template <typename scalar_t>
+inline void _vec_ragged_softmax(
+    scalar_t* input_data_base,
+    scalar_t* output_data_base,
+    const int64_t* offsets,
+    int64_t n_segments,
+    int64_t inner_size) {
+  using Vec = vec256::Vec256<scalar_t>;
+  int64_t total = offsets[n_segments];
+  int64_t avg_len = n_segments > 0 ? std::max<int64_t>(total / n_segments, 1) : 1;
+  int64_t grain_size =
+      std::max<int64_t>(internal::GRAIN_SIZE / (16 * avg_len * inner_size), 1);
+  parallel_for(0, n_segments, grain_size, [&](int64_t begin, int64_t end) {
+    // Per-column running max and exp-sum for the current segment.
+    std::vector<scalar_t> max_buf(inner_size);
+    std::vector<scalar_t> sum_buf(inner_size);
+    for (int64_t s = begin; s < end; s++) {
+      int64_t row_begin = offsets[s];
+      int64_t row_end = offsets[s + 1];
+      if (row_begin == row_end) {
+        continue;
+      }
+      scalar_t* first_row = input_data_base + row_begin * inner_size;
+      std::copy(first_row, first_row + inner_size, max_buf.data());
+      for (int64_t r = row_begin + 1; r < row_end; r++) {
+        vec256::map2(
+            [](Vec x, Vec y) { return vec256::maximum(x, y); },
+            max_buf.data(),
+            max_buf.data(),
+            input_data_base + r * inner_size,
+            inner_size);
+      }
+      std::fill(sum_buf.begin(), sum_buf.end(), scalar_t(0));
+      for (int64_t r = row_begin; r < row_end; r++) {
+        scalar_t* out_row = output_data_base + r * inner_size;
+        vec256::map2(
+            [](Vec x, Vec m) { return (x - m).exp(); },
+            out_row,
+            input_data_base + r * inner_size,
+            max_buf.data(),
+            inner_size);
+        vec256::map2(
+            [](Vec acc, Vec x) { return acc + x; },
+            sum_buf.data(),
+            sum_buf.data(),
+            out_row,
+            inner_size);
+      }
+      for (int64_t r = row_begin; r < row_end; r++) {
+        scalar_t* out_row = output_data_base + r * inner_size;
+        vec256::map2(
+            [](Vec x, Vec s) { return x / s; },
+            out_row,
+            out_row,
+            sum_buf.data(),
+            inner_size);
+      }
+    }
+  });
+}
+
+static void ragged_softmax_kernel_impl(
+    Tensor& result,
+    const Tensor& self,
+    const Tensor& offsets) {
+  int64_t n_segments = offsets.numel() - 1;
+  int64_t inner_size = self.dim() > 1 ? self.size(1) : 1;
+  AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(), "ragged_softmax_kernel_impl", [&] {
+        _vec_ragged_softmax<scalar_t>(
+            self.data_ptr<scalar_t>(),
+            result.data_ptr<scalar_t>(),
+            offsets.data_ptr<int64_t>(),
+            n_segments,
+            inner_size);
+      });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(softmax_lastdim_kernel, &softmax_lastdim_kernel_impl);
@@ -271,5 +354,6 @@ REGISTER_DISPATCH(
 REGISTER_DISPATCH(
     log_softmax_backward_lastdim_kernel,
     &log_softmax_backward_lastdim_kernel_impl);
+REGISTER_DISPATCH(ragged_softmax_kernel, &ragged_softmax_kernel_impl);
 
 }} // namespace at::native
@@ -2,6 +2,7 @@
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
 #include <ATen/NumericUtils.h>
+#include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/Sorting.h>
 #include <ATen/native/SortingUtils.h>
 
@@ -9,6 +10,105 @@ namespace at { namespace native {
 
 namespace {
 
+// Largest k for which we keep the running top-k in a small sorted array
+// instead of materializing and selecting over the whole row.
+constexpr int64_t kSmallTopkSize = 32;
+// Row chunk size for the candidate pre-check in topk_small_k.
+constexpr int64_t kTopkChunkSize = 1024;
+
+// Returns true iff x sorts before y, with NaN sorted as top for numpy
+// compatibility (same ordering as the comparators in topk_kernel below).
+template <typename scalar_t>
+inline bool topk_ranks_before(scalar_t x, scalar_t y, bool largest) {
+  return largest
+      ? ((_isnan<scalar_t>(x) && !_isnan<scalar_t>(y)) || x > y)
+      : ((!_isnan<scalar_t>(x) && _isnan<scalar_t>(y)) || x < y);
+}
+
+// Checks whether any element of data[0, len) could rank before `cutoff`.
+// Generic fallback: always scan the chunk.
+template <typename scalar_t>
+inline bool chunk_has_candidate(
+    const scalar_t* /*data*/,
+    int64_t /*len*/,
+    scalar_t /*cutoff*/,
+    bool /*largest*/) {
+  return true;
+}
+
+// Float specialization: reduce the chunk to its extreme with Vec256 lanes so
+// fully dominated chunks are rejected with a handful of vector ops. NaN
+// propagates through maximum/minimum and conservatively forces a scan.
+inline bool chunk_has_candidate(
+    const float* data,
+    int64_t len,
+    float cutoff,
+    bool largest) {
+  using Vec = vec256::Vec256<float>;
+  int64_t d = 0;
+  if (len >= Vec::size()) {
+    Vec acc = Vec::loadu(data);
+    for (d = Vec::size(); d + Vec::size() <= len; d += Vec::size()) {
+      Vec v = Vec::loadu(data + d);
+      acc = largest ? vec256::maximum(acc, v) : vec256::minimum(acc, v);
+    }
+    float buf[Vec::size()];
+    acc.store(buf);
+    for (int i = 0; i < Vec::size(); i++) {
+      if (_isnan<float>(buf[i]) ||
+          (largest ? buf[i] > cutoff : buf[i] < cutoff)) {
+        return true;
+      }
+    }
+  }
+  for (; d < len; d++) {
+    if (_isnan<float>(data[d]) ||
+        (largest ? data[d] > cutoff : data[d] < cutoff)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Single pass over a contiguous row keeping the current top-k in a small
+// sorted array. For k <= kSmallTopkSize a shift-insert into the array is
+// cheaper than heap maintenance, and once the array fills up the common case
+// per element is a single compare against the current cutoff top_v[k - 1]
+// (or, for float rows, one vector reduction per mostly-dominated chunk).
+template <typename scalar_t>
+void topk_small_k(
+    const scalar_t* row,
+    int64_t n,
+    int64_t k,
+    bool largest,
+    scalar_t* top_v,
+    int64_t* top_i) {
+  int64_t m = 0;
+  for (int64_t begin = 0; begin < n; begin += kTopkChunkSize) {
+    int64_t len = std::min(kTopkChunkSize, n - begin);
+    if (m == k && !chunk_has_candidate(row + begin, len, top_v[k - 1], largest)) {
+      continue;
+    }
+    for (int64_t j = begin; j < begin + len; j++) {
+      scalar_t v = row[j];
+      if (m == k && !topk_ranks_before(v, top_v[k - 1], largest)) {
+        continue;
+      }
+      int64_t pos = m < k ? m : k - 1;
+      while (pos > 0 && topk_ranks_before(v, top_v[pos - 1], largest)) {
+        top_v[pos] = top_v[pos - 1];
+        top_i[pos] = top_i[pos - 1];
+        pos--;
+      }
+      top_v[pos] = v;
+      top_i[pos] = j;
+      if (m < k) {
+        m++;
+      }
+    }
+  }
+}
+
 static void topk_kernel(
     Tensor& values,
     Tensor& indices,
@@ -27,6 +127,18 @@ static void topk_kernel(
           auto mode_indices = tl[2].accessor<int64_t, 1>();
 
           auto n = tmp_values.size(0);
+
+          if (k > 0 && k <= kSmallTopkSize && tmp_values.stride(0) == 1) {
+            scalar_t top_v[kSmallTopkSize];
+            int64_t top_i[kSmallTopkSize];
+            topk_small_k(tmp_values.data(), n, k, largest, top_v, top_i);
+            for (int64_t j = 0; j < k; j++) {
+              mode_values[j] = top_v[j];
+              mode_indices[j] = top_i[j];
+            }
+            return;
+          }
+
           auto use_partial_sort = k * 64 <= n;
 
           using elem_t = std::pair<scalar_t, int64_t>;
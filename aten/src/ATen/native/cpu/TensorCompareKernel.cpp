@@ -4,6 +4,8 @@
 #include <numeric>
 #include <iterator>
 #include <algorithm>
+#include <cstring>
+#include <vector>
 
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
@@ -120,10 +122,124 @@ static void where_kernel_impl(TensorIterator &iter, ScalarType condition_type) {
   });
 }
 
+// Left-packs the elements of [src, src + len) that compare greater than
+// threshold into out, returning how many were kept. out must have room for
+// len + 8 elements; the vectorized overload stores whole lanes.
+template <typename scalar_t>
+inline int64_t compact_greater(
+    const scalar_t* src,
+    int64_t len,
+    scalar_t threshold,
+    scalar_t* out) {
+  int64_t count = 0;
+  for (int64_t i = 0; i < len; i++) {
+    scalar_t v = src[i];
+    if (v > threshold) {
+      out[count++] = v;
+    }
+  }
+  return count;
+}
+
+#if defined(CPU_CAPABILITY_AVX2)
+// For each 8-bit comparison mask, the permutation that moves the selected
+// lanes to the front of the vector.
+struct FilterShuffleTable {
+  alignas(32) int32_t idx[256][8];
+  FilterShuffleTable() {
+    for (int mask = 0; mask < 256; ++mask) {
+      int k = 0;
+      for (int bit = 0; bit < 8; ++bit) {
+        if (mask & (1 << bit)) {
+          idx[mask][k++] = bit;
+        }
+      }
+      for (; k < 8; ++k) {
+        idx[mask][k] = 0;
+      }
+    }
+  }
+};
+
+inline int64_t compact_greater(
+    const float* src,
+    int64_t len,
+    float threshold,
+    float* out) {
+  static const FilterShuffleTable table;
+  const __m256 threshold_vec = _mm256_set1_ps(threshold);
+  int64_t count = 0;
+  int64_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256 v = _mm256_loadu_ps(src + i);
+    // ordered compare: NaN lanes drop out, matching the scalar `v > t`
+    int mask =
+        _mm256_movemask_ps(_mm256_cmp_ps(v, threshold_vec, _CMP_GT_OQ));
+    __m256i perm =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(table.idx[mask]));
+    _mm256_storeu_ps(out + count, _mm256_permutevar8x32_ps(v, perm));
+    count += _mm_popcnt_u32(static_cast<unsigned>(mask));
+  }
+  for (; i < len; i++) {
+    if (src[i] > threshold) {
+      out[count++] = src[i];
+    }
+  }
+  return count;
+}
+#endif
+
+static void filter_kernel_impl(
+    Tensor& result,
+    const Tensor& self,
+    Scalar threshold) {
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "filter_cpu", [&] {
+    scalar_t threshold_value = threshold.to<scalar_t>();
+    const scalar_t* src = self.data_ptr<scalar_t>();
+    int64_t numel = self.numel();
+    if (numel == 0) {
+      result.resize_({0});
+      return;
+    }
+
+    // Each chunk compacts into its own slack buffer in a single read of the
+    // data; the buffers are then stitched together with a prefix sum. The
+    // second pass only touches the selected elements.
+    int64_t chunk_size = std::max<int64_t>(
+        internal::GRAIN_SIZE, divup(numel, at::get_num_threads()));
+    int64_t n_chunks = divup(numel, chunk_size);
+    std::vector<std::vector<scalar_t>> buffers(n_chunks);
+    std::vector<int64_t> offsets(n_chunks + 1);
+    at::parallel_for(0, n_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; c++) {
+        int64_t start = c * chunk_size;
+        int64_t len = std::min(chunk_size, numel - start);
+        buffers[c].resize(len + 8);
+        offsets[c + 1] = compact_greater(
+            src + start, len, threshold_value, buffers[c].data());
+      }
+    });
+    for (int64_t c = 0; c < n_chunks; c++) {
+      offsets[c + 1] += offsets[c];
+    }
+    result.resize_({offsets[n_chunks]});
+    scalar_t* out = result.data_ptr<scalar_t>();
+    at::parallel_for(0, n_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; c++) {
+        std::memcpy(
+            out + offsets[c],
+            buffers[c].data(),
+            (offsets[c + 1] - offsets[c]) * sizeof(scalar_t));
+      }
+    });
+  });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(max_kernel, &max_kernel_impl);
 REGISTER_DISPATCH(min_kernel, &min_kernel_impl);
 REGISTER_DISPATCH(where_kernel, &where_kernel_impl);
+REGISTER_DISPATCH(filter_kernel, &filter_kernel_impl);
 
 }} // namespace at::native
@@ -16,4 +16,8 @@ DECLARE_DISPATCH(reduce_fn, min_kernel);
 using where_fn = void (*)(TensorIterator &, ScalarType);
 DECLARE_DISPATCH(where_fn, where_kernel);
 
+// (result, values, threshold): one-pass compare + compaction, see filter_cpu
+using filter_fn = void (*)(Tensor&, const Tensor&, Scalar);
+DECLARE_DISPATCH(filter_fn, filter_kernel);
+
 }} // namespace at::native
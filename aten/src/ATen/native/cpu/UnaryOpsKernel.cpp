@@ -30,7 +30,54 @@ namespace {
 
 using namespace vec256;
 
+// Shared strided loop for the vml-backed unary kernels (see also
+// IMPLEMENT_FLOAT_KERNEL below): contiguous data is handed to the vml
+// function in one batch, anything else is staged through a contiguous
+// stack buffer.
+template <typename scalar_t, typename VmlFn>
+static inline void vml_kernel_loop(TensorIterator& iter, VmlFn vop) {
+  iter.serial_for_each(
+      [&](char** data_, const int64_t* strides, int64_t n) {
+        scalar_t* out_data = reinterpret_cast<scalar_t*>(data_[0]);
+        scalar_t* in_data = reinterpret_cast<scalar_t*>(data_[1]);
+        int64_t out_stride = strides[0] / sizeof(scalar_t);
+        int64_t in_stride = strides[1] / sizeof(scalar_t);
+        if (out_stride == 1 && in_stride == 1) {
+          vop(out_data, in_data, n);
+        } else {
+          static constexpr int64_t WIDTH = 131072 / sizeof(scalar_t);
+          for (int64_t i = 0; i < n; i += WIDTH) {
+            scalar_t buffer[WIDTH];
+            int64_t width = WIDTH;
+            width = std::min(width, n - i);
+            for (int64_t j = 0; j < width; j++)
+              buffer[j] = in_data[in_stride * (i + j)];
+            vop(buffer, buffer, width);
+            for (int64_t j = 0; j < width; j++)
+              out_data[out_stride * (i + j)] = buffer[j];
+          }
+        }
+      },
+      {0, iter.numel()});
+}
+
 static void sigmoid_kernel(TensorIterator& iter) {
+  // Real types go through the vml layer for large tensors, so the exp (the
+  // expensive part) is computed by a batched MKL call when available. Below
+  // the vml parallelization grain the batch call has no room to win and its
+  // setup overhead dominates, so small tensors, and complex types (which
+  // vml does not implement), keep the Vec256 path.
+  static constexpr int64_t VML_MIN_SIZE = 2048;
+  if (isFloatingType(iter.dtype()) && iter.numel() >= VML_MIN_SIZE) {
+    TORCH_INTERNAL_ASSERT(iter.ntensors() == 2);
+    AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "sigmoid_vml_cpu", [&]() {
+      vml_kernel_loop<scalar_t>(
+          iter, [](scalar_t* out, const scalar_t* in, int64_t n) {
+            vml::vsigmoid(out, in, n);
+          });
+    });
+    return;
+  }
   AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES(iter.dtype(), "sigmoid_cpu", [&]() {
     cpu_kernel_vec(
         iter,
@@ -196,9 +243,12 @@ static void cosh_kernel(TensorIterator& iter) {
 
 static void digamma_kernel(TensorIterator& iter) {
   AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "digamma", [&]() {
+    // The series evaluation makes each element far more expensive than
+    // ordinary arithmetic, so parallelize in smaller chunks.
     cpu_kernel(
         iter,
-        [=](scalar_t a) -> scalar_t { return calc_digamma(a); });
+        [=](scalar_t a) -> scalar_t { return calc_digamma(a); },
+        internal::GRAIN_SIZE / 8);
   });
 }
 
@@ -206,7 +256,8 @@ static void trigamma_kernel(TensorIterator& iter) {
   AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "trigamma", [&]() {
     cpu_kernel(
         iter,
-        [=](scalar_t a) -> scalar_t { return trigamma(a); });
+        [=](scalar_t a) -> scalar_t { return trigamma(a); },
+        internal::GRAIN_SIZE / 8);
   });
 }
 
@@ -443,6 +494,12 @@ void normal_fill(Tensor& self, const scalar_t mean, const scalar_t std, Generato
 void normal_kernel(Tensor& self, double mean, double std, Generator* gen) {
   auto size = self.numel();
   if (self.scalar_type() == ScalarType::Float && size >= 16 && self.is_contiguous()) {
+    if (templates::philox_rng_enabled()) {
+      // opt-in parallel path; see Note [Batched Philox CPU fills]
+      templates::philox_normal_fill(
+          self, static_cast<float>(mean), static_cast<float>(std), gen);
+      return;
+    }
 #ifdef __AVX2__
     normal_fill_AVX2(self, static_cast<float>(mean), static_cast<float>(std), gen);
 #else
@@ -482,60 +539,22 @@ static void rsqrt_kernel(TensorIterator& iter) {
   static void op##_kernel(TensorIterator& iter) {                             \
     TORCH_INTERNAL_ASSERT(iter.ntensors() == 2);                              \
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), op##_vml_cpu, [&]() {            \
-      iter.serial_for_each(                                                   \
-          [&](char** data_, const int64_t* strides, int64_t n) { \
-            scalar_t* out_data = reinterpret_cast<scalar_t*>(data_[0]);       \
-            scalar_t* in_data = reinterpret_cast<scalar_t*>(data_[1]);        \
-            int64_t out_stride = strides[0] / sizeof(scalar_t);               \
-            int64_t in_stride = strides[1] / sizeof(scalar_t);                \
-            if (out_stride == 1 && in_stride == 1) {                          \
-              vml::v##op(out_data, in_data, n);                               \
-            } else {                                                          \
-              static constexpr int64_t WIDTH = 131072 / sizeof(scalar_t);     \
-              for (int64_t i = 0; i < n; i += WIDTH) {                        \
-                scalar_t buffer[WIDTH];                                       \
-                int64_t width = WIDTH;                                        \
-                width = std::min(width, n - i);                               \
-                for (int64_t j = 0; j < width; j++)                           \
-                  buffer[j] = in_data[in_stride * (i + j)];                   \
-                vml::v##op(buffer, buffer, width);                            \
-                for (int64_t j = 0; j < width; j++)                           \
-                  out_data[out_stride * (i + j)] = buffer[j];                 \
-              }                                                               \
-            }                                                                 \
-          },                                                                  \
-          {0, iter.numel()});                                                 \
+      vml_kernel_loop<scalar_t>(                                              \
+          iter, [](scalar_t* out, const scalar_t* in, int64_t n) {            \
+            vml::v##op(out, in, n);                                           \
+          });                                                                 \
     });                                                                       \
   }                                                                           \
   REGISTER_DISPATCH(op##_stub, &op##_kernel)
 
-#define IMPLEMENT_COMPLEX_KERNEL(dispatchtypes, op)                             \
+#define IMPLEMENT_COMPLEX_KERNEL(dispatchtypes, op)                           \
   static void op##_kernel(TensorIterator& iter) {                             \
     TORCH_INTERNAL_ASSERT(iter.ntensors() == 2);                              \
     AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES(iter.dtype(), op##_vml_cpu, [&]() {\
-      iter.serial_for_each(                                                   \
-          [&](char** data_, const int64_t* strides, int64_t n) {              \
-            scalar_t* out_data = reinterpret_cast<scalar_t*>(data_[0]);       \
-            scalar_t* in_data = reinterpret_cast<scalar_t*>(data_[1]);        \
-            int64_t out_stride = strides[0] / sizeof(scalar_t);               \
-            int64_t in_stride = strides[1] / sizeof(scalar_t);                \
-            if (out_stride == 1 && in_stride == 1) {                          \
-              vml::v##op(out_data, in_data, n);                               \
-            } else {                                                          \
-              static constexpr int64_t WIDTH = 131072 / sizeof(scalar_t);     \
-              for (int64_t i = 0; i < n; i += WIDTH) {                        \
-                scalar_t buffer[WIDTH];                                       \
-                int64_t width = WIDTH;                                        \
-                width = std::min(width, n - i);                               \
-                for (int64_t j = 0; j < width; j++)                           \
-                  buffer[j] = in_data[in_stride * (i + j)];                   \
-                vml::v##op(buffer, buffer, width);                            \
-                for (int64_t j = 0; j < width; j++)                           \
-                  out_data[out_stride * (i + j)] = buffer[j];                 \
-              }                                                               \
-            }                                                                 \
-          },                                                                  \
-          {0, iter.numel()});                                                 \
+      vml_kernel_loop<scalar_t>(                                              \
+          iter, [](scalar_t* out, const scalar_t* in, int64_t n) {            \
+            vml::v##op(out, in, n);                                           \
+          });                                                                 \
     });                                                                       \
   }                                                                           \
   REGISTER_DISPATCH(op##_stub, &op##_kernel)
@@ -5,6 +5,7 @@
 #include <ATen/ATen.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
 
@@ -94,6 +95,7 @@ void LayerNormBackwardKernelImplInternal(
     Tensor* dX,
     Tensor* dgamma,
     Tensor* dbeta) {
+  using Vec = vec256::Vec256<T>;
   DCHECK_EQ(dY.numel(), M * N);
   DCHECK_EQ(X.numel(), M * N);
   DCHECK_EQ(mean.numel(), M);
@@ -107,50 +109,226 @@ void LayerNormBackwardKernelImplInternal(
       gamma.defined() ? gamma.template data_ptr<T>() : nullptr;
   T* dX_data = dX->defined() ? dX->template data_ptr<T>() : nullptr;
   T* dgamma_data = dgamma->defined() ? dgamma->template data_ptr<T>() : nullptr;
-  if (dgamma_data != nullptr) {
-    std::memset(dgamma_data, 0, N * sizeof(T));
-  }
   T* dbeta_data = dbeta->defined() ? dbeta->template data_ptr<T>() : nullptr;
-  if (dbeta_data != nullptr) {
-    std::memset(dbeta_data, 0, N * sizeof(T));
-  }
   const T scale = T(1) / static_cast<T>(N);
   const bool gamma_null = gamma_data == nullptr;
-  for (int64_t i = 0; i < M; ++i) {
-    const T* dY_ptr = dY_data + i * N;
-    const T* X_ptr = X_data + i * N;
-    if (dX_data != nullptr) {
-      T* dX_ptr = dX_data + i * N;
-      T ds = 0;
-      T db = 0;
-      for (int64_t j = 0; j < N; ++j) {
-        const T gamma_v = gamma_null ? T(1) : gamma_data[j];
-        ds += dY_ptr[j] * X_ptr[j] * gamma_v;
-        db += dY_ptr[j] * gamma_v;
-      }
+
+  // dgamma and dbeta are column reductions over all rows. To parallelize
+  // over rows, each thread accumulates into its own slice of a scratch
+  // buffer, which is reduced vertically afterwards.
+  const int num_threads = at::get_num_threads();
+  Tensor buffer;
+  T* buffer_data = nullptr;
+  if (dgamma_data != nullptr || dbeta_data != nullptr) {
+    buffer = at::zeros({2 * num_threads, N}, X.options());
+    buffer_data = buffer.template data_ptr<T>();
+  }
+
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    const int tid = at::get_thread_num();
+    T* dgamma_buffer_ptr =
+        dgamma_data == nullptr ? nullptr : buffer_data + tid * N;
+    T* dbeta_buffer_ptr =
+        dbeta_data == nullptr ? nullptr : buffer_data + (num_threads + tid) * N;
+    for (int64_t i = start; i < end; ++i) {
+      const T* dY_ptr = dY_data + i * N;
+      const T* X_ptr = X_data + i * N;
       const T a = rstd_data[i];
-      const T b = (db * mean_data[i] - ds) * a * a * a * scale;
-      const T c = -b * mean_data[i] - db * a * scale;
-      for (int64_t j = 0; j < N; ++j) {
-        const T gamma_v = gamma_null ? T(1) : gamma_data[j];
-        dX_ptr[j] = a * dY_ptr[j] * gamma_v + b * X_ptr[j] + c;
+      const T mean_v = mean_data[i];
+
+      if (dX_data != nullptr) {
+        T* dX_ptr = dX_data + i * N;
+        T ds = 0;
+        T db = 0;
+        Vec ds_vec(0);
+        Vec db_vec(0);
+        int64_t j = 0;
+        for (; j + Vec::size() <= N; j += Vec::size()) {
+          const Vec dy_vec = Vec::loadu(dY_ptr + j);
+          const Vec x_vec = Vec::loadu(X_ptr + j);
+          const Vec dyg_vec =
+              gamma_null ? dy_vec : dy_vec * Vec::loadu(gamma_data + j);
+          ds_vec = vec256::fmadd(dyg_vec, x_vec, ds_vec);
+          db_vec = db_vec + dyg_vec;
+        }
+        ds = vec256::vec_reduce_all<T>(
+            [](Vec& x, Vec& y) { return x + y; }, ds_vec, Vec::size());
+        db = vec256::vec_reduce_all<T>(
+            [](Vec& x, Vec& y) { return x + y; }, db_vec, Vec::size());
+        for (; j < N; ++j) {
+          const T dy_g = gamma_null ? dY_ptr[j] : dY_ptr[j] * gamma_data[j];
+          ds += dy_g * X_ptr[j];
+          db += dy_g;
+        }
+        const T b = (db * mean_v - ds) * a * a * a * scale;
+        const T c = -b * mean_v - db * a * scale;
+        const Vec a_vec(a);
+        const Vec b_vec(b);
+        const Vec c_vec(c);
+        j = 0;
+        for (; j + Vec::size() <= N; j += Vec::size()) {
+          const Vec dy_vec = Vec::loadu(dY_ptr + j);
+          const Vec x_vec = Vec::loadu(X_ptr + j);
+          const Vec dyg_vec =
+              gamma_null ? dy_vec : dy_vec * Vec::loadu(gamma_data + j);
+          const Vec dx_vec =
+              vec256::fmadd(a_vec, dyg_vec, vec256::fmadd(b_vec, x_vec, c_vec));
+          dx_vec.store(dX_ptr + j);
+        }
+        for (; j < N; ++j) {
+          const T dy_g = gamma_null ? dY_ptr[j] : dY_ptr[j] * gamma_data[j];
+          dX_ptr[j] = a * dy_g + b * X_ptr[j] + c;
+        }
       }
-    }
-    if (dgamma_data != nullptr) {
-      const T a = rstd_data[i];
-      const T b = -a * mean_data[i];
-      for (int64_t j = 0; j < N; ++j) {
-        dgamma_data[j] += dY_ptr[j] * (a * X_ptr[j] + b);
+
+      if (dgamma_buffer_ptr != nullptr) {
+        const T b = -a * mean_v;
+        const Vec a_vec(a);
+        const Vec b_vec(b);
+        int64_t j = 0;
+        for (; j + Vec::size() <= N; j += Vec::size()) {
+          const Vec dy_vec = Vec::loadu(dY_ptr + j);
+          const Vec xhat_vec =
+              vec256::fmadd(a_vec, Vec::loadu(X_ptr + j), b_vec);
+          const Vec acc_vec = vec256::fmadd(
+              dy_vec, xhat_vec, Vec::loadu(dgamma_buffer_ptr + j));
+          acc_vec.store(dgamma_buffer_ptr + j);
+        }
+        for (; j < N; ++j) {
+          dgamma_buffer_ptr[j] += dY_ptr[j] * (a * X_ptr[j] + b);
+        }
       }
-    }
-    if (dbeta_data != nullptr) {
-      for (int64_t j = 0; j < N; ++j) {
-        dbeta_data[j] += dY_ptr[j];
+
+      if (dbeta_buffer_ptr != nullptr) {
+        int64_t j = 0;
+        for (; j + Vec::size() <= N; j += Vec::size()) {
+          const Vec acc_vec =
+              Vec::loadu(dbeta_buffer_ptr + j) + Vec::loadu(dY_ptr + j);
+          acc_vec.store(dbeta_buffer_ptr + j);
+        }
+        for (; j < N; ++j) {
+          dbeta_buffer_ptr[j] += dY_ptr[j];
+        }
       }
     }
+  });
+
+  if (buffer_data != nullptr) {
+    at::parallel_for(0, N, 1, [&](int64_t start, int64_t end) {
+      for (int64_t j = start; j < end; ++j) {
+        T dgamma_v = 0;
+        T dbeta_v = 0;
+        for (int64_t t = 0; t < num_threads; ++t) {
+          dgamma_v += buffer_data[t * N + j];
+          dbeta_v += buffer_data[(num_threads + t) * N + j];
+        }
+        if (dgamma_data != nullptr) {
+          dgamma_data[j] = dgamma_v;
+        }
+        if (dbeta_data != nullptr) {
+          dbeta_data[j] = dbeta_v;
+        }
+      }
+    });
   }
 }
 
+template <typename T>
+void EmbeddingLayerNormKernelImplInternal(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& positional,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    T eps,
+    Tensor* Y) {
+  using Vec = vec256::Vec256<T>;
+  DCHECK_EQ(indices.numel(), M);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  const T* weight_data = weight.data_ptr<T>();
+  const int64_t* indices_data = indices.data_ptr<int64_t>();
+  const T* pos_data = positional.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* Y_data = Y->data_ptr<T>();
+  const int64_t num_weights = weight.size(0);
+  const int64_t P = positional.numel() / N;
+  const T c = T(1) / static_cast<T>(N);
+  const bool gamma_null = gamma_data == nullptr;
+  const bool beta_null = beta_data == nullptr;
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t idx = indices_data[i];
+      TORCH_CHECK(
+          idx >= 0 && idx < num_weights,
+          "embedding_layernorm: index out of range, got ",
+          idx);
+      const T* W_ptr = weight_data + idx * N;
+      const T* P_ptr = pos_data + (i % P) * N;
+      T* Y_ptr = Y_data + i * N;
+      // One streaming pass computes x = w + p, stashes it in the output row,
+      // and accumulates the moments needed for the normalization below.
+      Vec sum_vec(0);
+      Vec sumsq_vec(0);
+      int64_t j = 0;
+      for (; j + Vec::size() <= N; j += Vec::size()) {
+        const Vec x_vec = Vec::loadu(W_ptr + j) + Vec::loadu(P_ptr + j);
+        x_vec.store(Y_ptr + j);
+        sum_vec = sum_vec + x_vec;
+        sumsq_vec = vec256::fmadd(x_vec, x_vec, sumsq_vec);
+      }
+      T mean_val = vec256::vec_reduce_all<T>(
+          [](Vec& x, Vec& y) { return x + y; }, sum_vec, Vec::size());
+      T rstd_val = vec256::vec_reduce_all<T>(
+          [](Vec& x, Vec& y) { return x + y; }, sumsq_vec, Vec::size());
+      for (; j < N; ++j) {
+        const T x = W_ptr[j] + P_ptr[j];
+        Y_ptr[j] = x;
+        mean_val += x;
+        rstd_val += x * x;
+      }
+      mean_val *= c;
+      rstd_val = std::max(rstd_val * c - mean_val * mean_val, T(0));
+      rstd_val = T(1) / std::sqrt(rstd_val + eps);
+      const T scale = rstd_val;
+      const T bias = -rstd_val * mean_val;
+      for (j = 0; j < N; ++j) {
+        const T gamma_v = gamma_null ? T(1) : gamma_data[j];
+        const T beta_v = beta_null ? T(0) : beta_data[j];
+        Y_ptr[j] = (Y_ptr[j] * scale + bias) * gamma_v + beta_v;
+      }
+    }
+  });
+}
+
+void EmbeddingLayerNormKernelImpl(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& positional,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    double eps,
+    Tensor* Y) {
+  AT_DISPATCH_FLOATING_TYPES(
+      weight.scalar_type(), "EmbeddingLayerNormKernelImpl", [&]() {
+        EmbeddingLayerNormKernelImplInternal<scalar_t>(
+            weight,
+            indices,
+            positional,
+            gamma,
+            beta,
+            M,
+            N,
+            static_cast<scalar_t>(eps),
+            Y);
+      });
+}
+
 void LayerNormBackwardKernelImpl(
     const Tensor& dY,
     const Tensor& X,
@@ -173,6 +351,7 @@ void LayerNormBackwardKernelImpl(
 
 REGISTER_DISPATCH(LayerNormKernel, &LayerNormKernelImpl);
 REGISTER_DISPATCH(LayerNormBackwardKernel, &LayerNormBackwardKernelImpl);
+REGISTER_DISPATCH(EmbeddingLayerNormKernel, &EmbeddingLayerNormKernelImpl);
 
 } // namespace native
 } // namespace at
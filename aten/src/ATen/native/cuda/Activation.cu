@@ -384,6 +384,31 @@ void GeluBackwardCUDAKernelImpl(TensorIterator& it) {
       });
 }
 
+void addmm_activation_kernel(
+    TensorIterator& iter,
+    Scalar alpha,
+    Scalar beta,
+    bool use_gelu) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(iter.dtype(), "addmm_activation_cuda", [&]() {
+    using T_ACC = acc_type<scalar_t, true>;
+    const T_ACC alpha_val = alpha.to<T_ACC>();
+    const T_ACC beta_val = beta.to<T_ACC>();
+    if (use_gelu) {
+      gpu_kernel(iter, [alpha_val, beta_val]GPU_LAMBDA(scalar_t a, scalar_t b) -> scalar_t {
+        const T_ACC x =
+            alpha_val * static_cast<T_ACC>(a) + beta_val * static_cast<T_ACC>(b);
+        return x * c10::cuda::compat::normcdf(x);
+      });
+    } else {
+      gpu_kernel(iter, [alpha_val, beta_val]GPU_LAMBDA(scalar_t a, scalar_t b) -> scalar_t {
+        const T_ACC x =
+            alpha_val * static_cast<T_ACC>(a) + beta_val * static_cast<T_ACC>(b);
+        return x > T_ACC(0) ? x : T_ACC(0);
+      });
+    }
+  });
+}
+
 void leaky_relu_kernel(TensorIterator& iter, Scalar negval_) {
   AT_DISPATCH_FLOATING_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16, iter.dtype(), "leaky_relu_cuda", [&]() {
     AT_SKIP_BFLOAT16_IF_NOT_ROCM(scalar_t, "leaky_relu_cuda", [&] {
@@ -464,5 +489,6 @@ REGISTER_DISPATCH(leaky_relu_stub, &leaky_relu_kernel);
 REGISTER_DISPATCH(leaky_relu_backward_stub, &leaky_relu_backward_kernel);
 REGISTER_DISPATCH(softplus_stub, &softplus_kernel);
 REGISTER_DISPATCH(softplus_backward_stub, &softplus_backward_kernel);
+REGISTER_DISPATCH(addmm_activation_stub, &addmm_activation_kernel);
 
 }}  // namespace at::native
@@ -214,6 +214,32 @@ inline int can_vectorize_up_to(array_t pointers) {
   return result;
 }
 
+// Host-side detection of the "innermost-contiguous with broadcast scalar"
+// pattern: the output and some inputs are contiguous in the inner dim and
+// the remaining inputs have inner stride 0 (e.g. a 0-dim tensor broadcast
+// against a contiguous one). Returns a bitmask of the stride-0 inputs, or
+// -1 when the pattern does not apply.
+template <typename traits, typename array_t, std::size_t... I>
+inline int broadcast_scalar_mask_impl(const array_t &strides, std::index_sequence<I...>) {
+  if (strides[0] != sizeof(typename traits::result_type)) {
+    return -1;
+  }
+  int mask = 0;
+  bool ok = true;
+  (void)std::initializer_list<int>{
+      (strides[I + 1] == sizeof(typename traits::template arg<I>::type)
+           ? 0
+           : strides[I + 1] == 0 ? (mask |= (1 << I), 0) : (ok = false, 0))...};
+  return (ok && mask != 0) ? mask : -1;
+}
+
+template <typename func_t, typename array_t>
+inline int broadcast_scalar_mask(const array_t &strides) {
+  using traits = function_traits<func_t>;
+  return broadcast_scalar_mask_impl<traits>(
+      strides, std::make_index_sequence<traits::arity>{});
+}
+
 }  // namespace detail
 
 template<int i>
@@ -310,6 +336,81 @@ static void launch_kernel(int64_t N, const func_t& f, array_t data) {
   AT_CUDA_CHECK(cudaGetLastError());
 }
 
+// Loads argument i either once (its bit is set in the compile-time
+// broadcast_mask, i.e. its inner stride is 0) or at the linear index. The
+// mask test folds at compile time, so the specialized kernel has no
+// per-element stride or offset arithmetic at all.
+template<int broadcast_mask>
+struct load_maybe_broadcast {
+  template<int i>
+  struct arg {
+    template <typename args_t, typename array_t>
+    static __device__ void apply(args_t &args, array_t data, int linear_idx) {
+      using arg_t = std::tuple_element_t<i, args_t>;
+      auto *base = reinterpret_cast<arg_t *>(data[i + 1]);
+      std::get<i>(args) =
+          ((broadcast_mask & (1 << i)) != 0) ? *base : base[linear_idx];
+    }
+  };
+};
+
+template<int broadcast_mask, typename func_t, typename array_t>
+C10_LAUNCH_BOUNDS_1(num_threads)
+__global__ void broadcast_elementwise_kernel(int N, func_t f, array_t data) {
+  using traits = function_traits<func_t>;
+  using return_t = typename traits::result_type;
+  using args_t = typename traits::ArgsTuple;
+  constexpr int arity = traits::arity;
+
+  int base_idx = block_work_size * blockIdx.x;
+  return_t *out = reinterpret_cast<return_t *>(data[0]);
+  #pragma unroll
+  for (int i = 0; i < thread_work_size; i++) {
+    int linear_idx = base_idx + threadIdx.x + i * num_threads;
+    if (linear_idx < N) {
+      args_t args;
+      detail::static_unroll<
+          load_maybe_broadcast<broadcast_mask>::template arg, arity>::
+          with_args(args, data, linear_idx);
+      out[linear_idx] = c10::guts::apply(f, args);
+    }
+  }
+}
+
+// Speculative host-side specialization for innermost-contiguous iterators
+// with broadcast scalar inputs (the other dominant elementwise shape next
+// to all-contiguous). Only unary/binary masks are instantiated; returns
+// false to bail out to the stride-multiplying legacy kernel otherwise.
+template<typename func_t, typename array_t>
+static bool launch_broadcast_kernel(int64_t N, const func_t& f, array_t data, int broadcast_mask) {
+  using traits = function_traits<func_t>;
+  TORCH_INTERNAL_ASSERT(N >= 0 && N <= std::numeric_limits<int32_t>::max());
+  if (traits::arity > 2 || broadcast_mask <= 0 ||
+      broadcast_mask >= (1 << traits::arity)) {
+    return false;
+  }
+  if (N == 0) {
+    return true;
+  }
+  int64_t grid = (N + block_work_size - 1) / block_work_size;
+  auto stream = at::cuda::getCurrentCUDAStream();
+  switch (broadcast_mask) {
+  case 1:
+    broadcast_elementwise_kernel<1, func_t, array_t><<<grid, num_threads, 0, stream>>>(N, f, data);
+    break;
+  case 2:
+    broadcast_elementwise_kernel<2, func_t, array_t><<<grid, num_threads, 0, stream>>>(N, f, data);
+    break;
+  case 3:
+    broadcast_elementwise_kernel<3, func_t, array_t><<<grid, num_threads, 0, stream>>>(N, f, data);
+    break;
+  default:
+    return false;
+  }
+  AT_CUDA_CHECK(cudaGetLastError());
+  return true;
+}
+
 } // namespace modern
 
 
@@ -349,6 +450,13 @@ void gpu_kernel_impl(TensorIterator& iter, const func_t& f) {
     } else if (iter.has_contiguous_first_dim()) {
       modern::launch_kernel(numel, f, data);
     } else {
+      // Not fully contiguous; speculate on the broadcast-scalar shape
+      // before paying for per-element stride arithmetic.
+      const int broadcast_mask = modern::detail::broadcast_scalar_mask<func_t>(strides);
+      if (broadcast_mask > 0 &&
+          modern::launch_broadcast_kernel(numel, f, data, broadcast_mask)) {
+        return;
+      }
       legacy::launch_kernel<launch_size_1d, 1>(numel, [=]GPU_LAMBDA(int idx) {
         arg0_t* out = (arg0_t*)(data[0] + strides[0] * idx);
         *out = legacy::invoke(f, &data.data[1], &strides.data[1], idx);
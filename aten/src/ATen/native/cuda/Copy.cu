@@ -40,13 +40,15 @@ void copy_device_to_device(TensorIterator& iter, bool non_blocking) {
     // before the copy. This ensures that any write-after-write and
     // write-after-read dependencies on the destination side are handled, so
     // that no one is operating on the dst memory when we perform the copy.
-    // src waits on dst barrier (src already waits on src)
-    CUDAEvent dst_ready;
+    // src waits on dst barrier (src already waits on src). The events come
+    // from a freelist since this runs once per copy and event
+    // creation/destruction is comparatively expensive.
+    auto dst_ready = getCUDAEventPool().acquire(dst_device.index());
     device_guard.set_device(dst_device);
-    dst_ready.record(getCurrentCUDAStream(dst_device.index()));
+    dst_ready.event().record(getCurrentCUDAStream(dst_device.index()));
 
     device_guard.set_device(src_device);
-    dst_ready.block(copy_stream);
+    dst_ready.event().block(copy_stream);
   }
 
   if (memcpy_eligible) {
@@ -68,11 +70,11 @@ void copy_device_to_device(TensorIterator& iter, bool non_blocking) {
     // operate on dst's copy until the copy is complete.
 
     // Still on src_device, record stream event
-    CUDAEvent src_ready;
-    src_ready.record(copy_stream);
+    auto src_ready = getCUDAEventPool().acquire(src_device.index());
+    src_ready.event().record(copy_stream);
 
     device_guard.set_device(dst_device);
-    src_ready.block(getCurrentCUDAStream(dst_device.index()));
+    src_ready.event().block(getCurrentCUDAStream(dst_device.index()));
   }
 
   AT_CUDA_CHECK(cudaGetLastError());
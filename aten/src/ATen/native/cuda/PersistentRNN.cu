@@ -0,0 +1,431 @@
+#include <ATen/native/cuda/PersistentRNN.h>
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/Exceptions.h>
+
+#include <cooperative_groups.h>
+
+#include <algorithm>
+#include <vector>
+
+// Persistent-kernel RNN decode for small batches.
+//
+// cuDNN's RNN kernels are tuned for large batches; at batch <= 4 a decode
+// step is dominated by kernel launch and weight re-read overhead, since a
+// fresh GEMM is launched per timestep and layer. The kernels below instead
+// process the entire sequence of one layer in a single cooperative launch:
+// each thread owns one (batch, hidden unit) pair, keeps its cell state in a
+// register across all timesteps, stages x_t and h_{t-1} in shared memory,
+// and a grid-wide sync separates timesteps. The weight rows a thread reads
+// stay resident in cache for the whole sequence because no other kernel
+// runs in between.
+//
+// The gate dot products are computed by a single thread each, so this only
+// wins when the per-timestep math is small - which is exactly the
+// batch <= 4, hidden <= 1024 regime this path is restricted to.
+
+namespace at {
+namespace native {
+
+namespace {
+
+constexpr int kPersistentMaxBatch = 4;
+constexpr int kPersistentMaxHidden = 1024;
+constexpr int kPersistentMaxInput = 1024;
+constexpr int kPersistentThreads = 256;
+
+__device__ __forceinline__ float sigmoid_(float x) {
+  return 1.0f / (1.0f + expf(-x));
+}
+
+// h_buf is double-buffered ([2, B, H], buffer 0 holds h_0) so that one
+// grid.sync() per timestep suffices: at step t every thread reads the
+// staged copy of h_buf[t & 1] and writes h_buf[(t + 1) & 1].
+__global__ void persistent_lstm_kernel(
+    const float* __restrict__ input, // [T, B, I]
+    const float* __restrict__ w_ih, // [4H, I], gate order i, f, g, o
+    const float* __restrict__ w_hh, // [4H, H]
+    const float* __restrict__ b_ih, // [4H] or nullptr
+    const float* __restrict__ b_hh, // [4H] or nullptr
+    float* __restrict__ h_buf, // [2, B, H]
+    float* __restrict__ c_state, // [B, H], c_0 on entry, c_T on exit
+    float* __restrict__ output, // [T, B, H]
+    int T,
+    int B,
+    int I,
+    int H) {
+  cooperative_groups::grid_group grid = cooperative_groups::this_grid();
+  extern __shared__ float smem[];
+  float* x_sh = smem; // B * I
+  float* h_sh = smem + B * I; // B * H
+
+  const int tid = blockIdx.x * blockDim.x + threadIdx.x;
+  const int b = tid / H;
+  const int u = tid - b * H;
+  const bool active = tid < B * H;
+
+  // The cell state never leaves this register for the whole sequence.
+  float c = active ? c_state[tid] : 0.0f;
+
+  for (int t = 0; t < T; ++t) {
+    const float* h_prev = h_buf + (t & 1) * B * H;
+    float* h_next = h_buf + ((t + 1) & 1) * B * H;
+    const float* x_t = input + static_cast<int64_t>(t) * B * I;
+    for (int i = threadIdx.x; i < B * I; i += blockDim.x) {
+      x_sh[i] = x_t[i];
+    }
+    for (int i = threadIdx.x; i < B * H; i += blockDim.x) {
+      h_sh[i] = h_prev[i];
+    }
+    __syncthreads();
+
+    if (active) {
+      const float* x_b = x_sh + b * I;
+      const float* h_b = h_sh + b * H;
+      float gates[4];
+#pragma unroll
+      for (int g = 0; g < 4; ++g) {
+        const int row = g * H + u;
+        const float* wi = w_ih + static_cast<int64_t>(row) * I;
+        const float* wh = w_hh + static_cast<int64_t>(row) * H;
+        float acc = b_ih != nullptr ? b_ih[row] + b_hh[row] : 0.0f;
+        for (int k = 0; k < I; ++k) {
+          acc += wi[k] * x_b[k];
+        }
+        for (int k = 0; k < H; ++k) {
+          acc += wh[k] * h_b[k];
+        }
+        gates[g] = acc;
+      }
+      const float in_gate = sigmoid_(gates[0]);
+      const float forget_gate = sigmoid_(gates[1]);
+      const float cell_gate = tanhf(gates[2]);
+      const float out_gate = sigmoid_(gates[3]);
+      c = forget_gate * c + in_gate * cell_gate;
+      const float h = out_gate * tanhf(c);
+      h_next[tid] = h;
+      output[static_cast<int64_t>(t) * B * H + tid] = h;
+    }
+    grid.sync();
+  }
+  if (active) {
+    c_state[tid] = c;
+  }
+}
+
+__global__ void persistent_gru_kernel(
+    const float* __restrict__ input, // [T, B, I]
+    const float* __restrict__ w_ih, // [3H, I], gate order r, z, n
+    const float* __restrict__ w_hh, // [3H, H]
+    const float* __restrict__ b_ih, // [3H] or nullptr
+    const float* __restrict__ b_hh, // [3H] or nullptr
+    float* __restrict__ h_buf, // [2, B, H]
+    float* __restrict__ output, // [T, B, H]
+    int T,
+    int B,
+    int I,
+    int H) {
+  cooperative_groups::grid_group grid = cooperative_groups::this_grid();
+  extern __shared__ float smem[];
+  float* x_sh = smem; // B * I
+  float* h_sh = smem + B * I; // B * H
+
+  const int tid = blockIdx.x * blockDim.x + threadIdx.x;
+  const int b = tid / H;
+  const int u = tid - b * H;
+  const bool active = tid < B * H;
+
+  for (int t = 0; t < T; ++t) {
+    const float* h_prev = h_buf + (t & 1) * B * H;
+    float* h_next = h_buf + ((t + 1) & 1) * B * H;
+    const float* x_t = input + static_cast<int64_t>(t) * B * I;
+    for (int i = threadIdx.x; i < B * I; i += blockDim.x) {
+      x_sh[i] = x_t[i];
+    }
+    for (int i = threadIdx.x; i < B * H; i += blockDim.x) {
+      h_sh[i] = h_prev[i];
+    }
+    __syncthreads();
+
+    if (active) {
+      const float* x_b = x_sh + b * I;
+      const float* h_b = h_sh + b * H;
+      // The reset gate scales only the hidden contribution of n, so the
+      // input and hidden halves are accumulated separately.
+      float ig[3];
+      float hg[3];
+#pragma unroll
+      for (int g = 0; g < 3; ++g) {
+        const int row = g * H + u;
+        const float* wi = w_ih + static_cast<int64_t>(row) * I;
+        const float* wh = w_hh + static_cast<int64_t>(row) * H;
+        float acc_i = b_ih != nullptr ? b_ih[row] : 0.0f;
+        float acc_h = b_hh != nullptr ? b_hh[row] : 0.0f;
+        for (int k = 0; k < I; ++k) {
+          acc_i += wi[k] * x_b[k];
+        }
+        for (int k = 0; k < H; ++k) {
+          acc_h += wh[k] * h_b[k];
+        }
+        ig[g] = acc_i;
+        hg[g] = acc_h;
+      }
+      const float reset_gate = sigmoid_(ig[0] + hg[0]);
+      const float update_gate = sigmoid_(ig[1] + hg[1]);
+      const float new_gate = tanhf(ig[2] + reset_gate * hg[2]);
+      const float h = (1.0f - update_gate) * new_gate + update_gate * h_b[u];
+      h_next[tid] = h;
+      output[static_cast<int64_t>(t) * B * H + tid] = h;
+    }
+    grid.sync();
+  }
+}
+
+struct CellWeights {
+  Tensor w_ih;
+  Tensor w_hh;
+  Tensor b_ih; // undefined when has_biases is false
+  Tensor b_hh;
+};
+
+std::vector<CellWeights> gather_cell_weights(
+    TensorList params,
+    bool has_biases,
+    int64_t num_layers) {
+  std::vector<CellWeights> result;
+  result.reserve(num_layers);
+  const int64_t stride = has_biases ? 4 : 2;
+  for (int64_t l = 0; l < num_layers; ++l) {
+    CellWeights w;
+    w.w_ih = params[l * stride].contiguous();
+    w.w_hh = params[l * stride + 1].contiguous();
+    if (has_biases) {
+      w.b_ih = params[l * stride + 2].contiguous();
+      w.b_hh = params[l * stride + 3].contiguous();
+    }
+    result.push_back(std::move(w));
+  }
+  return result;
+}
+
+// Common applicability checks; also computes the launch configuration.
+bool persistent_rnn_viable(
+    const Tensor& input,
+    const Tensor& hx,
+    bool train,
+    bool bidirectional,
+    const void* kernel,
+    int64_t* grid_blocks_out,
+    int64_t* smem_bytes_out) {
+  if (train || bidirectional) {
+    return false;
+  }
+  if (input.scalar_type() != kFloat || input.dim() != 3) {
+    return false;
+  }
+  const int64_t T = input.size(0);
+  const int64_t B = input.size(1);
+  const int64_t I = input.size(2);
+  const int64_t H = hx.size(2);
+  if (T == 0 || B == 0 || B > kPersistentMaxBatch ||
+      H > kPersistentMaxHidden || I > kPersistentMaxInput) {
+    return false;
+  }
+  auto* prop = at::cuda::getCurrentDeviceProperties();
+  if (!prop->cooperativeLaunch) {
+    return false;
+  }
+  // Both layer input (size I) and hidden (size H) are staged per block;
+  // deeper layers have input size H <= kPersistentMaxHidden.
+  const int64_t smem_bytes =
+      B * (std::max(I, H) + H) * static_cast<int64_t>(sizeof(float));
+  if (smem_bytes > static_cast<int64_t>(prop->sharedMemPerBlock)) {
+    return false;
+  }
+  const int64_t grid_blocks =
+      (B * H + kPersistentThreads - 1) / kPersistentThreads;
+  // A cooperative launch requires every block to be resident at once.
+  int blocks_per_sm = 0;
+  AT_CUDA_CHECK(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+      &blocks_per_sm,
+      kernel,
+      kPersistentThreads,
+      static_cast<size_t>(smem_bytes)));
+  if (static_cast<int64_t>(blocks_per_sm) * prop->multiProcessorCount <
+      grid_blocks) {
+    return false;
+  }
+  *grid_blocks_out = grid_blocks;
+  *smem_bytes_out = smem_bytes;
+  return true;
+}
+
+} // namespace
+
+bool persistent_lstm_cuda(
+    Tensor& output,
+    Tensor& hy,
+    Tensor& cy,
+    const Tensor& input,
+    const Tensor& hx,
+    const Tensor& cx,
+    TensorList params,
+    bool has_biases,
+    int64_t num_layers,
+    bool train,
+    bool bidirectional) {
+  int64_t grid_blocks = 0;
+  int64_t smem_bytes = 0;
+  if (!persistent_rnn_viable(
+          input,
+          hx,
+          train,
+          bidirectional,
+          reinterpret_cast<const void*>(&persistent_lstm_kernel),
+          &grid_blocks,
+          &smem_bytes)) {
+    return false;
+  }
+  const int64_t T = input.size(0);
+  const int64_t B = input.size(1);
+  const int64_t H = hx.size(2);
+
+  auto weights = gather_cell_weights(params, has_biases, num_layers);
+  auto options = input.options();
+  output = at::empty({T, B, H}, options);
+  hy = at::empty({num_layers, B, H}, options);
+  cy = at::empty({num_layers, B, H}, options);
+  cy.copy_(cx); // the kernel updates the cell state in place
+  auto h_buf = at::empty({2, B, H}, options);
+  auto stream = at::cuda::getCurrentCUDAStream();
+
+  Tensor layer_input = input.contiguous();
+  for (int64_t l = 0; l < num_layers; ++l) {
+    const auto& w = weights[l];
+    h_buf[0].copy_(hx[l]);
+    Tensor layer_output =
+        l == num_layers - 1 ? output : at::empty({T, B, H}, options);
+
+    const float* input_ptr = layer_input.data_ptr<float>();
+    const float* w_ih_ptr = w.w_ih.data_ptr<float>();
+    const float* w_hh_ptr = w.w_hh.data_ptr<float>();
+    const float* b_ih_ptr =
+        has_biases ? w.b_ih.data_ptr<float>() : nullptr;
+    const float* b_hh_ptr =
+        has_biases ? w.b_hh.data_ptr<float>() : nullptr;
+    float* h_buf_ptr = h_buf.data_ptr<float>();
+    float* c_ptr = cy.data_ptr<float>() + l * B * H;
+    float* output_ptr = layer_output.data_ptr<float>();
+    int T_arg = T;
+    int B_arg = B;
+    int I_arg = layer_input.size(2);
+    int H_arg = H;
+    void* args[] = {
+        &input_ptr,
+        &w_ih_ptr,
+        &w_hh_ptr,
+        &b_ih_ptr,
+        &b_hh_ptr,
+        &h_buf_ptr,
+        &c_ptr,
+        &output_ptr,
+        &T_arg,
+        &B_arg,
+        &I_arg,
+        &H_arg};
+    AT_CUDA_CHECK(cudaLaunchCooperativeKernel(
+        reinterpret_cast<const void*>(&persistent_lstm_kernel),
+        dim3(static_cast<unsigned int>(grid_blocks)),
+        dim3(kPersistentThreads),
+        args,
+        static_cast<size_t>(smem_bytes),
+        stream));
+
+    hy[l].copy_(h_buf[T % 2]);
+    layer_input = std::move(layer_output);
+  }
+  return true;
+}
+
+bool persistent_gru_cuda(
+    Tensor& output,
+    Tensor& hy,
+    const Tensor& input,
+    const Tensor& hx,
+    TensorList params,
+    bool has_biases,
+    int64_t num_layers,
+    bool train,
+    bool bidirectional) {
+  int64_t grid_blocks = 0;
+  int64_t smem_bytes = 0;
+  if (!persistent_rnn_viable(
+          input,
+          hx,
+          train,
+          bidirectional,
+          reinterpret_cast<const void*>(&persistent_gru_kernel),
+          &grid_blocks,
+          &smem_bytes)) {
+    return false;
+  }
+  const int64_t T = input.size(0);
+  const int64_t B = input.size(1);
+  const int64_t H = hx.size(2);
+
+  auto weights = gather_cell_weights(params, has_biases, num_layers);
+  auto options = input.options();
+  output = at::empty({T, B, H}, options);
+  hy = at::empty({num_layers, B, H}, options);
+  auto h_buf = at::empty({2, B, H}, options);
+  auto stream = at::cuda::getCurrentCUDAStream();
+
+  Tensor layer_input = input.contiguous();
+  for (int64_t l = 0; l < num_layers; ++l) {
+    const auto& w = weights[l];
+    h_buf[0].copy_(hx[l]);
+    Tensor layer_output =
+        l == num_layers - 1 ? output : at::empty({T, B, H}, options);
+
+    const float* input_ptr = layer_input.data_ptr<float>();
+    const float* w_ih_ptr = w.w_ih.data_ptr<float>();
+    const float* w_hh_ptr = w.w_hh.data_ptr<float>();
+    const float* b_ih_ptr =
+        has_biases ? w.b_ih.data_ptr<float>() : nullptr;
+    const float* b_hh_ptr =
+        has_biases ? w.b_hh.data_ptr<float>() : nullptr;
+    float* h_buf_ptr = h_buf.data_ptr<float>();
+    float* output_ptr = layer_output.data_ptr<float>();
+    int T_arg = T;
+    int B_arg = B;
+    int I_arg = layer_input.size(2);
+    int H_arg = H;
+    void* args[] = {
+        &input_ptr,
+        &w_ih_ptr,
+        &w_hh_ptr,
+        &b_ih_ptr,
+        &b_hh_ptr,
+        &h_buf_ptr,
+        &output_ptr,
+        &T_arg,
+        &B_arg,
+        &I_arg,
+        &H_arg};
+    AT_CUDA_CHECK(cudaLaunchCooperativeKernel(
+        reinterpret_cast<const void*>(&persistent_gru_kernel),
+        dim3(static_cast<unsigned int>(grid_blocks)),
+        dim3(kPersistentThreads),
+        args,
+        static_cast<size_t>(smem_bytes),
+        stream));
+
+    hy[l].copy_(h_buf[T % 2]);
+    layer_input = std::move(layer_output);
+  }
+  return true;
+}
+
+} // namespace native
+} // namespace at
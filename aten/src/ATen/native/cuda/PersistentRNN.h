@@ -0,0 +1,39 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at {
+namespace native {
+
+// Persistent-kernel LSTM/GRU decode for small batches (see PersistentRNN.cu).
+// input must be seq-major [T, B, I]. Both functions check their own
+// applicability (inference only, unidirectional, fp32, batch <= 4,
+// sizes <= 1024, cooperative launch support) and return false without
+// touching the outputs when the case is not supported, so callers can
+// fall through to cuDNN.
+TORCH_CUDA_API bool persistent_lstm_cuda(
+    Tensor& output,
+    Tensor& hy,
+    Tensor& cy,
+    const Tensor& input,
+    const Tensor& hx,
+    const Tensor& cx,
+    TensorList params,
+    bool has_biases,
+    int64_t num_layers,
+    bool train,
+    bool bidirectional);
+
+TORCH_CUDA_API bool persistent_gru_cuda(
+    Tensor& output,
+    Tensor& hy,
+    const Tensor& input,
+    const Tensor& hx,
+    TensorList params,
+    bool has_biases,
+    int64_t num_layers,
+    bool train,
+    bool bidirectional);
+
+} // namespace native
+} // namespace at
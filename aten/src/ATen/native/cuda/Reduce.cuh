@@ -10,12 +10,14 @@
 #include <THC/THCGeneral.hpp>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cuda/Loops.cuh>
+#include <ATen/native/cuda/ReduceAutotune.h>
 #include <c10/macros/Macros.h>
 #include <c10/cuda/CUDACachingAllocator.h>
 #include <functional>
 #include <iosfwd>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 #include <thrust/tuple.h>
 
@@ -37,6 +39,16 @@ static inline int last_pow2(int n) {
   return std::max(1, n - (n >> 1));
 }
 
+// returns floor(log2(n)); buckets autotuning keys by shape class
+static inline int log2_bucket(int64_t n) {
+  int bucket = 0;
+  while (n > 1) {
+    n >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
 // returns reduced fraction numerator & denominator
 C10_HOST_DEVICE static void reduce_fraction(size_t &numerator, size_t &denominator) {
   // get GCD of num and denom using Euclid's algorithm.
@@ -81,12 +93,12 @@ struct ReduceConfig {
   int block_height;
   int num_threads;
 
-  void set_block_dimension(int64_t dim0, int64_t dim1) {
-    int dim0_pow2 = dim0 < MAX_NUM_THREADS ? static_cast<int>(last_pow2(dim0)) : MAX_NUM_THREADS;
-    int dim1_pow2 = dim1 < MAX_NUM_THREADS ? static_cast<int>(last_pow2(dim1)) : MAX_NUM_THREADS;
+  void set_block_dimension(int64_t dim0, int64_t dim1, int max_threads = MAX_NUM_THREADS) {
+    int dim0_pow2 = dim0 < max_threads ? static_cast<int>(last_pow2(dim0)) : max_threads;
+    int dim1_pow2 = dim1 < max_threads ? static_cast<int>(last_pow2(dim1)) : max_threads;
     block_width = std::min(dim0_pow2, int(at::cuda::warp_size()));
-    block_height = std::min(dim1_pow2, int(MAX_NUM_THREADS / block_width));
-    block_width = std::min(dim0_pow2, int(MAX_NUM_THREADS / block_height));
+    block_height = std::min(dim1_pow2, int(max_threads / block_width));
+    block_width = std::min(dim0_pow2, int(max_threads / block_height));
     num_threads = block_width * block_height;
   }
 
@@ -718,11 +730,6 @@ inline void gpu_reduce_kernel(TensorIterator& iter, const ops_t& ops, ident_t id
   int64_t inputs_per_output = iter.numel() / num_outputs;
   int input_index = iter.ntensors() - 1;
 
-  auto config = ReduceConfig(sizeof(arg_t), num_outputs, inputs_per_output);
-
-  int64_t dim0;
-  int64_t dim1;
-
   // Adjust block size to map block width to fastest changing dimension of input
   // tensor. This grants the best possible memory accessing pattern, given that
   // for non-contiguous tensor with space in between, we cannot have perfect
@@ -731,6 +738,10 @@ inline void gpu_reduce_kernel(TensorIterator& iter, const ops_t& ops, ident_t id
       (iter.num_reduce_dims() == iter.ndim()) ||
       (iter.strides(/*arg=*/input_index)[0] <
        iter.strides(/*arg=*/input_index)[iter.num_reduce_dims()]);
+
+  int64_t dim0;
+  int64_t dim1;
+
   // Notice that dim0 & dim1 does NOT guarantee any launch configuration here!
   // dim0 & dim1 are more like the upper bound of the block dimension. The
   // actual launch config and reduction scheme is determined by setting values
@@ -751,75 +762,134 @@ inline void gpu_reduce_kernel(TensorIterator& iter, const ops_t& ops, ident_t id
     dim1 = inputs_per_output;
   }
 
-  // Adjust block_width and block_height
-  config.set_block_dimension(dim0, dim1);
+  // Derives a full ReduceConfig from the tuning knobs; the autotuner varies
+  // the knobs, kHeuristicParams reproduces the static heuristic exactly.
+  auto make_config = [&](const cuda_reduce::TuningParams& params) {
+    auto config = ReduceConfig(sizeof(arg_t), num_outputs, inputs_per_output);
 
-  int block_width = config.block_width;
-  int block_height = config.block_height;
+    // Adjust block_width and block_height
+    config.set_block_dimension(dim0, dim1, params.max_threads);
 
-  if (iter.ndim() == 0 || reduction_on_fastest_striding_dimension) {
-    // Split the input across lanes if the input is contiguous in the reduced
-    // dimension. This will require reduction between threads using warp
-    // shuffle instructions and shared memory (if block_width > warpSize).
-    config.input_mult[0] = config.split_input(block_width);
-  } else {
-    // Otherwise split the output across lanes in a warp.
-    config.output_mult[0] = config.split_output(block_width);
-  }
-
-  if (config.values_per_thread() >= block_height * 16 || config.values_per_thread() >= 256) {
-    // Divide the input across warps in a thread-block, if that leaves at least
-    // 16 elements to be summed by each thread. This will require inter-warp
-    // reduction using shared memory.
-    config.input_mult[1] = config.split_input(block_height);
-  } else {
-    // Otherwise, each warp handles a separate output.
-    config.output_mult[1] = config.split_output(block_height);
-  }
+    int block_width = config.block_width;
+    int block_height = config.block_height;
 
-  if (config.input_mult[1] != 0 && config.values_per_thread() >= 256 && num_outputs <= 4096) {
-    // Divide the input across thread-blocks if the amount of work per-thread
-    // is large enough and the size of the output is small enough. This will
-    // require a reduction using global memory.
-    config.ctas_per_output = div_up(config.values_per_thread(), 16);
-    if (config.ctas_per_output > 65535) {
-      config.ctas_per_output = 65535;
+    if (iter.ndim() == 0 || reduction_on_fastest_striding_dimension) {
+      // Split the input across lanes if the input is contiguous in the reduced
+      // dimension. This will require reduction between threads using warp
+      // shuffle instructions and shared memory (if block_width > warpSize).
+      config.input_mult[0] = config.split_input(block_width);
+    } else {
+      // Otherwise split the output across lanes in a warp.
+      config.output_mult[0] = config.split_output(block_width);
     }
-    config.input_mult[2] = config.split_input(config.ctas_per_output);
-  }
 
-  at::DataPtr buffer;
-  at::DataPtr semaphores;
-  if (config.should_global_reduce()) {
-    auto& allocator = *c10::cuda::CUDACachingAllocator::get();
-    buffer = allocator.allocate(config.global_memory_size());
-    semaphores = allocator.allocate(config.semaphore_size());
+    if (config.values_per_thread() >= block_height * 16 || config.values_per_thread() >= 256) {
+      // Divide the input across warps in a thread-block, if that leaves at least
+      // 16 elements to be summed by each thread. This will require inter-warp
+      // reduction using shared memory.
+      config.input_mult[1] = config.split_input(block_height);
+    } else {
+      // Otherwise, each warp handles a separate output.
+      config.output_mult[1] = config.split_output(block_height);
+    }
 
-    auto stream = at::cuda::getCurrentCUDAStream();
-    AT_CUDA_CHECK(cudaMemsetAsync(semaphores.get(), 0, config.semaphore_size(), stream));
-  }
+    if (params.vpt_target > 0 && config.input_mult[1] != 0 &&
+        config.values_per_thread() >= 256 && num_outputs <= 4096) {
+      // Divide the input across thread-blocks if the amount of work per-thread
+      // is large enough and the size of the output is small enough. This will
+      // require a reduction using global memory.
+      config.ctas_per_output = div_up(config.values_per_thread(), params.vpt_target);
+      if (config.ctas_per_output > 65535) {
+        config.ctas_per_output = 65535;
+      }
+      config.input_mult[2] = config.split_input(config.ctas_per_output);
+    }
+    return config;
+  };
 
   AT_ASSERT(can_use_32bit_indexing);
   auto output_calc = make_output_calculator<uint32_t>(iter);
   auto input_calc = make_input_calculator<uint32_t>(iter);
-  auto reduce = ReduceOp<scalar_t, ops_t, uint32_t, out_scalar_t, vt0>(
-      ops,
-      config,
-      input_calc,
-      output_calc,
-      in_data,
-      out_data,
-      out_data_extra,
-      acc_data,
-      buffer.get(),
-      (int*)semaphores.get(),
-      ident,
-      noutputs,
-      base_idx);
-  reduce.accumulate = iter.should_accumulate();
-  reduce.final_output = iter.is_final_output();
-
-  launch_reduce_kernel<ReduceConfig::MAX_NUM_THREADS>(config, reduce);
+
+  auto run = [&](const ReduceConfig& config) {
+    at::DataPtr buffer;
+    at::DataPtr semaphores;
+    if (config.should_global_reduce()) {
+      auto& allocator = *c10::cuda::CUDACachingAllocator::get();
+      buffer = allocator.allocate(config.global_memory_size());
+      semaphores = allocator.allocate(config.semaphore_size());
+
+      auto stream = at::cuda::getCurrentCUDAStream();
+      AT_CUDA_CHECK(cudaMemsetAsync(semaphores.get(), 0, config.semaphore_size(), stream));
+    }
+
+    auto reduce = ReduceOp<scalar_t, ops_t, uint32_t, out_scalar_t, vt0>(
+        ops,
+        config,
+        input_calc,
+        output_calc,
+        in_data,
+        out_data,
+        out_data_extra,
+        acc_data,
+        buffer.get(),
+        (int*)semaphores.get(),
+        ident,
+        noutputs,
+        base_idx);
+    reduce.accumulate = iter.should_accumulate();
+    reduce.final_output = iter.is_final_output();
+
+    launch_reduce_kernel<ReduceConfig::MAX_NUM_THREADS>(config, reduce);
+  };
+
+  // Accumulating reductions cannot be re-run, so they always take the
+  // heuristic config.
+  if (cuda_reduce::autotune_enabled() && !iter.should_accumulate()) {
+    auto* prop = at::cuda::getCurrentDeviceProperties();
+    cuda_reduce::TuningKey key{
+        typeid(ops_t).name(),
+        prop->major,
+        prop->minor,
+        (int)sizeof(arg_t),
+        log2_bucket(num_outputs),
+        log2_bucket(inputs_per_output),
+        reduction_on_fastest_striding_dimension};
+    auto tuned = cuda_reduce::lookup(key);
+    if (tuned) {
+      run(make_config(*tuned));
+      return;
+    }
+    // First execution of this key: time each candidate and persist the
+    // winner. Every candidate writes the same deterministic result, so the
+    // extra launches only cost time, and only once per key.
+    cudaEvent_t start_event;
+    cudaEvent_t stop_event;
+    AT_CUDA_CHECK(cudaEventCreate(&start_event));
+    AT_CUDA_CHECK(cudaEventCreate(&stop_event));
+    auto stream = at::cuda::getCurrentCUDAStream();
+    cuda_reduce::TuningParams best = cuda_reduce::kHeuristicParams;
+    float best_time = -1.0f;
+    for (const auto& params : cuda_reduce::candidates()) {
+      auto config = make_config(params);
+      AT_CUDA_CHECK(cudaEventRecord(start_event, stream));
+      run(config);
+      AT_CUDA_CHECK(cudaEventRecord(stop_event, stream));
+      AT_CUDA_CHECK(cudaEventSynchronize(stop_event));
+      float time = 0.0f;
+      AT_CUDA_CHECK(cudaEventElapsedTime(&time, start_event, stop_event));
+      if (best_time < 0.0f || time < best_time) {
+        best_time = time;
+        best = params;
+      }
+    }
+    AT_CUDA_CHECK(cudaEventDestroy(start_event));
+    AT_CUDA_CHECK(cudaEventDestroy(stop_event));
+    cuda_reduce::record(key, best);
+    return;
+  }
+
+  run(make_config(cuda_reduce::kHeuristicParams));
 }
 
 }} // namespace at::native
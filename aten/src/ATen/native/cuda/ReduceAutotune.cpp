@@ -0,0 +1,127 @@
+#include <ATen/native/cuda/ReduceAutotune.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+namespace at {
+namespace native {
+namespace cuda_reduce {
+
+namespace {
+
+std::string serializeKey(const TuningKey& key) {
+  std::ostringstream ss;
+  ss << key.op << ' ' << key.arch_major << ' ' << key.arch_minor << ' '
+     << key.element_size << ' ' << key.log2_num_outputs << ' '
+     << key.log2_inputs_per_output << ' '
+     << (key.fastest_dim_reduction ? 1 : 0);
+  return ss.str();
+}
+
+std::string databasePath() {
+  const char* path = std::getenv("PYTORCH_CUDA_REDUCE_AUTOTUNE_DB");
+  if (path != nullptr) {
+    return path;
+  }
+  const char* home = std::getenv("HOME");
+  if (home == nullptr) {
+    return std::string();
+  }
+#ifndef _WIN32
+  // best effort; tuning degrades to in-memory if the directory can't exist
+  mkdir((std::string(home) + "/.cache").c_str(), 0700);
+  mkdir((std::string(home) + "/.cache/torch").c_str(), 0700);
+#endif
+  return std::string(home) + "/.cache/torch/cuda_reduce_autotune.db";
+}
+
+// One winner per key; entries are whitespace-separated
+//   <op> <major> <minor> <elem> <log2out> <log2in> <fastest> <threads> <vpt>
+// and duplicate keys resolve to the last line, so record() can append.
+struct Database {
+  std::mutex mutex;
+  std::string path;
+  std::unordered_map<std::string, TuningParams> entries;
+
+  Database() : path(databasePath()) {
+    if (path.empty()) {
+      return;
+    }
+    std::ifstream file(path);
+    std::string op;
+    TuningKey key;
+    TuningParams params;
+    int fastest;
+    while (file >> key.op >> key.arch_major >> key.arch_minor >>
+           key.element_size >> key.log2_num_outputs >>
+           key.log2_inputs_per_output >> fastest >> params.max_threads >>
+           params.vpt_target) {
+      key.fastest_dim_reduction = fastest != 0;
+      entries[serializeKey(key)] = params;
+    }
+  }
+};
+
+Database& database() {
+  static Database db;
+  return db;
+}
+
+} // namespace
+
+bool autotune_enabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("PYTORCH_CUDA_REDUCE_AUTOTUNE");
+    return env != nullptr && std::string(env) == "1";
+  }();
+  return enabled;
+}
+
+c10::optional<TuningParams> lookup(const TuningKey& key) {
+  auto& db = database();
+  std::lock_guard<std::mutex> lock(db.mutex);
+  auto it = db.entries.find(serializeKey(key));
+  if (it == db.entries.end()) {
+    return c10::nullopt;
+  }
+  return it->second;
+}
+
+void record(const TuningKey& key, const TuningParams& params) {
+  auto& db = database();
+  std::lock_guard<std::mutex> lock(db.mutex);
+  const std::string serialized = serializeKey(key);
+  db.entries[serialized] = params;
+  if (!db.path.empty()) {
+    std::ofstream file(db.path, std::ios::app);
+    file << serialized << ' ' << params.max_threads << ' '
+         << params.vpt_target << '\n';
+  }
+}
+
+const std::vector<TuningParams>& candidates() {
+  // Narrower blocks help bandwidth-bound shapes on wide chips; the CTA
+  // split variants trade launch overhead against exposed parallelism for
+  // few-output reductions. Kept short: the whole set is timed once per key.
+  static const std::vector<TuningParams> configs = {
+      kHeuristicParams,
+      {256, 16},
+      {128, 16},
+      {512, 8},
+      {512, 32},
+      {512, 0},
+  };
+  return configs;
+}
+
+} // namespace cuda_reduce
+} // namespace native
+} // namespace at
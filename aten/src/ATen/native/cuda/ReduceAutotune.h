@@ -0,0 +1,59 @@
+#pragma once
+
+#include <c10/macros/Export.h>
+#include <c10/util/Optional.h>
+
+#include <string>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace cuda_reduce {
+
+// Launch-configuration knobs that gpu_reduce_kernel derives a ReduceConfig
+// from. `max_threads` caps the block size handed to set_block_dimension;
+// `vpt_target` is the values-per-thread divisor used when splitting the
+// input across CTAs (0 disables the CTA split entirely). The static
+// heuristic corresponds to kHeuristicParams below.
+struct TuningParams {
+  int max_threads;
+  int vpt_target;
+};
+
+constexpr TuningParams kHeuristicParams{/*max_threads=*/512, /*vpt_target=*/16};
+
+// Identifies a (reduction op, shape class, arch) combination. Shapes are
+// bucketed by their power-of-two class, so e.g. all fp32 full sums between
+// 2^20 and 2^21 elements on the same chip share one tuned config.
+struct TuningKey {
+  std::string op; // typeid name of the reduction ops functor
+  int arch_major;
+  int arch_minor;
+  int element_size;
+  int log2_num_outputs;
+  int log2_inputs_per_output;
+  bool fastest_dim_reduction;
+};
+
+// Whether reduction autotuning was requested (PYTORCH_CUDA_REDUCE_AUTOTUNE=1
+// in the environment). When enabled, the first execution of each key times
+// the candidate configs below and persists the winner - the cudnnFind
+// benchmarking model, applied to TensorIterator reductions. Tuned winners
+// are stored in the file named by PYTORCH_CUDA_REDUCE_AUTOTUNE_DB
+// (default: $HOME/.cache/torch/cuda_reduce_autotune.db), so later processes
+// skip the measuring step.
+TORCH_CUDA_API bool autotune_enabled();
+
+// Returns the tuned params for `key`, if the database has a winner for it.
+TORCH_CUDA_API c10::optional<TuningParams> lookup(const TuningKey& key);
+
+// Records `params` as the winner for `key`, in memory and on disk.
+TORCH_CUDA_API void record(const TuningKey& key, const TuningParams& params);
+
+// The configs tried on the first execution of a key; the first entry is the
+// static heuristic.
+TORCH_CUDA_API const std::vector<TuningParams>& candidates();
+
+} // namespace cuda_reduce
+} // namespace native
+} // namespace at
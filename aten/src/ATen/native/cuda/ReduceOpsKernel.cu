@@ -184,6 +184,26 @@ void min_values_kernel_cuda(TensorIterator& iter) {
   }
 }
 
+template <typename scalar_t, typename acc_t=scalar_t>
+void min_max_kernel_cuda_impl(TensorIterator& iter) {
+  gpu_reduce_kernel<scalar_t, scalar_t, 2>(
+    iter,
+    MinMaxOps<scalar_t, acc_t, thrust::tuple<scalar_t, scalar_t>>{},
+    thrust::pair<acc_t, acc_t>(
+      at::numeric_limits<acc_t>::upper_bound(),
+      at::numeric_limits<acc_t>::lower_bound()));
+}
+
+void min_max_kernel_cuda(TensorIterator& iter) {
+  if (iter.dtype(1) == kHalf) {
+    min_max_kernel_cuda_impl<at::Half, float>(iter);
+  } else {
+    AT_DISPATCH_ALL_TYPES(iter.dtype(), "min_max_cuda", [&]() {
+      min_max_kernel_cuda_impl<scalar_t>(iter);
+    });
+  }
+}
+
 template <typename scalar_t, typename acc_t=scalar_t>
 void argmax_kernel_cuda_impl(TensorIterator& iter) {
   gpu_reduce_kernel<scalar_t, int64_t>(
@@ -447,6 +467,7 @@ REGISTER_DISPATCH(and_stub, &and_kernel_cuda);
 REGISTER_DISPATCH(or_stub, &or_kernel_cuda);
 REGISTER_DISPATCH(max_values_stub, &max_values_kernel_cuda);
 REGISTER_DISPATCH(min_values_stub, &min_values_kernel_cuda);
+REGISTER_DISPATCH(min_max_stub, &min_max_kernel_cuda);
 REGISTER_DISPATCH(argmax_stub, &argmax_kernel_cuda);
 REGISTER_DISPATCH(argmin_stub, &argmin_kernel_cuda);
 
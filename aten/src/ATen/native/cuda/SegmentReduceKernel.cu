@@ -0,0 +1,150 @@
+#include <ATen/native/SegmentReduce.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/NumericLimits.cuh>
+
+namespace at { namespace native {
+
+namespace {
+
+// values is treated as a contiguous (rows, inner) matrix; segment i reduces
+// rows [offsets[i], offsets[i + 1]). Segment ranges are contiguous, so one
+// block walks one segment with its threads strided across the inner
+// dimension; there are no write conflicts and hence no atomics, unlike the
+// scatter_add formulation.
+
+constexpr int kSegmentReduceThreads = 256;
+constexpr int kSegmentReduceMaxBlocks = 65535;
+
+template <typename scalar_t>
+__global__ void segment_reduce_cuda_kernel(
+    scalar_t* output,
+    const scalar_t* values,
+    const int64_t* offsets,
+    int64_t num_segments,
+    int64_t inner_size,
+    SegmentReduceOp op) {
+  for (int64_t s = blockIdx.x; s < num_segments; s += gridDim.x) {
+    const int64_t row_begin = offsets[s];
+    const int64_t row_end = offsets[s + 1];
+    for (int64_t d = threadIdx.x; d < inner_size; d += blockDim.x) {
+      scalar_t acc = op == SegmentReduceOp::MAX && row_end > row_begin
+          ? at::numeric_limits<scalar_t>::lower_bound()
+          : static_cast<scalar_t>(0);
+      for (int64_t row = row_begin; row < row_end; ++row) {
+        const scalar_t v = values[row * inner_size + d];
+        acc = op == SegmentReduceOp::MAX ? (v > acc ? v : acc) : acc + v;
+      }
+      if (op == SegmentReduceOp::MEAN && row_end > row_begin) {
+        acc = acc / static_cast<scalar_t>(row_end - row_begin);
+      }
+      output[s * inner_size + d] = acc;
+    }
+  }
+}
+
+template <typename scalar_t>
+__global__ void segment_reduce_backward_cuda_kernel(
+    scalar_t* grad_values,
+    const scalar_t* grad,
+    const scalar_t* output,
+    const scalar_t* values,
+    const int64_t* offsets,
+    int64_t num_segments,
+    int64_t inner_size,
+    SegmentReduceOp op) {
+  for (int64_t s = blockIdx.x; s < num_segments; s += gridDim.x) {
+    const int64_t row_begin = offsets[s];
+    const int64_t row_end = offsets[s + 1];
+    for (int64_t d = threadIdx.x; d < inner_size; d += blockDim.x) {
+      const scalar_t g = grad[s * inner_size + d];
+      for (int64_t row = row_begin; row < row_end; ++row) {
+        scalar_t result;
+        if (op == SegmentReduceOp::MAX) {
+          // Every element equal to the segment max receives the full
+          // gradient, mirroring how ties behave in the forward reduction.
+          result = values[row * inner_size + d] == output[s * inner_size + d]
+              ? g
+              : static_cast<scalar_t>(0);
+        } else if (op == SegmentReduceOp::MEAN) {
+          result = g / static_cast<scalar_t>(row_end - row_begin);
+        } else {
+          result = g;
+        }
+        grad_values[row * inner_size + d] = result;
+      }
+    }
+  }
+}
+
+int grid_for_segments(int64_t num_segments) {
+  return static_cast<int>(
+      std::min<int64_t>(num_segments, kSegmentReduceMaxBlocks));
+}
+
+void segment_reduce_kernel_cuda(
+    Tensor& output,
+    const Tensor& values,
+    const Tensor& offsets,
+    SegmentReduceOp op) {
+  const int64_t num_segments = offsets.numel() - 1;
+  const int64_t inner_size =
+      values.numel() / std::max<int64_t>(values.size(0), 1);
+  cudaStream_t stream = at::cuda::getCurrentCUDAStream();
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::Half, values.scalar_type(), "segment_reduce_cuda", [&] {
+        segment_reduce_cuda_kernel<scalar_t>
+            <<<grid_for_segments(num_segments),
+               kSegmentReduceThreads,
+               0,
+               stream>>>(
+                output.data_ptr<scalar_t>(),
+                values.data_ptr<scalar_t>(),
+                offsets.data_ptr<int64_t>(),
+                num_segments,
+                inner_size,
+                op);
+      });
+  AT_CUDA_CHECK(cudaGetLastError());
+}
+
+void segment_reduce_backward_kernel_cuda(
+    Tensor& grad_values,
+    const Tensor& grad,
+    const Tensor& output,
+    const Tensor& values,
+    const Tensor& offsets,
+    SegmentReduceOp op) {
+  const int64_t num_segments = offsets.numel() - 1;
+  const int64_t inner_size =
+      values.numel() / std::max<int64_t>(values.size(0), 1);
+  cudaStream_t stream = at::cuda::getCurrentCUDAStream();
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+      values.scalar_type(), "segment_reduce_backward_cuda", [&] {
+        segment_reduce_backward_cuda_kernel<scalar_t>
+            <<<grid_for_segments(num_segments),
+               kSegmentReduceThreads,
+               0,
+               stream>>>(
+                grad_values.data_ptr<scalar_t>(),
+                grad.data_ptr<scalar_t>(),
+                output.data_ptr<scalar_t>(),
+                values.data_ptr<scalar_t>(),
+                offsets.data_ptr<int64_t>(),
+                num_segments,
+                inner_size,
+                op);
+      });
+  AT_CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace
+
+REGISTER_DISPATCH(segment_reduce_stub, &segment_reduce_kernel_cuda);
+REGISTER_DISPATCH(
+    segment_reduce_backward_stub,
+    &segment_reduce_backward_kernel_cuda);
+
+}} // namespace at::native
@@ -2,11 +2,13 @@
 
 #include <ATen/ATen.h>
 #include <ATen/AccumulateType.h>
+#include <ATen/CUDAGenerator.h>
 #include <ATen/Dispatch.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/cuda/CUDAApplyUtils.cuh>
 #include <ATen/cuda/detail/IndexUtils.cuh>
 #include <THC/THCDeviceUtils.cuh>
+#include <curand_kernel.h>
 
 #include <c10/cuda/CUDAMathCompat.h>
 
@@ -421,6 +423,69 @@ void LayerNormBackwardKernelImplInternal(
   }
 }
 
+// One block per row: generate the dropout mask in-register with Philox,
+// apply the residual add, stage z = dropout(input) + residual in Y, reduce
+// mean/variance across the block and normalize in a second sweep over the
+// staged values. One kernel launch and one global round trip instead of
+// three (dropout, add, layer norm).
+template <typename T>
+__global__ void DropoutAddLayerNormCUDAKernel(
+    int64_t N,
+    acc_type<T, true> keep_p,
+    acc_type<T, true> eps,
+    std::pair<uint64_t, uint64_t> seeds,
+    const T* input,
+    const T* residual,
+    const T* gamma,
+    const T* beta,
+    T* Y,
+    uint8_t* mask,
+    T* mean,
+    T* rstd) {
+  using T_ACC = acc_type<T, true>;
+  __shared__ T_ACC m_shared[C10_WARP_SIZE];
+  __shared__ T_ACC v_shared[C10_WARP_SIZE];
+  __shared__ T_ACC s_mean;
+  __shared__ T_ACC s_rstd;
+  const int64_t i = blockIdx.x;
+  curandStatePhilox4_32_10_t state;
+  curand_init(
+      seeds.first, i * blockDim.x + threadIdx.x, seeds.second, &state);
+  const T_ACC scale = T_ACC(1) / keep_p;
+  T_ACC sum1 = 0;
+  T_ACC sum2 = 0;
+  for (int64_t j = threadIdx.x; j < N; j += blockDim.x) {
+    const int64_t index = i * N + j;
+    const uint8_t keep =
+        static_cast<uint8_t>(curand_uniform(&state) < keep_p);
+    const T_ACC z = static_cast<T_ACC>(input[index]) * keep * scale +
+        static_cast<T_ACC>(residual[index]);
+    mask[index] = keep;
+    Y[index] = static_cast<T>(z);
+    sum1 += z;
+    sum2 += z * z;
+  }
+  sum1 = BlockReduceSum<T_ACC>(sum1, m_shared);
+  sum2 = BlockReduceSum<T_ACC>(sum2, v_shared);
+  if (threadIdx.x == 0) {
+    const T_ACC s = T_ACC(1) / static_cast<T_ACC>(N);
+    sum1 *= s;
+    sum2 = c10::cuda::compat::max(sum2 * s - sum1 * sum1, T_ACC(0));
+    s_mean = sum1;
+    s_rstd = c10::cuda::compat::rsqrt(sum2 + eps);
+    mean[i] = static_cast<T>(s_mean);
+    rstd[i] = static_cast<T>(s_rstd);
+  }
+  __syncthreads();
+  for (int64_t j = threadIdx.x; j < N; j += blockDim.x) {
+    const int64_t index = i * N + j;
+    const T_ACC g = gamma == nullptr ? T_ACC(1) : static_cast<T_ACC>(gamma[j]);
+    const T_ACC b = beta == nullptr ? T_ACC(0) : static_cast<T_ACC>(beta[j]);
+    Y[index] = static_cast<T>(
+        (static_cast<T_ACC>(Y[index]) - s_mean) * s_rstd * g + b);
+  }
+}
+
 void LayerNormBackwardKernelImpl(
     const Tensor& dY,
     const Tensor& X,
@@ -485,6 +550,147 @@ std::tuple<Tensor, Tensor, Tensor> layer_norm_backward_cuda(
   return std::make_tuple(std::move(dX), std::move(dgamma), std::move(dbeta));
 }
 
+std::tuple<Tensor, Tensor, Tensor, Tensor> dropout_add_layernorm_cuda(
+    const Tensor& input,
+    const Tensor& residual,
+    const Tensor& weight /* optional */,
+    const Tensor& bias /* optional */,
+    double p,
+    double eps,
+    Generator* generator) {
+  TORCH_CHECK(
+      input.sizes() == residual.sizes(),
+      "dropout_add_layernorm: input and residual must have the same shape, "
+      "but got ",
+      input.sizes(),
+      " and ",
+      residual.sizes());
+  TORCH_CHECK(
+      p >= 0 && p < 1,
+      "dropout_add_layernorm: dropout probability has to be in [0, 1), "
+      "but got ",
+      p);
+  const int64_t N = input.size(-1);
+  const int64_t M = input.numel() / std::max<int64_t>(N, 1);
+  TORCH_CHECK(
+      !weight.defined() || weight.numel() == N,
+      "dropout_add_layernorm: expected weight with ",
+      N,
+      " elements, but got ",
+      weight.numel());
+  TORCH_CHECK(
+      !bias.defined() || bias.numel() == N,
+      "dropout_add_layernorm: expected bias with ",
+      N,
+      " elements, but got ",
+      bias.numel());
+
+  const Tensor X = input.contiguous();
+  const Tensor R = residual.contiguous();
+  const Tensor gamma = weight.defined() ? weight.contiguous() : weight;
+  const Tensor beta = bias.defined() ? bias.contiguous() : bias;
+  Tensor Y = at::native::empty_like(X, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor mask = at::empty(X.sizes(), X.options().dtype(kByte));
+  Tensor mean = at::empty({M}, X.options());
+  Tensor rstd = at::empty({M}, X.options());
+  if (M == 0 || N == 0) {
+    return std::make_tuple(
+        std::move(Y), std::move(mask), std::move(mean), std::move(rstd));
+  }
+
+  auto gen = get_generator_or_default<CUDAGenerator>(
+      generator, cuda::detail::getDefaultCUDAGenerator());
+  // each thread draws one uniform per row element it owns; round up to the
+  // 4-wide Philox blocks curand consumes internally
+  const int64_t counter_offset =
+      ((N + kCUDABlockReduceNumThreads - 1) / kCUDABlockReduceNumThreads + 3) /
+          4 +
+      1;
+  std::pair<uint64_t, uint64_t> rng_engine_inputs;
+  {
+    // See Note [Acquire lock when using random generators]
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    rng_engine_inputs = gen->philox_engine_inputs(counter_offset);
+  }
+
+  cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+      X.scalar_type(), "dropout_add_layernorm_cuda", [&]() {
+        using T_ACC = acc_type<scalar_t, true>;
+        DropoutAddLayerNormCUDAKernel<scalar_t>
+            <<<M, kCUDABlockReduceNumThreads, 0, cuda_stream>>>(
+                N,
+                static_cast<T_ACC>(1.0 - p),
+                static_cast<T_ACC>(eps),
+                rng_engine_inputs,
+                X.data_ptr<scalar_t>(),
+                R.data_ptr<scalar_t>(),
+                gamma.defined() ? gamma.data_ptr<scalar_t>() : nullptr,
+                beta.defined() ? beta.data_ptr<scalar_t>() : nullptr,
+                Y.data_ptr<scalar_t>(),
+                mask.data_ptr<uint8_t>(),
+                mean.data_ptr<scalar_t>(),
+                rstd.data_ptr<scalar_t>());
+      });
+  AT_CUDA_CHECK(cudaGetLastError());
+  return std::make_tuple(
+      std::move(Y), std::move(mask), std::move(mean), std::move(rstd));
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor> dropout_add_layernorm_backward_cuda(
+    const Tensor& grad_out,
+    const Tensor& input,
+    const Tensor& residual,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& weight /* optional */,
+    double p,
+    std::array<bool, 4> grad_input_mask) {
+  const int64_t N = input.size(-1);
+  const int64_t M = input.numel() / std::max<int64_t>(N, 1);
+  const double scale = 1.0 / (1.0 - p);
+  // Recompute the normalized kernel's input z = dropout(input) + residual
+  // from the saved mask; cheaper than saving z from the forward.
+  const Tensor Z =
+      at::_masked_scale(input.contiguous(), mask, scale).add_(residual);
+  const Tensor dY = grad_out.contiguous();
+
+  Tensor dZ;
+  Tensor dgamma;
+  Tensor dbeta;
+  const bool needs_dZ = grad_input_mask[0] || grad_input_mask[1];
+  if (needs_dZ) {
+    dZ = at::native::empty_like(Z, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  }
+  if (grad_input_mask[2]) {
+    dgamma = M > 0
+        ? at::native::empty_like(weight, LEGACY_CONTIGUOUS_MEMORY_FORMAT)
+        : at::native::zeros_like(weight, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  }
+  if (grad_input_mask[3]) {
+    dbeta = M > 0
+        ? at::native::empty_like(weight, LEGACY_CONTIGUOUS_MEMORY_FORMAT)
+        : at::native::zeros_like(weight, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  }
+  if (M > 0) {
+    LayerNormBackwardKernelImpl(
+        dY, Z, mean, rstd, weight, M, N, &dZ, &dgamma, &dbeta);
+  }
+
+  Tensor dinput;
+  if (grad_input_mask[0]) {
+    // the dropout scaling is linear, so d_input = dZ * mask * scale
+    dinput = at::_masked_scale(dZ, mask, scale);
+  }
+  // the residual enters the sum unscaled, so its gradient is dZ itself
+  Tensor dresidual = grad_input_mask[1] ? dZ : Tensor();
+  return std::make_tuple(
+      std::move(dinput),
+      std::move(dresidual),
+      std::move(dgamma),
+      std::move(dbeta));
+}
 
 REGISTER_DISPATCH(LayerNormKernel, &LayerNormKernelImpl);
 REGISTER_DISPATCH(LayerNormBackwardKernel, &LayerNormBackwardKernelImpl);
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <ATen/cuda/ATenCUDAGeneral.h>
+
+#include <string>
+
+namespace at { namespace native {
+
+// Persistence for the cuDNN convolution algorithm benchmark caches.
+// See Note [Persistent benchmark cache] in native/cudnn/Conv.cpp.
+//
+// save_cudnn_benchmark_cache writes the in-process caches to `path`;
+// load_cudnn_benchmark_cache seeds them from such a file, either called
+// explicitly to pre-warm from a shipped profile or automatically at
+// handle creation when TORCH_CUDNN_BENCHMARK_CACHE_PATH is set. A file
+// is only accepted if it was written with the same cache format, cuDNN
+// version and GPU model. Both return false (without throwing) when the
+// file cannot be written, read, or does not match.
+TORCH_CUDA_API bool save_cudnn_benchmark_cache(const std::string& path);
+TORCH_CUDA_API bool load_cudnn_benchmark_cache(const std::string& path);
+
+}} // namespace at::native
@@ -5,6 +5,7 @@
 #include <ATen/cuda/CUDAConfig.h>
 #include <ATen/cuda/Exceptions.h>
 #include <ATen/native/ConvUtils.h>
+#include <ATen/native/cudnn/BenchmarkCachePersistence.h>
 
 #if !AT_CUDNN_ENABLED()
 
@@ -68,6 +69,14 @@ std::tuple<at::Tensor,at::Tensor> cudnn_convolution_transpose_backward(
   AT_ERROR("cudnn_convolution_transpose_backward: ATen not compiled with cuDNN support");
 }
 
+bool save_cudnn_benchmark_cache(const std::string& /* path */) {
+  return false;
+}
+
+bool load_cudnn_benchmark_cache(const std::string& /* path */) {
+  return false;
+}
+
 }}
 
 #else  // AT_CUDNN_ENABLED
@@ -78,11 +87,14 @@ std::tuple<at::Tensor,at::Tensor> cudnn_convolution_transpose_backward(
 #include <ATen/cudnn/Descriptors.h>
 #include <ATen/cudnn/Types.h>
 #include <ATen/cudnn/Utils.h>
+#include <ATen/cuda/CUDAContext.h>
 #include <ATen/native/utils/ParamsHash.h>
 
 #include <ATen/TensorUtils.h>
 
+#include <cstring>
 #include <functional>
+#include <fstream>
 #include <iterator>
 #include <sstream>
 #include <algorithm>
@@ -292,6 +304,113 @@ BenchmarkCache<cudnnConvolutionFwdAlgoPerf_t> fwd_algos;
 BenchmarkCache<cudnnConvolutionBwdDataAlgoPerf_t> bwd_data_algos;
 BenchmarkCache<cudnnConvolutionBwdFilterAlgoPerf_t> bwd_filter_algos;
 
+// Note [Persistent benchmark cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// With torch.backends.cudnn.benchmark enabled, every new convolution
+// configuration pays an exhaustive cudnnFind* sweep, and the resulting
+// cache is repaid from scratch on every process restart. The functions
+// below dump the three in-process caches to disk and seed them back from
+// such a file: explicitly, to pre-warm from a shipped profile, or
+// automatically at handle creation when TORCH_CUDNN_BENCHMARK_CACHE_PATH
+// is set (see cudnn/Handle.cpp).
+//
+// Entries are written as raw ConvolutionParams/perf structs, so a file is
+// only accepted when its header matches the current cache format, cuDNN
+// version and GPU model byte for byte; on any mismatch the whole file is
+// rejected rather than risking a stale algorithm choice.
+
+namespace {
+
+constexpr uint64_t kBenchmarkCacheMagic = 0x544f524348434246ULL; // "TORCHCBF"
+constexpr uint32_t kBenchmarkCacheFormatVersion = 1;
+
+struct BenchmarkCacheFileHeader {
+  uint64_t magic;
+  uint32_t format_version;
+  uint64_t cudnn_version;
+  char device_name[256];
+  int32_t device_major;
+  int32_t device_minor;
+};
+
+void fillCacheFileHeader(BenchmarkCacheFileHeader* header) {
+  memset(header, 0, sizeof(BenchmarkCacheFileHeader));
+  header->magic = kBenchmarkCacheMagic;
+  header->format_version = kBenchmarkCacheFormatVersion;
+  header->cudnn_version = cudnnGetVersion();
+  auto* prop = at::cuda::getCurrentDeviceProperties();
+  strncpy(header->device_name, prop->name, sizeof(header->device_name) - 1);
+  header->device_major = prop->major;
+  header->device_minor = prop->minor;
+}
+
+template <typename perf_t>
+void writeBenchmarkCache(std::ostream& out, BenchmarkCache<perf_t>& cache) {
+  std::lock_guard<std::mutex> guard(cache.mutex);
+  uint64_t count = cache.map.size();
+  out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  for (const auto& entry : cache.map) {
+    out.write(
+        reinterpret_cast<const char*>(&entry.first),
+        sizeof(ConvolutionParams));
+    out.write(reinterpret_cast<const char*>(&entry.second), sizeof(perf_t));
+  }
+}
+
+template <typename perf_t>
+bool readBenchmarkCache(std::istream& in, BenchmarkCache<perf_t>& cache) {
+  uint64_t count;
+  in.read(reinterpret_cast<char*>(&count), sizeof(count));
+  for (uint64_t i = 0; in && i < count; i++) {
+    ConvolutionParams params;
+    perf_t result;
+    in.read(reinterpret_cast<char*>(&params), sizeof(ConvolutionParams));
+    in.read(reinterpret_cast<char*>(&result), sizeof(perf_t));
+    if (in) {
+      cache.insert(params, result);
+    }
+  }
+  return bool(in);
+}
+
+} // namespace
+
+bool save_cudnn_benchmark_cache(const std::string& path) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  BenchmarkCacheFileHeader header;
+  fillCacheFileHeader(&header);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  writeBenchmarkCache(out, fwd_algos);
+  writeBenchmarkCache(out, bwd_data_algos);
+  writeBenchmarkCache(out, bwd_filter_algos);
+  return bool(out);
+}
+
+bool load_cudnn_benchmark_cache(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  BenchmarkCacheFileHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!in) {
+    return false;
+  }
+  // Both headers are zero-filled before use, so a byte-wise comparison
+  // covers the padding as well.
+  BenchmarkCacheFileHeader expected;
+  fillCacheFileHeader(&expected);
+  if (memcmp(&header, &expected, sizeof(header)) != 0) {
+    return false;
+  }
+  return readBenchmarkCache(in, fwd_algos) &&
+      readBenchmarkCache(in, bwd_data_algos) &&
+      readBenchmarkCache(in, bwd_filter_algos);
+}
+
 // TODO: Stop manually allocating CUDA memory; allocate an ATen byte
 // tensor instead.
 struct Workspace {
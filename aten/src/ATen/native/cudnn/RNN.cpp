@@ -8,6 +8,7 @@
 #include <ATen/cuda/CUDAConfig.h>
 #include <ATen/cuda/CUDAEvent.h>
 #include <ATen/cuda/Exceptions.h>
+#include <ATen/native/cuda/PersistentRNN.h>
 #include <c10/util/Exception.h>
 
 #if !AT_CUDNN_ENABLED()
@@ -1263,6 +1264,30 @@ std::pair<Tensor, hidden_type> _cudnn_impl(
   std::tie(hx, cx) = unpack_hidden(hidden);
   int64_t hidden_size = hx.size(2);
 
+  // Small-batch decode: cuDNN launches a fresh GEMM per timestep and is
+  // several times slower than a persistent kernel at batch <= 4. Try the
+  // single-launch persistent path first; it declines anything it cannot
+  // handle and we fall through to cuDNN.
+  if (mode == CUDNN_LSTM || mode == CUDNN_GRU) {
+    auto seq_input = batch_first ? input.transpose(0, 1) : input;
+    Tensor p_output, p_hy;
+    // pack_hidden<Tensor> (the GRU case) asserts an empty cell state.
+    Tensor p_cy = at::empty({0}, hx.options());
+    const bool handled = mode == CUDNN_LSTM
+        ? persistent_lstm_cuda(
+              p_output, p_hy, p_cy, seq_input, hx, cx, params, has_biases,
+              num_layers, train, bidirectional)
+        : persistent_gru_cuda(
+              p_output, p_hy, seq_input, hx, params, has_biases, num_layers,
+              train, bidirectional);
+    if (handled) {
+      if (batch_first) {
+        p_output = p_output.transpose(0, 1);
+      }
+      return {p_output, pack_hidden<hidden_type>(p_hy, p_cy)};
+    }
+  }
+
   auto weight_buf = try_get_weight_buf(
       input, params, has_biases, mode, hidden_size, num_layers, bidirectional);
   if (!weight_buf.defined()) {
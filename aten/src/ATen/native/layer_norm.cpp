@@ -12,6 +12,7 @@
 #include <ATen/Config.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/Parallel.h>
+#include <ATen/TensorUtils.h>
 
 namespace at {
 namespace native {
@@ -122,8 +123,79 @@ Tensor layer_norm(
   return std::get<0>(at::native_layer_norm(X, gamma, beta, M, N, eps));
 }
 
+// Fused transformer input block: for each token, gather its embedding row,
+// add the matching row of `positional` (precomputed positional + segment
+// embeddings), and layer-normalize over the embedding dimension in one
+// streaming pass, instead of materializing two intermediate [M, N] tensors.
+//
+// `positional` is a [P, N] (or reshapeable to [P, N]) tensor whose rows are
+// cycled over tokens, so a [seq_len, N] table broadcasts across the batch of
+// a [batch, seq_len] indices tensor, and a full per-token tensor is used
+// verbatim.
+Tensor embedding_layernorm_cpu(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& positional,
+    const Tensor& ln_weight /* optional */,
+    const Tensor& ln_bias /* optional */,
+    double eps) {
+  auto indices_arg = TensorArg(indices, "indices", 2);
+  checkScalarType("embedding_layernorm", indices_arg, kLong);
+  TORCH_CHECK(
+      weight.dim() == 2,
+      "embedding_layernorm: expected 2-D weight, but got weight of size ",
+      weight.sizes());
+  const int64_t N = weight.size(1);
+  const int64_t M = indices.numel();
+  TORCH_CHECK(
+      positional.numel() > 0 && positional.numel() % N == 0,
+      "embedding_layernorm: positional must hold whole rows of size ",
+      N,
+      ", but got positional of size ",
+      positional.sizes());
+  const int64_t P = positional.numel() / N;
+  TORCH_CHECK(
+      M % P == 0,
+      "embedding_layernorm: the ",
+      P,
+      " positional rows do not evenly cover ",
+      M,
+      " tokens");
+  TORCH_CHECK(
+      !ln_weight.defined() || ln_weight.numel() == N,
+      "embedding_layernorm: expected ln_weight with ",
+      N,
+      " elements, but got ln_weight of size ",
+      ln_weight.sizes());
+  TORCH_CHECK(
+      !ln_bias.defined() || ln_bias.numel() == N,
+      "embedding_layernorm: expected ln_bias with ",
+      N,
+      " elements, but got ln_bias of size ",
+      ln_bias.sizes());
+
+  auto size = indices.sizes().vec();
+  size.push_back(N);
+  Tensor Y = at::empty(size, weight.options());
+  if (M > 0) {
+    EmbeddingLayerNormKernel(
+        kCPU,
+        weight.contiguous(),
+        indices.contiguous(),
+        positional.contiguous(),
+        ln_weight.defined() ? ln_weight.contiguous() : ln_weight,
+        ln_bias.defined() ? ln_bias.contiguous() : ln_bias,
+        M,
+        N,
+        eps,
+        &Y);
+  }
+  return Y;
+}
+
 DEFINE_DISPATCH(LayerNormKernel);
 DEFINE_DISPATCH(LayerNormBackwardKernel);
+DEFINE_DISPATCH(EmbeddingLayerNormKernel);
 
 } // namespace native
 } // namespace at
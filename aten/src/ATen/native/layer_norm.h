@@ -29,8 +29,20 @@ using backward_fn = void (*)(
     Tensor* /* dgamma */,
     Tensor* /* dbeta */);
 
+using embedding_forward_fn = void (*)(
+    const Tensor& /* weight */,
+    const Tensor& /* indices */,
+    const Tensor& /* positional */,
+    const Tensor& /* gamma */,
+    const Tensor& /* beta */,
+    int64_t /* M */,
+    int64_t /* N */,
+    double /* eps */,
+    Tensor* /* Y */);
+
 DECLARE_DISPATCH(forward_fn, LayerNormKernel);
 DECLARE_DISPATCH(backward_fn, LayerNormBackwardKernel);
+DECLARE_DISPATCH(embedding_forward_fn, EmbeddingLayerNormKernel);
 
 } // namespace native
 } // namespace at
@@ -85,9 +85,21 @@ ideep::tensor _mkldnn_conv2d(
   std::vector<int64_t> output_sizes =
       conv_output_size(input_size, kernel_size, padding, stride, dilation);
 
+  std::vector<int64_t> cache_params;
+  cache_params.reserve(
+      padding.size() + stride.size() + dilation.size() + 2);
+  cache_params.insert(cache_params.end(), padding.begin(), padding.end());
+  cache_params.insert(cache_params.end(), stride.begin(), stride.end());
+  cache_params.insert(cache_params.end(), dilation.begin(), dilation.end());
+  cache_params.push_back(groups);
+  cache_params.push_back(b.has_value() ? 1 : 0);
+  ideep::key_t key =
+      get_primitive_cache_key("mkldnn_conv2d", x, w, cache_params);
+
   ideep::tensor y;
   if (b.has_value()) {
     ideep::convolution_forward::compute<AllocForMKLDNN>(
+        key,
         x,
         w,
         b.value(),
@@ -103,6 +115,7 @@ ideep::tensor _mkldnn_conv2d(
         ideep::prop_kind::forward);
   } else {
     ideep::convolution_forward::compute<AllocForMKLDNN>(
+      key,
       x,
       w,
       {output_sizes.cbegin(), output_sizes.cend()},
@@ -2,6 +2,11 @@
 #include <ATen/OpaqueTensorImpl.h>
 #include <c10/core/Allocator.h>
 
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #if AT_MKLDNN_ENABLED()
 
 #include <ideep.hpp>
@@ -73,6 +78,112 @@ ideep::tensor itensor_view_from_dense(const Tensor& tensor) {
            ideep::tensor::data_type::f32},
           tensor.template data_ptr<float>()};
 }
+
+// Note [MKLDNN primitive key cache]
+// ideep caches created primitives in per-computation LRU caches, but the
+// keyless compute() entry points re-serialize every descriptor and
+// parameter into the lookup key on each call, which shows up for small
+// dynamic-batch inference workloads. The keyed entry points skip that work
+// when the caller supplies a stable key (the caffe2 ideep operators cache
+// one key per operator instance this way). ATen ops are stateless, so this
+// is a global thread-safe LRU mapping (op, input descriptor, weight
+// descriptor, params) to a unique key. Descriptors are compared exactly, so
+// two calls only share a key when ideep would build an identical primitive.
+// Capacity evictions only drop the short key string; ideep's own cache
+// still bounds the number of live primitives.
+
+namespace {
+
+constexpr size_t kPrimitiveKeyCacheCapacity = 1024;
+
+struct PrimitiveKeyEntry {
+  // Encodes op, dims and params; descriptors disambiguate within a bucket.
+  std::string bucket;
+  ideep::tensor::descriptor x_desc;
+  ideep::tensor::descriptor w_desc;
+  ideep::key_t key;
+};
+
+// MRU-first list plus an index over a cheap (op, dims, params) bucket
+// string; entries in a bucket differ only in descriptor internals (e.g.
+// blocked weight formats), so buckets stay very small.
+struct PrimitiveKeyCache {
+  std::mutex mutex;
+  std::list<PrimitiveKeyEntry> entries;
+  std::unordered_multimap<std::string, std::list<PrimitiveKeyEntry>::iterator>
+      index;
+  uint64_t next_id = 0;
+};
+
+PrimitiveKeyCache& primitive_key_cache() {
+  static PrimitiveKeyCache cache;
+  return cache;
+}
+
+void append_dims(std::string& bucket, const ideep::tensor::dims& dims) {
+  for (auto d : dims) {
+    bucket += std::to_string(d);
+    bucket += ',';
+  }
+  bucket += ';';
+}
+
+void erase_index_entry(
+    PrimitiveKeyCache& cache,
+    std::list<PrimitiveKeyEntry>::iterator entry) {
+  auto range = cache.index.equal_range(entry->bucket);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == entry) {
+      cache.index.erase(it);
+      return;
+    }
+  }
+}
+
+} // anonymous namespace
+
+ideep::key_t get_primitive_cache_key(
+    const char* op,
+    const ideep::tensor& x,
+    const ideep::tensor& w,
+    IntArrayRef params) {
+  std::string bucket(op);
+  bucket += ';';
+  append_dims(bucket, x.get_dims());
+  append_dims(bucket, w.get_dims());
+  for (auto p : params) {
+    bucket += std::to_string(p);
+    bucket += ',';
+  }
+
+  auto& cache = primitive_key_cache();
+  std::lock_guard<std::mutex> guard(cache.mutex);
+
+  auto range = cache.index.equal_range(bucket);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto entry = it->second;
+    if (!(entry->x_desc != x.get_descriptor()) &&
+        !(entry->w_desc != w.get_descriptor())) {
+      // Splicing keeps list iterators (and thus the index) valid.
+      cache.entries.splice(cache.entries.begin(), cache.entries, entry);
+      return entry->key;
+    }
+  }
+
+  // The key only has to be unique within this process; ideep treats it as
+  // an opaque lookup token.
+  ideep::key_t key = bucket + '#' + std::to_string(cache.next_id++);
+  cache.entries.push_front(PrimitiveKeyEntry{
+      bucket, x.dup_descriptor(), w.dup_descriptor(), key});
+  cache.index.emplace(bucket, cache.entries.begin());
+
+  if (cache.entries.size() > kPrimitiveKeyCacheCapacity) {
+    auto last = std::prev(cache.entries.end());
+    erase_index_entry(cache, last);
+    cache.entries.erase(last);
+  }
+  return key;
+}
 }}
 
 #endif // AT_MKLDNN_ENABLED()
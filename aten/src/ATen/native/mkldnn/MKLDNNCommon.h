@@ -30,6 +30,18 @@ ideep::tensor& itensor_from_mkldnn(const Tensor& mkldnn_tensor);
 // Construct an `ideep::tensor` "view" from dense tensor, note the
 // ideep::tensor will share the underlying buffer
 ideep::tensor itensor_view_from_dense(const Tensor& tensor);
+
+// Return a stable ideep computation key for the call site identified by
+// `op` with the given input/weight tensors and primitive parameters
+// (padding, stride, etc. flattened into `params`). Passing the key to
+// ideep's keyed compute() entry points reuses the cached primitive without
+// re-serializing every descriptor on each call.
+// See Note [MKLDNN primitive key cache] in MKLDNNCommon.cpp.
+ideep::key_t get_primitive_cache_key(
+    const char* op,
+    const ideep::tensor& x,
+    const ideep::tensor& w,
+    IntArrayRef params);
 }}
 
 #endif // AT_MKLDNN_ENABLED
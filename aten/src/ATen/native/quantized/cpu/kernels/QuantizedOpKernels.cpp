@@ -306,6 +306,94 @@ void qsigmoid_kernel(const Tensor& qx, Tensor& qy) {
   });
 }
 
+// Shared template for fused dequantize -> op -> quantize kernels where the
+// output quantization parameters are supplied by the caller (the JIT quant
+// fusion pass) instead of being fixed by the op. The int8 data is widened to
+// fp32 in registers via the Vec256<qint> converters, the op is applied there,
+// and the result is narrowed back - the intermediate fp32 tensor that a
+// dequantize/op/quantize_per_tensor chain would materialize never exists.
+template <typename ScalarOp, typename VecOp>
+void qdq_unary_qparams_kernel(
+    const Tensor& qx,
+    double output_scale,
+    int64_t output_zero_point,
+    Tensor& qy,
+    const char* name,
+    const ScalarOp& scalar_op,
+    const VecOp& vec_op) {
+  int64_t zero_point = qx.q_zero_point();
+  float scale = qx.q_scale();
+  auto scale_vec = Vec256<float>(scale);
+  auto zero_point_vec = Vec256<float>((float)zero_point);
+  auto scale_neg_zp_premul_vec = scale_vec * zero_point_vec.neg();
+
+  AT_DISPATCH_QINT_TYPES(qx.scalar_type(), name, [&]() {
+    float inv_output_scale = 1.0 / output_scale;
+    qy = at::_empty_affine_quantized(
+        qx.sizes(),
+        at::device(kCPU).dtype(SCALAR_TYPE),
+        output_scale,
+        output_zero_point,
+        qx.suggest_memory_format());
+    auto iter = TensorIterator::unary_op(qy, qx);
+
+    using Vec = Vec256<scalar_t>;
+    cpu_kernel_vec(
+      iter,
+      [&](scalar_t value_qx) -> scalar_t {
+        const auto value_dx = at::dequantize_val(scale, zero_point, value_qx);
+        return at::quantize_val<scalar_t>(output_scale, output_zero_point,
+                                          scalar_op(value_dx));
+      },
+      [&](Vec value_qx) -> Vec {
+        auto value_dx = value_qx.dequantize(scale_vec, zero_point_vec,
+                                            scale_neg_zp_premul_vec);
+        for (int idx = 0; idx < Vec::float_num_vecs(); ++idx) {
+          value_dx[idx] = vec_op(value_dx[idx]);
+        }
+        return Vec::quantize(value_dx, output_scale, output_zero_point,
+                             inv_output_scale);
+      }
+    );
+  });
+}
+
+void qrelu_qparams_kernel(
+    const Tensor& qx,
+    double output_scale,
+    int64_t output_zero_point,
+    Tensor& qy) {
+  auto zero_vec = Vec256<float>(0.0f);
+  qdq_unary_qparams_kernel(
+      qx, output_scale, output_zero_point, qy, "qrelu_qparams",
+      [](float x) { return std::max(x, 0.0f); },
+      [&](Vec256<float> x) { return vec256::maximum(x, zero_vec); });
+}
+
+void qsigmoid_qparams_kernel(
+    const Tensor& qx,
+    double output_scale,
+    int64_t output_zero_point,
+    Tensor& qy) {
+  qdq_unary_qparams_kernel(
+      qx, output_scale, output_zero_point, qy, "qsigmoid_qparams",
+      [](float x) { return 1.0f / (1.0f + std::exp(-x)); },
+      [](Vec256<float> x) {
+        return (Vec256<float>(1.0f) + x.neg().exp()).reciprocal();
+      });
+}
+
+void qtanh_qparams_kernel(
+    const Tensor& qx,
+    double output_scale,
+    int64_t output_zero_point,
+    Tensor& qy) {
+  qdq_unary_qparams_kernel(
+      qx, output_scale, output_zero_point, qy, "qtanh_qparams",
+      [](float x) { return std::tanh(x); },
+      [](Vec256<float> x) { return x.tanh(); });
+}
+
 void qclamp_kernel(
     const Tensor& qx,
     Scalar min_scalar,
@@ -406,6 +494,41 @@ void qadd_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
   int64_t other_zero_point = other.q_zero_point();
   float other_scale = other.q_scale();
 
+  // When all three tensors share quantization parameters the sum can be
+  // computed directly on the integer representations:
+  //   c_q = clamp(a_q + b_q - zero_point)
+  // (the fused ReLU additionally clamps from below at the zero point),
+  // skipping the dequantize/requantize round trip through fp32 entirely.
+  if (self_scale == scale && other_scale == scale &&
+      self_zero_point == zero_point && other_zero_point == zero_point) {
+    auto iter = TensorIterator::binary_op(out, self, other);
+    AT_DISPATCH_QINT_TYPES(out.scalar_type(), "qadd", [&]() {
+      using Vec = Vec256<scalar_t>;
+      auto zero_point_vec =
+          Vec(scalar_t(static_cast<underlying_t>(zero_point)));
+      constexpr int64_t min_val = std::numeric_limits<underlying_t>::min();
+      constexpr int64_t max_val = std::numeric_limits<underlying_t>::max();
+      cpu_kernel_vec(
+          iter,
+          [&](scalar_t a, scalar_t b) -> scalar_t {
+            int64_t c = static_cast<int64_t>(a.val_) + b.val_ - zero_point;
+            if (ReLUFused) {
+              c = std::max<int64_t>(c, zero_point);
+            }
+            return scalar_t(
+                std::min<int64_t>(std::max<int64_t>(c, min_val), max_val));
+          },
+          [&](Vec a, Vec b) -> Vec {
+            auto c = a.shifted_add(b, zero_point_vec);
+            if (ReLUFused) {
+              c = c.relu(zero_point_vec);
+            }
+            return c;
+          });
+    });
+    return;
+  }
+
   // Broadcast out the parameters here to amortize out that cost across
   // loop iterations.
   // TODO: we can optimize dequantization by doing a premultiplication
@@ -1149,6 +1272,9 @@ REGISTER_DISPATCH(qrelu_leaky_stub, &leaky_qrelu_out_kernel);
 REGISTER_DISPATCH(qsigmoid_stub, &qsigmoid_kernel);
 REGISTER_DISPATCH(qclamp_stub, &qclamp_kernel);
 REGISTER_DISPATCH(qtanh_stub, &qtanh_kernel);
+REGISTER_DISPATCH(qrelu_qparams_stub, &qrelu_qparams_kernel);
+REGISTER_DISPATCH(qsigmoid_qparams_stub, &qsigmoid_qparams_kernel);
+REGISTER_DISPATCH(qtanh_qparams_stub, &qtanh_qparams_kernel);
 REGISTER_DISPATCH(qadd_relu_stub, &qadd_kernel<true>);
 REGISTER_DISPATCH(qadd_stub, &qadd_kernel<false>);
 REGISTER_DISPATCH(qmaxpool_2d_nhwc_stub, &qmaxpool_2d_nhwc_kernel);
@@ -52,12 +52,36 @@ Tensor quantized_cat_impl(
 
   const auto x_dtype = qxs.get(0).scalar_type();
   const auto x_qscheme = qxs.get(0).qscheme();
-  std::vector<Tensor> xs;
-  xs.reserve(qxs.size());
+  bool shared_qparams = true;
   for (const at::Tensor& qx : qxs) {
     TORCH_CHECK(x_dtype == qx.scalar_type(), "All dtypes must be the same.");
     TORCH_CHECK(
         x_qscheme == qx.qscheme(), "Quantization schemes must be the same.");
+    shared_qparams &=
+        qx.q_scale() == scale && qx.q_zero_point() == zero_point;
+  }
+
+  // If every input already carries the requested output quantization
+  // parameters, the integer representations are already in the output's
+  // quantization domain: concatenate them directly (and, for the fused
+  // variant, clamp from below at the zero point) without the
+  // dequantize/requantize round trip through fp32.
+  if (shared_qparams) {
+    std::vector<Tensor> xs_int;
+    xs_int.reserve(qxs.size());
+    for (const at::Tensor& qx : qxs) {
+      xs_int.push_back(qx.int_repr());
+    }
+    Tensor y = at::cat(xs_int, dim);
+    if (ReLUFused) {
+      y.clamp_min_(zero_point);
+    }
+    return at::_make_per_tensor_quantized_tensor(y, scale, zero_point);
+  }
+
+  std::vector<Tensor> xs;
+  xs.reserve(qxs.size());
+  for (const at::Tensor& qx : qxs) {
     xs.push_back(qx.dequantize());
   }
   const Tensor y = at::cat(xs, dim);
@@ -237,10 +237,12 @@ class QLinearDynamicInt8 final : public torch::OperatorKernel {
     auto bias_contig = bias_vec.contiguous();
     const float* bias_ptr = bias_contig.data_ptr<float>();
 
-    // Calculate statistics for quantization of input Tensor
-    // TODO: optimized kernel
-    float x_min = input_contig.min().item<float>();
-    float x_max = input_contig.max().item<float>();
+    // Calculate statistics for quantization of input Tensor; min and max
+    // are computed in a single pass over the input.
+    Tensor input_min, input_max;
+    std::tie(input_min, input_max) = at::_min_max(input_contig);
+    float x_min = input_min.item<float>();
+    float x_max = input_max.item<float>();
 
     auto q_params = quant_utils::ChooseQuantizationParams(
         /*min=*/x_min,
@@ -6,6 +6,9 @@
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <ATen/quantized/Quantizer.h>
 #include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace caffe2 {
@@ -24,6 +27,137 @@ namespace at {
 namespace native {
 namespace {
 
+#ifdef USE_FBGEMM
+// Servers commonly instantiate the same quantized model once per worker
+// thread, so without sharing every instance carries its own copy of the
+// packed weights. This cache keys packed buffers on the weight content so
+// identical weights share one packed tensor. The packed tensor is held
+// weakly: once the last module referencing it is destroyed, the entry is
+// evicted on the next lookup. Packed weights are read-only after creation,
+// so sharing them across threads is safe.
+class PackedWeightCache {
+ public:
+  // Returns a previously packed tensor for an identical (kind, weight, bias)
+  // triple, or runs `pack` and caches its result. `weight` and `bias` must
+  // be contiguous, and their content must match the bytes `pack` reads.
+  template <typename PackFn>
+  at::Tensor getOrCreate(
+      const char* kind,
+      const at::Tensor& weight,
+      const c10::optional<at::Tensor>& bias,
+      const PackFn& pack) {
+    const uint64_t key = hash(kind, weight, bias);
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second.packed.lock().isNone()) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    auto range = entries_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (matches(it->second, kind, weight, bias)) {
+        return it->second.packed.lock().toTensor();
+      }
+    }
+    // Packing under the lock means concurrent prepacks of the same weight
+    // (e.g. many workers loading the same model at startup) produce a
+    // single packed buffer instead of racing to create duplicates.
+    at::Tensor packed = pack();
+    entries_.emplace(
+        key, Entry{c10::WeakIValue(c10::IValue(packed)), kind, weight, bias});
+    return packed;
+  }
+
+ private:
+  struct Entry {
+    c10::WeakIValue packed;
+    const char* kind;
+    at::Tensor weight;
+    c10::optional<at::Tensor> bias;
+  };
+
+  static uint64_t hashBytes(uint64_t h, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      h = (h ^ bytes[i]) * 0x100000001b3ull; // FNV-1a
+    }
+    return h;
+  }
+
+  static uint64_t hashTensor(uint64_t h, const at::Tensor& t) {
+    const auto dtype = static_cast<int64_t>(t.scalar_type());
+    h = hashBytes(h, &dtype, sizeof(dtype));
+    h = hashBytes(h, t.sizes().data(), t.dim() * sizeof(int64_t));
+    return hashBytes(h, t.data_ptr(), t.numel() * t.element_size());
+  }
+
+  static uint64_t hash(
+      const char* kind,
+      const at::Tensor& weight,
+      const c10::optional<at::Tensor>& bias) {
+    uint64_t h = hashBytes(0xcbf29ce484222325ull, kind, std::strlen(kind));
+    h = hashTensor(h, weight);
+    if (bias.has_value()) {
+      h = hashTensor(h, *bias);
+    }
+    return h;
+  }
+
+  static bool tensorContentEqual(const at::Tensor& a, const at::Tensor& b) {
+    return a.scalar_type() == b.scalar_type() && a.sizes().equals(b.sizes()) &&
+        std::memcmp(
+            a.data_ptr(), b.data_ptr(), a.numel() * a.element_size()) == 0;
+  }
+
+  static bool quantParamsEqual(const at::Tensor& a, const at::Tensor& b) {
+    if (a.is_quantized() != b.is_quantized()) {
+      return false;
+    }
+    if (!a.is_quantized()) {
+      return true;
+    }
+    if (a.qscheme() != b.qscheme()) {
+      return false;
+    }
+    if (a.qscheme() == kPerTensorAffine) {
+      return a.q_scale() == b.q_scale() &&
+          a.q_zero_point() == b.q_zero_point();
+    }
+    return a.q_per_channel_axis() == b.q_per_channel_axis() &&
+        a.q_per_channel_scales().equal(b.q_per_channel_scales()) &&
+        a.q_per_channel_zero_points().equal(b.q_per_channel_zero_points());
+  }
+
+  // Exact verification behind the hash; a hash collision only costs a
+  // byte-wise comparison, never a wrong cache hit.
+  static bool matches(
+      const Entry& entry,
+      const char* kind,
+      const at::Tensor& weight,
+      const c10::optional<at::Tensor>& bias) {
+    if (std::strcmp(entry.kind, kind) != 0 ||
+        entry.bias.has_value() != bias.has_value()) {
+      return false;
+    }
+    if (bias.has_value() && !tensorContentEqual(*entry.bias, *bias)) {
+      return false;
+    }
+    return tensorContentEqual(entry.weight, weight) &&
+        quantParamsEqual(entry.weight, weight);
+  }
+
+  std::mutex mutex_;
+  std::unordered_multimap<uint64_t, Entry> entries_;
+};
+
+PackedWeightCache& packedWeightCache() {
+  static PackedWeightCache cache;
+  return cache;
+}
+#endif // USE_FBGEMM
+
 class QLinearPackWeightInt8 final : public c10::OperatorKernel {
  public:
 #ifdef USE_FBGEMM
@@ -64,6 +198,31 @@ class QLinearPackWeightInt8 final : public c10::OperatorKernel {
     // TODO: contiguous is called for further JIT optimizations.
     auto weight_contig = weight.contiguous();
     const auto qtype = weight.qscheme();
+
+    c10::optional<at::Tensor> bias_contig;
+    if (bias.has_value()) {
+      Tensor bias_vec = bias.value();
+      TORCH_CHECK(bias_vec.dim() == 1, "bias should be a vector (1D Tensor)");
+      TORCH_CHECK(
+          bias_vec.size(0) == N,
+          "bias should have N elements: " + std::to_string(N));
+      bias_contig = bias->contiguous();
+    }
+
+    return packedWeightCache().getOrCreate(
+        "linear_int8", weight_contig, bias_contig, [&]() {
+          return fbgemm_linear_prepack_impl(
+              weight, weight_contig, bias_contig, K, N, qtype);
+        });
+  }
+
+  at::Tensor fbgemm_linear_prepack_impl(
+      const at::Tensor& weight,
+      const at::Tensor& weight_contig,
+      const c10::optional<at::Tensor>& bias_contig,
+      int64_t K,
+      int64_t N,
+      c10::QScheme qtype) {
     std::vector<int32_t> weight_zero_points_int32(1, 0);
     if (qtype == kPerTensorAffine) {
       weight_zero_points_int32[0] = weight.q_zero_point();
@@ -96,15 +255,6 @@ class QLinearPackWeightInt8 final : public c10::OperatorKernel {
         /*col_offsets=*/col_offsets.data(),
         /*qtype=*/qtype);
 
-    c10::optional<at::Tensor> bias_contig;
-    if (bias.has_value()) {
-      Tensor bias_vec = bias.value();
-      TORCH_CHECK(bias_vec.dim() == 1, "bias should be a vector (1D Tensor)");
-      TORCH_CHECK(
-          bias_vec.size(0) == N,
-          "bias should have N elements: " + std::to_string(N));
-      bias_contig = bias->contiguous();
-    }
     auto ret_ptr = std::make_unique<PackedLinearWeight>(PackedLinearWeight{
         std::make_unique<fbgemm::PackBMatrix<int8_t>>(
             /*trans=*/fbgemm::matrix_op_t::Transpose,
@@ -205,6 +355,26 @@ class QLinearPackWeightFp16 final : public c10::OperatorKernel {
     float* weight_contig_ptr = weight_contig.data_ptr<float>();
     HandleWeightsSaturation(K * N, weight_contig_ptr);
 
+    c10::optional<Tensor> bias_contig;
+    if (bias.has_value()) {
+      bias_contig = bias->contiguous();
+    }
+
+    // Saturation runs before the cache lookup, so the bytes the key is
+    // computed from are the bytes that get packed.
+    return packedWeightCache().getOrCreate(
+        "linear_fp16", weight_contig, bias_contig, [&]() {
+          return fbgemm_linear_prepack_fp16_impl(
+              weight, weight_contig_ptr, bias_contig, K, N);
+        });
+  }
+
+  at::Tensor fbgemm_linear_prepack_fp16_impl(
+      const at::Tensor& weight,
+      float* weight_contig_ptr,
+      const c10::optional<Tensor>& bias_contig,
+      int64_t K,
+      int64_t N) {
     // TODO(mingzhe09088):
     // Consider using a functor here in PackedGemmMatrixFP16
     // Comments from (XQ): Not entirely sure this make_unique is safe.
@@ -215,7 +385,7 @@ class QLinearPackWeightFp16 final : public c10::OperatorKernel {
     auto ptr = std::make_unique<PackedLinearWeightFp16>(PackedLinearWeightFp16{
         std::make_unique<fbgemm::PackedGemmMatrixFP16>(
             fbgemm::matrix_op_t::Transpose, K, N, 1, weight_contig_ptr),
-        bias});
+        bias_contig});
     return cpp_custom_type_hack::create(std::move(ptr), weight.options());
   }
 #endif
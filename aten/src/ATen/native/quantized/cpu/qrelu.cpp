@@ -17,6 +17,7 @@ namespace native {
 DEFINE_DISPATCH(qrelu_stub);
 DEFINE_DISPATCH(qrelu6_stub);
 DEFINE_DISPATCH(qrelu_leaky_stub);
+DEFINE_DISPATCH(qrelu_qparams_stub);
 
 #ifdef USE_PYTORCH_QNNPACK
 Tensor qnnpack_relu(Tensor input) {
@@ -157,6 +158,16 @@ Tensor quantized_relu6_(Tensor& qx) {
   return qx;
 }
 
+class QRelu final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(Tensor qx, double output_scale, int64_t output_zero_point) {
+    Tensor qy;
+    qrelu_qparams_stub(
+        qx.device().type(), qx, output_scale, output_zero_point, qy);
+    return qy;
+  }
+};
+
 class QRelu6 final : public c10::OperatorKernel {
  public:
   Tensor operator()(Tensor qx, bool inplace) {
@@ -169,6 +180,10 @@ class QRelu6 final : public c10::OperatorKernel {
 };
 
 static auto registry = c10::RegisterOperators()
+.op("quantized::relu(Tensor qx, float output_scale, int output_zero_point) -> Tensor",
+    c10::RegisterOperators::options()
+        .aliasAnalysis(at::AliasAnalysisKind::FROM_SCHEMA)
+        .kernel<QRelu>(DispatchKey::QuantizedCPUTensorId))
 .op("quantized::relu6(Tensor qx, bool inplace=False) -> Tensor",
     c10::RegisterOperators::options().kernel<QRelu6>(DispatchKey::QuantizedCPUTensorId));
 } // namespace
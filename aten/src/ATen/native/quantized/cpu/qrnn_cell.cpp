@@ -0,0 +1,127 @@
+#include <ATen/ATen.h>
+#include <ATen/core/op_registration/op_registration.h>
+#include <ATen/native/c10_utils.h>
+
+#include <tuple>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+// Statically quantized single-step RNN cells.
+//
+// Unlike the dynamically quantized cells in native/RNN.cpp (int8 weights,
+// fp32 activations), these kernels keep the activations quantized: both the
+// input-to-hidden and hidden-to-hidden projections run as int8 gemms via
+// quantized::linear on prepacked weights (quantized::linear_prepack), the
+// gate pre-activations are requantized to a common (gates_scale,
+// gates_zero_point), and the new hidden state is requantized to (hy_scale,
+// hy_zero_point) so it can feed the next step's int8 gemm directly. Only
+// the O(hidden_size) elementwise gate math runs in fp32; the LSTM cell
+// state stays fp32 for accuracy, as is conventional for static int8 RNNs.
+
+void check_rnn_cell_inputs(const Tensor& input, const Tensor& hx) {
+  TORCH_CHECK(
+      input.is_quantized() && hx.is_quantized(),
+      "quantized rnn cell: input and hx must be quantized tensors");
+  TORCH_CHECK(
+      input.qscheme() == kPerTensorAffine && hx.qscheme() == kPerTensorAffine,
+      "quantized rnn cell: only per tensor quantized activations are supported");
+  TORCH_CHECK(
+      input.scalar_type() == hx.scalar_type(),
+      "quantized rnn cell: input and hx must have the same quantized dtype");
+}
+
+Tensor quantized_linear(
+    const Tensor& input,
+    const Tensor& packed_weight,
+    double scale,
+    int64_t zero_point) {
+  auto output = callOp(
+      "quantized::linear", "", input, packed_weight, scale, zero_point);
+  TORCH_INTERNAL_ASSERT(output.size() == 1);
+  return output[0].toTensor();
+}
+
+class QLSTMCellInt8 final : public c10::OperatorKernel {
+ public:
+  std::tuple<Tensor, Tensor> operator()(
+      Tensor input,
+      Tensor hx,
+      Tensor cx,
+      Tensor w_ih_prepack,
+      Tensor w_hh_prepack,
+      double gates_scale,
+      int64_t gates_zero_point,
+      double hy_scale,
+      int64_t hy_zero_point) {
+    check_rnn_cell_inputs(input, hx);
+    auto igates = quantized_linear(
+        input, w_ih_prepack, gates_scale, gates_zero_point);
+    auto hgates =
+        quantized_linear(hx, w_hh_prepack, gates_scale, gates_zero_point);
+    // requantized int8 add keeps the gate pre-activations on a single scale
+    auto gates = callOp(
+        "quantized::add", "", igates, hgates, gates_scale, gates_zero_point)
+        [0].toTensor();
+
+    auto chunked_gates = gates.dequantize().chunk(4, 1);
+    auto ingate = chunked_gates[0].sigmoid_();
+    auto forgetgate = chunked_gates[1].sigmoid_();
+    auto cellgate = chunked_gates[2].tanh_();
+    auto outgate = chunked_gates[3].sigmoid_();
+    auto cy = (forgetgate * cx).add_(ingate * cellgate);
+    auto hy = outgate * cy.tanh();
+    return std::make_tuple(
+        at::quantize_per_tensor(
+            hy, hy_scale, hy_zero_point, input.scalar_type()),
+        std::move(cy));
+  }
+};
+
+class QGRUCellInt8 final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor input,
+      Tensor hx,
+      Tensor w_ih_prepack,
+      Tensor w_hh_prepack,
+      double gates_scale,
+      int64_t gates_zero_point,
+      double hy_scale,
+      int64_t hy_zero_point) {
+    check_rnn_cell_inputs(input, hx);
+    // The new-gate math needs the reset gate applied to the hidden
+    // projection alone, so the two gemm outputs are dequantized separately
+    // instead of being combined with quantized::add.
+    auto chunked_igates = quantized_linear(
+        input, w_ih_prepack, gates_scale, gates_zero_point)
+        .dequantize().chunk(3, 1);
+    auto chunked_hgates =
+        quantized_linear(hx, w_hh_prepack, gates_scale, gates_zero_point)
+        .dequantize().chunk(3, 1);
+    const auto reset_gate =
+        chunked_hgates[0].add_(chunked_igates[0]).sigmoid_();
+    const auto input_gate =
+        chunked_hgates[1].add_(chunked_igates[1]).sigmoid_();
+    const auto new_gate =
+        chunked_igates[2].add(chunked_hgates[2].mul_(reset_gate)).tanh_();
+    auto hy = (hx.dequantize() - new_gate).mul_(input_gate).add_(new_gate);
+    return at::quantize_per_tensor(
+        hy, hy_scale, hy_zero_point, input.scalar_type());
+  }
+};
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("quantized::lstm_cell_int8(Tensor X, Tensor hx, Tensor cx, Tensor w_ih_prepack, Tensor w_hh_prepack, float gates_scale, int gates_zero_point, float hy_scale, int hy_zero_point) -> (Tensor hy, Tensor cy)",
+            torch::RegisterOperators::options().kernel<QLSTMCellInt8>(
+                DispatchKey::QuantizedCPUTensorId))
+        .op("quantized::gru_cell_int8(Tensor X, Tensor hx, Tensor w_ih_prepack, Tensor w_hh_prepack, float gates_scale, int gates_zero_point, float hy_scale, int hy_zero_point) -> Tensor hy",
+            torch::RegisterOperators::options().kernel<QGRUCellInt8>(
+                DispatchKey::QuantizedCPUTensorId));
+
+} // namespace
+} // namespace native
+} // namespace at
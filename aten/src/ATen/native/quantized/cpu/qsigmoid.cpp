@@ -15,6 +15,7 @@ namespace at {
 namespace native {
 
 DEFINE_DISPATCH(qsigmoid_stub);
+DEFINE_DISPATCH(qsigmoid_qparams_stub);
 
 #ifdef USE_PYTORCH_QNNPACK
 // This ALWAYS outputs scale=1.0/256, dtype=quint8
@@ -86,4 +87,24 @@ Tensor quantized_sigmoid(const Tensor& qx) {
   qsigmoid_stub(qx.device().type(), qx, qy);
   return qy;
 }
+
+// Keep the registry in the anonymous namespace.
+namespace {
+class QSigmoid final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(Tensor qx, double output_scale, int64_t output_zero_point) {
+    Tensor qy;
+    qsigmoid_qparams_stub(
+        qx.device().type(), qx, output_scale, output_zero_point, qy);
+    return qy;
+  }
+};
+
+static auto registry = c10::RegisterOperators().op(
+    "quantized::sigmoid(Tensor qx, float output_scale, int output_zero_point) -> Tensor",
+    c10::RegisterOperators::options()
+        .aliasAnalysis(at::AliasAnalysisKind::FROM_SCHEMA)
+        .kernel<QSigmoid>(DispatchKey::QuantizedCPUTensorId));
+} // namespace
+
 }}  // namespace at::native
@@ -15,6 +15,7 @@ namespace at {
 namespace native {
 
 DEFINE_DISPATCH(qtanh_stub);
+DEFINE_DISPATCH(qtanh_qparams_stub);
 
 #ifdef USE_PYTORCH_QNNPACK
 // This ALWAYS outputs scale=2.0/256, zp=128, dtype=quint8
@@ -85,4 +86,24 @@ Tensor quantized_tanh(const Tensor& qx) {
   qtanh_stub(qx.device().type(), qx, qy);
   return qy;
 }
+
+// Keep the registry in the anonymous namespace.
+namespace {
+class QTanh final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(Tensor qx, double output_scale, int64_t output_zero_point) {
+    Tensor qy;
+    qtanh_qparams_stub(
+        qx.device().type(), qx, output_scale, output_zero_point, qy);
+    return qy;
+  }
+};
+
+static auto registry = c10::RegisterOperators().op(
+    "quantized::tanh(Tensor qx, float output_scale, int output_zero_point) -> Tensor",
+    c10::RegisterOperators::options()
+        .aliasAnalysis(at::AliasAnalysisKind::FROM_SCHEMA)
+        .kernel<QTanh>(DispatchKey::QuantizedCPUTensorId));
+} // namespace
+
 }}  // namespace at::native
@@ -653,6 +653,67 @@ void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j,
   }
 };
 
+// Parallel CSR kernel used when the sparse matrix is coalesced. Rows are
+// independent once the row pointers are known, so they are distributed over
+// threads with parallel_for, and the dense columns are walked in blocks so
+// the accumulated output row block stays in cache while the matching blocks
+// of the dense rows stream through it.
+constexpr int64_t kCsrSpmmColBlock = 512;
+
+template <typename scalar_t>
+void s_addmm_out_csr_dense_worker(int64_t dim_i, int64_t dim_j, int64_t dim_k, Tensor& r, Scalar beta, const Tensor& t, Scalar alpha, const LongTensor& csr, const Tensor& indices, const Tensor& values, const Tensor& dense) {
+  scalar_t cast_alpha = alpha.to<scalar_t>();
+  scalar_t cast_beta = beta.to<scalar_t>();
+  if (cast_beta == 0) {
+    r.zero_();
+  } else if (cast_beta == 1) {
+    if (!is_same_tensor(r, t)) {
+      r.copy_(t);
+    }
+  } else {
+    at::mul_out(r, t, scalar_to_tensor(beta));
+  }
+
+  const int64_t* csr_ptr = csr.data_ptr<int64_t>();
+  auto indices_accessor = indices.accessor<int64_t, 2>();
+  auto values_accessor = values.accessor<scalar_t, 1>();
+  scalar_t* dense_ptr = dense.data_ptr<scalar_t>();
+  scalar_t* r_ptr = r.data_ptr<scalar_t>();
+
+  int64_t dense_stride0 = dense.stride(0);
+  int64_t dense_stride1 = dense.stride(1);
+  int64_t r_stride0 = r.stride(0);
+  int64_t r_stride1 = r.stride(1);
+
+  int64_t nnz = values.size(0);
+  int64_t avg_row_flops =
+      (nnz / std::max<int64_t>(dim_i, 1) + 1) * std::max<int64_t>(dim_k, 1);
+  int64_t grain_size =
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / avg_row_flops);
+
+  at::parallel_for(0, dim_i, grain_size, [&](int64_t row_begin, int64_t row_end) {
+    for (int64_t row = row_begin; row < row_end; row++) {
+      int64_t i_start = csr_ptr[row];
+      int64_t i_end = csr_ptr[row + 1];
+      scalar_t* r_row = r_ptr + row * r_stride0;
+      for (int64_t k = 0; k < dim_k; k += kCsrSpmmColBlock) {
+        int64_t block = std::min(kCsrSpmmColBlock, dim_k - k);
+        for (int64_t i = i_start; i < i_end; i++) {
+          scalar_t val = values_accessor[i];
+          int64_t col = indices_accessor[1][i];
+          if (col < 0 || col >= dim_j) {
+            AT_ERROR("addmm: index out of column bound: ", col, " not between 1 and ", dim_j);
+          }
+          THBlas_axpy<scalar_t>(block,
+                cast_alpha * val,
+                dense_ptr + col * dense_stride0 + k * dense_stride1, dense_stride1,
+                r_row + k * r_stride1, r_stride1);
+        }
+      }
+    }
+  });
+};
+
 Tensor& s_addmm_out_sparse_dense_cpu(
     Tensor& r,
     const Tensor& t,
@@ -695,6 +756,31 @@ Tensor& s_addmm_out_sparse_dense_cpu(
   LongTensor indices = sparse_._indices();
   Tensor values      = sparse_._values();
 
+  if (sparse_.is_coalesced()) {
+    // Coalesced indices are sorted by row, so the matrix converts to CSR row
+    // pointers directly; cache them on the impl so a sparse matrix reused
+    // across many mms (e.g. a GNN adjacency matrix) converts only once.
+    auto* sparse_impl = get_sparse_impl(sparse_);
+    LongTensor csr = sparse_impl->csr_indices();
+    if (!csr.defined()) {
+      auto indices_accessor = indices.accessor<int64_t, 2>();
+      for (int64_t i = 0; i < nnz; i++) {
+        int64_t row = indices_accessor[0][i];
+        if (row < 0 || row >= dim_i) {
+          AT_ERROR("addmm: index out of row bound: ", row, " not between 1 and ", dim_i);
+        }
+      }
+      csr = _to_csr(indices.data_ptr<int64_t>(), dim_i, nnz);
+      sparse_impl->set_csr_indices(csr);
+    }
+    AT_DISPATCH_ALL_TYPES(
+        values.scalar_type(), "addmm_sparse_dense", [&] {
+          s_addmm_out_csr_dense_worker<scalar_t>(dim_i, dim_j, dim_k, r, beta, t, alpha, csr, indices, values, dense);
+        }
+    );
+    return r;
+  }
+
   AT_DISPATCH_ALL_TYPES(
       values.scalar_type(), "addmm_sparse_dense", [&] {
         s_addmm_out_sparse_dense_worker<scalar_t>(nnz, dim_i, dim_j, dim_k, r, beta, t, alpha, indices, values, dense);
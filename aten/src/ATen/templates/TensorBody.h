@@ -266,6 +266,15 @@ class CAFFE2_API Tensor {
   bool is_alias_of(const at::Tensor& other) const{
     return impl_->storage().is_alias_of(other.storage());
   }
+
+  /// Transfers ownership of the tensor's underlying buffer to the caller and
+  /// leaves the tensor undefined. The tensor must be contiguous, start at
+  /// storage offset zero, not require grad, and be the sole owner of both its
+  /// TensorImpl and its storage (no live views or aliases). The returned
+  /// DataPtr releases the buffer with the storage's original deleter when it
+  /// is destroyed, so it can be handed to code that outlives the tensor
+  /// without copying the data.
+  DataPtr release_storage();
   Tensor toType(ScalarType t) const;
   Tensor toBackend(Backend b) const;
 
@@ -427,3 +427,50 @@ TEST(BasicTest, FactoryMethodsTest) {
     ASSERT_FALSE(tensor0.is_pinned());
   }
 }
+
+TEST(BasicTest, DataAlignmentTest) {
+  at::Tensor tensor = at::zeros({32}, at::kFloat);
+  // base tensors come out of the allocator at least gAlignment aligned
+  ASSERT_EQ(tensor.unsafeGetTensorImpl()->data_alignment() % c10::gAlignment, 0);
+
+  // a slice starting at element 1 is exactly 4-byte (itemsize) aligned
+  at::Tensor view = tensor.slice(0, 1);
+  ASSERT_EQ(view.unsafeGetTensorImpl()->data_alignment(), sizeof(float));
+
+  // element 16 is 64 bytes into the storage, so alignment is preserved
+  at::Tensor aligned_view = tensor.slice(0, 16);
+  ASSERT_EQ(
+      aligned_view.unsafeGetTensorImpl()->data_alignment() % c10::gAlignment,
+      0);
+
+  // undefined storage reports no alignment guarantee
+  at::Tensor empty = at::empty({0}, at::kFloat);
+  ASSERT_GE(empty.unsafeGetTensorImpl()->data_alignment(), 1);
+}
+
+TEST(BasicTest, ReleaseStorageTest) {
+  at::Tensor tensor = at::ones({4, 4}, at::kFloat);
+  void* data = tensor.data_ptr();
+
+  // Donation fails while the storage is shared with a view or alias.
+  {
+    at::Tensor view = tensor.view({16});
+    ASSERT_ANY_THROW(tensor.release_storage());
+  }
+  {
+    at::Tensor alias = tensor;
+    ASSERT_ANY_THROW(alias.release_storage());
+  }
+
+  // Non-contiguous tensors and nonzero storage offsets can't donate.
+  {
+    at::Tensor t = at::ones({4, 4}, at::kFloat).t();
+    ASSERT_ANY_THROW(t.release_storage());
+  }
+
+  at::DataPtr buffer = tensor.release_storage();
+  ASSERT_FALSE(tensor.defined());
+  ASSERT_EQ(buffer.get(), data);
+  // The buffer is still readable through the DataPtr the caller now owns.
+  ASSERT_EQ(static_cast<float*>(buffer.get())[0], 1.0f);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/core/grad_mode.h>
+#include <ATen/native/ConversionMemo.h>
+
+using namespace at;
+
+namespace {
+
+// The cache is bypassed under GradMode, so run everything with it off.
+struct ConversionMemoTest : public ::testing::Test {
+  void SetUp() override {
+    GradMode::set_enabled(false);
+    native::set_conversion_memo_enabled(true);
+  }
+  void TearDown() override {
+    native::set_conversion_memo_enabled(false);
+    GradMode::set_enabled(true);
+  }
+};
+
+} // namespace
+
+TEST_F(ConversionMemoTest, ReusesConversionUntilWrite) {
+  auto src = rand({8, 8}, kDouble);
+  auto a = src.to(kFloat);
+  auto b = src.to(kFloat);
+  // Second identical conversion is served from the cache.
+  ASSERT_EQ(a.data_ptr(), b.data_ptr());
+  ASSERT_TRUE(a.to(kDouble).allclose(src));
+
+  // These tests run without the autograd layer, which is what bumps the
+  // version (and with it the storage generation) on in-place ops, so bump
+  // it by hand the way the dispatcher would.
+  src.add_(1);
+  src.unsafeGetTensorImpl()->bump_version();
+
+  auto c = src.to(kFloat);
+  ASSERT_NE(a.data_ptr(), c.data_ptr());
+  ASSERT_TRUE(c.to(kDouble).allclose(src));
+}
+
+TEST_F(ConversionMemoTest, DistinguishesTargetsAndViews) {
+  auto src = rand({4, 6}, kDouble);
+  auto as_float = src.to(kFloat);
+  ASSERT_NE(as_float.data_ptr(), src.to(kHalf).data_ptr());
+  // A different view of the same storage must not share the cached result.
+  auto narrowed = src.narrow(1, 0, 3);
+  auto narrowed_float = narrowed.to(kFloat);
+  ASSERT_NE(as_float.data_ptr(), narrowed_float.data_ptr());
+  ASSERT_TRUE(narrowed_float.to(kDouble).allclose(narrowed));
+}
+
+TEST_F(ConversionMemoTest, ExplicitCopyBypassesCache) {
+  auto src = rand({8}, kDouble);
+  auto a = src.to(src.options().dtype(kFloat), /*non_blocking=*/false, /*copy=*/true);
+  auto b = src.to(src.options().dtype(kFloat), /*non_blocking=*/false, /*copy=*/true);
+  ASSERT_NE(a.data_ptr(), b.data_ptr());
+}
+
+TEST_F(ConversionMemoTest, DisabledByDefault) {
+  native::set_conversion_memo_enabled(false);
+  auto src = rand({8}, kDouble);
+  ASSERT_NE(src.to(kFloat).data_ptr(), src.to(kFloat).data_ptr());
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/ScalarReadback.h>
+
+TEST(ScalarReadbackTest, SingleScalar) {
+  if (!at::cuda::is_available()) return;
+  auto t = at::full({}, 3.5, at::device(at::kCUDA).dtype(at::kDouble));
+  auto future = at::cuda::item_async(t);
+  ASSERT_EQ(future.size(), 1);
+  ASSERT_EQ(future.get().toDouble(), 3.5);
+  // A consumed future reports ready and keeps returning the value.
+  ASSERT_TRUE(future.ready());
+  ASSERT_EQ(future.get().toDouble(), 3.5);
+}
+
+TEST(ScalarReadbackTest, BatchedScalars) {
+  if (!at::cuda::is_available()) return;
+  auto correct = at::full({}, 17, at::device(at::kCUDA).dtype(at::kLong));
+  auto total = at::full({}, 32, at::device(at::kCUDA).dtype(at::kLong));
+  auto loss = at::full({}, 0.25, at::device(at::kCUDA).dtype(at::kFloat));
+  auto future = at::cuda::items_async({correct, total, loss});
+  ASSERT_EQ(future.size(), 3);
+  auto values = future.values();
+  ASSERT_EQ(values[0].toLong(), 17);
+  ASSERT_EQ(values[1].toLong(), 32);
+  ASSERT_EQ(values[2].toDouble(), 0.25);
+}
+
+TEST(ScalarReadbackTest, MatchesItem) {
+  if (!at::cuda::is_available()) return;
+  auto t = at::randn({64, 64}, at::device(at::kCUDA)).sum();
+  auto future = at::cuda::item_async(t);
+  ASSERT_EQ(future.get().toDouble(), t.item<double>());
+}
+
+TEST(ScalarReadbackTest, RejectsNonScalar) {
+  if (!at::cuda::is_available()) return;
+  auto t = at::zeros({2}, at::device(at::kCUDA));
+  ASSERT_ANY_THROW(at::cuda::item_async(t));
+}
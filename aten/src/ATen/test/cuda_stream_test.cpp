@@ -196,6 +196,35 @@ TEST(TestStream, StreamPoolTest) {
   ASSERT_TRUE(hasDuplicates);
 }
 
+// Private stream pools reserve streams exclusively
+TEST(TestStream, PrivateStreamPoolTest) {
+  if (!at::cuda::is_available()) return;
+  std::unordered_set<cudaStream_t> stream_set{};
+  {
+    c10::cuda::CUDAStreamPool pool_a(4);
+    c10::cuda::CUDAStreamPool pool_b(4);
+
+    // Streams within and across live pools never overlap.
+    for (size_t i = 0; i < pool_a.size(); ++i) {
+      ASSERT_TRUE(stream_set.insert(pool_a.stream(i).stream()).second);
+      ASSERT_TRUE(stream_set.insert(pool_b.stream(i).stream()).second);
+    }
+
+    // next() round-robins within the pool.
+    ASSERT_EQ_CUDA(pool_a.next(), pool_a.stream(0));
+    ASSERT_EQ_CUDA(pool_a.next(), pool_a.stream(1));
+
+    // Pool streams work with stream guards like any other stream.
+    {
+      at::cuda::CUDAStreamGuard guard(pool_a.stream(0));
+      ASSERT_EQ_CUDA(at::cuda::getCurrentCUDAStream(), pool_a.stream(0));
+    }
+  }
+  // After release, the streams can be reserved again.
+  c10::cuda::CUDAStreamPool pool_c(8);
+  ASSERT_EQ_CUDA(pool_c.size(), static_cast<size_t>(8));
+}
+
 // Multi-GPU
 TEST(TestStream, MultiGPUTest) {
   if (!at::cuda::is_available()) return;
@@ -30,3 +30,44 @@ TEST(TestDlconvertor, TestDlconvertorNoStrides) {
 
   ASSERT_TRUE(a.equal(b));
 }
+
+TEST(TestDlconvertor, TestDlconvertorBatch) {
+  manual_seed(123);
+
+  std::vector<Tensor> tensors = {rand({3, 4}), rand({5}), rand({2, 2, 2})};
+  std::vector<DLManagedTensor*> dlMTensors = toDLPackBatch(tensors);
+  ASSERT_EQ(dlMTensors.size(), tensors.size());
+
+  std::vector<const DLManagedTensor*> srcs(
+      dlMTensors.begin(), dlMTensors.end());
+  std::vector<Tensor> roundtripped = fromDLPackBatch(srcs);
+  ASSERT_EQ(roundtripped.size(), tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    ASSERT_TRUE(tensors[i].equal(roundtripped[i]));
+  }
+}
+
+TEST(TestDlconvertor, TestDlconvertorBatchReleasesSources) {
+  manual_seed(123);
+
+  // dropping one ingested tensor must release its source right away, even
+  // while the rest of the batch is still alive
+  Tensor a = rand({3, 4});
+  Tensor b = rand({4, 3});
+  std::vector<DLManagedTensor*> dlMTensors = toDLPackBatch({a, b});
+  std::vector<Tensor> ingested = fromDLPackBatch(
+      std::vector<const DLManagedTensor*>(
+          dlMTensors.begin(), dlMTensors.end()));
+
+  ASSERT_EQ(a.use_count(), 2);
+  ingested[0] = Tensor();
+  ASSERT_EQ(a.use_count(), 1);
+  ASSERT_EQ(b.use_count(), 2);
+  ingested[1] = Tensor();
+  ASSERT_EQ(b.use_count(), 1);
+}
+
+TEST(TestDlconvertor, TestDlconvertorBatchEmpty) {
+  ASSERT_TRUE(toDLPackBatch({}).empty());
+  ASSERT_TRUE(fromDLPackBatch({}).empty());
+}
@@ -216,6 +216,50 @@ TEST(TensorIteratorTest, DoNotComputeCommonDTypeIfOutputIsUndefined) {
   ASSERT_ANY_THROW(iter.build());
 }
 
+TEST(TensorIteratorTest, PlanCacheRepeatedShapes) {
+  // repeated builds with identical shapes exercise the thread-local plan
+  // cache (see Note [TensorIterator plan cache]); results must not change
+  auto in1 = at::randn({17, 19}, kCPU);
+  auto in2 = at::randn({17, 19}, kCPU);
+  auto expected = in1.add(in2);
+  for (int i = 0; i < 3; i++) {
+    Tensor out = at::empty({17, 19}, kCPU);
+    auto iter = TensorIterator::binary_op(out, in1, in2);
+    at::native::cpu_serial_kernel(iter, [](float a, float b) -> float { return a + b; });
+    EXPECT_TRUE(out.equal(expected));
+  }
+}
+
+TEST(TensorIteratorTest, PlanCacheDistinguishesStrides) {
+  // a transposed input has the same sizes but different strides and must not
+  // reuse the contiguous plan
+  auto base = at::randn({8, 8}, kCPU);
+  Tensor out1 = at::empty({8, 8}, kCPU);
+  auto iter1 = TensorIterator::unary_op(out1, base);
+  at::native::cpu_serial_kernel(iter1, [](float a) -> float { return a * 2; });
+  EXPECT_TRUE(out1.equal(base.mul(2)));
+
+  auto transposed = base.t();
+  Tensor out2 = at::empty({8, 8}, kCPU);
+  auto iter2 = TensorIterator::unary_op(out2, transposed);
+  at::native::cpu_serial_kernel(iter2, [](float a) -> float { return a * 2; });
+  EXPECT_TRUE(out2.equal(transposed.mul(2)));
+}
+
+TEST(TensorIteratorTest, ForEachGrainHint) {
+  // A grain hint must only affect chunking, never which elements are
+  // visited; check both a small grain (forces parallel chunks) and a
+  // huge one (forces the serial path).
+  for (int64_t grain_size : {16L, 1L << 30}) {
+    auto in = at::randn({123, 7}, kCPU);
+    Tensor out = at::empty({123, 7}, kCPU);
+    auto iter = TensorIterator::unary_op(out, in);
+    at::native::cpu_kernel(
+        iter, [](float a) -> float { return a + 1; }, grain_size);
+    EXPECT_TRUE(out.equal(in.add(1)));
+  }
+}
+
 TEST(TensorIteratorTest, FailNonPromotingBinaryOp) {
   Tensor out;
   auto iter = at::TensorIterator();
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+
+using at::Tensor;
+using at::TensorRef;
+
+TEST(TensorRefTest, DoesNotTouchRefcount) {
+  Tensor t = at::ones({4, 4});
+  ASSERT_EQ(t.use_count(), 1);
+  {
+    TensorRef ref(t);
+    ASSERT_EQ(t.use_count(), 1);
+    ASSERT_EQ(ref->use_count(), 1);
+  }
+  ASSERT_EQ(t.use_count(), 1);
+}
+
+TEST(TensorRefTest, ForwardsMethods) {
+  Tensor t = at::rand({3, 5});
+  TensorRef ref(t);
+  ASSERT_EQ(ref->dim(), 2);
+  ASSERT_EQ(ref->sizes(), t.sizes());
+  ASSERT_TRUE(ref->equal(t));
+  ASSERT_EQ((*ref).unsafeGetTensorImpl(), t.unsafeGetTensorImpl());
+}
+
+TEST(TensorRefTest, UndefinedTensor) {
+  Tensor t;
+  TensorRef ref(t);
+  ASSERT_FALSE(ref->defined());
+}
@@ -52,6 +52,65 @@ TEST(TestParallel, Exceptions) {
     std::runtime_error);
 }
 
+TEST(TestParallel, ReduceTreeCombine) {
+  // exact arithmetic: the pairwise tree matches the serial fold
+  auto total = at::parallel_reduce(
+      0, 10000, 100, (int64_t)0,
+      [](int64_t begin, int64_t end, int64_t init) {
+        for (int64_t i = begin; i < end; i++) {
+          init += i;
+        }
+        return init;
+      },
+      std::plus<int64_t>());
+  ASSERT_EQ(total, 10000ll * 9999 / 2);
+
+  // every partial and every combine is exactly representable in fp32, so
+  // the result must be exact regardless of chunking or combine order
+  const int64_t n = 1 << 20;
+  auto fsum = at::parallel_reduce(
+      0, n, 4096, 0.0f,
+      [](int64_t begin, int64_t end, float init) {
+        for (int64_t i = begin; i < end; i++) {
+          init += 0.25f;
+        }
+        return init;
+      },
+      std::plus<float>());
+  ASSERT_EQ(fsum, n * 0.25f);
+
+  // degenerate cases: empty range yields the identity, short ranges are
+  // reduced serially
+  ASSERT_EQ(
+      at::parallel_reduce(
+          5, 5, 1, (int64_t)-1,
+          [](int64_t begin, int64_t end, int64_t init) { return init; },
+          std::plus<int64_t>()),
+      -1);
+}
+
+TEST(TestParallel, ThreadBudgetGuard) {
+  ASSERT_EQ(at::get_thread_budget(), 0);
+  {
+    ThreadBudgetGuard guard(2);
+    ASSERT_EQ(at::get_thread_budget(), 2);
+    {
+      // nested guards narrow the budget, never widen it
+      ThreadBudgetGuard inner(4);
+      ASSERT_EQ(at::get_thread_budget(), 2);
+    }
+    {
+      ThreadBudgetGuard inner(1);
+      ASSERT_EQ(at::get_thread_budget(), 1);
+      // results stay correct when the region is forced serial
+      Tensor a = ones({1024, 1024});
+      ASSERT_TRUE(a.sum().equal(a.sum()));
+    }
+    ASSERT_EQ(at::get_thread_budget(), 2);
+  }
+  ASSERT_EQ(at::get_thread_budget(), 0);
+}
+
 TEST(TestParallel, IntraOpLaunchFuture) {
   int v1 = 0;
   int v2 = 0;
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <ATen/native/Workspace.h>
+
+#include <cstdint>
+
+using at::native::Workspace;
+
+TEST(WorkspaceTest, ConsolidatesToHighWaterMark) {
+  at::native::release_workspace();
+  void* first = nullptr;
+  {
+    Workspace workspace;
+    first = workspace.get(1000);
+    void* second = workspace.get(5000);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(first, second);
+  }
+  const auto stats = at::native::workspace_stats();
+  ASSERT_GE(stats.capacity, 6000);
+  ASSERT_GE(stats.high_water_mark, 6000);
+  ASSERT_EQ(stats.requests, 2);
+
+  // A second pass of the same shape bump-allocates out of the consolidated
+  // block without growing the arena.
+  {
+    Workspace workspace;
+    workspace.get(1000);
+    workspace.get(5000);
+  }
+  ASSERT_EQ(at::native::workspace_stats().capacity, stats.capacity);
+}
+
+TEST(WorkspaceTest, NestedHandlesShareArena) {
+  at::native::release_workspace();
+  Workspace outer;
+  void* a = outer.get(128);
+  {
+    Workspace inner;
+    ASSERT_NE(inner.get(128), a);
+  }
+  // The arena only recycles when the outermost handle dies, so pointers
+  // handed out before (or inside) an inner scope stay valid.
+  ASSERT_NE(outer.get(128), a);
+}
+
+TEST(WorkspaceTest, ReturnsAlignedTypedBuffers) {
+  Workspace workspace;
+  double* buffer = workspace.get<double>(3);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer) % 64, 0);
+  // The next request may not overlap the three doubles above.
+  char* next = workspace.get<char>(1);
+  ASSERT_GE(next, reinterpret_cast<char*>(buffer + 3));
+}
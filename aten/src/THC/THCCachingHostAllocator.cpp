@@ -12,9 +12,19 @@
 #include <unordered_set>
 #include <set>
 #include <utility>
+#include <vector>
 
 namespace {
 
+// all allocations are rounded to multiples of this size, mirroring the
+// minimum block size of c10::cuda::CUDACachingAllocator
+constexpr size_t kMinBlockSize = 512;
+
+// requests smaller than this are served from a buffer of this size; the
+// remainder is split off and cached, so repeated small pins share one
+// cudaHostAlloc call
+constexpr size_t kPinnedBuffer = 2097152; // 2 MiB
+
 struct BlockSize
 {
   size_t  size; // allocation size
@@ -28,11 +38,22 @@ struct Block : public BlockSize
   bool  allocated;    // true if the block is currently allocated
   int   event_count;  // number of outstanding cuda events
   std::unordered_set<at::cuda::CUDAStream> streams;
+  Block* prev;        // adjacent block if the cudaHostAlloc region was split
+  Block* next;
 
   Block(size_t size, void* ptr, bool allocated) :
-      BlockSize(size, ptr), allocated(allocated), event_count(0), streams() {}
+      BlockSize(size, ptr), allocated(allocated), event_count(0), streams(),
+      prev(NULL), next(NULL) {}
 };
 
+static size_t roundSize(size_t size)
+{
+  if (size < kMinBlockSize) {
+    return kMinBlockSize;
+  }
+  return kMinBlockSize * ((size + kMinBlockSize - 1) / kMinBlockSize);
+}
+
 static bool BlockComparator(const BlockSize& a, const BlockSize& b)
 {
   // sort by size, break ties with pointer
@@ -70,15 +91,19 @@ struct HostAllocator
       return err;
     }
 
+    // round to limit fragmentation of the cache and improve reuse
+    size = roundSize(size);
+
     // search for the smallest block which can hold this allocation
     BlockSize search_key(size);
     auto it = available.lower_bound(search_key);
     if (it != available.end()) {
       Block& block = blocks.at(it->ptr);
       THAssert(!block.allocated && block.event_count == 0);
+      available.erase(it);
+      splitBlock(block, size);
       block.allocated = true;
       *ptr = block.ptr;
-      available.erase(it);
       return cudaSuccess;
     }
 
@@ -93,16 +118,20 @@ struct HostAllocator
       device_guard.reset_device(at::Device(at::DeviceType::CUDA, *primary_ctx_device_index));
     }
 
-    // note that cudaHostAlloc may not touch pointer if size is 0
     *ptr = 0;
 
-    // allocate a new block if no cached allocation is found
-    err = cudaHostAlloc(ptr, size, cudaHostAllocDefault);
+    // allocate a new block if no cached allocation is found. Small requests
+    // are backed by a larger buffer whose tail is split off and cached, so a
+    // burst of small pins costs a single cudaHostAlloc; the halves are
+    // coalesced again once both are unused.
+    size_t alloc_size = size < kPinnedBuffer ? kPinnedBuffer : size;
+    err = cudaHostAlloc(ptr, alloc_size, cudaHostAllocDefault);
     if (err != cudaSuccess) {
       return err;
     }
 
-    blocks.insert({*ptr, Block(size, *ptr, true)});
+    Block& block = blocks.insert({*ptr, Block(alloc_size, *ptr, true)}).first->second;
+    splitBlock(block, size);
     return cudaSuccess;
   }
 
@@ -138,7 +167,7 @@ struct HostAllocator
 
     if (block.event_count == 0) {
       // the block can be re-used if there are no outstanding cuda events
-      available.insert(block);
+      available.insert(*mergeWithNeighbors(&block));
     }
     return cudaSuccess;
   }
@@ -185,7 +214,7 @@ struct HostAllocator
       Block& block = blocks.at(e.second);
       block.event_count--;
       if (block.event_count == 0 && !block.allocated) {
-        available.insert(block);
+        available.insert(*mergeWithNeighbors(&block));
       }
       cuda_events.pop_front();
     }
@@ -212,18 +241,89 @@ struct HostAllocator
     // clear list of available blocks
     available.clear();
 
-    // free and erase non-allocated blocks
+    // coalesce adjacent free sub-blocks so fully unused regions become
+    // whole blocks again and can be returned to the driver
+    std::vector<void*> candidates;
+    candidates.reserve(blocks.size());
+    for (auto& entry : blocks) {
+      candidates.push_back(entry.first);
+    }
+    for (void* candidate : candidates) {
+      auto it = blocks.find(candidate);
+      if (it == blocks.end() || it->second.allocated || it->second.event_count != 0) {
+        // already merged into a neighbor, or still in use
+        continue;
+      }
+      mergeWithNeighbors(&it->second);
+    }
+
+    // free and erase whole unused regions; free sub-blocks whose siblings
+    // are still allocated cannot be returned and stay cached
     for (auto it = blocks.begin(); it != blocks.end();) {
       Block& block = it->second;
-      if (!block.allocated) {
+      if (!block.allocated && block.event_count == 0 && !block.prev && !block.next) {
         THCudaCheckWarn(cudaFreeHost(block.ptr));
         it = blocks.erase(it);
       } else {
+        if (!block.allocated && block.event_count == 0) {
+          available.insert(block);
+        }
         ++it;
       }
     }
   }
 
+  // Carve the tail of 'block' off into a separate cached block if what would
+  // remain after serving 'size' bytes is large enough to be useful. The caller
+  // must have removed 'block' from 'available' (its size changes here).
+  void splitBlock(Block& block, size_t size)
+  {
+    if (block.size - size < kMinBlockSize) {
+      return;
+    }
+    void* remaining_ptr = static_cast<char*>(block.ptr) + size;
+    Block& remaining = blocks.insert(
+        {remaining_ptr, Block(block.size - size, remaining_ptr, false)}).first->second;
+    remaining.prev = &block;
+    remaining.next = block.next;
+    if (remaining.next) {
+      remaining.next->prev = &remaining;
+    }
+    block.next = &remaining;
+    block.size = size;
+    available.insert(remaining);
+  }
+
+  // Merge 'block' with any adjacent sub-blocks of the same cudaHostAlloc
+  // region that are also unused and have no outstanding events. 'block' must
+  // not be in 'available'; merged-away neighbors are removed from it. Returns
+  // the surviving block.
+  Block* mergeWithNeighbors(Block* block)
+  {
+    Block* prev = block->prev;
+    if (prev && !prev->allocated && prev->event_count == 0) {
+      available.erase(BlockSize(prev->size, prev->ptr));
+      prev->size += block->size;
+      prev->next = block->next;
+      if (prev->next) {
+        prev->next->prev = prev;
+      }
+      blocks.erase(block->ptr);
+      block = prev;
+    }
+    Block* next = block->next;
+    if (next && !next->allocated && next->event_count == 0) {
+      available.erase(BlockSize(next->size, next->ptr));
+      block->size += next->size;
+      block->next = next->next;
+      if (block->next) {
+        block->next->prev = block;
+      }
+      blocks.erase(next->ptr);
+    }
+    return block;
+  }
+
   cudaError_t insertEvents(Block& block)
   {
     cudaError_t err;
@@ -1,5 +1,12 @@
 #include <c10/core/CPUAllocator.h>
 #include <c10/core/DeviceType.h>
+#include <c10/core/MemoryTracer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
 
 // TODO: rename flags to C10
 C10_DEFINE_bool(
@@ -17,8 +24,40 @@ C10_DEFINE_bool(
     false,
     "If set, fill memory with deterministic junk when allocating on CPU");
 
+C10_DEFINE_bool(
+    caffe2_cpu_allocator_wide_alignment,
+    false,
+    "If set, align CPU allocations to 128 bytes (an AVX-512 register pair / "
+    "two cache lines) instead of the default 64 bytes");
+
 namespace c10 {
 
+namespace {
+// Placement policy consulted by alloc_cpu; both fields are only written
+// through SetNUMAPlacementPolicy and read on the allocation path, hence
+// the relaxed atomics.
+std::atomic<NUMAPlacementPolicy> numa_placement_policy{
+    NUMAPlacementPolicy::LOCAL};
+std::atomic<int> numa_placement_node{-1};
+} // namespace
+
+void SetNUMAPlacementPolicy(NUMAPlacementPolicy policy, int numa_node_id) {
+  if (policy == NUMAPlacementPolicy::BIND) {
+    CAFFE_ENFORCE_GE(
+        numa_node_id, 0, "NUMAPlacementPolicy::BIND requires a valid node id");
+  }
+  numa_placement_node.store(numa_node_id, std::memory_order_relaxed);
+  numa_placement_policy.store(policy, std::memory_order_relaxed);
+}
+
+NUMAPlacementPolicy GetNUMAPlacementPolicy() {
+  return numa_placement_policy.load(std::memory_order_relaxed);
+}
+
+int GetNUMAPlacementNode() {
+  return numa_placement_node.load(std::memory_order_relaxed);
+}
+
 void memset_junk(void* data, size_t num) {
   // This garbage pattern is NaN when interpreted as floating point values,
   // or as very large integer values.
@@ -46,13 +85,15 @@ void* alloc_cpu(size_t nbytes) {
     ((ptrdiff_t)nbytes) >= 0,
     "alloc_cpu() seems to have been called with negative number: ", nbytes);
 
+  const size_t alignment =
+      FLAGS_caffe2_cpu_allocator_wide_alignment ? gWideAlignment : gAlignment;
   void* data;
 #ifdef __ANDROID__
-  data = memalign(gAlignment, nbytes);
+  data = memalign(alignment, nbytes);
 #elif defined(_MSC_VER)
-  data = _aligned_malloc(nbytes, gAlignment);
+  data = _aligned_malloc(nbytes, alignment);
 #else
-  int err = posix_memalign(&data, gAlignment, nbytes);
+  int err = posix_memalign(&data, alignment, nbytes);
   if (err != 0) {
     CAFFE_THROW(
         "DefaultCPUAllocator: can't allocate memory: you tried to allocate ",
@@ -71,8 +112,19 @@ void* alloc_cpu(size_t nbytes) {
       nbytes,
       " bytes. Buy new RAM!");
 
-  // move data to a thread's NUMA node
-  NUMAMove(data, nbytes, GetCurrentNUMANode());
+  // place data according to the configured NUMA policy; by default it is
+  // moved to the allocating thread's NUMA node
+  switch (GetNUMAPlacementPolicy()) {
+    case NUMAPlacementPolicy::LOCAL:
+      NUMAMove(data, nbytes, GetCurrentNUMANode());
+      break;
+    case NUMAPlacementPolicy::BIND:
+      NUMAMove(data, nbytes, GetNUMAPlacementNode());
+      break;
+    case NUMAPlacementPolicy::INTERLEAVE:
+      NUMAInterleave(data, nbytes);
+      break;
+  }
   CHECK(
       !FLAGS_caffe2_cpu_allocator_do_zero_fill ||
       !FLAGS_caffe2_cpu_allocator_do_junk_fill)
@@ -108,15 +160,26 @@ class C10_API MemoryAllocationReporter {
   size_t allocated_;
 };
 
+MemoryAllocationReporter& global_memory_reporter() {
+  static MemoryAllocationReporter reporter_;
+  return reporter_;
+}
+
 struct C10_API DefaultCPUAllocator final : at::Allocator {
   DefaultCPUAllocator() {}
   ~DefaultCPUAllocator() override {}
   at::DataPtr allocate(size_t nbytes) const override {
     void* data = alloc_cpu(nbytes);
+    if (nbytes > 0 && memory_tracing::enabled()) {
+      memory_tracing::recordAlloc(data, nbytes, at::DeviceType::CPU);
+    }
     if (FLAGS_caffe2_report_cpu_memory_usage && nbytes > 0) {
       getMemoryAllocationReporter().New(data, nbytes);
       return {data, data, &ReportAndDelete, at::Device(at::DeviceType::CPU)};
     }
+    if (memory_tracing::enabled()) {
+      return {data, data, &ReportAndDelete, at::Device(at::DeviceType::CPU)};
+    }
     return {data, data, &free_cpu, at::Device(at::DeviceType::CPU)};
   }
 
@@ -124,12 +187,15 @@ struct C10_API DefaultCPUAllocator final : at::Allocator {
     if (!ptr) {
       return;
     }
-    getMemoryAllocationReporter().Delete(ptr);
+    if (FLAGS_caffe2_report_cpu_memory_usage) {
+      getMemoryAllocationReporter().Delete(ptr);
+    }
+    memory_tracing::recordFree(ptr);
     free_cpu(ptr);
   }
 
   at::DeleterFnPtr raw_deleter() const override {
-    if (FLAGS_caffe2_report_cpu_memory_usage) {
+    if (FLAGS_caffe2_report_cpu_memory_usage || memory_tracing::enabled()) {
       return &ReportAndDelete;
     }
     return &free_cpu;
@@ -137,12 +203,190 @@ struct C10_API DefaultCPUAllocator final : at::Allocator {
 
  protected:
   static MemoryAllocationReporter& getMemoryAllocationReporter() {
-    static MemoryAllocationReporter reporter_;
-    return reporter_;
+    return global_memory_reporter();
   }
 
 };
 
+// Note [CPU arena allocator]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Request-scoped inference creates thousands of small short-lived
+// intermediates per request and malloc contention dominates. The arena
+// allocator serves allocations made inside a CPUArenaScope from a
+// thread-local bump arena: allocation is a pointer bump, individual frees
+// are no-ops, and the scope destructor releases a whole request's
+// intermediates in O(number of arena blocks). Outside a scope the
+// allocator behaves exactly like DefaultCPUAllocator.
+//
+// Tensors allocated inside a scope must not outlive it; this is the
+// caller's contract, as with any arena. Because a DataPtr may be destroyed
+// on a different thread than the one that allocated it, the deleter
+// distinguishes arena-served pointers from fallback allocations through a
+// registry of live block ranges. The registry is only locked on block
+// creation/destruction and on frees, never on the bump-allocation path.
+
+constexpr size_t kArenaMinBlockBytes = 1ULL << 20; // 1 MiB
+constexpr size_t kArenaMaxBlockBytes = 64ULL << 20; // 64 MiB
+
+class ArenaBlockRegistry {
+ public:
+  void insert(void* data, size_t size) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    blocks_[reinterpret_cast<uintptr_t>(data)] = size;
+  }
+
+  void erase(void* data) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    blocks_.erase(reinterpret_cast<uintptr_t>(data));
+  }
+
+  // true if ptr points into a live arena block (possibly an interior pointer)
+  bool contains(void* ptr) {
+    auto addr = reinterpret_cast<uintptr_t>(ptr);
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = blocks_.upper_bound(addr);
+    if (it == blocks_.begin()) {
+      return false;
+    }
+    --it;
+    return addr < it->first + it->second;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<uintptr_t, size_t> blocks_;
+};
+
+ArenaBlockRegistry& arena_block_registry() {
+  static ArenaBlockRegistry registry;
+  return registry;
+}
+
+struct ThreadLocalCPUArena {
+  struct Block {
+    void* data;
+    size_t size;
+    size_t used;
+  };
+
+  std::vector<Block> blocks;
+  size_t scope_depth = 0;
+  size_t next_block_bytes = kArenaMinBlockBytes;
+
+  void* allocate(size_t nbytes) {
+    // Bump by the active allocator alignment so arena allocations carry the
+    // same guarantee as alloc_cpu (block bases come from alloc_cpu already).
+    const size_t alignment = FLAGS_caffe2_cpu_allocator_wide_alignment
+        ? gWideAlignment
+        : gAlignment;
+    nbytes = (nbytes + alignment - 1) & ~(alignment - 1);
+    if (blocks.empty() || blocks.back().size - blocks.back().used < nbytes) {
+      size_t block_bytes = std::max(next_block_bytes, nbytes);
+      void* data = alloc_cpu(block_bytes);
+      arena_block_registry().insert(data, block_bytes);
+      if (FLAGS_caffe2_report_cpu_memory_usage) {
+        global_memory_reporter().New(data, block_bytes);
+      }
+      // The arena is traced at block granularity, matching the reporter.
+      if (memory_tracing::enabled()) {
+        memory_tracing::recordAlloc(data, block_bytes, at::DeviceType::CPU);
+      }
+      blocks.push_back({data, block_bytes, 0});
+      next_block_bytes = std::min(next_block_bytes * 2, kArenaMaxBlockBytes);
+    }
+    auto& block = blocks.back();
+    void* result = static_cast<char*>(block.data) + block.used;
+    block.used += nbytes;
+    return result;
+  }
+
+  // Rolls the arena back to the state captured at scope entry. The first
+  // block is kept cached across outermost scopes to avoid re-allocating it
+  // on every request.
+  void rewind(size_t num_blocks, size_t bytes_used) {
+    while (blocks.size() > num_blocks) {
+      if (num_blocks == 0 && blocks.size() == 1) {
+        blocks[0].used = 0;
+        return;
+      }
+      auto& block = blocks.back();
+      arena_block_registry().erase(block.data);
+      if (FLAGS_caffe2_report_cpu_memory_usage) {
+        global_memory_reporter().Delete(block.data);
+      }
+      memory_tracing::recordFree(block.data);
+      free_cpu(block.data);
+      blocks.pop_back();
+    }
+    if (!blocks.empty()) {
+      blocks.back().used = bytes_used;
+    }
+  }
+};
+
+ThreadLocalCPUArena& cpu_arena() {
+  static thread_local ThreadLocalCPUArena arena;
+  return arena;
+}
+
+static void ArenaAwareDelete(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  if (arena_block_registry().contains(ptr)) {
+    // arena-served pointer; released wholesale when its scope exits
+    return;
+  }
+  if (FLAGS_caffe2_report_cpu_memory_usage) {
+    global_memory_reporter().Delete(ptr);
+  }
+  memory_tracing::recordFree(ptr);
+  free_cpu(ptr);
+}
+
+struct C10_API ArenaCPUAllocator final : at::Allocator {
+  at::DataPtr allocate(size_t nbytes) const override {
+    auto& arena = cpu_arena();
+    void* data;
+    if (arena.scope_depth > 0) {
+      data = nbytes == 0 ? nullptr : arena.allocate(nbytes);
+    } else {
+      data = alloc_cpu(nbytes);
+      if (FLAGS_caffe2_report_cpu_memory_usage && nbytes > 0) {
+        global_memory_reporter().New(data, nbytes);
+      }
+      if (nbytes > 0 && memory_tracing::enabled()) {
+        memory_tracing::recordAlloc(data, nbytes, at::DeviceType::CPU);
+      }
+    }
+    return {data, data, &ArenaAwareDelete, at::Device(at::DeviceType::CPU)};
+  }
+
+  at::DeleterFnPtr raw_deleter() const override {
+    return &ArenaAwareDelete;
+  }
+};
+
+static ArenaCPUAllocator g_arena_cpu_alloc;
+
+at::Allocator* GetArenaCPUAllocator() {
+  return &g_arena_cpu_alloc;
+}
+
+CPUArenaScope::CPUArenaScope() {
+  auto& arena = cpu_arena();
+  arena.scope_depth++;
+  saved_num_blocks_ = arena.blocks.size();
+  saved_bytes_used_ = arena.blocks.empty() ? 0 : arena.blocks.back().used;
+}
+
+CPUArenaScope::~CPUArenaScope() {
+  auto& arena = cpu_arena();
+  TORCH_INTERNAL_ASSERT(arena.scope_depth > 0);
+  arena.scope_depth--;
+  arena.rewind(saved_num_blocks_, saved_bytes_used_);
+}
+
 void NoDelete(void*) {}
 
 at::Allocator* GetCPUAllocator() {
@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include <c10/core/Allocator.h>
+#include <c10/core/alignment.h>
 #include <c10/util/Logging.h>
 #include <c10/util/numa.h>
 
@@ -11,12 +12,11 @@
 C10_DECLARE_bool(caffe2_report_cpu_memory_usage);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_zero_fill);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_junk_fill);
+// If set, alloc_cpu aligns to gWideAlignment (128B) instead of gAlignment.
+C10_DECLARE_bool(caffe2_cpu_allocator_wide_alignment);
 
 namespace c10 {
 
-// Use 64-byte alignment should be enough for computation up to AVX512.
-constexpr size_t gAlignment = 64;
-
 using MemoryDeleter = void (*)(void*);
 
 // A helper function that is basically doing nothing.
@@ -30,6 +30,29 @@ C10_API void memset_junk(void* data, size_t num);
 C10_API void* alloc_cpu(size_t nbytes);
 C10_API void free_cpu(void* data);
 
+// NUMA placement policy applied by alloc_cpu (and hence by every CPU
+// allocator built on top of it). All policies are no-ops when NUMA is not
+// available or not enabled (see IsNUMAEnabled in c10/util/numa.h).
+enum class NUMAPlacementPolicy : uint8_t {
+  // Pages follow the allocating thread's NUMA node (default, first-touch
+  // behavior matching the historical NUMAMove call in alloc_cpu).
+  LOCAL = 0,
+  // Pages are bound to a fixed node set via SetNUMAPlacementPolicy.
+  BIND,
+  // Pages are interleaved across all configured nodes; useful for large
+  // buffers processed by threads on multiple sockets.
+  INTERLEAVE,
+};
+
+// Sets the NUMA placement policy for subsequent CPU allocations.
+// `numa_node_id` is only consulted for NUMAPlacementPolicy::BIND.
+C10_API void SetNUMAPlacementPolicy(
+    NUMAPlacementPolicy policy,
+    int numa_node_id = -1);
+C10_API NUMAPlacementPolicy GetNUMAPlacementPolicy();
+// Returns the node set for NUMAPlacementPolicy::BIND, or -1.
+C10_API int GetNUMAPlacementNode();
+
 // Get the CPU Allocator.
 C10_API at::Allocator* GetCPUAllocator();
 // Sets the CPU allocator to the given allocator: the caller gives away the
@@ -39,4 +62,25 @@ C10_API void SetCPUAllocator(at::Allocator* alloc);
 // Get the Default CPU Allocator
 C10_API at::Allocator* GetDefaultCPUAllocator();
 
+// Get the arena CPU allocator (see Note [CPU arena allocator] in
+// CPUAllocator.cpp). Install it with SetCPUAllocator; allocations made
+// while a CPUArenaScope is alive on the current thread are served from a
+// thread-local bump arena and released wholesale when the scope exits.
+// Outside a scope it behaves like the default allocator.
+C10_API at::Allocator* GetArenaCPUAllocator();
+
+// RAII scope for the thread-local CPU arena. Scopes may nest; each scope
+// rewinds the arena to the state captured at its entry. Tensors allocated
+// inside a scope must not outlive it.
+struct C10_API CPUArenaScope {
+  CPUArenaScope();
+  ~CPUArenaScope();
+  CPUArenaScope(const CPUArenaScope&) = delete;
+  CPUArenaScope& operator=(const CPUArenaScope&) = delete;
+
+ private:
+  size_t saved_num_blocks_;
+  size_t saved_bytes_used_;
+};
+
 } // namespace c10
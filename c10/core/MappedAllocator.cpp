@@ -0,0 +1,162 @@
+#include <c10/core/MappedAllocator.h>
+
+#include <c10/util/Exception.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace c10 {
+
+#ifndef _WIN32
+
+namespace {
+
+struct MmapContext {
+  void* base;
+  size_t size;
+};
+
+void deleteMmapContext(void* ptr) {
+  auto* ctx = static_cast<MmapContext*>(ptr);
+  munmap(ctx->base, ctx->size);
+  delete ctx;
+}
+
+DataPtr wrapMapping(void* base, size_t size) {
+  auto* ctx = new MmapContext{base, size};
+  return DataPtr(base, ctx, &deleteMmapContext, DeviceType::CPU);
+}
+
+void* doMap(
+    int fd,
+    size_t size,
+    const MappedAllocatorOptions& options,
+    bool anonymous) {
+  int prot = PROT_READ | (options.read_only ? 0 : PROT_WRITE);
+  int flags = options.shared ? MAP_SHARED : MAP_PRIVATE;
+  if (anonymous) {
+    flags |= MAP_ANONYMOUS;
+  }
+#ifdef MAP_POPULATE
+  if (options.populate) {
+    flags |= MAP_POPULATE;
+  }
+#endif
+  void* base = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  // MAP_HUGETLB only works for anonymous mappings and needs a reserved
+  // hugetlb pool; when it fails we fall through to an ordinary mapping
+  // and rely on transparent huge pages via madvise below.
+  if (options.hugepages && anonymous) {
+    base = mmap(nullptr, size, prot, flags | MAP_HUGETLB, fd, 0);
+  }
+#endif
+  if (base == MAP_FAILED) {
+    base = mmap(nullptr, size, prot, flags, fd, 0);
+  }
+  TORCH_CHECK(
+      base != MAP_FAILED,
+      "MappedAllocator: mmap of ",
+      size,
+      " bytes failed: ",
+      strerror(errno));
+#ifdef MADV_HUGEPAGE
+  if (options.hugepages) {
+    // Best effort; the kernel may have THP disabled.
+    madvise(base, size, MADV_HUGEPAGE);
+  }
+#endif
+  return base;
+}
+
+} // namespace
+
+DataPtr MappedAllocator::makeDataPtr(
+    size_t size,
+    const MappedAllocatorOptions& options) {
+  TORCH_CHECK(size > 0, "MappedAllocator: refusing to map 0 bytes");
+  TORCH_CHECK(
+      !options.read_only, "anonymous mappings cannot be read-only");
+  void* base = doMap(/*fd=*/-1, size, options, /*anonymous=*/true);
+  return wrapMapping(base, size);
+}
+
+DataPtr MappedAllocator::makeDataPtr(
+    const std::string& filename,
+    size_t size,
+    const MappedAllocatorOptions& options,
+    size_t* actual_size_out) {
+  const int open_flags = options.read_only ? O_RDONLY : (O_RDWR | O_CREAT);
+  const int fd = open(filename.c_str(), open_flags, (mode_t)0600);
+  TORCH_CHECK(
+      fd >= 0,
+      "MappedAllocator: unable to open file <",
+      filename,
+      ">: ",
+      strerror(errno));
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1) {
+    close(fd);
+    TORCH_CHECK(
+        false,
+        "MappedAllocator: unable to stat file <",
+        filename,
+        ">: ",
+        strerror(errno));
+  }
+  if (size == 0) {
+    size = file_stat.st_size;
+  } else if (static_cast<size_t>(file_stat.st_size) < size) {
+    if (options.read_only || ftruncate(fd, size) == -1) {
+      close(fd);
+      TORCH_CHECK(
+          false,
+          "MappedAllocator: file <",
+          filename,
+          "> is smaller than the requested ",
+          size,
+          " bytes");
+    }
+  }
+  if (size == 0) {
+    close(fd);
+    TORCH_CHECK(
+        false, "MappedAllocator: file <", filename, "> is empty");
+  }
+  void* base = doMap(fd, size, options, /*anonymous=*/false);
+  close(fd);
+  if (actual_size_out) {
+    *actual_size_out = size;
+  }
+  return wrapMapping(base, size);
+}
+
+#else // _WIN32
+
+DataPtr MappedAllocator::makeDataPtr(
+    size_t /*size*/,
+    const MappedAllocatorOptions& /*options*/) {
+  TORCH_CHECK(
+      false,
+      "MappedAllocator is not supported on this platform; use THMapAllocator");
+}
+
+DataPtr MappedAllocator::makeDataPtr(
+    const std::string& /*filename*/,
+    size_t /*size*/,
+    const MappedAllocatorOptions& /*options*/,
+    size_t* /*actual_size_out*/) {
+  TORCH_CHECK(
+      false,
+      "MappedAllocator is not supported on this platform; use THMapAllocator");
+}
+
+#endif // _WIN32
+
+} // namespace c10
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <c10/core/Allocator.h>
+#include <c10/macros/Macros.h>
+
+#include <cstddef>
+#include <string>
+
+namespace c10 {
+
+// Options controlling how MappedAllocator maps memory.
+struct C10_API MappedAllocatorOptions {
+  // Map with MAP_SHARED so stores are visible to other processes mapping
+  // the same file (file-backed) or inherited across fork (anonymous).
+  // Private copy-on-write mappings are the default.
+  bool shared = false;
+  // Back the mapping with huge pages. Anonymous mappings first try
+  // MAP_HUGETLB (pre-reserved hugetlb pool); if that fails, or for
+  // file-backed mappings, the region is madvise'd MADV_HUGEPAGE so the
+  // kernel can use transparent huge pages. Large read-mostly tables on 4k
+  // pages otherwise spend a significant fraction of cycles in dTLB misses.
+  bool hugepages = false;
+  // Prefault the whole mapping at creation (MAP_POPULATE) instead of
+  // paying one page fault per page on first touch.
+  bool populate = false;
+  // Map the file PROT_READ only; the file is not created or grown.
+  bool read_only = false;
+};
+
+// Mapped-memory counterpart of the TH mapped-file allocators that is
+// reachable from c10::Allocator-based code: it hands out DataPtrs whose
+// deleter unmaps the region, with no TH dependency. Only anonymous and
+// file-backed POSIX mappings are provided; the fd-passing and shm
+// refcounting features remain in THMapAllocator.
+class C10_API MappedAllocator {
+ public:
+  // Creates an anonymous mapping of `size` bytes.
+  static DataPtr makeDataPtr(
+      size_t size,
+      const MappedAllocatorOptions& options = MappedAllocatorOptions());
+
+  // Maps `filename`. With size == 0 the whole file is mapped; a writable
+  // mapping grows the file to `size` bytes if needed. Returns the mapped
+  // size in *actual_size_out when non-null.
+  static DataPtr makeDataPtr(
+      const std::string& filename,
+      size_t size,
+      const MappedAllocatorOptions& options = MappedAllocatorOptions(),
+      size_t* actual_size_out = nullptr);
+};
+
+} // namespace c10
@@ -0,0 +1,178 @@
+#include <c10/core/MemoryTracer.h>
+
+#include <c10/util/Backtrace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace c10 {
+namespace memory_tracing {
+
+namespace {
+
+struct LiveEntry {
+  int64_t nbytes;
+  DeviceType device;
+  std::string op_name;
+  uint64_t stack_fingerprint;
+};
+
+struct OpEntry {
+  int64_t live_bytes = 0;
+  int64_t peak_bytes = 0;
+  int64_t total_allocated_bytes = 0;
+  int64_t allocation_count = 0;
+};
+
+struct TracerState {
+  std::mutex mutex;
+  int64_t stack_depth = 0;
+  std::unordered_map<const void*, LiveEntry> live;
+  std::unordered_map<std::string, OpEntry> ops;
+  std::unordered_map<uint64_t, std::string> backtraces;
+};
+
+TracerState& state() {
+  static TracerState state_;
+  return state_;
+}
+
+// Fast-path gate; checked before taking the lock on every alloc/free.
+std::atomic<bool> tracing_enabled{false};
+// recordFree must keep draining the live table after disable(), or
+// entries for pointers freed later would linger forever.
+std::atomic<bool> has_recorded{false};
+
+thread_local std::string current_op_name;
+
+uint64_t captureStackFingerprint(int64_t depth, TracerState& s) {
+  if (depth <= 0) {
+    return 0;
+  }
+  // Skip get_backtrace, this frame and the recordAlloc frame.
+  auto backtrace = get_backtrace(
+      /*frames_to_skip=*/3, /*maximum_number_of_frames=*/depth);
+  uint64_t fingerprint = std::hash<std::string>()(backtrace);
+  s.backtraces.emplace(fingerprint, std::move(backtrace));
+  return fingerprint;
+}
+
+} // namespace
+
+void enable(int64_t stack_depth) {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.stack_depth = stack_depth;
+  tracing_enabled.store(true, std::memory_order_relaxed);
+}
+
+void disable() {
+  tracing_enabled.store(false, std::memory_order_relaxed);
+}
+
+bool enabled() {
+  return tracing_enabled.load(std::memory_order_relaxed);
+}
+
+void clear() {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.live.clear();
+  s.ops.clear();
+  s.backtraces.clear();
+  has_recorded.store(false, std::memory_order_relaxed);
+}
+
+void recordAlloc(const void* ptr, int64_t nbytes, DeviceType device) {
+  if (!enabled() || ptr == nullptr || nbytes == 0) {
+    return;
+  }
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  uint64_t fingerprint = captureStackFingerprint(s.stack_depth, s);
+  s.live[ptr] = LiveEntry{nbytes, device, current_op_name, fingerprint};
+  auto& op = s.ops[current_op_name];
+  op.live_bytes += nbytes;
+  op.peak_bytes = std::max(op.peak_bytes, op.live_bytes);
+  op.total_allocated_bytes += nbytes;
+  ++op.allocation_count;
+  has_recorded.store(true, std::memory_order_relaxed);
+}
+
+void recordFree(const void* ptr) {
+  if (!has_recorded.load(std::memory_order_relaxed) || ptr == nullptr) {
+    return;
+  }
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto it = s.live.find(ptr);
+  if (it == s.live.end()) {
+    // Allocated before tracing was enabled (or through an allocator that
+    // is not instrumented for allocation).
+    return;
+  }
+  auto op_it = s.ops.find(it->second.op_name);
+  if (op_it != s.ops.end()) {
+    op_it->second.live_bytes -= it->second.nbytes;
+  }
+  s.live.erase(it);
+}
+
+std::vector<LiveAllocation> liveAllocations() {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  std::vector<LiveAllocation> result;
+  result.reserve(s.live.size());
+  for (const auto& kv : s.live) {
+    LiveAllocation a;
+    a.ptr = kv.first;
+    a.nbytes = kv.second.nbytes;
+    a.device = kv.second.device;
+    a.op_name = kv.second.op_name;
+    a.stack_fingerprint = kv.second.stack_fingerprint;
+    result.push_back(std::move(a));
+  }
+  return result;
+}
+
+std::vector<OpMemoryStats> opStats() {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  std::vector<OpMemoryStats> result;
+  result.reserve(s.ops.size());
+  for (const auto& kv : s.ops) {
+    OpMemoryStats stats;
+    stats.op_name = kv.first;
+    stats.live_bytes = kv.second.live_bytes;
+    stats.peak_bytes = kv.second.peak_bytes;
+    stats.total_allocated_bytes = kv.second.total_allocated_bytes;
+    stats.allocation_count = kv.second.allocation_count;
+    result.push_back(std::move(stats));
+  }
+  std::sort(
+      result.begin(), result.end(), [](const auto& a, const auto& b) {
+        return a.peak_bytes > b.peak_bytes;
+      });
+  return result;
+}
+
+std::string fingerprintBacktrace(uint64_t fingerprint) {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto it = s.backtraces.find(fingerprint);
+  return it != s.backtraces.end() ? it->second : std::string();
+}
+
+void setCurrentOpName(const char* name) {
+  if (name != nullptr) {
+    current_op_name = name;
+  } else {
+    current_op_name.clear();
+  }
+}
+
+} // namespace memory_tracing
+} // namespace c10
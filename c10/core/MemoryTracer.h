@@ -0,0 +1,75 @@
+#pragma once
+
+#include <c10/core/DeviceType.h>
+#include <c10/macros/Macros.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace c10 {
+namespace memory_tracing {
+
+// Structured memory tracing across c10 allocators.
+//
+// When enabled, every allocation and deallocation that goes through an
+// instrumented allocator is recorded in a live-allocation table, tagged
+// with the operator that was running on the allocating thread (set by
+// RecordFunction) and, optionally, with a fingerprint of the C++ call
+// stack. Per-op aggregates track live and peak bytes, so a transient
+// spike can be attributed to the op (and through the fingerprint, the
+// call site) that produced it.
+//
+// Tracing is off by default and the fast-path check is a single relaxed
+// atomic load. Recording takes a global lock and, when a nonzero stack
+// depth is configured, walks the stack - this is a debugging mode, not
+// something to leave on in production.
+
+// Live and peak usage attributed to one op name. Allocations made while
+// no op is active are aggregated under the empty string.
+struct C10_API OpMemoryStats {
+  std::string op_name;
+  int64_t live_bytes = 0;
+  int64_t peak_bytes = 0;
+  int64_t total_allocated_bytes = 0;
+  int64_t allocation_count = 0;
+};
+
+// One outstanding allocation in the live table.
+struct C10_API LiveAllocation {
+  const void* ptr = nullptr;
+  int64_t nbytes = 0;
+  DeviceType device = DeviceType::CPU;
+  std::string op_name;
+  uint64_t stack_fingerprint = 0;
+};
+
+// Starts recording. stack_depth frames of the allocating call stack are
+// hashed into each entry's fingerprint (0 disables stack capture).
+C10_API void enable(int64_t stack_depth = 0);
+// Stops recording; the tables are kept so they can still be queried.
+C10_API void disable();
+C10_API bool enabled();
+// Drops all recorded state.
+C10_API void clear();
+
+// Called by instrumented allocators. recordFree of a pointer that was
+// never recorded is a no-op, so allocators may unconditionally pair the
+// two calls even across enable/disable transitions.
+C10_API void recordAlloc(const void* ptr, int64_t nbytes, DeviceType device);
+C10_API void recordFree(const void* ptr);
+
+// Snapshot of the current live-allocation table.
+C10_API std::vector<LiveAllocation> liveAllocations();
+// Per-op aggregates, sorted by descending peak bytes.
+C10_API std::vector<OpMemoryStats> opStats();
+// Resolves a fingerprint from the live table back to the backtrace that
+// was captured the first time it was seen; empty if unknown.
+C10_API std::string fingerprintBacktrace(uint64_t fingerprint);
+
+// Thread-local tag for subsequent allocations on this thread; nullptr
+// clears it. Maintained by RecordFunction around each op.
+C10_API void setCurrentOpName(const char* name);
+
+} // namespace memory_tracing
+} // namespace c10
@@ -20,6 +20,7 @@ struct C10_API StorageImpl final : public c10::intrusive_ptr_target {
         numel_(numel),
         resizable_(resizable),
         received_cuda_(false),
+        generation_(0),
         allocator_(allocator) {
     if (resizable) {
       AT_ASSERTM(
@@ -211,6 +212,21 @@ struct C10_API StorageImpl final : public c10::intrusive_ptr_target {
     resizable_ = false;
   }
 
+  // Write generation of this storage. It is bumped alongside the tensor
+  // version counter whenever a tensor backed by this storage is written
+  // in-place through the dispatcher (see TensorImpl::bump_version), which
+  // lets framework code prove that the data has not changed since an
+  // earlier read — e.g. the conversion memo cache in
+  // aten/src/ATen/native/TensorConversions.cpp. The tag is advisory:
+  // writes that bypass the dispatcher (raw data() pokes) do not bump it.
+  uint64_t generation() const {
+    return generation_;
+  }
+
+  void bump_generation() {
+    ++generation_;
+  }
+
   // This method can be used only after storage construction and cannot be used
   // to modify storage status
   void set_received_cuda(bool received_cuda) {
@@ -229,6 +245,8 @@ struct C10_API StorageImpl final : public c10::intrusive_ptr_target {
   // Identifies that Storage was received from another process and doesn't have
   // local to process cuda memory allocation
   bool received_cuda_;
+  // See generation() above.
+  uint64_t generation_;
   Allocator* allocator_;
 };
 } // namespace c10
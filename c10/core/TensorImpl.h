@@ -6,6 +6,7 @@
 
 #include <c10/core/Backend.h>
 #include <c10/core/MemoryFormat.h>
+#include <c10/core/alignment.h>
 #include <c10/core/Storage.h>
 #include <c10/core/TensorOptions.h>
 #include <c10/core/DispatchKeySet.h>
@@ -653,6 +654,26 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     return numel() == 0;
   }
 
+  /**
+   * Returns the alignment in bytes of the first element of this tensor,
+   * capped at gWideAlignment (128). Storages from the stock allocators are
+   * at least gAlignment (64) aligned, so base tensors report >= 64 while
+   * views and slices report whatever their byte offset leaves over; kernels
+   * can use this to pick vectorized load paths without touching the data.
+   * Returns 1 when the tensor has no initialized storage (including opaque
+   * layouts that hold no storage at all).
+   */
+  size_t data_alignment() const {
+    if (!has_storage() || !storage_.data() || !dtype_initialized()) {
+      return 1;
+    }
+    uintptr_t addr = reinterpret_cast<uintptr_t>(storage_.data()) +
+        data_type_.itemsize() * storage_offset_;
+    // lowest set bit of the address == largest power of two dividing it
+    uintptr_t alignment = addr & (~addr + 1);
+    return alignment < gWideAlignment ? alignment : gWideAlignment;
+  }
+
   /**
    * Change the size at some dimension.  This DOES NOT update strides;
    * thus, most changes to size will not preserve contiguity.  You probably
@@ -827,6 +848,10 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     return named_tensor_meta_ != nullptr;
   }
 
+  bool has_named_tensor_meta() const {
+    return named_tensor_meta_ != nullptr;
+  }
+
 
   // NOTE [ TensorImpl Shallow-Copying ]
   //
@@ -922,7 +947,39 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
   }
 
   void bump_version() noexcept {
+    if (C10_UNLIKELY(inference_frozen_)) {
+      // Inference-frozen tensors are never saved for backward, so the bump
+      // would only produce atomic traffic; writes to them are bugs and trip
+      // the assert in debug builds (see NOTE [ Inference-frozen tensors ]).
+      TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
+          false, "in-place write to an inference-frozen tensor");
+      return;
+    }
     version_counter_.bump();
+    // Also tag the underlying storage as written, so conversion memoization
+    // can detect staleness (see StorageImpl::generation).
+    if (storage_) {
+      storage_.unsafeGetStorageImpl()->bump_generation();
+    }
+  }
+
+  // NOTE [ Inference-frozen tensors ]
+  //
+  // The version counter lives on a cache line shared by every alias of a
+  // tensor, and every in-place op bumps it atomically. Weights of frozen
+  // inference modules are read concurrently by many serving threads and
+  // are never saved for backward, so no one ever compares their versions;
+  // the bumps are pure cache-line ping-pong. Marking such a tensor
+  // inference-frozen elides the bump entirely. In debug builds an attempted
+  // bump asserts instead, since a write to a frozen weight is a bug.
+  // Set by the freezing pass (torch/csrc/jit/passes/freeze_module.cpp) on
+  // detached aliases so the source module keeps normal version counting.
+  void set_inference_frozen(bool frozen) noexcept {
+    inference_frozen_ = frozen;
+  }
+
+  bool is_inference_frozen() const noexcept {
+    return inference_frozen_;
   }
 
   inline void set_pyobj(PyObject* pyobj) noexcept {
@@ -1613,6 +1670,10 @@ protected:
 
   bool is_wrapped_number_ = false;
 
+  // See NOTE [ Inference-frozen tensors ]: elides version-counter bumps on
+  // read-only inference weights.
+  bool inference_frozen_ = false;
+
   // NOTE [ Metadata Change for a Detached Tensor ]
   //
   // Normally, a user is allowed to change the tensor metadata
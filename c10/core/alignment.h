@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace c10 {
+
+// Use 64-byte alignment should be enough for computation up to AVX512.
+constexpr size_t gAlignment = 64;
+
+// Wider alignment covering a full AVX-512 register pair / two cache lines.
+// Allocations rounded up to this keep every vector lane of a 128-byte
+// access within one allocation-aligned block; opt in with the
+// caffe2_cpu_allocator_wide_alignment flag (see CPUAllocator.h).
+constexpr size_t gWideAlignment = 128;
+
+} // namespace c10
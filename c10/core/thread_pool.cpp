@@ -1,4 +1,5 @@
 #include <c10/core/thread_pool.h>
+#include <c10/util/thread_affinity.h>
 
 namespace c10 {
 
@@ -6,7 +7,8 @@ ThreadPool::ThreadPool(
       int pool_size,
       int numa_node_id,
       std::function<void()> init_thread)
-    : threads_(pool_size < 0 ? defaultNumThreads() : pool_size),
+    : queue_limits_{{0, 0, 0}},
+      threads_(pool_size < 0 ? defaultNumThreads() : pool_size),
       running_(true),
       complete_(true),
       available_(threads_.size()),
@@ -17,6 +19,9 @@ ThreadPool::ThreadPool(
       if (init_thread) {
         init_thread();
       }
+      // confine the worker to the configured CPU list, if any (applied after
+      // init_thread so it wins over the NUMA node binding's CPU mask)
+      ApplyThreadAffinity();
       this->main_loop(i);
     });
   }
@@ -56,18 +61,49 @@ bool ThreadPool::inThreadPool() const {
 }
 
 void ThreadPool::run(const std::function<void()>& func) {
+  run(func, TaskPriority::DEFAULT);
+}
+
+void ThreadPool::run(const std::function<void()>& func, TaskPriority priority) {
   if (threads_.size() == 0) {
     throw std::runtime_error("No threads to run a task");
   }
+  auto tier = static_cast<size_t>(priority);
   std::unique_lock<std::mutex> lock(mutex_);
 
+  // Apply backpressure if this tier is bounded and full.
+  while (queue_limits_[tier] != 0 && tasks_[tier].size() >= queue_limits_[tier]) {
+    queue_space_.wait(lock);
+  }
+
   // Set task and signal condition variable so that a worker thread will
   // wake up and use the task.
-  tasks_.push(task_element_t(func));
+  tasks_[tier].push(task_element_t(func));
   complete_ = false;
   condition_.notify_one();
 }
 
+size_t ThreadPool::queueDepth(TaskPriority priority) const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return tasks_[static_cast<size_t>(priority)].size();
+}
+
+size_t ThreadPool::queueDepth() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  size_t depth = 0;
+  for (const auto& queue : tasks_) {
+    depth += queue.size();
+  }
+  return depth;
+}
+
+void ThreadPool::setQueueLimit(TaskPriority priority, std::size_t limit) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  queue_limits_[static_cast<size_t>(priority)] = limit;
+  // a raised or removed limit may unblock waiting producers
+  queue_space_.notify_all();
+}
+
 void ThreadPool::waitWorkComplete() {
   std::unique_lock<std::mutex> lock(mutex_);
   while (!complete_) {
@@ -76,11 +112,20 @@ void ThreadPool::waitWorkComplete() {
 }
 
 void ThreadPool::main_loop(std::size_t index) {
+  auto all_empty = [this]() {
+    for (const auto& queue : tasks_) {
+      if (!queue.empty()) {
+        return false;
+      }
+    }
+    return true;
+  };
+
   std::unique_lock<std::mutex> lock(mutex_);
   while (running_) {
-    // Wait on condition variable while the task is empty and
+    // Wait on condition variable while all queues are empty and
     // the pool is still running.
-    while (tasks_.empty() && running_) {
+    while (all_empty() && running_) {
       condition_.wait(lock);
     }
     // If pool is no longer running, break out of loop.
@@ -94,8 +139,17 @@ void ThreadPool::main_loop(std::size_t index) {
     // useful in the event that the function contains
     // shared_ptr arguments bound via bind.
     {
-      auto tasks = tasks_.front();
-      tasks_.pop();
+      // Drain higher priority tiers first.
+      size_t tier = 0;
+      while (tasks_[tier].empty()) {
+        ++tier;
+      }
+      auto tasks = tasks_[tier].front();
+      tasks_[tier].pop();
+      if (queue_limits_[tier] != 0) {
+        // A producer may be blocked waiting for room in this tier.
+        queue_space_.notify_one();
+      }
       // Decrement count, indicating thread is no longer available.
       --available_;
 
@@ -117,7 +171,7 @@ void ThreadPool::main_loop(std::size_t index) {
 
       // Increment count, indicating thread is available.
       ++available_;
-      if (tasks_.empty() && available_ == total_) {
+      if (all_empty() && available_ == total_) {
         complete_ = true;
         completed_.notify_one();
       }
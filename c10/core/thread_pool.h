@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <queue>
@@ -14,11 +16,42 @@
 
 namespace c10 {
 
+// Priority tier of a task submitted to a thread pool. Workers always drain
+// higher tiers first, so a burst of BACKGROUND work (e.g. async logging)
+// cannot delay latency-critical tasks queued at HIGH or DEFAULT.
+enum class TaskPriority : uint8_t {
+  HIGH = 0,
+  DEFAULT = 1,
+  BACKGROUND = 2,
+};
+
+constexpr size_t kNumTaskPriorities = 3;
+
 // TODO: move this to C10 and make it C10_API
 class C10_API TaskThreadPoolBase {
  public:
   virtual void run(const std::function<void()>& func) = 0;
 
+  // Pools without priority support fall back to plain FIFO ordering.
+  virtual void run(const std::function<void()>& func, TaskPriority /*priority*/) {
+    run(func);
+  }
+
+  /**
+   * The number of tasks queued at the given priority but not yet picked up
+   * by a worker. Pools that do not track their queue report zero.
+   */
+  virtual size_t queueDepth(TaskPriority /*priority*/) const {
+    return 0;
+  }
+
+  /**
+   * The total number of queued tasks across all priorities.
+   */
+  virtual size_t queueDepth() const {
+    return 0;
+  }
+
   virtual size_t size() const = 0;
 
   /**
@@ -55,11 +88,15 @@ class C10_API ThreadPool : public c10::TaskThreadPoolBase {
         : run_with_id(true), no_id(nullptr), with_id(f) {}
   };
 
-  std::queue<task_element_t> tasks_;
+  // one FIFO queue per priority tier; workers drain lower indices first
+  std::array<std::queue<task_element_t>, kNumTaskPriorities> tasks_;
+  // per-tier queue bounds; 0 means unbounded
+  std::array<std::size_t, kNumTaskPriorities> queue_limits_;
   std::vector<std::thread> threads_;
-  std::mutex mutex_;
+  mutable std::mutex mutex_;
   std::condition_variable condition_;
   std::condition_variable completed_;
+  std::condition_variable queue_space_;
   std::atomic_bool running_;
   bool complete_;
   std::size_t available_;
@@ -84,13 +121,27 @@ class C10_API ThreadPool : public c10::TaskThreadPoolBase {
 
   void run(const std::function<void()>& func) override;
 
+  void run(const std::function<void()>& func, TaskPriority priority) override;
+
+  size_t queueDepth(TaskPriority priority) const override;
+
+  size_t queueDepth() const override;
+
+  /**
+   * Bound the queue of the given priority tier to at most `limit` pending
+   * tasks (0 restores the default of unbounded). When a tier is full,
+   * `run` blocks the submitting thread until a worker makes room, applying
+   * backpressure to bursty producers instead of growing the queue.
+   */
+  void setQueueLimit(TaskPriority priority, std::size_t limit);
+
   template <typename Task>
   void runTaskWithID(Task task) {
     std::unique_lock<std::mutex> lock(mutex_);
 
     // Set task and signal condition variable so that a worker thread will
     // wake up and use the task.
-    tasks_.push(
+    tasks_[static_cast<size_t>(TaskPriority::DEFAULT)].push(
         task_element_t(static_cast<std::function<void(std::size_t)>>(task)));
     complete_ = false;
     condition_.notify_one();
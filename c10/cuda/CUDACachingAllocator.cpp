@@ -1,5 +1,6 @@
 #include <c10/cuda/CUDACachingAllocator.h>
 
+#include <c10/core/MemoryTracer.h>
 #include <c10/cuda/CUDAGuard.h>
 #include <c10/cuda/CUDAException.h>
 #include <c10/cuda/CUDAFunctions.h>
@@ -66,6 +67,12 @@ constexpr size_t kRoundLarge = 2097152;     // round up large allocs to 2 MiB
 
 typedef std::bitset<static_cast<size_t>(StatType::NUM_TYPES)> StatTypes;
 
+// Reserved-vs-total fractions at which watermark callbacks fire, in
+// ascending order.
+constexpr double kWatermarkThresholds[] = {0.8, 0.9, 0.95};
+constexpr int kNumWatermarks =
+    sizeof(kWatermarkThresholds) / sizeof(kWatermarkThresholds[0]);
+
 void update_stat(Stat& stat, int64_t amount) {
   stat.current += amount;
 
@@ -109,18 +116,22 @@ struct Block {
   BlockPool*    pool;        // owning memory pool
   void*         ptr;         // memory address
   bool          allocated;   // in-use flag
+  bool          history_split; // segment has ever been split; stays set when
+                               // the pieces merge back (fragmentation suspect)
   Block*        prev;        // prev block if split from a larger allocation
   Block*        next;        // next block if split from a larger allocation
   int           event_count; // number of outstanding CUDA events
 
   Block(int device, cudaStream_t stream, size_t size, BlockPool* pool, void* ptr) :
     device(device), stream(stream), stream_uses(), size(size), pool(pool),
-    ptr(ptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(ptr), allocated(0), history_split(false), prev(nullptr), next(nullptr),
+    event_count(0) { }
 
   // constructor for search key
   Block(int device, cudaStream_t stream, size_t size) :
     device(device), stream(stream), stream_uses(), size(size), pool(nullptr),
-    ptr(nullptr), allocated(0), prev(nullptr), next(nullptr), event_count(0) { }
+    ptr(nullptr), allocated(0), history_split(false), prev(nullptr),
+    next(nullptr), event_count(0) { }
 
   bool is_split() const {
     return (prev != nullptr) || (next != nullptr);
@@ -175,23 +186,52 @@ class THCCachingAllocator {
   // device statistics
   std::vector<DeviceStats> device_stats;
 
-  // unallocated cached blocks larger than 1 MB
-  BlockPool large_blocks;
-
-  // unallocated cached blocks 1 MB or smaller
-  BlockPool small_blocks;
+  // Free lists are kept per device (see Note [Per-device free lists]).
+  // Within each pool, blocks remain segregated by stream through
+  // BlockComparator's (stream, size, ptr) ordering.
+  struct DevicePools {
+    // unallocated cached blocks larger than 1 MB
+    BlockPool large;
+    // unallocated cached blocks 1 MB or smaller
+    BlockPool small;
+    DevicePools() : large(BlockComparator), small(BlockComparator) {}
+  };
+
+  // Note [Per-device free lists]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Keeping one global pair of free lists forces every lookup to wade
+  // through blocks of all devices and makes all devices share the hottest
+  // part of the allocator state. Segregating the free lists per device
+  // shortens lookups, keeps each pool's working set local, and is the
+  // stepping stone towards finer-grained locking.
+  std::vector<std::unique_ptr<DevicePools>> device_pools;
 
   // allocated blocks by device pointer
   std::unordered_map<void*, Block*> allocated_blocks;
 
+  // bytes currently allocated and high-water mark per allocation stream
+  // (see Note [Watermark notifications and stream high-water marks])
+  std::vector<std::unordered_map<cudaStream_t, Stat>> stream_stats;
+
+  // total device memory, cached on first use (0 = not yet queried)
+  std::vector<int64_t> device_total_memory;
+
+  // highest watermark already notified per device; re-arms when reserved
+  // bytes fall back below the threshold
+  std::vector<int> watermark_level;
+
+  // watermark callbacks by handle
+  std::map<uint64_t, WatermarkCallback> watermark_callbacks;
+  uint64_t next_watermark_handle = 1;
+
+  AllocFailureHandler alloc_failure_handler;
+
   // outstanding cuda events
   std::deque<std::pair<cudaEvent_t, Block*>> cuda_events;
 
  public:
 
-  THCCachingAllocator() :
-      large_blocks(BlockComparator),
-      small_blocks(BlockComparator) {}
+  THCCachingAllocator() {}
 
   std::mutex* getCudaFreeMutex() const {
     return &cuda_free_mutex;
@@ -214,7 +254,7 @@ class THCCachingAllocator {
     size = round_size(size);
 
     Block search_key(device, stream, size);
-    auto& pool = get_pool(size);
+    auto& pool = get_pool(device, size);
 
     DeviceStats& stats = get_stats_for_device(device);
     StatTypes stat_types;
@@ -300,6 +340,8 @@ class THCCachingAllocator {
       remaining = block;
 
       block = new Block(device, stream, size, &pool, block->ptr);
+      block->history_split = true;
+      remaining->history_split = true;
       block->prev = remaining->prev;
       if (block->prev) {
         block->prev->next = block;
@@ -331,10 +373,20 @@ class THCCachingAllocator {
 
     *devPtr = block->ptr;
 
+    // Traced at block granularity: a cache hit is still a new allocation
+    // from the requesting op's point of view.
+    if (memory_tracing::enabled()) {
+      memory_tracing::recordAlloc(
+          block->ptr, block->size, at::DeviceType::CUDA);
+    }
+
     update_stat_array(stats.allocation, 1, stat_types);
     update_stat_array(stats.allocated_bytes, block->size, stat_types);
     update_stat_array(stats.active, 1, stat_types);
     update_stat_array(stats.active_bytes, block->size, stat_types);
+    update_stat(stream_stats_for_device(device)[stream], block->size);
+
+    maybe_notify_watermarks(device, stats);
   }
 
   void free(void* ptr)
@@ -353,12 +405,16 @@ class THCCachingAllocator {
     allocated_blocks.erase(it);
     block->allocated = false;
 
+    memory_tracing::recordFree(ptr);
+
     DeviceStats& stats = get_stats_for_device(block->device);
     StatTypes stat_types;
     stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
     stat_types[static_cast<size_t>(get_stat_type_for_pool(*(block->pool)))] = true;
     update_stat_array(stats.allocation, -1, {stat_types});
     update_stat_array(stats.allocated_bytes, -block->size, {stat_types});
+    update_stat(
+        stream_stats_for_device(block->device)[block->stream], -block->size);
 
     if (!block->stream_uses.empty()) {
       insert_events(block);
@@ -420,15 +476,42 @@ class THCCachingAllocator {
   void emptyCache() {
     std::lock_guard<std::recursive_mutex> lock(mutex);
     synchronize_and_free_events(nullopt);
-    free_blocks(large_blocks, large_blocks.begin(), large_blocks.end());
-    free_blocks(small_blocks, small_blocks.begin(), small_blocks.end());
+    for (auto& pools : device_pools) {
+      if (!pools) {
+        continue;
+      }
+      free_blocks(pools->large, pools->large.begin(), pools->large.end());
+      free_blocks(pools->small, pools->small.begin(), pools->small.end());
+    }
+  }
+
+  /** Returns cached segments that were ever split back to the system
+   *  allocator, keeping pristine cached blocks. Long-running services with
+   *  variable allocation sizes accumulate segments whose split remnants no
+   *  longer match any request size; releasing just those defragments the
+   *  cache between traffic peaks without paying the full emptyCache()
+   *  re-warm cost. **/
+  void releaseFragmentedBlocks() {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    // return event-held blocks to the pools first so whole segments can
+    // merge and become releasable
+    synchronize_and_free_events(nullopt);
+    for (auto& pools : device_pools) {
+      if (!pools) {
+        continue;
+      }
+      release_fragmented_blocks(pools->large);
+      release_fragmented_blocks(pools->small);
+    }
   }
 
   /** Retrieves info (total size + largest block) of the memory cache **/
   void cacheInfo(int dev_id, size_t* total, size_t* largest) {
     std::lock_guard<std::recursive_mutex> lock(mutex);
-    cache_info_aux(large_blocks, dev_id, total, largest);
-    cache_info_aux(small_blocks, dev_id, total, largest);
+    if ((size_t)dev_id < device_pools.size() && device_pools[dev_id]) {
+      cache_info_aux(device_pools[dev_id]->large, total, largest);
+      cache_info_aux(device_pools[dev_id]->small, total, largest);
+    }
   }
 
   /** Returns a copy of the memory allocator stats for the device **/
@@ -472,6 +555,12 @@ class THCCachingAllocator {
       reset_peak_stat(stats.active_bytes[statType]);
       reset_peak_stat(stats.inactive_split_bytes[statType]);
     }
+
+    if ((size_t)dev_id < stream_stats.size()) {
+      for (auto& item : stream_stats[dev_id]) {
+        reset_peak_stat(item.second);
+      }
+    }
   }
 
   /** Dump a complete snapshot of the memory held by the allocator. Potentially VERY expensive. **/
@@ -489,7 +578,7 @@ class THCCachingAllocator {
       SegmentInfo& segment_info = result.back();
       segment_info.device = head_block->device;
       segment_info.address = reinterpret_cast<int64_t>(head_block->ptr);
-      segment_info.is_large = (head_block->pool == &large_blocks);
+      segment_info.is_large = !is_small_pool(head_block->pool);
 
       const Block* block = head_block;
       while (block != nullptr) {
@@ -522,6 +611,39 @@ class THCCachingAllocator {
     return result;
   }
 
+  uint64_t attachWatermarkCallback(WatermarkCallback callback) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    const uint64_t handle = next_watermark_handle++;
+    watermark_callbacks.emplace(handle, std::move(callback));
+    return handle;
+  }
+
+  void removeWatermarkCallback(uint64_t handle) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    watermark_callbacks.erase(handle);
+  }
+
+  void setAllocFailureHandler(AllocFailureHandler handler) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    alloc_failure_handler = std::move(handler);
+  }
+
+  /** Returns the per-stream usage for all streams that allocated on the device **/
+  std::vector<StreamStats> getStreamStatsForDevice(int dev_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    std::vector<StreamStats> result;
+    auto& per_stream = stream_stats_for_device(dev_id);
+    result.reserve(per_stream.size());
+    for (const auto& item : per_stream) {
+      StreamStats entry;
+      entry.stream = reinterpret_cast<uintptr_t>(item.first);
+      entry.current = item.second.current;
+      entry.peak = item.second.peak;
+      result.push_back(entry);
+    }
+    return result;
+  }
+
  private:
 
   // All private methods do not acquire the allocator mutex.
@@ -534,10 +656,77 @@ class THCCachingAllocator {
     return device_stats.at(device);
   }
 
+  std::unordered_map<cudaStream_t, Stat>& stream_stats_for_device(int device) {
+    TORCH_CHECK(device >= 0);
+    if ((size_t)device >= stream_stats.size()) {
+      stream_stats.resize(device + 1);
+    }
+    return stream_stats[device];
+  }
+
+  int64_t total_memory_for_device(int device) {
+    if ((size_t)device >= device_total_memory.size()) {
+      device_total_memory.resize(device + 1, 0);
+    }
+    if (device_total_memory[device] == 0) {
+      cudaDeviceProp prop;
+      C10_CUDA_CHECK(cudaGetDeviceProperties(&prop, device));
+      device_total_memory[device] = static_cast<int64_t>(prop.totalGlobalMem);
+    }
+    return device_total_memory[device];
+  }
+
+  // Note [Watermark notifications and stream high-water marks]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Long-running services want to shed load before the allocator OOMs, not
+  // discover the OOM from a failed request. Watermark callbacks fire inline
+  // on the allocation that pushes reserved bytes across a threshold, so
+  // there is no polling lag; each threshold re-arms once reserved bytes
+  // fall back below it, so a service hovering near a boundary is notified
+  // once per excursion rather than once per allocation. The per-stream
+  // counters give the same monitoring code a cheap answer to "which stream
+  // is responsible": one hash-map update per malloc/free, always on.
+  void maybe_notify_watermarks(int device, DeviceStats& stats) {
+    if ((size_t)device >= watermark_level.size()) {
+      watermark_level.resize(device + 1, -1);
+    }
+    const int64_t reserved =
+        stats.reserved_bytes[static_cast<size_t>(StatType::AGGREGATE)].current;
+    const int64_t total = total_memory_for_device(device);
+    int level = -1;
+    for (int i = 0; i < kNumWatermarks; ++i) {
+      if (reserved >= static_cast<int64_t>(kWatermarkThresholds[i] * total)) {
+        level = i;
+      }
+    }
+    if (level <= watermark_level[device]) {
+      // Below the last notified threshold again (or no change): re-arm.
+      watermark_level[device] = level;
+      return;
+    }
+    watermark_level[device] = level;
+    if (watermark_callbacks.empty()) {
+      return;
+    }
+    WatermarkInfo info;
+    info.device = device;
+    info.threshold = kWatermarkThresholds[level];
+    info.reserved_bytes = reserved;
+    info.device_total = total;
+    for (const auto& item : watermark_callbacks) {
+      item.second(info);
+    }
+  }
+
   std::vector<const Block*> get_all_blocks() const {
     std::vector<const Block*> blocks;
-    blocks.insert(blocks.end(), small_blocks.begin(), small_blocks.end());
-    blocks.insert(blocks.end(), large_blocks.begin(), large_blocks.end());
+    for (const auto& pools : device_pools) {
+      if (!pools) {
+        continue;
+      }
+      blocks.insert(blocks.end(), pools->small.begin(), pools->small.end());
+      blocks.insert(blocks.end(), pools->large.begin(), pools->large.end());
+    }
     for (const auto& item : allocated_blocks) {
       blocks.push_back(item.second);
     }
@@ -611,32 +800,45 @@ class THCCachingAllocator {
     return subsumed_size;
   }
 
-  BlockPool& get_pool(size_t size) {
+  DevicePools& pools_for_device(int device) {
+    TORCH_CHECK(device >= 0);
+    if ((size_t)device >= device_pools.size()) {
+      device_pools.resize(device + 1);
+    }
+    if (!device_pools[device]) {
+      device_pools[device] = std::unique_ptr<DevicePools>(new DevicePools());
+    }
+    return *device_pools[device];
+  }
+
+  BlockPool& get_pool(int device, size_t size) {
+    auto& pools = pools_for_device(device);
     if (size <= kSmallSize) {
-      return small_blocks;
+      return pools.small;
     } else {
-      return large_blocks;
+      return pools.large;
     }
   }
 
-  StatType get_stat_type_for_pool(const BlockPool& pool) {
-    if (&pool == &small_blocks) {
-      return StatType::SMALL_POOL;
-    } else if (&pool == &large_blocks) {
-      return StatType::LARGE_POOL;
-    } else {
-      AT_ERROR("get_stat_type_for_pool: invalid pool");
+  bool is_small_pool(const BlockPool* pool) const {
+    for (const auto& pools : device_pools) {
+      if (pools && &pools->small == pool) {
+        return true;
+      }
     }
+    return false;
+  }
+
+  StatType get_stat_type_for_pool(const BlockPool& pool) {
+    return is_small_pool(&pool) ? StatType::SMALL_POOL : StatType::LARGE_POOL;
   }
 
   bool should_split(const Block* block, size_t size) {
     size_t remaining = block->size - size;
-    if (block->pool == &small_blocks) {
+    if (is_small_pool(block->pool)) {
       return remaining >= kMinBlockSize;
-    } else if (block->pool == &large_blocks) {
-      return remaining > kSmallSize;
     } else {
-      AT_ERROR("should_split: invalid pool");
+      return remaining > kSmallSize;
     }
   }
 
@@ -668,6 +870,16 @@ class THCCachingAllocator {
       DeviceStats& stats = get_stats_for_device(device);
       stats.num_alloc_retries += 1;
       cudaGetLastError();  // reset the last CUDA error
+      if (alloc_failure_handler) {
+        // Give the pre-hook a chance to trim caches or reject the request
+        // (by throwing) before the flush-and-retry below stalls other
+        // threads on the allocator mutex.
+        alloc_failure_handler(
+            device,
+            size,
+            stats.reserved_bytes[static_cast<size_t>(StatType::AGGREGATE)]
+                .current);
+      }
       free_cached_blocks(device);
       err = cudaMalloc(devPtr, size);
       if (err != cudaSuccess) {
@@ -685,17 +897,9 @@ class THCCachingAllocator {
     synchronize_and_free_events(device);
 
     // Free all non-split cached blocks on device
-    Block lower_bound(device, nullptr, 0);
-    Block upper_bound(device + 1, nullptr, 0);
-
-    free_blocks(
-        large_blocks,
-        large_blocks.lower_bound(&lower_bound),
-        large_blocks.lower_bound(&upper_bound));
-    free_blocks(
-        small_blocks,
-        small_blocks.lower_bound(&lower_bound),
-        small_blocks.lower_bound(&upper_bound));
+    auto& pools = pools_for_device(device);
+    free_blocks(pools.large, pools.large.begin(), pools.large.end());
+    free_blocks(pools.small, pools.small.begin(), pools.small.end());
   }
 
   void free_blocks(BlockPool& blocks, BlockPool::iterator it, BlockPool::iterator end)
@@ -723,6 +927,35 @@ class THCCachingAllocator {
     }
   }
 
+  void release_fragmented_blocks(BlockPool& blocks)
+  {
+    // Frees whole free segments that have ever been split. Split remnants
+    // merge back into a single block once all neighbors are freed, but the
+    // history_split mark survives, identifying segments shaped by an
+    // allocation pattern that may no longer recur.
+    auto it = blocks.begin();
+    while (it != blocks.end()) {
+      Block* block = *it;
+      if (!block->prev && !block->next && block->history_split) {
+        C10_CUDA_CHECK(cudaFree((void*)block->ptr));
+
+        DeviceStats& stats = get_stats_for_device(block->device);
+        StatTypes stat_types;
+        stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
+        stat_types[static_cast<size_t>(get_stat_type_for_pool(*(block->pool)))] = true;
+        update_stat_array(stats.segment, -1, stat_types);
+        update_stat_array(stats.reserved_bytes, -block->size, stat_types);
+
+        auto cur = it;
+        ++it;
+        blocks.erase(cur);
+        delete block;
+      } else {
+        ++it;
+      }
+    }
+  }
+
   void synchronize_and_free_events(optional<int> device) {
     // Synchronize on outstanding events and then free associated blocks.
     // Limited to blocks on the given device if specified.
@@ -809,12 +1042,10 @@ class THCCachingAllocator {
     }
   }
 
-  // Accumulates sizes of all memory blocks for given device in given pool
-  void cache_info_aux(BlockPool& blocks, int dev_id, size_t* total, size_t* largest)
+  // Accumulates sizes of all memory blocks in the given per-device pool
+  void cache_info_aux(BlockPool& blocks, size_t* total, size_t* largest)
   {
-    Block search_key(dev_id, 0, 0);
-    auto it = blocks.lower_bound(&search_key);
-    for (; it != blocks.end() && *it && (*it)->device == dev_id; ++it) {
+    for (auto it = blocks.begin(); it != blocks.end(); ++it) {
       size_t blocksize = (*it)->size;
       *total += blocksize;
       if (blocksize > *largest) {
@@ -855,6 +1086,10 @@ void emptyCache(void) {
   caching_allocator.emptyCache();
 }
 
+void releaseFragmentedBlocks(void) {
+  caching_allocator.releaseFragmentedBlocks();
+}
+
 void cacheInfo(int dev_id, size_t* cachedAndFree, size_t* largestBlock) {
   caching_allocator.cacheInfo(dev_id, cachedAndFree, largestBlock);
 }
@@ -898,6 +1133,23 @@ std::vector<SegmentInfo> snapshot() {
   return caching_allocator.snapshot();
 }
 
+uint64_t attachWatermarkCallback(WatermarkCallback callback) {
+  return caching_allocator.attachWatermarkCallback(std::move(callback));
+}
+
+void removeWatermarkCallback(uint64_t handle) {
+  caching_allocator.removeWatermarkCallback(handle);
+}
+
+void setAllocFailureHandler(AllocFailureHandler handler) {
+  caching_allocator.setAllocFailureHandler(std::move(handler));
+}
+
+std::vector<StreamStats> getStreamStats(int device) {
+  assertValidDevice(device);
+  return caching_allocator.getStreamStatsForDevice(device);
+}
+
 //
 // In CUDA IPC, sender sends a tensor to receiver, getIpcDevPtr
 // is called by the receiving process to map the CUDA memory from the sending
@@ -7,7 +7,10 @@
 #include <c10/util/Registry.h>
 
 #include <array>
+#include <cstdint>
+#include <functional>
 #include <mutex>
+#include <vector>
 
 namespace c10 {
 
@@ -87,6 +90,33 @@ struct DeviceStats {
   int64_t num_ooms = 0;
 };
 
+// Passed to watermark callbacks when the reserved memory on a device crosses
+// one of the notification thresholds (fractions of total device memory).
+struct WatermarkInfo {
+  int device = 0;
+  // The threshold that was crossed, e.g. 0.9.
+  double threshold = 0.0;
+  int64_t reserved_bytes = 0;
+  int64_t device_total = 0;
+};
+
+// Per-stream memory usage: bytes currently allocated on the stream and the
+// high-water mark (reset by resetPeakStats).
+struct StreamStats {
+  uintptr_t stream = 0;
+  int64_t current = 0;
+  int64_t peak = 0;
+};
+
+using WatermarkCallback = std::function<void(const WatermarkInfo&)>;
+
+// Called when cudaMalloc first fails, before the allocator flushes its cache
+// and retries. The handler may free memory (the allocator mutex is recursive,
+// so calling back into the allocator from the same thread is safe) or throw
+// to reject the allocation without paying for the flush-and-retry.
+using AllocFailureHandler =
+    std::function<void(int device, size_t alloc_size, int64_t reserved_bytes)>;
+
 // Struct containing info of an allocation block (i.e. a fractional part of a cudaMalloc)..
 struct BlockInfo {
   int64_t size = 0;
@@ -110,6 +140,11 @@ C10_CUDA_API void raw_delete(void* ptr);
 
 C10_CUDA_API Allocator* get();
 C10_CUDA_API void emptyCache();
+// Releases only cached segments that have ever been split (fragmentation
+// suspects), keeping pristine cached blocks warm. Useful for defragmenting
+// long-running services between traffic peaks without the full re-warm
+// cost of emptyCache().
+C10_CUDA_API void releaseFragmentedBlocks();
 C10_CUDA_API void cacheInfo(int dev_id, size_t* cachedAndFree, size_t* largestBlock);
 C10_CUDA_API void* getBaseAllocation(void *ptr, size_t *size);
 C10_CUDA_API void recordStream(const DataPtr&, CUDAStream stream);
@@ -117,6 +152,19 @@ C10_CUDA_API DeviceStats getDeviceStats(int device);
 C10_CUDA_API void resetAccumulatedStats(int device);
 C10_CUDA_API void resetPeakStats(int device);
 C10_CUDA_API std::vector<SegmentInfo> snapshot();
+// Registers a callback invoked whenever the reserved bytes on a device cross
+// one of the watermark thresholds (80/90/95% of total device memory) from
+// below. Returns a handle for removeWatermarkCallback. The callback runs
+// with the allocator mutex held and should be cheap; deferring heavy work
+// (e.g. load shedding) to another thread is recommended.
+C10_CUDA_API uint64_t attachWatermarkCallback(WatermarkCallback callback);
+C10_CUDA_API void removeWatermarkCallback(uint64_t handle);
+// Installs the allocation-failure pre-hook (pass nullptr to remove it).
+C10_CUDA_API void setAllocFailureHandler(AllocFailureHandler handler);
+// Returns the per-stream usage for all streams that have ever allocated on
+// the device. The per-stream counters are always on and O(1) per
+// allocation.
+C10_CUDA_API std::vector<StreamStats> getStreamStats(int device);
 
 C10_CUDA_API std::mutex* getFreeMutex();
 
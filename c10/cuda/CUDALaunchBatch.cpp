@@ -0,0 +1,145 @@
+#include <c10/cuda/CUDALaunchBatch.h>
+
+#include <c10/cuda/CUDAException.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/util/Exception.h>
+
+namespace c10 {
+namespace cuda {
+
+namespace {
+// The batch currently recording on this thread, if any. Capture state is
+// per-thread in the driver, so one recording batch per thread is the
+// natural granularity.
+thread_local CUDALaunchBatch* active_batch = nullptr;
+} // namespace
+
+namespace detail {
+
+void flushLaunchBatch(cudaStream_t stream) {
+  if (active_batch != nullptr && active_batch->recording() &&
+      active_batch->stream().stream() == stream) {
+    active_batch->flush();
+  }
+}
+
+} // namespace detail
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+
+CUDALaunchBatch::CUDALaunchBatch(CUDAStream stream) : stream_(stream) {
+  TORCH_CHECK(
+      active_batch == nullptr,
+      "a CUDALaunchBatch is already recording on this thread");
+  TORCH_CHECK(
+      stream_ != getDefaultCUDAStream(stream_.device_index()),
+      "CUDALaunchBatch cannot record on the default stream; "
+      "use a stream from getStreamFromPool");
+  active_batch = this;
+  beginCapture();
+}
+
+CUDALaunchBatch::CUDALaunchBatch()
+    : CUDALaunchBatch(getCurrentCUDAStream()) {}
+
+CUDALaunchBatch::~CUDALaunchBatch() {
+  try {
+    end();
+    reapRetired(/*wait=*/true);
+  } catch (const std::exception& e) {
+    TORCH_WARN("CUDALaunchBatch destructor failed to submit: ", e.what());
+  }
+  active_batch = nullptr;
+}
+
+void CUDALaunchBatch::flush() {
+  if (recording_) {
+    submit(/*resume=*/true);
+  }
+}
+
+void CUDALaunchBatch::end() {
+  if (recording_) {
+    submit(/*resume=*/false);
+  }
+}
+
+void CUDALaunchBatch::beginCapture() {
+  CUDAGuard guard(stream_.device_index());
+#if CUDA_VERSION >= 10010
+  C10_CUDA_CHECK(
+      cudaStreamBeginCapture(stream_, cudaStreamCaptureModeRelaxed));
+#else
+  // CUDA 10.0 has no capture modes; capture is global
+  C10_CUDA_CHECK(cudaStreamBeginCapture(stream_));
+#endif
+  recording_ = true;
+}
+
+void CUDALaunchBatch::submit(bool resume) {
+  CUDAGuard guard(stream_.device_index());
+  cudaGraph_t graph = nullptr;
+  C10_CUDA_CHECK(cudaStreamEndCapture(stream_, &graph));
+  recording_ = false;
+  if (graph != nullptr) {
+    cudaGraphExec_t exec = nullptr;
+    C10_CUDA_CHECK(cudaGraphInstantiate(&exec, graph, nullptr, nullptr, 0));
+    C10_CUDA_CHECK(cudaGraphDestroy(graph));
+    C10_CUDA_CHECK(cudaGraphLaunch(exec, stream_));
+    // The exec must outlive the launch; retire it behind an event instead
+    // of synchronizing here.
+    cudaEvent_t done = nullptr;
+    C10_CUDA_CHECK(cudaEventCreateWithFlags(&done, cudaEventDisableTiming));
+    C10_CUDA_CHECK(cudaEventRecord(done, stream_));
+    retired_.emplace_back(exec, done);
+  }
+  // Opportunistically free finished graphs while we are not capturing
+  // (event queries are illegal inside a capture in non-relaxed modes).
+  reapRetired(/*wait=*/false);
+  if (resume) {
+    beginCapture();
+  }
+}
+
+void CUDALaunchBatch::reapRetired(bool wait) {
+  std::vector<std::pair<cudaGraphExec_t, cudaEvent_t>> still_running;
+  for (auto& pair : retired_) {
+    cudaError_t err =
+        wait ? cudaEventSynchronize(pair.second) : cudaEventQuery(pair.second);
+    if (err == cudaSuccess) {
+      C10_CUDA_CHECK(cudaGraphExecDestroy(pair.first));
+      C10_CUDA_CHECK(cudaEventDestroy(pair.second));
+    } else if (!wait && err == cudaErrorNotReady) {
+      still_running.push_back(pair);
+    } else {
+      C10_CUDA_CHECK(err);
+    }
+  }
+  retired_.swap(still_running);
+}
+
+#else // CUDA_VERSION < 10000
+
+// Stream capture is unavailable; a batch is inert and launches run eagerly.
+
+CUDALaunchBatch::CUDALaunchBatch(CUDAStream stream) : stream_(stream) {}
+
+CUDALaunchBatch::CUDALaunchBatch()
+    : CUDALaunchBatch(getCurrentCUDAStream()) {}
+
+CUDALaunchBatch::~CUDALaunchBatch() = default;
+
+void CUDALaunchBatch::flush() {}
+
+void CUDALaunchBatch::end() {}
+
+void CUDALaunchBatch::beginCapture() {}
+
+void CUDALaunchBatch::submit(bool /*resume*/) {}
+
+void CUDALaunchBatch::reapRetired(bool /*wait*/) {}
+
+#endif
+
+} // namespace cuda
+} // namespace c10
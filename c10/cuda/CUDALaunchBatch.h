@@ -0,0 +1,77 @@
+#pragma once
+
+#include <c10/cuda/CUDAStream.h>
+
+#include <cuda_runtime_api.h>
+
+#include <utility>
+#include <vector>
+
+namespace c10 {
+namespace cuda {
+
+// Note [Deferred kernel launches]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Eager execution pays the driver's per-launch cost (a few microseconds)
+// for every kernel, which dominates small-model inference. CUDALaunchBatch
+// is a middle path between that and full graph support: while a batch is
+// recording, kernel launches on its stream are captured via CUDA stream
+// capture instead of being submitted; flush() instantiates the captured
+// sequence as a single CUDA graph and hands it to the driver with one
+// launch call. The destructor submits whatever is still recorded.
+//
+// Only launches are deferred. Anything that must observe results - a
+// stream synchronize or query, or a device-to-host copy that ends in one -
+// has to submit the pending batch first. CUDAStream::synchronize() and
+// query() do this automatically for the recording thread (see
+// detail::flushLaunchBatch); flush() is there for explicit control.
+// Recording uses relaxed capture mode where the toolkit supports it, so
+// allocator bookkeeping calls from the recording thread stay legal.
+//
+// The capture machinery needs CUDA >= 10; on older toolkits a batch
+// records nothing and every launch executes eagerly as before. The
+// default (legacy) stream cannot be captured, so a batch must record on a
+// pool or user stream.
+struct C10_CUDA_API CUDALaunchBatch {
+  explicit CUDALaunchBatch(CUDAStream stream);
+  // Records on the current stream of the current device.
+  CUDALaunchBatch();
+  ~CUDALaunchBatch();
+
+  CUDALaunchBatch(const CUDALaunchBatch&) = delete;
+  CUDALaunchBatch& operator=(const CUDALaunchBatch&) = delete;
+
+  /// Submits everything recorded since construction (or the previous
+  /// flush) as one graph launch on the batch's stream, then resumes
+  /// recording.
+  void flush();
+
+  /// Final flush: submits pending work and stops recording, after which
+  /// launches on the stream execute eagerly again. Called by the
+  /// destructor.
+  void end();
+
+  bool recording() const {
+    return recording_;
+  }
+
+  CUDAStream stream() const {
+    return stream_;
+  }
+
+ private:
+  void beginCapture();
+  void submit(bool resume);
+  void reapRetired(bool wait);
+
+  CUDAStream stream_;
+  bool recording_ = false;
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  // instantiated graphs that may still be executing on stream_; each is
+  // destroyed once its trailing event has completed
+  std::vector<std::pair<cudaGraphExec_t, cudaEvent_t>> retired_;
+#endif
+};
+
+} // namespace cuda
+} // namespace c10
@@ -73,6 +73,19 @@ static std::array<LeakyStreamInternals, kStreamsPerPool>
 static std::array<LeakyStreamInternals, kStreamsPerPool>
     high_priority_streams[C10_COMPILE_TIME_MAX_GPUS];
 
+// Privately reserved streams (see CUDAStreamPool in CUDAStream.h). Slots are
+// claimed and returned under private_pool_mutex; the streams themselves are
+// created lazily and, like all others, leaked. A returned slot's stream is
+// reused by the next pool that claims it, which is safe because release
+// quiesces the stream first.
+static std::mutex private_pool_mutex;
+static uint32_t private_slots_in_use[C10_COMPILE_TIME_MAX_GPUS];
+static std::array<LeakyStreamInternals, kStreamsPerPool>
+    private_streams[C10_COMPILE_TIME_MAX_GPUS];
+static_assert(
+    kStreamsPerPool <= 32,
+    "private_slots_in_use bitmask needs one bit per pool slot");
+
 // Note [StreamId assignment]
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~
 // How do we assign stream IDs?
@@ -84,6 +97,7 @@ static std::array<LeakyStreamInternals, kStreamsPerPool>
 //  00 = default stream
 //  01 = low priority stream
 //  10 = high priority stream
+//  11 = privately reserved stream (see CUDAStreamPool)
 //
 // This is not really for efficiency; it's just easier to write the code
 // to extract the index if we do this with bitmasks :)
@@ -104,6 +118,7 @@ enum class StreamIdType : uint8_t {
   DEFAULT = 0x0,
   LOW = 0x1,
   HIGH = 0x2,
+  PRIVATE = 0x3,
 };
 
 std::ostream& operator<<(std::ostream& stream, StreamIdType s) {
@@ -117,6 +132,9 @@ std::ostream& operator<<(std::ostream& stream, StreamIdType s) {
     case StreamIdType::HIGH:
       stream << "HIGH";
       break;
+    case StreamIdType::PRIVATE:
+      stream << "PRIVATE";
+      break;
     default:
       stream << static_cast<uint8_t>(s);
       break;
@@ -178,6 +196,13 @@ static StreamId CUDAStream_getStreamId(const LeakyStreamInternals* ptr) {
         StreamIdType::HIGH, ptr - high_priority_streams[device_index].data());
   }
 
+  // Check if it's a privately reserved stream
+  if (pointer_within<LeakyStreamInternals>(
+          ptr, private_streams[device_index])) {
+    return makeStreamId(
+        StreamIdType::PRIVATE, ptr - private_streams[device_index].data());
+  }
+
   AT_ASSERTM(
       0,
       "Could not compute stream ID for ",
@@ -190,6 +215,13 @@ static StreamId CUDAStream_getStreamId(const LeakyStreamInternals* ptr) {
 // Thread-local current streams
 static thread_local LeakyStreamInternals** current_streams = nullptr;
 
+// Cached stream ids for the entries of current_streams. getCurrentCUDAStream
+// is called many times per op (through guards and kernel launches), and
+// recomputing the id from the internals pointer scans the stream pools; the
+// cache makes the lookup a plain array read. The slots are kept in sync by
+// setCurrentCUDAStream, which every stream change funnels through.
+static thread_local StreamId* current_stream_ids = nullptr;
+
 // Populates global values and creates a default stream for each device.
 // Note: the default stream on each device is signified by a nullptr,
 // and so is not created as usual.
@@ -255,8 +287,10 @@ static void initCUDAStreamsOnce() {
   // Inits current streams (thread local) to default streams
   current_streams =
       (LeakyStreamInternals**)malloc(num_gpus * sizeof(LeakyStreamInternals*));
+  current_stream_ids = (StreamId*)malloc(num_gpus * sizeof(StreamId));
   for (auto i = decltype(num_gpus){0}; i < num_gpus; ++i) {
     current_streams[i] = &default_streams[i];
+    current_stream_ids[i] = makeStreamId(StreamIdType::DEFAULT, 0);
   }
 }
 
@@ -293,6 +327,8 @@ LeakyStreamInternals* CUDAStream_internals(CUDAStream s) {
       return &low_priority_streams[device_index][si];
     case StreamIdType::HIGH:
       return &high_priority_streams[device_index][si];
+    case StreamIdType::PRIVATE:
+      return &private_streams[device_index][si];
     default:
       AT_ASSERTM(
           0,
@@ -345,6 +381,102 @@ CUDAStream getStreamFromPool(
   return CUDAStream_fromInternals(&low_priority_streams[device_index][idx]);
 }
 
+CUDAStreamPool::CUDAStreamPool(size_t num_streams, DeviceIndex device_index) {
+  initCUDAStreamsOnce();
+  if (device_index == -1) {
+    device_index = current_device();
+  }
+  check_gpu(device_index);
+  TORCH_CHECK(num_streams > 0, "CUDAStreamPool needs at least one stream");
+  device_index_ = device_index;
+
+  std::lock_guard<std::mutex> lock(private_pool_mutex);
+  uint32_t& in_use = private_slots_in_use[device_index];
+  std::vector<size_t> slots;
+  for (size_t i = 0; i < kStreamsPerPool && slots.size() < num_streams; ++i) {
+    if (!(in_use & (1u << i))) {
+      slots.push_back(i);
+    }
+  }
+  TORCH_CHECK(
+      slots.size() == num_streams,
+      "Cannot reserve ",
+      num_streams,
+      " private CUDA streams on device ",
+      device_index,
+      "; only ",
+      slots.size(),
+      " of ",
+      kStreamsPerPool,
+      " are free. Release another CUDAStreamPool first.");
+
+  // Switches to the requested device so streams are properly associated
+  // with it.
+  CUDAGuard device_guard{device_index};
+  stream_ids_.reserve(num_streams);
+  for (auto slot : slots) {
+    auto& internals = private_streams[device_index][slot];
+    if (!internals.stream) {
+      internals.device_index = device_index;
+      C10_CUDA_CHECK(
+          cudaStreamCreateWithFlags(&internals.stream, kDefaultFlags));
+    }
+    in_use |= (1u << slot);
+    stream_ids_.push_back(makeStreamId(StreamIdType::PRIVATE, slot));
+  }
+}
+
+CUDAStreamPool::CUDAStreamPool(CUDAStreamPool&& other) noexcept
+    : device_index_(other.device_index_),
+      stream_ids_(std::move(other.stream_ids_)),
+      next_(other.next_) {
+  other.stream_ids_.clear();
+}
+
+CUDAStreamPool::~CUDAStreamPool() {
+  if (stream_ids_.empty()) {
+    // moved-from
+    return;
+  }
+  try {
+    // Event-based quiesce: wait for the work already enqueued on this pool's
+    // streams -- and nothing else -- before handing the slots back.
+    CUDAGuard device_guard{device_index_};
+    for (auto id : stream_ids_) {
+      auto& internals = private_streams[device_index_][streamIdIndex(id)];
+      cudaEvent_t event = nullptr;
+      C10_CUDA_CHECK_WARN(
+          cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+      if (event) {
+        C10_CUDA_CHECK_WARN(cudaEventRecord(event, internals.stream));
+        C10_CUDA_CHECK_WARN(cudaEventSynchronize(event));
+        C10_CUDA_CHECK_WARN(cudaEventDestroy(event));
+      }
+    }
+  } catch (...) { /* No throw */
+  }
+  std::lock_guard<std::mutex> lock(private_pool_mutex);
+  for (auto id : stream_ids_) {
+    private_slots_in_use[device_index_] &=
+        ~(1u << static_cast<uint32_t>(streamIdIndex(id)));
+  }
+}
+
+CUDAStream CUDAStreamPool::stream(size_t idx) const {
+  TORCH_CHECK(
+      idx < stream_ids_.size(),
+      "CUDAStreamPool index ",
+      idx,
+      " out of range for pool of size ",
+      stream_ids_.size());
+  return CUDAStream_fromInternals(
+      &private_streams[device_index_][streamIdIndex(stream_ids_[idx])]);
+}
+
+CUDAStream CUDAStreamPool::next() {
+  return stream(next_++ % stream_ids_.size());
+}
+
 CUDAStream getDefaultCUDAStream(DeviceIndex device_index) {
   initCUDAStreamsOnce();
   if (device_index == -1) {
@@ -359,7 +491,14 @@ CUDAStream getCurrentCUDAStream(DeviceIndex device_index) {
     device_index = current_device();
   }
   check_gpu(device_index);
-  return CUDAStream_fromInternals(current_streams[device_index]);
+  // The id is cached, so the common case does not have to map the internals
+  // pointer back to a pool slot.
+  return CUDAStream(
+      CUDAStream::UNCHECKED,
+      Stream(
+          Stream::UNSAFE,
+          c10::Device(DeviceType::CUDA, device_index),
+          current_stream_ids[device_index]));
 }
 
 void setCurrentCUDAStream(CUDAStream stream) {
@@ -367,6 +506,7 @@ void setCurrentCUDAStream(CUDAStream stream) {
   auto ptr = CUDAStream_internals(stream);
   AT_ASSERT(ptr);
   current_streams[ptr->device_index] = ptr;
+  current_stream_ids[ptr->device_index] = stream.id();
 }
 
 std::ostream& operator<<(std::ostream& stream, const CUDAStream& s) {
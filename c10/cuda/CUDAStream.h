@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 #include <cuda_runtime_api.h>
 
@@ -56,6 +57,13 @@
 namespace c10 {
 namespace cuda {
 
+namespace detail {
+// Defined in CUDALaunchBatch.cpp. If the calling thread is recording a
+// deferred launch batch on `stream`, submit the pending batch before the
+// stream is synchronized or queried; see Note [Deferred kernel launches].
+C10_CUDA_API void flushLaunchBatch(cudaStream_t stream);
+} // namespace detail
+
 // Value object representing a CUDA stream.  This is just a wrapper
 // around c10::Stream, but it comes with a little extra CUDA-specific
 // functionality (conversion to cudaStream_t), and a guarantee that
@@ -103,6 +111,7 @@ public:
 
   bool query() const {
     DeviceGuard guard{stream_.device()};
+    detail::flushLaunchBatch(stream());
     cudaError_t err = cudaStreamQuery(stream());
 
     if (err == cudaSuccess) {
@@ -116,6 +125,7 @@ public:
 
   void synchronize() const {
     DeviceGuard guard{stream_.device()};
+    detail::flushLaunchBatch(stream());
     C10_CUDA_CHECK(cudaStreamSynchronize(stream()));
   }
 
@@ -184,6 +194,58 @@ private:
 CAFFE2_API CUDAStream
 getStreamFromPool(const bool isHighPriority = false, DeviceIndex device = -1);
 
+/**
+ * RAII handle for a private set of CUDA streams.
+ *
+ * getStreamFromPool hands out streams from a fixed, globally shared
+ * round-robin pool, so independent units of work (e.g. concurrent inference
+ * requests) can end up on the same stream and falsely serialize against each
+ * other. A CUDAStreamPool instead reserves streams for exclusive use: while
+ * the handle is alive, no other pool (and no getStreamFromPool call) will
+ * hand out the same streams.
+ *
+ * The streams are ordinary CUDAStreams, so they compose with
+ * CUDAStreamGuard / setCurrentCUDAStream as usual. On destruction the pool
+ * quiesces by recording and waiting on an event per stream -- only work
+ * enqueued on the pool's own streams is waited for, never the whole device
+ * -- and then returns the streams for reuse by later pools.
+ *
+ * The number of reservable streams per device is fixed (same size as the
+ * shared pools); construction throws when no free streams are left.
+ */
+class C10_CUDA_API CUDAStreamPool {
+ public:
+  /// Reserves `num_streams` streams on `device_index` (the current device
+  /// if -1) for exclusive use by this handle.
+  explicit CUDAStreamPool(size_t num_streams, DeviceIndex device_index = -1);
+  ~CUDAStreamPool();
+
+  CUDAStreamPool(const CUDAStreamPool&) = delete;
+  CUDAStreamPool& operator=(const CUDAStreamPool&) = delete;
+  CUDAStreamPool(CUDAStreamPool&& other) noexcept;
+  CUDAStreamPool& operator=(CUDAStreamPool&&) = delete;
+
+  /// Returns the idx-th stream of this pool.
+  CUDAStream stream(size_t idx) const;
+
+  /// Returns the pool's streams in round-robin order, like
+  /// getStreamFromPool does for the shared pool.
+  CUDAStream next();
+
+  size_t size() const {
+    return stream_ids_.size();
+  }
+
+  DeviceIndex device_index() const {
+    return device_index_;
+  }
+
+ private:
+  DeviceIndex device_index_ = -1;
+  std::vector<StreamId> stream_ids_;
+  uint32_t next_ = 0;
+};
+
 /**
  * Get the default CUDA stream, for the passed CUDA device, or for the
  * current device if no device index is passed.  The default stream is
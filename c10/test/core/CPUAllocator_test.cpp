@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <c10/core/CPUAllocator.h>
+
+namespace c10 {
+
+TEST(CPUAllocatorTest, ArenaScopeServesAndReleases) {
+  auto* allocator = GetArenaCPUAllocator();
+  {
+    CPUArenaScope scope;
+    auto a = allocator->allocate(128);
+    auto b = allocator->allocate(4096);
+    ASSERT_NE(a.get(), nullptr);
+    ASSERT_NE(b.get(), nullptr);
+    ASSERT_NE(a.get(), b.get());
+    // arena allocations are aligned like the default allocator
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(a.get()) % gAlignment, 0);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(b.get()) % gAlignment, 0);
+    // writes must not overlap
+    memset(a.get(), 0xaa, 128);
+    memset(b.get(), 0xbb, 4096);
+    ASSERT_EQ(static_cast<unsigned char*>(a.get())[127], 0xaa);
+  }
+}
+
+TEST(CPUAllocatorTest, ArenaScopeNesting) {
+  auto* allocator = GetArenaCPUAllocator();
+  CPUArenaScope outer;
+  auto a = allocator->allocate(64);
+  void* first = nullptr;
+  {
+    CPUArenaScope inner;
+    auto b = allocator->allocate(64);
+    first = b.get();
+  }
+  {
+    CPUArenaScope inner;
+    auto c = allocator->allocate(64);
+    // the inner scope was rewound, so the same arena offset is reused
+    ASSERT_EQ(c.get(), first);
+  }
+  ASSERT_NE(a.get(), nullptr);
+}
+
+TEST(CPUAllocatorTest, ArenaFallbackOutsideScope) {
+  auto* allocator = GetArenaCPUAllocator();
+  // without a scope the allocator behaves like the default one, and the
+  // DataPtr destructor must free the memory without crashing
+  auto a = allocator->allocate(1024);
+  ASSERT_NE(a.get(), nullptr);
+  memset(a.get(), 0, 1024);
+}
+
+TEST(CPUAllocatorTest, ArenaLargeAllocation) {
+  auto* allocator = GetArenaCPUAllocator();
+  CPUArenaScope scope;
+  // larger than any arena block growth step; gets a dedicated block
+  auto a = allocator->allocate(128ULL << 20);
+  ASSERT_NE(a.get(), nullptr);
+  static_cast<char*>(a.get())[0] = 1;
+  static_cast<char*>(a.get())[(128ULL << 20) - 1] = 1;
+}
+
+TEST(CPUAllocatorTest, WideAlignmentFlag) {
+  FLAGS_caffe2_cpu_allocator_wide_alignment = true;
+  for (size_t nbytes : {1, 63, 64, 65, 4096}) {
+    void* data = alloc_cpu(nbytes);
+    ASSERT_NE(data, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(data) % gWideAlignment, 0);
+    free_cpu(data);
+  }
+  // the arena bumps by the wide alignment too; its block base may predate
+  // the flag flip, so only the spacing is asserted here
+  {
+    CPUArenaScope scope;
+    auto* allocator = GetArenaCPUAllocator();
+    auto a = allocator->allocate(1);
+    auto b = allocator->allocate(1);
+    auto distance = reinterpret_cast<uintptr_t>(b.get()) -
+        reinterpret_cast<uintptr_t>(a.get());
+    ASSERT_EQ(distance % gWideAlignment, 0);
+    ASSERT_GT(distance, 0);
+  }
+  FLAGS_caffe2_cpu_allocator_wide_alignment = false;
+}
+
+TEST(CPUAllocatorTest, NUMAPlacementPolicyRoundTrip) {
+  ASSERT_EQ(GetNUMAPlacementPolicy(), NUMAPlacementPolicy::LOCAL);
+  SetNUMAPlacementPolicy(NUMAPlacementPolicy::INTERLEAVE);
+  ASSERT_EQ(GetNUMAPlacementPolicy(), NUMAPlacementPolicy::INTERLEAVE);
+  SetNUMAPlacementPolicy(NUMAPlacementPolicy::BIND, 0);
+  ASSERT_EQ(GetNUMAPlacementPolicy(), NUMAPlacementPolicy::BIND);
+  ASSERT_EQ(GetNUMAPlacementNode(), 0);
+  // BIND without a node id is a caller error
+  ASSERT_ANY_THROW(SetNUMAPlacementPolicy(NUMAPlacementPolicy::BIND));
+  SetNUMAPlacementPolicy(NUMAPlacementPolicy::LOCAL);
+}
+
+TEST(CPUAllocatorTest, AllocationsSucceedUnderAnyNUMAPolicy) {
+  // on non-NUMA machines all policies degrade to plain allocation
+  for (auto policy :
+       {NUMAPlacementPolicy::LOCAL, NUMAPlacementPolicy::INTERLEAVE}) {
+    SetNUMAPlacementPolicy(policy);
+    void* data = alloc_cpu(1 << 20);
+    ASSERT_NE(data, nullptr);
+    memset(data, 0, 1 << 20);
+    free_cpu(data);
+  }
+  SetNUMAPlacementPolicy(NUMAPlacementPolicy::LOCAL);
+}
+
+} // namespace c10
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <c10/core/MappedAllocator.h>
+
+#ifndef _WIN32
+
+namespace c10 {
+
+TEST(MappedAllocatorTest, AnonymousMapping) {
+  MappedAllocatorOptions options;
+  auto ptr = MappedAllocator::makeDataPtr(1 << 20, options);
+  ASSERT_NE(ptr.get(), nullptr);
+  // anonymous mappings are zero-filled and writable
+  auto* data = static_cast<unsigned char*>(ptr.get());
+  ASSERT_EQ(data[0], 0);
+  memset(data, 0xab, 1 << 20);
+  ASSERT_EQ(data[(1 << 20) - 1], 0xab);
+}
+
+TEST(MappedAllocatorTest, AnonymousHugepagesAndPopulate) {
+  // MAP_HUGETLB falls back to a THP-advised mapping when no hugetlb pool
+  // is reserved, so this must succeed on any kernel.
+  MappedAllocatorOptions options;
+  options.hugepages = true;
+  options.populate = true;
+  auto ptr = MappedAllocator::makeDataPtr(4 << 20, options);
+  ASSERT_NE(ptr.get(), nullptr);
+  memset(ptr.get(), 0xcd, 4 << 20);
+}
+
+TEST(MappedAllocatorTest, FileBackedMapping) {
+  std::string path = std::tmpnam(nullptr);
+  {
+    std::ofstream out(path, std::ios::binary);
+    for (int i = 0; i < 256; ++i) {
+      out.put(static_cast<char>(i));
+    }
+  }
+  MappedAllocatorOptions options;
+  options.read_only = true;
+  size_t actual_size = 0;
+  auto ptr = MappedAllocator::makeDataPtr(path, 0, options, &actual_size);
+  ASSERT_EQ(actual_size, 256);
+  auto* data = static_cast<unsigned char*>(ptr.get());
+  ASSERT_EQ(data[0], 0);
+  ASSERT_EQ(data[255], 255);
+  ptr.clear();
+  std::remove(path.c_str());
+}
+
+TEST(MappedAllocatorTest, WritableMappingGrowsFile) {
+  std::string path = std::tmpnam(nullptr);
+  {
+    MappedAllocatorOptions options;
+    options.shared = true;
+    auto ptr = MappedAllocator::makeDataPtr(path, 4096, options);
+    memset(ptr.get(), 0x11, 4096);
+  }
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  ASSERT_EQ(in.tellg(), 4096);
+  std::remove(path.c_str());
+}
+
+} // namespace c10
+
+#endif // !_WIN32
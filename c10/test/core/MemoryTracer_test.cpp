@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/core/MemoryTracer.h>
+
+namespace c10 {
+namespace memory_tracing {
+
+namespace {
+
+const OpMemoryStats* findOp(
+    const std::vector<OpMemoryStats>& stats,
+    const std::string& name) {
+  for (const auto& entry : stats) {
+    if (entry.op_name == name) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace
+
+TEST(MemoryTracerTest, AttributesAllocationsToOps) {
+  clear();
+  enable();
+  auto* allocator = GetCPUAllocator();
+
+  setCurrentOpName("op_a");
+  auto a = allocator->allocate(1024);
+  setCurrentOpName("op_b");
+  auto b = allocator->allocate(2048);
+  setCurrentOpName(nullptr);
+
+  auto stats = opStats();
+  const auto* op_a = findOp(stats, "op_a");
+  const auto* op_b = findOp(stats, "op_b");
+  ASSERT_NE(op_a, nullptr);
+  ASSERT_NE(op_b, nullptr);
+  EXPECT_EQ(op_a->live_bytes, 1024);
+  EXPECT_EQ(op_a->peak_bytes, 1024);
+  EXPECT_EQ(op_a->allocation_count, 1);
+  EXPECT_EQ(op_b->live_bytes, 2048);
+
+  // op_b's allocation shows up in the live table.
+  bool found = false;
+  for (const auto& alloc : liveAllocations()) {
+    if (alloc.ptr == b.get()) {
+      found = true;
+      EXPECT_EQ(alloc.nbytes, 2048);
+      EXPECT_EQ(alloc.op_name, "op_b");
+      EXPECT_EQ(alloc.device, DeviceType::CPU);
+    }
+  }
+  EXPECT_TRUE(found);
+
+  // Freeing drains the live table but keeps the peak.
+  b.clear();
+  stats = opStats();
+  op_b = findOp(stats, "op_b");
+  ASSERT_NE(op_b, nullptr);
+  EXPECT_EQ(op_b->live_bytes, 0);
+  EXPECT_EQ(op_b->peak_bytes, 2048);
+
+  a.clear();
+  disable();
+  clear();
+}
+
+TEST(MemoryTracerTest, PeakTracksTransientSpike) {
+  clear();
+  enable();
+  auto* allocator = GetCPUAllocator();
+
+  setCurrentOpName("spiky_op");
+  {
+    auto transient = allocator->allocate(1 << 20);
+  }
+  auto persistent = allocator->allocate(64);
+  setCurrentOpName(nullptr);
+
+  const auto* op = findOp(opStats(), "spiky_op");
+  ASSERT_NE(op, nullptr);
+  EXPECT_EQ(op->live_bytes, 64);
+  EXPECT_GE(op->peak_bytes, 1 << 20);
+
+  persistent.clear();
+  disable();
+  clear();
+}
+
+TEST(MemoryTracerTest, FreeAfterDisableDrainsLiveTable) {
+  clear();
+  enable();
+  auto* allocator = GetCPUAllocator();
+  auto ptr = allocator->allocate(512);
+  EXPECT_EQ(liveAllocations().size(), 1);
+  disable();
+  ptr.clear();
+  EXPECT_EQ(liveAllocations().size(), 0);
+  clear();
+}
+
+TEST(MemoryTracerTest, StackFingerprintIsCaptured) {
+  clear();
+  enable(/*stack_depth=*/16);
+  auto* allocator = GetCPUAllocator();
+  auto ptr = allocator->allocate(256);
+
+  auto live = liveAllocations();
+  ASSERT_EQ(live.size(), 1);
+  EXPECT_NE(live[0].stack_fingerprint, 0u);
+  // The backtrace the fingerprint was derived from must be resolvable.
+  EXPECT_FALSE(fingerprintBacktrace(live[0].stack_fingerprint).empty());
+
+  ptr.clear();
+  disable();
+  clear();
+}
+
+} // namespace memory_tracing
+} // namespace c10
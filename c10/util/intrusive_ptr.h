@@ -216,6 +216,23 @@ class intrusive_ptr final {
  public:
   using element_type = TTarget;
 
+  // Tag for the borrowing constructor below.
+  struct unsafe_borrow_t {
+    explicit unsafe_borrow_t() = default;
+  };
+
+  /**
+   * Constructs an intrusive_ptr that aliases `raw` WITHOUT touching the
+   * refcount. The resulting pointer *must* be defused with release() before
+   * it is destroyed, otherwise the refcount is decremented once too often.
+   * This exists so that non-owning wrappers (see at::TensorRef) can present
+   * an owning interface on hot paths without atomic traffic; only use it
+   * when an enclosing frame keeps the object alive for the whole lifetime
+   * of the borrow.
+   */
+  explicit intrusive_ptr(unsafe_borrow_t, TTarget* raw) noexcept
+      : target_(raw == nullptr ? NullType::singleton() : raw) {}
+
   intrusive_ptr() noexcept : intrusive_ptr(NullType::singleton()) {}
 
   intrusive_ptr(intrusive_ptr&& rhs) noexcept : target_(rhs.target_) {
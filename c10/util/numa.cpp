@@ -94,6 +94,31 @@ void NUMAMove(void* ptr, size_t size, int numa_node_id) {
       "Could not move memory to a NUMA node");
 }
 
+void NUMAInterleave(void* ptr, size_t size) {
+  if (!IsNUMAEnabled()) {
+    return;
+  }
+  if (GetNumNUMANodes() <= 1) {
+    return;
+  }
+  AT_ASSERT(ptr);
+
+  uintptr_t page_start_ptr =
+      ((reinterpret_cast<uintptr_t>(ptr)) & ~(getpagesize() - 1));
+  ptrdiff_t offset = reinterpret_cast<uintptr_t>(ptr) - page_start_ptr;
+  auto bm = numa_get_mems_allowed();
+  TORCH_CHECK(
+      mbind(
+          reinterpret_cast<void*>(page_start_ptr),
+          size + offset,
+          MPOL_INTERLEAVE,
+          bm->maskp,
+          bm->size + 1,
+          MPOL_MF_MOVE) == 0,
+      "Could not interleave memory across NUMA nodes");
+  numa_bitmask_free(bm);
+}
+
 int GetCurrentNUMANode() {
   if (!IsNUMAEnabled()) {
     return -1;
@@ -123,6 +148,9 @@ int GetNumNUMANodes() {
 void NUMAMove(void* ptr, size_t size, int numa_node_id) {
 }
 
+void NUMAInterleave(void* ptr, size_t size) {
+}
+
 int GetCurrentNUMANode() {
   return -1;
 }
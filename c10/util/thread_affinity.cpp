@@ -0,0 +1,76 @@
+#include <c10/util/thread_affinity.h>
+
+#include <c10/util/Exception.h>
+
+#include <mutex>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace c10 {
+
+namespace {
+
+std::mutex affinity_mutex;
+std::vector<int> affinity_cpus;
+
+} // namespace
+
+void SetThreadAffinityCPUs(const std::vector<int>& cpus) {
+#if defined(__linux__)
+  for (auto cpu : cpus) {
+    TORCH_CHECK(
+        cpu >= 0 && cpu < CPU_SETSIZE,
+        "SetThreadAffinityCPUs: invalid CPU id ",
+        cpu);
+  }
+#endif
+  std::lock_guard<std::mutex> guard(affinity_mutex);
+  affinity_cpus = cpus;
+}
+
+std::vector<int> GetThreadAffinityCPUs() {
+  std::lock_guard<std::mutex> guard(affinity_mutex);
+  return affinity_cpus;
+}
+
+void ApplyThreadAffinity() {
+#if defined(__linux__)
+  std::vector<int> cpus = GetThreadAffinityCPUs();
+  if (cpus.empty()) {
+    return;
+  }
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (auto cpu : cpus) {
+    CPU_SET(cpu, &mask);
+  }
+  // sched_setaffinity on pid 0 pins the calling thread only; failure (e.g.
+  // all listed CPUs excluded by the enclosing cpuset) leaves the thread
+  // where it was rather than killing the pool.
+  if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+    TORCH_WARN_ONCE(
+        "ApplyThreadAffinity: sched_setaffinity failed; the configured CPU "
+        "list may be disjoint from the enclosing cpuset");
+  }
+#endif
+}
+
+std::vector<int> GetCurrentThreadAffinity() {
+  std::vector<int> cpus;
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &mask)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return cpus;
+}
+
+} // namespace c10
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+#include <vector>
+
+namespace c10 {
+
+// Configures the CPU list that pool worker threads (intra-op and inter-op)
+// are confined to. Workers apply the list when they start up, so this should
+// be called before the pools are lazily spawned by the first parallel region
+// (or interop task). The list uses the kernel's CPU numbering, i.e. what a
+// cgroup cpuset or taskset would name. An empty list clears the confinement
+// for threads started afterwards.
+C10_API void SetThreadAffinityCPUs(const std::vector<int>& cpus);
+
+// Returns the configured CPU list (empty if unset).
+C10_API std::vector<int> GetThreadAffinityCPUs();
+
+// Applies the configured CPU list to the calling thread. No-op when no list
+// is configured or affinity is unsupported on this platform.
+C10_API void ApplyThreadAffinity();
+
+// Returns the CPUs the calling thread is currently allowed to run on, as
+// reported by the scheduler (empty when unsupported). This reflects the
+// effective placement, including confinement applied by an enclosing cgroup.
+C10_API std::vector<int> GetCurrentThreadAffinity();
+
+} // namespace c10
@@ -1,9 +1,12 @@
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <cerrno>
 #include <istream>
 #include <ostream>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 #include <c10/core/Allocator.h>
 #include <c10/core/Backend.h>
@@ -13,6 +16,7 @@
 #include "caffe2/serialize/file_adapter.h"
 #include "caffe2/serialize/inline_container.h"
 #include "caffe2/serialize/istream_adapter.h"
+#include "caffe2/serialize/mmap_adapter.h"
 #include "caffe2/serialize/read_adapter_interface.h"
 
 #include "miniz.h"
@@ -73,6 +77,11 @@ void PyTorchStreamReader::init() {
   AT_ASSERT(ar_ != nullptr);
   memset(ar_.get(), 0, sizeof(mz_zip_archive));
 
+  // reading through a memory mapping enables the zero-copy path in getRecord
+  if (auto* mmap_in = dynamic_cast<MmapFileAdapter*>(in_.get())) {
+    mapped_file_ = mmap_in->file();
+  }
+
   size_t size = in_->size();
 
   // check for the old magic number,
@@ -217,6 +226,26 @@ std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getRecord(const std::string
   mz_zip_archive_file_stat stat;
   mz_zip_reader_file_stat(ar_.get(), key, &stat);
   valid("retrieving file meta-data for ", name.c_str());
+
+  // Zero-copy path: stored (uncompressed) records in a memory-mapped archive
+  // are returned as aliases of the mapped copy-on-write pages rather than
+  // copied into a fresh buffer. Each DataPtr keeps a reference to the
+  // mapping, so the aliased storage stays valid after the reader is gone.
+  if (mapped_file_ != nullptr && stat.m_method == 0) {
+    size_t offset = getRecordOffset(name);
+    void* data = const_cast<char*>(
+        static_cast<const char*>(mapped_file_->data()) + offset);
+    auto* ctx = new std::shared_ptr<MemoryMappedFile>(mapped_file_);
+    at::DataPtr retval(
+        data,
+        ctx,
+        [](void* ctx) {
+          delete static_cast<std::shared_ptr<MemoryMappedFile>*>(ctx);
+        },
+        at::kCPU);
+    return std::make_tuple(std::move(retval), stat.m_uncomp_size);
+  }
+
   void * ptr = malloc(stat.m_uncomp_size);
   mz_zip_reader_extract_to_mem(ar_.get(), key, ptr, stat.m_uncomp_size, 0);
   valid("reading file ", name.c_str());
@@ -309,6 +338,107 @@ void PyTorchStreamWriter::setup(const string& file_name) {
   writeRecord("version", version.c_str(), version.size());
 }
 
+namespace {
+
+// The CRC32 pass over large stored (uncompressed) records is the dominant CPU
+// cost when writing checkpoints, and miniz computes it serially. CRC32 is
+// linear over GF(2), so partial CRCs of adjacent chunks can be computed on
+// separate threads and stitched together with the standard zlib
+// crc32_combine construction below.
+
+uint32_t gf2_matrix_times(const uint32_t* mat, uint32_t vec) {
+  uint32_t sum = 0;
+  while (vec) {
+    if (vec & 1) {
+      sum ^= *mat;
+    }
+    vec >>= 1;
+    mat++;
+  }
+  return sum;
+}
+
+void gf2_matrix_square(uint32_t* square, const uint32_t* mat) {
+  for (int n = 0; n < 32; n++) {
+    square[n] = gf2_matrix_times(mat, mat[n]);
+  }
+}
+
+// Returns the CRC32 of the concatenation of two blocks, given the CRC32 of
+// each block and the length of the second one.
+uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
+  if (len2 == 0) {
+    return crc1;
+  }
+  uint32_t even[32]; // even-power-of-two zero operators
+  uint32_t odd[32]; // odd-power-of-two zero operators
+
+  // put operator for one zero bit in odd
+  odd[0] = 0xedb88320UL; // CRC32 polynomial
+  uint32_t row = 1;
+  for (int n = 1; n < 32; n++) {
+    odd[n] = row;
+    row <<= 1;
+  }
+
+  // put operator for two zero bits in even, four zero bits in odd
+  gf2_matrix_square(even, odd);
+  gf2_matrix_square(odd, even);
+
+  // apply len2 zeros to crc1 (first square will put the operator for one
+  // zero byte, eight zero bits, in even)
+  do {
+    gf2_matrix_square(even, odd);
+    if (len2 & 1) {
+      crc1 = gf2_matrix_times(even, crc1);
+    }
+    len2 >>= 1;
+    if (len2 == 0) {
+      break;
+    }
+    gf2_matrix_square(odd, even);
+    if (len2 & 1) {
+      crc1 = gf2_matrix_times(odd, crc1);
+    }
+    len2 >>= 1;
+  } while (len2 != 0);
+
+  return crc1 ^ crc2;
+}
+
+// Records smaller than this are not worth spawning threads for.
+constexpr size_t kParallelCrcMinSize = 1 << 23; // 8MB
+constexpr size_t kCrcBytesPerThread = 1 << 22; // 4MB
+
+uint32_t parallel_crc32(const uint8_t* data, size_t size) {
+  size_t num_threads = std::min<size_t>(
+      std::max<size_t>(std::thread::hardware_concurrency(), 1),
+      size / kCrcBytesPerThread);
+  size_t chunk_size = (size + num_threads - 1) / num_threads;
+  std::vector<uint32_t> crcs(num_threads);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t] {
+      size_t begin = t * chunk_size;
+      size_t len = std::min(chunk_size, size - begin);
+      crcs[t] = static_cast<uint32_t>(
+          mz_crc32(MZ_CRC32_INIT, data + begin, len));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  uint32_t crc = crcs[0];
+  for (size_t t = 1; t < num_threads; ++t) {
+    size_t begin = t * chunk_size;
+    crc = crc32_combine(crc, crcs[t], std::min(chunk_size, size - begin));
+  }
+  return crc;
+}
+
+} // namespace
+
 void PyTorchStreamWriter::writeRecord(
     const std::string& name,
     const void* data,
@@ -319,6 +449,30 @@ void PyTorchStreamWriter::writeRecord(
   std::string full_name = archive_name_plus_slash_ + name;
   size_t padding_size =
       getPadding(ar_->m_archive_size, full_name.size(), size, padding_);
+  if (!compress && size >= kParallelCrcMinSize) {
+    // Large stored records skip deflate, so miniz's serial CRC32 pass is the
+    // only per-byte CPU work; precompute the CRC on multiple threads and hand
+    // it to miniz through the precomputed-data path (with level 0 the payload
+    // is still stored verbatim, so the archive layout is unchanged).
+    uint32_t crc = parallel_crc32(static_cast<const uint8_t*>(data), size);
+    mz_zip_writer_add_mem_ex_v2(
+        ar_.get(),
+        full_name.c_str(),
+        data,
+        size,
+        nullptr,
+        0,
+        MZ_ZIP_FLAG_COMPRESSED_DATA,
+        size,
+        crc,
+        nullptr,
+        padding_.c_str(),
+        padding_size,
+        nullptr,
+        0);
+    valid("writing file ", name.c_str());
+    return;
+  }
   uint32_t flags = compress ? MZ_BEST_COMPRESSION : 0;
   mz_zip_writer_add_mem_ex_v2(
       ar_.get(),
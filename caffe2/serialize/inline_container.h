@@ -90,6 +90,8 @@ typedef struct mz_zip_archive mz_zip_archive;
 namespace caffe2 {
 namespace serialize {
 
+class MemoryMappedFile;
+
 constexpr uint64_t kMinSupportedFileFormatVersion = 0x1L;
 constexpr uint64_t kMaxSupportedFileFormatVersion = 0x2L;
 constexpr uint64_t kProducedFileFormatVersion = 0x2L;
@@ -126,6 +128,9 @@ class CAFFE2_API PyTorchStreamReader final {
   std::string archive_name_;
   std::string archive_name_plus_slash_;
   std::unique_ptr<ReadAdapterInterface> in_;
+  // set when in_ is an MmapFileAdapter; getRecord then returns DataPtrs that
+  // alias the mapped pages for records stored uncompressed
+  std::shared_ptr<MemoryMappedFile> mapped_file_;
   int64_t version_;
 };
 
@@ -1,10 +1,12 @@
 #include <cstdio>
 #include <string>
 #include <array>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "caffe2/serialize/inline_container.h"
+#include "caffe2/serialize/mmap_adapter.h"
 
 namespace caffe2 {
 namespace serialize {
@@ -63,6 +65,72 @@ TEST(PyTorchStreamWriterAndReader, SaveAndLoad) {
   ASSERT_EQ(memcmp(the_file.c_str() + off2, data2.data(), data2.size()), 0);
 }
 
+TEST(PyTorchStreamWriterAndReader, LargeRecordParallelCrc) {
+  // Records past the parallel-CRC threshold go through the chunked
+  // multi-threaded CRC32 path; make sure they still round-trip with the
+  // stored method so the reader's zero-copy path keeps working.
+  constexpr size_t kRecordSize = 9 * 1024 * 1024;
+  std::vector<char> big(kRecordSize);
+  uint32_t state = 42;
+  for (size_t i = 0; i < big.size(); ++i) {
+    state = state * 1664525 + 1013904223;
+    big[i] = static_cast<char>(state >> 24);
+  }
+
+  std::ostringstream oss;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    oss.write(static_cast<const char*>(b), n);
+    return oss ? n : 0;
+  });
+  writer.writeRecord("big", big.data(), big.size());
+  writer.writeEndOfFile();
+
+  std::string the_file = oss.str();
+  std::istringstream iss(the_file);
+  PyTorchStreamReader reader(&iss);
+  at::DataPtr data_ptr;
+  int64_t size;
+  std::tie(data_ptr, size) = reader.getRecord("big");
+  ASSERT_EQ(size, big.size());
+  ASSERT_EQ(memcmp(data_ptr.get(), big.data(), big.size()), 0);
+  // stored verbatim: the raw archive bytes contain the record
+  size_t off = reader.getRecordOffset("big");
+  ASSERT_EQ(memcmp(the_file.c_str() + off, big.data(), big.size()), 0);
+}
+
+#ifndef _WIN32
+TEST(PyTorchStreamWriterAndReader, MmapZeroCopyLoad) {
+  std::string file_name = "mmap_test.zip";
+  PyTorchStreamWriter writer(file_name);
+  std::array<char, 256> data;
+  for (int i = 0; i < data.size(); ++i) {
+    data[i] = i;
+  }
+  writer.writeRecord("key1", data.data(), data.size());
+  writer.writeEndOfFile();
+
+  at::DataPtr data_ptr;
+  int64_t size;
+  const void* map_base = nullptr;
+  size_t map_size = 0;
+  {
+    auto adapter = std::make_unique<MmapFileAdapter>(file_name);
+    map_base = adapter->file()->data();
+    map_size = adapter->file()->size();
+    PyTorchStreamReader reader(std::move(adapter));
+    std::tie(data_ptr, size) = reader.getRecord("key1");
+  }
+  ASSERT_EQ(size, data.size());
+  // the record must alias the mapping, not a fresh allocation, and must stay
+  // readable after the reader and adapter are destroyed
+  ASSERT_GE(data_ptr.get(), map_base);
+  ASSERT_LT(
+      data_ptr.get(), static_cast<const char*>(map_base) + map_size);
+  ASSERT_EQ(memcmp(data_ptr.get(), data.data(), data.size()), 0);
+  std::remove(file_name.c_str());
+}
+#endif
+
 } // namespace
 } // namespace serialize
 } // namespace caffe2
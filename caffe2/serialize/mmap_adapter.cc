@@ -0,0 +1,83 @@
+#include "caffe2/serialize/mmap_adapter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <c10/util/Exception.h>
+#include "caffe2/core/common.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace caffe2 {
+namespace serialize {
+
+#ifndef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string& file_name)
+    : data_(nullptr), size_(0) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd == -1) {
+    AT_ERROR("open file failed, file path: ", file_name);
+  }
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    close(fd);
+    AT_ERROR("stat file failed, file path: ", file_name);
+  }
+  size_ = st.st_size;
+  // MAP_PRIVATE makes the mapping copy-on-write: in-place writes to tensors
+  // fault in private copies of the touched pages and never reach the file.
+  // The fd can be closed right away; the mapping keeps the file open.
+  data_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data_ == MAP_FAILED) {
+    data_ = nullptr;
+    AT_ERROR("mmap file failed, file path: ", file_name);
+  }
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string& file_name)
+    : data_(nullptr), size_(0) {
+  AT_ERROR(
+      "memory-mapped loading is not supported on this platform, file path: ",
+      file_name);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {}
+
+#endif
+
+MmapFileAdapter::MmapFileAdapter(const std::string& file_name)
+    : file_(std::make_shared<MemoryMappedFile>(file_name)) {}
+
+size_t MmapFileAdapter::size() const {
+  return file_->size();
+}
+
+size_t MmapFileAdapter::read(uint64_t pos, void* buf, size_t n, const char* what)
+    const {
+  if (pos >= file_->size()) {
+    return 0;
+  }
+  size_t to_read = std::min(n, file_->size() - static_cast<size_t>(pos));
+  memcpy(buf, static_cast<const char*>(file_->data()) + pos, to_read);
+  return to_read;
+}
+
+MmapFileAdapter::~MmapFileAdapter() {}
+
+} // namespace serialize
+} // namespace caffe2
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "c10/macros/Macros.h"
+#include "caffe2/serialize/read_adapter_interface.h"
+
+namespace caffe2 {
+namespace serialize {
+
+// A read-only, copy-on-write memory mapping of a whole file. The mapping is
+// shared: PyTorchStreamReader hands out DataPtrs that alias the mapped pages,
+// and each of them keeps the mapping alive through a shared_ptr, so tensor
+// storages may outlive the reader and the adapter.
+class CAFFE2_API MemoryMappedFile final {
+ public:
+  C10_DISABLE_COPY_AND_ASSIGN(MemoryMappedFile);
+  explicit MemoryMappedFile(const std::string& file_name);
+  ~MemoryMappedFile();
+
+  const void* data() const {
+    return data_;
+  }
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  void* data_;
+  size_t size_;
+};
+
+// ReadAdapterInterface backed by MemoryMappedFile. When a PyTorchStreamReader
+// is constructed with this adapter, records that are stored uncompressed are
+// returned as aliases of the mapped pages instead of being copied into
+// freshly allocated buffers, so loading becomes page-fault driven.
+class CAFFE2_API MmapFileAdapter final : public ReadAdapterInterface {
+ public:
+  C10_DISABLE_COPY_AND_ASSIGN(MmapFileAdapter);
+  explicit MmapFileAdapter(const std::string& file_name);
+  size_t size() const override;
+  size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
+      const override;
+  const std::shared_ptr<MemoryMappedFile>& file() const {
+    return file_;
+  }
+  ~MmapFileAdapter();
+
+ private:
+  std::shared_ptr<MemoryMappedFile> file_;
+};
+
+} // namespace serialize
+} // namespace caffe2
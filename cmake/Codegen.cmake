@@ -117,6 +117,26 @@ if (INTERN_BUILD_ATEN_OPS)
     ENDIF(MSVC)
   ENDIF(CXX_AVX2_FOUND)
 
+  IF(CXX_AVX512_FOUND)
+    SET(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DHAVE_AVX512_CPU_DEFINITION")
+    LIST(APPEND CPU_CAPABILITY_NAMES "AVX512")
+    IF(MSVC)
+      LIST(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG}/arch:AVX512")
+    ELSE(MSVC)
+      LIST(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma")
+    ENDIF(MSVC)
+  ENDIF(CXX_AVX512_FOUND)
+
+  # See Note [Per-op AVX512 opt-in] in aten/src/ATen/native/DispatchStub.h:
+  # AVX512 frequency licensing makes the wider vectors a loss for
+  # compute-bound kernels, so only kernels that are close to pure memory
+  # bandwidth get an AVX512 build. Everything else falls back to its AVX2
+  # kernel at runtime.
+  SET(cpu_kernel_avx512_opt_in
+    "native/cpu/CopyKernel.cpp"
+    "native/cpu/FillKernel.cpp"
+    "native/cpu/ReduceOpsKernel.cpp")
+
   list(LENGTH CPU_CAPABILITY_NAMES NUM_CPU_CAPABILITY_NAMES)
   math(EXPR NUM_CPU_CAPABILITY_NAMES "${NUM_CPU_CAPABILITY_NAMES}-1")
 
@@ -124,6 +144,12 @@ if (INTERN_BUILD_ATEN_OPS)
     FOREACH(IMPL ${cpu_kernel_cpp_in})
       string(REPLACE "${CMAKE_CURRENT_LIST_DIR}/../aten/src/ATen/" "" NAME ${IMPL})
       LIST(GET CPU_CAPABILITY_NAMES ${i} CPU_CAPABILITY)
+      IF("${CPU_CAPABILITY}" STREQUAL "AVX512")
+        LIST(FIND cpu_kernel_avx512_opt_in ${NAME} _avx512_opt_in_index)
+        IF(_avx512_opt_in_index EQUAL -1)
+          CONTINUE()
+        ENDIF()
+      ENDIF()
       SET(NEW_IMPL ${CMAKE_BINARY_DIR}/aten/src/ATen/${NAME}.${CPU_CAPABILITY}.cpp)
       CONFIGURE_FILE(${IMPL} ${NEW_IMPL} COPYONLY)
       SET(cpu_kernel_cpp ${NEW_IMPL} ${cpu_kernel_cpp}) # Create list of copies
@@ -25,6 +25,20 @@ SET(AVX2_CODE "
   }
 ")
 
+SET(AVX512_CODE "
+  #include <immintrin.h>
+
+  int main()
+  {
+    __m512 a = _mm512_set1_ps(0);
+    // The kernels assume the VL/BW/DQ subsets as well; see
+    // compute_cpu_capability in aten/src/ATen/native/DispatchStub.cpp.
+    __mmask16 m = _mm512_cmp_ps_mask(a, a, _CMP_EQ_OQ);
+    a = _mm512_castsi512_ps(_mm512_movm_epi32(m));
+    return 0;
+  }
+")
+
 MACRO(CHECK_SSE lang type flags)
   SET(__FLAG_I 1)
   SET(CMAKE_REQUIRED_FLAGS_SAVE ${CMAKE_REQUIRED_FLAGS})
@@ -56,6 +70,8 @@ ENDMACRO()
 
 CHECK_SSE(C "AVX" " ;-mavx;/arch:AVX")
 CHECK_SSE(C "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+CHECK_SSE(C "AVX512" " ;-mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma;/arch:AVX512")
 
 CHECK_SSE(CXX "AVX" " ;-mavx;/arch:AVX")
 CHECK_SSE(CXX "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+CHECK_SSE(CXX "AVX512" " ;-mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma;/arch:AVX512")
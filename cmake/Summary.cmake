@@ -125,6 +125,7 @@ function (caffe2_print_configuration_summary)
   message(STATUS "  USE_PYTORCH_QNNPACK   : ${USE_PYTORCH_QNNPACK}")
   message(STATUS "  USE_REDIS             : ${USE_REDIS}")
   message(STATUS "  USE_ROCKSDB           : ${USE_ROCKSDB}")
+  message(STATUS "  USE_PERF_EVENTS       : ${USE_PERF_EVENTS}")
   message(STATUS "  USE_ZMQ               : ${USE_ZMQ}")
   message(STATUS "  USE_DISTRIBUTED       : ${USE_DISTRIBUTED}")
   if(${USE_DISTRIBUTED})
@@ -2,6 +2,8 @@
 
 #include <torch/torch.h>
 
+#include <torch/csrc/autograd/checkpoint.h>
+
 #include <test/cpp/api/support.h>
 
 using namespace torch::autograd;
@@ -149,6 +151,62 @@ TEST(AutogradAPITests, RetainGrad) {
   ASSERT_VARIABLE_EQ(input * 18, input.grad());
 }
 
+TEST(AutogradAPITests, InferenceModeGuardTest) {
+  auto x = torch::randn({2, 2}, torch::requires_grad());
+  {
+    torch::InferenceModeGuard guard;
+    ASSERT_FALSE(at::GradMode::is_enabled());
+    auto y = x * 2;
+    ASSERT_FALSE(y.requires_grad());
+    ASSERT_VARIABLE_EQ(y, x * 2);
+  }
+  // both grad mode and the autograd dispatch layer are restored on exit
+  ASSERT_TRUE(at::GradMode::is_enabled());
+  auto z = x * 2;
+  ASSERT_TRUE(z.requires_grad());
+}
+
+TEST(AutogradAPITests, CheckpointTest) {
+  auto segment1 = [](const variable_list& inputs) -> variable_list {
+    return {(inputs[0] * inputs[1]).sigmoid()};
+  };
+  auto segment2 = [](const variable_list& inputs) -> variable_list {
+    return {inputs[0].tanh() + inputs[0] * 3};
+  };
+
+  Variable x = torch::randn({5, 5}, torch::requires_grad());
+  Variable y = torch::randn({5, 5}, torch::requires_grad());
+
+  // Two chained segments so backward exercises the prefetch path.
+  auto hidden = checkpoint(segment1, {x, y})[0];
+  auto out = checkpoint(segment2, {hidden})[0];
+  out.sum().backward();
+
+  // Reference without checkpointing.
+  Variable xr = x.detach().set_requires_grad(true);
+  Variable yr = y.detach().set_requires_grad(true);
+  auto ref = segment2(segment1({xr, yr}))[0];
+  ref.sum().backward();
+
+  ASSERT_VARIABLE_EQ(x.grad(), xr.grad());
+  ASSERT_VARIABLE_EQ(y.grad(), yr.grad());
+}
+
+TEST(AutogradAPITests, CheckpointNonRequiresGradInput) {
+  auto segment = [](const variable_list& inputs) -> variable_list {
+    return {inputs[0] * inputs[1]};
+  };
+
+  Variable x = torch::randn({3, 3}, torch::requires_grad());
+  Variable c = torch::randn({3, 3});
+
+  auto out = checkpoint(segment, {x, c})[0];
+  out.sum().backward();
+
+  ASSERT_VARIABLE_EQ(x.grad(), c);
+  ASSERT_FALSE(c.grad().defined());
+}
+
 TEST(CustomAutogradTest, CustomFunction) {
   struct MyFunction : public Function<MyFunction> {
     static Variable forward(AutogradContext *ctx, Variable var1, int mul, Variable var2) {
@@ -8,8 +8,10 @@
 #include <c10/util/tempfile.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <future>
+#include <memory>
 #include <iostream>
 #include <iterator>
 #include <limits>
@@ -450,6 +452,71 @@ TEST(DataTest, TensorDatasetConstructsFromInitializerListOfTensors) {
       torch::tensor({0, 0, 1, 0, 0}, torch::kFloat32).allclose(dataset.get(2)));
 }
 
+TEST(DataTest, ColumnarDatasetParsesCSV) {
+  auto tempfile = c10::make_tempfile();
+  {
+    std::ofstream stream(tempfile.name);
+    stream << "label,x,y\n";
+    stream << "0,1.5,2\n";
+    stream << "1,-3,4.25\n";
+    stream << "2,0.5,-1\n";
+  }
+  datasets::Columnar dataset(
+      tempfile.name,
+      datasets::Columnar::Format::kCSV,
+      datasets::ColumnarOptions().skip_header(true).target_column(0));
+  ASSERT_EQ(dataset.size().value(), 3);
+  ASSERT_EQ(dataset.feature_columns(), 2);
+
+  std::vector<size_t> indices = {0, 2};
+  auto batch = dataset.get_batch(indices);
+  ASSERT_TRUE(batch.data.view(-1).allclose(
+      torch::tensor({1.5f, 2.0f, 0.5f, -1.0f})));
+  ASSERT_TRUE(batch.target.allclose(torch::tensor({0.0f, 2.0f})));
+}
+
+TEST(DataTest, ColumnarDatasetReadsBinaryRows) {
+  auto tempfile = c10::make_tempfile();
+  const std::vector<float> values = {0.f, 1.5f, 2.f, 1.f, -3.f, 4.25f};
+  {
+    std::ofstream stream(tempfile.name, std::ios::binary);
+    stream.write(
+        reinterpret_cast<const char*>(values.data()),
+        values.size() * sizeof(float));
+  }
+  datasets::Columnar dataset(
+      tempfile.name,
+      datasets::Columnar::Format::kBinary,
+      datasets::ColumnarOptions().columns(3).target_column(0));
+  ASSERT_EQ(dataset.size().value(), 2);
+
+  std::vector<size_t> indices = {1, 0};
+  auto batch = dataset.get_batch(indices);
+  ASSERT_TRUE(batch.data.view(-1).allclose(
+      torch::tensor({-3.f, 4.25f, 1.5f, 2.f})));
+  ASSERT_TRUE(batch.target.allclose(torch::tensor({1.f, 0.f})));
+}
+
+TEST(DataTest, ColumnarDatasetWorksWithDataLoader) {
+  auto tempfile = c10::make_tempfile();
+  {
+    std::ofstream stream(tempfile.name);
+    for (int i = 0; i < 10; ++i) {
+      stream << i << "," << 2 * i << "\n";
+    }
+  }
+  datasets::Columnar dataset(
+      tempfile.name, datasets::Columnar::Format::kCSV);
+  auto loader = torch::data::make_data_loader<samplers::SequentialSampler>(
+      std::move(dataset), DataLoaderOptions().batch_size(4));
+  size_t rows = 0;
+  for (const auto& batch : *loader) {
+    ASSERT_EQ(batch.data.size(1), 2);
+    rows += batch.data.size(0);
+  }
+  ASSERT_EQ(rows, 10);
+}
+
 TEST(DataTest, StackTransformWorksForExample) {
   struct D : public datasets::Dataset<D> {
     Example<> get(size_t index) override {
@@ -934,6 +1001,129 @@ TEST(DataTest, CanSaveAndLoadDistributedRandomSampler) {
   }
 }
 
+TEST(DataTest, DistributedStreamingRandomSamplerSingleReplicaCorrectSamples) {
+  size_t sample_count = 10;
+  samplers::DistributedStreamingRandomSampler dsrs(sample_count);
+
+  std::vector<size_t> res;
+  torch::optional<std::vector<size_t>> idx;
+  while ((idx = dsrs.next(3)).has_value()) {
+    res.insert(std::end(res), std::begin(*idx), std::end(*idx));
+  }
+
+  ASSERT_EQ(res.size(), sample_count);
+
+  std::sort(res.begin(), res.end());
+  for (size_t i = 0; i < res.size(); ++i) {
+    ASSERT_EQ(res[i], i);
+  }
+}
+
+TEST(DataTest, DistributedStreamingRandomSamplerMultiReplicaCorrectSamples) {
+  size_t sample_count = 10;
+  size_t num_replicas = 3;
+
+  auto test_function = [&](bool allow_duplicates,
+                           size_t local_sample_count,
+                           std::vector<size_t>& output,
+                           size_t batch_size) {
+    std::vector<std::unique_ptr<samplers::DistributedStreamingRandomSampler>>
+        samplers;
+
+    for (size_t i = 0; i < num_replicas; ++i) {
+      samplers.emplace_back(
+          torch::make_unique<samplers::DistributedStreamingRandomSampler>(
+              sample_count, num_replicas, i, allow_duplicates));
+    }
+
+    std::vector<size_t> res;
+    for (size_t i = 0; i < num_replicas; ++i) {
+      (*samplers[i]).reset();
+      torch::optional<std::vector<size_t>> idx;
+      while ((idx = (*samplers[i]).next(batch_size)).has_value()) {
+        res.insert(std::end(res), std::begin(*idx), std::end(*idx));
+      }
+      ASSERT_EQ(res.size(), local_sample_count * (i + 1));
+    }
+    std::sort(res.begin(), res.end());
+    ASSERT_EQ(res, output);
+  };
+
+  for (size_t batch_size = 1; batch_size <= 3; ++batch_size) {
+    size_t local_sample_count =
+        static_cast<size_t>(std::ceil(sample_count * 1.0 / num_replicas));
+    std::vector<size_t> output1{0, 0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    test_function(true, local_sample_count, output1, batch_size);
+
+    local_sample_count =
+        static_cast<size_t>(std::floor(sample_count * 1.0 / num_replicas));
+    std::vector<size_t> output2{0, 1, 2, 3, 4, 5, 6, 7, 8};
+    test_function(false, local_sample_count, output2, batch_size);
+  }
+}
+
+TEST(DataTest, DistributedStreamingRandomSamplerIsDeterministicPerEpoch) {
+  auto drain = [](samplers::DistributedStreamingRandomSampler& sampler) {
+    std::vector<size_t> res;
+    torch::optional<std::vector<size_t>> idx;
+    while ((idx = sampler.next(3)).has_value()) {
+      res.insert(std::end(res), std::begin(*idx), std::end(*idx));
+    }
+    return res;
+  };
+
+  samplers::DistributedStreamingRandomSampler a(100);
+  samplers::DistributedStreamingRandomSampler b(100);
+  std::vector<size_t> first = drain(a);
+  // same (seed, epoch) => identical order, with no coordination between
+  // the two sampler instances.
+  ASSERT_EQ(first, drain(b));
+
+  a.set_epoch(1);
+  a.reset();
+  std::vector<size_t> second = drain(a);
+  ASSERT_NE(first, second);
+  std::sort(second.begin(), second.end());
+  for (size_t i = 0; i < second.size(); ++i) {
+    ASSERT_EQ(second[i], i);
+  }
+}
+
+TEST(DataTest, CanSaveAndLoadDistributedStreamingRandomSampler) {
+  {
+    samplers::DistributedStreamingRandomSampler a(10);
+    ASSERT_EQ(a.index(), 0);
+    std::stringstream stream;
+    torch::save(a, stream);
+
+    samplers::DistributedStreamingRandomSampler b(10);
+    torch::load(b, stream);
+    ASSERT_EQ(b.index(), 0);
+  }
+  {
+    samplers::DistributedStreamingRandomSampler a(10);
+    a.next(3);
+    a.next(4);
+    ASSERT_EQ(a.index(), 7);
+    std::stringstream stream;
+    torch::save(a, stream);
+
+    samplers::DistributedStreamingRandomSampler b(10);
+    torch::load(b, stream);
+    ASSERT_EQ(b.index(), 7);
+  }
+  {
+    samplers::DistributedStreamingRandomSampler a(10);
+    a.set_epoch(3);
+    std::stringstream stream;
+    torch::save(a, stream);
+
+    samplers::DistributedStreamingRandomSampler b(10);
+    torch::load(b, stream);
+    ASSERT_EQ(b.epoch(), 3);
+  }
+}
+
 TEST(DataTest, DistributedSequentialSamplerSingleReplicaProduceCorrectSamples) {
   size_t sample_count = 10;
   size_t batch_size = 3;
@@ -1030,6 +1220,15 @@ TEST(DataLoaderTest, DataLoaderOptionsDefaultAsExpected) {
   ASSERT_EQ(full_options.max_jobs, 0);
   ASSERT_FALSE(full_options.timeout.has_value());
   ASSERT_TRUE(full_options.enforce_ordering);
+  ASSERT_FALSE(full_options.pin_memory);
+}
+
+TEST(DataLoaderTest, PinBatchMemoryPassesThroughTensorFreeBatches) {
+  // Batches without tensors (e.g. plain index batches) are returned
+  // unchanged; actual pinning requires a CUDA build and is exercised there.
+  std::vector<int> batch = {1, 2, 3};
+  auto pinned = torch::data::detail::pin_batch_memory(std::move(batch));
+  ASSERT_EQ(pinned, (std::vector<int>{1, 2, 3}));
 }
 
 TEST(DataLoaderTest, DataLoaderOptionsCoalesceOptionalValues) {
@@ -1037,6 +1236,69 @@ TEST(DataLoaderTest, DataLoaderOptionsCoalesceOptionalValues) {
   FullDataLoaderOptions full_options(partial_options);
   ASSERT_EQ(full_options.batch_size, 32);
   ASSERT_EQ(full_options.max_jobs, 2 * 10);
+  // The prefetch depth defaults to max_jobs and is clamped to it.
+  ASSERT_EQ(full_options.prefetch_count, 2 * 10);
+  ASSERT_EQ(
+      FullDataLoaderOptions(DataLoaderOptions(32).workers(10).prefetch_count(4))
+          .prefetch_count,
+      4);
+  ASSERT_EQ(
+      FullDataLoaderOptions(
+          DataLoaderOptions(32).workers(10).prefetch_count(100))
+          .prefetch_count,
+      2 * 10);
+}
+
+struct ResetCountingDataset : datasets::Dataset<ResetCountingDataset, int> {
+  explicit ResetCountingDataset(std::shared_ptr<std::atomic<size_t>> counter)
+      : counter_(std::move(counter)) {}
+
+  int get(size_t index) override {
+    return index;
+  }
+
+  torch::optional<size_t> size() const override {
+    return 4;
+  }
+
+  // Called by the DataLoader on every worker's copy of the dataset at the
+  // start of each epoch.
+  void reset() {
+    ++(*counter_);
+  }
+
+  std::shared_ptr<std::atomic<size_t>> counter_;
+};
+
+TEST(DataLoaderTest, WorkersResetDatasetCopiesEveryEpoch) {
+  const size_t kNumberOfWorkers = 2;
+  const size_t kNumberOfEpochs = 3;
+  auto counter = std::make_shared<std::atomic<size_t>>(0);
+  auto data_loader = torch::data::make_data_loader(
+      ResetCountingDataset(counter),
+      DataLoaderOptions(2).workers(kNumberOfWorkers));
+  for (size_t epoch = 0; epoch < kNumberOfEpochs; ++epoch) {
+    size_t example_count = 0;
+    for (auto batch : *data_loader) {
+      example_count += batch.size();
+    }
+    ASSERT_EQ(example_count, 4);
+  }
+  // Every worker's dataset copy is reset once per epoch.
+  ASSERT_EQ(counter->load(), kNumberOfWorkers * kNumberOfEpochs);
+}
+
+TEST(DataLoaderTest, MainThreadDatasetIsResetEveryEpoch) {
+  const size_t kNumberOfEpochs = 2;
+  auto counter = std::make_shared<std::atomic<size_t>>(0);
+  auto data_loader = torch::data::make_data_loader(
+      ResetCountingDataset(counter), DataLoaderOptions(2).workers(0));
+  for (size_t epoch = 0; epoch < kNumberOfEpochs; ++epoch) {
+    for (auto batch : *data_loader) {
+      (void)batch;
+    }
+  }
+  ASSERT_EQ(counter->load(), kNumberOfEpochs);
 }
 
 TEST(DataLoaderTest, MakeDataLoaderDefaultsAsExpected) {
@@ -2223,6 +2485,83 @@ TEST(DataLoaderTest, ChunkDatasetCrossChunkShuffle) {
   }
 }
 
+TEST(DataLoaderTest, ChunkDatasetAsyncReaderWithIoDepth) {
+  // An async reader that splits chunk loading into a raw read and a decode
+  // step. The raw chunk holds the examples as bytes; decode widens them to
+  // int and records that it ran on data of the expected size.
+  struct D : public datasets::AsyncChunkDataReader<int> {
+   public:
+    using BatchType = datasets::ChunkDataReader<int>::ChunkType;
+
+    RawChunkType read_chunk_raw(size_t chunk_index) override {
+      RawChunkType raw(chunk_sizes[chunk_index]);
+      int start_index = chunk_index == 0
+          ? 0
+          : std::accumulate(chunk_sizes, chunk_sizes + chunk_index, 0);
+      std::iota(raw.begin(), raw.end(), static_cast<char>(start_index));
+      return raw;
+    }
+
+    BatchType decode_chunk(RawChunkType raw, size_t chunk_index) override {
+      EXPECT_EQ(raw.size(), chunk_sizes[chunk_index]);
+      return BatchType(raw.begin(), raw.end());
+    }
+
+    size_t chunk_count() override {
+      return chunk_count_;
+    };
+
+    void reset() override{};
+
+    const static size_t chunk_count_ = 3;
+    size_t chunk_sizes[chunk_count_] = {10, 5, 20};
+  };
+
+  const size_t prefetch_count = 2;
+  const size_t batch_size = 5;
+  const size_t cache_size = 10;
+  const size_t cross_chunk_shuffle_count = 1;
+  const size_t io_depths[] = {1, 3};
+
+  for (auto io_depth : io_depths) {
+    D data_reader;
+    samplers::SequentialSampler sampler(0);
+
+    datasets::SharedBatchDataset<datasets::ChunkDataset<
+        D,
+        samplers::SequentialSampler,
+        samplers::SequentialSampler>>
+        dataset = datasets::make_shared_dataset<datasets::ChunkDataset<
+            D,
+            samplers::SequentialSampler,
+            samplers::SequentialSampler>>(
+            data_reader,
+            sampler,
+            sampler,
+            datasets::ChunkDatasetOptions(
+                prefetch_count,
+                batch_size,
+                cache_size,
+                cross_chunk_shuffle_count,
+                io_depth));
+
+    auto data_loader = torch::data::make_data_loader(
+        dataset, DataLoaderOptions(batch_size).workers(0));
+
+    size_t sum = 0;
+    size_t example_count = 0;
+    for (auto iterator = data_loader->begin(); iterator != data_loader->end();
+         ++iterator) {
+      for (int value : *iterator) {
+        sum += value;
+        ++example_count;
+      }
+    }
+    ASSERT_EQ(example_count, 35);
+    ASSERT_EQ(sum, 595); // sum([0, 35))
+  }
+}
+
 TEST(DataLoaderTest, CustomPreprocessPolicy) {
   const size_t chunk_size = 5;
   const size_t batch_size = 10;
@@ -301,6 +301,73 @@ TEST(OptimTest, ProducesPyTorchValues_SGDWithWeightDecayAndNesterovMomentum) {
       expected_parameters::SGD_with_weight_decay_and_nesterov_momentum());
 }
 
+TEST(OptimTest, FusedAdamStepMatchesUnfusedOps) {
+  torch::manual_seed(0);
+  // An odd size exercises the vectorized loop and its scalar tail.
+  auto param = torch::randn({17});
+  auto grad = torch::randn({17});
+  auto exp_avg = torch::rand({17});
+  auto exp_avg_sq = torch::rand({17}).add_(0.1);
+
+  const int64_t step = 3;
+  const double lr = 1e-2;
+  const double beta1 = 0.9;
+  const double beta2 = 0.999;
+  const double weight_decay = 0.1;
+  const double eps = 1e-8;
+
+  // Reference update composed of the same tensor ops Adam::step issues on
+  // the generic path.
+  auto param_ref = param.clone();
+  auto exp_avg_ref = exp_avg.clone();
+  auto exp_avg_sq_ref = exp_avg_sq.clone();
+  auto g = grad + weight_decay * param_ref;
+  exp_avg_ref.mul_(beta1).add_(g, 1 - beta1);
+  exp_avg_sq_ref.mul_(beta2).addcmul_(g, g, 1 - beta2);
+  const auto bias_correction1 = 1 - std::pow(beta1, step);
+  const auto bias_correction2 = 1 - std::pow(beta2, step);
+  auto denom = (exp_avg_sq_ref / bias_correction2).sqrt() + eps;
+  param_ref.addcdiv_(exp_avg_ref, denom, -lr / bias_correction1);
+
+  at::_fused_adam_step_(
+      param, grad, exp_avg, exp_avg_sq, step, lr, beta1, beta2, weight_decay,
+      eps);
+
+  ASSERT_TRUE(param.allclose(param_ref));
+  ASSERT_TRUE(exp_avg.allclose(exp_avg_ref));
+  ASSERT_TRUE(exp_avg_sq.allclose(exp_avg_sq_ref));
+}
+
+TEST(OptimTest, FusedSgdMomentumStepMatchesUnfusedOps) {
+  torch::manual_seed(0);
+  const double lr = 0.1;
+  const double momentum = 0.9;
+  const double dampening = 0.1;
+  const double weight_decay = 0.01;
+  for (bool nesterov : {false, true}) {
+    auto param = torch::randn({17});
+    auto grad = torch::randn({17});
+    auto buf = torch::randn({17});
+
+    auto param_ref = param.clone();
+    auto buf_ref = buf.clone();
+    auto d_p = grad.add(param_ref, weight_decay);
+    buf_ref.mul_(momentum).add_(d_p, 1 - dampening);
+    if (nesterov) {
+      d_p = d_p.add(buf_ref, momentum);
+    } else {
+      d_p = buf_ref;
+    }
+    param_ref.add_(d_p, -lr);
+
+    at::_fused_sgd_momentum_step_(
+        param, grad, buf, lr, momentum, dampening, weight_decay, nesterov);
+
+    ASSERT_TRUE(param.allclose(param_ref));
+    ASSERT_TRUE(buf.allclose(buf_ref));
+  }
+}
+
 TEST(OptimTest, ZeroGrad) {
   torch::manual_seed(0);
 
@@ -3,8 +3,11 @@
 #include <torch/csrc/autograd/functions/comm.h>
 #include <torch/nn/module.h>
 #include <torch/nn/modules/conv.h>
+#include <torch/nn/modules/container/functional.h>
+#include <torch/nn/modules/container/sequential.h>
 #include <torch/nn/modules/linear.h>
 #include <torch/nn/parallel/data_parallel.h>
+#include <torch/nn/parallel/pipeline.h>
 #include <torch/nn/pimpl.h>
 #include <torch/optim/sgd.h>
 #include <torch/types.h>
@@ -291,3 +294,69 @@ TEST_F(ParallelTest, DataParallelNumericalEquivalence_MultiCUDA) {
       }
     }
 }
+
+TEST_F(ParallelTest, PipelineMatchesSerialExecution) {
+  torch::nn::Sequential model(
+      torch::nn::Linear(4, 8), torch::nn::Linear(8, 8), torch::nn::Linear(8, 2));
+  auto reference =
+      std::dynamic_pointer_cast<SequentialImpl>(model.ptr()->clone());
+
+  parallel::Pipeline pipeline(
+      model,
+      {torch::Device(torch::kCPU), torch::Device(torch::kCPU)},
+      /*chunks=*/3);
+  ASSERT_EQ(pipeline.stages().size(), 2);
+  ASSERT_EQ(pipeline.stages()[0]->size() + pipeline.stages()[1]->size(), 3);
+
+  auto input = torch::randn({8, 4}, torch::requires_grad(true));
+  auto input_serial = input.clone().detach().requires_grad_(true);
+
+  auto output = pipeline.forward(input);
+  auto output_serial = reference->forward(input_serial);
+  ASSERT_TRUE(output.allclose(output_serial));
+
+  output.sum().backward();
+  output_serial.sum().backward();
+  ASSERT_TRUE(input.grad().allclose(input_serial.grad()));
+
+  // Stages share parameters with the wrapped module.
+  for (auto& parameter : model->parameters()) {
+    ASSERT_TRUE(parameter.grad().defined());
+  }
+}
+
+TEST_F(ParallelTest, PipelineRethrowsStageException) {
+  torch::nn::Sequential model(
+      torch::nn::Linear(3, 3),
+      torch::nn::Functional([](torch::Tensor input) -> torch::Tensor {
+        TORCH_CHECK(false, "stage failure");
+        return input;
+      }));
+  parallel::Pipeline pipeline(
+      model, {torch::Device(torch::kCPU), torch::Device(torch::kCPU)});
+  ASSERT_THROWS_WITH(
+      pipeline.forward(torch::ones({4, 3})), "stage failure");
+}
+
+TEST_F(ParallelTest, PipelineNumericalEquivalence_MultiCUDA) {
+  torch::nn::Sequential model(
+      torch::nn::Linear(4, 8), torch::nn::Linear(8, 8), torch::nn::Linear(8, 2));
+  auto reference =
+      std::dynamic_pointer_cast<SequentialImpl>(model.ptr()->clone());
+
+  parallel::Pipeline pipeline(
+      model,
+      {torch::Device(torch::kCUDA, 0), torch::Device(torch::kCUDA, 1)},
+      /*chunks=*/4);
+
+  auto input = torch::randn({10, 4});
+  auto output = pipeline.forward(input);
+  ASSERT_EQ(output.device(), torch::Device(torch::kCUDA, 1));
+  ASSERT_TRUE(output.to(torch::kCPU).allclose(reference->forward(input)));
+
+  output.sum().backward();
+  for (auto& parameter : model->parameters()) {
+    ASSERT_TRUE(parameter.grad().defined());
+    ASSERT_EQ(parameter.grad().device(), parameter.device());
+  }
+}
@@ -6,6 +6,7 @@
 #include <torch/csrc/distributed/autograd/context/container.h>
 #include <torch/csrc/distributed/autograd/context/context.h>
 #include <torch/csrc/distributed/autograd/engine/dist_engine.h>
+#include <torch/csrc/distributed/autograd/functions/recvrpc_backward.h>
 #include <torch/csrc/distributed/autograd/rpc_messages/rpc_with_autograd.h>
 #include <torch/csrc/distributed/autograd/utils.h>
 #include <torch/torch.h>
@@ -99,6 +100,16 @@ TEST_F(DistAutogradTest, TestInitializedContextCleanupSendFunction) {
   ASSERT_EQ(0, engine.numBackwardPasses());
 }
 
+TEST_F(DistAutogradTest, TestRecvBackwardIsEagerDispatch) {
+  autogradContainer_->newContext();
+  auto context = autogradContainer_->currentContext();
+  // Recv functions must be flagged for eager dispatch so the local engine
+  // fires the remote backward RPC before draining queued local compute.
+  RecvRpcBackward recv(
+      AutogradMetadata(context->contextId(), 0), context, /*fromWorkerId=*/1);
+  ASSERT_TRUE(recv.is_eager_dispatch());
+}
+
 } // namespace autograd
 } // namespace distributed
 } // namespace torch
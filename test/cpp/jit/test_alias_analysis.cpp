@@ -456,6 +456,44 @@ void testAliasAnalysis() {
   }
 }
 
+void testAliasAnalysisIncrementalUpdates() {
+  {
+    // newly inserted nodes can be analyzed in place of a full rebuild
+    auto graph = std::make_shared<Graph>();
+    auto a = graph->addInput();
+    auto b = graph->addInput();
+    auto pureNode = graph->insert(aten::mul, {a, b})->node();
+
+    AliasDb aliasDb(graph);
+    // prime the memory location caches with some queries
+    ASSERT_FALSE(aliasDb.mayAlias(pureNode->output(), a));
+    ASSERT_FALSE(aliasDb.hasWriters(a));
+
+    WithInsertPoint guard(graph->return_node());
+    auto writingNode = graph->insert(aten::add_, {a, b})->node();
+    aliasDb.analyzeNewNode(writingNode);
+
+    ASSERT_TRUE(aliasDb.mayAlias(writingNode->output(), a));
+    ASSERT_TRUE(aliasDb.writesToAlias(
+        writingNode, std::unordered_set<const Value*>{a}));
+    ASSERT_TRUE(aliasDb.hasWriters(a));
+  }
+  {
+    // removing a node removes its registered writes
+    auto graph = std::make_shared<Graph>();
+    auto a = graph->addInput();
+    auto b = graph->addInput();
+    auto writingNode = graph->insert(aten::add_, {a, b})->node();
+
+    AliasDb aliasDb(graph);
+    ASSERT_TRUE(aliasDb.hasWriters(a));
+
+    aliasDb.removeNode(writingNode);
+    writingNode->destroy();
+    ASSERT_FALSE(aliasDb.hasWriters(a));
+  }
+}
+
 void testWriteTracking() {
   RegisterOperators reg({Operator(
       "prim::creates_alias(Tensor(a) x) -> Tensor(a)",
@@ -188,5 +188,49 @@ void testArgumentSpec() {
   ASSERT_EQ(spec.count(c), 1);
 }
 
+void testBatchBucketing() {
+  auto& CF = at::CPU(at::kFloat);
+
+  auto graph = jit::compile(R"JIT(
+   def fn(a):
+      return a
+   )JIT")
+                   ->get_function("fn")
+                   .graph();
+  ArgumentSpecCreator arg_spec_creator(*graph);
+
+  // off by default: batch size is not part of the spec
+  ASSERT_EQ(batchBucketingMode(), BatchBucketingMode::None);
+  ArgumentSpec b4 = arg_spec_creator.create(true, createStack({var(CF, {4, 3}, false)}));
+  ArgumentSpec b7 = arg_spec_creator.create(true, createStack({var(CF, {7, 3}, false)}));
+  ASSERT_EQ(b4, b7);
+  ASSERT_EQ(b4.tensorAt(0).batchBucket(), 0);
+
+  setBatchBucketing(BatchBucketingMode::PowerOfTwo);
+  ASSERT_EQ(batchBucketId(1), 1);
+  ASSERT_EQ(batchBucketId(5), 4);
+  ASSERT_EQ(batchBucketCeiling(batchBucketId(5)), 8);
+  // sizes within a bucket share a spec; different buckets do not
+  ArgumentSpec p5 = arg_spec_creator.create(true, createStack({var(CF, {5, 3}, false)}));
+  ArgumentSpec p8 = arg_spec_creator.create(true, createStack({var(CF, {8, 3}, false)}));
+  ArgumentSpec p9 = arg_spec_creator.create(true, createStack({var(CF, {9, 3}, false)}));
+  ASSERT_EQ(p5, p8);
+  ASSERT_TRUE(p8 != p9);
+  // the specialized type carries the ceiling as the batch-dim size hint
+  auto type = p5.tensorAt(0).toType()->expect<TensorType>();
+  ASSERT_EQ(*type->sizes().sizes()->at(0), 8);
+  ASSERT_FALSE(type->sizes().sizes()->at(1).has_value());
+
+  setBatchBucketing(BatchBucketingMode::Pinned, {8, 32, 128});
+  ASSERT_EQ(batchBucketCeiling(batchBucketId(3)), 8);
+  ASSERT_EQ(batchBucketCeiling(batchBucketId(33)), 128);
+  ASSERT_EQ(batchBucketId(129), 0); // beyond the largest pin: unbucketed
+  ArgumentSpec n9 = arg_spec_creator.create(true, createStack({var(CF, {9, 3}, false)}));
+  ArgumentSpec n32 = arg_spec_creator.create(true, createStack({var(CF, {32, 3}, false)}));
+  ASSERT_EQ(n9, n32);
+
+  setBatchBucketing(BatchBucketingMode::None);
+}
+
 } // namespace jit
 } // namespace torch
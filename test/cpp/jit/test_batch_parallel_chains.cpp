@@ -0,0 +1,84 @@
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/irparser.h>
+#include <torch/csrc/jit/passes/batch_parallel_chains.h>
+#include <torch/csrc/jit/testing/file_check.h>
+#include "test/cpp/jit/test_base.h"
+
+#include <string>
+
+namespace torch {
+namespace jit {
+
+void testBatchParallelChains() {
+  {
+    // Four identical addmm + relu towers over independent inputs collapse
+    // into one bmm with a stacked bias, recovered via select.
+    auto graph = std::make_shared<Graph>();
+    script::parseIR(
+        R"IR(
+graph(%x0 : Float(8, 16), %x1 : Float(8, 16), %x2 : Float(8, 16), %x3 : Float(8, 16),
+      %w : Float(16, 32), %b : Float(32)):
+  %one : int = prim::Constant[value=1]()
+  %y0 : Tensor = aten::addmm(%b, %x0, %w, %one, %one)
+  %r0 : Tensor = aten::relu(%y0)
+  %y1 : Tensor = aten::addmm(%b, %x1, %w, %one, %one)
+  %r1 : Tensor = aten::relu(%y1)
+  %y2 : Tensor = aten::addmm(%b, %x2, %w, %one, %one)
+  %r2 : Tensor = aten::relu(%y2)
+  %y3 : Tensor = aten::addmm(%b, %x3, %w, %one, %one)
+  %r3 : Tensor = aten::relu(%y3)
+  return (%r0, %r1, %r2, %r3)
+  )IR",
+        &*graph);
+    BatchParallelChains(graph);
+    testing::FileCheck()
+        .check_count("aten::bmm", 1, /*exactly*/ true)
+        ->check("aten::relu")
+        ->check_count("aten::select", 4, /*exactly*/ true)
+        ->run(*graph);
+    testing::FileCheck().check_not("aten::addmm")->run(*graph);
+  }
+  {
+    // Without complete shapes there is nothing safe to stack; the graph is
+    // left untouched.
+    auto graph = std::make_shared<Graph>();
+    script::parseIR(
+        R"IR(
+graph(%x0 : Tensor, %x1 : Tensor, %x2 : Tensor, %x3 : Tensor, %w : Tensor):
+  %y0 : Tensor = aten::mm(%x0, %w)
+  %y1 : Tensor = aten::mm(%x1, %w)
+  %y2 : Tensor = aten::mm(%x2, %w)
+  %y3 : Tensor = aten::mm(%x3, %w)
+  return (%y0, %y1, %y2, %y3)
+  )IR",
+        &*graph);
+    BatchParallelChains(graph);
+    testing::FileCheck()
+        .check_count("aten::mm", 4, /*exactly*/ true)
+        ->run(*graph);
+    testing::FileCheck().check_not("aten::bmm")->run(*graph);
+  }
+  {
+    // Chains that consume another chain's output are not independent, which
+    // leaves the group below the batching threshold.
+    auto graph = std::make_shared<Graph>();
+    script::parseIR(
+        R"IR(
+graph(%x0 : Float(8, 8), %x1 : Float(8, 8), %x2 : Float(8, 8), %w : Float(8, 8)):
+  %y0 : Float(8, 8) = aten::mm(%x0, %w)
+  %y1 : Tensor = aten::mm(%x1, %w)
+  %y2 : Tensor = aten::mm(%x2, %w)
+  %y3 : Tensor = aten::mm(%y0, %w)
+  return (%y1, %y2, %y3)
+  )IR",
+        &*graph);
+    BatchParallelChains(graph);
+    testing::FileCheck()
+        .check_count("aten::mm", 4, /*exactly*/ true)
+        ->run(*graph);
+    testing::FileCheck().check_not("aten::bmm")->run(*graph);
+  }
+}
+
+} // namespace jit
+} // namespace torch
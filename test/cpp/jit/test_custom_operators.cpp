@@ -189,5 +189,19 @@ void testIValueKWargs() {
   ASSERT_EQ(result.toInt(), 19);
 }
 
+void testTrustedInvocation() {
+  const auto text = R"(
+    def foo(a : int, b : int, c : int = 4):
+      return a + 2*b + 3*c
+  )";
+  auto cu = compile(text);
+  auto& foo = cu->get_function("foo");
+  // A trusted call takes a complete positional stack and skips per-call
+  // schema validation; it must agree with the validating entry point.
+  ASSERT_EQ(foo.invokeTrusted({1, 3, 4}).toInt(), foo({1}, {{"b", 3}}).toInt());
+  // The O(1) arity check is kept even for trusted callers.
+  ASSERT_ANY_THROW(foo.invokeTrusted({1, 3}));
+}
+
 } // namespace jit
 } // namespace torch
@@ -0,0 +1,82 @@
+#include <test/cpp/jit/test_base.h>
+#include <torch/csrc/jit/dynamic_batcher.h>
+#include <torch/torch.h>
+
+#include <thread>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+void testDynamicBatcher() {
+  script::Module m("m");
+  m.define(R"(
+    def forward(self, x):
+      return x * 2 + 1
+  )");
+
+  {
+    // Concurrent submissions are coalesced and every future receives the
+    // same row a direct forward would produce.
+    DynamicBatcherOptions options;
+    options.max_batch_size = 8;
+    options.max_queue_delay = std::chrono::microseconds(2000);
+    DynamicBatcher batcher(m, options);
+
+    std::vector<at::Tensor> inputs;
+    std::vector<c10::intrusive_ptr<c10::ivalue::Future>> futures;
+    for (int i = 0; i < 16; ++i) {
+      inputs.push_back(torch::rand({4}));
+    }
+    std::vector<std::thread> submitters;
+    futures.resize(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      submitters.emplace_back([&batcher, &inputs, &futures, i]() {
+        futures[i] = batcher.submit({inputs[i]});
+      });
+    }
+    for (auto& t : submitters) {
+      t.join();
+    }
+    for (size_t i = 0; i < futures.size(); ++i) {
+      futures[i]->wait();
+      auto result = futures[i]->value().toTensor();
+      ASSERT_TRUE(result.allclose(inputs[i] * 2 + 1));
+    }
+  }
+
+  {
+    // Requests with different shapes are never mixed into one batch.
+    DynamicBatcher batcher(m, DynamicBatcherOptions());
+    auto small = torch::rand({2});
+    auto large = torch::rand({6});
+    auto fut_small = batcher.submit({small});
+    auto fut_large = batcher.submit({large});
+    fut_small->wait();
+    fut_large->wait();
+    ASSERT_TRUE(fut_small->value().toTensor().allclose(small * 2 + 1));
+    ASSERT_TRUE(fut_large->value().toTensor().allclose(large * 2 + 1));
+  }
+
+  {
+    // Errors raised by forward propagate through the futures.
+    script::Module bad("bad");
+    bad.define(R"(
+      def forward(self, x):
+        return x.matmul(x)
+    )");
+    DynamicBatcher batcher(bad, DynamicBatcherOptions());
+    auto fut = batcher.submit({torch::rand({3})});
+    fut->wait();
+    bool threw = false;
+    try {
+      fut->value();
+    } catch (const std::exception&) {
+      threw = true;
+    }
+    ASSERT_TRUE(threw);
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,76 @@
+#include <torch/csrc/jit/interpreter.h>
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/irparser.h>
+#include <torch/csrc/jit/passes/memoize_subgraphs.h>
+#include <torch/csrc/jit/testing/file_check.h>
+#include "test/cpp/jit/test_base.h"
+#include "test/cpp/jit/test_utils.h"
+
+namespace torch {
+namespace jit {
+
+void testMemoizeSubgraphs() {
+  // A pure tensor-only graph gets wrapped in a single MemoizedGraph node.
+  {
+    auto graph = std::make_shared<Graph>();
+    script::parseIR(
+        R"IR(
+graph(%a : Tensor, %b : Tensor):
+  %c : Tensor = aten::mul(%a, %b)
+  %d : Tensor = aten::mul(%c, %b)
+  return (%d)
+  )IR",
+        &*graph);
+    MemoizeGraph(graph);
+    testing::FileCheck()
+        .check_count("prim::MemoizedGraph", 1, /*exactly*/ true)
+        ->run(*graph);
+    testing::FileCheck().check_not("aten::mul")->run(*graph);
+
+    Code code(graph);
+    InterpreterState interp(code);
+    auto a = at::randn({4, 4});
+    auto b = at::randn({4, 4});
+    auto expected = (a * b) * b;
+
+    auto first = run(interp, {a, b});
+    ASSERT_TRUE(exactlyEqual(first[0], expected));
+
+    // unchanged inputs hit the cache and return the same tensor
+    auto second = run(interp, {a, b});
+    ASSERT_EQ(first[0].data_ptr(), second[0].data_ptr());
+
+    // an in-place update bumps the version counter and forces a recompute
+    a.add_(1);
+    auto third = run(interp, {a, b});
+    ASSERT_TRUE(exactlyEqual(third[0], (a * b) * b));
+
+    // mutating a returned tensor invalidates the cached outputs too
+    third[0].add_(1);
+    auto fourth = run(interp, {a, b});
+    ASSERT_TRUE(exactlyEqual(fourth[0], (a * b) * b));
+
+    // fresh tensors never hit, even when an allocator happens to hand back
+    // a previous input's address: identity is the cached tensors themselves
+    auto a2 = a + 1;
+    auto fifth = run(interp, {a2, b});
+    ASSERT_TRUE(exactlyEqual(fifth[0], (a2 * b) * b));
+  }
+  // Graphs with mutation are left alone.
+  {
+    auto graph = std::make_shared<Graph>();
+    script::parseIR(
+        R"IR(
+graph(%a : Tensor, %b : Tensor):
+  %2 : int = prim::Constant[value=1]()
+  %c : Tensor = aten::add_(%a, %b, %2)
+  return (%c)
+  )IR",
+        &*graph);
+    MemoizeGraph(graph);
+    testing::FileCheck().check_not("prim::MemoizedGraph")->run(*graph);
+  }
+}
+
+} // namespace jit
+} // namespace torch
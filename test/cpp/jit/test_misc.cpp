@@ -539,6 +539,62 @@ void testTorchSaveError() {
   ASSERT_TRUE(passed);
 }
 
+void testConsolidatedPickler() {
+  // Many small tensors and one large one: the small storages are coalesced
+  // into a single shared record, the large one keeps a record of its own.
+  std::vector<IValue> values;
+  for (int64_t i = 0; i < 32; ++i) {
+    values.emplace_back(torch::full({4, 4}, static_cast<float>(i)));
+  }
+  values.emplace_back(torch::rand({512, 512}));
+  auto tuple = c10::ivalue::Tuple::create(values);
+
+  auto data = pickle_save(IValue(tuple), /*consolidate_small_tensors=*/true);
+  IValue loaded = pickle_load(data);
+
+  const auto& expected = tuple->elements();
+  const auto& actual = loaded.toTuple()->elements();
+  AT_ASSERT(expected.size() == actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    AT_ASSERT(expected[i].toTensor().equal(actual[i].toTensor()));
+  }
+}
+
+void testUnpicklerOpCodeRuns() {
+  // Long homogeneous lists exercise the Unpickler's batched opcode-run
+  // decoding across every int width plus doubles and a mixed-width list.
+  c10::List<int64_t> small_ints;
+  c10::List<int64_t> large_ints;
+  c10::List<int64_t> mixed_ints;
+  c10::List<double> doubles;
+  for (int64_t i = 0; i < 3000; ++i) {
+    small_ints.push_back(i % 200);
+    large_ints.push_back((i << 40) - 7);
+    mixed_ints.push_back(i % 5 == 0 ? (i << 33) : i);
+    doubles.push_back(i * 0.5 - 1000.0);
+  }
+  auto tuple = c10::ivalue::Tuple::create(
+      {IValue(small_ints),
+       IValue(large_ints),
+       IValue(mixed_ints),
+       IValue(doubles)});
+
+  auto data = pickle_save(IValue(tuple));
+  IValue loaded = pickle_load(data);
+
+  const auto& actual = loaded.toTuple()->elements();
+  auto expectListEq = [](const auto& expected, const auto& got) {
+    AT_ASSERT(expected.size() == got.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      AT_ASSERT(expected.get(i) == got.get(i));
+    }
+  };
+  expectListEq(small_ints, actual.at(0).toIntList());
+  expectListEq(large_ints, actual.at(1).toIntList());
+  expectListEq(mixed_ints, actual.at(2).toIntList());
+  expectListEq(doubles, actual.at(3).toDoubleList());
+}
+
 // test a few features that are not directly used in schemas yet
 void testSchemaParser() {
   // nested arrays
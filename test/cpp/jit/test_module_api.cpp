@@ -1,5 +1,7 @@
 #include <test/cpp/jit/test_base.h>
 #include <test/cpp/jit/test_utils.h>
+#include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/testing/file_check.h>
 #include <torch/torch.h>
 
 namespace torch {
@@ -111,5 +113,83 @@ void testModuleParameter() {
   ASSERT_TRUE(m.hasattr("none_param2"));
 }
 
+void testFreezeModule() {
+  Module m("m");
+  m.register_parameter("weight", 2 * torch::ones({2, 2}), false);
+  m.register_attribute("training", BoolType::get(), IValue(true));
+  m.define(R"(
+    def forward(self, x):
+      if self.training:
+        return x
+      else:
+        return x + self.weight
+  )");
+  m.eval();
+  Module frozen = FreezeModule(m);
+
+  // The parameter and the training flag fold to constants; constant
+  // propagation then eliminates the training branch.
+  auto graph = frozen.get_method("forward").graph();
+  testing::FileCheck()
+      .check_not("prim::GetAttr")
+      ->check_not("prim::If")
+      ->run(*graph);
+
+  auto out = frozen.run_method("forward", torch::ones({2, 2}));
+  ASSERT_TRUE(out.toTensor().allclose(3 * torch::ones({2, 2})));
+
+  // The original module is untouched.
+  testing::FileCheck()
+      .check("prim::GetAttr")
+      ->run(*m.get_method("forward").graph());
+
+  // Attributes the module assigns to are preserved, not folded.
+  Module counter("counter");
+  counter.register_attribute("count", IntType::get(), IValue(0));
+  counter.register_attribute("training", BoolType::get(), IValue(false));
+  counter.define(R"(
+    def forward(self, x):
+      self.count = self.count + 1
+      return x + self.count
+  )");
+  Module frozen_counter = FreezeModule(counter);
+  testing::FileCheck()
+      .check("prim::GetAttr")
+      ->check("prim::SetAttr")
+      ->run(*frozen_counter.get_method("forward").graph());
+  auto first = frozen_counter.run_method("forward", torch::zeros({2}));
+  auto second = frozen_counter.run_method("forward", torch::zeros({2}));
+  ASSERT_TRUE(second.toTensor().allclose(2 * torch::ones({2})));
+  (void)first;
+
+  // Frozen modules mark their reachable tensors inference-frozen, on
+  // detached aliases only: the source module's weight keeps its version
+  // counting (see NOTE [ Inference-frozen tensors ] in TensorImpl.h).
+  Module keeper("keeper");
+  keeper.register_attribute("count", IntType::get(), IValue(0));
+  keeper.register_parameter("weight", 2 * torch::ones({2, 2}), false);
+  keeper.register_attribute("training", BoolType::get(), IValue(false));
+  keeper.define(R"(
+    def forward(self, x):
+      self.count = self.count + 1
+      return x + self.weight
+  )");
+  Module frozen_keeper = FreezeModule(keeper);
+  auto frozen_weight = frozen_keeper.attr("weight").toTensor();
+  ASSERT_TRUE(frozen_weight.unsafeGetTensorImpl()->is_inference_frozen());
+  ASSERT_FALSE(keeper.attr("weight")
+                   .toTensor()
+                   .unsafeGetTensorImpl()
+                   ->is_inference_frozen());
+#ifdef NDEBUG
+  // release builds elide the bump entirely rather than asserting
+  auto version_before = frozen_weight.unsafeGetTensorImpl()->version_counter().current_version();
+  frozen_weight.unsafeGetTensorImpl()->bump_version();
+  ASSERT_EQ(
+      frozen_weight.unsafeGetTensorImpl()->version_counter().current_version(),
+      version_before);
+#endif
+}
+
 } // namespace jit
 } // namespace torch
@@ -0,0 +1,99 @@
+#include <test/cpp/jit/test_base.h>
+
+#include <torch/csrc/jit/irparser.h>
+#include <torch/csrc/jit/passes/shape_interpreter.h>
+
+namespace torch {
+namespace jit {
+
+void testShapeInterpreter() {
+  // Shapes flow through matmuls, elementwise ops and broadcasting without
+  // executing anything.
+  {
+    auto graph_string = R"IR(
+      graph(%a : Tensor, %b : Tensor, %c : Tensor):
+        %one : int = prim::Constant[value=1]()
+        %mm : Tensor = aten::mm(%a, %b)
+        %act : Tensor = aten::relu(%mm)
+        %out : Tensor = aten::add(%act, %c, %one)
+        return (%out))IR";
+    auto g = std::make_shared<Graph>();
+    script::parseIR(graph_string, g.get());
+
+    auto shapes = InferShapes(
+        *g, {ShapeVec{2, 3}, ShapeVec{3, 4}, ShapeVec{1, 4}});
+    AT_ASSERT(shapes.size() == 1);
+    AT_ASSERT(shapes[0].has_value());
+    AT_ASSERT(*shapes[0] == (ShapeVec{2, 4}));
+  }
+
+  // View with a -1 dimension and cat through a ListConstruct.
+  {
+    auto graph_string = R"IR(
+      graph(%a : Tensor, %b : Tensor):
+        %size : int[] = prim::Constant[value=[6, -1]]()
+        %dim : int = prim::Constant[value=0]()
+        %av : Tensor = aten::view(%a, %size)
+        %bv : Tensor = aten::view(%b, %size)
+        %list : Tensor[] = prim::ListConstruct(%av, %bv)
+        %out : Tensor = aten::cat(%list, %dim)
+        return (%out))IR";
+    auto g = std::make_shared<Graph>();
+    script::parseIR(graph_string, g.get());
+
+    auto shapes = InferShapes(*g, {ShapeVec{2, 3, 4}, ShapeVec{24}});
+    AT_ASSERT(shapes.size() == 1);
+    AT_ASSERT(shapes[0].has_value());
+    AT_ASSERT(*shapes[0] == (ShapeVec{12, 4}));
+  }
+
+  // Unknown input shapes and unregistered ops degrade to unknown outputs
+  // instead of erroring.
+  {
+    auto graph_string = R"IR(
+      graph(%a : Tensor, %b : Tensor):
+        %mm : Tensor = aten::mm(%a, %b)
+        %mys : Tensor = aten::mysterious_op(%mm)
+        return (%mm, %mys))IR";
+    auto g = std::make_shared<Graph>();
+    script::parseIR(graph_string, g.get());
+
+    auto shapes = InferShapes(*g, {ShapeVec{5, 7}, c10::nullopt});
+    AT_ASSERT(shapes.size() == 2);
+    AT_ASSERT(!shapes[0].has_value());
+    AT_ASSERT(!shapes[1].has_value());
+
+    AT_ASSERT(HasShapeFunction(aten::mm));
+    AT_ASSERT(!HasShapeFunction(Symbol::aten("mysterious_op")));
+  }
+
+  // Custom shape functions can be registered alongside custom ops.
+  {
+    RegisterShapeFunction(
+        Symbol::aten("mysterious_op"),
+        [](Node* node, const ShapeLookup& lookup)
+            -> c10::optional<std::vector<ShapeVec>> {
+          auto self = lookup(node->input(0));
+          if (!self) {
+            return c10::nullopt;
+          }
+          return std::vector<ShapeVec>{*self};
+        });
+    AT_ASSERT(HasShapeFunction(Symbol::aten("mysterious_op")));
+
+    auto graph_string = R"IR(
+      graph(%a : Tensor):
+        %mys : Tensor = aten::mysterious_op(%a)
+        return (%mys))IR";
+    auto g = std::make_shared<Graph>();
+    script::parseIR(graph_string, g.get());
+
+    auto shapes = InferShapes(*g, {ShapeVec{5, 7}});
+    AT_ASSERT(shapes.size() == 1);
+    AT_ASSERT(shapes[0].has_value());
+    AT_ASSERT(*shapes[0] == (ShapeVec{5, 7}));
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,133 @@
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/irparser.h>
+#include <torch/csrc/jit/passes/tensor_core_advisor.h>
+#include "test/cpp/jit/test_base.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+TensorTypePtr cudaTensor(at::ScalarType dtype, at::IntArrayRef sizes) {
+  return TensorType::create(dtype, at::DeviceType::CUDA, sizes, false);
+}
+
+size_t countCategory(
+    const std::vector<TensorCoreAdvisory>& report,
+    const std::string& category) {
+  size_t count = 0;
+  for (const auto& advisory : report) {
+    if (advisory.category == category) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+} // namespace
+
+void testTensorCoreAdvisor() {
+  {
+    // an fp32 matmul on CUDA is flagged as tensor-core eligible; the same
+    // matmul with aligned fp16 shapes is clean
+    auto graph = std::make_shared<Graph>();
+    std::unordered_map<std::string, Value*> vmap;
+    script::parseIR(
+        R"IR(
+graph(%a : Tensor, %b : Tensor):
+  %c : Tensor = aten::mm(%a, %b)
+  return (%c)
+  )IR",
+        &*graph,
+        vmap);
+    vmap["a"]->setType(cudaTensor(at::kFloat, {64, 64}));
+    vmap["b"]->setType(cudaTensor(at::kFloat, {64, 64}));
+    vmap["c"]->setType(cudaTensor(at::kFloat, {64, 64}));
+    auto report = TensorCoreAdvisor(graph);
+    ASSERT_EQ(countCategory(report, "fp32_gemm"), 1);
+    ASSERT_EQ(report[0].node_kind, "aten::mm");
+
+    vmap["a"]->setType(cudaTensor(at::kHalf, {64, 64}));
+    vmap["b"]->setType(cudaTensor(at::kHalf, {64, 64}));
+    vmap["c"]->setType(cudaTensor(at::kHalf, {64, 64}));
+    ASSERT_EQ(TensorCoreAdvisor(graph).size(), 0);
+  }
+  {
+    // fp16 matmul with a dimension that is not a multiple of 8 misses
+    // tensor cores
+    auto graph = std::make_shared<Graph>();
+    std::unordered_map<std::string, Value*> vmap;
+    script::parseIR(
+        R"IR(
+graph(%a : Tensor, %b : Tensor):
+  %c : Tensor = aten::mm(%a, %b)
+  return (%c)
+  )IR",
+        &*graph,
+        vmap);
+    vmap["a"]->setType(cudaTensor(at::kHalf, {64, 60}));
+    vmap["b"]->setType(cudaTensor(at::kHalf, {60, 64}));
+    vmap["c"]->setType(cudaTensor(at::kHalf, {64, 64}));
+    auto report = TensorCoreAdvisor(graph);
+    ASSERT_EQ(countCategory(report, "tensor_core_alignment"), 2);
+  }
+  {
+    // mixed fp16/fp32 inputs promoting the result to fp32
+    auto graph = std::make_shared<Graph>();
+    std::unordered_map<std::string, Value*> vmap;
+    script::parseIR(
+        R"IR(
+graph(%a : Tensor, %b : Tensor):
+  %1 : int = prim::Constant[value=1]()
+  %c : Tensor = aten::add(%a, %b, %1)
+  return (%c)
+  )IR",
+        &*graph,
+        vmap);
+    vmap["a"]->setType(cudaTensor(at::kHalf, {16, 16}));
+    vmap["b"]->setType(cudaTensor(at::kFloat, {16, 16}));
+    vmap["c"]->setType(cudaTensor(at::kFloat, {16, 16}));
+    auto report = TensorCoreAdvisor(graph);
+    ASSERT_EQ(countCategory(report, "dtype_promotion"), 1);
+  }
+  {
+    // a transpose feeding directly into a matmul is a layout hotspot
+    auto graph = std::make_shared<Graph>();
+    std::unordered_map<std::string, Value*> vmap;
+    script::parseIR(
+        R"IR(
+graph(%a : Tensor, %b : Tensor):
+  %t : Tensor = aten::t(%a)
+  %c : Tensor = aten::mm(%t, %b)
+  return (%c)
+  )IR",
+        &*graph,
+        vmap);
+    vmap["a"]->setType(cudaTensor(at::kHalf, {64, 64}));
+    vmap["t"]->setType(cudaTensor(at::kHalf, {64, 64}));
+    vmap["b"]->setType(cudaTensor(at::kHalf, {64, 64}));
+    vmap["c"]->setType(cudaTensor(at::kHalf, {64, 64}));
+    auto report = TensorCoreAdvisor(graph);
+    ASSERT_EQ(countCategory(report, "layout_conversion"), 1);
+  }
+  {
+    // CPU tensors are never reported: tensor cores are a CUDA feature
+    auto graph = std::make_shared<Graph>();
+    std::unordered_map<std::string, Value*> vmap;
+    script::parseIR(
+        R"IR(
+graph(%a : Float(64, 64), %b : Float(64, 64)):
+  %c : Float(64, 64) = aten::mm(%a, %b)
+  return (%c)
+  )IR",
+        &*graph,
+        vmap);
+    ASSERT_EQ(TensorCoreAdvisor(graph).size(), 0);
+  }
+}
+
+} // namespace jit
+} // namespace torch
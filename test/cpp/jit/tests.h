@@ -11,6 +11,7 @@ namespace jit {
 #define TH_FORALL_TESTS(_)             \
   _(ADFormulas)                        \
   _(Attributes)                        \
+  _(BatchBucketing)                    \
   _(Blocks)                            \
   _(CallStack)                         \
   _(CallStackCaching)                  \
@@ -20,10 +21,12 @@ namespace jit {
   _(CustomOperators)                   \
   _(CustomOperatorAliasing)            \
   _(IValueKWargs)                      \
+  _(TrustedInvocation)                 \
   _(CustomFusion)                      \
   _(SchemaMatching)                    \
   _(Differentiate)                     \
   _(DifferentiateWithRequiresGrad)     \
+  _(FreezeModule)                      \
   _(FromQualString)                    \
   _(InternedStrings)                   \
   _(IValue)                            \
@@ -31,17 +34,22 @@ namespace jit {
   _(Proto)                             \
   _(RegisterFusionCachesKernel)        \
   _(SchemaParser)                      \
+  _(ShapeInterpreter)                  \
   _(TopologicalIndex)                  \
   _(TopologicalMove)                   \
   _(SubgraphUtils)                     \
   _(AliasAnalysis)                     \
+  _(AliasAnalysisIncrementalUpdates)   \
   _(ContainerAliasing)                 \
   _(AliasRegistration)                 \
   _(WriteTracking)                     \
   _(Wildcards)                         \
   _(MemoryDAG)                         \
+  _(MemoizeSubgraphs)                  \
   _(IRParser)                          \
   _(ConstantPooling)                   \
+  _(BatchParallelChains)               \
+  _(DynamicBatcher)                    \
   _(NetDefConverter)                   \
   _(THNNConv)                          \
   _(ATenNativeBatchNorm)               \
@@ -55,6 +63,7 @@ namespace jit {
   _(RecordFunction)                    \
   _(ThreadLocalDebugInfo)              \
   _(SubgraphMatching)                  \
+  _(TensorCoreAdvisor)                 \
   _(SubgraphRewriter)                  \
   _(ModuleClone)                       \
   _(ModuleCloneInstance)               \
@@ -66,6 +75,10 @@ namespace jit {
   _(ProfiledTensorTypeHashing)         \
   _(ScriptObject)                      \
   _(SaveExtraFilesHook)                \
+  _(ConsolidatedPickler)               \
+  _(UnpicklerOpCodeRuns)               \
+  _(SaveAsyncSnapshotsTensors)         \
+  _(SharedWeightLoad)                  \
   _(DCE)                               \
   _(CustomFusionNestedBlocks)          \
   _(ClassDerive)                       \
@@ -83,7 +96,9 @@ namespace jit {
   _(AutogradSymbols)                   \
   _(MobileTypeParser)                  \
   _(LiteInterpreterPrim)               \
-  _(LiteInterpreterLoadOrigJit)
+  _(LiteInterpreterRepeatedOps)        \
+  _(LiteInterpreterLoadOrigJit)        \
+  _(LiteInterpreterLazyMethods)
 
 #define TH_FORALL_TESTS_CUDA(_) \
   _(ArgumentSpec)               \
@@ -37,6 +37,59 @@ TEST(WireSerialize, Base) {
   run("more", {torch::randn({5, 5}), torch::rand({10, 10})});
 }
 
+TEST(WireSerialize, Segmented) {
+  auto run = [](const std::string& payload,
+                const std::vector<at::Tensor>& tensors) {
+    std::vector<char> mpayload(payload.begin(), payload.end());
+    auto wire =
+        torch::distributed::rpc::wireSerializeSegmented(mpayload, tensors);
+    EXPECT_EQ(wire.tensorData.size(), tensors.size());
+    // Receive side: copy each segment into its own flat buffer, the way the
+    // agent receives segments off the wire.
+    std::vector<at::Tensor> segments;
+    for (const auto& td : wire.tensorData) {
+      auto segment = torch::empty({(int64_t)td.sizeInBytes()}, {torch::kChar});
+      memcpy(segment.data_ptr(), td.data(), td.sizeInBytes());
+      segments.push_back(segment);
+    }
+    auto deser = torch::distributed::rpc::wireDeserializeSegmented(
+        wire.header.data(), wire.header.size(), std::move(segments));
+    EXPECT_EQ(payload.size(), deser.first.size());
+    EXPECT_EQ(tensors.size(), deser.second.size());
+    if (payload.size() > 0) {
+      EXPECT_TRUE(
+          memcmp(deser.first.data(), payload.data(), payload.size()) == 0);
+    }
+    for (size_t i = 0; i < tensors.size(); ++i) {
+      EXPECT_TRUE(torch::equal(tensors[i], deser.second[i]));
+    }
+  };
+  run("", {});
+  run("hi", {});
+  run("", {torch::randn({5, 5})});
+  run("hi", {torch::randn({5, 5})});
+  run("more", {torch::randn({5, 5}), torch::rand({10, 10})});
+}
+
+TEST(WireSerialize, SegmentedAdoptsSegmentStorage) {
+  // The deserialized tensor should use the received segment buffer as its
+  // storage rather than copying out of it.
+  at::Tensor t = torch::randn({64});
+  auto wire = torch::distributed::rpc::wireSerializeSegmented({}, {t});
+  ASSERT_EQ(wire.tensorData.size(), 1);
+  auto segment = torch::empty(
+      {(int64_t)wire.tensorData[0].sizeInBytes()}, {torch::kChar});
+  memcpy(
+      segment.data_ptr(),
+      wire.tensorData[0].data(),
+      wire.tensorData[0].sizeInBytes());
+  auto deser = torch::distributed::rpc::wireDeserializeSegmented(
+      wire.header.data(), wire.header.size(), {segment});
+  ASSERT_EQ(deser.second.size(), 1);
+  EXPECT_TRUE(torch::equal(t, deser.second[0]));
+  EXPECT_EQ(deser.second[0].storage().data(), segment.storage().data());
+}
+
 TEST(WireSerialize, RecopySparseTensors) {
   // Take a 1K row of a 1M tensors, and make sure we don't send across 1M rows.
   constexpr size_t k1K = 1024;
@@ -1571,6 +1571,43 @@ class ProcessGroupGlooTest(MultiProcessTestCase):
                 self.assertEqual(torch.full([10, 10], self.world_size), tensor)
             del pg
 
+    def test_hierarchical_allreduce(self):
+        # Gloo does not implement reduce_scatter, so this exercises the two
+        # degenerate topologies where the hierarchical group falls back to a
+        # flat allreduce on the non-trivial subgroup; the three-phase path
+        # requires a backend with reduce_scatter support (NCCL).
+        store = c10d.FileStore(self.file_name, self.world_size)
+        pg_global = c10d.ProcessGroupGloo(
+            c10d.PrefixStore("global", store), self.rank, self.world_size)
+        expected = torch.full(
+            [100], float(self.world_size * (self.world_size + 1) // 2))
+
+        # Single node: the intra-node group spans the world and the
+        # inter-node group is trivial.
+        pg_intra = c10d.ProcessGroupGloo(
+            c10d.PrefixStore("intra", store), self.rank, self.world_size)
+        pg_inter = c10d.ProcessGroupGloo(
+            c10d.PrefixStore("inter/%d" % self.rank, store), 0, 1)
+        pg = c10d._hierarchical_process_group(pg_global, pg_intra, pg_inter)
+        tensor = torch.full([100], self.rank + 1)
+        pg.allreduce(tensor).wait()
+        self.assertEqual(expected, tensor)
+
+        # One rank per node: the inter-node group spans the world.
+        pg_intra = c10d.ProcessGroupGloo(
+            c10d.PrefixStore("intra2/%d" % self.rank, store), 0, 1)
+        pg_inter = c10d.ProcessGroupGloo(
+            c10d.PrefixStore("inter2", store), self.rank, self.world_size)
+        pg = c10d._hierarchical_process_group(pg_global, pg_intra, pg_inter)
+        tensor = torch.full([100], self.rank + 1)
+        pg.allreduce(tensor).wait()
+        self.assertEqual(expected, tensor)
+
+        # Subgroup sizes that do not factor the world size are rejected.
+        if self.world_size > 1:
+            with self.assertRaises(RuntimeError):
+                c10d._hierarchical_process_group(pg_global, pg_global, pg_global)
+
 
 @requires_nccl()
 class ProcessGroupNCCLTest(TestCase):
@@ -612,6 +612,27 @@ class TestAutograd(TestCase):
         self.assertEqual(counter[0], 1)
         z.sum().backward()
 
+    def test_dependency_cache(self):
+        torch._C._set_dependency_cache_enabled(True)
+        try:
+            self.assertTrue(torch._C._is_dependency_cache_enabled())
+            x = torch.randn(2, 2, requires_grad=True)
+            y = (x * x + x).sum()
+            # the second backward over the same retained graph hits the cache
+            y.backward(retain_graph=True)
+            g1 = x.grad.clone()
+            x.grad.zero_()
+            y.backward(retain_graph=True)
+            self.assertEqual(x.grad, g1)
+            # a freshly built graph misses the cache and stays correct
+            z = (x * 3).sum()
+            x.grad.zero_()
+            z.backward()
+            self.assertEqual(x.grad, torch.full_like(x, 3))
+        finally:
+            torch._C._set_dependency_cache_enabled(False)
+        self.assertFalse(torch._C._is_dependency_cache_enabled())
+
     def test_backward(self):
         v_t = torch.randn(5, 5)
         x_t = torch.randn(5, 5)
@@ -635,6 +656,28 @@ class TestAutograd(TestCase):
         self.assertEqual(y.grad.data, y_grad * grad_output)
         self.assertEqual(z.grad.data, z_grad * grad_output)
 
+    def test_backward_priority(self):
+        # priority only affects scheduling order; results must be identical
+        x = torch.randn(5, 5, requires_grad=True)
+        y = torch.randn(5, 5, requires_grad=True)
+        out = (x * y).sum()
+        torch.autograd.backward([out], priority=10)
+        x_grad, y_grad = x.grad.clone(), y.grad.clone()
+        x.grad.zero_()
+        y.grad.zero_()
+        out = (x * y).sum()
+        out.backward()
+        self.assertEqual(x.grad, x_grad)
+        self.assertEqual(y.grad, y_grad)
+
+        # partial, prioritized backward for one output via autograd.grad
+        out_fast = (x * y).sum()
+        out_slow = (x - y).pow(2).sum()
+        gx, = torch.autograd.grad([out_fast, out_slow], [x],
+                                  grad_outputs=[torch.ones(()), torch.zeros(())],
+                                  priority=10)
+        self.assertEqual(gx, y)
+
     def test_sparse_backward(self):
         class FixedGradientFunction(Function):
             @staticmethod
@@ -2604,6 +2647,86 @@ class TestAutograd(TestCase):
         foo_event = [event for event in function_events if "foo" in event.name][0]
         self.assertEqual(foo_event.count, 1)
 
+    def test_op_latency_histograms(self):
+        x = torch.randn(10, 10)
+
+        torch.autograd.profiler.enable_op_latency_histograms()
+        try:
+            self.assertTrue(torch.autograd._op_latency_histograms_enabled())
+            torch.autograd.profiler.reset_op_latency_histograms()
+            y = x * 2 + 4
+            hists = torch.autograd.profiler.snapshot_op_latency_histograms()
+        finally:
+            torch.autograd.profiler.disable_op_latency_histograms()
+
+        self.assertFalse(torch.autograd._op_latency_histograms_enabled())
+        for name in ['mul', 'add']:
+            self.assertIn(name, hists)
+            hist = hists[name]
+            self.assertEqual(hist['count'], 1)
+            self.assertGreaterEqual(hist['total_ns'], 0)
+            # exactly one bucket holds the single sample
+            self.assertEqual(sum(count for _, count in hist['buckets']), 1)
+
+        torch.autograd.profiler.reset_op_latency_histograms()
+
+    def test_memory_tracing(self):
+        x = torch.randn(64, 64)
+
+        torch.autograd.profiler.clear_memory_tracing()
+        torch.autograd.profiler.enable_memory_tracing()
+        try:
+            self.assertTrue(torch.autograd._memory_tracing_enabled())
+            # the profiler emits the op markers that tag allocations
+            with profile():
+                y = x.mm(x)
+            snapshot = torch.autograd.profiler.snapshot_memory_tracing()
+        finally:
+            torch.autograd.profiler.disable_memory_tracing()
+
+        self.assertFalse(torch.autograd._memory_tracing_enabled())
+        self.assertIn('mm', snapshot)
+        stats = snapshot['mm']
+        self.assertGreaterEqual(stats['peak_bytes'], y.numel() * 4)
+        self.assertGreaterEqual(stats['allocation_count'], 1)
+
+        # the output buffer is still alive and attributed to mm
+        live = torch.autograd.profiler.memory_tracing_live_allocations()
+        self.assertTrue(
+            any(a['op_name'] == 'mm' and a['nbytes'] >= y.numel() * 4
+                for a in live))
+
+        del y
+        torch.autograd.profiler.clear_memory_tracing()
+
+    def test_sampling_profiler(self):
+        x = torch.randn(10, 10)
+
+        # sample_rate=1.0 so the test is deterministic
+        torch.autograd.profiler.enable_sampling_profiler(1.0)
+        try:
+            self.assertTrue(torch.autograd._sampling_profiler_enabled())
+            y = x * 2 + 4
+            events = torch.autograd.profiler.drain_sampled_events()
+        finally:
+            remaining = torch.autograd.profiler.disable_sampling_profiler()
+
+        self.assertFalse(torch.autograd._sampling_profiler_enabled())
+
+        names = [e.name() for e in events if e.kind() == 'push']
+        self.assertIn('mul', names)
+        self.assertIn('add', names)
+        # each push has a matching pop on the same thread
+        for thread_id in {e.thread_id() for e in events}:
+            kinds = [e.kind() for e in events if e.thread_id() == thread_id]
+            self.assertEqual(kinds.count('push'), kinds.count('pop'))
+        # timestamps are ordered and a drain consumes what it returns
+        timestamps = [e.cpu_ns() for e in events]
+        self.assertEqual(timestamps, sorted(timestamps))
+        self.assertFalse(
+            set((e.name(), e.cpu_ns()) for e in events) &
+            set((e.name(), e.cpu_ns()) for e in remaining))
+
     def test_profiler_aggregation_fake(self):
         events = EventList()
         id = [0]
@@ -39,7 +39,7 @@ from torch._six import inf
 from torch.testing._internal.common_utils import TestCase, run_tests, set_rng_seed, TEST_WITH_UBSAN, load_tests
 from torch.testing._internal.common_cuda import TEST_CUDA
 from torch.autograd import grad, gradcheck
-from torch.distributions import (Bernoulli, Beta, Binomial, Categorical,
+from torch.distributions import (AliasMultinomial, Bernoulli, Beta, Binomial, Categorical,
                                  Cauchy, Chi2, Dirichlet, Distribution,
                                  Exponential, ExponentialFamily,
                                  FisherSnedecor, Gamma, Geometric, Gumbel,
@@ -1127,6 +1127,25 @@ class TestDistributions(TestCase):
         self._gradcheck_log_prob(Categorical, (p,))
         self.assertRaises(NotImplementedError, Categorical(p).rsample)
 
+    def test_alias_multinomial(self):
+        set_rng_seed(0)  # see Note [Randomized statistical tests]
+        probs = torch.tensor([0.1, 0.2, 0.3, 0.4])
+        sampler = AliasMultinomial(probs)
+        self.assertEqual(sampler.num_categories, 4)
+        samples = sampler.draw(50000)
+        self.assertEqual(samples.size(), (50000,))
+        self.assertEqual(samples.dtype, torch.int64)
+        self.assertTrue((samples >= 0).all())
+        self.assertTrue((samples < 4).all())
+        freqs = torch.bincount(samples, minlength=4).float() / samples.numel()
+        self.assertEqual(freqs, probs, 0.02)
+        self.assertEqual(sampler.draw(0).size(), (0,))
+        # unnormalized input is normalized at construction
+        self.assertEqual(AliasMultinomial(probs * 7).probs, probs)
+        self.assertRaises(ValueError, lambda: AliasMultinomial(torch.ones(2, 2)))
+        self.assertRaises(ValueError, lambda: AliasMultinomial(torch.tensor([-1.0, 2.0])))
+        self.assertRaises(ValueError, lambda: AliasMultinomial(torch.zeros(3)))
+
     def test_categorical_2d(self):
         probabilities = [[0.1, 0.2, 0.3], [0.5, 0.3, 0.2]]
         probabilities_1 = [[1.0, 0.0], [0.0, 1.0]]
@@ -115,6 +115,17 @@ class TestIndexing(TestCase):
         res = src.index_put_(indices, vals, accumulate=True)
         self.assertEqual(res.shape, src.shape)
 
+    def test_index_put_accumulate_large(self, device):
+        # large enough to take the parallel accumulation path on CPU;
+        # duplicate indices must still sum exactly
+        dst = torch.zeros(1000, 64, device=device)
+        idx = torch.arange(100000, device=device) % 17
+        vals = torch.ones(100000, 64, device=device)
+        dst.index_put_((idx,), vals, accumulate=True)
+        expected = torch.zeros(1000, device=device)
+        expected[:17] = torch.bincount(idx, minlength=17)[:17].float()
+        self.assertEqual(dst, expected.unsqueeze(1).expand(-1, 64))
+
     @dtypes(torch.float, torch.bfloat16, torch.long, torch.bool)
     @dtypesIfCPU(torch.float, torch.long, torch.bfloat16, torch.bool)
     @dtypesIfCUDA(torch.half, torch.long, torch.bfloat16, torch.bool)
@@ -581,6 +581,35 @@ class TestJit(JitTestCase):
         self.run_pass('peephole', tf2.graph)
         self.assertEqual(s, str(s))
 
+    def test_canonicalize_strength_reduction(self):
+        def pow_fn(x):
+            return x ** 2
+
+        def div_fn(x):
+            return x / 8.0
+
+        pow_graph = torch.jit.script(pow_fn).graph
+        self.run_pass('canonicalize_ops', pow_graph)
+        FileCheck().check("aten::mul").check_not("aten::pow").run(str(pow_graph))
+
+        # div by constant is only reduced under the fast-math toggle
+        div_graph = torch.jit.script(div_fn).graph
+        self.run_pass('canonicalize_ops', div_graph)
+        FileCheck().check("aten::div").run(str(div_graph))
+
+        old = torch._C._jit_set_fastmath_enabled(True)
+        try:
+            div_graph = torch.jit.script(div_fn).graph
+            self.run_pass('canonicalize_ops', div_graph)
+            FileCheck().check("aten::mul").check_not("aten::div").run(str(div_graph))
+        finally:
+            torch._C._jit_set_fastmath_enabled(old)
+
+        # 1/8 is exactly representable, so results agree
+        x = torch.randn(8)
+        self.assertEqual(div_fn(x), torch.jit.script(div_fn)(x))
+        self.assertEqual(pow_fn(x), torch.jit.script(pow_fn)(x))
+
     def test_peephole_dynamic(self):
         def f(x, y):
             return x.type_as(y)
@@ -1477,6 +1506,17 @@ graph(%packed_params_module, %a, %a_scale, %a_zero_point, %a_dtype, %r_scale, %r
         %r = aten::matmul(%a_dequant, %w_dequant_t)
         %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
         %r_dequant = aten::dequantize(%r_quant)
+        return (%r_dequant)""",
+            # aten::sigmoid --> quantized::sigmoid
+            """
+graph(%a, %a_scale, %a_zero_point, %a_dtype, %r_scale, %r_zero_point, %r_dtype):
+        %a_quant = aten::quantize_per_tensor(%a, %a_scale, %a_zero_point, %a_dtype)
+        %a_dequant = aten::dequantize(%a_quant)
+        # CHECK: quantized::sigmoid
+        # CHECK-NOT: aten::sigmoid
+        %r = aten::sigmoid(%a_dequant)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        %r_dequant = aten::dequantize(%r_quant)
         return (%r_dequant)"""
         ]
         for input_str in input_strs:
@@ -1660,6 +1700,27 @@ graph(%input, %weight):
             torch._C._jit_pass_fuse_linear(graph)
             FileCheck().run(input_str, graph)
 
+    def test_fuse_addmm_activation(self):
+        input_strs = ["""
+graph(%bias, %input, %weight, %4):
+    # CHECK-NOT: aten::addmm
+    # CHECK-NOT: aten::relu
+    # CHECK: aten::_addmm_activation
+    %res = aten::addmm(%bias, %input, %weight, %4, %4)
+    %out = aten::relu(%res)
+    return (%out)""", """
+graph(%bias, %input, %weight, %4):
+    # CHECK-NOT: aten::addmm
+    # CHECK-NOT: aten::gelu
+    # CHECK: aten::_addmm_activation
+    %res = aten::addmm(%bias, %input, %weight, %4, %4)
+    %out = aten::gelu(%res)
+    return (%out)"""]
+        for input_str in input_strs:
+            graph = parse_ir(input_str)
+            torch._C._jit_pass_fuse_addmm_activation(graph)
+            FileCheck().run(input_str, graph)
+
     @_tmp_donotuse_dont_inline_everything
     def test_fold_quantize(self):
         class M(torch.nn.Module):
@@ -1964,6 +2025,28 @@ graph(%Ra, %Rb):
         torch._C._jit_pass_complete_shape_analysis(graph, (x, y), False)
         FileCheck().check("Double(4, 3, 8, 5)").run(str(graph))
 
+    def test_memory_planning(self):
+        def fn(a, b):
+            c = a + b
+            d = torch.sigmoid(c)
+            e = d * c
+            return torch.tanh(e)
+
+        x = torch.randn(4, 8)
+        y = torch.randn(4, 8)
+        expected = fn(x, y)
+
+        scripted = torch.jit.script(fn)
+        graph = scripted.graph
+        torch._C._jit_pass_complete_shape_analysis(graph, (x, y), False)
+        planned = torch._C._jit_pass_plan_memory(graph)
+        # c, d and e are planned; the graph output is not
+        self.assertEqual(planned, 3)
+        FileCheck().check("aten::empty") \
+                   .check_count("aten::as_strided", 3) \
+                   .run(str(graph))
+        self.assertEqual(scripted(x, y), expected)
+
     # TODO: update verify to work with GraphExecutors
     @unittest.skip("verify needs to be updated to work with GraphExecutors")
     def test_verify(self):
@@ -5614,6 +5697,42 @@ def foo(xyz):
         fc.run(scripted.graph)
         fc.run(str(scripted.graph))
 
+    def test_save_load_warm_start_profiles(self):
+        class M(torch.nn.Module):
+            def forward(self, x):
+                return x * x + x
+
+        def has_profiles(module):
+            buffer = io.BytesIO()
+            torch.jit.save(module, buffer)
+            buffer.seek(0)
+            with zipfile.ZipFile(buffer) as zf:
+                found = any(name.endswith('profiles.pkl') for name in zf.namelist())
+            buffer.seek(0)
+            return found, buffer
+
+        old_exec = torch._C._jit_set_profiling_executor(True)
+        old_mode = torch._C._jit_set_profiling_mode(True)
+        try:
+            m = torch.jit.script(M())
+            x = torch.randn(2, 3)
+
+            # a module that was never run has no profiles to save
+            found, _ = has_profiles(m)
+            self.assertFalse(found)
+
+            # run enough times for the profiling executor to finish profiling
+            for _ in range(3):
+                m(x)
+            found, buffer = has_profiles(m)
+            self.assertTrue(found)
+
+            loaded = torch.jit.load(buffer)
+            self.assertEqual(loaded(x), m(x))
+        finally:
+            torch._C._jit_set_profiling_executor(old_exec)
+            torch._C._jit_set_profiling_mode(old_mode)
+
     def test_serialized_source_ranges(self):
 
         class FooTest(torch.jit.ScriptModule):
@@ -5952,6 +6071,31 @@ a")
 
         self.checkScript(foo, ())
 
+    def test_tokenizer_ops(self):
+        vocab = ["[PAD]", "[UNK]", "un", "##aff", "##able", "hello", "world"]
+
+        @torch.jit.script
+        def encode(vocab, texts):
+            # type: (List[str], List[str]) -> Tuple[Tensor, Tensor]
+            tok = torch.tokenizer_new(vocab, "[UNK]", "##")
+            return torch.tokenizer_encode(tok, texts, 5, 0)
+
+        ids, mask = encode(vocab, ["hello world", "unaffable", "hello qzqz", ""])
+        self.assertEqual(ids, torch.tensor([[5, 6, 0, 0, 0],
+                                            [2, 3, 4, 0, 0],
+                                            [5, 1, 0, 0, 0],
+                                            [0, 0, 0, 0, 0]]))
+        self.assertEqual(mask, torch.tensor([[1, 1, 0, 0, 0],
+                                             [1, 1, 1, 0, 0],
+                                             [1, 1, 0, 0, 0],
+                                             [0, 0, 0, 0, 0]]))
+        # output longer than max_len truncates
+        ids, _ = encode(vocab, ["hello world hello world hello world"])
+        self.assertEqual(ids[0].tolist(), [5, 6, 5, 6, 5])
+        # unknown unk token is rejected at build time
+        with self.assertRaisesRegex(RuntimeError, "not found in the vocabulary"):
+            encode(["a"], ["a"])
+
     def test_string_new_line(self):
         with self.assertRaisesRegex(RuntimeError, "expected a valid token*"):
             torch.jit.CompilationUnit('''
@@ -7069,6 +7213,26 @@ a")
         code = torch._C._jit_fuser_get_fused_kernel_code(graph, [torch.rand(3, 4)])
         FileCheck().check('1.282549830161864').run(code)
 
+    @unittest.skipIf(RUN_CUDA, 'This tests the CPU fuser')
+    @unittest.skipIf(IS_SANDCASTLE, "NYI: fuser support for Sandcastle")
+    @enable_cpu_fuser
+    def test_fuser_vectorized_cpu_codegen(self):
+        # Elementwise chains should compile to a single restrict-qualified,
+        # simd-annotated loop rather than one memory pass per op.
+        code = '''
+        graph(%0 : Float(*, *), %1 : Float(*, *)):
+            %2 : int = prim::Constant[value=1]()
+            %3 : Float(*, *) = aten::mul(%0, %1)
+            %4 : Float(*, *) = aten::add(%3, %1, %2)
+            %5 : Float(*, *) = aten::relu(%4)
+            return (%5)
+        '''
+
+        graph = parse_ir(code)
+        inputs = 2 * [torch.rand(26, 2048, dtype=torch.float)]
+        code = torch._C._jit_fuser_get_fused_kernel_code(graph, inputs)
+        FileCheck().check('RESTRICT data').check('omp parallel for simd').run(code)
+
     def test_fuser_multiple_blocks(self):
         cu = torch.jit.CompilationUnit('''
         def test_fuser_multiple_blocks(this, that, theother, meme):
@@ -12661,6 +12825,28 @@ a")
             .check("prim::Loop").check("aten::sub").run(str(graph))
         self.checkScript(fn, (torch.tensor(10),))
 
+    @unittest.skipIf(GRAPH_EXECUTOR != ProfilingMode.PROFILING,
+                     "Testing profile-guided loop specialization")
+    def test_loop_unrolling_profiled(self):
+        with enable_profiling_mode():
+            @torch.jit.script
+            def fn(x, n):
+                # type: (Tensor, int) -> Tensor
+                y = x
+                for _ in range(n):
+                    y = y + 1
+                return y
+
+            x = torch.ones(1)
+            self.assertEqual(fn(x, 4), x + 4)  # profiling run
+            self.assertEqual(fn(x, 4), x + 4)  # optimized run
+            # The specialized branch is fully unrolled; the fallback loop
+            # lives in the other branch of the trip count check.
+            FileCheck().check("aten::eq").check("prim::If") \
+                .check("prim::Loop").run(str(fn.graph_for(x, 4)))
+            # A different trip count takes the fallback and stays correct.
+            self.assertEqual(fn(x, 7), x + 7)
+
     def test_loop_unrolling_const(self):
         def fn():
             y = 0
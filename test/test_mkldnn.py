@@ -122,6 +122,19 @@ class TestMkldnn(TestCase):
                 self._test_serialization(mkldnn_conv2d, (x.to_mkldnn(),))
                 self._test_tracing(mkldnn_conv2d, (x.to_mkldnn(),))
 
+    def test_conv2d_dynamic_batch_prewarm(self):
+        # Repeated calls at varying batch sizes hit the primitive key cache;
+        # results must stay identical to the dense module.
+        conv2d = torch.nn.Conv2d(3, 8, kernel_size=3, padding=1).float()
+        mkldnn_conv2d = mkldnn_utils.to_mkldnn(copy.deepcopy(conv2d))
+        sample = torch.randn(1, 3, 32, 32, dtype=torch.float32).to_mkldnn()
+        mkldnn_utils.prewarm(mkldnn_conv2d, sample, [1, 2, 4])
+        for batch_size in [1, 2, 4, 2, 1]:
+            x = torch.randn(batch_size, 3, 32, 32, dtype=torch.float32)
+            self.assertEqual(
+                conv2d(x),
+                mkldnn_conv2d(x.to_mkldnn()).to_dense())
+
     def test_relu(self):
         x = torch.randn((4, 5), dtype=torch.float32) * 10
         self.assertEqual(torch.relu(x), torch.relu(x.to_mkldnn()).to_dense())
@@ -333,6 +346,42 @@ class TestMkldnn(TestCase):
             self._test_serialization(mkldnn_linear, (x.to_mkldnn(),))
             self._test_tracing(mkldnn_linear, (x.to_mkldnn(),))
 
+    def test_prepack_jit_pass(self):
+        from torch.testing import FileCheck
+
+        class ConvLinear(torch.nn.Module):
+            def __init__(self):
+                super(ConvLinear, self).__init__()
+                self.conv_weight = torch.nn.Parameter(torch.randn(8, 3, 3, 3))
+                self.conv_bias = torch.nn.Parameter(torch.randn(8))
+                self.fc_weight = torch.nn.Parameter(torch.randn(10, 8 * 16 * 16))
+                self.fc_bias = torch.nn.Parameter(torch.randn(10))
+
+            def forward(self, x):
+                y = torch.conv2d(x, self.conv_weight, self.conv_bias,
+                                 [1, 1], [1, 1], [1, 1], 1)
+                y = torch.max_pool2d(y, [2, 2])
+                y = y.reshape(y.size(0), -1)
+                return torch._C._nn.linear(y, self.fc_weight, self.fc_bias)
+
+        x = torch.randn(2, 3, 32, 32, dtype=torch.float32)
+        m = torch.jit.script(ConvLinear().float().eval())
+        expected = m(x)
+
+        frozen = torch._C._jit_freeze_module(m._c)
+        graph = frozen._get_method('forward').graph
+        torch._C._jit_pass_mkldnn_prepack(graph)
+
+        # both ops run on prepacked mkldnn weights; dense conversion happens
+        # only at the graph boundaries
+        FileCheck().check("aten::to_mkldnn") \
+                   .check("aten::conv2d") \
+                   .check("aten::mkldnn_linear") \
+                   .check("aten::to_dense") \
+                   .run(graph)
+
+        self.assertEqual(frozen._get_method('forward')(x), expected)
+
     def test_softmax(self):
         x = torch.randn(3, 4, 5, dtype=torch.float32) * 10
         for dim in range(x.ndim):
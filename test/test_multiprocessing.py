@@ -157,6 +157,11 @@ def mixed_type_producer(queue, event):
         event.clear()
 
 
+def tensor_queue_fill(queue, count):
+    for i in range(count):
+        queue.put(torch.full((4, 4), i))
+
+
 @contextlib.contextmanager
 def fs_sharing():
     prev_strategy = mp.get_sharing_strategy()
@@ -802,6 +807,57 @@ if __name__ == "__main__":
         t = torch.Tensor()
         t.share_memory_()
 
+    @unittest.skipIf(IS_WINDOWS, "TensorQueue is not supported on Windows")
+    def test_tensor_queue(self):
+        name = 'torch_tq_test_{}'.format(os.getpid())
+        q = mp.TensorQueue.create(name, slots=4, slot_bytes=1024)
+        self.assertEqual(q.name, name)
+        self.assertEqual(q.slots, 4)
+        self.assertEqual(q.slot_bytes, 1024)
+        self.assertIsNone(q.try_get())
+
+        x = torch.arange(6, dtype=torch.float64).view(2, 3)
+        q.put(x)
+        y = q.get()
+        self.assertEqual(y, x)
+        self.assertEqual(y.dtype, x.dtype)
+        # get() returns a copy, not an alias
+        x.zero_()
+        self.assertEqual(y.sum().item(), 15)
+
+        # non-contiguous and integral tensors round-trip
+        z = torch.arange(16, dtype=torch.int32).view(4, 4).t()
+        q.put(z)
+        self.assertEqual(q.get(), z)
+
+        for i in range(4):
+            self.assertTrue(q.try_put(torch.tensor([i])))
+        self.assertFalse(q.try_put(torch.tensor([4])))
+        for i in range(4):
+            self.assertEqual(q.get(), torch.tensor([i]))
+
+        self.assertRaisesRegex(RuntimeError, 'does not fit',
+                               lambda: q.put(torch.empty(1024)))
+        self.assertRaisesRegex(RuntimeError, 'must be non-empty',
+                               lambda: mp.TensorQueue.create('', 1, 64))
+
+        # attaching by name joins the same ring
+        q2 = mp.TensorQueue.attach(name)
+        q2.put(torch.ones(3))
+        self.assertEqual(q.get(), torch.ones(3))
+
+    @unittest.skipIf(IS_WINDOWS, "TensorQueue is not supported on Windows")
+    def test_tensor_queue_process(self):
+        q = mp.TensorQueue.create(
+            'torch_tq_proc_test_{}'.format(os.getpid()), slots=2, slot_bytes=512)
+        # two slots force the producer to block and be woken by our gets
+        p = mp.Process(target=tensor_queue_fill, args=(q, 10))
+        p.daemon = True
+        p.start()
+        for i in range(10):
+            self.assertEqual(q.get(), torch.full((4, 4), i))
+        p.join(1)
+
     def _test_is_shared(self):
         t = torch.randn(5, 5)
         self.assertFalse(t.is_shared())
@@ -3017,6 +3017,42 @@ class TestNN(NNTestCase):
         self.assertTrue(embedding.weight.grad.is_sparse)
         self.assertEqual(embedding.weight.grad.shape, embedding.weight.shape)
 
+    def test_embedding_sparse_coalesced(self):
+        # CPU sparse embedding grads come out already coalesced: duplicate
+        # indices are segment-reduced by the backward itself
+        embedding = nn.Embedding(10, 20, sparse=True)
+        input = torch.tensor([[0, 2, 4, 5], [4, 3, 0, 9]], dtype=torch.long)
+        embedding(input).sum().backward()
+        sparse_grad = embedding.weight.grad
+        self.assertTrue(sparse_grad.is_coalesced())
+        self.assertEqual(sparse_grad._indices(),
+                         torch.tensor([[0, 2, 3, 4, 5, 9]]))
+
+        # the coalesced grad must match the dense backward
+        dense_embedding = nn.Embedding(10, 20, sparse=False)
+        with torch.no_grad():
+            dense_embedding.weight.copy_(embedding.weight)
+        dense_embedding(input).sum().backward()
+        self.assertEqual(sparse_grad.to_dense(), dense_embedding.weight.grad)
+
+    def test_embedding_dense_backward_scaled(self):
+        # exercises the sorted segment-reduction path, including
+        # scale_grad_by_freq and padding_idx, against a reference scatter
+        for dtype in [torch.float, torch.double]:
+            embedding = nn.Embedding(50, 17, padding_idx=3,
+                                     scale_grad_by_freq=True).to(dtype)
+            input = torch.randint(0, 50, (4, 100), dtype=torch.long)
+            grad_output = torch.randn(4, 100, 17, dtype=dtype)
+            embedding(input).backward(grad_output)
+
+            counts = torch.bincount(input.view(-1), minlength=50).to(dtype)
+            reference = torch.zeros(50, 17, dtype=dtype)
+            reference.index_add_(
+                0, input.view(-1),
+                grad_output.view(-1, 17) / counts[input.view(-1)].unsqueeze(1))
+            reference[3].zero_()
+            self.assertEqual(embedding.weight.grad, reference)
+
     def test_embedding_sparse_empty_tensor(self):
         embedding = nn.Embedding(0, 0, sparse=True)
         input = torch.tensor([], dtype=torch.int64)
@@ -3091,6 +3127,72 @@ class TestNN(NNTestCase):
         res_F = F.embedding(a, embeddings)
         self.assertEqual(res_old, res_F)
 
+    def test_embedding_layernorm(self):
+        batch, seq, dim = 2, 3, 37
+        weight = torch.randn(11, dim)
+        indices = torch.randint(0, 11, (batch, seq), dtype=torch.long)
+        gamma = torch.randn(dim)
+        beta = torch.randn(dim)
+
+        def reference(positional):
+            x = F.embedding(indices, weight) + positional
+            return F.layer_norm(x, (dim,), gamma, beta)
+
+        # [seq, dim] positional table broadcasts across the batch
+        positional = torch.randn(seq, dim)
+        res = torch.embedding_layernorm(weight, indices, positional, gamma, beta)
+        self.assertEqual(res, reference(positional))
+
+        # a full per-token tensor is used verbatim
+        positional = torch.randn(batch, seq, dim)
+        res = torch.embedding_layernorm(weight, indices, positional, gamma, beta)
+        self.assertEqual(res, reference(positional))
+
+        # ln affine parameters are optional
+        res = torch.embedding_layernorm(weight, indices, positional)
+        expected = F.layer_norm(F.embedding(indices, weight) + positional, (dim,))
+        self.assertEqual(res, expected)
+
+    @unittest.skipIf(not TEST_CUDA, "CUDA unavailable")
+    def test_dropout_add_layernorm(self):
+        batch, seq, dim = 4, 7, 64
+        input = torch.randn(batch, seq, dim, device='cuda', requires_grad=True)
+        residual = torch.randn(batch, seq, dim, device='cuda', requires_grad=True)
+        gamma = torch.randn(dim, device='cuda', requires_grad=True)
+        beta = torch.randn(dim, device='cuda', requires_grad=True)
+        p = 0.37
+
+        out, mask, mean, rstd = torch.dropout_add_layernorm(
+            input, residual, gamma, beta, p, 1e-5)
+        # reconstruct the reference from the mask the kernel actually drew
+        ref_in = input.detach().requires_grad_()
+        ref_res = residual.detach().requires_grad_()
+        ref_gamma = gamma.detach().requires_grad_()
+        ref_beta = beta.detach().requires_grad_()
+        z = ref_in * mask.type_as(ref_in) / (1 - p) + ref_res
+        reference = F.layer_norm(z, (dim,), ref_gamma, ref_beta, 1e-5)
+        self.assertEqual(out, reference)
+
+        grad_out = torch.randn_like(out)
+        out.backward(grad_out)
+        reference.backward(grad_out)
+        self.assertEqual(input.grad, ref_in.grad)
+        self.assertEqual(residual.grad, ref_res.grad)
+        self.assertEqual(gamma.grad, ref_gamma.grad)
+        self.assertEqual(beta.grad, ref_beta.grad)
+
+        # p == 0 keeps everything: exact match with the unfused composition
+        out, mask, _, _ = torch.dropout_add_layernorm(
+            input, residual, gamma, beta, 0., 1e-5)
+        self.assertTrue(mask.bool().all())
+        self.assertEqual(
+            out, F.layer_norm(input + residual, (dim,), gamma, beta, 1e-5))
+
+        # affine parameters are optional
+        out, mask, _, _ = torch.dropout_add_layernorm(
+            input, residual, None, None, 0., 1e-5)
+        self.assertEqual(out, F.layer_norm(input + residual, (dim,)))
+
     @unittest.skipUnless('fbgemm' in torch.backends.quantized.supported_engines,
                          'Linear_FP16_weight requires FBGEMM. FBGEMM is only optimized for CPUs'
                          ' with instruction set support avx2 or newer.')
@@ -3623,6 +3725,76 @@ class TestNN(NNTestCase):
         self.assertTrue(ref_out.is_contiguous())
         self.assertEqual(out, ref_out)
 
+    def test_conv2d_direct_cpu(self):
+        # Shapes chosen so the im2col buffer exceeds the direct convolution
+        # heuristic's cache budget: under no_grad this takes the direct
+        # kernel, while the run with gradients takes the im2col+gemm path.
+        for bias in [True, False]:
+            conv = torch.nn.Conv2d(160, 8, 3, padding=1, bias=bias)
+            input = torch.randn(2, 160, 7, 7)
+            ref_out = conv(input)
+            with torch.no_grad():
+                out = conv(input)
+            self.assertEqual(out, ref_out)
+
+    def test_pooling_nhwc_cpu(self):
+        for pool in [torch.nn.MaxPool2d(3, stride=2, padding=1),
+                     torch.nn.AvgPool2d(3, stride=2, padding=1)]:
+            input = torch.randint(1, 10, (4, 8, 8, 8), dtype=torch.float32)
+            input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+            grad = torch.randint(1, 10, (4, 8, 4, 4), dtype=torch.float32)
+
+            ref_input = input.detach().clone().contiguous().requires_grad_(True)
+            ref_grad = grad.detach().clone().contiguous()
+
+            out = pool(input)
+            out.backward(grad)
+            ref_out = pool(ref_input)
+            ref_out.backward(ref_grad)
+
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+            self.assertTrue(ref_out.is_contiguous())
+            self.assertEqual(out, ref_out)
+            self.assertEqual(input.grad, ref_input.grad)
+
+    def test_upsample_nearest2d_nhwc_cpu(self):
+        input = torch.randint(1, 10, (4, 8, 8, 8), dtype=torch.float32)
+        input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+        grad = torch.randint(1, 10, (4, 8, 16, 16), dtype=torch.float32)
+
+        ref_input = input.detach().clone().contiguous().requires_grad_(True)
+        ref_grad = grad.detach().clone().contiguous()
+
+        out = F.interpolate(input, scale_factor=2, mode='nearest')
+        out.backward(grad)
+        ref_out = F.interpolate(ref_input, scale_factor=2, mode='nearest')
+        ref_out.backward(ref_grad)
+
+        self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+        self.assertTrue(ref_out.is_contiguous())
+        self.assertEqual(out, ref_out)
+        self.assertEqual(input.grad, ref_input.grad)
+
+    def test_upsample_bilinear2d_nhwc_cpu(self):
+        for align_corners in [True, False]:
+            for scale_factor in [0.5, 1.5, 2]:
+                input = torch.randint(1, 10, (4, 8, 8, 8), dtype=torch.float32)
+                input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+                ref_input = input.detach().clone().contiguous().requires_grad_(True)
+
+                out = F.interpolate(input, scale_factor=scale_factor,
+                                    mode='bilinear', align_corners=align_corners)
+                ref_out = F.interpolate(ref_input, scale_factor=scale_factor,
+                                        mode='bilinear', align_corners=align_corners)
+                grad = torch.randint(1, 10, ref_out.shape, dtype=torch.float32)
+                out.backward(grad.contiguous(memory_format=torch.channels_last))
+                ref_out.backward(grad.clone().contiguous())
+
+                self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+                self.assertTrue(ref_out.is_contiguous())
+                self.assertEqual(out, ref_out)
+                self.assertEqual(input.grad, ref_input.grad)
+
     @unittest.skipIf(not TEST_MULTIGPU, "multi-GPU not supported")
     def test_broadcast_double_backwards_gpu(self):
         tensors = (torch.randn(4, 4, device='cuda', requires_grad=True),
@@ -5698,6 +5870,26 @@ class TestNN(NNTestCase):
         # Because of dropout randomness, can only compare dropout=0 and dropout=1
         self._test_RNN_cpu_vs_cudnn(1)
 
+    @unittest.skipIf(not TEST_CUDNN, "needs cudnn")
+    def test_RNN_persistent_small_batch_decode(self):
+        # batch <= 4 fp32 eval-mode LSTM/GRU takes the persistent-kernel
+        # decode path instead of cuDNN; compare it against the CPU result
+        for module in (nn.LSTM, nn.GRU):
+            for num_layers in (1, 2):
+                for bias in (True, False):
+                    rnn = module(32, 64, num_layers=num_layers, bias=bias).eval()
+                    rnn_gpu = deepcopy(rnn).cuda()
+                    input_val = torch.randn(50, 2, 32)
+                    with torch.no_grad():
+                        output_cpu, hidden_cpu = rnn(input_val)
+                        output_gpu, hidden_gpu = rnn_gpu(input_val.cuda())
+                    self.assertEqual(output_cpu, output_gpu, prec=5e-5)
+                    if isinstance(hidden_cpu, tuple):
+                        for h_cpu, h_gpu in zip(hidden_cpu, hidden_gpu):
+                            self.assertEqual(h_cpu, h_gpu, prec=5e-5)
+                    else:
+                        self.assertEqual(hidden_cpu, hidden_gpu, prec=5e-5)
+
     @unittest.skipIf(not TEST_CUDNN, "needs cudnn")
     def test_RNN_cudnn_weight_norm(self):
         input_size = 10
@@ -1399,6 +1399,21 @@ class RecordHistogramObserverTest(QuantizationTestCase):
         loaded = torch.jit.load(buf)
         self.assertTrue(torch.equal(obs.get_tensor_value()[0], loaded.get_tensor_value()[0]))
 
+    def test_histc_fused_ops(self):
+        """Fused histogram ops used by HistogramObserver match histc/min/max."""
+        x = torch.randn(4096)
+        hist, min_val, max_val = torch._histc_with_min_max(x, 256)
+        self.assertEqual(min_val, torch.min(x))
+        self.assertEqual(max_val, torch.max(x))
+        self.assertEqual(
+            hist, torch.histc(x, 256, min=min_val.item(), max=max_val.item()))
+        # in-place accumulation over the same bin grid; values outside the
+        # range are ignored, like histc
+        y = torch.randn(4096)
+        ref = hist + torch.histc(y, 256, min=min_val.item(), max=max_val.item())
+        torch._histc_add_(hist, y, min_val.item(), max_val.item())
+        self.assertEqual(hist, ref)
+
     @given(qdtype=st.sampled_from((torch.qint8, torch.quint8)),
            qscheme=st.sampled_from((torch.per_tensor_affine, torch.per_tensor_symmetric)),
            reduce_range=st.booleans())
@@ -225,6 +225,35 @@ class TestQuantizedOps(TestCase):
         self.assertEqual(qY, qY_hat,
                          message="TanH failed: {} vs. {}".format(qY, qY_hat))
 
+    """Tests the correctness of the fused dequantize->op->quantize kernels
+    with caller-provided output quantization parameters."""
+    @given(X=hu.tensor(shapes=hu.array_shapes(1, 5, 1, 5),
+                       qparams=hu.qparams()))
+    def test_qdq_unary_fused(self, X):
+        X, (scale, zero_point, torch_type) = X
+
+        X = torch.from_numpy(X)
+        qX = torch.quantize_per_tensor(X, scale=scale,
+                                       zero_point=zero_point,
+                                       dtype=torch_type)
+
+        ops_under_test = {
+            torch.ops.quantized.relu: torch.relu,
+            torch.ops.quantized.sigmoid: torch.sigmoid,
+            torch.ops.quantized.tanh: torch.tanh,
+        }
+        output_scale = 0.05
+        output_zero_point = 0 if torch_type == torch.qint8 else 10
+        for q_op, ref_op in ops_under_test.items():
+            qY = torch.quantize_per_tensor(ref_op(qX.dequantize()),
+                                           scale=output_scale,
+                                           zero_point=output_zero_point,
+                                           dtype=torch_type)
+            qY_hat = q_op(qX, output_scale, output_zero_point)
+            self.assertEqual(qY, qY_hat,
+                             message="{} failed: {} vs. {}".format(
+                                 q_op, qY, qY_hat))
+
     """Tests the correctness of the quantized::clamp op."""
     @given(X=hu.tensor(shapes=hu.array_shapes(1, 8, 1, 8),
                        elements=hu.floats(-1e6, 1e6, allow_nan=False),
@@ -396,6 +425,47 @@ class TestQuantizedOps(TestCase):
             self.assertEqual(qCrelu_hat, qCrelu_out_hat,
                              message="AddReLU.out failed")
 
+    """Tests the correctness of the add and add_relu op when the inputs share
+    quantization parameters but the output does not. This must not take the
+    integer-domain fast path."""
+    def test_qadd_relu_same_input_qparams_different_output(self):
+        for dtype in [torch.quint8, torch.qint8, torch.qint32]:
+            add_relu = torch.ops.quantized.add_relu
+            add = torch.ops.quantized.add
+
+            A = torch.arange(-128, 130, dtype=torch.float)
+            B = torch.arange(-128, 130, dtype=torch.float)
+            scale = 2.0
+            zero_point = 127
+
+            scale_C = 0.5
+            zero_point_C = 5
+
+            qA = torch.quantize_per_tensor(A, scale=scale, zero_point=zero_point,
+                                           dtype=dtype)
+            qB = torch.quantize_per_tensor(B, scale=scale, zero_point=zero_point,
+                                           dtype=dtype)
+
+            # Add ground truth
+            C = (qA.dequantize() + qB.dequantize()).numpy()
+            np_dtype = {
+                torch.quint8 : np.uint8,
+                torch.qint8 : np.int8,
+                torch.qint32 : np.int32
+            }
+            qC = _quantize(C, scale_C, zero_point_C, dtype=np_dtype[dtype])
+            qC_hat = add(qA, qB, scale=scale_C, zero_point=zero_point_C)
+            np.testing.assert_equal(qC, qC_hat.int_repr(),
+                                    "Quantized addition failed.")
+
+            # Add + ReLU ground truth
+            Crelu = C.copy()
+            Crelu[C < 0] = 0
+            qCrelu = _quantize(Crelu, scale_C, zero_point_C, dtype=np_dtype[dtype])
+            qCrelu_hat = add_relu(qA, qB, scale=scale_C, zero_point=zero_point_C)
+            np.testing.assert_equal(qCrelu, qCrelu_hat.int_repr(),
+                                    "Quantized addition with ReLU failed.")
+
     """Tests the correctness of the mul and mul_relu op."""
     def test_qmul_relu_same_qparams(self):
         mul_relu = torch.ops.quantized.mul_relu
@@ -938,6 +1008,18 @@ class TestQuantizedOps(TestCase):
         cat_q_out = cat_q_out.dequantize()
         np.testing.assert_equal(cat_ref.numpy(), cat_q_out.numpy())
 
+        # Use an output scale that differs from the inputs' so that the
+        # general (dequantize/requantize) path is exercised too.
+        out_scale = scale + 1.0
+        cat_ref2 = torch.cat(tensors_ref, dim=dim)
+        cat_ref2 = torch.quantize_per_tensor(cat_ref2, out_scale, zero_point,
+                                             torch_type).dequantize()
+        if relu:
+            cat_ref2 = F.relu(cat_ref2)
+        cat_q2 = q_cat_op(tensors_q, dim=dim, scale=out_scale,
+                          zero_point=zero_point)
+        np.testing.assert_equal(cat_ref2.numpy(), cat_q2.dequantize().numpy())
+
         # Test the cat on per-channel quantized tensor.
         ch_axis = 1
         scales = torch.from_numpy(np.array([1.0] * X.shape[ch_axis]))
@@ -1153,6 +1235,79 @@ class TestQuantizedOps(TestCase):
             quantize_ref = torch.quantize_per_tensor(float_ref, Y_scale, Y_zero_point, dtype_x)
             self.assertEqual(qy.int_repr().numpy(), quantize_ref.int_repr().numpy())
 
+@unittest.skipUnless('fbgemm' in torch.backends.quantized.supported_engines,
+                     " Quantized operations require FBGEMM. FBGEMM is only optimized for CPUs"
+                     " with instruction set support avx2 or newer.")
+class TestQuantizedRNNCells(TestCase):
+    """Tests the statically quantized int8 LSTM and GRU cell ops."""
+
+    def _make_inputs(self, batch_size, input_size, hidden_size, num_gates):
+        torch.manual_seed(0)
+        x = torch.randn(batch_size, input_size) * 0.1
+        hx = torch.randn(batch_size, hidden_size) * 0.1
+        w_ih = torch.randn(num_gates * hidden_size, input_size) * 0.1
+        w_hh = torch.randn(num_gates * hidden_size, hidden_size) * 0.1
+        b_ih = torch.randn(num_gates * hidden_size) * 0.1
+        b_hh = torch.randn(num_gates * hidden_size) * 0.1
+        x_q = torch.quantize_per_tensor(x, 0.01, 128, torch.quint8)
+        hx_q = torch.quantize_per_tensor(hx, 0.01, 128, torch.quint8)
+        w_ih_q = torch.quantize_per_tensor(w_ih, 0.004, 0, torch.qint8)
+        w_hh_q = torch.quantize_per_tensor(w_hh, 0.004, 0, torch.qint8)
+        packed_ih = torch.ops.quantized.linear_prepack(w_ih_q, b_ih)
+        packed_hh = torch.ops.quantized.linear_prepack(w_hh_q, b_hh)
+        return (x_q, hx_q, w_ih_q, w_hh_q, b_ih, b_hh, packed_ih, packed_hh)
+
+    def test_lstm_cell_int8(self):
+        with override_quantized_engine('fbgemm'):
+            batch_size, input_size, hidden_size = 2, 16, 8
+            (x_q, hx_q, w_ih_q, w_hh_q, b_ih, b_hh, packed_ih, packed_hh) = \
+                self._make_inputs(batch_size, input_size, hidden_size, 4)
+            cx = torch.randn(batch_size, hidden_size) * 0.1
+            gates_scale, gates_zp = 0.01, 128
+            hy_scale, hy_zp = 0.01, 128
+
+            hy, cy = torch.ops.quantized.lstm_cell_int8(
+                x_q, hx_q, cx, packed_ih, packed_hh,
+                gates_scale, gates_zp, hy_scale, hy_zp)
+
+            gates = F.linear(x_q.dequantize(), w_ih_q.dequantize(), b_ih) + \
+                F.linear(hx_q.dequantize(), w_hh_q.dequantize(), b_hh)
+            ingate, forgetgate, cellgate, outgate = gates.chunk(4, 1)
+            cy_ref = forgetgate.sigmoid() * cx + \
+                ingate.sigmoid() * cellgate.tanh()
+            hy_ref = outgate.sigmoid() * cy_ref.tanh()
+
+            self.assertEqual(cy, cy_ref, prec=0.05,
+                             message="quantized.lstm_cell_int8 cy is off")
+            self.assertEqual(hy.dequantize(), hy_ref, prec=0.05,
+                             message="quantized.lstm_cell_int8 hy is off")
+
+    def test_gru_cell_int8(self):
+        with override_quantized_engine('fbgemm'):
+            batch_size, input_size, hidden_size = 2, 16, 8
+            (x_q, hx_q, w_ih_q, w_hh_q, b_ih, b_hh, packed_ih, packed_hh) = \
+                self._make_inputs(batch_size, input_size, hidden_size, 3)
+            gates_scale, gates_zp = 0.01, 128
+            hy_scale, hy_zp = 0.01, 128
+
+            hy = torch.ops.quantized.gru_cell_int8(
+                x_q, hx_q, packed_ih, packed_hh,
+                gates_scale, gates_zp, hy_scale, hy_zp)
+
+            igates = F.linear(x_q.dequantize(), w_ih_q.dequantize(), b_ih)
+            hgates = F.linear(hx_q.dequantize(), w_hh_q.dequantize(), b_hh)
+            i_r, i_z, i_n = igates.chunk(3, 1)
+            h_r, h_z, h_n = hgates.chunk(3, 1)
+            reset_gate = (i_r + h_r).sigmoid()
+            input_gate = (i_z + h_z).sigmoid()
+            new_gate = (i_n + reset_gate * h_n).tanh()
+            hy_ref = new_gate + \
+                input_gate * (hx_q.dequantize() - new_gate)
+
+            self.assertEqual(hy.dequantize(), hy_ref, prec=0.05,
+                             message="quantized.gru_cell_int8 hy is off")
+
+
 @unittest.skipUnless('fbgemm' in torch.backends.quantized.supported_engines,
                      " Quantized operations require FBGEMM. FBGEMM is only optimized for CPUs"
                      " with instruction set support avx2 or newer.")
@@ -894,6 +894,16 @@ class TestSparse(TestCase):
             expected = torch.mm(self.safeToDense(x), y)
             self.assertEqual(res, expected)
 
+            # coalesced tensors take the cached-CSR kernel; run it twice so
+            # both the conversion and the cache-hit paths are exercised
+            xc = x.coalesce()
+            res = torch.addmm(alpha, t, beta, xc, y)
+            expected = torch.addmm(alpha, t, beta, self.safeToDense(xc), y)
+            self.assertEqual(res, expected)
+            res = torch.mm(xc, y)
+            expected = torch.mm(self.safeToDense(xc), y)
+            self.assertEqual(res, expected)
+
         test_shape(10, 100, 100, 20)
         test_shape(100, 1000, 200, 20)
         test_shape(64, 10000, 300, 20)
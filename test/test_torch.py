@@ -603,6 +603,20 @@ class _TestTorchMixin(object):
     def test_min(self):
         self._testSelection(torch.min, min)
 
+    def test_min_max(self):
+        for dtype in (torch.float, torch.double, torch.int64):
+            for size in (5, 100, 10000):
+                x = torch.randn(size).mul(100).to(dtype)
+                minval, maxval = torch._min_max(x)
+                self.assertEqual(minval, x.min())
+                self.assertEqual(maxval, x.max())
+        # non-contiguous input
+        x = torch.randn(100, 2)[:, 0]
+        minval, maxval = torch._min_max(x)
+        self.assertEqual(minval, x.min())
+        self.assertEqual(maxval, x.max())
+        self.assertRaises(RuntimeError, lambda: torch._min_max(torch.empty(0)))
+
     def test_dim_reduction_uint8_overflow(self):
         example = [[-1, 2, 1], [5, 3, 6]]
         x = torch.tensor(example, dtype=torch.uint8)
@@ -637,6 +651,49 @@ class _TestTorchMixin(object):
         torch.logsumexp(a, 1, out=c)
         self.assertTrue(np.allclose(expected, b[:, 0].numpy()))
 
+    def test_filter(self):
+        for dtype in [torch.float, torch.double, torch.long]:
+            x = (torch.randn(4, 37) * 10).to(dtype)
+            self.assertEqual(torch.filter(x, 2), x.masked_select(x > 2))
+            self.assertEqual(x.filter(2), x.masked_select(x > 2))
+        # large enough to exercise the vectorized and parallel paths
+        x = torch.randn(100003)
+        self.assertEqual(torch.filter(x, 0.5), x.masked_select(x > 0.5))
+        self.assertEqual(torch.filter(x, float('inf')).numel(), 0)
+        # non-contiguous input
+        y = x[::2]
+        self.assertEqual(torch.filter(y, 0.0), y.masked_select(y > 0.0))
+
+    def test_ragged_ops(self):
+        values = torch.randn(7, 3)
+        offsets = torch.tensor([0, 2, 2, 7])
+
+        # softmax over each segment of the ragged dimension
+        out = torch.ragged_softmax(values, offsets)
+        for b in range(offsets.numel() - 1):
+            start, end = offsets[b].item(), offsets[b + 1].item()
+            if end > start:
+                self.assertEqual(out[start:end], values[start:end].softmax(0))
+
+        # ragged -> padded fills the tail of short segments
+        padded = torch.ragged_to_padded(values, offsets, padding_value=-1)
+        self.assertEqual(padded.shape, torch.Size([3, 5, 3]))
+        self.assertEqual(padded[0, :2], values[:2])
+        self.assertTrue((padded[0, 2:] == -1).all())
+        self.assertTrue((padded[1] == -1).all())
+
+        # padded -> ragged round-trips
+        lengths = offsets[1:] - offsets[:-1]
+        values2, offsets2 = torch.padded_to_ragged(padded, lengths)
+        self.assertEqual(values2, values)
+        self.assertEqual(offsets2, offsets)
+
+        # malformed offsets are rejected
+        with self.assertRaisesRegex(RuntimeError, "nondecreasing"):
+            torch.ragged_softmax(values, torch.tensor([0, 3, 2, 7]))
+        with self.assertRaisesRegex(RuntimeError, "must equal the length"):
+            torch.ragged_softmax(values, torch.tensor([0, 2, 6]))
+
     @unittest.skipIf(not TEST_NUMPY, "Numpy not found")
     def test_cpu_parallel(self):
         # To use parallel branches we'll need to compare on tensors
@@ -1931,6 +1988,20 @@ class _TestTorchMixin(object):
                         k = random.randint(1, testTensor.size(dim))
                         compare(testTensor, k, dim, dir)
 
+    def test_topk_small_k_long_row(self):
+        # Exercises the small-k selection fast path on rows much longer
+        # than k, including NaN handling (NaN sorts as top).
+        t = torch.randn(4, 10000)
+        t[1, 137] = float('nan')
+        for largest in (True, False):
+            for k in (1, 10, 32):
+                val, ind = t.topk(k, dim=-1, largest=largest, sorted=True)
+                # topk over a non-contiguous dim takes the generic path;
+                # use it as the reference
+                ref_val, _ = t.t().topk(k, dim=0, largest=largest, sorted=True)
+                self.assertEqual(val, ref_val.t(), 0)
+                self.assertEqual(val, t.gather(-1, ind), 0)
+
     def test_topk_arguments(self):
         q = torch.randn(10, 2, 10)
         # Make sure True isn't mistakenly taken as the 2nd dimension (interpreted as 1)
@@ -2639,6 +2710,50 @@ class _TestTorchMixin(object):
                 added = zeros.index_add(0, torch.arange(0, size[0], dtype=torch.long, device=device), tensor)
                 self.assertEqual(added, tensor)
 
+    def test_segment_reduce(self):
+        for device in torch.testing.get_all_device_types():
+            values = torch.randn(10, 6, device=device)
+            offsets = torch.tensor([0, 3, 3, 7, 10], device=device)
+            lengths = offsets[1:] - offsets[:-1]
+            segments = [values[b:e] for b, e in zip(offsets[:-1], offsets[1:])]
+
+            def reference(segment, reduce):
+                # empty segments reduce to zero regardless of the reduction
+                if segment.numel() == 0:
+                    return torch.zeros(6, device=device)
+                if reduce == 'max':
+                    return segment.max(0)[0]
+                return getattr(segment, reduce)(0)
+
+            for reduce in ('sum', 'mean', 'max'):
+                expected = torch.stack([reference(s, reduce) for s in segments])
+                res = torch.segment_reduce(values, offsets, reduce)
+                self.assertEqual(res, expected)
+
+            # backward: sum broadcasts grad, mean scales it by segment length
+            v = values.clone().requires_grad_()
+            grad_out = torch.randn(4, 6, device=device)
+            torch.segment_reduce(v, offsets, 'sum').backward(grad_out)
+            expected_grad = torch.repeat_interleave(grad_out, lengths, dim=0)
+            self.assertEqual(v.grad, expected_grad)
+
+            v = values.clone().requires_grad_()
+            torch.segment_reduce(v, offsets, 'mean').backward(grad_out)
+            expected_grad = torch.repeat_interleave(
+                grad_out / lengths.unsqueeze(1).float().clamp(min=1), lengths, dim=0)
+            self.assertEqual(v.grad, expected_grad)
+
+            # max routes the gradient to the elements attaining the maximum
+            v = values.clone().requires_grad_()
+            out = torch.segment_reduce(v, offsets, 'max')
+            out.backward(grad_out)
+            mask = values == torch.repeat_interleave(out.detach(), lengths, dim=0)
+            expected_grad = torch.repeat_interleave(grad_out, lengths, dim=0) * mask.float()
+            self.assertEqual(v.grad, expected_grad)
+
+            with self.assertRaisesRegex(RuntimeError, 'unsupported reduction'):
+                torch.segment_reduce(values, offsets, 'prod')
+
     def test_t(self):
         # Test 0D tensors
         x = torch.randn(())
@@ -4050,6 +4165,24 @@ class _TestTorchMixin(object):
             t2.fill_(rnum)
             self.assertEqual(t1, t2, 0)
 
+    @unittest.skipIf(IS_WINDOWS, "MappedAllocator is not supported on Windows")
+    def test_torch_from_file_hugepages(self):
+        size = 10000
+        with tempfile.NamedTemporaryFile() as f:
+            expected = torch.randn(size)
+            torch.from_file(f.name, True, size, dtype=torch.float).copy_(expected)
+
+            # hugepages/populate take the c10::MappedAllocator path; a
+            # private prefaulted mapping must still see the file contents
+            t = torch.from_file(f.name, False, size, hugepages=True,
+                                populate=True, dtype=torch.float)
+            self.assertEqual(t, expected, 0)
+
+            # size defaults to the whole file on this path
+            t2 = torch.from_file(f.name, False, 0, hugepages=True,
+                                 dtype=torch.float)
+            self.assertEqual(t2.numel(), size)
+
     def test_print(self):
         default_type = torch.Tensor().type()
         for t in torch._tensor_classes:
@@ -4978,6 +5111,21 @@ tensor([[[1., 1., 1.,  ..., 1., 1., 1.],
     def test_parallel_info(self):
         torch.__config__.parallel_info()
 
+    def test_thread_affinity(self):
+        prev = torch.get_thread_affinity()
+        try:
+            torch.set_thread_affinity([0])
+            self.assertEqual(torch.get_thread_affinity(), [0])
+            torch.set_thread_affinity([])
+            self.assertEqual(torch.get_thread_affinity(), [])
+            self.assertRaises(RuntimeError, lambda: torch.set_thread_affinity(0))
+            if sys.platform == 'linux':
+                # the effective placement of the calling thread is reported by
+                # the scheduler and is never empty on Linux
+                self.assertGreater(len(torch._C._get_effective_thread_affinity()), 0)
+        finally:
+            torch.set_thread_affinity(prev)
+
     @slowTest
     def test_slow_test(self):
         # Just a smoketest to make sure our slowTest decorator works.
@@ -6145,6 +6293,32 @@ class TestTorchDeviceType(TestCase):
         expected_inv = torch.as_tensor(inv(matrices.cpu().numpy()))
         self.assertEqual(matrices_inverse, expected_inv.to(device))
 
+    def test_inverse_small_sizes(self, device):
+        # sizes 2-4 take an unrolled Cramer-rule path on CPU; check it against
+        # the identity and against the general LAPACK path semantics
+        from torch.testing._internal.common_utils import random_fullrank_matrix_distinct_singular_value
+
+        for n in (2, 3, 4):
+            for dtype in (torch.float, torch.double):
+                matrices = random_fullrank_matrix_distinct_singular_value(n, 64).to(
+                    device=device, dtype=dtype)
+                matrices_inverse = torch.inverse(matrices)
+                identity = torch.eye(n, device=device, dtype=dtype).expand_as(matrices)
+                self.assertEqual(torch.matmul(matrices, matrices_inverse), identity,
+                                 1e-3 if dtype == torch.float else 1e-8)
+                # non-contiguous inputs: inverse of the transpose is the
+                # transpose of the inverse
+                self.assertEqual(torch.inverse(matrices.transpose(-2, -1)),
+                                 matrices_inverse.transpose(-2, -1),
+                                 1e-3 if dtype == torch.float else 1e-8)
+            # non-batched
+            matrix = random_fullrank_matrix_distinct_singular_value(n).to(device)
+            self.assertEqual(torch.mm(matrix, torch.inverse(matrix)),
+                             torch.eye(n, device=device), 1e-8)
+            # singular input is reported like a zero pivot
+            with self.assertRaisesRegex(RuntimeError, 'singular'):
+                torch.inverse(torch.zeros(n, n, device=device))
+
     def test_bitwise_not(self, device):
         res = 0xffff - torch.arange(127, dtype=torch.int8, device=device)
         for dtype in (torch.bool, torch.uint8, torch.int8, torch.int16, torch.int32, torch.int64):
@@ -7607,6 +7781,20 @@ class TestTorchDeviceType(TestCase):
         x.set_(x.storage(), 0, x.size(), stride)
         self.assertTrue(x.is_contiguous())
 
+    def test_contiguous_transposed(self, device):
+        # exercises the blocked copy path for transposed layouts, including
+        # sizes that are not a multiple of the block size
+        for n, m in [(64, 64), (65, 67), (3, 129), (1, 5)]:
+            for dtype in [torch.float, torch.double, torch.long, torch.uint8]:
+                x = torch.arange(n * m, device=device).reshape(n, m).to(dtype)
+                y = x.t().contiguous()
+                self.assertTrue(y.is_contiguous())
+                self.assertEqual(y, x.t())
+                # non-contiguous destination rows take the generic path
+                z = torch.empty(m, 2 * n, device=device, dtype=dtype)[:, ::2]
+                z.copy_(x.t())
+                self.assertEqual(z, x.t())
+
     def test_index(self, device):
 
         def consec(size, start=1):
@@ -9956,6 +10144,31 @@ class TestTorchDeviceType(TestCase):
                                lambda: torch.add(m1, m2, alpha=1.0))
 
 
+    def test_foreach_binary_ops(self, device):
+        # _foreach ops apply an in-place binary op over lists of tensors
+        # with a single dispatch; results must match the per-tensor ops.
+        sizes = [(3, 4), (10,), (2, 2, 2)]
+        selfs = [torch.randn(s, device=device) for s in sizes]
+        others = [torch.randn(s, device=device) for s in sizes]
+
+        refs = [a.clone() for a in selfs]
+        torch._foreach_add_(selfs, others, alpha=2)
+        for r, o in zip(refs, others):
+            r.add_(o, alpha=2)
+        self.assertEqual(selfs, refs)
+
+        torch._foreach_sub_(selfs, others)
+        torch._foreach_mul_(selfs, others)
+        torch._foreach_div_(selfs, others)
+        for r, o in zip(refs, others):
+            r.sub_(o).mul_(o).div_(o)
+        self.assertEqual(selfs, refs)
+
+        with self.assertRaisesRegex(RuntimeError, "same number of tensors"):
+            torch._foreach_add_(selfs, others[:-1])
+        with self.assertRaisesRegex(RuntimeError, "at least one tensor"):
+            torch._foreach_mul_([], [])
+
     def test_sub_typing(self, device):
         m1 = torch.tensor([True, False, False, True, False, False], dtype=torch.bool, device=device)
         m2 = torch.tensor([True, True, False, False, False, True], dtype=torch.bool, device=device)
@@ -14000,6 +14213,70 @@ class TestTorchDeviceType(TestCase):
         z = torch.randn(2, 2, 1, device=device)
         self.assertRaises(RuntimeError, lambda: torch.cat([x, y, z], dim=1))
 
+    @onlyCPU
+    @dtypes(torch.double, torch.int64)
+    def test_cat_many_small_tensors(self, device, dtype):
+        # exercises the fused contiguous concatenation path, which kicks in
+        # for long input lists, along with its non-contiguous fallback
+        for dim in range(3):
+            inputs = []
+            for i in range(40):
+                size = [4, 3, 5]
+                size[dim] = i % 3 + 1
+                inputs.append(torch.randint(low=-100, high=100, size=size, device=device).to(dtype))
+            res = torch.cat(inputs, dim)
+            offset = 0
+            for t in inputs:
+                self.assertEqual(res.narrow(dim, offset, t.size(dim)), t, 0)
+                offset += t.size(dim)
+
+            # pre-sized output: the caller guarantees the shapes, so the
+            # per-input scans are skipped entirely
+            out = res.clone().zero_()
+            torch._cat_presized_(out, inputs, dim)
+            self.assertEqual(out, res, 0)
+
+        # non-contiguous inputs fall back to the iterator path
+        inputs = [torch.randint(low=-100, high=100, size=(6, 8), device=device).to(dtype).t()
+                  for _ in range(12)]
+        res = torch.cat(inputs, 1)
+        self.assertEqual(res, torch.cat([t.contiguous() for t in inputs], 1), 0)
+
+        # legacy size-[0] placeholders are still skipped by the fused path
+        inputs = [torch.randint(low=-100, high=100, size=(2, 3), device=device).to(dtype)
+                  for _ in range(10)]
+        inputs.insert(4, torch.empty(0, dtype=dtype, device=device))
+        self.assertEqual(torch.cat(inputs, 0).size(0), 20)
+
+    @onlyCPU
+    def test_hash_tensor(self, device):
+        x = torch.randn(37, 21, device=device)
+        digest = torch.hash_tensor(x)
+        self.assertEqual(digest.shape, torch.Size([2]))
+        self.assertEqual(digest.dtype, torch.int64)
+
+        # deterministic, and a bitwise copy hashes alike regardless of layout
+        self.assertEqual(digest, torch.hash_tensor(x))
+        self.assertEqual(digest, torch.hash_tensor(x.clone()))
+        y = x.t()
+        self.assertEqual(torch.hash_tensor(y), torch.hash_tensor(y.contiguous()))
+
+        # content, shape, and dtype all feed the digest
+        z = x.clone()
+        z[3, 4] += 1
+        self.assertNotEqual(digest, torch.hash_tensor(z))
+        self.assertNotEqual(digest, torch.hash_tensor(x.reshape(21, 37)))
+        self.assertNotEqual(digest, torch.hash_tensor(y))
+        self.assertNotEqual(
+            torch.hash_tensor(torch.zeros(8, device=device)),
+            torch.hash_tensor(torch.zeros(8, device=device, dtype=torch.int64)))
+
+        # empty and scalar tensors are valid inputs
+        torch.hash_tensor(torch.empty(0, 5, device=device))
+        self.assertEqual(
+            torch.hash_tensor(torch.tensor(2.5, device=device)),
+            torch.hash_tensor(torch.tensor(2.5, device=device)))
+
     @slowTest
     @onlyCPU
     def test_cat_big(self, device):
@@ -14231,6 +14508,40 @@ class TestDevicePrecision(TestCase):
         self.assertEqual(x.type(torch.int).device, torch.device(devices[1]))
         self.assertEqual(x.to(torch.int).device, torch.device(devices[1]))
 
+    def test_min_max_fused(self, device):
+        for dtype in (torch.float, torch.double, torch.int64):
+            for size in (5, 100, 10000):
+                x = torch.randn(size).mul(100).to(dtype).to(device)
+                minval, maxval = torch._min_max(x)
+                self.assertEqual(minval, x.min())
+                self.assertEqual(maxval, x.max())
+        # non-contiguous input
+        x = torch.randn(100, 2, device=device)[:, 0]
+        minval, maxval = torch._min_max(x)
+        self.assertEqual(minval, x.min())
+        self.assertEqual(maxval, x.max())
+        # NaNs propagate to both outputs
+        x = torch.arange(25.0, device=device)
+        x[13] = nan
+        minval, maxval = torch._min_max(x)
+        self.assertTrue(torch.isnan(minval))
+        self.assertTrue(torch.isnan(maxval))
+
+    def test_addmm_activation(self, device):
+        for dtype in (torch.float, torch.double):
+            bias = torch.randn(5, device=device, dtype=dtype)
+            mat1 = torch.randn(4, 3, device=device, dtype=dtype)
+            mat2 = torch.randn(3, 5, device=device, dtype=dtype)
+            ref = torch.addmm(bias, mat1, mat2)
+            self.assertEqual(
+                torch._addmm_activation(bias, mat1, mat2), ref.relu())
+            self.assertEqual(
+                torch._addmm_activation(bias, mat1, mat2, use_gelu=True),
+                torch.nn.functional.gelu(ref))
+            self.assertEqual(
+                torch._addmm_activation(bias, mat1, mat2, beta=0.5, alpha=2),
+                torch.addmm(bias, mat1, mat2, beta=0.5, alpha=2).relu())
+
     def test_min_max_nan(self, device):
         tests = [(lambda x: x.min(), 'min'),
                  (lambda x: x.max(), 'max'),
@@ -6163,7 +6163,10 @@ mz_bool mz_zip_writer_add_mem_ex_v2(mz_zip_archive *pZip, const char *pArchive_n
 
     MZ_CLEAR_OBJ(local_dir_header);
 
-    if (!store_data_uncompressed || (level_and_flags & MZ_ZIP_FLAG_COMPRESSED_DATA))
+    /* PyTorch local patch: MZ_ZIP_FLAG_COMPRESSED_DATA with level 0 means the
+       caller supplies a precomputed CRC32 for data that is stored verbatim,
+       so the method must remain 0 (stored), not MZ_DEFLATED. */
+    if (!store_data_uncompressed || ((level_and_flags & MZ_ZIP_FLAG_COMPRESSED_DATA) && level))
     {
         method = MZ_DEFLATED;
     }
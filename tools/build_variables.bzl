@@ -35,6 +35,7 @@ libtorch_sources = [
     "torch/csrc/autograd/VariableTypeManual.cpp",
     "torch/csrc/autograd/anomaly_mode.cpp",
     "torch/csrc/autograd/autograd.cpp",
+    "torch/csrc/autograd/checkpoint.cpp",
     "torch/csrc/autograd/custom_function.cpp",
     "torch/csrc/autograd/cpp_hook.cpp",
     "torch/csrc/autograd/engine.cpp",
@@ -45,7 +46,9 @@ libtorch_sources = [
     "torch/csrc/autograd/functions/tensor.cpp",
     "torch/csrc/autograd/functions/utils.cpp",
     "torch/csrc/autograd/input_buffer.cpp",
+    "torch/csrc/autograd/op_latency_histogram.cpp",
     "torch/csrc/autograd/profiler.cpp",
+    "torch/csrc/autograd/profiler_perf_events.cpp",
     "torch/csrc/autograd/record_function.cpp",
     "torch/csrc/autograd/record_function_ops.cpp",
     "torch/csrc/autograd/saved_variable.cpp",
@@ -89,6 +92,7 @@ libtorch_sources = [
     "torch/csrc/jit/pass_manager.cpp",
     "torch/csrc/jit/pickler.cpp",
     "torch/csrc/jit/unpickler.cpp",
+    "torch/csrc/jit/dynamic_batcher.cpp",
     "torch/csrc/jit/graph_executor.cpp",
     "torch/csrc/jit/import.cpp",
     "torch/csrc/jit/import_legacy.cpp",
@@ -108,6 +112,7 @@ libtorch_sources = [
     "torch/csrc/jit/operator.cpp",
     "torch/csrc/jit/passes/alias_analysis.cpp",
     "torch/csrc/jit/passes/batch_mm.cpp",
+    "torch/csrc/jit/passes/batch_parallel_chains.cpp",
     "torch/csrc/jit/passes/bailout_graph.cpp",
     "torch/csrc/jit/passes/canonicalize_ops.cpp",
     "torch/csrc/jit/passes/decompose_ops.cpp",
@@ -130,18 +135,23 @@ libtorch_sources = [
     "torch/csrc/jit/passes/insert_guards.cpp",
     "torch/csrc/jit/passes/liveness.cpp",
     "torch/csrc/jit/passes/loop_unrolling.cpp",
+    "torch/csrc/jit/passes/memory_planning.cpp",
+    "torch/csrc/jit/passes/memoize_subgraphs.cpp",
     "torch/csrc/jit/passes/lower_grad_of.cpp",
     "torch/csrc/jit/passes/lower_graph.cpp",
     "torch/csrc/jit/passes/lower_tuples.cpp",
     "torch/csrc/jit/passes/peephole.cpp",
     "torch/csrc/jit/passes/python_print.cpp",
     "torch/csrc/jit/passes/quantization.cpp",
+    "torch/csrc/jit/passes/freeze_module.cpp",
     "torch/csrc/jit/passes/fuse_linear.cpp",
     "torch/csrc/jit/passes/remove_expands.cpp",
     "torch/csrc/jit/passes/requires_grad_analysis.cpp",
     "torch/csrc/jit/passes/shape_analysis.cpp",
+    "torch/csrc/jit/passes/shape_interpreter.cpp",
     "torch/csrc/jit/passes/specialize_autogradzero.cpp",
     "torch/csrc/jit/passes/subgraph_rewrite.cpp",
+    "torch/csrc/jit/passes/tensor_core_advisor.cpp",
     "torch/csrc/jit/passes/tensorexpr_fuser.cpp",
     "torch/csrc/jit/passes/utils/subgraph_utils.cpp",
     "torch/csrc/jit/passes/utils/memory_dag.cpp",
@@ -226,6 +236,7 @@ libtorch_cuda_sources = [
 
 torch_cpp_srcs = [
     "torch/csrc/api/src/cuda.cpp",  # this just forwards stuff, no real CUDA
+    "torch/csrc/api/src/data/datasets/columnar.cpp",
     "torch/csrc/api/src/data/datasets/mnist.cpp",
     "torch/csrc/api/src/data/samplers/distributed.cpp",
     "torch/csrc/api/src/data/samplers/random.cpp",
@@ -343,6 +354,7 @@ def add_torch_libs():
         "torch/csrc/distributed/rpc/python_functions.cpp",
         "torch/csrc/distributed/rpc/python_rpc_handler.cpp",
         "torch/csrc/distributed/rpc/request_callback_impl.cpp",
+        "torch/csrc/distributed/rpc/tcp_agent.cpp",
         "torch/csrc/jit/init.cpp",
         "torch/csrc/jit/passes/inline_fork_wait.cpp",
         "torch/csrc/jit/passes/onnx.cpp",
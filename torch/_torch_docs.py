@@ -4981,6 +4981,27 @@ WARNING: Can only be called once and before any inter-op parallel work
 is started (e.g. JIT execution).
 """)
 
+add_docstr(torch.set_thread_affinity,
+           r"""
+set_thread_affinity(cpus)
+
+Sets the list of CPU cores that intra-op and inter-op pool threads are
+pinned to, using the kernel's CPU numbering (what a cgroup cpuset or
+``taskset`` would name). Pass an empty list to clear the pinning for
+threads started afterwards.
+WARNING:
+Workers apply the list when they start, so set_thread_affinity must be
+called before the thread pools are spawned by the first parallel region.
+""")
+
+add_docstr(torch.get_thread_affinity,
+           r"""
+get_thread_affinity() -> List[int]
+
+Returns the CPU core list configured with :func:`torch.set_thread_affinity`
+(empty if unset).
+""")
+
 add_docstr(torch.sigmoid,
            r"""
 sigmoid(input, out=None) -> Tensor
@@ -41,7 +41,8 @@ def _make_grads(outputs, grads):
     return tuple(new_grads)
 
 
-def backward(tensors, grad_tensors=None, retain_graph=None, create_graph=False, grad_variables=None):
+def backward(tensors, grad_tensors=None, retain_graph=None, create_graph=False, grad_variables=None,
+             priority=0):
     r"""Computes the sum of gradients of given tensors w.r.t. graph leaves.
 
     The graph is differentiated using the chain rule. If any of ``tensors``
@@ -71,6 +72,11 @@ def backward(tensors, grad_tensors=None, retain_graph=None, create_graph=False,
         create_graph (bool, optional): If ``True``, graph of the derivative will
             be constructed, allowing to compute higher order derivative products.
             Defaults to ``False``.
+        priority (int, optional): Scheduling priority of this backward call
+            relative to other concurrently running backward calls. Tasks from
+            a higher-priority call are executed first by the engine's worker
+            threads, so a latency-critical backward can overtake bulk ones.
+            Defaults to ``0``.
     """
     if grad_variables is not None:
         warnings.warn("'grad_variables' is deprecated. Use 'grad_tensors' instead.")
@@ -96,11 +102,11 @@ def backward(tensors, grad_tensors=None, retain_graph=None, create_graph=False,
 
     Variable._execution_engine.run_backward(
         tensors, grad_tensors, retain_graph, create_graph,
-        allow_unreachable=True)  # allow_unreachable flag
+        allow_unreachable=True, priority=priority)  # allow_unreachable flag
 
 
 def grad(outputs, inputs, grad_outputs=None, retain_graph=None, create_graph=False,
-         only_inputs=True, allow_unused=False):
+         only_inputs=True, allow_unused=False, priority=0):
     r"""Computes and returns the sum of gradients of outputs w.r.t. the inputs.
 
     ``grad_outputs`` should be a sequence of length matching ``output``
@@ -131,6 +137,12 @@ def grad(outputs, inputs, grad_outputs=None, retain_graph=None, create_graph=Fal
         allow_unused (bool, optional): If ``False``, specifying inputs that were not
             used when computing outputs (and therefore their grad is always zero)
             is an error. Defaults to ``False``.
+        priority (int, optional): Scheduling priority of this backward call
+            relative to other concurrently running backward calls. Tasks from
+            a higher-priority call are executed first by the engine's worker
+            threads. Combined with a subset of ``outputs`` this runs a partial,
+            branch-first backward for the latency-critical head while the rest
+            of the graph lags. Defaults to ``0``.
     """
     if not only_inputs:
         warnings.warn("only_inputs argument is deprecated and is ignored now "
@@ -154,7 +166,7 @@ def grad(outputs, inputs, grad_outputs=None, retain_graph=None, create_graph=Fal
 
     return Variable._execution_engine.run_backward(
         outputs, grad_outputs, retain_graph, create_graph,
-        inputs, allow_unused)
+        inputs, allow_unused, priority=priority)
 
 
 # This function applies in case of gradient checkpointing for memory
@@ -375,6 +375,115 @@ class record_function(ContextDecorator):
         return False
 
 
+def enable_op_latency_histograms():
+    """Starts aggregating per-op-name latency histograms.
+
+    Unlike :class:`profile`, this does not record individual events: each op
+    only increments a counter in an exponentially-bucketed histogram, so it is
+    cheap enough to leave enabled in production. Use
+    :func:`snapshot_op_latency_histograms` to read the counters.
+    """
+    torch.autograd._enable_op_latency_histograms()
+
+
+def disable_op_latency_histograms():
+    """Stops aggregating per-op-name latency histograms."""
+    torch.autograd._disable_op_latency_histograms()
+
+
+def snapshot_op_latency_histograms():
+    """Returns latency histograms merged across all threads.
+
+    Returns a dict mapping op name to a dict with keys ``count``, ``total_ns``
+    and ``buckets``, where ``buckets`` is a list of
+    ``(bucket_lower_bound_ns, count)`` pairs; bucket ``i`` covers latencies in
+    ``[2**i, 2**(i + 1))`` nanoseconds. Collection is not interrupted.
+    """
+    return torch.autograd._snapshot_op_latency_histograms()
+
+
+def reset_op_latency_histograms():
+    """Clears all accumulated op latency histograms."""
+    torch.autograd._reset_op_latency_histograms()
+
+
+def enable_memory_tracing(stack_depth=0):
+    """Starts recording every allocation that goes through the c10 allocators.
+
+    Each allocation is tagged with the op that was running on the allocating
+    thread (so run your workload under :class:`profile`, which is what emits
+    the op markers) and, if ``stack_depth`` is nonzero, with a fingerprint of
+    that many frames of the C++ call stack. Use
+    :func:`snapshot_memory_tracing` for per-op live/peak aggregates and
+    :func:`memory_tracing_live_allocations` for the outstanding allocations;
+    this is how you find which op owns a transient memory spike.
+    """
+    torch.autograd._enable_memory_tracing(stack_depth)
+
+
+def disable_memory_tracing():
+    """Stops memory tracing; recorded tables remain queryable."""
+    torch.autograd._disable_memory_tracing()
+
+
+def clear_memory_tracing():
+    """Drops all recorded memory tracing state."""
+    torch.autograd._clear_memory_tracing()
+
+
+def snapshot_memory_tracing():
+    """Returns a dict mapping op name to its memory stats.
+
+    Each value has ``live_bytes``, ``peak_bytes``, ``total_allocated_bytes``
+    and ``allocation_count``. Allocations made while no op was active are
+    aggregated under the empty string.
+    """
+    return torch.autograd._snapshot_memory_tracing()
+
+
+def memory_tracing_live_allocations():
+    """Returns the live-allocation table as a list of dicts.
+
+    Each entry has ``nbytes``, ``device``, ``op_name`` and
+    ``stack_fingerprint``; resolve the fingerprint with
+    :func:`memory_tracing_backtrace`.
+    """
+    return torch.autograd._memory_tracing_live_allocations()
+
+
+def memory_tracing_backtrace(fingerprint):
+    """Resolves a stack fingerprint to the backtrace captured for it."""
+    return torch.autograd._memory_tracing_fingerprint_backtrace(fingerprint)
+
+
+def enable_sampling_profiler(sample_rate):
+    """Starts recording a sampled subset of ops into per-thread ring buffers.
+
+    Unlike :class:`profile`, only a ``sample_rate`` fraction of ops is
+    recorded, each as a fixed-size record with an interned name in a lock-free
+    ring buffer, so it is cheap enough to leave enabled in production (e.g. at
+    a rate of ``0.01``). Use :func:`drain_sampled_events` to collect the
+    accumulated samples; each ring holds the most recent 8192 records per
+    thread, so drain often enough for the expected event rate.
+    """
+    torch.autograd._enable_sampling_profiler(sample_rate)
+
+
+def disable_sampling_profiler():
+    """Stops the sampling profiler and returns the remaining samples."""
+    return torch.autograd._disable_sampling_profiler()
+
+
+def drain_sampled_events():
+    """Returns (and consumes) samples accumulated since the last drain.
+
+    Returns a list of events ordered by timestamp, with ``name()``,
+    ``kind()`` (``"push"`` or ``"pop"``), ``thread_id()`` and ``cpu_ns()``
+    accessors. Collection is not interrupted.
+    """
+    return torch.autograd._drain_sampled_events()
+
+
 class emit_nvtx(object):
     """Context manager that makes every autograd operation emit an NVTX range.
 
@@ -10,6 +10,7 @@
 #include <libshm.h>
 #include <TH/TH.h>
 #include <c10/util/Logging.h>
+#include <c10/util/thread_affinity.h>
 #include <ATen/ATen.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/dlpack.h>
@@ -191,6 +192,49 @@ static PyObject * THPModule_setNumInteropThreads(PyObject *module, PyObject *arg
   Py_RETURN_NONE;
 }
 
+static PyObject * THPModule_setThreadAffinity(PyObject *module, PyObject *arg)
+{
+  HANDLE_TH_ERRORS
+  THPUtils_assert(PySequence_Check(arg), "set_thread_affinity expects a sequence of ints, "
+          "but got %s", THPUtils_typename(arg));
+  THPObjectPtr seq(PySequence_Fast(arg, "set_thread_affinity expects a sequence of ints"));
+  if (!seq) return nullptr;
+  Py_ssize_t length = PySequence_Fast_GET_SIZE(seq.get());
+  std::vector<int> cpus;
+  cpus.reserve(length);
+  for (Py_ssize_t i = 0; i < length; i++) {
+    PyObject* item = PySequence_Fast_GET_ITEM(seq.get(), i);
+    THPUtils_assert(THPUtils_checkLong(item), "set_thread_affinity expects a sequence of ints, "
+            "but found %s", THPUtils_typename(item));
+    cpus.push_back((int)THPUtils_unpackLong(item));
+  }
+  c10::SetThreadAffinityCPUs(cpus);
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject* wrap_cpu_list(const std::vector<int>& cpus)
+{
+  THPObjectPtr list(PyList_New(cpus.size()));
+  if (!list) return nullptr;
+  for (size_t i = 0; i < cpus.size(); i++) {
+    PyObject* cpu = PyLong_FromLong(cpus[i]);
+    if (!cpu) return nullptr;
+    PyList_SET_ITEM(list.get(), i, cpu);
+  }
+  return list.release();
+}
+
+static PyObject * THPModule_getThreadAffinity(PyObject *module, PyObject *noargs)
+{
+  return wrap_cpu_list(c10::GetThreadAffinityCPUs());
+}
+
+static PyObject * THPModule_getEffectiveThreadAffinity(PyObject *module, PyObject *noargs)
+{
+  return wrap_cpu_list(c10::GetCurrentThreadAffinity());
+}
+
 PyObject * THPModule_setDefaultTensorType(PyObject *_unused, PyObject *type)
 {
   HANDLE_TH_ERRORS
@@ -544,6 +588,9 @@ static PyMethodDef TorchMethods[] = {
   {"set_num_threads", (PyCFunction)THPModule_setNumThreads,     METH_O,       nullptr},
   {"get_num_interop_threads", (PyCFunction)THPModule_getNumInteropThreads,     METH_NOARGS,  nullptr},
   {"set_num_interop_threads", (PyCFunction)THPModule_setNumInteropThreads,     METH_O,       nullptr},
+  {"set_thread_affinity", (PyCFunction)THPModule_setThreadAffinity, METH_O,      nullptr},
+  {"get_thread_affinity", (PyCFunction)THPModule_getThreadAffinity, METH_NOARGS, nullptr},
+  {"_get_effective_thread_affinity", (PyCFunction)THPModule_getEffectiveThreadAffinity, METH_NOARGS, nullptr},
   {"_get_cudnn_enabled", (PyCFunction)THPModule_userEnabledCuDNN, METH_NOARGS,     nullptr},
   {"_set_cudnn_enabled", (PyCFunction)THPModule_setUserEnabledCuDNN, METH_O,  nullptr},
   {"_get_mkldnn_enabled", (PyCFunction)THPModule_userEnabledMkldnn, METH_NOARGS,     nullptr},
@@ -2,6 +2,7 @@
 
 #include <torch/data/dataloader_options.h>
 #include <torch/data/detail/data_shuttle.h>
+#include <torch/data/detail/pin_memory.h>
 #include <torch/data/detail/sequencers.h>
 #include <torch/data/iterator.h>
 #include <torch/data/samplers/random.h>
@@ -11,11 +12,14 @@
 #include <torch/csrc/utils/memory.h>
 #include <torch/csrc/utils/variadic.h>
 
+#include <c10/util/C++17.h>
 #include <c10/util/Exception.h>
 
+#include <condition_variable>
 #include <cstddef>
 #include <exception>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -106,14 +110,22 @@ class DataLoaderBase {
 
   struct QuitWorker {};
 
-  /// A `Job` is either a `BatchRequest` (new indices to fetch data at) or a
-  /// `QuitWorker` object, to indicate the worker should shut down.
+  /// Message telling a worker that a new epoch is starting, so that it can
+  /// call `reset()` on its copy of the dataset (if the dataset has one)
+  /// without the thread being torn down and re-created.
+  struct ResetDataset {};
+
+  /// A `Job` is either a `BatchRequest` (new indices to fetch data at), a
+  /// `ResetDataset` message, or a `QuitWorker` object, to indicate the worker
+  /// should shut down.
   struct Job : Sequenced {
     Job() = default;
     Job(QuitWorker q, size_t sqn) : Sequenced(sqn), quit(q) {}
+    Job(ResetDataset r, size_t sqn) : Sequenced(sqn), reset(r) {}
     Job(BatchRequest&& i, size_t sqn)
         : Sequenced(sqn), batch_request(std::move(i)) {}
     optional<QuitWorker> quit;
+    optional<ResetDataset> reset;
     optional<BatchRequest> batch_request;
   };
 
@@ -154,9 +166,46 @@ class DataLoaderBase {
     }
   }
 
-  /// Schedules the maximum number of jobs (based on the `max_jobs` option).
+  /// Schedules `prefetch_count` many jobs. This defaults to `max_jobs` but
+  /// can be configured independently to bound the number of batches held in
+  /// memory ahead of consumption.
   void prefetch() {
-    prefetch(options_.max_jobs);
+    prefetch(options_.prefetch_count);
+  }
+
+  /// Sends one `ResetDataset` message to every worker and waits until all of
+  /// them have applied it to their copy of the dataset. This lets datasets
+  /// with per-epoch state (open file handles, memory maps, shuffle state)
+  /// refresh it once per epoch while the worker threads stay alive, so any
+  /// expensive per-worker warmup is paid once per DataLoader instead of once
+  /// per epoch. No-op when the dataset has no `reset()` method or data is
+  /// loaded on the main thread.
+  void reset_worker_datasets() {
+    if (!has_reset_method<Dataset>::value) {
+      return;
+    }
+    if (options_.workers == 0) {
+      if (main_thread_dataset_ != nullptr) {
+        apply_dataset_reset(*main_thread_dataset_);
+      }
+      return;
+    }
+    shuttle_.drain();
+    sequence_number_ = 0;
+    sequencer_ = new_sequencer();
+    for (size_t w = 0; w < options_.workers; ++w) {
+      push_job(ResetDataset());
+    }
+    // Wait for every worker's acknowledgement, surfacing any exception the
+    // dataset reset may have thrown. The rendezvous in the workers ensures
+    // each one consumes exactly one message.
+    for (size_t w = 0; w < options_.workers; ++w) {
+      auto result = pop_result();
+      AT_ASSERT(result.has_value());
+      if (result->exception) {
+        throw WorkerException(result->exception);
+      }
+    }
   }
 
   /// Returns the next batch of data, or an empty `optional` if the DataLoader
@@ -173,7 +222,12 @@ class DataLoaderBase {
         }
       }
     } else if (auto batch_request = get_batch_request()) {
-      return this->main_thread_dataset_->get_batch(std::move(*batch_request));
+      auto batch =
+          this->main_thread_dataset_->get_batch(std::move(*batch_request));
+      if (options_.pin_memory) {
+        batch = detail::pin_batch_memory(std::move(batch));
+      }
+      return batch;
     }
     return nullopt;
   }
@@ -185,8 +239,31 @@ class DataLoaderBase {
       if (job.quit) {
         break;
       }
+      if (job.reset) {
+        std::exception_ptr exception;
+        try {
+          apply_dataset_reset(dataset);
+        } catch (...) {
+          exception = std::current_exception();
+        }
+        // Rendezvous with the other workers so that each one consumes
+        // exactly one reset message before anyone pulls new batch jobs.
+        rendezvous_on_reset();
+        if (exception) {
+          shuttle_.push_result({std::move(exception), job.sequence_number});
+        } else {
+          shuttle_.push_result({optional<Batch>(), job.sequence_number});
+        }
+        continue;
+      }
       try {
         auto batch = dataset.get_batch(std::move(*job.batch_request));
+        // Staging into pinned buffers happens here, in the worker, so the
+        // consumer thread receives batches that are already cheap to move
+        // to the GPU asynchronously.
+        if (options_.pin_memory) {
+          batch = detail::pin_batch_memory(std::move(batch));
+        }
         shuttle_.push_result({std::move(batch), job.sequence_number});
       } catch (...) {
         shuttle_.push_result({std::current_exception(), job.sequence_number});
@@ -217,6 +294,44 @@ class DataLoaderBase {
     return torch::make_unique<detail::sequencers::NoSequencer<Result>>();
   }
 
+  /// Detects whether the dataset provides a `reset()` method that workers
+  /// should invoke at the start of every epoch.
+  template <typename T, typename = void>
+  struct has_reset_method : std::false_type {};
+
+  template <typename T>
+  struct has_reset_method<
+      T,
+      c10::guts::void_t<decltype(std::declval<T&>().reset())>>
+      : std::true_type {};
+
+  /// Calls `dataset.reset()` when the dataset has one, and does nothing
+  /// otherwise.
+  template <typename T = Dataset>
+  typename std::enable_if<has_reset_method<T>::value>::type
+  apply_dataset_reset(T& dataset) {
+    dataset.reset();
+  }
+
+  template <typename T = Dataset>
+  typename std::enable_if<!has_reset_method<T>::value>::type
+  apply_dataset_reset(T& /* dataset */) {}
+
+  /// Barrier on which workers wait after applying a dataset reset, so that
+  /// every worker consumes exactly one `ResetDataset` message per epoch
+  /// (unlike `QuitWorker`, workers stay alive after handling it).
+  void rendezvous_on_reset() {
+    std::unique_lock<std::mutex> lock(reset_mutex_);
+    if (++workers_in_reset_ == options_.workers) {
+      workers_in_reset_ = 0;
+      ++reset_generation_;
+      reset_cv_.notify_all();
+    } else {
+      const size_t generation = reset_generation_;
+      reset_cv_.wait(lock, [&] { return reset_generation_ != generation; });
+    }
+  }
+
   /// The options the DataLoader was configured with.
   const FullDataLoaderOptions options_;
 
@@ -241,6 +356,12 @@ class DataLoaderBase {
 
   /// True if the DataLoader has joined its worker threads.
   bool joined_ = false;
+
+  /// State for the per-epoch dataset reset rendezvous of the workers.
+  std::mutex reset_mutex_;
+  std::condition_variable reset_cv_;
+  size_t workers_in_reset_ = 0;
+  size_t reset_generation_ = 0;
 };
 } // namespace data
 } // namespace torch
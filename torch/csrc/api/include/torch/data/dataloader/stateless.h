@@ -58,6 +58,10 @@ class StatelessDataLoader : public DataLoaderBase<
   /// Resets the internal state of the dataloader and the sampler.
   void reset() override {
     sampler_.reset();
+    // Each worker owns its own copy of the dataset; tell them a new epoch is
+    // starting so datasets with per-epoch state (file handles, memory maps)
+    // can refresh it while the worker threads stay alive.
+    this->reset_worker_datasets();
     // Call the base class method last because it calls `prefetch()`
     super::reset();
   }
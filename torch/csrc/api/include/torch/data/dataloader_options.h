@@ -3,6 +3,7 @@
 #include <torch/arg.h>
 #include <torch/types.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 
@@ -26,6 +27,14 @@ struct DataLoaderOptions {
   /// Defaults to two times the number of worker threads.
   TORCH_ARG(optional<size_t>, max_jobs);
 
+  /// The number of batches to schedule ahead of consumption (per epoch at
+  /// reset, and topped up by one per consumed batch). Defaults to `max_jobs`,
+  /// which preserves the behavior of keeping the job queue full. Set a
+  /// smaller value to bound the memory held by prefetched batches without
+  /// shrinking the job queue itself. Values are clamped to `[1, max_jobs]`
+  /// (or 0 when `max_jobs` is 0, i.e. data is loaded on the main thread).
+  TORCH_ARG(optional<size_t>, prefetch_count);
+
   /// An optional limit on the time to wait for the next batch.
   TORCH_ARG(optional<std::chrono::milliseconds>, timeout);
 
@@ -37,6 +46,13 @@ struct DataLoaderOptions {
   /// Whether to omit the last batch if it contains less than `batch_size`
   /// examples.
   TORCH_ARG(bool, drop_last) = false;
+
+  /// Whether worker threads should copy fetched batches into page-locked
+  /// (pinned) host memory before handing them to the consumer. Pinned
+  /// batches can be moved to the GPU with
+  /// `tensor.to(device, /*non_blocking=*/true)` so that input transfer
+  /// overlaps with compute. Requires a CUDA-enabled build.
+  TORCH_ARG(bool, pin_memory) = false;
 };
 
 /// Like `DataLoaderOptions`, but without any unconfigured state.
@@ -50,16 +66,26 @@ struct FullDataLoaderOptions {
       : batch_size(options.batch_size()),
         workers(options.workers()),
         max_jobs(options.max_jobs().value_or(2 * workers)),
+        prefetch_count(
+            max_jobs == 0
+                ? 0
+                : std::min(
+                      std::max<size_t>(
+                          options.prefetch_count().value_or(max_jobs), 1),
+                      max_jobs)),
         timeout(options.timeout()),
         enforce_ordering(options.enforce_ordering()),
-        drop_last(options.drop_last()) {}
+        drop_last(options.drop_last()),
+        pin_memory(options.pin_memory()) {}
 
   size_t batch_size;
   size_t workers;
   size_t max_jobs;
+  size_t prefetch_count;
   optional<std::chrono::milliseconds> timeout;
   bool enforce_ordering;
   bool drop_last;
+  bool pin_memory;
 };
 } // namespace data
 } // namespace torch
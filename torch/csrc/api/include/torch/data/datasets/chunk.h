@@ -1,9 +1,13 @@
 #pragma once
 
+#include <c10/util/C++17.h>
 #include <torch/arg.h>
 #include <torch/csrc/utils/memory.h>
 #include <torch/data/datasets/stateful.h>
 #include <torch/data/samplers.h>
+#include <deque>
+#include <functional>
+#include <future>
 #include <queue>
 #include <thread>
 
@@ -37,7 +41,45 @@ class ChunkDataReader {
   virtual void reset() = 0;
 };
 
+/// Interface for chunk readers that split chunk loading into a raw storage
+/// read and a decode step.
+///
+/// With a plain `ChunkDataReader`, `read_chunk` blocks a preloader thread for
+/// the full storage read plus decode. Readers deriving from this class let
+/// `ChunkDataset` issue several raw reads concurrently (see
+/// `ChunkDatasetOptions::io_depth`) while decoding stays on the preloader
+/// thread, so decode overlaps storage latency instead of stalling behind it.
+/// `read_chunk_raw` may be called from multiple threads at the same time and
+/// should not hold state across calls.
+template <
+    typename ExampleType_,
+    typename ChunkType_ = std::vector<ExampleType_>,
+    typename RawChunkType_ = std::vector<char>>
+class AsyncChunkDataReader : public ChunkDataReader<ExampleType_, ChunkType_> {
+ public:
+  using RawChunkType = RawChunkType_;
+
+  /// Read the raw bytes of an entire chunk from storage.
+  virtual RawChunkType read_chunk_raw(size_t chunk_index) = 0;
+
+  /// Decode a raw chunk into examples.
+  virtual ChunkType_ decode_chunk(RawChunkType raw_data, size_t chunk_index) = 0;
+
+  ChunkType_ read_chunk(size_t chunk_index) override {
+    return decode_chunk(read_chunk_raw(chunk_index), chunk_index);
+  }
+};
+
 namespace detail {
+
+/// Detects whether a chunk reader supports the raw-read/decode split of
+/// `AsyncChunkDataReader` (identified by its `RawChunkType` typedef).
+template <typename T, typename = void>
+struct is_async_chunk_reader : std::false_type {};
+
+template <typename T>
+struct is_async_chunk_reader<T, c10::guts::void_t<typename T::RawChunkType>>
+    : std::true_type {};
 /// BatchDataBuffer manages a queue of UnwrappedBatchData. After a new chunk is
 /// loaded, BatchDataBuffer splits it into small batches and push them into the
 /// queue. When get_batch is called from data loader, it pops cached batches and
@@ -250,11 +292,13 @@ struct ChunkDatasetOptions {
       size_t preloader_count,
       size_t batch_size,
       size_t cache_size = 2048,
-      size_t cross_chunk_shuffle_count = 1)
+      size_t cross_chunk_shuffle_count = 1,
+      size_t io_depth = 1)
       : preloader_count_(preloader_count),
         batch_size_(batch_size),
         cache_size_(cache_size),
-        cross_chunk_shuffle_count_(cross_chunk_shuffle_count) {
+        cross_chunk_shuffle_count_(cross_chunk_shuffle_count),
+        io_depth_(io_depth) {
     TORCH_CHECK(
         preloader_count_ > 0,
         "Preloader count is 0. At least one preloader needs to be specified.");
@@ -271,6 +315,9 @@ struct ChunkDatasetOptions {
     TORCH_CHECK(
         cross_chunk_shuffle_count_ > 0,
         "cross_chunk_shuffle_count needs to be greater than 0.");
+    TORCH_CHECK(
+        io_depth_ > 0,
+        "io_depth needs to be greater than 0.");
   }
 
   /// The number of worker thread to preload chunk data.
@@ -292,6 +339,16 @@ struct ChunkDatasetOptions {
   // penalty when this value is greater than 1, as we need to do extra merge
   // between multiple chunks before performing example sampling.
   TORCH_ARG(size_t, cross_chunk_shuffle_count) = 1;
+
+  // The number of outstanding chunk reads each preloader keeps in flight.
+  // Default to 1 meaning chunks are read synchronously on the preloader
+  // thread, as before. When it is equal to n (n > 1), each preloader issues
+  // up to n storage reads on background threads and assembles batches as the
+  // reads complete, which hides storage latency on high-latency devices
+  // (e.g. NVMe or network storage). This pays off most with chunk readers
+  // deriving from AsyncChunkDataReader, where only the raw read runs in the
+  // background and decoding stays on the preloader thread.
+  TORCH_ARG(size_t, io_depth) = 1;
 };
 
 /// A stateful dataset that support hierarchical sampling and prefetching of
@@ -422,22 +479,87 @@ class ChunkDataset final
   }
 
  private:
+  /// A started chunk read. Invoking the completion retrieves the decoded
+  /// chunk, blocking until the background read has finished.
+  using ChunkReadCompletion = std::function<UnwrappedBatchType()>;
+
+  /// Starts reading one chunk. For readers deriving from
+  /// AsyncChunkDataReader only the raw storage read runs on the background
+  /// thread; the completion decodes on the calling (preloader) thread so that
+  /// io_depth controls outstanding I/O without multiplying decode
+  /// concurrency.
+  template <typename R = ChunkReader>
+  typename std::enable_if<
+      detail::is_async_chunk_reader<R>::value,
+      ChunkReadCompletion>::type
+  start_chunk_read(size_t chunk_index) {
+    auto raw = std::make_shared<std::future<typename R::RawChunkType>>(
+        std::async(std::launch::async, [this, chunk_index] {
+          return chunk_reader_.read_chunk_raw(chunk_index);
+        }));
+    return [this, raw, chunk_index] {
+      return chunk_reader_.decode_chunk(raw->get(), chunk_index);
+    };
+  }
+
+  /// Plain readers do not expose a raw-read/decode split, so the full
+  /// read_chunk call runs on the background thread. With io_depth 1 the read
+  /// is simply deferred to the completion, preserving the fully synchronous
+  /// behavior.
+  template <typename R = ChunkReader>
+  typename std::enable_if<
+      !detail::is_async_chunk_reader<R>::value,
+      ChunkReadCompletion>::type
+  start_chunk_read(size_t chunk_index) {
+    if (options_.io_depth() == 1) {
+      return [this, chunk_index] {
+        return chunk_reader_.read_chunk(chunk_index);
+      };
+    }
+    auto result = std::make_shared<std::future<UnwrappedBatchType>>(
+        std::async(std::launch::async, [this, chunk_index] {
+          return chunk_reader_.read_chunk(chunk_index);
+        }));
+    return [result] { return result->get(); };
+  }
+
   /// running on worker thread to preload chunk data.
   void preloader(size_t id) {
+    // Chunk groups whose reads have been issued but whose batches have not
+    // been assembled yet, in request order.
+    std::deque<std::vector<ChunkReadCompletion>> in_flight;
+    bool exhausted = false;
     while (!quit_worker_.load()) {
       try {
-        std::vector<size_t> chunk_idx;
-        {
-          std::lock_guard<std::mutex> lock(chunk_index_guard_);
-          if (auto chunk_sampler_result = chunk_sampler_.next(this->options_.cross_chunk_shuffle_count())) {
-            chunk_idx = chunk_sampler_result.value();
-          } else {
-            break;
+        // Keep up to io_depth chunk groups in flight so the storage reads
+        // for upcoming chunks overlap with decode and batch assembly of the
+        // current one.
+        while (!exhausted && in_flight.size() < options_.io_depth()) {
+          std::vector<size_t> chunk_idx;
+          {
+            std::lock_guard<std::mutex> lock(chunk_index_guard_);
+            if (auto chunk_sampler_result = chunk_sampler_.next(this->options_.cross_chunk_shuffle_count())) {
+              chunk_idx = chunk_sampler_result.value();
+            } else {
+              exhausted = true;
+              break;
+            }
           }
+          std::vector<ChunkReadCompletion> reads;
+          reads.reserve(chunk_idx.size());
+          for (size_t index : chunk_idx) {
+            reads.push_back(start_chunk_read(index));
+          }
+          in_flight.push_back(std::move(reads));
+        }
+        if (in_flight.empty()) {
+          break;
         }
-        UnwrappedBatchType data = chunk_reader_.read_chunk(chunk_idx[0]);
-        for (size_t i = 1; i < chunk_idx.size(); ++i) {
-          auto chunk_data = chunk_reader_.read_chunk(chunk_idx[i]);
+        std::vector<ChunkReadCompletion> reads = std::move(in_flight.front());
+        in_flight.pop_front();
+        UnwrappedBatchType data = reads[0]();
+        for (size_t i = 1; i < reads.size(); ++i) {
+          auto chunk_data = reads[i]();
           std::move(
               chunk_data.begin(), chunk_data.end(), std::back_inserter(data));
         }
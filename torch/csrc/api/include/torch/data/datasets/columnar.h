@@ -0,0 +1,104 @@
+#pragma once
+
+#include <torch/arg.h>
+#include <torch/data/datasets/base.h>
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <c10/core/Allocator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+
+/// Options for the `Columnar` dataset.
+struct TORCH_API ColumnarOptions {
+  /// The field delimiter for `Columnar::Format::kCSV` files.
+  TORCH_ARG(char, delimiter) = ',';
+  /// Whether the first row of a CSV file is a header and should be skipped.
+  TORCH_ARG(bool, skip_header) = false;
+  /// Index of the column to split off as the target, or -1 for no target.
+  TORCH_ARG(int64_t, target_column) = -1;
+  /// Number of columns per row. Required for `Columnar::Format::kBinary`;
+  /// inferred from the first row for `Columnar::Format::kCSV`.
+  TORCH_ARG(int64_t, columns) = -1;
+};
+
+/// A dataset over a columnar file of numeric values.
+///
+/// The file is memory mapped once; `get_batch` parses the requested rows
+/// straight into a single pre-allocated `[batch_size, columns]` float tensor
+/// instead of producing per-example tensors that a collate step would copy
+/// again. Two formats are supported:
+///
+/// - `Format::kCSV`: delimiter-separated text with one sample per line. Rows
+///   are located with `memchr` over the mapping when the dataset is
+///   constructed, so `get_batch` is random access.
+/// - `Format::kBinary`: a fixed schema of `columns` float32 values per row in
+///   native byte order, with no header; rows are copied with `memcpy`.
+///
+/// The batch type is `Example<>`, so the dataset plugs into a `DataLoader`
+/// directly, with no `Stack` transform:
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   auto dataset = torch::data::datasets::Columnar(
+///       "train.csv",
+///       torch::data::datasets::Columnar::Format::kCSV,
+///       torch::data::datasets::ColumnarOptions().target_column(0));
+///   auto loader = torch::data::make_data_loader(std::move(dataset));
+/// \endrst
+class TORCH_API Columnar : public BatchDataset<Columnar, Example<>> {
+ public:
+  /// The on-disk layout of the file.
+  enum class Format { kCSV, kBinary };
+
+  /// Maps the file at `path` and, for CSV files, indexes its rows.
+  explicit Columnar(
+      std::string path,
+      Format format,
+      ColumnarOptions options = {});
+
+  /// Parses the rows at `indices` into one data (and optionally one target)
+  /// tensor.
+  Example<> get_batch(ArrayRef<size_t> indices) override;
+
+  /// Returns the number of rows in the file.
+  optional<size_t> size() const override;
+
+  /// Returns the number of feature columns (excluding the target column).
+  int64_t feature_columns() const noexcept;
+
+ private:
+  void index_csv_rows();
+  void parse_csv_row(size_t row, float* out, float* target) const;
+
+  std::string path_;
+  Format format_;
+  ColumnarOptions options_;
+
+  /// Owns the file mapping. Shared so that the copy each `DataLoader` worker
+  /// receives maps the file only once.
+  std::shared_ptr<at::DataPtr> map_;
+  const char* data_ = nullptr;
+  size_t file_size_ = 0;
+
+  /// Byte offset of the start of each row, plus a sentinel entry for the end
+  /// of the last row (CSV only).
+  std::vector<size_t> row_offsets_;
+  int64_t rows_ = 0;
+  int64_t columns_ = 0;
+};
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
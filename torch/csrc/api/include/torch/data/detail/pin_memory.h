@@ -0,0 +1,71 @@
+#pragma once
+
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace detail {
+
+/// Recursively copies all tensors contained in a batch into page-locked
+/// (pinned) host memory. Pinned staging buffers are recycled by the CUDA
+/// caching host allocator, so after warm-up every worker draws from a pool
+/// of existing pinned buffers instead of registering fresh pages. Batches
+/// staged this way can be moved to the GPU with
+/// `tensor.to(device, /*non_blocking=*/true)`, which lets the host-to-device
+/// transfer overlap with compute. Used by the `DataLoader` when the
+/// `pin_memory` option is set; see `DataLoaderOptions::pin_memory`.
+
+/// Forward declarations so that each overload below can recurse into any of
+/// the others regardless of ordering (e.g. a vector of examples of vectors).
+template <typename Batch>
+Batch pin_batch_memory(Batch batch);
+template <typename Data, typename Target>
+Example<Data, Target> pin_batch_memory(Example<Data, Target> example);
+template <typename Data>
+Example<Data, example::NoTarget> pin_batch_memory(
+    Example<Data, example::NoTarget> example);
+template <typename T>
+std::vector<T> pin_batch_memory(std::vector<T> batch);
+
+inline Tensor pin_batch_memory(Tensor tensor) {
+  if (tensor.defined() && !tensor.is_cuda() && !tensor.is_pinned()) {
+    return tensor.pin_memory();
+  }
+  return tensor;
+}
+
+/// Batch types that contain no tensors (e.g. plain index batches) pass
+/// through unchanged.
+template <typename Batch>
+Batch pin_batch_memory(Batch batch) {
+  return batch;
+}
+
+template <typename Data, typename Target>
+Example<Data, Target> pin_batch_memory(Example<Data, Target> example) {
+  return {
+      pin_batch_memory(std::move(example.data)),
+      pin_batch_memory(std::move(example.target))};
+}
+
+template <typename Data>
+Example<Data, example::NoTarget> pin_batch_memory(
+    Example<Data, example::NoTarget> example) {
+  return {pin_batch_memory(std::move(example.data))};
+}
+
+template <typename T>
+std::vector<T> pin_batch_memory(std::vector<T> batch) {
+  for (auto& item : batch) {
+    item = pin_batch_memory(std::move(item));
+  }
+  return batch;
+}
+
+} // namespace detail
+} // namespace data
+} // namespace torch
@@ -4,6 +4,7 @@
 #include <torch/data/samplers/base.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace torch {
@@ -96,6 +97,63 @@ class TORCH_API DistributedRandomSampler : public DistributedSampler<> {
   std::vector<size_t> all_indices_;
 };
 
+/// Selects samples pseudo-randomly like `DistributedRandomSampler`, but
+/// without materializing and shuffling an index vector: the k-th shuffled
+/// index is computed on demand in O(1) by a format-preserving cipher (a
+/// Feistel network over the index range, with cycle-walking to stay inside
+/// it). Every rank derives the same permutation from (seed, epoch), so
+/// epochs need no coordination and `reset()` costs O(1) regardless of
+/// dataset size.
+class TORCH_API DistributedStreamingRandomSampler
+    : public DistributedSampler<> {
+ public:
+  DistributedStreamingRandomSampler(
+      size_t size,
+      size_t num_replicas = 1,
+      size_t rank = 0,
+      bool allow_duplicates = true,
+      size_t seed = 0);
+
+  /// Re-derives the permutation from (seed, epoch). Call after
+  /// `set_epoch()` to get the next epoch's ordering, exactly like
+  /// `DistributedRandomSampler`.
+  void reset(optional<size_t> new_size = nullopt) override;
+
+  /// Returns the next batch of indices.
+  optional<std::vector<size_t>> next(size_t batch_size) override;
+
+  /// Serializes the `DistributedStreamingRandomSampler` to the `archive`.
+  void save(serialize::OutputArchive& archive) const override;
+
+  /// Deserializes the `DistributedStreamingRandomSampler` from the
+  /// `archive`.
+  void load(serialize::InputArchive& archive) override;
+
+  /// Returns the current index of the `DistributedStreamingRandomSampler`.
+  size_t index() const noexcept;
+
+ private:
+  /// The value at position `k` of this epoch's permutation of the (padded)
+  /// index range.
+  size_t index_at(size_t k) const;
+
+  /// One application of the Feistel network; a permutation of
+  /// [0, 2^(2 * half_bits_)).
+  uint64_t feistel(uint64_t value) const;
+
+  size_t seed_;
+  size_t begin_index_;
+  size_t end_index_;
+  size_t sample_index_;
+  // padded domain size: local_sample_count() * num_replicas_
+  size_t sample_count_;
+  // each Feistel half covers [0, 2^half_bits_)
+  uint64_t half_bits_;
+  uint64_t half_mask_;
+  // per-(seed, epoch) round keys, derived in reset()
+  uint64_t round_keys_[4];
+};
+
 /// Select samples sequentially.
 class TORCH_API DistributedSequentialSampler : public DistributedSampler<> {
  public:
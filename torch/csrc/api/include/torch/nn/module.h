@@ -566,8 +566,10 @@ class TORCH_API Module : public std::enable_shared_from_this<Module> {
   virtual void clone_(Module& other, const optional<Device>& device);
 
   /// The implementation of the various `to()` methods.
-  template <typename... Ts>
-  void to_impl(Ts&&... ts);
+  void to_impl(
+      const optional<Device>& device,
+      const optional<Dtype>& dtype,
+      bool non_blocking);
 
   /// Implements pretty printing the module hierarchy.
   void pretty_print_recursive(
@@ -671,21 +673,6 @@ std::shared_ptr<ModuleType> Module::replace_module(
   return replace_module(name, module_holder.ptr());
 }
 
-template <typename... Ts>
-void Module::to_impl(Ts&&... ts) {
-  // First call `to()` on every child module.
-  for (auto& child : children_) {
-    child.value()->to(ts...);
-  }
-  // Then move every parameter to the new dtype/device.
-  for (auto& parameter : named_parameters(/*recurse=*/false)) {
-    parameter->set_data(autograd::Variable(*parameter).to(ts...));
-  }
-  // Then move every buffer to the new dtype/device.
-  for (auto& buffer : named_buffers(/*recurse=*/false)) {
-    buffer->set_data(autograd::Variable(*buffer).to(ts...));
-  }
-}
 
 } // namespace nn
 } // namespace torch
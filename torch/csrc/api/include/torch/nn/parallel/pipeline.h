@@ -0,0 +1,197 @@
+#pragma once
+
+#include <torch/nn/modules/container/sequential.h>
+#include <torch/nn/pimpl.h>
+#include <torch/types.h>
+
+#include <ATen/Device.h>
+#include <c10/util/Exception.h>
+#include <c10/util/Optional.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace nn {
+namespace parallel {
+
+namespace detail {
+
+/// A minimal blocking FIFO used to hand micro-batches from one pipeline stage
+/// to the next. An empty `optional` acts as the end-of-stream marker.
+class MicroBatchQueue {
+ public:
+  void push(optional<Tensor> value) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(value));
+    }
+    cv_.notify_one();
+  }
+
+  optional<Tensor> pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !queue_.empty(); });
+    auto value = std::move(queue_.front());
+    queue_.pop_front();
+    return value;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<optional<Tensor>> queue_;
+};
+
+} // namespace detail
+
+/// Runs a `Sequential` as a GPipe-style pipeline across several devices.
+///
+/// The wrapped `Sequential` is partitioned into one contiguous stage per
+/// device, and each stage is moved to its device. `forward()` splits the input
+/// batch into micro-batches along dimension 0 and streams them through the
+/// stages: while stage `s` processes micro-batch `k`, stage `s + 1` is already
+/// processing micro-batch `k - 1`, so all devices are busy once the pipeline
+/// is full. Each stage runs on its own thread, and micro-batches are moved
+/// between devices with non-blocking copies so transfers overlap with compute.
+///
+/// Stages share parameters with the original `Sequential` (moving a stage to
+/// its device moves the original parameters as well), so an optimizer should
+/// be constructed over the original module's parameters as usual. Autograd
+/// records the device-to-device copies, so `backward()` on the returned tensor
+/// propagates gradients back through every stage.
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   torch::nn::Sequential model(
+///       torch::nn::Linear(320, 640),
+///       torch::nn::Linear(640, 640),
+///       torch::nn::Linear(640, 320),
+///       torch::nn::Linear(320, 10));
+///
+///   torch::nn::parallel::Pipeline pipeline(
+///       model,
+///       {torch::Device(torch::kCUDA, 0), torch::Device(torch::kCUDA, 1)},
+///       /*chunks=*/4);
+///
+///   auto output = pipeline.forward(input);
+///
+/// \endrst
+class Pipeline {
+ public:
+  /// Partitions `module` into `devices.size()` contiguous stages of
+  /// near-equal length and moves each stage to its device. `chunks` is the
+  /// number of micro-batches an input batch is split into; it defaults to the
+  /// number of devices.
+  Pipeline(Sequential module, std::vector<Device> devices, size_t chunks = 0)
+      : devices_(std::move(devices)),
+        chunks_(chunks == 0 ? devices_.size() : chunks) {
+    TORCH_CHECK(!devices_.empty(), "Pipeline requires at least one device");
+    TORCH_CHECK(
+        module->size() >= devices_.size(),
+        "Pipeline requires at least as many modules (",
+        module->size(),
+        ") as devices (",
+        devices_.size(),
+        ")");
+
+    const size_t num_modules = module->size();
+    const size_t num_stages = devices_.size();
+    stages_.reserve(num_stages);
+    auto iterator = module->begin();
+    size_t index = 0;
+    for (size_t stage = 0; stage < num_stages; ++stage) {
+      const size_t next = ((stage + 1) * num_modules) / num_stages;
+      Sequential stage_module;
+      for (; index < next; ++index, ++iterator) {
+        stage_module->push_back(*iterator);
+      }
+      stage_module->to(devices_[stage]);
+      stages_.push_back(std::move(stage_module));
+    }
+  }
+
+  /// Streams `input` through the pipeline in micro-batches and returns the
+  /// concatenated output, located on the last device.
+  ///
+  /// The first exception thrown by any stage is rethrown on the calling
+  /// thread after all stage threads have shut down.
+  Tensor forward(Tensor input) {
+    auto micro_batches = input.chunk(chunks_, /*dim=*/0);
+
+    // One queue in front of every stage, plus one collecting the outputs.
+    std::vector<detail::MicroBatchQueue> queues(stages_.size() + 1);
+    std::mutex mutex;
+    std::exception_ptr exception;
+
+    std::vector<std::thread> workers;
+    workers.reserve(stages_.size());
+    for (size_t stage = 0; stage < stages_.size(); ++stage) {
+      workers.emplace_back([this, stage, &queues, &mutex, &exception] {
+        while (auto micro_batch = queues[stage].pop()) {
+          try {
+            queues[stage + 1].push(stages_[stage]->forward(
+                micro_batch->to(devices_[stage], /*non_blocking=*/true)));
+          } catch (...) {
+            {
+              std::lock_guard<std::mutex> lock(mutex);
+              if (!exception) {
+                exception = std::current_exception();
+              }
+            }
+            break;
+          }
+        }
+        // Propagate the end-of-stream marker (or an early shutdown after an
+        // exception) to the next stage.
+        queues[stage + 1].push(nullopt);
+      });
+    }
+
+    for (auto& micro_batch : micro_batches) {
+      queues.front().push(std::move(micro_batch));
+    }
+    queues.front().push(nullopt);
+
+    std::vector<Tensor> outputs;
+    outputs.reserve(micro_batches.size());
+    while (auto output = queues.back().pop()) {
+      outputs.push_back(std::move(*output));
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+    return torch::cat(outputs, /*dim=*/0);
+  }
+
+  /// Returns the per-device stages the wrapped module was partitioned into.
+  const std::vector<Sequential>& stages() const noexcept {
+    return stages_;
+  }
+
+  /// Returns the devices the pipeline runs on.
+  const std::vector<Device>& devices() const noexcept {
+    return devices_;
+  }
+
+ private:
+  std::vector<Device> devices_;
+  size_t chunks_;
+  std::vector<Sequential> stages_;
+};
+
+} // namespace parallel
+} // namespace nn
+} // namespace torch
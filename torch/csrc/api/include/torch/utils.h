@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ATen/Parallel.h>
+#include <ATen/core/LegacyTypeDispatch.h>
 #include <torch/csrc/autograd/grad_mode.h>
 #include <cstdint>
 
@@ -8,6 +9,13 @@ namespace torch {
 
 using NoGradGuard = at::NoGradGuard;
 
+/// Like `NoGradGuard`, but additionally bypasses the autograd dispatch
+/// layer entirely, so ops inside the guard go straight to the backend
+/// kernel with no per-tensor autograd bookkeeping. Nothing is profiled or
+/// traced inside the guard, and in-place ops skip version-counter bumps;
+/// see `at::AutoInferenceMode` for details. Use for pure inference loops.
+using InferenceModeGuard = at::AutoInferenceMode;
+
 /// Sets the global random seed for all newly created CPU and CUDA tensors.
 using at::manual_seed;
 
@@ -0,0 +1,193 @@
+#include <torch/data/datasets/columnar.h>
+
+#include <torch/types.h>
+
+#include <c10/util/Exception.h>
+
+#include <TH/THAllocator.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+namespace {
+
+size_t file_size(const std::string& path) {
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  TORCH_CHECK(stream, "Error opening file at ", path);
+  return static_cast<size_t>(stream.tellg());
+}
+
+// Parses a single numeric field. Fields are short, so the bounded copy into a
+// stack buffer costs little and lets us use strtof on the unterminated
+// mapping.
+float parse_field(const char* begin, const char* end) {
+  char buffer[64];
+  const auto length =
+      std::min(static_cast<size_t>(end - begin), sizeof(buffer) - 1);
+  std::memcpy(buffer, begin, length);
+  buffer[length] = '\0';
+  return std::strtof(buffer, /*endptr=*/nullptr);
+}
+
+} // namespace
+
+Columnar::Columnar(std::string path, Format format, ColumnarOptions options)
+    : path_(std::move(path)), format_(format), options_(options) {
+  file_size_ = file_size(path_);
+  map_ = std::make_shared<at::DataPtr>(THMapAllocator::makeDataPtr(
+      path_.c_str(), /*flags=*/0, file_size_, /*actual_size_out=*/nullptr));
+  data_ = static_cast<const char*>(map_->get());
+  TORCH_CHECK(data_ != nullptr, "Error mapping file at ", path_);
+
+  if (format_ == Format::kCSV) {
+    index_csv_rows();
+  } else {
+    columns_ = options_.columns();
+    TORCH_CHECK(
+        columns_ > 0,
+        "ColumnarOptions::columns() must be set for Columnar::Format::kBinary");
+    const size_t row_bytes = columns_ * sizeof(float);
+    TORCH_CHECK(
+        file_size_ % row_bytes == 0,
+        "Size of ",
+        path_,
+        " (",
+        file_size_,
+        " bytes) is not a multiple of the row size (",
+        row_bytes,
+        " bytes)");
+    rows_ = static_cast<int64_t>(file_size_ / row_bytes);
+  }
+
+  if (options_.target_column() >= 0) {
+    TORCH_CHECK(
+        options_.target_column() < columns_,
+        "target_column (",
+        options_.target_column(),
+        ") is out of range for a file with ",
+        columns_,
+        " columns");
+  }
+}
+
+void Columnar::index_csv_rows() {
+  const char* position = data_;
+  const char* const end = data_ + file_size_;
+  if (options_.skip_header() && position != end) {
+    const char* newline = static_cast<const char*>(
+        std::memchr(position, '\n', end - position));
+    position = newline ? newline + 1 : end;
+  }
+  while (position != end) {
+    row_offsets_.push_back(position - data_);
+    const char* newline = static_cast<const char*>(
+        std::memchr(position, '\n', end - position));
+    position = newline ? newline + 1 : end;
+  }
+  row_offsets_.push_back(file_size_);
+  rows_ = static_cast<int64_t>(row_offsets_.size()) - 1;
+
+  // Infer the column count from the first data row.
+  if (rows_ > 0) {
+    const char* row = data_ + row_offsets_[0];
+    const char* const row_end = data_ + row_offsets_[1];
+    columns_ = 1;
+    while ((row = static_cast<const char*>(std::memchr(
+                row, options_.delimiter(), row_end - row))) != nullptr) {
+      ++columns_;
+      ++row;
+    }
+  }
+}
+
+void Columnar::parse_csv_row(size_t row, float* out, float* target) const {
+  const char* position = data_ + row_offsets_[row];
+  const char* const row_end = data_ + row_offsets_[row + 1];
+  for (int64_t column = 0; column < columns_; ++column) {
+    const char* field_end = static_cast<const char*>(std::memchr(
+        position, options_.delimiter(), row_end - position));
+    if (field_end == nullptr) {
+      field_end = row_end;
+    }
+    TORCH_CHECK(
+        field_end != row_end || column == columns_ - 1,
+        "Row ",
+        row,
+        " of ",
+        path_,
+        " has fewer than ",
+        columns_,
+        " fields");
+    const float value = parse_field(position, field_end);
+    if (column == options_.target_column()) {
+      *target = value;
+    } else {
+      *out++ = value;
+    }
+    position = (field_end == row_end) ? row_end : field_end + 1;
+  }
+}
+
+Example<> Columnar::get_batch(ArrayRef<size_t> indices) {
+  const bool has_target = options_.target_column() >= 0;
+  const int64_t features = feature_columns();
+  Tensor data = torch::empty(
+      {static_cast<int64_t>(indices.size()), features}, torch::kFloat32);
+  Tensor target;
+  float* target_data = nullptr;
+  if (has_target) {
+    target =
+        torch::empty({static_cast<int64_t>(indices.size())}, torch::kFloat32);
+    target_data = target.data_ptr<float>();
+  }
+  float* out = data.data_ptr<float>();
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const size_t row = indices[i];
+    TORCH_CHECK(
+        row < static_cast<size_t>(rows_),
+        "Row index ",
+        row,
+        " is out of range; the file has ",
+        rows_,
+        " rows");
+    if (format_ == Format::kCSV) {
+      parse_csv_row(row, out, has_target ? target_data + i : nullptr);
+    } else {
+      const float* row_data =
+          reinterpret_cast<const float*>(data_) + row * columns_;
+      if (has_target) {
+        const int64_t target_column = options_.target_column();
+        target_data[i] = row_data[target_column];
+        std::memcpy(out, row_data, target_column * sizeof(float));
+        std::memcpy(
+            out + target_column,
+            row_data + target_column + 1,
+            (columns_ - target_column - 1) * sizeof(float));
+      } else {
+        std::memcpy(out, row_data, columns_ * sizeof(float));
+      }
+    }
+    out += features;
+  }
+  return {std::move(data), std::move(target)};
+}
+
+optional<size_t> Columnar::size() const {
+  return static_cast<size_t>(rows_);
+}
+
+int64_t Columnar::feature_columns() const noexcept {
+  return options_.target_column() >= 0 ? columns_ - 1 : columns_;
+}
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
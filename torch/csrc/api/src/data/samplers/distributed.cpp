@@ -93,6 +93,139 @@ size_t DistributedRandomSampler::index() const noexcept {
   return sample_index_;
 }
 
+namespace {
+
+// splitmix64 finalizer; used both to derive round keys and as the Feistel
+// round function.
+inline uint64_t mix64(uint64_t z) {
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+} // namespace
+
+DistributedStreamingRandomSampler::DistributedStreamingRandomSampler(
+    size_t size,
+    size_t num_replicas,
+    size_t rank,
+    bool allow_duplicates,
+    size_t seed)
+    : DistributedSampler(size, num_replicas, rank, allow_duplicates),
+      seed_(seed),
+      begin_index_(0),
+      end_index_(0),
+      sample_index_(0),
+      sample_count_(0),
+      half_bits_(0),
+      half_mask_(0) {
+  reset(size_);
+}
+
+optional<std::vector<size_t>> DistributedStreamingRandomSampler::next(
+    size_t batch_size) {
+  if (sample_index_ == end_index_) {
+    return nullopt;
+  }
+
+  size_t end = sample_index_ + batch_size;
+  if (end > end_index_) {
+    end = end_index_;
+  }
+
+  std::vector<size_t> res;
+  res.reserve(end - sample_index_);
+  for (size_t k = sample_index_; k < end; ++k) {
+    res.push_back(index_at(k));
+  }
+  sample_index_ = end;
+  return res;
+}
+
+void DistributedStreamingRandomSampler::reset(optional<size_t> new_size) {
+  size_ = new_size.value_or(size_);
+  size_t num_local_samples = local_sample_count();
+  sample_count_ =
+      num_replicas_ == 1 ? size_ : num_local_samples * num_replicas_;
+
+  // The cipher permutes [0, 2^(2 * half_bits_)); pick the smallest domain
+  // covering the padded index range. Cycle-walking in index_at skips the
+  // at most 3x overshoot.
+  half_bits_ = 1;
+  while ((uint64_t(1) << (2 * half_bits_)) < sample_count_) {
+    ++half_bits_;
+  }
+  half_mask_ = (uint64_t(1) << half_bits_) - 1;
+
+  // Round keys depend only on (seed, epoch), so every rank computes the
+  // same permutation without coordination.
+  uint64_t state = mix64(static_cast<uint64_t>(seed_) ^
+      (static_cast<uint64_t>(epoch_) << 32 | epoch_));
+  for (auto& key : round_keys_) {
+    state = mix64(state);
+    key = state;
+  }
+
+  begin_index_ = rank_ * num_local_samples;
+  end_index_ = begin_index_ + num_local_samples;
+  sample_index_ = begin_index_;
+}
+
+size_t DistributedStreamingRandomSampler::index_at(size_t k) const {
+  uint64_t value = k;
+  // Walk the cipher's cycle until it lands back inside the index range;
+  // terminates because k itself is on the cycle.
+  do {
+    value = feistel(value);
+  } while (value >= sample_count_);
+  if (value >= size_) {
+    // duplicate sample added to give all replicas the same count,
+    // mirroring DistributedRandomSampler::populate_indices
+    value -= size_;
+  }
+  return static_cast<size_t>(value);
+}
+
+uint64_t DistributedStreamingRandomSampler::feistel(uint64_t value) const {
+  uint64_t left = value >> half_bits_;
+  uint64_t right = value & half_mask_;
+  for (const auto key : round_keys_) {
+    uint64_t new_right = left ^ (mix64(right ^ key) & half_mask_);
+    left = right;
+    right = new_right;
+  }
+  return (left << half_bits_) | right;
+}
+
+void DistributedStreamingRandomSampler::save(
+    serialize::OutputArchive& archive) const {
+  archive.write(
+      "sample_index_",
+      torch::tensor(static_cast<int64_t>(sample_index_)),
+      /*is_buffer=*/true);
+  archive.write(
+      "epoch_",
+      torch::tensor(static_cast<int64_t>(epoch_)),
+      /*is_buffer=*/true);
+}
+
+void DistributedStreamingRandomSampler::load(serialize::InputArchive& archive) {
+  auto tensor = torch::empty(1, torch::kInt64);
+  archive.read("epoch_", tensor, /*is_buffer=*/true);
+  epoch_ = tensor.item<int64_t>();
+  // call reset() after loading epoch_ to re-derive the permutation.
+  reset(size_);
+
+  tensor = torch::empty(1, torch::kInt64);
+  archive.read("sample_index_", tensor, /*is_buffer=*/true);
+  sample_index_ = tensor.item<int64_t>();
+}
+
+size_t DistributedStreamingRandomSampler::index() const noexcept {
+  return sample_index_;
+}
+
 DistributedSequentialSampler::DistributedSequentialSampler(
     size_t size,
     size_t num_replicas,
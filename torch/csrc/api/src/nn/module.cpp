@@ -3,6 +3,7 @@
 #include <torch/ordered_dict.h>
 
 #include <torch/csrc/autograd/generated/VariableType.h>
+#include <torch/csrc/utils/module_state_transfer.h>
 
 #include <c10/util/Exception.h>
 
@@ -239,11 +240,55 @@ void Module::to(torch::Device device, torch::Dtype dtype, bool non_blocking) {
 }
 
 void Module::to(torch::Dtype dtype, bool non_blocking) {
-  to_impl(dtype, non_blocking);
+  to_impl(/*device=*/c10::nullopt, dtype, non_blocking);
 }
 
 void Module::to(torch::Device device, bool non_blocking) {
-  to_impl(device, non_blocking);
+  to_impl(device, /*dtype=*/c10::nullopt, non_blocking);
+}
+
+void Module::to_impl(
+    const optional<Device>& device,
+    const optional<Dtype>& dtype,
+    bool non_blocking) {
+  // First call `to()` on every child module. This stays a virtual per-child
+  // call because subclasses (e.g. RNN) override `to()` to refresh derived
+  // state after the move.
+  for (auto& child : children_) {
+    if (device && dtype) {
+      child.value()->to(*device, *dtype, non_blocking);
+    } else if (device) {
+      child.value()->to(*device, non_blocking);
+    } else {
+      child.value()->to(*dtype, non_blocking);
+    }
+  }
+  // Then move this module's own parameters and buffers. Device moves batch
+  // small tensors through staging buffers and synchronize once (see
+  // torch/csrc/utils/module_state_transfer.h); everything else takes the
+  // per-tensor path below.
+  std::vector<Tensor> state;
+  for (const auto& parameter : named_parameters(/*recurse=*/false)) {
+    state.push_back(parameter.value());
+  }
+  for (const auto& buffer : named_buffers(/*recurse=*/false)) {
+    state.push_back(buffer.value());
+  }
+  if (torch::utils::parallel_module_state_to(
+          state, device, dtype, non_blocking, [&](size_t i, Tensor data) {
+            state[i].set_data(std::move(data));
+          })) {
+    return;
+  }
+  for (auto& tensor : state) {
+    if (device && dtype) {
+      tensor.set_data(autograd::Variable(tensor).to(*device, *dtype, non_blocking));
+    } else if (device) {
+      tensor.set_data(autograd::Variable(tensor).to(*device, non_blocking));
+    } else {
+      tensor.set_data(autograd::Variable(tensor).to(*dtype, non_blocking));
+    }
+  }
 }
 
 bool Module::is_training() const noexcept {
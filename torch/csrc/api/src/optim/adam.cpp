@@ -15,6 +15,29 @@ namespace optim {
 AdamOptions::AdamOptions(double learning_rate)
     : learning_rate_(learning_rate) {}
 
+namespace {
+// The fused CPU step walks the raw buffers in lockstep, so it requires
+// dense, contiguous float/double tensors of identical type and shape.
+bool can_use_fused_step(const Tensor& param, at::ArrayRef<Tensor> others) {
+  if (!param.device().is_cpu() || param.layout() != torch::kStrided ||
+      !param.is_contiguous()) {
+    return false;
+  }
+  if (param.scalar_type() != torch::kFloat &&
+      param.scalar_type() != torch::kDouble) {
+    return false;
+  }
+  for (const auto& t : others) {
+    if (t.layout() != torch::kStrided || !t.is_contiguous() ||
+        t.scalar_type() != param.scalar_type() ||
+        !t.sizes().equals(param.sizes())) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 void Adam::step() {
   for (size_t i = 0; i < parameters_.size(); ++i) {
     Tensor p = parameters_.at(i);
@@ -22,6 +45,32 @@ void Adam::step() {
       continue;
     }
 
+    if (!options.amsgrad() &&
+        can_use_fused_step(
+            p,
+            {p.grad(),
+             buffer_at(exp_average_buffers, i),
+             buffer_at(exp_average_sq_buffers, i)})) {
+      // Single read-modify-write pass over the parameter, gradient and both
+      // moment buffers (including weight decay and bias correction), instead
+      // of one dispatched kernel per elementwise op. Unlike the generic path
+      // below, the gradient itself is left untouched by weight decay.
+      buffer_at(step_buffers, i) += 1;
+      NoGradGuard guard;
+      at::_fused_adam_step_(
+          p,
+          p.grad(),
+          buffer_at(exp_average_buffers, i),
+          buffer_at(exp_average_sq_buffers, i),
+          buffer_at(step_buffers, i),
+          options.learning_rate(),
+          options.beta1(),
+          options.beta2(),
+          options.weight_decay(),
+          options.eps());
+      continue;
+    }
+
     if (options.weight_decay() > 0) {
       NoGradGuard guard;
       p.grad() = p.grad() + options.weight_decay() * p;
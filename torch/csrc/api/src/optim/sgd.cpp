@@ -44,6 +44,33 @@ bool operator==(const SGDParamState& lhs, const SGDParamState& rhs) {
   return torch::equal(lhs.momentum_buffer(), rhs.momentum_buffer());
 }
 
+namespace {
+// The fused CPU momentum step walks the raw buffers in lockstep, so it
+// requires dense, contiguous float/double tensors of identical type and
+// shape.
+bool can_use_fused_momentum_step(
+    const Tensor& param,
+    const Tensor& grad,
+    const Tensor& momentum_buffer) {
+  if (!param.device().is_cpu() || param.layout() != torch::kStrided ||
+      !param.is_contiguous()) {
+    return false;
+  }
+  if (param.scalar_type() != torch::kFloat &&
+      param.scalar_type() != torch::kDouble) {
+    return false;
+  }
+  for (const auto& t : {grad, momentum_buffer}) {
+    if (t.layout() != torch::kStrided || !t.is_contiguous() ||
+        t.scalar_type() != param.scalar_type() ||
+        !t.sizes().equals(param.sizes())) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 void SGDParamState::serialize(torch::serialize::OutputArchive& archive) const {
   _TORCH_OPTIM_SERIALIZE_TORCH_ARG(momentum_buffer);
 }
@@ -65,6 +92,28 @@ void SGD::step() {
         continue;
       }
       auto d_p = p.grad().data();
+      if (momentum != 0) {
+        auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
+        if (param_state != state_.end()) {
+          auto buf = static_cast<SGDParamState&>(*param_state->second).momentum_buffer();
+          if (can_use_fused_momentum_step(p.data(), d_p, buf)) {
+            // Single read-modify-write pass over the parameter, gradient and
+            // momentum buffer; weight decay and the (nesterov) update are
+            // applied in the same sweep.
+            auto p_data = p.data();
+            at::_fused_sgd_momentum_step_(
+                p_data,
+                d_p,
+                buf,
+                options.lr(),
+                momentum,
+                dampening,
+                weight_decay,
+                nesterov);
+            continue;
+          }
+        }
+      }
       if (weight_decay != 0) {
         d_p = d_p.add(p.data(), weight_decay);
       }
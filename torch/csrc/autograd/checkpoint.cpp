@@ -0,0 +1,245 @@
+#include <torch/csrc/autograd/checkpoint.h>
+
+#include <torch/csrc/autograd/autograd.h>
+#include <torch/csrc/autograd/custom_function.h>
+#include <torch/csrc/autograd/grad_mode.h>
+
+#include <ATen/detail/CUDAHooksInterface.h>
+#include <c10/core/StreamGuard.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
+
+#include <unordered_set>
+#include <utility>
+
+namespace torch { namespace autograd {
+
+namespace {
+
+// The most recently created checkpoint segment on this thread. Each new
+// segment keeps a weak reference to its predecessor, so that its backward
+// can prefetch the predecessor's replay - the next checkpoint node the
+// engine will reach.
+thread_local std::weak_ptr<CheckpointBackward> last_segment;
+
+// The device the segment's replay should be overlapped on, if any.
+c10::optional<c10::Device> segment_cuda_device(const variable_list& vars) {
+  for (const auto& var : vars) {
+    if (var.defined() && var.is_cuda()) {
+      return var.device();
+    }
+  }
+  return c10::nullopt;
+}
+
+} // namespace
+
+variable_list checkpoint(CheckpointedFunction function, variable_list inputs) {
+  TORCH_CHECK(function, "checkpoint() requires a segment function");
+  TORCH_CHECK(!inputs.empty(), "checkpoint() requires at least one input");
+
+  auto node = std::shared_ptr<CheckpointBackward>(
+      new CheckpointBackward(std::move(function)), deleteNode);
+  const bool is_executable =
+      GradMode::is_enabled() && any_variable_requires_grad(inputs);
+  node->set_next_edges(collect_next_edges(inputs));
+
+  // Run the segment without grad: no graph is built and no intermediate
+  // activations are kept alive. Backward replays it.
+  variable_list outputs;
+  {
+    AutoGradMode grad_mode(false);
+    outputs = node->function_(inputs);
+  }
+
+  if (is_executable) {
+    node->saved_inputs_.reserve(inputs.size());
+    for (const auto& var : inputs) {
+      node->saved_inputs_.emplace_back(var, /*is_output=*/false);
+    }
+    node->prev_segment_ = last_segment;
+    last_segment = node;
+  }
+
+  std::unordered_set<at::TensorImpl*> non_differentiable;
+  std::unordered_set<at::TensorImpl*> dirty_inputs;
+  auto wrapped_outputs = _wrap_outputs(
+      inputs,
+      non_differentiable,
+      dirty_inputs,
+      outputs,
+      is_executable ? node : nullptr);
+
+  if (is_executable) {
+    node->output_info_.reserve(wrapped_outputs.size());
+    for (const auto& output : wrapped_outputs) {
+      node->output_info_.emplace_back(output);
+    }
+  }
+  return wrapped_outputs;
+}
+
+void CheckpointBackward::recompute(bool allow_side_stream) {
+  if (recomputed_) {
+    return;
+  }
+  TORCH_CHECK(
+      function_,
+      "checkpoint segment was already freed; specify retain_graph=True to "
+      "backward through it a second time");
+
+  // Detached copies of the saved inputs become the leaves of the replayed
+  // subgraph, exactly like torch.utils.checkpoint does in Python.
+  variable_list detached;
+  detached.reserve(saved_inputs_.size());
+  for (const auto& saved : saved_inputs_) {
+    auto var = saved.unpack();
+    if (!var.defined()) {
+      detached.emplace_back();
+      continue;
+    }
+    auto leaf = var.detach();
+    leaf.set_requires_grad(var.requires_grad());
+    detached.push_back(std::move(leaf));
+  }
+
+  auto replay = [&]() {
+    AutoGradMode grad_mode(true);
+    recomputed_outputs_ = function_(detached);
+  };
+
+  auto device = segment_cuda_device(detached);
+  if (allow_side_stream && device) {
+    // Replay on a pool stream so the kernels overlap the consumer
+    // segment's backward instead of queueing behind it.
+    c10::impl::VirtualGuardImpl impl(device->type());
+    auto main_stream = impl.getStream(*device);
+    auto side_stream =
+        at::detail::getCUDAHooks().getStreamFromPool(device->index());
+
+    // The replay must not race with work still pending on the saved
+    // inputs, and its results must be visible to whoever consumes them:
+    // one event in each direction (the second is blocked on in apply()).
+    c10::Event inputs_ready(device->type());
+    inputs_ready.record(main_stream);
+    inputs_ready.block(side_stream);
+    {
+      c10::StreamGuard stream_guard(side_stream);
+      replay();
+    }
+    c10::Event ready(device->type());
+    ready.record(side_stream);
+    ready_event_ = std::move(ready);
+  } else {
+    replay();
+  }
+
+  recomputed_inputs_ = std::move(detached);
+  recomputed_ = true;
+}
+
+void CheckpointBackward::prefetch() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (saved_inputs_.empty()) {
+    return;
+  }
+  recompute(/*allow_side_stream=*/true);
+}
+
+variable_list CheckpointBackward::apply(variable_list&& grads) {
+  // The preceding segment is the next checkpoint node the engine reaches;
+  // start its replay now so it overlaps this segment's backward.
+  if (auto prev = prev_segment_.lock()) {
+    prev->prefetch();
+  }
+
+  variable_list inputs;
+  variable_list outputs;
+  c10::optional<c10::Event> ready;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    recompute(/*allow_side_stream=*/false);
+    inputs = std::move(recomputed_inputs_);
+    outputs = std::move(recomputed_outputs_);
+    ready = std::move(ready_event_);
+    recomputed_inputs_.clear();
+    recomputed_outputs_.clear();
+    ready_event_ = c10::nullopt;
+    // With retain_graph a second backward simply replays again.
+    recomputed_ = false;
+  }
+
+  if (ready) {
+    // Order the consuming stream after the side-stream replay.
+    auto device = segment_cuda_device(outputs);
+    if (device) {
+      c10::impl::VirtualGuardImpl impl(device->type());
+      ready->block(impl.getStream(*device));
+    }
+  }
+
+  TORCH_CHECK(
+      outputs.size() == grads.size(),
+      "checkpointed function returned ",
+      outputs.size(),
+      " outputs on replay, expected ",
+      grads.size());
+
+  at::OptionalDeviceGuard device_guard;
+  variable_list roots;
+  variable_list grad_outputs;
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (!outputs[i].defined() || !outputs[i].requires_grad()) {
+      continue;
+    }
+    roots.push_back(outputs[i]);
+    if (grads[i].defined()) {
+      grad_outputs.push_back(grads[i]);
+    } else {
+      grad_outputs.push_back(output_info_[i].zeros(device_guard));
+    }
+  }
+  TORCH_CHECK(
+      !roots.empty(),
+      "none of the recomputed outputs of the checkpointed function "
+      "requires grad");
+
+  variable_list diff_inputs;
+  for (const auto& input : inputs) {
+    if (input.defined() && input.requires_grad()) {
+      diff_inputs.push_back(input);
+    }
+  }
+
+  // Reentrant backward through the rematerialized subgraph only.
+  auto input_grads = grad(
+      roots,
+      diff_inputs,
+      grad_outputs,
+      /*retain_graph=*/false,
+      /*create_graph=*/false,
+      /*allow_unused=*/true);
+
+  variable_list results;
+  results.reserve(inputs.size());
+  size_t grad_index = 0;
+  for (const auto& input : inputs) {
+    if (input.defined() && input.requires_grad()) {
+      results.push_back(input_grads[grad_index++]);
+    } else {
+      results.emplace_back();
+    }
+  }
+  return results;
+}
+
+void CheckpointBackward::release_variables() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  function_ = nullptr;
+  saved_inputs_.clear();
+  recomputed_inputs_.clear();
+  recomputed_outputs_.clear();
+  ready_event_ = c10::nullopt;
+  recomputed_ = false;
+}
+
+}} // namespace torch::autograd
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <torch/csrc/autograd/custom_function.h>
+#include <torch/csrc/autograd/function.h>
+#include <torch/csrc/autograd/saved_variable.h>
+#include <torch/csrc/autograd/variable.h>
+#include <c10/core/Event.h>
+#include <c10/util/Optional.h>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace torch { namespace autograd {
+
+using CheckpointedFunction = std::function<variable_list(const variable_list&)>;
+
+// Runs `function` on `inputs` under checkpointing (activation
+// rematerialization): the forward pass executes without grad so no
+// intermediate activations are kept alive, and only the segment inputs are
+// saved. During backward the segment is replayed with grad enabled and the
+// input gradients are computed from the rematerialized subgraph.
+//
+// Consecutive checkpointed segments on one thread are chained: when a
+// segment's backward starts, it kicks off the replay of the *preceding*
+// segment - the next node the engine will reach - on a side stream when the
+// inputs live on an accelerator, so the recomputation overlaps the current
+// segment's backward kernels instead of serializing with them.
+//
+// The segment function must be side-effect free and deterministic enough
+// that replaying it yields outputs with the same shapes; it is invoked once
+// during forward and once more per backward pass through the segment.
+TORCH_API variable_list checkpoint(
+    CheckpointedFunction function,
+    variable_list inputs);
+
+// The backward node for a checkpointed segment. Holds only the segment
+// inputs (as SavedVariables) and the segment function; the activations are
+// rematerialized in apply(), or earlier via prefetch() when a successor
+// segment's backward starts.
+struct TORCH_API CheckpointBackward : public Node {
+  explicit CheckpointBackward(CheckpointedFunction function)
+      : function_(std::move(function)) {}
+
+  variable_list apply(variable_list&& grads) override;
+  void release_variables() override;
+
+  // Rematerializes the segment ahead of its turn, replaying on a pool
+  // stream when the inputs are on an accelerator. Idempotent; safe to call
+  // from another segment's backward.
+  void prefetch();
+
+ private:
+  // Replays the segment if it has not been replayed yet. Must be called
+  // with mutex_ held.
+  void recompute(bool allow_side_stream);
+
+  CheckpointedFunction function_;
+  std::vector<SavedVariable> saved_inputs_;
+  std::vector<VariableInfo> output_info_;
+  // The checkpoint segment created right before this one on the forward
+  // thread; its replay is prefetched when this segment's backward runs.
+  std::weak_ptr<CheckpointBackward> prev_segment_;
+
+  // Guards the rematerialization state below, since prefetch() may race
+  // with apply() across engine threads.
+  std::mutex mutex_;
+  bool recomputed_ = false;
+  variable_list recomputed_inputs_;
+  variable_list recomputed_outputs_;
+  // Set when the replay ran on a side stream; consumers must block on it.
+  c10::optional<c10::Event> ready_event_;
+
+  friend TORCH_API variable_list checkpoint(
+      CheckpointedFunction function,
+      variable_list inputs);
+};
+
+}} // namespace torch::autograd
@@ -17,9 +17,11 @@
 #include <c10/util/Optional.h>
 #include <c10/core/StreamGuard.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -47,11 +49,13 @@ static thread_local int worker_device = NO_DEVICE;
 static thread_local bool checkpoint_valid = true;
 
 // XXX: Changes to the way multithreading works in execute should be done with
-// great care. Right now the implementation guarantees that a single function's
-// apply will never be entered concurrently (even if multiple graphs are
-// executed at the same time). Adding multiple threads per-device or removing
-// engine thread affinity to the device can break this invariant, and we depend
-// on it in a few places (e.g. AccumulateGrad function).
+// great care. The implementation guarantees that a single function's apply
+// will never be entered concurrently (even if multiple graphs are executed at
+// the same time), and we depend on this in a few places (e.g. AccumulateGrad
+// function). With a single worker per ready queue the affinity alone used to
+// provide this; now that the CPU queue may have several consumers (see
+// Note [CPU worker threads]) the guarantee is enforced by holding the node's
+// mutex() across the call in call_function.
 
 // Number of nested reentrant backwards calls currently on this thread
 static thread_local int current_depth = 0;
@@ -69,6 +73,11 @@ struct CompareNodeTaskTime {
     } else if (!t2.fn_) {
       return true;
     } else if (t1.getReentrantDepth() == t2.getReentrantDepth()) {
+      // Between graph tasks at the same reentrant depth, the one with the
+      // higher priority runs first; sequence_nr only breaks ties.
+      if (t1.getPriority() != t2.getPriority()) {
+        return t1.getPriority() < t2.getPriority();
+      }
       return t1.fn_->sequence_nr() < t2.fn_->sequence_nr();
     } else {
       return t1.getReentrantDepth() < t2.getReentrantDepth();
@@ -76,12 +85,51 @@ struct CompareNodeTaskTime {
   }
 };
 
+// Note [Sharded ready queue]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Graphs with many tiny ops make every worker thread hammer a single
+// mutex-protected priority queue, and the queue lock dominates backward
+// time past a handful of threads. The queue is therefore split into
+// several independently locked shards for ordinary (non-reentrant) tasks,
+// plus one high-priority lane. Pushes distribute round-robin across
+// shards; pops scan shards starting from a per-thread offset, so disjoint
+// threads usually touch disjoint locks.
+//
+// Priority semantics are preserved where they matter:
+//  - shutdown tasks, error tasks (expired GraphTask), tasks belonging
+//    to reentrant backward calls, tasks from graph tasks with a
+//    positive priority and eager-dispatch nodes always go to the
+//    high-priority lane, which every pop checks first. Reentrant tasks
+//    therefore still run before outer-graph work, bounding reentrant
+//    nesting as before, a prioritized backward overtakes concurrently
+//    running default ones, and nodes that hand work to another executor
+//    (such as RecvRpcBackward firing a remote backward RPC) fire before
+//    the remaining local compute.
+//  - within each shard, tasks are still ordered by CompareNodeTaskTime.
+//    The global sequence_nr ordering across shards is relaxed; it is a
+//    locality heuristic, not a correctness requirement, since a task is
+//    only ever pushed once all its inputs are ready.
 struct ReadyQueue {
-  std::priority_queue<NodeTask, std::vector<NodeTask>, CompareNodeTaskTime> heap_;
-  // To notify threads waiting on the ReadyQueue of available tasks on the heap_
+  static constexpr size_t kNumShards = 8;
+
+  struct Shard {
+    // To protect read and writes to heap_
+    mutable std::mutex mutex_;
+    std::priority_queue<NodeTask, std::vector<NodeTask>, CompareNodeTaskTime> heap_;
+  };
+
+  // shards for non-reentrant tasks
+  std::array<Shard, kNumShards> shards_;
+  // shutdown, error and reentrant tasks; checked first by every pop
+  Shard high_priority_;
+  // total number of queued tasks across all shards
+  std::atomic<size_t> total_size_{0};
+  // round-robin cursor for pushes
+  std::atomic<size_t> next_shard_{0};
+  // threads block here only when the whole queue is empty
+  std::mutex sleep_mutex_;
   std::condition_variable not_empty_;
-  // To protect read and writes to heap_
-  mutable std::mutex mutex_;
+  std::atomic<size_t> sleepers_{0};
 
   // incrementOutstandingTasks indicates whether or not we should increment
   // 'outstanding_tasks_' for the associated GraphTask. This should mostly
@@ -91,6 +139,10 @@ struct ReadyQueue {
   void pushShutdownTask();
   NodeTask pop();
   size_t size() const;
+
+ private:
+  void push_to(Shard& shard, NodeTask item);
+  bool try_pop_from(Shard& shard, NodeTask& task);
 };
 
 // Note [Reentrant backwards]
@@ -164,46 +216,119 @@ int NodeTask::getReentrantDepth() const {
   }
 }
 
+int NodeTask::getPriority() const {
+  std::shared_ptr<GraphTask> graph_task = base_.lock();
+  if (graph_task) {
+    return graph_task->priority_;
+  } else {
+    // Same rationale as getReentrantDepth: surface errors quickly.
+    return std::numeric_limits<int>::max();
+  }
+}
+
 bool graph_task_completed(const std::shared_ptr<GraphTask>& graph_task) {
   return graph_task->outstanding_tasks_.load() == 0 ||
       (graph_task->exit_on_error_ && graph_task->has_error_.load());
 }
 
 auto ReadyQueue::push(NodeTask item, bool incrementOutstandingTasks) -> void {
-  {
-    // Lock mutex for writing to heap_
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (incrementOutstandingTasks) {
-      std::shared_ptr<GraphTask> graph_task = item.base_.lock();
-      TORCH_INTERNAL_ASSERT(graph_task, "GraphTask is no longer valid!");
-      ++graph_task->outstanding_tasks_;
-    }
-    heap_.push(std::move(item));
+  int depth = 0;
+  int priority = 0;
+  if (incrementOutstandingTasks) {
+    std::shared_ptr<GraphTask> graph_task = item.base_.lock();
+    TORCH_INTERNAL_ASSERT(graph_task, "GraphTask is no longer valid!");
+    // 'outstanding_tasks_' is atomic and is incremented before the task is
+    // published by push_to, so no popper can observe the task without the
+    // increment.
+    ++graph_task->outstanding_tasks_;
+    depth = graph_task->reentrant_depth_;
+    priority = graph_task->priority_;
+  } else {
+    depth = item.getReentrantDepth();
+    priority = item.getPriority();
+  }
+  // Shutdown tasks, error tasks (expired GraphTask, depth == INT_MAX),
+  // reentrant tasks, tasks from prioritized graph tasks and eager-dispatch
+  // nodes (see Node::is_eager_dispatch) bypass the shards so every worker
+  // sees them first.
+  if (item.isShutdownTask_ || !item.fn_ || depth != 0 || priority > 0 ||
+      item.fn_->is_eager_dispatch()) {
+    push_to(high_priority_, std::move(item));
+  } else {
+    auto idx = next_shard_.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+    push_to(shards_[idx], std::move(item));
   }
-  not_empty_.notify_one();
 }
 
 auto ReadyQueue::pushShutdownTask() -> void {
+  push_to(high_priority_, NodeTask({}, nullptr, InputBuffer(0), true));
+}
+
+void ReadyQueue::push_to(Shard& shard, NodeTask item) {
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    heap_.push(NodeTask({}, nullptr, InputBuffer(0), true));
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    shard.heap_.push(std::move(item));
+  }
+  // The size increment and the sleepers_ load must be seq_cst, matching the
+  // seq_cst ++sleepers_ and predicate load in pop(): with weaker orderings
+  // this pair is a store-buffering pattern where the pusher may read
+  // sleepers_ == 0 while the sleeper reads total_size_ == 0, losing the
+  // wakeup and hanging a worker with a task queued. seq_cst is free for the
+  // RMW on x86 and cheap everywhere else.
+  total_size_.fetch_add(1);
+  // Only take the sleep lock when someone might actually be waiting; in the
+  // steady state (all workers busy) this is a single uncontended load.
+  if (sleepers_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    not_empty_.notify_one();
   }
-  not_empty_.notify_one();
+}
+
+bool ReadyQueue::try_pop_from(Shard& shard, NodeTask& task) {
+  std::lock_guard<std::mutex> lock(shard.mutex_);
+  if (shard.heap_.empty()) {
+    return false;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  task = std::move(const_cast<NodeTask&>(shard.heap_.top()));
+  shard.heap_.pop();
+  total_size_.fetch_sub(1);
+  return true;
 }
 
 size_t ReadyQueue::size() const {
-  // Lock mutex for accesses to heap_
-  std::unique_lock<std::mutex> lock(mutex_);
-  return heap_.size();
+  return total_size_.load(std::memory_order_acquire);
 }
 
 auto ReadyQueue::pop() -> NodeTask {
-  // Lock mutex for accesses to heap_
-  std::unique_lock<std::mutex> lock(mutex_);
-  not_empty_.wait(lock, [this]{ return !heap_.empty(); });
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  auto task = std::move(const_cast<NodeTask&>(heap_.top())); heap_.pop();
-  return task;
+  // Start scanning at a per-thread offset so concurrent poppers tend to hit
+  // different shards first.
+  const size_t start =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) % kNumShards;
+  NodeTask task({}, nullptr, InputBuffer(0));
+  while (true) {
+    if (try_pop_from(high_priority_, task)) {
+      return task;
+    }
+    for (size_t i = 0; i < kNumShards; i++) {
+      if (try_pop_from(shards_[(start + i) % kNumShards], task)) {
+        return task;
+      }
+    }
+    // Nothing found; sleep until a push raises total_size_. A push that
+    // lands between the scan above and the wait below is not lost: the
+    // size increment in push_to, the ++sleepers_ here, and the two loads
+    // are all seq_cst, so in the single total order either the pusher sees
+    // us as a sleeper and notifies under sleep_mutex_, or the predicate
+    // below observes the non-zero size. This argument needs seq_cst; with
+    // acquire/release both sides may read the old values.
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    ++sleepers_;
+    not_empty_.wait(lock, [this] {
+      return total_size_.load() > 0;
+    });
+    --sleepers_;
+  }
 }
 
 // This limit is based on the default python recursion limit which is 1000
@@ -215,17 +340,25 @@ Engine::Engine() : max_recursion_depth_(100) {}
 Engine::~Engine() {
   bool noBackward = true;
   for (auto& queue: ready_queues_) {
-    std::lock_guard<std::mutex> lock(queue->mutex_);
-    noBackward =  noBackward && queue->heap_.empty();
+    noBackward = noBackward && queue->size() == 0;
   }
   if (noBackward) {
     for (auto& queue : ready_queues_) {
      queue->pushShutdownTask();
     }
+    // The CPU queue may have more than one consumer; each needs its own
+    // shutdown task (see Note [CPU worker threads]).
+    for (size_t i = 1; i < cpu_workers_started_; ++i) {
+      ready_queues_[0]->pushShutdownTask();
+    }
   }
   // Othewise threads are leaked
 }
 
+void Engine::set_cpu_worker_count(size_t count) {
+  cpu_worker_count_.store(count);
+}
+
 void Engine::set_device(int device) {
   // NB: We MUST NOT construct the guard for device -1,
   // as in some settings we compile with cuda, but
@@ -487,6 +620,9 @@ static variable_list call_function(
   checkpoint_valid =
       graph_task->can_checkpoint() && prev_checkpoint_valid_state;
   auto& fn = *func;
+  // Several CPU workers may pull tasks referencing the same node (shared
+  // AccumulateGrad across concurrent graph tasks); serialize calls into it.
+  std::lock_guard<std::recursive_mutex> fn_lock(fn.mutex());
   auto inputs =
       call_pre_hooks(fn, InputBuffer::variables(std::move(inputBuffer)));
 
@@ -682,6 +818,86 @@ auto Engine::compute_dependencies(Node* root, GraphTask& task) -> void {
   }
 }
 
+// Note [Autograd dependency cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// compute_dependencies walks the whole graph on every backward. When the same
+// retained graph is executed repeatedly (e.g. several backward calls per
+// step, or a step that reuses its graph), that walk recomputes exactly the
+// same counts each time, which is several milliseconds for large graphs.
+//
+// When the cache is enabled (it is opt-in; see
+// set_dependency_cache_enabled), execute() remembers the dependency counts of
+// the last run together with the roots it started from and, for every
+// reachable node, a weak reference and the node's structure version. A later
+// run with equal roots revalidates by walking that flat list: if every node
+// is still alive and none had its edges mutated (Node::structure_version),
+// the saved counts are copied into the new GraphTask instead of re-walking
+// the graph edge by edge. Any mismatch drops the cache and falls back to
+// compute_dependencies. Freshly built graphs never match the cached roots,
+// so they take the normal path and simply refresh the cache.
+bool Engine::try_reuse_cached_dependencies(
+    const edge_list& roots,
+    GraphTask& task) {
+  std::lock_guard<std::mutex> lock(dependency_cache_mutex_);
+  if (dependency_cache_.nodes.empty() || dependency_cache_.roots != roots) {
+    return false;
+  }
+  for (const auto& entry : dependency_cache_.nodes) {
+    auto node = entry.first.lock();
+    if (!node || node->structure_version() != entry.second) {
+      // The graph changed shape (or died); this cache can never hit again.
+      dependency_cache_ = DependencyCache();
+      return false;
+    }
+  }
+  task.dependencies_ = dependency_cache_.dependencies;
+  return true;
+}
+
+void Engine::update_dependency_cache(
+    const edge_list& roots,
+    const GraphTask& task) {
+  DependencyCache cache;
+  cache.roots = roots;
+  cache.dependencies = task.dependencies_;
+  cache.nodes.reserve(task.dependencies_.size());
+
+  // Collect a weak reference and structure version for every reachable node,
+  // including those with no dependents (they only show up as edge targets).
+  std::unordered_set<Node*> seen;
+  std::vector<Node*> queue;
+  for (const auto& root : roots) {
+    if (root.function && seen.insert(root.function.get()).second) {
+      cache.nodes.emplace_back(root.function, root.function->structure_version());
+      queue.push_back(root.function.get());
+    }
+  }
+  while (!queue.empty()) {
+    auto fn = queue.back(); queue.pop_back();
+    for (const auto& edge : fn->next_edges()) {
+      if (edge.function && seen.insert(edge.function.get()).second) {
+        cache.nodes.emplace_back(edge.function, edge.function->structure_version());
+        queue.push_back(edge.function.get());
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(dependency_cache_mutex_);
+  dependency_cache_ = std::move(cache);
+}
+
+void Engine::set_dependency_cache_enabled(bool enabled) {
+  dependency_cache_enabled_ = enabled;
+  if (!enabled) {
+    std::lock_guard<std::mutex> lock(dependency_cache_mutex_);
+    dependency_cache_ = DependencyCache();
+  }
+}
+
+bool Engine::dependency_cache_enabled() const {
+  return dependency_cache_enabled_;
+}
+
 struct ClearCallbacks {
   ClearCallbacks(std::vector<std::function<void()>>& callbacks,
                  std::mutex &callbacks_lock)
@@ -702,7 +918,8 @@ auto Engine::execute(const edge_list& roots,
                      const variable_list& inputs,
                      bool keep_graph,
                      bool create_graph,
-                     const edge_list& outputs) -> variable_list {
+                     const edge_list& outputs,
+                     int priority) -> variable_list {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
   validate_outputs(roots, const_cast<variable_list&>(inputs), [](const std::string& msg) {
     return msg;
@@ -715,11 +932,19 @@ auto Engine::execute(const edge_list& roots,
   auto graph_task = std::make_shared<GraphTask>(
       keep_graph,
       create_graph,
-      worker_device == NO_DEVICE ? 0 : total_depth + 1);
+      worker_device == NO_DEVICE ? 0 : total_depth + 1,
+      /* exit_on_error */ false,
+      priority);
 
   // Now compute the dependencies for all executable functions and queue the root
   auto graph_root = std::make_shared<GraphRoot>(roots, inputs);
-  compute_dependencies(graph_root.get(), *graph_task);
+  if (!dependency_cache_enabled_ ||
+      !try_reuse_cached_dependencies(roots, *graph_task)) {
+    compute_dependencies(graph_root.get(), *graph_task);
+    if (dependency_cache_enabled_) {
+      update_dependency_cache(roots, *graph_task);
+    }
+  }
 
   if (!outputs.empty()) {
     graph_task->init_to_execute(*graph_root, outputs);
@@ -900,19 +1125,56 @@ auto Engine::start_threads() -> void {
     }
   }
 
-  // One for CPU, plus one for every GPU device (but colocate GPUs of different
-  // types)
-  int num_threads = num_devices + 1;
-  ready_queues_ = std::vector<std::shared_ptr<ReadyQueue>>(num_threads);
+  // One queue for CPU, plus one for every GPU device (but colocate GPUs of
+  // different types)
+  int num_queues = num_devices + 1;
+  ready_queues_ = std::vector<std::shared_ptr<ReadyQueue>>(num_queues);
   for (auto& queue : ready_queues_)
     queue.reset(new ReadyQueue());
 
   thread_pool_shared_ = std::make_shared<ThreadPoolShared>();
 
-  for (int i = 0; i < num_threads; ++i) {
+  // Note [CPU worker threads]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Device queues get one worker each: device kernels run asynchronously, so
+  // a single thread is enough to keep a device busy. CPU nodes execute
+  // synchronously on their worker, so graphs with many CPU-resident nodes
+  // (losses, data-dependent control flow) serialize on a single consumer.
+  // The CPU queue may therefore be served by several workers - the ReadyQueue
+  // supports multiple consumers - configured with set_cpu_worker_count() or
+  // the PYTORCH_AUTOGRAD_CPU_WORKERS environment variable before the first
+  // backward call. The count defaults to 1 (the historical behavior) and is
+  // capped so that cpu workers times the intra-op pool (at::get_num_threads)
+  // does not oversubscribe the machine's cores. Correctness with several
+  // consumers relies on the per-node lock in call_function; see the XXX near
+  // the top of this file.
+  size_t cpu_workers = cpu_worker_count_.load();
+  if (cpu_workers == 0) {
+    const char* env = std::getenv("PYTORCH_AUTOGRAD_CPU_WORKERS");
+    if (env) {
+      int parsed = std::atoi(env);
+      if (parsed > 0) {
+        cpu_workers = static_cast<size_t>(parsed);
+      }
+    }
+  }
+  if (cpu_workers == 0) {
+    cpu_workers = 1;
+  }
+  size_t num_cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  size_t max_workers =
+      std::max<size_t>(num_cores / std::max(at::get_num_threads(), 1), 1);
+  cpu_workers_started_ = std::min(cpu_workers, max_workers);
+
+  for (int i = 0; i < num_queues; ++i) {
     std::thread t(&Engine::thread_init, this, i - 1);
     t.detach();
   }
+  // additional consumers of the CPU queue, beyond the one started above
+  for (size_t i = 1; i < cpu_workers_started_; ++i) {
+    std::thread t(&Engine::thread_init, this, -1);
+    t.detach();
+  }
 }
 
 void Engine::add_thread_pool_task(const std::weak_ptr<GraphTask>& graph_task) {
@@ -11,6 +11,7 @@
 #include <torch/csrc/autograd/input_buffer.h>
 #include <torch/csrc/utils/future.h>
 
+#include <atomic>
 #include <deque>
 #include <exception>
 #include <functional>
@@ -102,6 +103,14 @@ struct GraphTask {
   // an exception as soon as the autograd engine receives an exception.
   bool exit_on_error_;
 
+  // Scheduling priority of this backward call. Tasks from graph tasks with a
+  // higher priority are picked up by the worker threads before tasks from
+  // concurrently running ones, so a latency-critical backward (e.g. the
+  // branch feeding an online update) can overtake a bulk backward that can
+  // lag. 0 is the default; negative values deprioritize.
+  // Safe to read without synchronization.
+  const int priority_;
+
   // Future representing the completion of the graph task. Notified when all
   // tasks are done.
   std::shared_ptr<FutureVariableList> future_result_;
@@ -110,7 +119,8 @@ struct GraphTask {
       bool keep_graph,
       bool grad_mode,
       int reentrant_depth,
-      bool exit_on_error = false)
+      bool exit_on_error = false,
+      int priority = 0)
       : has_error_(false),
         outstanding_tasks_(0),
         keep_graph_(keep_graph),
@@ -118,7 +128,9 @@ struct GraphTask {
         owner_(NO_DEVICE),
         reentrant_depth_(reentrant_depth),
         exit_on_error_(exit_on_error),
+        priority_(priority),
         future_result_(std::make_shared<FutureVariableList>()) {}
+
 };
 
 struct NodeTask {
@@ -134,6 +146,9 @@ struct NodeTask {
 
   int getReentrantDepth() const;
 
+  // Scheduling priority inherited from the owning GraphTask.
+  int getPriority() const;
+
   NodeTask(
       std::weak_ptr<GraphTask> base,
       std::shared_ptr<Node> fn,
@@ -158,13 +173,15 @@ struct TORCH_API Engine {
   using dependencies_type = std::unordered_map<Node*, int>;
 
   // Given a list of (Node, input number) pairs computes the value of the graph
-  // by following next_edge references.
+  // by following next_edge references. `priority` orders this backward call
+  // relative to concurrently running ones (see GraphTask::priority_).
   virtual variable_list execute(
       const edge_list& roots,
       const variable_list& inputs,
       bool keep_graph,
       bool create_graph,
-      const edge_list& outputs = {});
+      const edge_list& outputs = {},
+      int priority = 0);
 
   // Given a pre-populated GraphTask and GraphRoot, computes the backward pass
   // for the graph. This API should only be used by internal autograd specific
@@ -197,8 +214,19 @@ struct TORCH_API Engine {
 
   size_t ready_queue_size(at::Device device);
 
+  // Controls the dependency cache. See Note [Autograd dependency cache].
+  void set_dependency_cache_enabled(bool enabled);
+  bool dependency_cache_enabled() const;
+
+  // Number of worker threads consuming the CPU ready queue; only effective
+  // if called before the first backward pass starts the engine threads.
+  // See Note [CPU worker threads] in engine.cpp.
+  void set_cpu_worker_count(size_t count);
+
  protected:
   void compute_dependencies(Node* root, GraphTask& task);
+  bool try_reuse_cached_dependencies(const edge_list& roots, GraphTask& task);
+  void update_dependency_cache(const edge_list& roots, const GraphTask& task);
   void evaluate_function(
       std::shared_ptr<GraphTask>& graph_task,
       Node* func,
@@ -222,12 +250,32 @@ struct TORCH_API Engine {
   std::once_flag start_threads_flag_;
   // Safe to read ready_queues_ without synchronization after intialization
   std::vector<std::shared_ptr<ReadyQueue>> ready_queues_;
+  // requested CPU worker count (0 = unset, consult the environment); see
+  // Note [CPU worker threads]
+  std::atomic<size_t> cpu_worker_count_{0};
+  // number of CPU queue consumers actually started by start_threads
+  size_t cpu_workers_started_{1};
   std::vector<std::function<void()>> final_callbacks_;
   // To protect reads and writes to final_callbacks_
   std::mutex post_callbacks_lock_;
   // How many nested reentrant calls are allowed until a new thread is used
   int max_recursion_depth_;
 
+  // See Note [Autograd dependency cache]. Holds the dependency counts from
+  // the last execute() together with everything needed to validate that the
+  // graph reached from the same roots is structurally unchanged.
+  struct DependencyCache {
+    edge_list roots;
+    // Every node reachable from roots, with the structure version it had
+    // when the cache was populated.
+    std::vector<std::pair<std::weak_ptr<Node>, uint64_t>> nodes;
+    std::unordered_map<Node*, int> dependencies;
+  };
+  std::atomic<bool> dependency_cache_enabled_{false};
+  // Protects dependency_cache_.
+  std::mutex dependency_cache_mutex_;
+  DependencyCache dependency_cache_;
+
   struct ThreadPoolShared {
     // Data structures used by the threads for executing reentrant backwards
     // tasks. See Note [Reentrant backwards]
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -192,24 +193,37 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
 
   void set_next_edge(size_t index, Edge edge) {
     next_edges_[index] = std::move(edge);
+    ++structure_version_;
   }
 
   void add_next_edge(Edge edge) {
     next_edges_.push_back(std::move(edge));
+    ++structure_version_;
   }
 
   void set_next_edges(edge_list&& next_edges) {
     next_edges_ = std::move(next_edges);
+    ++structure_version_;
   }
 
   const edge_list& next_edges() const noexcept {
     return next_edges_;
   }
 
+  // NB: mutations made through this accessor are invisible to
+  // structure_version(); callers that rewire edges in place must use the
+  // setters above for the engine's dependency cache to stay sound.
   edge_list& next_edges() noexcept {
     return next_edges_;
   }
 
+  /// Counts mutations to this `Node`'s set of outgoing edges. Used by the
+  /// engine's dependency cache to cheaply detect whether a previously seen
+  /// graph still has the same topology.
+  uint64_t structure_version() const noexcept {
+    return structure_version_;
+  }
+
   uint32_t num_outputs() const noexcept {
     return next_edges_.size();
   }
@@ -222,6 +236,18 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
     return sequence_nr_;
   }
 
+  /// Serializes calls into this node. The engine may run the CPU ready queue
+  /// with several worker threads, and the same node (for example the
+  /// `AccumulateGrad` of a parameter shared by two concurrently executing
+  /// graph tasks) must never have `apply()` entered from two threads at once.
+  /// The mutex is recursive because re-entering a node on the same thread
+  /// (its `apply()` runs a reentrant backward that reaches the node again)
+  /// was possible with the historical single CPU worker and must keep
+  /// working.
+  std::recursive_mutex& mutex() {
+    return mutex_;
+  }
+
   /// Returns the name of the dynamic type of the function, for debugging.
   virtual std::string name() const;
 
@@ -332,6 +358,16 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
     return false;
   }
 
+  /// Scheduling hint: a `Node` that merely hands work off to another
+  /// executor (e.g. `RecvRpcBackward`, which fires the remote backward RPC
+  /// in distributed autograd) should run as soon as it becomes ready, so
+  /// the other executor can start while local compute continues. The engine
+  /// schedules such nodes on the high-priority lane of the ready queue
+  /// instead of behind already queued local work.
+  virtual bool is_eager_dispatch() const {
+    return false;
+  }
+
   static uint64_t peek_at_next_sequence_nr();
 
  protected:
@@ -347,6 +383,12 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
   // fields.
   const uint64_t sequence_nr_;
 
+  // Bumped whenever next_edges_ is mutated through the setters above.
+  uint64_t structure_version_ = 0;
+
+  // See mutex() above; held by the engine for the duration of a call.
+  std::recursive_mutex mutex_;
+
   edge_list next_edges_;
   PyObject* pyobj_ = nullptr; // weak reference
   std::unique_ptr<AnomalyMetadata> anomaly_metadata_ = nullptr;
@@ -1,9 +1,13 @@
 #include <torch/csrc/python_headers.h>
 
+#include <c10/core/MemoryTracer.h>
 #include <torch/csrc/Exceptions.h>
 #include <torch/csrc/utils/pybind.h>
 #include <torch/csrc/autograd/grad_mode.h>
+#include <torch/csrc/autograd/engine.h>
+#include <torch/csrc/autograd/op_latency_histogram.h>
 #include <torch/csrc/autograd/profiler.h>
+#include <torch/csrc/autograd/profiler_perf_events.h>
 #include <torch/csrc/autograd/python_function.h>
 #include <torch/csrc/autograd/function.h>
 
@@ -46,11 +50,90 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
       .def("cpu_elapsed_us", &Event::cpu_elapsed_us)
       .def("cuda_elapsed_us", &Event::cuda_elapsed_us)
       .def("has_cuda", &Event::has_cuda)
-      .def("shapes", &Event::shapes);
+      .def("shapes", &Event::shapes)
+      .def("counters", &Event::counters)
+      .def("counter_elapsed", &Event::counter_elapsed);
 
   m.def("_enable_profiler", enableProfiler);
   m.def("_disable_profiler", disableProfiler);
   m.def("_profiler_enabled", profilerEnabled);
+  m.def("_profiler_set_perf_counters", setPerfCounters);
+  m.def("_profiler_perf_counter_names", perfCounterNames);
+  m.def("_profiler_perf_counters_enabled", perfCountersEnabled);
+
+  py::class_<SampledEvent>(m, "_SampledEvent")
+      .def("kind", [](const SampledEvent& e) {
+        switch (e.kind) {
+          case EventKind::Mark: return "mark";
+          case EventKind::PushRange: return "push";
+          case EventKind::PopRange: return "pop";
+        }
+        throw std::runtime_error("unknown EventKind");
+      })
+      .def("name", [](const SampledEvent& e) { return e.name_str(); })
+      .def("thread_id", [](const SampledEvent& e) { return e.thread_id; })
+      .def("cpu_ns", [](const SampledEvent& e) { return e.cpu_ns; });
+
+  m.def("_enable_sampling_profiler", enableSamplingProfiler);
+  m.def("_disable_sampling_profiler", disableSamplingProfiler);
+  m.def("_sampling_profiler_enabled", samplingProfilerEnabled);
+  m.def("_drain_sampled_events", drainSampledEvents);
+
+  m.def("_enable_op_latency_histograms", enableOpLatencyHistograms);
+  m.def("_disable_op_latency_histograms", disableOpLatencyHistograms);
+  m.def("_op_latency_histograms_enabled", opLatencyHistogramsEnabled);
+  m.def("_reset_op_latency_histograms", resetOpLatencyHistograms);
+  m.def("_snapshot_op_latency_histograms", []() {
+    py::dict result;
+    for (const auto& entry : snapshotOpLatencyHistograms()) {
+      py::dict hist;
+      hist["count"] = entry.second.count;
+      hist["total_ns"] = entry.second.total_ns;
+      py::list buckets;
+      for (size_t i = 0; i < kOpLatencyNumBuckets; ++i) {
+        buckets.append(py::make_tuple(
+            opLatencyBucketLowerBound(i), entry.second.buckets[i]));
+      }
+      hist["buckets"] = buckets;
+      result[py::str(entry.first)] = hist;
+    }
+    return result;
+  });
+
+  m.def(
+      "_enable_memory_tracing",
+      [](int64_t stack_depth) { c10::memory_tracing::enable(stack_depth); },
+      py::arg("stack_depth") = 0);
+  m.def("_disable_memory_tracing", c10::memory_tracing::disable);
+  m.def("_memory_tracing_enabled", c10::memory_tracing::enabled);
+  m.def("_clear_memory_tracing", c10::memory_tracing::clear);
+  m.def("_snapshot_memory_tracing", []() {
+    py::dict result;
+    for (const auto& stats : c10::memory_tracing::opStats()) {
+      py::dict op;
+      op["live_bytes"] = stats.live_bytes;
+      op["peak_bytes"] = stats.peak_bytes;
+      op["total_allocated_bytes"] = stats.total_allocated_bytes;
+      op["allocation_count"] = stats.allocation_count;
+      result[py::str(stats.op_name)] = op;
+    }
+    return result;
+  });
+  m.def("_memory_tracing_live_allocations", []() {
+    py::list result;
+    for (const auto& alloc : c10::memory_tracing::liveAllocations()) {
+      py::dict entry;
+      entry["nbytes"] = alloc.nbytes;
+      entry["device"] = c10::DeviceTypeName(alloc.device, /*lower_case=*/true);
+      entry["op_name"] = alloc.op_name;
+      entry["stack_fingerprint"] = alloc.stack_fingerprint;
+      result.append(entry);
+    }
+    return result;
+  });
+  m.def(
+      "_memory_tracing_fingerprint_backtrace",
+      c10::memory_tracing::fingerprintBacktrace);
 
   m.def("_push_range", [](std::string name) { pushRange(std::move(name)); });
   m.def("_pop_range", []() { popRange(); });
@@ -84,6 +167,27 @@ static PyObject * is_grad_enabled(PyObject* _unused, PyObject *arg) {
   END_HANDLE_TH_ERRORS
 }
 
+static PyObject * set_dependency_cache_enabled(PyObject* _unused, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  if (!PyBool_Check(arg)) {
+    throw TypeError("enabled must be a bool (got %s)", Py_TYPE(arg)->tp_name);
+  }
+  torch::autograd::Engine::get_default_engine().set_dependency_cache_enabled(
+      arg == Py_True);
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject * is_dependency_cache_enabled(PyObject* _unused, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  if (torch::autograd::Engine::get_default_engine().dependency_cache_enabled()) {
+    Py_RETURN_TRUE;
+  } else {
+    Py_RETURN_FALSE;
+  }
+  END_HANDLE_TH_ERRORS
+}
+
 static PyObject * set_anomaly_mode_enabled(PyObject* _unused, PyObject *arg) {
   HANDLE_TH_ERRORS
   if (!PyBool_Check(arg)) {
@@ -109,6 +213,8 @@ static PyMethodDef methods[] = {
   {"set_grad_enabled", (PyCFunction)set_grad_enabled, METH_O, nullptr},
   {"is_grad_enabled", (PyCFunction)is_grad_enabled, METH_NOARGS, nullptr},
   {"set_anomaly_enabled", (PyCFunction)set_anomaly_mode_enabled, METH_O, nullptr},
+  {"_set_dependency_cache_enabled", (PyCFunction)set_dependency_cache_enabled, METH_O, nullptr},
+  {"_is_dependency_cache_enabled", (PyCFunction)is_dependency_cache_enabled, METH_NOARGS, nullptr},
   {"is_anomaly_enabled", (PyCFunction)is_anomaly_mode_enabled, METH_NOARGS, nullptr},
   {nullptr, nullptr, 0, nullptr}
 };
@@ -11,6 +11,17 @@
 
 namespace torch { namespace autograd {
 
+  // True if `v` is a plain dense tensor whose storage we are the only owner
+  // of, so accumulating into it cannot be observed by anyone else.
+  //
+  // use_count is a big hammer, but for anything lighter there's an
+  // adversarial example with unexpected inplace modification.
+  static bool can_accumulate_inplace(const Variable& v) {
+    return !v.is_sparse() && v.is_contiguous() &&
+        v.use_count() == 1 &&
+        v.has_storage() && v.storage().use_count() == 1;
+  }
+
   static void accumulate(std::vector<Variable>& buffer,
                          const size_t pos,
                          Variable&& var) {
@@ -19,15 +30,24 @@ namespace torch { namespace autograd {
     // ATen doesn't route sparse additions correctly...
     // do dense + sparse in-place if possible
     if (old_var.is_sparse()) {
-      //storage use_count is a big hammer, but for anything lighter there's an adversarial example with unexpected inplace modification
-      if (!var.is_sparse() && var.is_contiguous() && var.storage().use_count() == 1) {
+      if (can_accumulate_inplace(var)) {
           buffer[pos] = var.add_(old_var);
       } else {
           buffer[pos] = var + old_var;
       }
+    } else if (var.is_sparse()) {
+      if (can_accumulate_inplace(old_var)) {
+          buffer[pos] = old_var.add_(var);
+      } else {
+          buffer[pos] = old_var + var;
+      }
     } else {
-      if (var.is_sparse() && !old_var.is_sparse() && old_var.is_contiguous() && old_var.storage().use_count() == 1) {
+      // dense + dense: steal whichever gradient's storage we exclusively own
+      // instead of allocating a fresh result tensor at every fan-in node
+      if (can_accumulate_inplace(old_var)) {
           buffer[pos] = old_var.add_(var);
+      } else if (can_accumulate_inplace(var)) {
+          buffer[pos] = var.add_(old_var);
       } else {
           buffer[pos] = old_var + var;
       }
@@ -0,0 +1,171 @@
+#include <torch/csrc/autograd/op_latency_histogram.h>
+#include <torch/csrc/autograd/profiler.h>
+#include <torch/csrc/autograd/record_function.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace autograd {
+namespace profiler {
+
+namespace {
+
+inline size_t bucketIndex(uint64_t ns) {
+  if (ns <= 1) {
+    return 0;
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  size_t bucket = 63 - __builtin_clzll(ns);
+#else
+  size_t bucket = 0;
+  while (ns >>= 1) {
+    ++bucket;
+  }
+#endif
+  return std::min(bucket, kOpLatencyNumBuckets - 1);
+}
+
+// Per-thread collection state. Ops record into their own thread's histograms
+// without touching shared data; the mutex is only contended when a snapshot
+// or reset walks the registry.
+struct ThreadLatencyState {
+  std::mutex mutex;
+  std::unordered_map<std::string, OpLatencyHistogram> histograms;
+  // Start timestamps of the RecordFunctions currently on this thread's
+  // stack. RecordFunctions nest, so matching end callbacks pop from the
+  // back; an end arriving on a different thread (setThreadId) is skipped.
+  std::vector<std::pair<const RecordFunction*, int64_t>> start_times;
+};
+
+class LatencyStateRegistry {
+ public:
+  std::shared_ptr<ThreadLatencyState> registerThread() {
+    auto state = std::make_shared<ThreadLatencyState>();
+    std::lock_guard<std::mutex> guard(mutex_);
+    states_.push_back(state);
+    return state;
+  }
+
+  std::unordered_map<std::string, OpLatencyHistogram> snapshot() {
+    std::unordered_map<std::string, OpLatencyHistogram> merged;
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto& state : states_) {
+      std::lock_guard<std::mutex> state_guard(state->mutex);
+      for (const auto& entry : state->histograms) {
+        merged[entry.first].merge(entry.second);
+      }
+    }
+    return merged;
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto& state : states_) {
+      std::lock_guard<std::mutex> state_guard(state->mutex);
+      state->histograms.clear();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  // Keeps states of exited threads alive so their counts survive until the
+  // next reset; bounded by the number of threads ever used.
+  std::vector<std::shared_ptr<ThreadLatencyState>> states_;
+};
+
+LatencyStateRegistry& registry() {
+  static LatencyStateRegistry instance;
+  return instance;
+}
+
+ThreadLatencyState& threadState() {
+  static thread_local std::shared_ptr<ThreadLatencyState> state =
+      registry().registerThread();
+  return *state;
+}
+
+bool histograms_enabled = false;
+
+void onFunctionEnter(const RecordFunction& fn) {
+  auto& state = threadState();
+  std::lock_guard<std::mutex> guard(state.mutex);
+  state.start_times.emplace_back(&fn, getTime());
+}
+
+void onFunctionExit(const RecordFunction& fn) {
+  const int64_t end_ns = getTime();
+  auto& state = threadState();
+  std::lock_guard<std::mutex> guard(state.mutex);
+  if (state.start_times.empty() || state.start_times.back().first != &fn) {
+    // end() ran on a thread other than the one that saw the start callback;
+    // there is no matching timestamp here, so drop the sample.
+    return;
+  }
+  const int64_t start_ns = state.start_times.back().second;
+  state.start_times.pop_back();
+  if (fn.name().str() == nullptr) {
+    return;
+  }
+  state.histograms[fn.name().str()].record(
+      static_cast<uint64_t>(std::max<int64_t>(end_ns - start_ns, 0)));
+}
+
+} // namespace
+
+void OpLatencyHistogram::record(uint64_t ns) {
+  ++buckets[bucketIndex(ns)];
+  ++count;
+  total_ns += ns;
+}
+
+void OpLatencyHistogram::merge(const OpLatencyHistogram& other) {
+  for (size_t i = 0; i < kOpLatencyNumBuckets; ++i) {
+    buckets[i] += other.buckets[i];
+  }
+  count += other.count;
+  total_ns += other.total_ns;
+}
+
+uint64_t opLatencyBucketLowerBound(size_t bucket) {
+  TORCH_CHECK(
+      bucket < kOpLatencyNumBuckets, "bucket index out of range: ", bucket);
+  return bucket == 0 ? 0 : (uint64_t(1) << bucket);
+}
+
+void enableOpLatencyHistograms() {
+  TORCH_CHECK(
+      !histograms_enabled, "op latency histograms are already enabled");
+  histograms_enabled = true;
+  pushCallback(
+      onFunctionEnter,
+      onFunctionExit,
+      /* needs_inputs */ false,
+      /* sampled */ false);
+}
+
+void disableOpLatencyHistograms() {
+  TORCH_CHECK(histograms_enabled, "op latency histograms are not enabled");
+  histograms_enabled = false;
+  popCallback();
+}
+
+bool opLatencyHistogramsEnabled() {
+  return histograms_enabled;
+}
+
+std::unordered_map<std::string, OpLatencyHistogram>
+snapshotOpLatencyHistograms() {
+  return registry().snapshot();
+}
+
+void resetOpLatencyHistograms() {
+  registry().reset();
+}
+
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
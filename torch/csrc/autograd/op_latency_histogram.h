@@ -0,0 +1,50 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace torch { namespace autograd { namespace profiler {
+
+// Number of latency buckets. Bucket i counts ops whose wall time fell into
+// [2^i, 2^(i+1)) nanoseconds (bucket 0 also absorbs sub-nanosecond readings,
+// the last bucket absorbs everything above ~2 seconds).
+constexpr size_t kOpLatencyNumBuckets = 32;
+
+// A fixed-size, exponentially-bucketed latency histogram for a single op
+// name. Unlike the event-list profiler, recording into it is allocation-free:
+// one bucket increment plus two counter updates per op.
+struct TORCH_API OpLatencyHistogram {
+  std::array<uint64_t, kOpLatencyNumBuckets> buckets{{}};
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+
+  void record(uint64_t ns);
+  void merge(const OpLatencyHistogram& other);
+};
+
+// Lower bound, in nanoseconds, of the given bucket.
+TORCH_API uint64_t opLatencyBucketLowerBound(size_t bucket);
+
+// Starts aggregating per-op-name latency histograms through the
+// RecordFunction observer mechanism. Samples are recorded into thread-local
+// state and only merged when a snapshot is taken, so this is cheap enough to
+// leave enabled in production. Like enableProfiler()/disableProfiler(), the
+// enable/disable pair participates in the RecordFunction callback stack and
+// must nest with other observers.
+TORCH_API void enableOpLatencyHistograms();
+TORCH_API void disableOpLatencyHistograms();
+TORCH_API bool opLatencyHistogramsEnabled();
+
+// Returns the histograms merged across all threads that have recorded since
+// the last reset. Does not stop collection.
+TORCH_API std::unordered_map<std::string, OpLatencyHistogram>
+snapshotOpLatencyHistograms();
+
+// Clears all accumulated histograms (collection, if enabled, continues).
+TORCH_API void resetOpLatencyHistograms();
+
+}}} // namespace torch::autograd::profiler
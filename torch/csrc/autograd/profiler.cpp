@@ -1,6 +1,8 @@
 #include <torch/csrc/autograd/profiler.h>
+#include <torch/csrc/autograd/profiler_perf_events.h>
 #include <torch/csrc/jit/code_template.h>
 
+#include <algorithm>
 #include <fstream>
 #include <list>
 #include <mutex>
@@ -39,12 +41,116 @@ RangeEventList& getEventList() {
   if (!event_list) {
     std::lock_guard<std::mutex> guard(all_event_lists_map_mutex);
     event_list = std::make_shared<RangeEventList>();
-    thread_id = ++next_thread_id;
+    if (thread_id == 0) {
+      thread_id = ++next_thread_id;
+    }
     all_event_lists_map.emplace(thread_id, event_list);
   }
   return *event_list;
 }
 
+// Sampling profiler state. The ring buffers are kept in a map like
+// all_event_lists_map so that samples recorded by threads that have since
+// exited can still be drained. The mutex only guards registration and
+// draining; recording itself is lock-free.
+std::atomic<bool> sampling_profiler_enabled{false};
+std::unordered_map<uint16_t, std::shared_ptr<SampledEventRingBuffer>>
+    sampled_buffers_map;
+thread_local std::shared_ptr<SampledEventRingBuffer> sampled_buffer;
+
+SampledEventRingBuffer& getSampledEventBuffer() {
+  if (!sampled_buffer) {
+    std::lock_guard<std::mutex> guard(all_event_lists_map_mutex);
+    sampled_buffer = std::make_shared<SampledEventRingBuffer>();
+    if (thread_id == 0) {
+      thread_id = ++next_thread_id;
+    }
+    sampled_buffers_map.emplace(thread_id, sampled_buffer);
+  }
+  return *sampled_buffer;
+}
+
+// Interns the op name so that SampledEvent stays a fixed-size POD. Names go
+// under a "profiler" namespace since autograd node names ("AddBackward0")
+// are not otherwise qualified. The registry lookup is only paid on sampled
+// calls.
+at::Symbol internSampledName(const char* name) {
+  return at::Symbol::fromQualString(std::string("profiler::") + name);
+}
+
+void enableSamplingProfiler(double sample_rate) {
+  TORCH_CHECK(
+      sample_rate > 0.0 && sample_rate <= 1.0,
+      "sample rate must be in (0, 1], got ",
+      sample_rate);
+  TORCH_CHECK(
+      !sampling_profiler_enabled.load(),
+      "sampling profiler is already enabled");
+  setSamplingProbability(sample_rate);
+  pushCallback(
+      [](const RecordFunction& fn) {
+        getSampledEventBuffer().record(
+            internSampledName(fn.name().str()),
+            EventKind::PushRange,
+            thread_id);
+      },
+      [](const RecordFunction& fn) {
+        // The end may run on a different thread than the begin (see
+        // RecordFunction::setThreadId); record into the current thread's
+        // buffer but keep the originating thread id so begin/end pairs can
+        // be matched after draining.
+        auto& buf = getSampledEventBuffer();
+        buf.record(
+            internSampledName(fn.name().str()),
+            EventKind::PopRange,
+            fn.getThreadId() != 0 ? fn.getThreadId() : thread_id);
+      },
+      /*needs_inputs=*/false,
+      /*sampled=*/true);
+  sampling_profiler_enabled = true;
+}
+
+std::vector<SampledEvent> disableSamplingProfiler() {
+  TORCH_CHECK(
+      sampling_profiler_enabled.load(),
+      "can't disable sampling profiler when it's not running");
+  popCallback();
+  setSamplingProbability(1.0);
+  sampling_profiler_enabled = false;
+  return drainSampledEvents();
+}
+
+bool samplingProfilerEnabled() {
+  return sampling_profiler_enabled.load();
+}
+
+std::vector<SampledEvent> drainSampledEvents() {
+  std::vector<SampledEvent> result;
+  std::lock_guard<std::mutex> guard(all_event_lists_map_mutex);
+  for (auto it = sampled_buffers_map.begin();
+       it != sampled_buffers_map.end();) {
+    auto& buffer = it->second;
+    auto events = buffer->drain();
+    result.insert(
+        result.end(),
+        std::make_move_iterator(events.begin()),
+        std::make_move_iterator(events.end()));
+    // GC buffers that are not held by any threads
+    if (buffer.use_count() == 1) {
+      it = sampled_buffers_map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  std::sort(
+      result.begin(),
+      result.end(),
+      [](const SampledEvent& a, const SampledEvent& b) {
+        return a.cpu_ns < b.cpu_ns;
+      });
+  return result;
+}
+
 void mark(std::string name, bool include_cuda /* = true */) {
   if (state == ProfilerState::Disabled) {
     return;
@@ -245,6 +351,9 @@ thread_event_lists disableProfiler() {
 }
 
 void Event::record(bool record_cuda) {
+  if (perfCountersEnabled()) {
+    readPerfCounters(counter_values_);
+  }
   if (record_cuda) {
     cuda_stubs->record(&device_, &event, &cpu_ns_);
     return;
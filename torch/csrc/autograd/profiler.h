@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <mutex>
 #include <memory>
@@ -165,6 +167,22 @@ struct TORCH_API Event final {
   int device() const {
     return device_;
   }
+  // Raw per-thread PMU counter readings taken when this event was recorded
+  // (see profiler_perf_events.h), in the order of perfCounterNames(); empty
+  // unless perf counters are configured. A counter that could not be opened
+  // on the recording thread reads as -1.
+  const std::vector<int64_t>& counters() const {
+    return counter_values_;
+  }
+  // Delta of counter idx between this event and a later event e, i.e. the
+  // amount attributed to the range the two events bracket.
+  int64_t counter_elapsed(const Event& e, size_t idx) const {
+    if (idx >= counter_values_.size() || idx >= e.counter_values_.size() ||
+        counter_values_[idx] < 0 || e.counter_values_[idx] < 0) {
+      throw std::runtime_error("no perf counter recorded at this index");
+    }
+    return e.counter_values_[idx] - counter_values_[idx];
+  }
 private:
   // signed to allow for negative intervals, initialized for safety.
   int64_t cpu_ns_ = 0;
@@ -172,6 +190,7 @@ private:
   EventKind kind_;
   uint16_t thread_id_;
   std::vector<std::vector<int64_t>> shapes_;
+  std::vector<int64_t> counter_values_;
   int device_ = -1;
   struct CUevent_st* event = nullptr;
 };
@@ -222,6 +241,80 @@ struct RangeEventList {
   std::forward_list<block_type> blocks;
 };
 
+// Fixed-size POD record used by the sampling profiler. Unlike Event it owns
+// no memory: the op name is interned as an at::Symbol under the "profiler"
+// namespace, so copying a record is a plain memcpy.
+struct TORCH_API SampledEvent {
+  int64_t cpu_ns = 0;
+  at::Symbol name;
+  EventKind kind = EventKind::Mark;
+  uint16_t thread_id = 0;
+
+  const char* name_str() const {
+    // The name was interned as "profiler::<name>", so the unqualified part
+    // is the original op name.
+    return name.toUnqualString();
+  }
+};
+
+// Lock-free single-writer ring buffer of SampledEvents. Every thread records
+// into its own buffer, so the hot path is a relaxed load, a slot write and a
+// release store - no mutex and no allocation. The drain side can race with a
+// writer that wraps around, in which case the oldest records of a snapshot
+// may be torn; that imprecision is accepted so the sampling profiler can
+// stay enabled in production.
+struct SampledEventRingBuffer {
+  constexpr static size_t capacity = 8192;
+  static_assert((capacity & (capacity - 1)) == 0,
+                "capacity must be a power of two");
+
+  void record(at::Symbol name, EventKind kind, uint16_t thread_id) {
+    auto pos = head_.load(std::memory_order_relaxed);
+    SampledEvent& slot = records_[pos & (capacity - 1)];
+    slot.cpu_ns = getTime();
+    slot.name = name;
+    slot.kind = kind;
+    slot.thread_id = thread_id;
+    head_.store(pos + 1, std::memory_order_release);
+  }
+
+  // Copies all records accumulated since the last drain (at most the ring
+  // capacity), oldest first, and marks them as consumed. Drains are
+  // serialized by the caller.
+  std::vector<SampledEvent> drain() {
+    const auto head = head_.load(std::memory_order_acquire);
+    auto tail = tail_;
+    if (head - tail > capacity) {
+      // The writer lapped the drainer; the overwritten records are lost.
+      tail = head - capacity;
+    }
+    std::vector<SampledEvent> result;
+    result.reserve(head - tail);
+    for (auto pos = tail; pos != head; ++pos) {
+      result.push_back(records_[pos & (capacity - 1)]);
+    }
+    tail_ = head;
+    return result;
+  }
+
+ private:
+  std::array<SampledEvent, capacity> records_;
+  std::atomic<uint64_t> head_{0};
+  // Only touched by the drainer.
+  uint64_t tail_ = 0;
+};
+
+// The sampling profiler is independent of enableProfiler/disableProfiler: it
+// samples op begin/end pairs at the given rate into per-thread ring buffers
+// of POD records, cheap enough to leave always-on at a low rate. Accumulated
+// samples are collected (and consumed) with drainSampledEvents. Note that
+// enable/disable use the RecordFunction callback stack, so the sampling
+// profiler and the full profiler must be disabled in LIFO order of enabling.
+TORCH_API void enableSamplingProfiler(double sample_rate);
+TORCH_API std::vector<SampledEvent> disableSamplingProfiler();
+TORCH_API bool samplingProfilerEnabled();
+TORCH_API std::vector<SampledEvent> drainSampledEvents();
+
 TORCH_API RangeEventList& getEventList();
 TORCH_API void mark(std::string name, bool include_cuda = true);
 TORCH_API void pushRange(std::string name);
@@ -0,0 +1,194 @@
+#include <torch/csrc/autograd/profiler_perf_events.h>
+#include <torch/csrc/autograd/profiler.h>
+
+#include <c10/util/Exception.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#ifdef USE_PERF_EVENTS
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace torch { namespace autograd { namespace profiler {
+
+#ifdef USE_PERF_EVENTS
+
+namespace {
+
+struct CounterConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+const std::unordered_map<std::string, CounterConfig>& counterTable() {
+  // Names follow the generic events of perf(1).
+  static const std::unordered_map<std::string, CounterConfig> table = {
+      {"cycles", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES}},
+      {"instructions", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS}},
+      {"cache-references",
+       {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES}},
+      {"cache-misses", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}},
+      {"branches", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS}},
+      {"branch-misses", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}},
+      {"bus-cycles", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BUS_CYCLES}},
+      {"stalled-cycles-frontend",
+       {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND}},
+      {"stalled-cycles-backend",
+       {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND}},
+      {"page-faults", {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS}},
+      {"context-switches",
+       {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES}},
+      {"cpu-migrations", {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS}},
+  };
+  return table;
+}
+
+// The configured counters. Configuration only changes while the profiler is
+// stopped; the generation counter lets threads notice a change and reopen
+// their descriptors lazily on the next read.
+std::mutex config_mutex;
+std::vector<std::string> configured_names;
+std::vector<CounterConfig> configured_counters;
+std::atomic<uint64_t> config_generation{0};
+std::atomic<bool> counters_enabled{false};
+
+int openCounter(const CounterConfig& config) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = config.type;
+  attr.config = config.config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // Count for the calling thread only, on whichever CPU it runs on.
+  return syscall(
+      __NR_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, /*group_fd=*/-1,
+      /*flags=*/0);
+}
+
+// Per-thread descriptors for the configured counters; closed on thread exit.
+struct ThreadCounters {
+  uint64_t generation = 0;
+  std::vector<int> fds;
+
+  void refresh() {
+    const auto current = config_generation.load(std::memory_order_acquire);
+    if (generation == current) {
+      return;
+    }
+    closeAll();
+    std::lock_guard<std::mutex> guard(config_mutex);
+    fds.reserve(configured_counters.size());
+    for (const auto& config : configured_counters) {
+      fds.push_back(openCounter(config));
+    }
+    generation = current;
+  }
+
+  void closeAll() {
+    for (int fd : fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+    fds.clear();
+  }
+
+  ~ThreadCounters() {
+    closeAll();
+  }
+};
+
+thread_local ThreadCounters thread_counters;
+
+} // namespace
+
+void setPerfCounters(const std::vector<std::string>& counter_names) {
+  TORCH_CHECK(
+      !profilerEnabled(),
+      "can't change perf counters while the profiler is running");
+  std::vector<CounterConfig> counters;
+  counters.reserve(counter_names.size());
+  for (const auto& name : counter_names) {
+    auto it = counterTable().find(name);
+    TORCH_CHECK(it != counterTable().end(), "unknown perf counter: ", name);
+    counters.push_back(it->second);
+  }
+  // Probe the counters on the calling thread so misconfiguration (e.g. a
+  // restrictive perf_event_paranoid setting) surfaces here instead of as -1
+  // readings later.
+  for (size_t i = 0; i < counters.size(); ++i) {
+    int fd = openCounter(counters[i]);
+    TORCH_CHECK(
+        fd >= 0,
+        "could not open perf counter '",
+        counter_names[i],
+        "' (errno ",
+        errno,
+        "); check /proc/sys/kernel/perf_event_paranoid");
+    close(fd);
+  }
+  {
+    std::lock_guard<std::mutex> guard(config_mutex);
+    configured_names = counter_names;
+    configured_counters = std::move(counters);
+  }
+  counters_enabled.store(
+      !counter_names.empty(), std::memory_order_relaxed);
+  config_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::vector<std::string> perfCounterNames() {
+  std::lock_guard<std::mutex> guard(config_mutex);
+  return configured_names;
+}
+
+bool perfCountersEnabled() {
+  return counters_enabled.load(std::memory_order_relaxed);
+}
+
+void readPerfCounters(std::vector<int64_t>& values) {
+  thread_counters.refresh();
+  const auto& fds = thread_counters.fds;
+  values.resize(fds.size());
+  for (size_t i = 0; i < fds.size(); ++i) {
+    uint64_t count = 0;
+    if (fds[i] < 0 || read(fds[i], &count, sizeof(count)) != sizeof(count)) {
+      values[i] = -1;
+      continue;
+    }
+    values[i] = static_cast<int64_t>(count);
+  }
+}
+
+#else // USE_PERF_EVENTS
+
+void setPerfCounters(const std::vector<std::string>& counter_names) {
+  TORCH_CHECK(
+      counter_names.empty(),
+      "PyTorch was built without perf_event support; rebuild with "
+      "USE_PERF_EVENTS=1 (Linux only)");
+}
+
+std::vector<std::string> perfCounterNames() {
+  return {};
+}
+
+bool perfCountersEnabled() {
+  return false;
+}
+
+void readPerfCounters(std::vector<int64_t>& values) {
+  values.clear();
+}
+
+#endif // USE_PERF_EVENTS
+
+}}} // namespace torch::autograd::profiler
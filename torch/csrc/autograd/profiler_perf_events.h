@@ -0,0 +1,39 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace torch { namespace autograd { namespace profiler {
+
+// Optional hardware performance-counter sampling for the profiler, backed by
+// Linux perf_event. When a set of counters is configured, every profiler
+// Event additionally records the calling thread's current counter values, so
+// the delta across a push/pop pair attributes e.g. cache misses or retired
+// instructions to an individual op without an external perf session.
+// Compiled in only when built with USE_PERF_EVENTS; without it
+// setPerfCounters throws (except for the empty list) and nothing is read.
+
+// Replaces the set of sampled counters. Accepts names matching perf(1):
+// "cycles", "instructions", "cache-references", "cache-misses", "branches",
+// "branch-misses", "bus-cycles", "stalled-cycles-frontend",
+// "stalled-cycles-backend", "page-faults", "context-switches",
+// "cpu-migrations". An empty list disables sampling. Must not be called
+// while the profiler is running. Throws if a name is unknown or the kernel
+// refuses access (see /proc/sys/kernel/perf_event_paranoid).
+TORCH_API void setPerfCounters(const std::vector<std::string>& counter_names);
+
+// Names currently configured, in the order their values appear in
+// Event::counters().
+TORCH_API std::vector<std::string> perfCounterNames();
+
+TORCH_API bool perfCountersEnabled();
+
+// Reads the configured counters on the calling thread into `values`. Called
+// by Event::record; a counter that could not be opened on this thread reads
+// as -1.
+TORCH_API void readPerfCounters(std::vector<int64_t>& values);
+
+}}} // namespace torch::autograd::profiler
@@ -1,4 +1,5 @@
 #include <torch/csrc/autograd/record_function.h>
+#include <c10/core/MemoryTracer.h>
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/utils/memory.h>
@@ -192,6 +193,11 @@ void RecordFunction::processCallbacks() {
   parent_ = thread_local_func_;
   thread_local_func_ = this;
 
+  // Tag allocations made while this op runs for the memory tracer.
+  if (c10::memory_tracing::enabled()) {
+    c10::memory_tracing::setCurrentOpName(name_.str());
+  }
+
   for (size_t idx = 0; idx < manager().start_callbacks.size(); ++idx) {
     if (!manager().is_callback_sampled[idx] || run_sampled_) {
       manager().start_callbacks[idx](*this);
@@ -233,6 +239,11 @@ void RecordFunction::end() {
         ": must be top of stack. If you are calling RecordFunction::end in a"
         "separate thread, call RecordFunction::setThreadId() in the creating"
         "thread.");
+    if (thread_local_func_ == this && c10::memory_tracing::enabled()) {
+      c10::memory_tracing::setCurrentOpName(
+          parent_ != nullptr && parent_->active() ? parent_->name().str()
+                                                  : nullptr);
+    }
     thread_local_func_ = parent_;
     initialized_ = false;
   }
@@ -27,6 +27,14 @@ class TORCH_API RecvRpcBackward : public torch::autograd::Node {
   torch::autograd::variable_list apply(
       torch::autograd::variable_list&& grads) override;
 
+  // apply() only serializes the gradients and fires an asynchronous RPC to
+  // the remote host, so it should be scheduled as soon as its inputs are
+  // ready: the remote worker then runs its portion of the backward pass
+  // while the local engine keeps working through local compute.
+  bool is_eager_dispatch() const override {
+    return true;
+  }
+
  private:
   const AutogradMetadata autogradMetadata_;
 
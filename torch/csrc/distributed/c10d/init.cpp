@@ -17,6 +17,7 @@
 #endif
 
 #include <c10d/PrefixStore.hpp>
+#include <c10d/ProcessGroupHierarchical.hpp>
 #include <c10d/ProcessGroupRoundRobin.hpp>
 #include <c10d/TCPStore.hpp>
 #include <pybind11/chrono.h>
@@ -118,15 +119,47 @@ PyObject* c10d_init(PyObject* _unused) {
 
   shared_ptr_class_<::c10d::Reducer>(module, "Reducer")
       .def(
-          py::init<
-              std::vector<std::vector<torch::autograd::Variable>>,
-              std::vector<std::vector<size_t>>,
-              std::shared_ptr<::c10d::ProcessGroup>,
-              std::vector<std::vector<bool>>>(),
+          py::init(
+              [](std::vector<std::vector<torch::autograd::Variable>> replicas,
+                 std::vector<std::vector<size_t>> bucket_indices,
+                 std::shared_ptr<::c10d::ProcessGroup> process_group,
+                 std::vector<std::vector<bool>> expect_sparse_gradients,
+                 const std::string& gradient_compression,
+                 const std::string& comm_dtype) {
+                ::c10d::GradientCompressionHook hook;
+                if (gradient_compression == "fp16") {
+                  hook = ::c10d::make_fp16_compression_hook();
+                } else {
+                  TORCH_CHECK(
+                      gradient_compression == "none",
+                      "Unknown gradient compression: ",
+                      gradient_compression);
+                }
+                c10::optional<c10::ScalarType> comm_scalar_type;
+                if (comm_dtype == "fp16") {
+                  comm_scalar_type = at::kHalf;
+                } else if (comm_dtype == "bf16") {
+                  comm_scalar_type = at::kBFloat16;
+                } else {
+                  TORCH_CHECK(
+                      comm_dtype == "none",
+                      "Unknown communication dtype: ",
+                      comm_dtype);
+                }
+                return std::make_shared<::c10d::Reducer>(
+                    std::move(replicas),
+                    std::move(bucket_indices),
+                    std::move(process_group),
+                    std::move(expect_sparse_gradients),
+                    std::move(hook),
+                    comm_scalar_type);
+              }),
           py::arg("replicas"),
           py::arg("bucket_indices"),
           py::arg("process_group"),
-          py::arg("expect_sparse_gradients") = std::vector<std::vector<bool>>())
+          py::arg("expect_sparse_gradients") = std::vector<std::vector<bool>>(),
+          py::arg("gradient_compression") = "none",
+          py::arg("comm_dtype") = "none")
       .def(
           "initialize_buckets",
           &::c10d::Reducer::initialize_buckets,
@@ -140,7 +173,13 @@ PyObject* c10d_init(PyObject* _unused) {
           [](::c10d::Reducer& reducer, const torch::autograd::Variable& output)
               -> void { reducer.prepare_for_backward({output}); },
           py::call_guard<py::gil_scoped_release>())
-      .def("get_backward_stats", &::c10d::Reducer::get_backward_stats);
+      .def("get_backward_stats", &::c10d::Reducer::get_backward_stats)
+      .def(
+          "get_comm_overflow_element_count",
+          &::c10d::Reducer::get_comm_overflow_element_count)
+      .def(
+          "get_comm_overflow_bucket_count",
+          &::c10d::Reducer::get_comm_overflow_bucket_count);
 
   py::enum_<::c10d::ReduceOp>(module, "ReduceOp", R"(
 An enum-like class for available reduction operations: ``SUM``, ``PRODUCT``,
@@ -265,13 +304,17 @@ They are used in specifying strategies for reduction collectives, e.g.,
               int,
               int,
               bool,
-              std::chrono::milliseconds>(),
+              std::chrono::milliseconds,
+              bool,
+              int>(),
           py::arg("host_name"),
           py::arg("port"),
           py::arg("world_size"),
           py::arg("is_master"),
           py::arg("timeout") =
-              std::chrono::milliseconds(::c10d::Store::kDefaultTimeout));
+              std::chrono::milliseconds(::c10d::Store::kDefaultTimeout),
+          py::arg("wait_workers") = true,
+          py::arg("num_server_threads") = 1);
 
   shared_ptr_class_<::c10d::PrefixStore>(module, "PrefixStore", store)
       .def(py::init<const std::string&, std::shared_ptr<::c10d::Store>>());
@@ -332,6 +375,29 @@ They are used in specifying strategies for reduction collectives, e.g.,
               py::arg("op") = ::c10d::ReduceOp::SUM,
               py::call_guard<py::gil_scoped_release>())
 
+          .def(
+              "start_coalescing",
+              &::c10d::ProcessGroup::start_coalescing,
+              py::call_guard<py::gil_scoped_release>())
+
+          .def(
+              "end_coalescing",
+              &::c10d::ProcessGroup::end_coalescing,
+              py::call_guard<py::gil_scoped_release>())
+
+          .def(
+              "coalesced_allreduce",
+              [](::c10d::ProcessGroup& pg,
+                 std::vector<at::Tensor>& xs,
+                 ::c10d::ReduceOp op) {
+                ::c10d::AllreduceOptions opts;
+                opts.reduceOp = op;
+                return pg.coalesced_allreduce(xs, opts);
+              },
+              py::arg("tensors"),
+              py::arg("op") = ::c10d::ReduceOp::SUM,
+              py::call_guard<py::gil_scoped_release>())
+
           .def(
               "allreduce_coalesced",
               [](::c10d::ProcessGroup& pg,
@@ -504,6 +570,26 @@ They are used in specifying strategies for reduction collectives, e.g.,
       py::arg("process_groups"),
       py::call_guard<py::gil_scoped_release>());
 
+  module.def(
+      "_hierarchical_process_group",
+      [](std::shared_ptr<::c10d::ProcessGroup> globalGroup,
+         std::shared_ptr<::c10d::ProcessGroup> intraGroup,
+         std::shared_ptr<::c10d::ProcessGroup> interGroup)
+          -> std::shared_ptr<::c10d::ProcessGroup> {
+        const auto rank = globalGroup->getRank();
+        const auto size = globalGroup->getSize();
+        return std::make_shared<::c10d::ProcessGroupHierarchical>(
+            rank,
+            size,
+            std::move(globalGroup),
+            std::move(intraGroup),
+            std::move(interGroup));
+      },
+      py::arg("global_group"),
+      py::arg("intra_group"),
+      py::arg("inter_group"),
+      py::call_guard<py::gil_scoped_release>());
+
 #ifdef USE_C10D_GLOO
   auto processGroupGloo = shared_ptr_class_<::c10d::ProcessGroupGloo>(
       module, "ProcessGroupGloo", processGroup);
@@ -585,7 +671,26 @@ They are used in specifying strategies for reduction collectives, e.g.,
           py::arg("rank"),
           py::arg("size"),
           py::arg("timeout") = std::chrono::milliseconds(
-              ::c10d::ProcessGroupNCCL::kProcessGroupNCCLOpTimeoutMillis));
+              ::c10d::ProcessGroupNCCL::kProcessGroupNCCLOpTimeoutMillis))
+      .def(
+          "_init_comms",
+          [](::c10d::ProcessGroupNCCL& pg,
+             const std::vector<std::vector<int64_t>>& device_indices) {
+            std::vector<std::vector<at::Device>> deviceLists;
+            deviceLists.reserve(device_indices.size());
+            for (const auto& indices : device_indices) {
+              std::vector<at::Device> devices;
+              devices.reserve(indices.size());
+              for (auto index : indices) {
+                devices.emplace_back(
+                    at::DeviceType::CUDA, static_cast<c10::DeviceIndex>(index));
+              }
+              deviceLists.push_back(std::move(devices));
+            }
+            pg.initComms(deviceLists);
+          },
+          py::arg("device_indices"),
+          py::call_guard<py::gil_scoped_release>());
 #endif
 
 #ifdef USE_C10D_MPI
@@ -39,14 +39,31 @@ inline int64_t current_time_in_nanos() {
 
 } // namespace
 
+GradientCompressionHook make_fp16_compression_hook() {
+  GradientCompressionHook hook;
+  hook.compress = [](const at::Tensor& tensor) {
+    return tensor.to(at::kHalf);
+  };
+  // The reduced half precision tensor is copied back into the full precision
+  // bucket by the reducer, which performs the cast.
+  hook.decompress = [](const at::Tensor& tensor) { return tensor; };
+  return hook;
+}
+
 Reducer::Reducer(
     std::vector<std::vector<torch::autograd::Variable>> replicas,
     std::vector<std::vector<size_t>> bucket_indices,
     std::shared_ptr<c10d::ProcessGroup> process_group,
-    std::vector<std::vector<bool>> expect_sparse_gradients)
+    std::vector<std::vector<bool>> expect_sparse_gradients,
+    GradientCompressionHook compression_hook,
+    c10::optional<c10::ScalarType> comm_dtype)
     : replicas_(std::move(replicas)),
       process_group_(std::move(process_group)),
       expect_sparse_gradients_(std::move(expect_sparse_gradients)),
+      compression_hook_(std::move(compression_hook)),
+      comm_dtype_(comm_dtype),
+      comm_overflow_element_count_(0),
+      comm_overflow_bucket_count_(0),
       expect_autograd_hooks_(false),
       require_finalize_(false),
       next_bucket_(0),
@@ -56,6 +73,17 @@ Reducer::Reducer(
   TORCH_CHECK(replicas_.size() >= 1, "Expected at least one model replica.");
   TORCH_CHECK(replicas_[0].size() >= 1, "Expected at least one parameter.");
 
+  if (comm_dtype_) {
+    TORCH_CHECK(
+        *comm_dtype_ == at::kHalf || *comm_dtype_ == at::kBFloat16,
+        "Expected communication dtype to be Half or BFloat16, got ",
+        *comm_dtype_);
+    TORCH_CHECK(
+        !compression_hook_,
+        "A communication dtype cannot be combined with a gradient ",
+        "compression hook.");
+  }
+
   // If `expect_sparse_gradients` is not specified, initialize it such that
   // we do not expect sparse gradients for any parameter.
   if (expect_sparse_gradients_.empty()) {
@@ -223,9 +251,12 @@ void Reducer::mark_variable_ready_dense(VariableIndex index) {
   auto bucket_view = replica.contents.narrow(0, offset, length);
   auto& grad = variable.grad();
   if (grad.defined()) {
-    // Ensure that the gradient type matches the bucket type.
+    // Ensure that the gradient type matches the bucket type. If the bucket
+    // is allocated in a lower precision communication dtype, the copy below
+    // performs the downcast instead.
     TORCH_CHECK(
-        grad.options().type_equal(bucket_view.options()),
+        replica.comm_downcast ||
+            grad.options().type_equal(bucket_view.options()),
         "Expected ",
         bucket_view.toString(),
         ", got ",
@@ -412,7 +443,19 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
       //
       tensors.push_back(replica.contents);
     }
-    bucket.work = process_group_->allreduce(tensors);
+    if (compression_hook_ && !bucket.expect_sparse_gradient) {
+      // Communicate the compressed representation instead of the full
+      // precision bucket; the result is decompressed and copied back into
+      // the bucket in finalize_backward.
+      bucket.compressed.clear();
+      bucket.compressed.reserve(tensors.size());
+      for (const auto& tensor : tensors) {
+        bucket.compressed.push_back(compression_hook_.compress(tensor));
+      }
+      bucket.work = process_group_->allreduce(bucket.compressed);
+    } else {
+      bucket.work = process_group_->allreduce(tensors);
+    }
   }
 }
 
@@ -500,7 +543,16 @@ void Reducer::initialize_buckets(
           offset += length;
         }
 
-        // Allocate bucket contents tensor.
+        // Allocate bucket contents tensor. If a communication dtype is set,
+        // full precision buckets are allocated at the reduced width instead;
+        // gradients that already are lower precision are left alone.
+        if (comm_dtype_) {
+          const auto scalar_type = c10::typeMetaToScalarType(options.dtype());
+          if (scalar_type == at::kFloat || scalar_type == at::kDouble) {
+            options = options.dtype(*comm_dtype_);
+            replica.comm_downcast = true;
+          }
+        }
         replica.contents = at::empty({static_cast<long>(offset)}, options);
       }
 
@@ -670,9 +722,11 @@ void Reducer::finalize_bucket_dense(Bucket& bucket) {
       auto& grad = variable.grad();
 
       // If a parameter is globally unused, we keep its grad untouched.
+      // The gradient is allocated in the variable's dtype, not the bucket's,
+      // so that the copy upcasts if the bucket holds a communication dtype.
       if (!global_unused) {
         if (!grad.defined()) {
-          grad = at::empty(bucket_view.sizes(), bucket_view.options());
+          grad = at::empty(bucket_view.sizes(), variable.options());
         }
         grad.copy_(bucket_view);
       }
@@ -709,9 +763,36 @@ void Reducer::finalize_backward() {
   for (auto& bucket : buckets_) {
     TORCH_INTERNAL_ASSERT(bucket.work);
     bucket.work->wait();
+    if (!bucket.compressed.empty()) {
+      // Restore full precision bucket contents from the reduced compressed
+      // representation before unflattening into the variables.
+      for (size_t i = 0; i < bucket.replicas.size(); i++) {
+        bucket.replicas[i].contents.copy_(
+            compression_hook_.decompress(bucket.compressed[i]));
+      }
+      bucket.compressed.clear();
+    }
     if (bucket.expect_sparse_gradient) {
       finalize_bucket_sparse(bucket);
     } else {
+      // Count non-finite values produced by reducing at a narrower range
+      // before the contents are unflattened into the gradients.
+      for (auto& replica : bucket.replicas) {
+        if (!replica.comm_downcast) {
+          continue;
+        }
+        // isfinite has no kernel for bfloat16 in all backends; inspect an
+        // fp32 copy instead, which preserves infs and nans exactly.
+        auto contents = replica.contents.scalar_type() == at::kHalf
+            ? replica.contents
+            : replica.contents.to(at::kFloat);
+        const auto overflowed = contents.numel() -
+            at::isfinite(contents).sum().item<int64_t>();
+        if (overflowed > 0) {
+          comm_overflow_element_count_ += overflowed;
+          comm_overflow_bucket_count_++;
+        }
+      }
       finalize_bucket_dense(bucket);
     }
   }
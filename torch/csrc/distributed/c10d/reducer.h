@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <tuple>
@@ -13,17 +14,50 @@
 
 namespace c10d {
 
+// A gradient compression hook transforms a bucket's flattened contents
+// tensor into a (typically smaller or lower precision) tensor that is
+// allreduced in its place, and maps the reduced result back. `compress` runs
+// right before a bucket's allreduce is kicked off and `decompress` right
+// after the corresponding work handle completes; the decompressed result is
+// copied back into the full precision bucket (with dtype conversion), so
+// `decompress` may simply return its argument for plain casting hooks.
+// Sparse gradient buckets are never compressed.
+struct GradientCompressionHook {
+  std::function<at::Tensor(const at::Tensor&)> compress;
+  std::function<at::Tensor(const at::Tensor&)> decompress;
+
+  explicit operator bool() const {
+    return compress != nullptr && decompress != nullptr;
+  }
+};
+
+// Built-in hook that casts bucket contents to half precision for
+// communication and relies on the copy back into the bucket to restore the
+// original dtype.
+GradientCompressionHook make_fp16_compression_hook();
+
 class Reducer {
  public:
   // The constructor takes a list of variables for every model replica.
   // The bucket assignment for this reducer is specified as a list of
   // buckets, each of which is specified as a list of indices into the
   // variables list for **a single replica** (i.e. `variables[0]`).
+  // `comm_dtype`, if given, must be kHalf or kBFloat16 and enables
+  // low-precision gradient communication: bucket contents are allocated in
+  // that dtype, the copy of each fp32/fp64 gradient into its bucket
+  // performs the downcast, the allreduce runs at the reduced width, and the
+  // copy back into the gradients upcasts. Gradients and the optimizer state
+  // stay full precision. Non-finite values produced by the narrower range
+  // are tallied in the overflow counters below. This is distinct from a
+  // compression hook, which transforms an already-allocated full precision
+  // bucket per iteration; the two are mutually exclusive.
   explicit Reducer(
       std::vector<std::vector<torch::autograd::Variable>> replicas,
       std::vector<std::vector<size_t>> bucket_indices,
       std::shared_ptr<c10d::ProcessGroup> process_group,
-      std::vector<std::vector<bool>> expect_sparse_gradients);
+      std::vector<std::vector<bool>> expect_sparse_gradients,
+      GradientCompressionHook compression_hook = GradientCompressionHook(),
+      c10::optional<c10::ScalarType> comm_dtype = c10::nullopt);
 
   ~Reducer() noexcept(false);
 
@@ -47,6 +81,17 @@ class Reducer {
     return backward_stats_;
   }
 
+  // Running totals of non-finite values observed in low-precision bucket
+  // contents after reduction, and of buckets that contained at least one
+  // such value. Only ever incremented when a `comm_dtype` was specified.
+  int64_t get_comm_overflow_element_count() const {
+    return comm_overflow_element_count_;
+  }
+
+  int64_t get_comm_overflow_bucket_count() const {
+    return comm_overflow_bucket_count_;
+  }
+
  protected:
   // Forward declaration.
   struct Bucket;
@@ -61,6 +106,10 @@ class Reducer {
   std::vector<std::vector<torch::autograd::Variable>> replicas_;
   std::shared_ptr<c10d::ProcessGroup> process_group_;
   std::vector<std::vector<bool>> expect_sparse_gradients_;
+  GradientCompressionHook compression_hook_;
+  c10::optional<c10::ScalarType> comm_dtype_;
+  int64_t comm_overflow_element_count_;
+  int64_t comm_overflow_bucket_count_;
 
   std::vector<std::vector<std::shared_ptr<torch::autograd::Node>>>
       grad_accumulators_;
@@ -136,6 +185,11 @@ class Reducer {
     // This is reset to `variables.size()` every iteration.
     size_t pending;
 
+    // Whether `contents` is allocated in the reducer's communication dtype
+    // rather than the variables' dtype. If set, the copy into the bucket
+    // downcasts and the copy back into the gradients upcasts.
+    bool comm_downcast = false;
+
     // TODO(@pietern)
     // Memory copies from gradient tensors into the bucket are potentially
     // done on different CUDA streams. We record an event for every copy
@@ -160,6 +214,10 @@ class Reducer {
     // Keep work handle around when this set of buckets is being reduced.
     std::shared_ptr<c10d::ProcessGroup::Work> work;
 
+    // Compressed per-replica contents while this bucket's reduction is in
+    // flight. Only populated when a compression hook is installed.
+    std::vector<at::Tensor> compressed;
+
     // If this bucket should expect a single sparse gradient.
     // Implies: replicas[i].variables.size() == 1.
     bool expect_sparse_gradient = false;
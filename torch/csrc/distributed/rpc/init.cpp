@@ -2,6 +2,7 @@
 
 #include <torch/csrc/distributed/rpc/process_group_agent.h>
 #include <torch/csrc/distributed/rpc/py_rref.h>
+#include <torch/csrc/distributed/rpc/tcp_agent.h>
 #include <torch/csrc/distributed/rpc/python_functions.h>
 #include <torch/csrc/distributed/rpc/python_rpc_handler.h>
 #include <torch/csrc/distributed/rpc/rpc_agent.h>
@@ -252,6 +253,53 @@ If the future completes with an error, an exception is thrown.
           &ProcessGroupAgent::sync,
           py::call_guard<py::gil_scoped_release>());
 
+#ifdef __linux__
+  shared_ptr_class_<TcpRpcBackendOptions>(
+      module, "TcpRpcBackendOptions", rpcBackendOptions)
+      .def(py::init<>())
+      .def_readwrite(
+          "num_worker_threads", &TcpRpcBackendOptions::numWorkerThreads);
+
+  shared_ptr_class_<TcpRpcAgent>(module, "TcpRpcAgent", rpcAgent)
+      .def(
+          py::init<
+              std::string,
+              worker_id_t,
+              int,
+              std::shared_ptr<::c10d::Store>,
+              int,
+              std::chrono::milliseconds>(),
+          py::arg("name"),
+          py::arg("rank"),
+          py::arg("world_size"),
+          py::arg("store"),
+          py::arg("num_worker_threads"),
+          py::arg("rpc_timeout"))
+      .def(
+          "get_worker_info",
+          (const WorkerInfo& (TcpRpcAgent::*)(void)const) &
+              RpcAgent::getWorkerInfo,
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "get_worker_info",
+          (const WorkerInfo& (TcpRpcAgent::*)(const std::string&)const) &
+              TcpRpcAgent::getWorkerInfo,
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "get_worker_infos",
+          (std::vector<WorkerInfo>(TcpRpcAgent::*)() const) &
+              TcpRpcAgent::getWorkerInfos,
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "join", &TcpRpcAgent::join, py::call_guard<py::gil_scoped_release>())
+      .def(
+          "shutdown",
+          &TcpRpcAgent::shutdown,
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "sync", &TcpRpcAgent::sync, py::call_guard<py::gil_scoped_release>());
+#endif
+
   module.def("_is_current_rpc_agent_set", &RpcAgent::isCurrentRpcAgentSet);
 
   module.def("_get_current_rpc_agent", &RpcAgent::getCurrentRpcAgent);
@@ -44,6 +44,10 @@ enum MessageType {
   CLEANUP_AUTOGRAD_CONTEXT_REQ = 19,
   CLEANUP_AUTOGRAD_CONTEXT_RESP = 20,
 
+  // Batched RRef fetches
+  MULTI_RREF_FETCH_CALL = 21, // Fetch values of several OwnerRRefs in one RPC
+  MULTI_RREF_FETCH_RET = 22, // Values for a MULTI_RREF_FETCH_CALL
+
   // Other internal message types
   EXCEPTION = 55,
   UNKNOWN = 60
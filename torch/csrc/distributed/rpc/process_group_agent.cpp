@@ -1,5 +1,6 @@
 #include <torch/csrc/distributed/rpc/process_group_agent.h>
 
+#include <TH/THAllocator.h>
 #include <c10/util/C++17.h>
 #include <c10d/ProcessGroup.hpp>
 #include <torch/csrc/distributed/rpc/request_callback_impl.h>
@@ -7,6 +8,15 @@
 
 #include <Python.h>
 
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace torch {
 namespace distributed {
 namespace rpc {
@@ -55,6 +65,89 @@ const std::string kThreadPoolSize = "agent.thread_pool_size";
 const std::string kNumIdleThreads = "agent.num_idle_threads";
 const std::string kGilAverageWaitTime = "agent.gil_average_wait_time_us";
 
+// Note [Same-host shm transport]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// When caller and callee share a shared-memory namespace, tensor payloads
+// do not need to travel through the ProcessGroup at all: handleSend()
+// writes each wire segment once into a named shm segment and only sends
+// the segment names; listenLoopInternal() maps the segments and the
+// deserialized tensors adopt the mappings as their storages (see
+// wireDeserializeSegmented()). This turns loopback serialization into a
+// single local memcpy per tensor.
+//
+// The receiver unlinks a segment immediately after mapping it, so the
+// name disappears once both sides hold the mapping and the memory is
+// reclaimed when the last tensor referencing it dies. A process crashing
+// between creation and mapping can leak a segment; this is the same
+// tradeoff torch.multiprocessing makes for file_system sharing.
+//
+// Whether a peer is "same host" is decided at startup by probing, not by
+// comparing hostnames: every rank publishes a named probe segment filled
+// with a random nonce, every rank tries to map every other rank's probe,
+// and the results are allgathered so both directions must agree. Mapping
+// by name is exactly the operation the transport performs, so containers
+// that share a hostname but not /dev/shm are classified correctly. The
+// fast path can be disabled by setting RPC_DISABLE_SHM_TRANSPORT=1.
+
+#ifndef _WIN32
+namespace {
+
+// Below this payload size the two extra ProcessGroup messages and the shm
+// syscalls cost more than just inlining the segment bytes.
+constexpr size_t kShmMinTotalSegmentBytes = 1 << 16;
+constexpr size_t kShmProbeSize = 64;
+constexpr size_t kShmProbeNameLen = 64;
+
+std::string newShmFilename() {
+  static std::random_device rd;
+  static std::atomic<uint64_t> counter{0};
+  std::string handle = "/torch_rpc_";
+  handle += std::to_string(getpid());
+  handle += '_';
+  handle += std::to_string(rd());
+  handle += '_';
+  handle += std::to_string(counter++);
+  return handle;
+}
+
+// Copies `size` bytes into a freshly created named shm segment and appends
+// a "<name> <size>" record line. The returned DataPtr owns the sender-side
+// mapping; the name stays valid for the receiver until it unlinks it.
+at::DataPtr createShmSegment(
+    const char* data,
+    size_t size,
+    std::string& records) {
+  const auto filename = newShmFilename();
+  int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE;
+  auto ptr = THMapAllocator::makeDataPtr(filename.c_str(), flags, size, nullptr);
+  memcpy(ptr.get(), data, size);
+  records.append(filename).append(" ").append(c10::to_string(size));
+  records.push_back('\n');
+  return ptr;
+}
+
+// Maps a peer's shm segment and wraps it in a flat kChar tensor suitable
+// as a wire segment. The name is unlinked right away; the mapping keeps
+// the memory alive until the deserialized tensors release it.
+torch::Tensor mapShmSegment(const std::string& filename, int64_t size) {
+  int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE |
+      TH_ALLOCATOR_MAPPED_UNLINK;
+  auto ptr =
+      THMapAllocator::makeDataPtr(filename.c_str(), flags, (size_t)size, nullptr);
+  auto storage = c10::Storage(
+      caffe2::TypeMeta::Make<int8_t>(),
+      size,
+      std::move(ptr),
+      /* allocator */ nullptr,
+      /* resizable */ false);
+  auto segment = torch::empty({0}, torch::kChar);
+  segment.set_(storage, 0, {size}, {1});
+  return segment;
+}
+
+} // namespace
+#endif // !_WIN32
+
 void ProcessGroupAgent::collectNames() {
   const std::string& workerName = workerInfo_.name_;
   const auto worldSize = pg_->getSize();
@@ -86,6 +179,123 @@ void ProcessGroupAgent::collectNames() {
   }
 }
 
+void ProcessGroupAgent::detectSameHostPeers() {
+  const auto worldSize = pg_->getSize();
+  sameHostPeers_.assign(worldSize, false);
+#ifndef _WIN32
+  const auto rank = pg_->getRank();
+  // Publish a probe segment filled with a random nonce. If creating it
+  // fails (or the fast path is disabled), we still have to participate in
+  // the collectives below, so we publish an empty name that no peer will
+  // be able to map.
+  std::string nonce(kShmProbeSize, '\0');
+  {
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    for (auto& c : nonce) {
+      c = (char)gen();
+    }
+  }
+
+  std::string probeName;
+  at::DataPtr probe;
+  const char* disableEnv = std::getenv("RPC_DISABLE_SHM_TRANSPORT");
+  bool probeOk = !(disableEnv && strcmp(disableEnv, "0") != 0);
+  if (probeOk) {
+    try {
+      auto name = newShmFilename();
+      TORCH_INTERNAL_ASSERT(name.size() < kShmProbeNameLen);
+      probe = THMapAllocator::makeDataPtr(
+          name.c_str(),
+          TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE,
+          kShmProbeSize,
+          nullptr);
+      memcpy(probe.get(), nonce.data(), kShmProbeSize);
+      probeName = std::move(name);
+    } catch (const std::exception&) {
+      probeOk = false;
+    }
+  }
+
+  const int64_t probeMsgLen = kShmProbeNameLen + kShmProbeSize;
+  torch::Tensor probeMsg = torch::zeros({probeMsgLen}, torch::kChar);
+  char* probeMsgData = (char*)probeMsg.storage().data();
+  if (probeOk) {
+    memcpy(probeMsgData, probeName.c_str(), probeName.size());
+    memcpy(probeMsgData + kShmProbeNameLen, nonce.data(), kShmProbeSize);
+  }
+  std::vector<torch::Tensor> inputProbe = {probeMsg};
+  std::vector<std::vector<torch::Tensor>> outputProbes(1);
+  for (int i = 0; i < worldSize; ++i) {
+    outputProbes[0].emplace_back(torch::empty({probeMsgLen}, {torch::kChar}));
+  }
+  pg_->allgather(outputProbes, inputProbe)->wait();
+
+  // Try to map every peer's probe and check its nonce round-trips.
+  torch::Tensor canMap = torch::zeros({worldSize}, torch::kChar);
+  char* canMapData = (char*)canMap.storage().data();
+  for (int i = 0; i < worldSize; ++i) {
+    if (i == rank) {
+      continue;
+    }
+    const char* peerData = (const char*)outputProbes[0][i].storage().data();
+    std::string peerName(peerData, strnlen(peerData, kShmProbeNameLen));
+    if (peerName.empty()) {
+      continue;
+    }
+    try {
+      auto peerProbe = THMapAllocator::makeDataPtr(
+          peerName.c_str(),
+          TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE,
+          kShmProbeSize,
+          nullptr);
+      canMapData[i] =
+          memcmp(peerProbe.get(), peerData + kShmProbeNameLen, kShmProbeSize) ==
+          0;
+    } catch (const std::exception&) {
+      // Not reachable through shm; leave canMapData[i] at 0.
+    }
+  }
+
+  // Both directions have to agree before the fast path is used. The second
+  // allgather also acts as a barrier: once it completes, every peer is done
+  // mapping probes and the probe segments can be unlinked.
+  std::vector<torch::Tensor> inputCanMap = {canMap};
+  std::vector<std::vector<torch::Tensor>> outputCanMap(1);
+  for (int i = 0; i < worldSize; ++i) {
+    outputCanMap[0].emplace_back(torch::empty({worldSize}, {torch::kChar}));
+  }
+  pg_->allgather(outputCanMap, inputCanMap)->wait();
+  for (int i = 0; i < worldSize; ++i) {
+    if (i == rank) {
+      continue;
+    }
+    const char* peerCanMap = (const char*)outputCanMap[0][i].storage().data();
+    sameHostPeers_[i] = canMapData[i] != 0 && peerCanMap[rank] != 0;
+  }
+
+  if (probeOk) {
+    try {
+      // Re-opening with UNLINK removes the name; the probe mapping itself
+      // dies with `probe` below.
+      THMapAllocator::makeDataPtr(
+          probeName.c_str(),
+          TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE |
+              TH_ALLOCATOR_MAPPED_UNLINK,
+          kShmProbeSize,
+          nullptr);
+    } catch (const std::exception&) {
+      // Best effort; a leaked 64-byte probe segment is harmless.
+    }
+  }
+#endif // !_WIN32
+}
+
+bool ProcessGroupAgent::isSameHostPeer(worker_id_t dst) const {
+  return dst >= 0 && (size_t)dst < sameHostPeers_.size() &&
+      sameHostPeers_[dst];
+}
+
 ProcessGroupAgent::ProcessGroupAgent(
     std::string workerName,
     std::shared_ptr<c10d::ProcessGroup> pg,
@@ -135,6 +345,8 @@ ProcessGroupAgent::ProcessGroupAgent(
   for (int rank = 0; rank < (int)tmpWorkerIds.size(); ++rank) {
     allWorkerInfo_.emplace_back(std::move(tmpWorkerIds[rank]), rank);
   }
+
+  detectSameHostPeers();
 }
 
 ProcessGroupAgent::~ProcessGroupAgent() {
@@ -325,23 +537,32 @@ std::shared_ptr<FutureMessage> ProcessGroupAgent::send(
     threadPool_.run(std::bind(
         [this](const Message& message) {
           sendCounts_.increment(pg_->getRank());
-          // Unlike the other cases, need to add a tensor deleter, since the
-          // data outlives the scope of this function. It's shared_ptr<> due
-          // to c++11 lambda capture limitations with unique_ptr<>.
-          auto payload = std::make_unique<std::string>(
-              wireSerialize(message.payload(), message.tensors()));
-          const char* data = payload->data();
-          size_t len = payload->length();
-          std::string* delete_when_done = payload.release();
+          // Serialize in segmented form so that even the loopback path does
+          // not copy tensor contents: the header and every segment tensor
+          // alias the shared WireSegments object, whose deleters keep the
+          // data alive until the last view is released. It's shared_ptr<>
+          // due to c++11 lambda capture limitations with unique_ptr<>.
+          auto wire = std::make_shared<WireSegments>(
+              wireSerializeSegmented(message.payload(), message.tensors()));
+          std::vector<torch::Tensor> segments;
+          segments.reserve(wire->tensorData.size());
+          for (const auto& td : wire->tensorData) {
+            segments.push_back(torch::from_blob(
+                (void*)td.data(),
+                (int64_t)td.sizeInBytes(),
+                [wire](void*) {},
+                {torch::kChar}));
+          }
           enqueueRecv(RecvWork(
               getWorkerInfo(pg_->getRank()),
               message.type(),
               message.id(),
               torch::from_blob(
-                  (void*)data,
-                  len,
-                  [delete_when_done](void*) { delete delete_when_done; },
-                  {torch::kChar})));
+                  (void*)wire->header.data(),
+                  (int64_t)wire->header.length(),
+                  [wire](void*) {},
+                  {torch::kChar}),
+              std::move(segments)));
         },
         std::move(message)));
     return future;
@@ -361,25 +582,81 @@ std::shared_ptr<FutureMessage> ProcessGroupAgent::send(
 }
 
 void ProcessGroupAgent::handleSend(const SendWork& work) {
-  std::string serializedPayload =
-      wireSerialize(work.message_.payload(), work.message_.tensors());
+  // Serialize into a flat header (payload bits plus pickle metadata) and one
+  // data segment per tensor. The segments alias the message's tensor
+  // storages, so tensor bytes go onto the wire without first being copied
+  // into a flat buffer. `wire` must stay alive until all sends below have
+  // completed.
+  auto wire =
+      wireSerializeSegmented(work.message_.payload(), work.message_.tensors());
+  const int64_t numSegments = (int64_t)wire.tensorData.size();
+  const auto dst = work.to_.id_;
+
+  // Same-host fast path: write the segments into named shm segments and
+  // only send the records; the segment bytes never touch the ProcessGroup.
+  // Signalled to the receiver by a negative segment count in the preamble.
+  // See Note [Same-host shm transport].
+  bool useShm = false;
+  std::string shmRecords;
+  std::vector<at::DataPtr> shmSegments;
+#ifndef _WIN32
+  size_t totalSegmentBytes = 0;
+  for (const auto& td : wire.tensorData) {
+    totalSegmentBytes += td.sizeInBytes();
+  }
+  useShm = numSegments > 0 && isSameHostPeer(dst) &&
+      totalSegmentBytes >= kShmMinTotalSegmentBytes;
+  if (useShm) {
+    shmSegments.reserve(wire.tensorData.size());
+    for (const auto& td : wire.tensorData) {
+      if (td.sizeInBytes() == 0) {
+        // Zero-byte segments cannot be mmapped; the receiver recreates
+        // them as empty tensors from the size alone.
+        shmRecords.append("- 0\n");
+      } else {
+        shmSegments.push_back(
+            createShmSegment(td.data(), td.sizeInBytes(), shmRecords));
+      }
+    }
+  }
+#endif
 
   std::vector<torch::Tensor> preamble = {torch::tensor(
       {(int64_t)pg_->getRank(),
-       (int64_t)serializedPayload.length(),
+       (int64_t)wire.header.length(),
        (int64_t)work.message_.type(),
-       (int64_t)work.message_.id()},
+       (int64_t)work.message_.id(),
+       useShm ? -numSegments : numSegments},
       {torch::kInt64})};
 
   // ProcessGroup is not thread-safe when sending with the same tag,
   // hence the lock
   std::vector<std::shared_ptr<c10d::ProcessGroup::Work>> pendingSends;
-  const auto dst = work.to_.id_;
   std::vector<torch::Tensor> payload = {torch::from_blob(
-      (void*)serializedPayload.c_str(),
-      serializedPayload.length(),
-      {torch::kChar})};
-  pendingSends.reserve(2);
+      (void*)wire.header.c_str(), wire.header.length(), {torch::kChar})};
+
+  std::vector<torch::Tensor> segmentSizes;
+  std::vector<std::vector<torch::Tensor>> segments;
+  std::vector<torch::Tensor> recordsLen;
+  std::vector<torch::Tensor> records;
+  if (useShm) {
+    recordsLen.push_back(
+        torch::tensor({(int64_t)shmRecords.length()}, {torch::kInt64}));
+    records.push_back(torch::from_blob(
+        (void*)shmRecords.c_str(), (int64_t)shmRecords.length(),
+        {torch::kChar}));
+  } else if (numSegments > 0) {
+    std::vector<int64_t> sizes;
+    sizes.reserve(wire.tensorData.size());
+    segments.reserve(wire.tensorData.size());
+    for (const auto& td : wire.tensorData) {
+      sizes.push_back((int64_t)td.sizeInBytes());
+      segments.push_back({torch::from_blob(
+          (void*)td.data(), (int64_t)td.sizeInBytes(), {torch::kChar})});
+    }
+    segmentSizes.push_back(torch::tensor(sizes, {torch::kInt64}));
+  }
+  pendingSends.reserve(4 + segments.size());
 
   sendCounts_.increment(dst);
 
@@ -387,10 +664,24 @@ void ProcessGroupAgent::handleSend(const SendWork& work) {
     std::lock_guard<std::mutex> guard(sendMutexes_[dst]);
     pendingSends.emplace_back(pg_->send(preamble, dst, dst /* channelTag */));
     pendingSends.emplace_back(pg_->send(payload, dst, dst /* channelTag */));
+    if (useShm) {
+      pendingSends.emplace_back(
+          pg_->send(recordsLen, dst, dst /* channelTag */));
+      pendingSends.emplace_back(pg_->send(records, dst, dst /* channelTag */));
+    } else if (numSegments > 0) {
+      pendingSends.emplace_back(
+          pg_->send(segmentSizes, dst, dst /* channelTag */));
+      for (auto& segment : segments) {
+        pendingSends.emplace_back(
+            pg_->send(segment, dst, dst /* channelTag */));
+      }
+    }
   }
   for (auto& pendingSend : pendingSends) {
     pendingSend->wait();
   }
+  // `shmSegments` is released here; the named segments stay available for
+  // the receiver until it maps and unlinks them.
 }
 
 void ProcessGroupAgent::enqueueSend(SendWork work) {
@@ -417,7 +708,10 @@ void ProcessGroupAgent::enqueueRecv(RecvWork work) {
   threadPool_.run(std::bind(
       [&](RecvWork& work) {
         torch::Tensor& payload = work.payload_;
-        auto data = wireDeserialize(payload.storage().data(), payload.numel());
+        auto data = wireDeserializeSegmented(
+            payload.storage().data(),
+            payload.numel(),
+            std::move(work.tensorSegments_));
         Message message(
             std::move(data.first),
             std::move(data.second),
@@ -572,8 +866,10 @@ void ProcessGroupAgent::listenLoop() {
 
 void ProcessGroupAgent::listenLoopInternal() {
   while (rpcRunning_.load()) {
-    // rank, tensor size, message type
-    std::vector<torch::Tensor> preamble = {torch::empty({4}, {torch::kInt64})};
+    // rank, header size, message type, id, number of tensor segments
+    // (negative when the segments come as shm records rather than inline,
+    // see Note [Same-host shm transport])
+    std::vector<torch::Tensor> preamble = {torch::empty({5}, {torch::kInt64})};
     auto work = pg_->recvAnysource(preamble, pg_->getRank());
     {
       std::lock_guard<std::mutex> guard(recvWorkMutex_);
@@ -590,12 +886,67 @@ void ProcessGroupAgent::listenLoopInternal() {
     auto size = preamble_items[1];
     MessageType type = MessageType(preamble_items[2]);
     int64_t id = preamble_items[3];
+    int64_t numSegments = preamble_items[4];
 
     std::vector<torch::Tensor> tensors = {torch::empty({size}, {torch::kChar})};
     pg_->recv(tensors, srcRank, pg_->getRank())->wait();
 
-    enqueueRecv(
-        RecvWork(allWorkerInfo_[srcRank], type, id, std::move(tensors[0])));
+    // Tensor data segments follow, received straight into freshly allocated
+    // buffers that the deserialized tensors later adopt as their storage.
+    std::vector<torch::Tensor> segments;
+    if (numSegments > 0) {
+      std::vector<torch::Tensor> segmentSizes = {
+          torch::empty({numSegments}, {torch::kInt64})};
+      pg_->recv(segmentSizes, srcRank, pg_->getRank())->wait();
+      const int64_t* sizesData =
+          segmentSizes.front().storage().data<int64_t>();
+      segments.reserve(numSegments);
+      for (int64_t i = 0; i < numSegments; ++i) {
+        std::vector<torch::Tensor> segment = {
+            torch::empty({sizesData[i]}, {torch::kChar})};
+        pg_->recv(segment, srcRank, pg_->getRank())->wait();
+        segments.push_back(std::move(segment.front()));
+      }
+    }
+#ifndef _WIN32
+    else if (numSegments < 0) {
+      // Same-host fast path: only the shm segment records crossed the
+      // wire. Map the segments here (not in the thread pool) so the names
+      // are unlinked promptly. See Note [Same-host shm transport].
+      std::vector<torch::Tensor> recordsLen = {
+          torch::empty({1}, {torch::kInt64})};
+      pg_->recv(recordsLen, srcRank, pg_->getRank())->wait();
+      const int64_t len = recordsLen.front().storage().data<int64_t>()[0];
+      std::vector<torch::Tensor> records = {
+          torch::empty({len}, {torch::kChar})};
+      pg_->recv(records, srcRank, pg_->getRank())->wait();
+
+      std::istringstream recordStream(std::string(
+          (const char*)records.front().storage().data<signed char>(), len));
+      segments.reserve(-numSegments);
+      for (int64_t i = 0; i < -numSegments; ++i) {
+        std::string filename;
+        int64_t nbytes = -1;
+        recordStream >> filename >> nbytes;
+        TORCH_CHECK(
+            !filename.empty() && nbytes >= 0,
+            "Malformed shm segment record from rank ",
+            srcRank);
+        if (nbytes == 0) {
+          segments.push_back(torch::empty({0}, {torch::kChar}));
+        } else {
+          segments.push_back(mapShmSegment(filename, nbytes));
+        }
+      }
+    }
+#endif
+
+    enqueueRecv(RecvWork(
+        allWorkerInfo_[srcRank],
+        type,
+        id,
+        std::move(tensors[0]),
+        std::move(segments)));
   }
 }
 
@@ -29,18 +29,27 @@ struct SendWork {
 
 // SendWork wraps a Message and RecvWork wraps a Tensor. The difference here is
 // to allow us to run serialization/deserialization in the worker threads.
+// `payload` holds the wire-sections header (payload bits and pickle
+// metadata), and `tensorSegments` holds one flat char tensor per serialized
+// tensor, received directly off the wire. See wireSerializeSegmented().
 struct RecvWork {
   RecvWork(
       const WorkerInfo& from,
       MessageType type,
       int64_t id,
-      torch::Tensor&& payload)
-      : from_(from), type_(type), id_(id), payload_(payload) {}
+      torch::Tensor&& payload,
+      std::vector<torch::Tensor>&& tensorSegments)
+      : from_(from),
+        type_(type),
+        id_(id),
+        payload_(payload),
+        tensorSegments_(tensorSegments) {}
 
   const WorkerInfo& from_;
   const MessageType type_;
   const int64_t id_;
   torch::Tensor payload_;
+  std::vector<torch::Tensor> tensorSegments_;
 };
 
 class ProcessGroupAgent : public RpcAgent {
@@ -130,6 +139,13 @@ class ProcessGroupAgent : public RpcAgent {
   };
 
   void collectNames();
+  // Probe which peers can map this process's shared-memory segments and
+  // record the result in sameHostPeers_. Runs once at construction; see
+  // Note [Same-host shm transport] in process_group_agent.cpp.
+  void detectSameHostPeers();
+  // Whether tensor payloads to `dst` can be passed by shared-memory handle
+  // instead of being copied through the ProcessGroup.
+  bool isSameHostPeer(worker_id_t dst) const;
   // put SendWork into a queue and notify the worker thread
   void enqueueSend(SendWork work);
   // handle a SendWork request. This serializes the payload inside the work
@@ -192,6 +208,9 @@ class ProcessGroupAgent : public RpcAgent {
   // worker name -> rank
   std::unordered_map<std::string, int> nameMap_;
   std::vector<WorkerInfo> allWorkerInfo_;
+  // sameHostPeers_[rank] is true when that peer proved at startup that it
+  // can map shared-memory segments created by this process.
+  std::vector<bool> sameHostPeers_;
   // record the number of messages sent to and received from each peer. The recv
   // counter is only marked after the message is processed. Join uses allgather
   // to collect all counts from all peers, uses these counters to detect global
@@ -23,13 +23,72 @@
 #include <torch/csrc/distributed/rpc/utils.h>
 #include <torch/csrc/jit/pybind_utils.h>
 
+#include <c10/core/thread_pool.h>
+
+#include <atomic>
+
 namespace torch {
 namespace distributed {
 namespace rpc {
 
 using namespace torch::distributed::autograd;
 
+namespace {
+
+// Python UDFs run on their own small pool, separate from the agent's
+// send/recv threads. A slow, GIL-bound Python handler otherwise occupies
+// an agent thread for its full duration and can starve TorchScript calls
+// queued behind it. The GIL still serializes the Python bytecode itself;
+// the separate lane only keeps that serialization from head-of-line
+// blocking script calls, and overlaps any GIL-releasing sections.
+constexpr int kNumPythonHandlerThreads = 4;
+
+c10::ThreadPool& pythonHandlerThreadPool() {
+  static c10::ThreadPool pool(kNumPythonHandlerThreads);
+  return pool;
+}
+
+// Runs task on the Python handler pool and returns a future that is
+// completed with the Message it produces (tagged with messageId), or with
+// the error it throws. The dist autograd context id is thread local, so
+// the caller's context, if any, is re-established on the pool thread to
+// keep nested rpc calls made from the handler in the right context.
+std::shared_ptr<FutureMessage> runOnPythonHandlerPool(
+    int64_t messageId,
+    std::function<Message()> task) {
+  auto responseFuture = std::make_shared<FutureMessage>();
+  auto& autogradContainer = DistAutogradContainer::getInstance();
+  const bool hasAutogradContext = autogradContainer.hasValidContext();
+  const int64_t autogradContextId = hasAutogradContext
+      ? autogradContainer.currentContext()->contextId()
+      : 0;
+  pythonHandlerThreadPool().run([messageId,
+                                 responseFuture,
+                                 hasAutogradContext,
+                                 autogradContextId,
+                                 task{std::move(task)}]() {
+    auto& container = DistAutogradContainer::getInstance();
+    if (hasAutogradContext) {
+      container.setCurrentContextId(autogradContextId);
+    }
+    try {
+      Message m = task();
+      m.setId(messageId);
+      responseFuture->markCompleted(std::move(m));
+    } catch (const std::exception& e) {
+      responseFuture->setError(e.what());
+    }
+    if (hasAutogradContext) {
+      container.clearCurrentContext();
+    }
+  });
+  return responseFuture;
+}
+
+} // namespace
+
 std::shared_ptr<FutureMessage> RequestCallbackImpl::processRpc(
+    const std::shared_ptr<RpcCommandBase>& rpcHolder,
     RpcCommandBase& rpc,
     MessageType messageType,
     int64_t messageId) const {
@@ -69,14 +128,17 @@ std::shared_ptr<FutureMessage> RequestCallbackImpl::processRpc(
       return wrap(std::move(ScriptResp(std::move(stack.front()))).toMessage());
     }
     case MessageType::PYTHON_CALL: {
-      auto& pyCall = static_cast<PythonCall&>(rpc);
-      std::vector<torch::Tensor> responseTensorTable;
-      auto payload = PythonRpcHandler::getInstance().generatePythonUDFResult(
-          pyCall.pickledPayload(), pyCall.tensors(), responseTensorTable);
-      return wrap(
-          std::move(
-              PythonResp(std::move(payload), std::move(responseTensorTable)))
-              .toMessage());
+      // The UDF runs on the Python handler lane, not this agent thread;
+      // rpcHolder keeps the deserialized command alive until it finishes.
+      return runOnPythonHandlerPool(messageId, [rpcHolder, rpcPtr = &rpc]() {
+        auto& pyCall = static_cast<PythonCall&>(*rpcPtr);
+        std::vector<torch::Tensor> responseTensorTable;
+        auto payload = PythonRpcHandler::getInstance().generatePythonUDFResult(
+            pyCall.pickledPayload(), pyCall.tensors(), responseTensorTable);
+        return std::move(
+                   PythonResp(std::move(payload), std::move(responseTensorTable)))
+            .toMessage();
+      });
     }
     case MessageType::SCRIPT_REMOTE_CALL: {
       auto& scriptRemoteCall = static_cast<ScriptRemoteCall&>(rpc);
@@ -134,32 +196,35 @@ std::shared_ptr<FutureMessage> RequestCallbackImpl::processRpc(
       return wrap(RemoteRet(rrefId, forkId).toMessage());
     }
     case MessageType::PYTHON_REMOTE_CALL: {
-      auto& prc = static_cast<PythonRemoteCall&>(rpc);
-
-      auto rrefId = RRefId::fromIValue(prc.retRRefId());
-      auto forkId = ForkId::fromIValue(prc.retForkId());
-      auto& ctx = RRefContext::getInstance();
-
-      auto ownerRRef = ctx.getOrCreateOwnerRRef(rrefId, PyObjectType::get());
-
-      IValue py_ivalue = jit::toIValue(
-          PythonRpcHandler::getInstance().runPythonUDF(prc.serializedPyObj()),
-          PyObjectType::get());
-
-      ownerRRef->setValue(std::move(py_ivalue));
-
-      if (rrefId != forkId) {
-        // Caller is a user and callee is the owner, add fork
-        //
-        // NB: rrefId == forkId is true if and only if calling remote to self.
-        // In that case both the caller and the callee will access the
-        // OwnerRRef. Hence, on the callee side (here), it should not call
-        // addForkOfOwner as it is not a fork. To allow callee to distinguish
-        // when this request is sent to self, the caller will set forkId using
-        // rrefId (OwnerRRef does not have a forkId anyway).
-        ctx.addForkOfOwner(rrefId, forkId);
-      }
-      return wrap(RemoteRet(rrefId, forkId).toMessage());
+      // As with PYTHON_CALL, defer the UDF to the Python handler lane.
+      return runOnPythonHandlerPool(messageId, [rpcHolder, rpcPtr = &rpc]() {
+        auto& prc = static_cast<PythonRemoteCall&>(*rpcPtr);
+
+        auto rrefId = RRefId::fromIValue(prc.retRRefId());
+        auto forkId = ForkId::fromIValue(prc.retForkId());
+        auto& ctx = RRefContext::getInstance();
+
+        auto ownerRRef = ctx.getOrCreateOwnerRRef(rrefId, PyObjectType::get());
+
+        IValue py_ivalue = jit::toIValue(
+            PythonRpcHandler::getInstance().runPythonUDF(prc.serializedPyObj()),
+            PyObjectType::get());
+
+        ownerRRef->setValue(std::move(py_ivalue));
+
+        if (rrefId != forkId) {
+          // Caller is a user and callee is the owner, add fork
+          //
+          // NB: rrefId == forkId is true if and only if calling remote to self.
+          // In that case both the caller and the callee will access the
+          // OwnerRRef. Hence, on the callee side (here), it should not call
+          // addForkOfOwner as it is not a fork. To allow callee to distinguish
+          // when this request is sent to self, the caller will set forkId using
+          // rrefId (OwnerRRef does not have a forkId anyway).
+          ctx.addForkOfOwner(rrefId, forkId);
+        }
+        return RemoteRet(rrefId, forkId).toMessage();
+      });
     }
     case MessageType::SCRIPT_RREF_FETCH_CALL: {
       auto& srf = static_cast<ScriptRRefFetchCall&>(rpc);
@@ -187,6 +252,55 @@ std::shared_ptr<FutureMessage> RequestCallbackImpl::processRpc(
           });
       return responseFuture;
     }
+    case MessageType::MULTI_RREF_FETCH_CALL: {
+      auto& mrf = static_cast<MultiRRefFetchCall&>(rpc);
+      auto& ctx = RRefContext::getInstance();
+      std::vector<c10::intrusive_ptr<OwnerRRef>> rrefs;
+      rrefs.reserve(mrf.rrefIds().size());
+      bool allReady = true;
+      for (const auto& rrefId : mrf.rrefIds()) {
+        auto rref = ctx.getOwnerRRef(rrefId);
+        allReady = allReady && rref->hasValue();
+        rrefs.push_back(std::move(rref));
+      }
+      auto collectValues = [rrefs]() {
+        std::vector<at::IValue> values;
+        values.reserve(rrefs.size());
+        for (const auto& rref : rrefs) {
+          values.push_back(rref->getValue());
+        }
+        return MultiRRefFetchRet(std::move(values)).toMessage();
+      };
+      if (allReady) { // optional fast-path
+        return wrap(collectValues());
+      }
+
+      // Our response is satisfied when the last pending value is set.
+      auto responseFuture = std::make_shared<FutureMessage>();
+      auto remaining = std::make_shared<std::atomic<int64_t>>(rrefs.size());
+      auto errored = std::make_shared<std::atomic<bool>>(false);
+      for (const auto& rref : rrefs) {
+        rref->getFuture()->addCallback(
+            [responseFuture, messageId, remaining, errored, collectValues](
+                const rpc::Message& /* unused */,
+                const c10::optional<utils::FutureError>& error) {
+              if (error) {
+                // only propagate the first error; later value callbacks will
+                // never bring remaining to zero
+                if (!errored->exchange(true)) {
+                  responseFuture->setError(error->what());
+                }
+                return;
+              }
+              if (--(*remaining) == 0 && !errored->load()) {
+                Message m = collectValues();
+                m.setId(messageId);
+                responseFuture->markCompleted(std::move(m));
+              }
+            });
+      }
+      return responseFuture;
+    }
     case MessageType::PYTHON_RREF_FETCH_CALL: {
       auto& prf = static_cast<PythonRRefFetchCall&>(rpc);
       auto& ctx = RRefContext::getInstance();
@@ -276,7 +390,7 @@ std::shared_ptr<FutureMessage> RequestCallbackImpl::processRpc(
       // Kick off processing for the nested future and get a Future<T> to the
       // result.
       auto wrappedRpcResponseFuture = processRpc(
-          rpcWithAutograd.wrappedRpc(), wrappedMessageType, messageId);
+          rpcHolder, rpcWithAutograd.wrappedRpc(), wrappedMessageType, messageId);
 
       // Make an overall future for the wrapped response.
       auto responseFuture = std::make_shared<rpc::FutureMessage>();
@@ -359,8 +473,10 @@ std::shared_ptr<FutureMessage> RequestCallbackImpl::processRpc(
 
 std::shared_ptr<FutureMessage> RequestCallbackImpl::processMessage(
     Message& request) const {
-  std::unique_ptr<RpcCommandBase> rpc = deserializeRequest(request);
-  return processRpc(*rpc, request.type(), request.id());
+  // Held as a shared_ptr so work deferred to the Python handler pool can
+  // keep the command alive past this call.
+  std::shared_ptr<RpcCommandBase> rpc = deserializeRequest(request);
+  return processRpc(rpc, *rpc, request.type(), request.id());
 }
 
 } // namespace rpc
@@ -14,7 +14,12 @@ class TORCH_API RequestCallbackImpl : public RequestCallback {
       Message& request) const override;
 
  private:
+  // rpcHolder owns the deserialized command; rpc is the command to process,
+  // which is either *rpcHolder or a wrapped rpc nested inside it. Passing
+  // the holder separately lets cases that defer work to the Python handler
+  // pool keep the command alive until the deferred task completes.
   std::shared_ptr<FutureMessage> processRpc(
+      const std::shared_ptr<RpcCommandBase>& rpcHolder,
       RpcCommandBase& rpc,
       MessageType messageType,
       int64_t messageId) const;
@@ -1,7 +1,10 @@
 #include <torch/csrc/distributed/rpc/rref_context.h>
+#include <torch/csrc/distributed/autograd/utils.h>
 #include <torch/csrc/distributed/rpc/rref_proto.h>
+#include <torch/csrc/distributed/rpc/utils.h>
 
 #include <sstream>
+#include <unordered_map>
 
 namespace torch {
 namespace distributed {
@@ -247,6 +250,70 @@ c10::intrusive_ptr<OwnerRRef> RRefContext::getOwnerRRef(const RRefId& rrefId) {
   }
 }
 
+std::vector<IValue> RRefContext::toHereAll(
+    const std::vector<c10::intrusive_ptr<UserRRef>>& rrefs) {
+  std::vector<IValue> results(rrefs.size());
+
+  // py::object RRefs cannot share a batched response; fetch them
+  // concurrently through toHereAsync. IValue RRefs are grouped by owner.
+  std::vector<std::pair<size_t, std::shared_ptr<FutureMessage>>> singleFetches;
+  std::unordered_map<worker_id_t, std::vector<size_t>> scriptByOwner;
+  for (size_t i = 0; i < rrefs.size(); ++i) {
+    if (rrefs[i]->isPyObj()) {
+      singleFetches.emplace_back(i, rrefs[i]->toHereAsync());
+    } else {
+      scriptByOwner[rrefs[i]->owner()].push_back(i);
+    }
+  }
+
+  // one MULTI_RREF_FETCH_CALL per owner
+  std::vector<std::pair<const std::vector<size_t>*, std::shared_ptr<FutureMessage>>>
+      batchFetches;
+  batchFetches.reserve(scriptByOwner.size());
+  for (const auto& entry : scriptByOwner) {
+    std::vector<RRefId> rrefIds;
+    rrefIds.reserve(entry.second.size());
+    for (size_t idx : entry.second) {
+      rrefIds.push_back(rrefs[idx]->rrefId());
+    }
+    // as with toHere, always carry the autograd context id because the
+    // response will potentially contain tensors
+    auto futureResponse = autograd::sendMessageWithAutograd(
+        *agent_,
+        agent_->getWorkerInfo(entry.first),
+        MultiRRefFetchCall(getWorkerId(), std::move(rrefIds)).toMessage(),
+        true /* forceGradRecording */);
+    batchFetches.emplace_back(&entry.second, std::move(futureResponse));
+  }
+
+  for (auto& fetch : batchFetches) {
+    const Message& message = fetch.second->wait();
+    MessageType msgType = message.type();
+    auto response = deserializeResponse(message, msgType);
+    TORCH_INTERNAL_ASSERT(
+        msgType == MessageType::MULTI_RREF_FETCH_RET,
+        "Message type should be MULTI_RREF_FETCH_RET");
+    auto& fetchRet = static_cast<MultiRRefFetchRet&>(*response);
+    const auto& values = fetchRet.values();
+    const auto& indices = *fetch.first;
+    TORCH_INTERNAL_ASSERT(
+        values.size() == indices.size(),
+        "MultiRRefFetchRet carries ",
+        values.size(),
+        " values, expected ",
+        indices.size());
+    for (size_t j = 0; j < indices.size(); ++j) {
+      results[indices[j]] = values[j];
+    }
+  }
+
+  for (auto& fetch : singleFetches) {
+    results[fetch.first] = rrefs[fetch.first]->fromFetchRet(fetch.second->wait());
+  }
+
+  return results;
+}
+
 RRefForkData RRefContext::prepareChildFork(const c10::intrusive_ptr<RRef>& rref) {
   auto rrefForkData = rref->fork();
   if (rref->isOwner()) {
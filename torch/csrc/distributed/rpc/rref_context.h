@@ -89,6 +89,15 @@ class TORCH_API RRefContext {
 
   c10::intrusive_ptr<OwnerRRef> getOwnerRRef(const RRefId& rrefId);
 
+  // Fetch the values of multiple UserRRefs, coalescing all IValue RRefs that
+  // live on the same owner into a single MULTI_RREF_FETCH_CALL RPC instead
+  // of one blocking round trip each. py::object RRefs cannot be batched (see
+  // MultiRRefFetchCall) and are fetched concurrently with toHereAsync.
+  // Returns the values in the order of ``rrefs``; blocks until all fetches
+  // complete.
+  std::vector<IValue> toHereAll(
+      const std::vector<c10::intrusive_ptr<UserRRef>>& rrefs);
+
   // Adding the RRefId of an OwnerRRef into the forks_ map. This is useful when
   // making a remote call to self, which as for now, still goes through serde
   // and invokes request callback. In this case, the OwnerRRef has already been
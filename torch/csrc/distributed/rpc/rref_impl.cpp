@@ -97,6 +97,11 @@ const ForkId& UserRRef::forkId() const {
 }
 
 IValue UserRRef::toHere() {
+  auto futureResponse = toHereAsync();
+  return fromFetchRet(futureResponse->wait());
+}
+
+std::shared_ptr<FutureMessage> UserRRef::toHereAsync() {
   auto agent = RpcAgent::getCurrentRpcAgent();
 
   // ScriptRRefFetchCall message always carries autograd context id even if
@@ -110,13 +115,14 @@ IValue UserRRef::toHere() {
     msgToSend = ScriptRRefFetchCall(ownerId_, rrefId()).toMessage();
   }
 
-  auto futureResponse = autograd::sendMessageWithAutograd(
+  return autograd::sendMessageWithAutograd(
       *agent,
       agent->getWorkerInfo(ownerId_),
       std::move(msgToSend),
       true /* forceGradRecording */);
+}
 
-  const Message& message = futureResponse->wait();
+IValue UserRRef::fromFetchRet(const Message& message) const {
   MessageType msgType = message.type();
   auto response = deserializeResponse(message, msgType);
   TORCH_INTERNAL_ASSERT(
@@ -253,6 +253,17 @@ class TORCH_API UserRRef final : public RRef {
   // yet, this call will block.
   IValue toHere();
 
+  // Sends the fetch request to the owner and returns immediately with a
+  // Future of the response message. Use ``fromFetchRet`` on the completed
+  // message to extract the value; ``toHere`` is equivalent to waiting on
+  // this future. This allows fetching many RRefs concurrently instead of
+  // paying one blocking round trip each.
+  std::shared_ptr<FutureMessage> toHereAsync();
+
+  // Extracts the fetched value from a completed response message produced
+  // by ``toHereAsync``.
+  IValue fromFetchRet(const Message& message) const;
+
   // Upon destruction, this ``UserRRef`` will tell the owner to deref.
   ~UserRRef() override;
 
@@ -125,6 +125,39 @@ std::unique_ptr<PythonRRefFetchCall> PythonRRefFetchCall::fromMessage(
       worker_id_t(id), RRefId::fromIValue(values[0]));
 }
 
+const std::vector<RRefId>& MultiRRefFetchCall::rrefIds() const {
+  return rrefIds_;
+}
+
+Message MultiRRefFetchCall::toMessage() && {
+  std::vector<at::IValue> ivalues;
+  ivalues.reserve(rrefIds_.size() + 1);
+  for (const auto& rrefId : rrefIds_) {
+    ivalues.emplace_back(rrefId.toIValue());
+  }
+  ivalues.emplace_back(fromWorkerId_);
+  return fromIValues(std::move(ivalues), MessageType::MULTI_RREF_FETCH_CALL);
+}
+
+std::unique_ptr<MultiRRefFetchCall> MultiRRefFetchCall::fromMessage(
+    const Message& message) {
+  auto values = toIValues(message, MessageType::MULTI_RREF_FETCH_CALL);
+  TORCH_INTERNAL_ASSERT(
+      !values.empty(), "MultiRRefFetchCall expects at least 1 IValue");
+  auto id = values.back().toInt();
+  TORCH_INTERNAL_ASSERT(
+      id >= std::numeric_limits<worker_id_t>::min() &&
+          id <= std::numeric_limits<worker_id_t>::max(),
+      "MultiRRefFetchCall fromWorkerId exceeds worker_id_t limit.")
+  std::vector<RRefId> rrefIds;
+  rrefIds.reserve(values.size() - 1);
+  for (size_t i = 0; i < values.size() - 1; ++i) {
+    rrefIds.emplace_back(RRefId::fromIValue(values[i]));
+  }
+  return std::make_unique<MultiRRefFetchCall>(
+      worker_id_t(id), std::move(rrefIds));
+}
+
 const std::vector<at::IValue>& RRefFetchRet::values() {
   return values_;
 }
@@ -154,6 +187,12 @@ std::unique_ptr<PythonRRefFetchRet> PythonRRefFetchRet::fromMessage(
       toIValues(message, MessageType::PYTHON_RREF_FETCH_RET));
 }
 
+std::unique_ptr<MultiRRefFetchRet> MultiRRefFetchRet::fromMessage(
+    const Message& message) {
+  return std::make_unique<MultiRRefFetchRet>(
+      toIValues(message, MessageType::MULTI_RREF_FETCH_RET));
+}
+
 std::unique_ptr<RRefUserDelete> RRefUserDelete::fromMessage(
     const Message& message) {
   auto pair =
@@ -113,6 +113,40 @@ class TORCH_API PythonRRefFetchRet final : public RRefFetchRet {
       const Message& message);
 };
 
+// Fetches the values of several OwnerRRefs on the same owner in a single
+// round trip. Only IValue RRefs can be batched; py::object RRefs need
+// per-object serialization and keep using PythonRRefFetchCall.
+class TORCH_API MultiRRefFetchCall final : public RpcCommandBase {
+ public:
+  MultiRRefFetchCall(worker_id_t fromWorkerId, std::vector<RRefId> rrefIds)
+      : fromWorkerId_(fromWorkerId), rrefIds_(std::move(rrefIds)) {}
+
+  inline worker_id_t fromWorkerId() const {
+    return fromWorkerId_;
+  }
+
+  const std::vector<RRefId>& rrefIds() const;
+
+  Message toMessage() && override;
+  static std::unique_ptr<MultiRRefFetchCall> fromMessage(
+      const Message& message);
+
+ private:
+  const worker_id_t fromWorkerId_;
+  const std::vector<RRefId> rrefIds_;
+};
+
+// Carries one IValue per requested RRef, in the order of the corresponding
+// MultiRRefFetchCall.
+class TORCH_API MultiRRefFetchRet final : public RRefFetchRet {
+ public:
+  explicit MultiRRefFetchRet(std::vector<at::IValue> values)
+      : RRefFetchRet(std::move(values), MessageType::MULTI_RREF_FETCH_RET) {}
+
+  static std::unique_ptr<MultiRRefFetchRet> fromMessage(
+      const Message& message);
+};
+
 // UserRRef (regardless it's the creator or not) uses this message to notiify
 // OwnerRRef on delete.
 class TORCH_API RRefUserDelete final : public ForkMessageBase {
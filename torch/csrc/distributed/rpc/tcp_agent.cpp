@@ -0,0 +1,884 @@
+#ifdef __linux__
+
+#include <torch/csrc/distributed/rpc/tcp_agent.h>
+
+#include <c10/util/C++17.h>
+#include <torch/csrc/distributed/rpc/request_callback_impl.h>
+
+#include <Python.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <sstream>
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+namespace {
+
+constexpr int kListenBacklog = 128;
+constexpr int kMaxEpollEvents = 64;
+// Granularity of the store-based spin waits in barriers and count exchanges.
+constexpr std::chrono::milliseconds kStorePollInterval(1);
+
+const std::string kAddrKeyPrefix = "tcp_agent/addr/";
+const std::string kBarrierKeyPrefix = "tcp_agent/barrier/";
+const std::string kCountsKeyPrefix = "tcp_agent/counts/";
+
+void setNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  TORCH_CHECK(
+      flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0,
+      "Failed to make socket non-blocking: ",
+      strerror(errno));
+}
+
+void setNoDelay(int fd) {
+  int on = 1;
+  // Latency matters more than packet efficiency for RPC; never batch small
+  // writes behind Nagle.
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+std::vector<uint8_t> toStoreValue(const std::string& str) {
+  return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+std::string fromStoreValue(const std::vector<uint8_t>& value) {
+  return std::string(value.begin(), value.end());
+}
+
+} // namespace
+
+//////////////////////////  MessageCounter  /////////////////////////////////
+
+TcpRpcAgent::MessageCounter::MessageCounter(int worldSize)
+    : counters_(worldSize) {}
+
+void TcpRpcAgent::MessageCounter::increment(int dst) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  ++counters_[dst];
+}
+
+std::vector<int64_t> TcpRpcAgent::MessageCounter::snapshot() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return counters_;
+}
+
+/////////////////////////  OutgoingMessage  /////////////////////////////////
+
+TcpRpcAgent::OutgoingMessage::OutgoingMessage(Message&& m)
+    : message(std::move(m)) {
+  wire = wireSerializeSegmented(message.payload(), message.tensors());
+  frameInts.reserve(kFrameInts + wire.tensorData.size());
+  frameInts.push_back(0); // srcRank, filled in by send()
+  frameInts.push_back((int64_t)message.type());
+  frameInts.push_back(message.id());
+  frameInts.push_back((int64_t)wire.header.size());
+  frameInts.push_back((int64_t)wire.tensorData.size());
+  totalBytes = wire.header.size();
+  for (const auto& td : wire.tensorData) {
+    frameInts.push_back((int64_t)td.sizeInBytes());
+    totalBytes += td.sizeInBytes();
+  }
+  totalBytes += frameInts.size() * sizeof(int64_t);
+}
+
+void TcpRpcAgent::IncomingFrame::reset() {
+  stage = Stage::FIXED;
+  fixed.clear();
+  segmentSizes.clear();
+  header.clear();
+  segments.clear();
+  bytesRead = 0;
+  segmentIdx = 0;
+}
+
+//////////////////////////  TcpRpcAgent  ////////////////////////////////////
+
+TcpRpcAgent::TcpRpcAgent(
+    std::string workerName,
+    worker_id_t rank,
+    int worldSize,
+    std::shared_ptr<::c10d::Store> store,
+    int numWorkerThreads,
+    std::chrono::milliseconds rpcTimeout)
+    : RpcAgent(
+          WorkerInfo(std::move(workerName), rank),
+          std::make_unique<RequestCallbackImpl>(),
+          rpcTimeout),
+      rank_(rank),
+      worldSize_(worldSize),
+      store_(std::move(store)),
+      connections_(worldSize),
+      threadPool_(numWorkerThreads),
+      sendCounts_(worldSize),
+      recvCounts_(worldSize) {
+  TORCH_CHECK(
+      worldSize_ >= 2,
+      "TcpRpcAgent requires world_size to be at least 2, but got ",
+      worldSize_);
+
+  // Create the listen socket up front so that the address can be published
+  // before start(); connections dialed before the IO thread runs simply wait
+  // in the accept backlog.
+  listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+  TORCH_CHECK(listenFd_ >= 0, "Failed to create socket: ", strerror(errno));
+  int on = 1;
+  setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = 0; // pick an ephemeral port
+  TORCH_CHECK(
+      ::bind(listenFd_, (struct sockaddr*)&addr, sizeof(addr)) == 0,
+      "Failed to bind socket: ",
+      strerror(errno));
+  TORCH_CHECK(
+      ::listen(listenFd_, kListenBacklog) == 0,
+      "Failed to listen: ",
+      strerror(errno));
+  setNonBlocking(listenFd_);
+
+  collectWorkers();
+}
+
+TcpRpcAgent::~TcpRpcAgent() {
+  if (rpcRunning_) {
+    shutdown();
+  }
+  if (listenFd_ >= 0) {
+    ::close(listenFd_);
+    listenFd_ = -1;
+  }
+}
+
+void TcpRpcAgent::collectWorkers() {
+  socklen_t addrLen;
+  struct sockaddr_in addr;
+  addrLen = sizeof(addr);
+  TORCH_CHECK(
+      ::getsockname(listenFd_, (struct sockaddr*)&addr, &addrLen) == 0,
+      "Failed to read listen port: ",
+      strerror(errno));
+  const int port = ntohs(addr.sin_port);
+
+  char hostname[HOST_NAME_MAX + 1];
+  TORCH_CHECK(
+      ::gethostname(hostname, sizeof(hostname)) == 0,
+      "Failed to read hostname: ",
+      strerror(errno));
+  hostname[HOST_NAME_MAX] = '\0';
+
+  // Publish "hostname:port/name" and resolve every peer's record. The store
+  // get() blocks until the peer has published, so this doubles as the
+  // startup rendezvous.
+  store_->set(
+      kAddrKeyPrefix + c10::to_string(rank_),
+      toStoreValue(
+          std::string(hostname) + ":" + c10::to_string(port) + "/" +
+          workerInfo_.name_));
+
+  peerAddrs_.resize(worldSize_);
+  allWorkerInfo_.reserve(worldSize_);
+  for (int rank = 0; rank < worldSize_; ++rank) {
+    std::string record =
+        fromStoreValue(store_->get(kAddrKeyPrefix + c10::to_string(rank)));
+    auto sep = record.rfind('/');
+    TORCH_CHECK(
+        sep != std::string::npos, "Malformed worker record ", record);
+    std::string peerName = record.substr(sep + 1);
+    peerAddrs_[rank] = record.substr(0, sep);
+
+    TORCH_CHECK(
+        nameMap_.find(peerName) == nameMap_.end(),
+        "RpcAgent name ",
+        peerName,
+        " is not unique.");
+    nameMap_[peerName] = rank;
+    allWorkerInfo_.emplace_back(std::move(peerName), rank);
+  }
+
+  auto workerRankIter = nameMap_.find(workerInfo_.name_);
+  TORCH_CHECK(
+      workerRankIter != nameMap_.end() && workerRankIter->second == rank_,
+      "Worker name ",
+      workerInfo_.name_,
+      " does not resolve to rank ",
+      rank_);
+}
+
+const WorkerInfo& TcpRpcAgent::getWorkerInfo(
+    const std::string& workerName) const {
+  const auto idIter = nameMap_.find(workerName);
+  TORCH_CHECK(
+      idIter != nameMap_.end(), "Unknown destination worker ", workerName);
+  return allWorkerInfo_[idIter->second];
+}
+
+const WorkerInfo& TcpRpcAgent::getWorkerInfo(worker_id_t id) const {
+  return allWorkerInfo_[id];
+}
+
+std::vector<WorkerInfo> TcpRpcAgent::getWorkerInfos() const {
+  return allWorkerInfo_;
+}
+
+void TcpRpcAgent::start() {
+  epollFd_ = ::epoll_create1(0);
+  TORCH_CHECK(epollFd_ >= 0, "Failed to create epoll: ", strerror(errno));
+  wakeFd_ = ::eventfd(0, EFD_NONBLOCK);
+  TORCH_CHECK(wakeFd_ >= 0, "Failed to create eventfd: ", strerror(errno));
+
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = listenFd_;
+  TORCH_CHECK(
+      ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, listenFd_, &ev) == 0,
+      "Failed to register listen socket: ",
+      strerror(errno));
+  ev.data.fd = wakeFd_;
+  TORCH_CHECK(
+      ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &ev) == 0,
+      "Failed to register wakeup eventfd: ",
+      strerror(errno));
+
+  rpcRunning_.store(true);
+  ioThread_ = std::thread(&TcpRpcAgent::ioLoop, this);
+  timeoutThread_ = std::thread(&TcpRpcAgent::pollTimedOutRPCs, this);
+}
+
+void TcpRpcAgent::shutdown() {
+  LOG(INFO) << "Shutting down TcpRpcAgent on rank " << rank_ << ".";
+  if (!rpcRunning_.exchange(false)) {
+    return;
+  }
+  wakeIoThread();
+  ioThread_.join();
+  futureCV_.notify_all();
+  timeoutThread_.join();
+  threadPool_.waitWorkComplete();
+
+  {
+    std::lock_guard<std::mutex> guard(sendMutex_);
+    for (auto& conn : connections_) {
+      if (conn.fd >= 0) {
+        ::close(conn.fd);
+        conn.fd = -1;
+      }
+      conn.sendQueue.clear();
+    }
+  }
+  for (auto& entry : incoming_) {
+    ::close(entry.first);
+  }
+  incoming_.clear();
+  ::close(wakeFd_);
+  wakeFd_ = -1;
+  ::close(epollFd_);
+  epollFd_ = -1;
+}
+
+void TcpRpcAgent::wakeIoThread() {
+  uint64_t one = 1;
+  if (::write(wakeFd_, &one, sizeof(one)) < 0) {
+    // EAGAIN means the counter is already non-zero and the IO thread will
+    // wake anyway.
+  }
+}
+
+std::shared_ptr<FutureMessage> TcpRpcAgent::send(
+    const WorkerInfo& to,
+    Message&& message) {
+  TORCH_CHECK(rpcRunning_.load(), "TcpRpcAgent hasn't started.")
+  TORCH_CHECK(
+      to.id_ < (worker_id_t)worldSize_,
+      "Destination rank is out of bound, got ",
+      to.id_,
+      ", but world size is ",
+      worldSize_);
+
+  auto requestId = nextId();
+  auto future = std::make_shared<FutureMessage>();
+  if (message.isRequest()) {
+    auto timeout = rpcTimeout_.load();
+    steady_clock_time_point endTime = timeout.count() == 0
+        ? std::chrono::time_point<std::chrono::steady_clock>::max()
+        : std::chrono::steady_clock::now() + timeout;
+    {
+      std::lock_guard<std::mutex> lock{futureMutex_};
+      futures_.emplace(requestId, FutureInfo{future, endTime, to.id_});
+    }
+    message.setId(requestId);
+  } else {
+    future->markCompleted(Message());
+  }
+
+  sendCounts_.increment(to.id_);
+
+  // Loopback messages skip the wire entirely.
+  if (to.id_ == rank_) {
+    threadPool_.run(std::bind(
+        [this](Message& message) {
+          handleMessage(std::move(message), allWorkerInfo_[rank_]);
+        },
+        std::move(message)));
+    return future;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(sendMutex_);
+    auto& conn = connectionTo(to.id_);
+    auto out = std::make_unique<OutgoingMessage>(std::move(message));
+    out->frameInts[0] = rank_;
+    conn.sendQueue.push_back(std::move(out));
+  }
+  // The IO thread flushes the queue; sends to the same peer are written
+  // back-to-back without waiting for responses in between.
+  wakeIoThread();
+  return future;
+}
+
+TcpRpcAgent::PeerConnection& TcpRpcAgent::connectionTo(worker_id_t dst) {
+  auto& conn = connections_[dst];
+  if (conn.fd >= 0) {
+    return conn;
+  }
+
+  const auto& addr = peerAddrs_[dst];
+  auto sep = addr.rfind(':');
+  TORCH_CHECK(sep != std::string::npos, "Malformed peer address ", addr);
+  const std::string host = addr.substr(0, sep);
+  const std::string port = addr.substr(sep + 1);
+
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo* res = nullptr;
+  int rv = ::getaddrinfo(host.c_str(), port.c_str(), &hints, &res);
+  TORCH_CHECK(
+      rv == 0, "Failed to resolve peer ", addr, ": ", gai_strerror(rv));
+
+  int fd = -1;
+  for (struct addrinfo* ai = res; ai != nullptr; ai = ai->ai_next) {
+    fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+      break;
+    }
+    ::close(fd);
+    fd = -1;
+  }
+  ::freeaddrinfo(res);
+  TORCH_CHECK(fd >= 0, "Failed to connect to peer ", addr);
+
+  setNoDelay(fd);
+  setNonBlocking(fd);
+
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  // Outbound sockets are write-only; EPOLLRDHUP detects peer shutdown and
+  // EPOLLOUT is armed only while the queue has unflushed bytes.
+  ev.events = EPOLLRDHUP;
+  ev.data.fd = fd;
+  TORCH_CHECK(
+      ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) == 0,
+      "Failed to register peer socket: ",
+      strerror(errno));
+
+  conn.fd = fd;
+  return conn;
+}
+
+bool TcpRpcAgent::writePending(PeerConnection& conn) {
+  while (!conn.sendQueue.empty()) {
+    auto& out = *conn.sendQueue.front();
+
+    // Gather whatever remains of the front message into one writev() call:
+    // frame ints, wire header, then each tensor segment directly from its
+    // tensor storage.
+    std::vector<struct iovec> iov;
+    size_t skip = out.bytesWritten;
+    auto addPart = [&](const void* base, size_t len) {
+      if (skip >= len) {
+        skip -= len;
+        return;
+      }
+      iov.push_back(
+          {const_cast<char*>(static_cast<const char*>(base)) + skip,
+           len - skip});
+      skip = 0;
+    };
+    addPart(out.frameInts.data(), out.frameInts.size() * sizeof(int64_t));
+    addPart(out.wire.header.data(), out.wire.header.size());
+    for (const auto& td : out.wire.tensorData) {
+      addPart(td.data(), td.sizeInBytes());
+    }
+
+    ssize_t n = ::writev(
+        conn.fd, iov.data(), (int)std::min<size_t>(iov.size(), IOV_MAX));
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return true;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      failConnection(conn, strerror(errno));
+      return false;
+    }
+    out.bytesWritten += n;
+    if (out.bytesWritten == out.totalBytes) {
+      conn.sendQueue.pop_front();
+    }
+  }
+  return false;
+}
+
+void TcpRpcAgent::failConnection(
+    PeerConnection& conn,
+    const std::string& reason) {
+  LOG(ERROR) << "TcpRpcAgent connection failed: " << reason;
+  for (auto& out : conn.sendQueue) {
+    if (out->message.isRequest()) {
+      markFutureWithError(
+          out->message.id(),
+          "Connection to peer failed while sending RPC: " + reason);
+    }
+  }
+  conn.sendQueue.clear();
+  if (conn.fd >= 0) {
+    ::close(conn.fd); // implicitly removes the fd from epoll
+    conn.fd = -1;
+  }
+  conn.epollOutArmed = false;
+}
+
+void TcpRpcAgent::markFutureWithError(int64_t id, std::string errorMsg) {
+  std::shared_ptr<FutureMessage> fm = nullptr;
+  {
+    std::lock_guard<std::mutex> lock{futureMutex_};
+    const auto& futureIt = futures_.find(id);
+    if (futureIt == futures_.end()) {
+      return;
+    }
+    fm = futureIt->second.future_;
+    futures_.erase(id);
+  }
+  fm->setError(std::move(errorMsg));
+  futureCV_.notify_all();
+}
+
+void TcpRpcAgent::ioLoop() {
+  std::vector<struct epoll_event> events(kMaxEpollEvents);
+  while (rpcRunning_.load()) {
+    int n = ::epoll_wait(epollFd_, events.data(), kMaxEpollEvents, -1);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG(ERROR) << "TcpRpcAgent epoll_wait failed: " << strerror(errno);
+      return;
+    }
+    for (int i = 0; i < n; ++i) {
+      const int fd = events[i].data.fd;
+      if (fd == wakeFd_) {
+        uint64_t buf;
+        while (::read(wakeFd_, &buf, sizeof(buf)) > 0) {
+        }
+        if (!rpcRunning_.load()) {
+          return;
+        }
+        // New messages may have been enqueued on any peer; flush them.
+        std::lock_guard<std::mutex> guard(sendMutex_);
+        for (auto& conn : connections_) {
+          if (conn.fd < 0 || conn.sendQueue.empty()) {
+            continue;
+          }
+          const bool pending = writePending(conn);
+          if (pending != conn.epollOutArmed && conn.fd >= 0) {
+            struct epoll_event ev;
+            memset(&ev, 0, sizeof(ev));
+            ev.events = EPOLLRDHUP | (pending ? EPOLLOUT : 0);
+            ev.data.fd = conn.fd;
+            ::epoll_ctl(epollFd_, EPOLL_CTL_MOD, conn.fd, &ev);
+            conn.epollOutArmed = pending;
+          }
+        }
+      } else if (fd == listenFd_) {
+        while (true) {
+          int peerFd = ::accept(listenFd_, nullptr, nullptr);
+          if (peerFd < 0) {
+            break; // EAGAIN: backlog drained
+          }
+          setNoDelay(peerFd);
+          setNonBlocking(peerFd);
+          struct epoll_event ev;
+          memset(&ev, 0, sizeof(ev));
+          ev.events = EPOLLIN | EPOLLRDHUP;
+          ev.data.fd = peerFd;
+          ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, peerFd, &ev);
+          incoming_[peerFd]; // default-construct the parser state
+        }
+      } else if (incoming_.count(fd) != 0) {
+        if (!readIncoming(fd)) {
+          ::close(fd);
+          incoming_.erase(fd);
+        }
+      } else {
+        // Writable or failed outbound connection.
+        std::lock_guard<std::mutex> guard(sendMutex_);
+        for (auto& conn : connections_) {
+          if (conn.fd != fd) {
+            continue;
+          }
+          if (events[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+            failConnection(conn, "peer closed the connection");
+            break;
+          }
+          const bool pending = writePending(conn);
+          if (!pending && conn.fd >= 0 && conn.epollOutArmed) {
+            struct epoll_event ev;
+            memset(&ev, 0, sizeof(ev));
+            ev.events = EPOLLRDHUP;
+            ev.data.fd = conn.fd;
+            ::epoll_ctl(epollFd_, EPOLL_CTL_MOD, conn.fd, &ev);
+            conn.epollOutArmed = false;
+          }
+          break;
+        }
+      }
+    }
+  }
+}
+
+bool TcpRpcAgent::readIncoming(int fd) {
+  auto& frame = incoming_[fd];
+  while (true) {
+    char* base = nullptr;
+    size_t want = 0;
+    switch (frame.stage) {
+      case IncomingFrame::Stage::FIXED:
+        frame.fixed.resize(kFrameInts);
+        base = reinterpret_cast<char*>(frame.fixed.data());
+        want = kFrameInts * sizeof(int64_t);
+        break;
+      case IncomingFrame::Stage::SIZES:
+        base = reinterpret_cast<char*>(frame.segmentSizes.data());
+        want = frame.segmentSizes.size() * sizeof(int64_t);
+        break;
+      case IncomingFrame::Stage::HEADER:
+        base = &frame.header[0];
+        want = frame.header.size();
+        break;
+      case IncomingFrame::Stage::SEGMENTS:
+        base = static_cast<char*>(
+            frame.segments[frame.segmentIdx].data_ptr());
+        want = (size_t)frame.segmentSizes[frame.segmentIdx];
+        break;
+    }
+
+    if (frame.bytesRead < want) {
+      ssize_t n = ::read(fd, base + frame.bytesRead, want - frame.bytesRead);
+      if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          return true;
+        }
+        if (errno == EINTR) {
+          continue;
+        }
+        LOG(ERROR) << "TcpRpcAgent read failed: " << strerror(errno);
+        return false;
+      }
+      if (n == 0) {
+        // Orderly shutdown; mid-frame EOF means the peer died, which the
+        // sender-side future timeout will surface.
+        return false;
+      }
+      frame.bytesRead += n;
+      if (frame.bytesRead < want) {
+        continue;
+      }
+    }
+
+    // Current stage complete; advance the state machine.
+    frame.bytesRead = 0;
+    switch (frame.stage) {
+      case IncomingFrame::Stage::FIXED: {
+        const int64_t numSegments = frame.fixed[4];
+        frame.segmentSizes.resize(numSegments);
+        frame.header.resize(frame.fixed[3]);
+        frame.stage = numSegments > 0 ? IncomingFrame::Stage::SIZES
+                                      : IncomingFrame::Stage::HEADER;
+        break;
+      }
+      case IncomingFrame::Stage::SIZES:
+        frame.stage = IncomingFrame::Stage::HEADER;
+        break;
+      case IncomingFrame::Stage::HEADER:
+        if (frame.segmentSizes.empty()) {
+          // Frame complete.
+        } else {
+          // Segment buffers are allocated up front and filled straight from
+          // the socket; the deserialized tensors adopt them as storage.
+          frame.segments.reserve(frame.segmentSizes.size());
+          for (const auto size : frame.segmentSizes) {
+            frame.segments.push_back(torch::empty({size}, {torch::kChar}));
+          }
+          frame.segmentIdx = 0;
+          frame.stage = IncomingFrame::Stage::SEGMENTS;
+          continue;
+        }
+        break;
+      case IncomingFrame::Stage::SEGMENTS:
+        if (++frame.segmentIdx < frame.segmentSizes.size()) {
+          continue;
+        }
+        break;
+    }
+
+    if (frame.stage == IncomingFrame::Stage::SEGMENTS ||
+        frame.segmentSizes.empty()) {
+      // Dispatch the complete frame to a worker thread and start parsing
+      // the next one. More frames may already be buffered on the socket.
+      threadPool_.run(std::bind(
+          [this](IncomingFrame& complete) {
+            processFrame(std::move(complete));
+          },
+          std::move(frame)));
+      frame.reset();
+    }
+  }
+}
+
+void TcpRpcAgent::processFrame(IncomingFrame frame) {
+  const auto srcRank = (worker_id_t)frame.fixed[0];
+  const MessageType type = MessageType(frame.fixed[1]);
+  const int64_t id = frame.fixed[2];
+
+  auto data = wireDeserializeSegmented(
+      frame.header.data(), frame.header.size(), std::move(frame.segments));
+  Message message(std::move(data.first), std::move(data.second), type, id);
+  handleMessage(std::move(message), allWorkerInfo_[srcRank]);
+}
+
+void TcpRpcAgent::handleMessage(Message&& message, const WorkerInfo& from) {
+  if (message.isRequest()) {
+    auto futureResponse = cb_->operator()(message);
+    if (futureResponse->completed()) {
+      if (!futureResponse->hasError()) {
+        send(from, std::move(*futureResponse).moveValue());
+      } else {
+        send(
+            from,
+            createExceptionResponse(message, futureResponse->error()->what()));
+      }
+    } else {
+      auto fromId = from.id_;
+      auto requestId = message.id();
+      futureResponse->addCallback(
+          [this, fromId, requestId, futureResponse](
+              const Message& /* unused */,
+              const c10::optional<utils::FutureError>& err) {
+            if (!err) {
+              send(
+                  getWorkerInfo(fromId),
+                  std::move(*futureResponse).moveValue());
+            } else {
+              std::string errStr = err->what();
+              std::vector<char> payload(errStr.begin(), errStr.end());
+              Message m(
+                  std::move(payload), {}, MessageType::EXCEPTION, requestId);
+              send(getWorkerInfo(fromId), std::move(m));
+            }
+          });
+    }
+  } else if (message.isResponse()) {
+    auto id = message.id();
+    std::shared_ptr<FutureMessage> fm = nullptr;
+    {
+      std::lock_guard<std::mutex> lock{futureMutex_};
+      const auto& futureIt = futures_.find(id);
+      if (futureIt == futures_.end()) {
+        // Received a completion for a timed out future; drop it. The
+        // timeout path already counted this message as received.
+        return;
+      }
+      fm = futureIt->second.future_;
+      futures_.erase(id);
+    }
+    futureCV_.notify_all();
+    if (message.type() == MessageType::EXCEPTION) {
+      fm->setError(
+          std::string(message.payload().begin(), message.payload().end()));
+    } else {
+      fm->markCompleted(std::move(message));
+    }
+  } else {
+    TORCH_INTERNAL_ASSERT(
+        false, "unrecognized message type ", message.type());
+  }
+
+  recvCounts_.increment(from.id_);
+}
+
+void TcpRpcAgent::pollTimedOutRPCs() {
+  // Unlike ProcessGroupAgent's sorted-by-deadline map, this scans the whole
+  // future map once per tick. The scan is O(outstanding RPCs) at a coarse
+  // interval, which is cheap next to the network latency being bounded.
+  constexpr std::chrono::milliseconds kPollInterval(100);
+  std::unique_lock<std::mutex> lock{futureMutex_};
+  while (rpcRunning_.load()) {
+    futureCV_.wait_for(lock, kPollInterval);
+    if (!rpcRunning_.load()) {
+      return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<FutureMessage>> timedOut;
+    for (auto it = futures_.begin(); it != futures_.end();) {
+      if (it->second.endTime_ <= now) {
+        timedOut.push_back(it->second.future_);
+        // Pre-count the late response, which handleMessage() drops without
+        // counting when it eventually arrives; see ProcessGroupAgent.
+        recvCounts_.increment(it->second.dstRank_);
+        it = futures_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    lock.unlock();
+    for (auto& fm : timedOut) {
+      std::ostringstream ss;
+      ss << "RPC ran for more than " << rpcTimeout_.load().count()
+         << " milliseconds and timed out.";
+      if (!fm->hasError()) {
+        fm->setError(ss.str());
+      }
+    }
+    if (!timedOut.empty()) {
+      futureCV_.notify_all();
+    }
+    lock.lock();
+  }
+}
+
+void TcpRpcAgent::storeBarrier() {
+  const std::string key =
+      kBarrierKeyPrefix + c10::to_string(storeSeq_.fetch_add(1));
+  store_->add(key, 1);
+  while (store_->add(key, 0) < worldSize_) {
+    std::this_thread::sleep_for(kStorePollInterval);
+  }
+}
+
+bool TcpRpcAgent::hasPendingMessage() {
+  const auto seq = storeSeq_.fetch_add(1);
+
+  std::vector<int64_t> snapshot;
+  snapshot.reserve(2 * worldSize_);
+  auto recvSnapshot = recvCounts_.snapshot();
+  auto sendSnapshot = sendCounts_.snapshot();
+  snapshot.insert(snapshot.end(), recvSnapshot.begin(), recvSnapshot.end());
+  snapshot.insert(snapshot.end(), sendSnapshot.begin(), sendSnapshot.end());
+
+  std::vector<uint8_t> bytes(snapshot.size() * sizeof(int64_t));
+  memcpy(bytes.data(), snapshot.data(), bytes.size());
+  store_->set(
+      kCountsKeyPrefix + c10::to_string(seq) + "/" + c10::to_string(rank_),
+      bytes);
+
+  // peerCounts[rank] = [recv counts..., send counts...]
+  std::vector<std::vector<int64_t>> peerCounts(worldSize_);
+  for (int rank = 0; rank < worldSize_; ++rank) {
+    auto value = store_->get(
+        kCountsKeyPrefix + c10::to_string(seq) + "/" + c10::to_string(rank));
+    peerCounts[rank].resize(2 * worldSize_);
+    TORCH_CHECK(
+        value.size() == peerCounts[rank].size() * sizeof(int64_t),
+        "Malformed counter snapshot from rank ",
+        rank);
+    memcpy(peerCounts[rank].data(), value.data(), value.size());
+  }
+
+  for (int from = 0; from < worldSize_; ++from) {
+    for (int to = 0; to < worldSize_; ++to) {
+      const int64_t sentCnt = peerCounts[from][worldSize_ + to];
+      const int64_t recvCnt = peerCounts[to][from];
+      // NB: both > and < are valid transient states, since the counters are
+      // read in a distributed manner; see ProcessGroupAgent.
+      if (sentCnt != recvCnt) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void TcpRpcAgent::sync() {
+  storeBarrier();
+  do {
+    // Wait for all queued frames to reach the wire and for all received
+    // messages to be processed. Response callbacks can enqueue more
+    // messages, hence the loop.
+    while (true) {
+      threadPool_.waitWorkComplete();
+      {
+        std::lock_guard<std::mutex> guard(sendMutex_);
+        bool drained = true;
+        for (const auto& conn : connections_) {
+          drained = drained && conn.sendQueue.empty();
+        }
+        if (drained) {
+          break;
+        }
+      }
+      std::this_thread::sleep_for(kStorePollInterval);
+    }
+  } while (hasPendingMessage());
+}
+
+void TcpRpcAgent::join() {
+  sync();
+  std::unique_lock<std::mutex> lock(futureMutex_);
+  futureCV_.wait(lock, [this] { return futures_.empty(); });
+  lock.unlock();
+  storeBarrier();
+}
+
+std::unordered_map<std::string, std::string> TcpRpcAgent::getMetrics() {
+  std::unordered_map<std::string, std::string> metrics;
+  {
+    std::lock_guard<std::mutex> lock(futureMutex_);
+    metrics["agent.num_pending_requests"] = c10::to_string(futures_.size());
+  }
+  metrics["agent.thread_pool_size"] = c10::to_string(threadPool_.size());
+  metrics["agent.num_idle_threads"] = c10::to_string(threadPool_.numAvailable());
+  return metrics;
+}
+
+void TcpRpcAgent::addGilWaitTime(
+    const std::chrono::microseconds /* gilWaitTime */) {}
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
+
+#endif // __linux__
@@ -0,0 +1,212 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <c10/core/thread_pool.h>
+#include <c10d/Store.hpp>
+#include <torch/csrc/distributed/rpc/rpc_agent.h>
+#include <torch/csrc/distributed/rpc/utils.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace distributed {
+namespace rpc {
+
+struct TcpRpcBackendOptions : public RpcBackendOptions {
+  TcpRpcBackendOptions() = default;
+  int numWorkerThreads;
+};
+
+// Note [TCP RPC agent]
+// ~~~~~~~~~~~~~~~~~~~~
+// ProcessGroupAgent funnels every message through ProcessGroup::send/recv,
+// which costs multiple rendezvous (preamble, payload, tensor segments) per
+// message and serializes all traffic to a peer behind a single tag.
+// TcpRpcAgent instead owns a plain TCP connection per peer and a single
+// epoll-driven IO thread:
+//
+//  - sends are appended to a per-peer queue and written back-to-back with
+//    writev(), gathering the frame header, the pickled metadata, and every
+//    tensor segment straight from tensor storage, so consecutive RPCs to the
+//    same peer are pipelined on the wire without waiting for responses and
+//    without flattening tensor bytes into an intermediate buffer;
+//  - the IO thread accepts peer connections and parses inbound frames,
+//    handing complete messages to a thread pool for deserialization and
+//    request callback execution;
+//  - workers rendezvous through the given c10d::Store: each rank publishes
+//    "hostname:port/name" under a well-known key, and outbound connections
+//    are established lazily on first send.
+//
+// Frames reuse the segmented serialization from wireSerializeSegmented(), so
+// received tensor segments are adopted as tensor storage without copies.
+//
+// join()/sync() mirror ProcessGroupAgent's count-matching termination
+// detection, but exchange the per-peer send/recv counters through the store
+// instead of an allgather.
+class TORCH_API TcpRpcAgent : public RpcAgent {
+ public:
+  TcpRpcAgent(
+      std::string workerName,
+      worker_id_t rank,
+      int worldSize,
+      std::shared_ptr<::c10d::Store> store,
+      int numWorkerThreads,
+      std::chrono::milliseconds rpcTimeout);
+
+  ~TcpRpcAgent() override;
+
+  std::shared_ptr<FutureMessage> send(const WorkerInfo& to, Message&& message)
+      override;
+
+  const WorkerInfo& getWorkerInfo(const std::string& workerName) const override;
+
+  const WorkerInfo& getWorkerInfo(worker_id_t id) const override;
+
+  std::vector<WorkerInfo> getWorkerInfos() const override;
+
+  void join() override;
+
+  void sync() override;
+
+  void start() override;
+
+  void shutdown() override;
+
+  std::unordered_map<std::string, std::string> getMetrics() override;
+
+ private:
+  // Number of int64 fields in the fixed part of a frame:
+  // srcRank, message type, message id, header length, number of segments.
+  static constexpr size_t kFrameInts = 5;
+
+  class MessageCounter {
+   public:
+    explicit MessageCounter(int worldSize);
+    void increment(int dst);
+    std::vector<int64_t> snapshot();
+
+   private:
+    std::vector<int64_t> counters_;
+    std::mutex mutex_;
+  };
+
+  // A message queued for a peer, already serialized into segmented form. The
+  // fixed frame fields and the segment sizes are flattened into `frameInts`
+  // so the whole message is described by one gather list.
+  struct OutgoingMessage {
+    explicit OutgoingMessage(Message&& m);
+
+    Message message;
+    WireSegments wire;
+    std::vector<int64_t> frameInts;
+    size_t bytesWritten = 0;
+    size_t totalBytes = 0;
+  };
+
+  struct PeerConnection {
+    int fd = -1;
+    bool epollOutArmed = false;
+    std::deque<std::unique_ptr<OutgoingMessage>> sendQueue;
+  };
+
+  // Parser state for one inbound connection.
+  struct IncomingFrame {
+    enum class Stage { FIXED, SIZES, HEADER, SEGMENTS };
+    Stage stage = Stage::FIXED;
+    std::vector<int64_t> fixed;
+    std::vector<int64_t> segmentSizes;
+    std::string header;
+    std::vector<torch::Tensor> segments;
+    size_t bytesRead = 0; // within the current stage / segment
+    size_t segmentIdx = 0;
+
+    void reset();
+  };
+
+  // Publishes our listen address and name to the store and resolves those of
+  // all peers.
+  void collectWorkers();
+  // Returns the connection to `dst`, dialing it if needed. Caller must hold
+  // sendMutex_.
+  PeerConnection& connectionTo(worker_id_t dst);
+  // The epoll loop: accepts connections, drains inbound frames, and flushes
+  // pending outbound queues.
+  void ioLoop();
+  void wakeIoThread();
+  // Flushes as much of `conn`'s queue as the socket accepts. Caller must
+  // hold sendMutex_. Returns true while unwritten bytes remain (EPOLLOUT
+  // should stay armed).
+  bool writePending(PeerConnection& conn);
+  // Drains readable frames from an inbound socket. Returns false once the
+  // peer has closed the connection.
+  bool readIncoming(int fd);
+  // Deserializes a complete frame and processes the message; runs in the
+  // thread pool.
+  void processFrame(IncomingFrame frame);
+  void handleMessage(Message&& message, const WorkerInfo& from);
+  void markFutureWithError(int64_t id, std::string errorMsg);
+  // Fails all queued requests on a broken connection.
+  void failConnection(PeerConnection& conn, const std::string& reason);
+  void pollTimedOutRPCs();
+  // A store-backed barrier across all workers.
+  void storeBarrier();
+  // Exchanges send/recv counters through the store; returns true while any
+  // sent message has not been processed by its destination.
+  bool hasPendingMessage();
+
+  const worker_id_t rank_;
+  const int worldSize_;
+  std::shared_ptr<::c10d::Store> store_;
+
+  std::unordered_map<std::string, worker_id_t> nameMap_;
+  std::vector<WorkerInfo> allWorkerInfo_;
+  // "hostname:port" for every rank, resolved during collectWorkers().
+  std::vector<std::string> peerAddrs_;
+
+  int listenFd_ = -1;
+  int epollFd_ = -1;
+  int wakeFd_ = -1;
+  std::thread ioThread_;
+  std::thread timeoutThread_;
+  std::atomic<bool> rpcRunning_{false};
+
+  // Guards connections_ and every per-peer send queue.
+  std::mutex sendMutex_;
+  std::vector<PeerConnection> connections_;
+  // Inbound fd -> frame parser. Only touched by the IO thread.
+  std::unordered_map<int, IncomingFrame> incoming_;
+
+  ThreadPool threadPool_;
+  std::atomic<int64_t> nextId_{0};
+
+  MessageCounter sendCounts_;
+  MessageCounter recvCounts_;
+  // Monotonic sequence for store keys used by barriers and count exchanges.
+  std::atomic<int64_t> storeSeq_{0};
+
+  struct FutureInfo {
+    std::shared_ptr<FutureMessage> future_;
+    steady_clock_time_point endTime_;
+    worker_id_t dstRank_;
+  };
+
+  std::mutex futureMutex_;
+  std::condition_variable futureCV_;
+  std::unordered_map<int64_t, FutureInfo> futures_;
+
+  void addGilWaitTime(const std::chrono::microseconds gilWaitTime) override;
+};
+
+} // namespace rpc
+} // namespace distributed
+} // namespace torch
+
+#endif // __linux__
@@ -51,6 +51,58 @@ c10::intrusive_ptr<c10::ivalue::Future> rpcTorchscript(
   return futPtr;
 }
 
+std::vector<c10::intrusive_ptr<c10::ivalue::Future>> rpcTorchscriptBatch(
+    const std::vector<std::string>& dstWorkerNames,
+    const c10::QualifiedName& qualifiedName,
+    std::vector<std::vector<c10::IValue>>& stacks,
+    const c10::TypePtr& returnType) {
+  TORCH_CHECK(
+      dstWorkerNames.size() == stacks.size(),
+      "rpc_async_batch expects one argument list per destination worker, got ",
+      stacks.size(),
+      " argument lists for ",
+      dstWorkerNames.size(),
+      " workers.");
+  auto rpcAgentPtr = RpcAgent::getCurrentRpcAgent();
+
+  // Serialize every call before the first send so that message construction
+  // is not interleaved with network progress.
+  std::vector<Message> messages;
+  messages.reserve(stacks.size());
+  for (auto& stack : stacks) {
+    messages.push_back(
+        ScriptCall(qualifiedName, std::move(stack)).toMessage());
+  }
+
+  // Hand the messages to the agent back to back. Each send only enqueues
+  // work, so the calls overlap on the wire rather than running serially.
+  std::vector<c10::intrusive_ptr<c10::ivalue::Future>> futures;
+  futures.reserve(messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    auto futMessage = autograd::sendMessageWithAutograd(
+        *rpcAgentPtr,
+        rpcAgentPtr->getWorkerInfo(dstWorkerNames[i]),
+        std::move(messages[i]),
+        true /*forceGradRecording*/);
+
+    auto futPtr = c10::make_intrusive<c10::ivalue::Future>(returnType);
+    futMessage->addCallback(
+        [futPtr](
+            const rpc::Message& message,
+            const c10::optional<utils::FutureError>& futErr) {
+          if (futErr) {
+            c10::ivalue::Future::FutureError jitFutErr(
+                std::string((*futErr).what()));
+            futPtr->markCompleted(std::move(jitFutErr));
+          } else {
+            futPtr->markCompleted(deserializeRespToIValue(message));
+          }
+        });
+    futures.push_back(std::move(futPtr));
+  }
+  return futures;
+}
+
 c10::intrusive_ptr<RRef> remoteTorchscript(
     const std::string& dstWorkerName,
     const c10::QualifiedName& qualifiedName,
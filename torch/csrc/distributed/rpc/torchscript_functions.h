@@ -25,6 +25,25 @@ c10::intrusive_ptr<c10::ivalue::Future> TORCH_API rpcTorchscript(
     const c10::FunctionSchema& functionSchema,
     std::vector<c10::IValue>& stack);
 
+// Batched variant of rpcTorchscript backing the TorchScript-visible
+// aten::rpc_async_batch op. All calls run the same torchscript function, on
+// possibly different workers. Every ScriptCall is serialized before the first
+// send, then the messages are handed to the agent back to back so the sends
+// pipeline on the wire instead of waiting on one another (ProcessGroupAgent
+// just enqueues each message onto its send thread pool).
+//   dstWorkerNames: one destination worker name per call
+//   qualifiedName: torchscript function qualified name, as for rpcTorchscript
+//   stacks: one bag of IValue args per call; consumed by this function
+//   returnType: return type of the called function, passed in explicitly
+//               because the caller has no FunctionSchema to consult
+// It returns one ivalue::Future per call, in argument order.
+std::vector<c10::intrusive_ptr<c10::ivalue::Future>> TORCH_API
+rpcTorchscriptBatch(
+    const std::vector<std::string>& dstWorkerNames,
+    const c10::QualifiedName& qualifiedName,
+    std::vector<std::vector<c10::IValue>>& stacks,
+    const c10::TypePtr& returnType);
+
 c10::intrusive_ptr<RRef> TORCH_API remoteTorchscript(
     const std::string& dstWorkerName,
     const c10::QualifiedName& qualifiedName,
@@ -40,6 +40,9 @@ std::unique_ptr<RpcCommandBase> deserializeRequest(const Message& request) {
     case MessageType::PYTHON_RREF_FETCH_CALL: {
       return PythonRRefFetchCall::fromMessage(request);
     }
+    case MessageType::MULTI_RREF_FETCH_CALL: {
+      return MultiRRefFetchCall::fromMessage(request);
+    }
     case MessageType::RREF_USER_DELETE: {
       return RRefUserDelete::fromMessage(request);
     }
@@ -84,6 +87,9 @@ std::unique_ptr<RpcCommandBase> deserializeResponse(
     case MessageType::PYTHON_RREF_FETCH_RET: {
       return PythonRRefFetchRet::fromMessage(response);
     }
+    case MessageType::MULTI_RREF_FETCH_RET: {
+      return MultiRRefFetchRet::fromMessage(response);
+    }
     case MessageType::RREF_ACK: {
       return RRefAck::fromMessage(response);
     }
@@ -343,6 +349,116 @@ std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
   return {std::move(payload), std::move(tensors)};
 }
 
+WireSegments wireSerializeSegmented(
+    const std::vector<char>& payload,
+    const std::vector<at::Tensor>& tensors) {
+  WireSegments out;
+  std::string metaEntry;
+
+  if (!tensors.empty()) {
+    torch::jit::Pickler pickler(
+        [&](const void* buf, size_t sz) -> size_t {
+          metaEntry.append(static_cast<const char*>(buf), sz);
+          return sz;
+        },
+        nullptr);
+    pickler.protocol();
+    pickler.pushIValue(cloneSparseTensors(tensors));
+    pickler.stop();
+    out.tensorData = pickler.tensorData();
+  }
+
+  // Unlike wireSerialize(), tensor sections are not appended to the flat
+  // buffer: the header is a self-contained wire-sections blob holding only
+  // the payload and metadata, and the unpickler is fed the out-of-band
+  // segments at deserialization time.
+  struct Ent {
+    std::string name;
+    const char* data;
+    size_t size;
+  };
+  std::vector<Ent> entries;
+  if (!payload.empty()) {
+    entries.push_back({kPayload, payload.data(), payload.size()});
+  }
+  if (!metaEntry.empty()) {
+    entries.push_back({kMeta, metaEntry.data(), metaEntry.size()});
+  }
+
+  std::string header;
+  size_t tot = 0;
+  for (const auto& e : entries) {
+    tot += e.size;
+    header.append(e.name)
+        .append(" ")
+        .append(c10::to_string(e.size))
+        .append("\n");
+  }
+  header.push_back('\n');
+
+  out.header.reserve(header.size() + tot);
+  out.header.append(header);
+  for (const auto& e : entries) {
+    out.header.append(e.data, e.size);
+  }
+  return out;
+}
+
+std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserializeSegmented(
+    const void* header,
+    size_t header_size,
+    std::vector<at::Tensor> tensorSegments) {
+  auto sections = parseWireSections(header, header_size);
+
+  std::vector<char> payload;
+  auto payloadIt = sections.find(kPayload);
+  if (payloadIt != sections.end() && payloadIt->second.second != 0) {
+    payload.assign(
+        payloadIt->second.first,
+        payloadIt->second.first + payloadIt->second.second);
+  }
+
+  std::vector<at::Tensor> tensors;
+  auto metaIt = sections.find(kMeta);
+  if (metaIt != sections.end()) {
+    const auto& metaData = metaIt->second;
+    size_t metaDataPos = 0;
+    auto metaDataReadFunc = [&](char* buf, size_t n) -> size_t {
+      if (metaDataPos >= metaData.second || n == 0) {
+        return 0;
+      }
+      size_t toCopy = std::min(metaDataPos + n, metaData.second) - metaDataPos;
+      memcpy(buf, metaData.first + metaDataPos, toCopy);
+      metaDataPos += toCopy;
+      return toCopy;
+    };
+    auto sectionReadFunc = [&](const std::string& ename) -> at::DataPtr {
+      const auto idx = static_cast<size_t>(c10::stoll(ename));
+      TORCH_CHECK(
+          idx < tensorSegments.size(), "Couldn't find tensor segment ", ename);
+      // Adopt the segment buffer as the tensor storage instead of copying it
+      // out. The DataPtr context keeps the segment tensor, and thereby the
+      // buffer, alive for the lifetime of the deserialized tensor.
+      auto* ctx = new at::Tensor(tensorSegments[idx]);
+      return at::DataPtr(
+          ctx->data_ptr(),
+          ctx,
+          [](void* c) { delete static_cast<at::Tensor*>(c); },
+          at::kCPU);
+    };
+
+    // No need to pass typeResolver here, as it always processes string and
+    // tensors only
+    torch::jit::Unpickler unpickler(
+        metaDataReadFunc, nullptr, nullptr, sectionReadFunc, {});
+    auto ival = unpickler.parse_ivalue();
+    for (auto&& t : ival.toTensorList()) {
+      tensors.emplace_back(std::move(t));
+    }
+  }
+  return {std::move(payload), std::move(tensors)};
+}
+
 } // namespace rpc
 } // namespace distributed
 } // namespace torch
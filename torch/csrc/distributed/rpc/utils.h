@@ -1,6 +1,7 @@
 #pragma once
 
 #include <torch/csrc/distributed/rpc/rpc_command_base.h>
+#include <torch/csrc/jit/pickler.h>
 
 namespace torch {
 namespace distributed {
@@ -39,6 +40,32 @@ TORCH_API std::pair<std::vector<char>, std::vector<at::Tensor>> wireDeserialize(
     const void* data,
     size_t data_size);
 
+// Zero-copy variant of wireSerialize(). `header` holds the section table,
+// the payload bits, and the unpickler metadata, while the tensor bytes stay
+// behind in `tensorData`, each segment aliasing the storage of the tensor it
+// came from. A transport can then hand the segments to the wire directly
+// (e.g. one ProcessGroup::send per segment) instead of copying multi-MB
+// tensor contents into one flat buffer first. The segments remain valid for
+// as long as the returned WireSegments object is alive.
+struct TORCH_API WireSegments {
+  std::string header;
+  std::vector<torch::jit::WriteableTensorData> tensorData;
+};
+
+TORCH_API WireSegments wireSerializeSegmented(
+    const std::vector<char>& payload,
+    const std::vector<at::Tensor>& tensors);
+
+// Counterpart of wireSerializeSegmented(). `tensorSegments` must hold one
+// flat char tensor per serialized segment, in order. The returned tensors
+// adopt the segment buffers as their storage, so receiving a segment
+// directly into pre-allocated memory makes the whole path copy-free.
+TORCH_API std::pair<std::vector<char>, std::vector<at::Tensor>>
+wireDeserializeSegmented(
+    const void* header,
+    size_t header_size,
+    std::vector<at::Tensor> tensorSegments);
+
 // Some Tensors are effectively views of larger Tensors, where only a small
 // subset of the Storage data is referenced. This normally is good and avoids
 // copies when kept locally, but if we naively push the whole Storage over the
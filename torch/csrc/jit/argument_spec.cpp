@@ -1,9 +1,101 @@
 
 #include <torch/csrc/jit/argument_spec.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 namespace torch {
 namespace jit {
 
+namespace {
+// Bucket ids live in 5 bits of ArgumentInfo, so id 31 is the largest; id 0
+// always means "unbucketed".
+constexpr unsigned kMaxBucketId = 31;
+
+std::atomic<BatchBucketingMode> bucketing_mode{BatchBucketingMode::None};
+std::mutex pinned_sizes_mutex;
+std::vector<int64_t>& pinnedSizes() {
+  static std::vector<int64_t> sizes;
+  return sizes;
+}
+} // namespace
+
+void setBatchBucketing(
+    BatchBucketingMode mode,
+    std::vector<int64_t> pinned_sizes) {
+  if (mode == BatchBucketingMode::Pinned) {
+    TORCH_CHECK(
+        !pinned_sizes.empty() && pinned_sizes.size() <= kMaxBucketId,
+        "Pinned batch bucketing needs between 1 and ",
+        kMaxBucketId,
+        " sizes, got ",
+        pinned_sizes.size());
+    std::sort(pinned_sizes.begin(), pinned_sizes.end());
+    TORCH_CHECK(
+        pinned_sizes.front() > 0, "pinned batch sizes must be positive");
+  }
+  {
+    std::lock_guard<std::mutex> lock(pinned_sizes_mutex);
+    pinnedSizes() = std::move(pinned_sizes);
+  }
+  bucketing_mode.store(mode, std::memory_order_relaxed);
+}
+
+BatchBucketingMode batchBucketingMode() {
+  return bucketing_mode.load(std::memory_order_relaxed);
+}
+
+unsigned batchBucketId(int64_t batch_size) {
+  if (batch_size <= 0) {
+    return 0;
+  }
+  switch (batchBucketingMode()) {
+    case BatchBucketingMode::PowerOfTwo: {
+      int64_t ceiling = 1;
+      unsigned id = 1;
+      while (ceiling < batch_size) {
+        if (id == kMaxBucketId) {
+          return 0; // beyond 2^30; leave unbucketed
+        }
+        ceiling <<= 1;
+        ++id;
+      }
+      return id;
+    }
+    case BatchBucketingMode::Pinned: {
+      std::lock_guard<std::mutex> lock(pinned_sizes_mutex);
+      const auto& sizes = pinnedSizes();
+      auto it = std::lower_bound(sizes.begin(), sizes.end(), batch_size);
+      if (it == sizes.end()) {
+        return 0; // larger than every pinned size
+      }
+      return static_cast<unsigned>(it - sizes.begin()) + 1;
+    }
+    case BatchBucketingMode::None:
+      break;
+  }
+  return 0;
+}
+
+int64_t batchBucketCeiling(unsigned bucket_id) {
+  if (bucket_id == 0 || bucket_id > kMaxBucketId) {
+    return 0;
+  }
+  switch (batchBucketingMode()) {
+    case BatchBucketingMode::PowerOfTwo:
+      return static_cast<int64_t>(1) << (bucket_id - 1);
+    case BatchBucketingMode::Pinned: {
+      std::lock_guard<std::mutex> lock(pinned_sizes_mutex);
+      const auto& sizes = pinnedSizes();
+      return bucket_id <= sizes.size() ? sizes[bucket_id - 1] : 0;
+    }
+    case BatchBucketingMode::None:
+      break;
+  }
+  return 0;
+}
+
 void ArgumentSpecCreator::scan(
     const TypePtr& typ,
     size_t depth,
@@ -20,6 +20,39 @@ namespace jit {
 inline static at::Device ConvertIntToCPUOrCUDA(int device) {
   return device < 0 ? at::kCPU : at::Device(at::DeviceType::CUDA, device);
 }
+
+// Shape-class bucketing for the batch (first) dimension.
+//
+// By default a spec carries only dimensionality, so every batch size shares
+// one plan compiled with an unknown batch dimension. Dynamic-batch serving
+// can opt in to bucketing: size(0) is mapped to a small bucket id that
+// becomes part of the spec's identity, and specialized input types carry the
+// bucket's ceiling as the batch-dim size. Each bucket then gets its own
+// ExecutionPlan, compiled as if every batch were exactly the ceiling, and
+// the set of plans stays small and stable no matter how batch sizes vary.
+//
+// Plans specialized this way are padding-aware: callers enabling bucketing
+// are expected to pad the batch dimension of their inputs up to the bucket
+// ceiling before running. Set the mode once at startup; changing it
+// invalidates nothing but makes previously cached plans unreachable.
+enum class BatchBucketingMode : uint8_t {
+  None, // sizes are not part of the spec (default)
+  PowerOfTwo, // bucket ceiling is the next power of two of size(0)
+  Pinned, // bucket ceiling is the smallest pinned size >= size(0)
+};
+
+// `pinned_sizes` is consulted only in Pinned mode and may hold at most 31
+// entries (bucket ids are packed into 5 spare bits of ArgumentInfo). Batch
+// sizes with no bucket - above the largest pinned entry, or beyond 2^30 in
+// PowerOfTwo mode - stay unbucketed and specialize like mode None.
+TORCH_API void setBatchBucketing(
+    BatchBucketingMode mode,
+    std::vector<int64_t> pinned_sizes = {});
+TORCH_API BatchBucketingMode batchBucketingMode();
+// Maps size(0) to its bucket id (0 means unbucketed), and an id back to the
+// ceiling it stands for.
+TORCH_API unsigned batchBucketId(int64_t batch_size);
+TORCH_API int64_t batchBucketCeiling(unsigned bucket_id);
 struct ArgumentInfo {
   friend struct ArgumentSpec;
   using plain_data_type = uint32_t;
@@ -41,9 +74,27 @@ struct ArgumentInfo {
   at::ScalarType type() const {
     return at::ScalarType(type_);
   }
+  // Nonzero only when batch bucketing is enabled; see batchBucketCeiling()
+  // for the padded batch size this spec stands for.
+  unsigned batchBucket() const {
+    return batch_bucket_;
+  }
   TypePtr toType() const {
     if (!defined())
       return TensorType::get();
+    if (batch_bucket_ != 0 && dim() >= 1) {
+      // Record the bucket ceiling as the batch-dim size and leave the other
+      // dims varying: the runtime pads inputs up to the ceiling, so a plan
+      // specialized on this type serves the whole bucket.
+      std::vector<c10::optional<int64_t>> sizes(dim(), c10::nullopt);
+      sizes[0] = batchBucketCeiling(batch_bucket_);
+      return TensorType::create(
+          type(),
+          ConvertIntToCPUOrCUDA(device()),
+          c10::VaryingShape(std::move(sizes)),
+          c10::VaryingShape(dim()),
+          requires_grad());
+    }
     return TensorType::create(
         type(),
         ConvertIntToCPUOrCUDA(device()),
@@ -58,7 +109,7 @@ struct ArgumentInfo {
  private:
   unsigned defined_ : 1;
   unsigned requires_grad_ : 1;
-  unsigned : 5;
+  unsigned batch_bucket_ : 5; // 0 when batch bucketing is off
   unsigned dim_ : 8;
   int device_ : 8; // NOTE: this needs to be signed because we use -1 to
                    // represent CPU
@@ -104,6 +155,9 @@ struct ArgumentSpec {
       arg.dim_ = t->dim();
       arg.device_ = t->is_cuda() ? t->get_device() : -1;
       arg.type_ = static_cast<unsigned>(t->scalar_type());
+      if (batchBucketingMode() != BatchBucketingMode::None && t->dim() >= 1) {
+        arg.batch_bucket_ = batchBucketId(t->size(0));
+      }
     }
     combineHash(arg);
   }
@@ -0,0 +1,159 @@
+#include <torch/csrc/jit/dynamic_batcher.h>
+
+#include <ATen/Parallel.h>
+#include <c10/util/Exception.h>
+
+#include <memory>
+#include <utility>
+
+namespace torch {
+namespace jit {
+
+DynamicBatcher::DynamicBatcher(
+    script::Module module,
+    DynamicBatcherOptions options)
+    : module_(std::move(module)), options_(std::move(options)) {
+  TORCH_CHECK(
+      options_.max_batch_size > 0, "max_batch_size must be positive");
+  collector_ = std::thread([this]() { collectorLoop(); });
+}
+
+DynamicBatcher::~DynamicBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  // The collector drains pending_ before exiting, so every submitted
+  // request still gets a batch.
+  collector_.join();
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return in_flight_ == 0; });
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> DynamicBatcher::submit(
+    std::vector<at::Tensor> inputs) {
+  TORCH_CHECK(!inputs.empty(), "submit expects at least one input tensor");
+  auto future = c10::make_intrusive<c10::ivalue::Future>(c10::AnyType::get());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TORCH_CHECK(!shutdown_, "DynamicBatcher is shutting down");
+    pending_.push_back(
+        Request{std::move(inputs), future, std::chrono::steady_clock::now()});
+  }
+  cv_.notify_all();
+  return future;
+}
+
+bool DynamicBatcher::compatible(const Request& a, const Request& b) {
+  if (a.inputs.size() != b.inputs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.inputs.size(); ++i) {
+    const auto& ta = a.inputs[i];
+    const auto& tb = b.inputs[i];
+    if (ta.scalar_type() != tb.scalar_type() || ta.device() != tb.device() ||
+        ta.sizes() != tb.sizes()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void DynamicBatcher::collectorLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return shutdown_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      // Only reachable on shutdown with nothing left to drain.
+      return;
+    }
+    // Wait for the batch to fill or for the oldest request to expire.
+    const auto deadline =
+        pending_.front().enqueue_time + options_.max_queue_delay;
+    while (!shutdown_ && pending_.size() < options_.max_batch_size &&
+           std::chrono::steady_clock::now() < deadline) {
+      cv_.wait_until(lock, deadline);
+    }
+    // Cut the longest run of requests the head is compatible with; the
+    // first incompatible request starts the next batch, preserving
+    // submission order.
+    auto batch = std::make_shared<std::vector<Request>>();
+    batch->push_back(std::move(pending_.front()));
+    pending_.pop_front();
+    while (!pending_.empty() && batch->size() < options_.max_batch_size &&
+           compatible(batch->front(), pending_.front())) {
+      batch->push_back(std::move(pending_.front()));
+      pending_.pop_front();
+    }
+    ++in_flight_;
+    lock.unlock();
+    at::launch([this, batch]() { runBatch(std::move(*batch)); });
+    lock.lock();
+  }
+}
+
+void DynamicBatcher::runBatch(std::vector<Request> batch) {
+  try {
+    const size_t num_args = batch.front().inputs.size();
+    std::vector<IValue> stacked;
+    stacked.reserve(num_args);
+    std::vector<at::Tensor> column(batch.size());
+    for (size_t arg = 0; arg < num_args; ++arg) {
+      for (size_t i = 0; i < batch.size(); ++i) {
+        column[i] = batch[i].inputs[arg];
+      }
+      stacked.emplace_back(at::stack(column, /*dim=*/0));
+    }
+
+    IValue out = module_.forward(std::move(stacked));
+    if (out.isTensor()) {
+      auto result = out.toTensor();
+      TORCH_CHECK(
+          result.dim() > 0 &&
+              result.size(0) == static_cast<int64_t>(batch.size()),
+          "module output is missing the batch dimension");
+      for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].future->markCompleted(result.select(0, i));
+      }
+    } else if (out.isTuple()) {
+      const auto& elements = out.toTuple()->elements();
+      for (const auto& element : elements) {
+        TORCH_CHECK(
+            element.isTensor() && element.toTensor().dim() > 0 &&
+                element.toTensor().size(0) ==
+                    static_cast<int64_t>(batch.size()),
+            "every tuple output must be a Tensor with the batch dimension");
+      }
+      for (size_t i = 0; i < batch.size(); ++i) {
+        std::vector<IValue> row;
+        row.reserve(elements.size());
+        for (const auto& element : elements) {
+          row.emplace_back(element.toTensor().select(0, i));
+        }
+        batch[i].future->markCompleted(
+            c10::ivalue::Tuple::create(std::move(row)));
+      }
+    } else {
+      TORCH_CHECK(
+          false,
+          "DynamicBatcher supports Tensor or tuple-of-Tensor outputs, got ",
+          out.tagKind());
+    }
+  } catch (std::exception& e) {
+    for (auto& request : batch) {
+      if (!request.future->completed()) {
+        request.future->markCompleted(
+            c10::ivalue::Future::FutureError(std::string(e.what())));
+      }
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --in_flight_;
+  }
+  cv_.notify_all();
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,75 @@
+#pragma once
+
+// DynamicBatcher coalesces concurrent single-example inference requests
+// against a scripted module into batched forward calls. Callers submit the
+// module's tensor arguments for one example (without the batch dimension)
+// and receive an ivalue::Future; a collector thread gathers compatible
+// requests until either the batch is full or the oldest request has waited
+// max_queue_delay, stacks the arguments along a new leading dimension, runs
+// one forward on the inter-op thread pool and scatters the rows of the
+// output back to the per-request futures.
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/script/module.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+struct DynamicBatcherOptions {
+  // Largest number of requests fused into one forward call.
+  size_t max_batch_size = 32;
+  // Longest time the oldest queued request may wait for the batch to fill
+  // before a partial batch is flushed.
+  std::chrono::microseconds max_queue_delay = std::chrono::microseconds(1000);
+};
+
+struct TORCH_API DynamicBatcher {
+  explicit DynamicBatcher(
+      script::Module module,
+      DynamicBatcherOptions options = DynamicBatcherOptions());
+  ~DynamicBatcher();
+
+  DynamicBatcher(const DynamicBatcher&) = delete;
+  DynamicBatcher& operator=(const DynamicBatcher&) = delete;
+
+  // Submits the tensor arguments for a single example. Requests are
+  // coalesced with the longest run of queued requests whose arguments have
+  // the same shapes, dtypes and devices; an incompatible request starts the
+  // next batch. The returned future holds this example's row of the
+  // module's output: a Tensor, or a tuple of Tensors each carrying the
+  // batch dimension. The future reports an error if forward throws.
+  c10::intrusive_ptr<c10::ivalue::Future> submit(
+      std::vector<at::Tensor> inputs);
+
+ private:
+  struct Request {
+    std::vector<at::Tensor> inputs;
+    c10::intrusive_ptr<c10::ivalue::Future> future;
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
+  static bool compatible(const Request& a, const Request& b);
+  void collectorLoop();
+  void runBatch(std::vector<Request> batch);
+
+  script::Module module_;
+  DynamicBatcherOptions options_;
+
+  // Protects pending_, shutdown_ and in_flight_.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request> pending_;
+  size_t in_flight_ = 0;
+  bool shutdown_ = false;
+  std::thread collector_;
+};
+
+} // namespace jit
+} // namespace torch
@@ -13,6 +13,7 @@
 #include <onnx/proto_utils.h>
 
 #include <ATen/ATen.h>
+#include <ATen/Parallel.h>
 #include <c10/util/Optional.h>
 
 #include <fstream>
@@ -30,13 +31,21 @@ void writeArchiveAndTensors(
     const char* data,
     size_t size,
     const std::vector<WriteableTensorData>& tensors,
-    caffe2::serialize::PyTorchStreamWriter& out) {
+    caffe2::serialize::PyTorchStreamWriter& out,
+    const std::string* consolidated_tensor_data) {
   std::string prefix = archive_name + "/";
   size_t i = 0;
   for (const auto& td : tensors) {
     std::string fname = prefix + std::to_string(i++);
     out.writeRecord(fname, td.data(), td.sizeInBytes());
   }
+  if (consolidated_tensor_data != nullptr &&
+      !consolidated_tensor_data->empty()) {
+    out.writeRecord(
+        prefix + kConsolidatedStorageRecordName,
+        consolidated_tensor_data->data(),
+        consolidated_tensor_data->size());
+  }
   std::string fname = archive_name + ".pkl";
   out.writeRecord(fname, data, size);
 }
@@ -559,6 +568,10 @@ class GraphEncoder : public EncoderBase {
 
   RawDataExportMap raw_data_export_map_;
   bool defer_weight_export_;
+  // (file name, contiguous tensor) pairs collected during encoding; the
+  // blobs are streamed out in parallel after the proto is built, see the
+  // constructor.
+  std::vector<std::pair<std::string, at::Tensor>> pending_external_data_;
 };
 
 GraphEncoder::GraphEncoder(
@@ -606,6 +619,26 @@ GraphEncoder::GraphEncoder(
       "Please verify custom opset domain names.");
     }
   }
+
+  if (!pending_external_data_.empty()) {
+    // The proto only references the sidecar files, so the weight blobs can
+    // be dumped now that encoding is done. Each initializer writes to its
+    // own file, making the writes embarrassingly parallel; for multi-GB
+    // models this is the dominant cost of the export.
+    at::parallel_for(
+        0,
+        pending_external_data_.size(),
+        1,
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            CreateExternalFile(
+                pending_external_data_[i].second,
+                pending_external_data_[i].first,
+                onnx_file_path);
+          }
+        });
+    pending_external_data_.clear();
+  }
 }
 
 void GraphEncoder::EncodeTensor(
@@ -651,7 +684,10 @@ void GraphEncoder::EncodeTensor(
       AT_ASSERT(!onnx_file_path.empty());
       AT_ASSERT((external_ref != c10::nullopt) && (external_ref.value() == tensor_proto->name()));
       auto tensorName = GetExternalFileName(external_ref);
-      CreateExternalFile(t, tensorName, onnx_file_path);      
+      // Only metadata goes into the proto here; the raw blob is written to
+      // its sidecar file later, in parallel with the other initializers.
+      // `t` is a refcounted handle, so no extra copy of the data is held.
+      pending_external_data_.emplace_back(tensorName, t);
       onnx::StringStringEntryProto* location = tensor_proto->mutable_external_data()->Add();
       location->set_key("location");
       location->set_value(tensorName);
@@ -6,6 +6,7 @@
 #include <torch/csrc/onnx/onnx.h>
 #include <caffe2/serialize/inline_container.h>
 
+#include <future>
 #include <ostream>
 
 namespace torch {
@@ -69,14 +70,37 @@ TORCH_API void ExportModule(
     const script::ExtraFilesMap& metadata = script::ExtraFilesMap(),
     bool bytecode_format = false);
 
+// Asynchronous variants of ExportModule. The module's tensor attributes are
+// snapshotted on the calling thread before this returns; pickling,
+// compression and writing of the zip container all happen on a background
+// thread. In-place updates to the module made after the call (e.g. from
+// continued training) do not affect the checkpoint. The returned future
+// completes when the file is fully written and rethrows any serialization
+// error on get()/wait(). For the stream variant, `out` must stay alive
+// until the future completes.
+TORCH_API std::future<void> ExportModuleAsync(
+    const script::Module& module,
+    std::ostream& out,
+    const script::ExtraFilesMap& metadata = script::ExtraFilesMap(),
+    bool bytecode_format = false);
+
+TORCH_API std::future<void> ExportModuleAsync(
+    const script::Module& module,
+    const std::string& filename,
+    const script::ExtraFilesMap& metadata = script::ExtraFilesMap(),
+    bool bytecode_format = false);
+
 // Write the bytes of a pickle archive and the tensors referenced inside that
-// archive
+// archive. If the pickler produced consolidated small-tensor data, pass it
+// as consolidated_tensor_data so it is written as the shared record the
+// pickle stream references.
 TORCH_API void writeArchiveAndTensors(
     const std::string& archive_name,
     const char* pickle_bytes,
     size_t size,
     const std::vector<WriteableTensorData>& tensors,
-    caffe2::serialize::PyTorchStreamWriter& out);
+    caffe2::serialize::PyTorchStreamWriter& out,
+    const std::string* consolidated_tensor_data = nullptr);
 
 // Surrounding system can install an additional hook to produce extra files
 // with metadata based on environment every time a module is serialized.
@@ -6,13 +6,17 @@
 #include <torch/csrc/jit/pickle.h>
 #include <torch/csrc/jit/source_range_serialization.h>
 #include <torch/csrc/jit/instruction.h>
+#include <torch/csrc/jit/passes/constant_pooling.h>
 #include <torch/csrc/jit/passes/inliner.h>
 
 #include <caffe2/serialize/inline_container.h>
 
 #include <ATen/ATen.h>
 
+#include <future>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace torch {
@@ -25,6 +29,24 @@ ExportModuleExtraFilesHook& GetExtraFilesHook() {
   static ExportModuleExtraFilesHook func = nullptr;
   return func;
 };
+
+// Cheap content hash for bucketing tensor constants; callers confirm hash
+// matches with a full equality check, so collisions only cost time.
+size_t hashTensorConstant(const at::Tensor& t) {
+  size_t hash = static_cast<size_t>(t.scalar_type());
+  for (int64_t s : t.sizes()) {
+    hash = hash * 31 + static_cast<size_t>(s);
+  }
+  if (t.defined() && !t.is_sparse() && t.device().is_cpu() &&
+      t.is_contiguous() && t.numel() > 0) {
+    const auto* data = static_cast<const unsigned char*>(t.data_ptr());
+    size_t nbytes = std::min<size_t>(t.numel() * t.element_size(), 256);
+    for (size_t i = 0; i < nbytes; ++i) {
+      hash = hash * 31 + data[i];
+    }
+  }
+  return hash;
+}
 }
 
 void SetExportModuleExtraFilesHook(ExportModuleExtraFilesHook hook) {
@@ -58,6 +80,7 @@ class ScriptModuleSerializer {
     if (bytecode_format) {
       writeByteCode(module);
     }
+    writeWarmStartProfiles(module);
   }
 
  private:
@@ -162,21 +185,30 @@ class ScriptModuleSerializer {
       const auto& func = method.function();
       auto graph = func.graph()->copy();
       Inline(*graph);
+      // Inlining replicates the constants of every call site, so pool them
+      // back into one node per distinct value before emitting bytecode.
+      ConstantPooling(graph);
       torch::jit::Code code(graph);
 
-      // operator names
+      // instructions and deduplicated operator names. Each distinct operator
+      // is written once and the operand of every OP/OPN instruction is
+      // remapped to index the compacted table, so the mobile runtime resolves
+      // each operator at most once per method instead of once per call site.
       std::vector<c10::OperatorName> opnames;
+      std::unordered_map<c10::OperatorName, size_t> opname_to_index;
+      std::vector<IValue> instructions;
       for (size_t i = 0; i < code.instructions().size(); ++i) {
         Instruction ins = code.instructions()[i];
         if (ins.op == OP || ins.op == OPN) {
           auto node = code.instructions_source()[i];
-          opnames.emplace_back(node->schema().operator_name());
+          auto opname = node->schema().operator_name();
+          auto it = opname_to_index.find(opname);
+          if (it == opname_to_index.end()) {
+            it = opname_to_index.emplace(opname, opnames.size()).first;
+            opnames.emplace_back(std::move(opname));
+          }
+          ins.X = it->second;
         }
-      }
-
-      // instructions
-      std::vector<IValue> instructions;
-      for (Instruction ins : code.instructions()) {
         instructions.emplace_back(Tup({toString(ins.op), ins.X, ins.N}));
       }
 
@@ -186,8 +218,17 @@ class ScriptModuleSerializer {
         operators.emplace_back(c10::ivalue::Tuple::create({opname.name, opname.overload_name}));
       }
 
-      // constants
+      // constants; identical tensor constants recur across methods (shared
+      // submodules inline the same weights and tables), so canonicalize
+      // them to a single object. The pickler memoizes storages by address,
+      // which makes the combined bytecode archive store each distinct
+      // constant once.
       auto constants = code.constant_table();
+      for (IValue& constant : constants) {
+        if (constant.isTensor()) {
+          constant = dedupTensorConstant(constant.toTensor());
+        }
+      }
 
       // types
       std::vector<IValue> types;
@@ -206,9 +247,87 @@ class ScriptModuleSerializer {
 
       elements.push_back(Tup({func.qualname().qualifiedName(), table}));
     }
+
+    // In addition to the eager "bytecode" archive, write the same methods in
+    // a lazily-parseable layout: one archive per method plus a flat index
+    // record, so the mobile importer can defer unpickling a method until its
+    // first call (see torch/csrc/jit/mobile/import.cpp). The eager archive is
+    // kept so older runtimes can still load the file; bytecode is small
+    // relative to the tensor data, so the duplication is cheap.
+    std::vector<std::string> method_names;
+    for (size_t i = 0; i < elements.size(); ++i) {
+      method_names.push_back(
+          elements[i].toTuple()->elements().at(0).toStringRef());
+      writeArchive("bytecode.lazy/" + c10::to_string(i), elements[i]);
+    }
+    writeByteCodeIndex(method_names);
+
     writeArchive("bytecode", Tup(std::move(elements)));
   }
 
+  // The flat index for the lazy bytecode layout: a fixed header followed by
+  // one length-prefixed qualified name per method, in archive order (method i
+  // lives in "bytecode.lazy/<i>.pkl"). Kept deliberately trivial so the
+  // importer can parse it without touching the unpickler.
+  void writeByteCodeIndex(const std::vector<std::string>& method_names) {
+    std::vector<char> data;
+    auto append_uint64 = [&](uint64_t value) {
+      const char* start = reinterpret_cast<const char*>(&value);
+      data.insert(data.end(), start, start + sizeof(value));
+    };
+    append_uint64(kLazyByteCodeIndexMagic);
+    append_uint64(kLazyByteCodeIndexVersion);
+    append_uint64(method_names.size());
+    for (const auto& name : method_names) {
+      append_uint64(name.size());
+      data.insert(data.end(), name.begin(), name.end());
+    }
+    writer_.writeRecord("bytecode.lazy.index", data.data(), data.size());
+  }
+
+  // If any of the module's methods have been run in this process under the
+  // profiling executor, snapshot their runtime profiles into a "profiles"
+  // archive so the process that loads this file starts with them and
+  // compiles optimized plans immediately (see
+  // GraphExecutor::warmStartWithProfiles). A module that was never run
+  // produces no archive, so the common save path is unaffected.
+  void writeWarmStartProfiles(const script::Module& module) {
+    std::vector<IValue> entries;
+    std::unordered_set<std::string> seen;
+    for (const script::Module& m : module.modules()) {
+      for (const auto& method : m.get_methods()) {
+        auto& fn = method.function();
+        const auto qualname = fn.qualname().qualifiedName();
+        if (!seen.insert(qualname).second || !fn.has_executor()) {
+          continue;
+        }
+        auto profiles = fn.get_executor().serializeProfiles();
+        if (!profiles.isNone()) {
+          entries.push_back(Tup({qualname, std::move(profiles)}));
+        }
+      }
+    }
+    if (!entries.empty()) {
+      writeArchive("profiles", Tup(std::move(entries)));
+    }
+  }
+
+  // Maps a tensor constant to the first equal-content tensor seen while
+  // writing bytecode, so equal constants from different methods alias one
+  // object (and therefore one storage record in the bytecode archive).
+  at::Tensor dedupTensorConstant(const at::Tensor& t) {
+    size_t hash = hashTensorConstant(t);
+    auto range = bytecode_constant_dedup_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (t.options().type_equal(it->second.options()) &&
+          t.equal(it->second)) {
+        return it->second;
+      }
+    }
+    bytecode_constant_dedup_.emplace(hash, t);
+    return t;
+  }
+
   void convertNamedType(const c10::NamedTypePtr& class_type) {
     if (converted_types_.count(class_type)) {
       return;
@@ -227,6 +346,9 @@ class ScriptModuleSerializer {
 
   caffe2::serialize::PyTorchStreamWriter writer_;
   std::vector<at::Tensor> constant_table_;
+  // content-hash buckets of canonical tensor constants for the bytecode
+  // archives; see dedupTensorConstant
+  std::unordered_multimap<size_t, at::Tensor> bytecode_constant_dedup_;
   std::unordered_set<c10::NamedTypePtr> converted_types_;
   std::vector<c10::NamedTypePtr> class_deps_;
 
@@ -266,5 +388,66 @@ void ExportModule(
   serializer.serialize(module, extra_files, bytecode_format);
 }
 
+namespace {
+
+// Snapshots a module so it can be serialized on a background thread while
+// the caller keeps mutating the original. clone_instance() gives a fresh
+// object tree sharing the ClassType; the tensor slots (parameters and
+// buffers, i.e. the bulk of a checkpoint) are then replaced with copies.
+// GPU tensors are staged to CPU here so the background thread never has to
+// touch the device. The staging copy runs at memory/PCIe bandwidth; the
+// expensive part of a save - pickling, zip bookkeeping, compression and
+// disk IO - is what moves off the calling thread.
+script::Module snapshotForAsyncSave(const script::Module& module) {
+  script::Module snapshot = module.clone_instance();
+  for (script::Module m : snapshot.modules()) {
+    auto type = m.type();
+    size_t N = type->numAttributes();
+    for (size_t i = 0; i < N; ++i) {
+      IValue s = m._ivalue()->getSlot(i);
+      if (s.isTensor()) {
+        const auto& t = s.toTensor();
+        if (!t.defined()) {
+          continue;
+        }
+        m._ivalue()->setSlot(
+            i,
+            t.device().is_cpu()
+                ? t.clone()
+                : t.to(at::kCPU, /*non_blocking=*/false, /*copy=*/true));
+      }
+    }
+  }
+  return snapshot;
+}
+
+} // namespace
+
+std::future<void> ExportModuleAsync(
+    const script::Module& module,
+    std::ostream& out,
+    const script::ExtraFilesMap& extra_files,
+    bool bytecode_format) {
+  script::Module snapshot = snapshotForAsyncSave(module);
+  return std::async(
+      std::launch::async,
+      [snapshot, &out, extra_files, bytecode_format]() {
+        ExportModule(snapshot, out, extra_files, bytecode_format);
+      });
+}
+
+std::future<void> ExportModuleAsync(
+    const script::Module& module,
+    const std::string& filename,
+    const script::ExtraFilesMap& extra_files,
+    bool bytecode_format) {
+  script::Module snapshot = snapshotForAsyncSave(module);
+  return std::async(
+      std::launch::async,
+      [snapshot, filename, extra_files, bytecode_format]() {
+        ExportModule(snapshot, filename, extra_files, bytecode_format);
+      });
+}
+
 } // namespace jit
 } // namespace torch
@@ -44,6 +44,38 @@ IValue Function::operator()(
   return stack.front();
 }
 
+IValue Function::invokeTrusted(std::vector<IValue> stack) {
+  const FunctionSchema& schema = getSchema();
+  // Arity is the only check kept in release builds; it is O(1) and catches
+  // the common misuse of passing an incomplete stack.
+  TORCH_CHECK(
+      stack.size() == schema.arguments().size(),
+      "invokeTrusted expects a complete positional stack for '",
+      name(),
+      "', but got ",
+      stack.size(),
+      " argument(s) for a schema with ",
+      schema.arguments().size(),
+      " argument(s). Declaration: ",
+      schema);
+#ifndef NDEBUG
+  for (size_t i = 0; i < stack.size(); ++i) {
+    TORCH_INTERNAL_ASSERT(
+        stack[i].type()->isSubtypeOf(schema.arguments()[i].type()),
+        "invokeTrusted called on '",
+        name(),
+        "' with an argument of type ",
+        stack[i].type()->python_str(),
+        " in position ",
+        i,
+        ", which does not match the schema. Declaration: ",
+        schema);
+  }
+#endif
+  run(stack);
+  return stack.front();
+}
+
 void Function::ensure_defined() {
   if (function_creator_) {
     auto creator = function_creator_;
@@ -33,6 +33,15 @@ struct TORCH_API Function {
       std::vector<IValue> stack,
       const Kwargs& kwargs = Kwargs());
 
+  // Calls the function without per-call schema validation. The stack must
+  // be complete and positional (defaults already applied, no kwargs) and
+  // its types must have been verified against getSchema() by the caller,
+  // e.g. statically when the calling code was compiled. Untrusted callers
+  // should use operator(), which validates and normalizes the stack.
+  // Interpreter-emitted calls already enter the callee unvalidated and do
+  // not go through this entry point.
+  IValue invokeTrusted(std::vector<IValue> stack);
+
   std::shared_ptr<Graph> graph() const {
     return graph_;
   }
@@ -104,6 +113,14 @@ struct TORCH_API Function {
     return executor_;
   }
 
+  // whether get_executor() has already created the executor; lets callers
+  // (e.g. profile serialization during export) inspect executors without
+  // forcing compilation of never-run functions
+  bool has_executor() const {
+    std::lock_guard<std::recursive_mutex> lock(compile_mutex);
+    return static_cast<bool>(executor_);
+  }
+
  private:
   c10::QualifiedName name_;
   // The original, non-optimized graph
@@ -280,7 +280,22 @@ std::shared_ptr<FusedKernel> compileKernel(
   }
 
   const bool use_cuda = device.is_cuda();
-  const std::string name = "kernel_" + c10::to_string(next_kernel_id++);
+  std::string name;
+  if (persistentCacheEnabled()) {
+    // Derive the kernel name from a stable hash of the specialization
+    // instead of the process-local counter, so the generated source is
+    // byte-identical across processes and cached binaries can be reused;
+    // see Note [Persistent fused kernel cache] in kernel_cache.cpp.
+    const size_t seed = torch::get_hash(
+        spec.graph()->toString(false),
+        arg_spec.hashCode(),
+        map_size,
+        static_cast<int>(device.type()));
+    name = "kernel_" + c10::to_string(seed);
+    next_kernel_id++;
+  } else {
+    name = "kernel_" + c10::to_string(next_kernel_id++);
+  }
   std::string code =
       generateKernel(name, *graph, flat_inputs, flat_outputs, use_cuda);
   const FusedKernelConstructor& kernel_ctor =
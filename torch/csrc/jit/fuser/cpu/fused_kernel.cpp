@@ -4,9 +4,11 @@
 #include <torch/csrc/jit/code_template.h>
 #include <torch/csrc/jit/fuser/compiler.h>
 #include <torch/csrc/jit/fuser/cpu/temp_file.h>
+#include <torch/csrc/jit/fuser/kernel_cache.h>
 #include <torch/csrc/utils/memory.h>
 
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -186,9 +188,14 @@ struct CompilerConfig {
   #ifdef _MSC_VER
     std::string cxx = "cl";
     const std::string openmp_flags = "/openmp";
+    // MSVC has no equivalent of -fopenmp-simd.
+    const std::string openmp_fallback_flags = "";
   #else
     std::string cxx = "g++";
     const std::string openmp_flags = "-fopenmp";
+    // When linking against the OpenMP runtime fails, still honor the simd
+    // pragmas in the generated kernel so the loop body stays vectorized.
+    const std::string openmp_fallback_flags = "-fopenmp-simd";
   #endif
   bool openmp = true;
 };
@@ -247,7 +254,9 @@ static void runCompiler(
   auto& config = getConfig();
   TemplateEnv env;
   env.s("cxx", config.cxx);
-  env.s("fopenmp", config.openmp ? config.openmp_flags : "");
+  env.s(
+      "fopenmp",
+      config.openmp ? config.openmp_flags : config.openmp_fallback_flags);
   env.s("cpp_file", cpp_file);
   env.s("so_file", so_file);
   std::string result = format(compile_string, env);
@@ -296,13 +305,32 @@ FusedKernelCPU::FusedKernelCPU(
           has_random) {
   TempFile so_file(so_template, so_suffix_len);
   TempFile cpp_file(cpp_template, cpp_suffix_len);
-  cpp_file.write(code_);
-  cpp_file.sync();
+  // See Note [Persistent fused kernel cache] in kernel_cache.cpp. Cached
+  // shared objects are written into the usual temp file and dlopen'd from
+  // there, so the load path below is identical either way.
+  const std::string cache_key = name_ + "_cpu";
+  if (auto cached_so = loadPersistentKernel(cache_key, code_)) {
+    so_file.write(*cached_so);
+    so_file.sync();
 #ifdef _MSC_VER
-  so_file.close();
-  cpp_file.close();
+    so_file.close();
+    cpp_file.close();
 #endif
-  runCompiler(cpp_file.name(), so_file.name());
+  } else {
+    cpp_file.write(code_);
+    cpp_file.sync();
+#ifdef _MSC_VER
+    so_file.close();
+    cpp_file.close();
+#endif
+    runCompiler(cpp_file.name(), so_file.name());
+    std::ifstream so_in(so_file.name(), std::ios::in | std::ios::binary);
+    if (so_in) {
+      std::ostringstream so_contents;
+      so_contents << so_in.rdbuf();
+      storePersistentKernel(cache_key, code_, so_contents.str());
+    }
+  }
   if (debugFuser() >= 2)
     disas(so_file.name());
   so_lib = make_unique<at::DynamicLibrary>(so_file.name().c_str());
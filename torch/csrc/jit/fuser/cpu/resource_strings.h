@@ -17,16 +17,26 @@ static auto type_declarations_template = CodeTemplate(R"(
 #define POS_INFINITY INFINITY
 #define NEG_INFINITY -INFINITY
 
+#ifdef _MSC_VER
+#define RESTRICT __restrict
+#else
+#define RESTRICT __restrict__
+#endif
+
 typedef ${IndexType} IndexType;
+// The fuser never emits in-place kernels: output tensors are freshly
+// allocated and never alias the inputs, so the data pointers can be marked
+// restrict. Without it the compiler must assume stores to an output may
+// clobber an input and refuses to vectorize the loop body.
 template<typename T, size_t N>
 struct TensorInfo {
-  T* data;
+  T* RESTRICT data;
   IndexType sizes[N];
   IndexType strides[N];
 };
 template<typename T>
 struct TensorInfo<T, 0> {
-  T * data;
+  T* RESTRICT data;
 };
 )");
 
@@ -78,7 +88,14 @@ using int_same_size_t = typename int_of_size<sizeof(T)>::type;
 
 #define OMP_THRESHOLD 100000
 static void ${kernelName}_kernel(IndexType totalElements, ${formals}) {
+// MSVC's OpenMP support predates the simd construct; everywhere else ask
+// for vectorization explicitly so the loop is vectorized even when the
+// trip count check disables threading (and under -fopenmp-simd builds).
+#ifdef _MSC_VER
   #pragma omp parallel for if(totalElements > OMP_THRESHOLD)
+#else
+  #pragma omp parallel for simd if(totalElements > OMP_THRESHOLD)
+#endif
   for (IndexTypeLoop linearIndex = 0;
         linearIndex < ToIndexTypeLoop(totalElements);
         linearIndex += 1) {
@@ -1,5 +1,6 @@
 #include <torch/csrc/jit/fuser/cuda/fused_kernel.h>
 #include <torch/csrc/jit/fuser/compiler.h>
+#include <torch/csrc/jit/fuser/kernel_cache.h>
 
 #include <ATen/ATen.h>
 #include <ATen/cuda/CUDAContext.h>
@@ -103,37 +104,48 @@ FusedKernelCUDA::FusedKernelCUDA(
   int major, minor;
   getMajorMinor(prop_, major, minor);
 
-  // Creates the NVRTC program
-  nvrtcProgram program;
-  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcCreateProgram(
-      &program, code_.c_str(), nullptr, 0, nullptr, nullptr));
+  // Key for the on-disk binary cache: the name encodes the specialization
+  // hash and the arch suffix covers "same kernel, different GPU"; see
+  // Note [Persistent fused kernel cache] in kernel_cache.cpp.
+  const std::string cache_key =
+      name_ + "_compute_" + std::to_string(major) + std::to_string(minor);
+  if (auto cached_ptx = loadPersistentKernel(cache_key, code_)) {
+    ptx_.assign(cached_ptx->begin(), cached_ptx->end());
+  } else {
+    // Creates the NVRTC program
+    nvrtcProgram program;
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcCreateProgram(
+        &program, code_.c_str(), nullptr, 0, nullptr, nullptr));
 
 #ifdef __HIP_PLATFORM_HCC__
-  std::vector<const char*> args = {};
+    std::vector<const char*> args = {};
 #else
-  const std::string compute = "--gpu-architecture=compute_" +
-      std::to_string(major) + std::to_string(minor);
-  const std::vector<const char*> args = {
-      "--std=c++14", compute.c_str(), "-default-device"};
+    const std::string compute = "--gpu-architecture=compute_" +
+        std::to_string(major) + std::to_string(minor);
+    const std::vector<const char*> args = {
+        "--std=c++14", compute.c_str(), "-default-device"};
 #endif
-  const auto result =
-      nvrtc().nvrtcCompileProgram(program, args.size(), args.data());
-  if (result != NVRTC_SUCCESS) {
-    size_t logsize;
-    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetProgramLogSize(program, &logsize));
-    std::vector<char> log(logsize);
-    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetProgramLog(program, log.data()));
-    std::stringstream cu;
-    cu << log.data();
-    throw std::runtime_error(cu.str());
+    const auto result =
+        nvrtc().nvrtcCompileProgram(program, args.size(), args.data());
+    if (result != NVRTC_SUCCESS) {
+      size_t logsize;
+      AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetProgramLogSize(program, &logsize));
+      std::vector<char> log(logsize);
+      AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetProgramLog(program, log.data()));
+      std::stringstream cu;
+      cu << log.data();
+      throw std::runtime_error(cu.str());
+    }
+    ResourceGuard holdProgram(
+        [&] { AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcDestroyProgram(&program)); });
+    AT_CUDA_NVRTC_CHECK(result);
+    size_t ptx_size;
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTXSize(program, &ptx_size));
+    ptx_.resize(ptx_size);
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTX(program, ptx_.data()));
+    storePersistentKernel(
+        cache_key, code_, std::string(ptx_.data(), ptx_.size()));
   }
-  ResourceGuard holdProgram(
-      [&] { AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcDestroyProgram(&program)); });
-  AT_CUDA_NVRTC_CHECK(result);
-  size_t ptx_size;
-  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTXSize(program, &ptx_size));
-  ptx_.resize(ptx_size);
-  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTX(program, ptx_.data()));
 
   AT_CUDA_DRIVER_CHECK(nvrtc().cuModuleLoadData(&module_, ptx_.data()));
   AT_CUDA_DRIVER_CHECK(
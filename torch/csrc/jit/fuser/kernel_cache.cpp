@@ -3,7 +3,11 @@
 #include <torch/csrc/jit/passes/shape_analysis.h>
 
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <mutex>
+#include <sstream>
 #include <unordered_map>
 
 namespace torch {
@@ -87,6 +91,102 @@ at::optional<KernelSpec*> lookupGraph(std::shared_ptr<Graph> graph) {
   return nolock_retrieve(cache, it->second);
 }
 
+// Note [Persistent fused kernel cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The in-process caches above die with the process, so every restart pays
+// full NVRTC/cc compilation for every fusion group. When the directory
+// named by PYTORCH_KERNEL_CACHE_PATH exists, backends additionally persist
+// compiled binaries there as a pair of files per kernel:
+//
+//   <key>.src  the exact generated source the binary was built from
+//   <key>.bin  the compiled artifact (PTX or shared object contents)
+//
+// The key is chosen by the backend and must include everything that affects
+// the binary besides the source itself (e.g. the GPU compute capability).
+// On load the stored source is compared byte-for-byte against the source
+// about to be compiled; any mismatch (including a stale cache from a
+// different build) falls back to compilation. Writes go to a temp file that
+// is renamed into place so concurrent processes sharing a cache directory
+// never observe partial entries. All failures are treated as cache misses;
+// the cache is purely an optimization.
+
+static const char* persistentCachePath() {
+  static const char* path = std::getenv("PYTORCH_KERNEL_CACHE_PATH");
+  return path;
+}
+
+bool persistentCacheEnabled() {
+  return persistentCachePath() != nullptr;
+}
+
+static std::string persistentCacheFile(
+    const std::string& key,
+    const char* suffix) {
+  return std::string(persistentCachePath()) + "/" + key + suffix;
+}
+
+static at::optional<std::string> readFile(const std::string& filename) {
+  std::ifstream in(filename, std::ios::in | std::ios::binary);
+  if (!in) {
+    return at::nullopt;
+  }
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  if (!in) {
+    return at::nullopt;
+  }
+  return contents.str();
+}
+
+static bool writeFileAtomically(
+    const std::string& filename,
+    const std::string& contents) {
+  const std::string tmp_name = filename + ".tmp";
+  {
+    std::ofstream out(
+        tmp_name, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out) {
+      return false;
+    }
+    out.write(contents.data(), contents.size());
+    if (!out) {
+      std::remove(tmp_name.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_name.c_str(), filename.c_str()) != 0) {
+    std::remove(tmp_name.c_str());
+    return false;
+  }
+  return true;
+}
+
+at::optional<std::string> loadPersistentKernel(
+    const std::string& key,
+    const std::string& source) {
+  if (!persistentCacheEnabled()) {
+    return at::nullopt;
+  }
+  const auto stored_source = readFile(persistentCacheFile(key, ".src"));
+  if (!stored_source || *stored_source != source) {
+    return at::nullopt;
+  }
+  return readFile(persistentCacheFile(key, ".bin"));
+}
+
+void storePersistentKernel(
+    const std::string& key,
+    const std::string& source,
+    const std::string& binary) {
+  if (!persistentCacheEnabled()) {
+    return;
+  }
+  // the binary goes first so that a matching .src implies a complete entry
+  if (writeFileAtomically(persistentCacheFile(key, ".bin"), binary)) {
+    writeFileAtomically(persistentCacheFile(key, ".src"), source);
+  }
+}
+
 } // namespace fuser
 } // namespace jit
 } // namespace torch
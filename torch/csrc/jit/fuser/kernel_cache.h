@@ -31,6 +31,29 @@ TORCH_API at::optional<KernelSpec*> retrieve(const int64_t key);
 // Only used for testing.
 TORCH_API int64_t debugNumCachedKernelSpecs();
 
+// Persistent fused kernel cache. When the PYTORCH_KERNEL_CACHE_PATH
+// environment variable is set to a writable directory, compiled kernel
+// binaries (PTX for the CUDA backend, shared objects for the CPU backend)
+// are stored there and reloaded on subsequent runs, so a restarted process
+// skips NVRTC/compiler invocations for kernels it has seen before. See
+// Note [Persistent fused kernel cache] in kernel_cache.cpp.
+
+// Whether the persistent cache is enabled (i.e. the directory is set).
+TORCH_API bool persistentCacheEnabled();
+
+// Returns the cached binary for `key` if present and its recorded source
+// matches `source` exactly; nullopt otherwise.
+TORCH_API c10::optional<std::string> loadPersistentKernel(
+    const std::string& key,
+    const std::string& source);
+
+// Best-effort store of `binary` (and `source`, for validation) under `key`.
+// Failures are silently ignored; the cache is purely an optimization.
+TORCH_API void storePersistentKernel(
+    const std::string& key,
+    const std::string& source,
+    const std::string& binary);
+
 } // namespace fuser
 } // namespace jit
 } // namespace torch
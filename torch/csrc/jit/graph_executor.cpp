@@ -12,7 +12,9 @@
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/pass_manager.h>
 #include <torch/csrc/jit/passes/batch_mm.h>
+#include <torch/csrc/jit/passes/batch_parallel_chains.h>
 #include <torch/csrc/jit/passes/canonicalize_ops.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
 #include <torch/csrc/jit/passes/common_subexpression_elimination.h>
 #include <torch/csrc/jit/passes/constant_pooling.h>
 #include <torch/csrc/jit/passes/constant_propagation.h>
@@ -41,11 +43,13 @@
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/jit/script/logging.h>
 
+#include <condition_variable>
 #include <cstdint>
 #include <iterator>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -477,12 +481,33 @@ void GraphExecutorImplBase::run(Stack& stack) {
   logging::getLogger()->addStatValue(
       logging::runtime_counters::GRAPH_EXECUTOR_INVOCATIONS, 1.0);
 
+  // See Note [Frozen execution plan]
+  if (const ExecutionPlan* frozen = frozenPlan()) {
+    InterpreterState(frozen->code).run(stack);
+    last_executed_optimized_graph = frozen->graph;
+    return;
+  }
+
   ExecutionPlan plan =
       getPlanFor(stack, GraphExecutor::getDefaultNumBailOuts());
   InterpreterState(plan.code).run(stack);
   last_executed_optimized_graph = plan.graph;
 }
 
+void GraphExecutorImplBase::freezePlan(Stack& stack) {
+  // A bailout depth of zero disables profiling and bailout/guard insertion
+  // in both executors; the legacy executor still specializes the plan for
+  // the signature of `stack` through its ArgumentSpec path.
+  frozen_plan_ = getPlanFor(stack, 0);
+  has_frozen_plan_.store(true, std::memory_order_release);
+}
+
+void GraphExecutorImplBase::unfreezePlan() {
+  // Only the flag is cleared; the plan itself is left in place so that a
+  // concurrent run that already observed the flag keeps a valid plan.
+  has_frozen_plan_.store(false, std::memory_order_release);
+}
+
 // a Graph can be created via tracing, or via a language-based frontend
 // GraphExecutor runs it. It can run the same graph on many different sizes
 // and different requires_grad states, and handles specializations for each
@@ -531,19 +556,41 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
     // path ArgumentSpec even computes its hashCode here.
     ArgumentSpec spec =
         arg_spec_creator_.create(autograd::GradMode::is_enabled(), stack);
-    {
-      std::lock_guard<std::mutex> lock(compile_mutex);
+    std::unique_lock<std::mutex> lock(compile_mutex);
+    while (true) {
       auto it = plan_cache.find(spec);
       if (it != plan_cache.end()) {
         logging::getLogger()->addStatValue(
             logging::runtime_counters::EXECUTION_PLAN_CACHE_HIT, 1.0);
         return it->second;
       }
-      auto plan = compileSpec(spec);
+      if (in_flight_specs.count(spec) == 0) {
+        break;
+      }
+      // Another thread is already compiling a plan for this spec. Wait for
+      // it to publish the result rather than compiling the same spec twice.
+      compile_done.wait(lock);
+    }
+    // Compile outside the lock so that independent specs (and independent
+    // executors sharing caller threads) can compile concurrently. The
+    // in-flight set keeps a second thread with the same spec from starting
+    // a duplicate compilation in the meantime.
+    in_flight_specs.insert(spec);
+    lock.unlock();
+    try {
+      ExecutionPlan plan = compileSpec(spec);
+      lock.lock();
+      in_flight_specs.erase(spec);
       auto r = plan_cache.emplace(std::move(spec), std::move(plan));
       logging::getLogger()->addStatValue(
           logging::runtime_counters::EXECUTION_PLAN_CACHE_MISS, 1.0);
+      compile_done.notify_all();
       return r.first->second;
+    } catch (...) {
+      lock.lock();
+      in_flight_specs.erase(spec);
+      compile_done.notify_all();
+      throw;
     }
   }
 
@@ -554,11 +601,12 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
 
     // Phase 0. Inline functions, then clean up any artifacts that the inliner
     //          left in that may inhibit optimization
-    Inline(*opt_graph);
-    LowerGradOf(*opt_graph);
-    specializeAutogradZero(*opt_graph);
-    LowerSimpleTuples(opt_graph);
-    ConstantPooling(opt_graph);
+    JIT_TIMED_PASS("Inline", opt_graph, Inline(*opt_graph));
+    JIT_TIMED_PASS("LowerGradOf", opt_graph, LowerGradOf(*opt_graph));
+    JIT_TIMED_PASS(
+        "specializeAutogradZero", opt_graph, specializeAutogradZero(*opt_graph));
+    JIT_TIMED_PASS("LowerSimpleTuples", opt_graph, LowerSimpleTuples(opt_graph));
+    JIT_TIMED_PASS("ConstantPooling", opt_graph, ConstantPooling(opt_graph));
 
     // Phase 1. Specialize to input definedness (this is very important for
     //          gradient graphs), and run required passes to bring the graph
@@ -570,9 +618,12 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
     //          Shape propagation sometimes depends on certain arguments being
     //          constants, and constant propagation doesn't need shape
     //          information anyway, so it's better to run it first.
-    ConstantPropagation(opt_graph);
-    PropagateInputShapes(opt_graph);
-    PropagateRequiresGrad(opt_graph);
+    JIT_TIMED_PASS(
+        "ConstantPropagation", opt_graph, ConstantPropagation(opt_graph));
+    JIT_TIMED_PASS(
+        "PropagateInputShapes", opt_graph, PropagateInputShapes(opt_graph));
+    JIT_TIMED_PASS(
+        "PropagateRequiresGrad", opt_graph, PropagateRequiresGrad(opt_graph));
 
     // Phase 3. Run differentiable optimizations (i.e. simple graph rewrites
     //          that we can still execute using autograd).
@@ -621,6 +672,12 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
   // Mapping from argument configurations to optimized versions of the graph
   // that are specialized to the spec.
   std::unordered_map<ArgumentSpec, ExecutionPlan> plan_cache;
+
+  // Specs whose plans are currently being compiled outside compile_mutex;
+  // threads that race on one of these wait on compile_done instead of
+  // compiling the spec a second time.
+  std::unordered_set<ArgumentSpec> in_flight_specs;
+  std::condition_variable compile_done;
 };
 
 GraphExecutor::GraphExecutor(std::shared_ptr<Graph> graph)
@@ -641,9 +698,21 @@ size_t GraphExecutor::getDefaultNumBailOuts() {
 ExecutionPlan GraphExecutor::getPlanFor(
     Stack& inputs,
     size_t remaining_bailout_depth) {
+  // See Note [Frozen execution plan]
+  if (const ExecutionPlan* frozen = pImpl->frozenPlan()) {
+    return *frozen;
+  }
   return pImpl->getPlanFor(inputs, remaining_bailout_depth);
 }
 
+void GraphExecutor::freezeExecutionPlan(Stack& inputs) {
+  pImpl->freezePlan(inputs);
+}
+
+void GraphExecutor::unfreezeExecutionPlan() {
+  pImpl->unfreezePlan();
+}
+
 std::shared_ptr<Graph> GraphExecutor::graph() const {
   return pImpl->graph;
 }
@@ -652,6 +721,14 @@ GraphExecutorState GraphExecutor::getDebugState() {
   return pImpl->getDebugState();
 }
 
+IValue GraphExecutor::serializeProfiles() {
+  return pImpl->serializeProfiles();
+}
+
+void GraphExecutor::warmStartWithProfiles(const IValue& profiles) {
+  pImpl->warmStartWithProfiles(profiles);
+}
+
 void runRequiredPasses(const std::shared_ptr<Graph>& g) {
   // implicit inserted expand nodes are not necessarily always valid
   // when used inside script methods that might have unstable shapes
@@ -711,49 +788,67 @@ void runNondiffOptimization(
     std::shared_ptr<Graph>& graph,
     bool strict_fuser_check) {
   // Run custom passes that different backends can register.
-  for (const auto& pass : getCustomPreFusionPasses()) {
-    pass(graph);
-  }
+  JIT_TIMED_PASS("CustomPreFusionPasses", graph, {
+    for (const auto& pass : getCustomPreFusionPasses()) {
+      pass(graph);
+    }
+  });
 
   // decomposition pass, decompose certain ops that will be used in the
   // following passes (like batchmm and jit fusion)
   if (!getProfilingMode()) {
-    DecomposeOps(graph);
+    JIT_TIMED_PASS("DecomposeOps", graph, DecomposeOps(graph));
   }
 
   // TupleConstruct / TupleUnpack pairs can still be present at this point
   // and must be removed for fusion.
-  LowerSimpleTuples(graph);
+  JIT_TIMED_PASS("LowerSimpleTuples", graph, LowerSimpleTuples(graph));
 
   // Rewrite subgraphs with many MMs into expressions that batch them.
-  BatchMM(graph);
+  JIT_TIMED_PASS("BatchMM", graph, BatchMM(graph));
+  // Batch groups of identical, independent matmul + bias/activation chains
+  // (which BatchMM does not catch) when complete shapes are known.
+  JIT_TIMED_PASS("BatchParallelChains", graph, BatchParallelChains(graph));
 
   // Fuse the dequant - op - quant patterns into quantized ops
-  QuantFusion(graph);
+  JIT_TIMED_PASS("QuantFusion", graph, QuantFusion(graph));
 
-  FuseGraph(graph, strict_fuser_check);
+  JIT_TIMED_PASS("FuseGraph", graph, FuseGraph(graph, strict_fuser_check));
 
   // Run custom post-fusion passes
-  for (const auto& pass : getCustomPostFusionPasses()) {
-    pass(graph);
-  }
+  JIT_TIMED_PASS("CustomPostFusionPasses", graph, {
+    for (const auto& pass : getCustomPostFusionPasses()) {
+      pass(graph);
+    }
+  });
 }
 
 void runOptimization(std::shared_ptr<Graph>& graph) {
-  // Basic graph preprocessing to eliminate noise.
-  EliminateDeadCode(graph);
-  EliminateCommonSubexpression(graph);
-
-  PeepholeOptimize(graph);
-  ConstantPropagation(graph);
-  ConstantPooling(graph);
+  // Basic graph preprocessing to eliminate noise. DCE and CSE only delete
+  // nodes, so they can share one AliasDb through the incremental update API
+  // instead of each rebuilding it from scratch.
+  {
+    AliasDb aliasDb(graph);
+    JIT_TIMED_PASS("EliminateDeadCode", graph, EliminateDeadCode(graph, aliasDb));
+    JIT_TIMED_PASS(
+        "EliminateCommonSubexpression",
+        graph,
+        EliminateCommonSubexpression(graph, aliasDb));
+  }
+
+  JIT_TIMED_PASS("PeepholeOptimize", graph, PeepholeOptimize(graph));
+  JIT_TIMED_PASS("ConstantPropagation", graph, ConstantPropagation(graph));
+  JIT_TIMED_PASS("ConstantPooling", graph, ConstantPooling(graph));
 
   // Unroll small loops, and eliminate expressions that are the same at every
   // iteration.
-  UnrollLoops(graph);
-  EliminateCommonSubexpression(graph);
+  JIT_TIMED_PASS("UnrollLoops", graph, UnrollLoops(graph));
+  JIT_TIMED_PASS(
+      "EliminateCommonSubexpression",
+      graph,
+      EliminateCommonSubexpression(graph));
 
-  CheckInplace(graph);
+  JIT_TIMED_PASS("CheckInplace", graph, CheckInplace(graph));
 }
 
 } // namespace jit
@@ -54,12 +54,29 @@ struct TORCH_API GraphExecutor {
   // `GraphExecutor` will be created. This new `GraphExecutor`'s
   // remaining_bailout_depth will be reduced by 1.
   ExecutionPlan getPlanFor(Stack& inputs, size_t remaining_bailout_depth);
+  // Pin the plan compiled for the signature of `inputs`: subsequent calls
+  // bypass ArgumentSpec computation, guard checks and the plan cache and run
+  // the pinned plan directly. The plan is compiled without profiling or
+  // bailouts, so this is only appropriate when every call uses the same
+  // input signature. See Note [Frozen execution plan] in
+  // graph_executor_impl.h.
+  void freezeExecutionPlan(Stack& inputs);
+  void unfreezeExecutionPlan();
   explicit operator bool() const {
     return pImpl != nullptr;
   }
   std::shared_ptr<Graph> graph() const;
   GraphExecutorState getDebugState();
 
+  // Warm-start support for the profiling executor: serializeProfiles
+  // snapshots the runtime profiles gathered so far (None if the executor
+  // hasn't finished profiling or doesn't profile at all) and
+  // warmStartWithProfiles seeds a fresh executor with a snapshot so it
+  // compiles optimized plans on the first call. See
+  // ProfilingRecord::serializeProfiles.
+  IValue serializeProfiles();
+  void warmStartWithProfiles(const IValue& profiles);
+
   static size_t getDefaultNumBailOuts();
 
  private:
@@ -64,10 +64,35 @@ struct GraphExecutorImplBase {
   // entry point where execution begins
   void run(Stack& stack);
 
+  // Note [Frozen execution plan]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Services that only ever see a single input signature can pin the plan
+  // compiled for that signature. Once frozen, run() and
+  // GraphExecutor::getPlanFor skip ArgumentSpec computation, guard checks
+  // and the plan cache lookup and execute the pinned plan directly. The
+  // plan is compiled with a bailout depth of zero, so it contains no
+  // profiling or bailout nodes. Freezing is meant to happen once, before
+  // serving traffic; the caller is responsible for only feeding inputs
+  // that match the frozen signature afterwards.
+  void freezePlan(Stack& stack);
+  void unfreezePlan();
+  const ExecutionPlan* frozenPlan() const {
+    return has_frozen_plan_.load(std::memory_order_acquire) ? &frozen_plan_
+                                                            : nullptr;
+  }
+
   virtual ExecutionPlan getPlanFor(
       Stack& stack,
       size_t remaining_bailout_depth) = 0;
   virtual GraphExecutorState getDebugState() = 0;
+
+  // Warm-start support (see ProfilingRecord::serializeProfiles). Executors
+  // that don't gather runtime profiles have nothing to save or restore.
+  virtual IValue serializeProfiles() {
+    return IValue();
+  }
+  virtual void warmStartWithProfiles(const IValue& profiles) {}
+
   virtual ~GraphExecutorImplBase() = default;
 
  protected:
@@ -86,6 +111,12 @@ struct GraphExecutorImplBase {
   // GraphExecutors can be accessed from multiple threads, so this thread needs
   // to be held every time we access the fallback or plan_cache.
   std::mutex compile_mutex;
+
+  // See Note [Frozen execution plan]. The plan is published with a release
+  // store on has_frozen_plan_ and is never mutated while the flag is set, so
+  // readers only need the acquire load in frozenPlan().
+  ExecutionPlan frozen_plan_;
+  std::atomic<bool> has_frozen_plan_{false};
 };
 
 } // namespace jit
@@ -13,12 +13,15 @@
 #include <torch/csrc/jit/source_range_serialization.h>
 
 #include "caffe2/serialize/file_adapter.h"
+#include "caffe2/serialize/mmap_adapter.h"
 #include "caffe2/serialize/inline_container.h"
 #include "caffe2/serialize/istream_adapter.h"
 
 #include <ATen/ATen.h>
 
+#include <cstring>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -27,6 +30,7 @@ namespace torch {
 namespace jit {
 
 using caffe2::serialize::FileAdapter;
+using caffe2::serialize::MmapFileAdapter;
 using caffe2::serialize::IStreamAdapter;
 using caffe2::serialize::PyTorchStreamReader;
 using caffe2::serialize::ReadAdapterInterface;
@@ -54,12 +58,89 @@ void postSetStateValidate(const IValue& v) {
   }
 }
 
+namespace {
+
+// Process-wide content-addressed registry behind `share_weights` loads.
+// Every deduplicated tensor record is registered under its (hash, size); a
+// later load whose record matches byte-for-byte gets a view into the
+// already-resident copy instead of keeping its own. Entries are weak: once
+// every module holding a storage is gone, the bytes are freed and the entry
+// is reclaimed on the next lookup that walks its bucket.
+class SharedWeightRegistry {
+ public:
+  static SharedWeightRegistry& singleton() {
+    static SharedWeightRegistry registry;
+    return registry;
+  }
+
+  at::DataPtr dedup(at::DataPtr&& data, size_t size) {
+    if (data.device().type() != at::DeviceType::CPU || size == 0) {
+      return std::move(data);
+    }
+    const uint64_t hash =
+        contentHash(static_cast<const char*>(data.get()), size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = entries_.equal_range(hash);
+    for (auto it = range.first; it != range.second;) {
+      auto held = it->second.data.lock();
+      if (held == nullptr) {
+        it = entries_.erase(it);
+        continue;
+      }
+      if (it->second.size == size &&
+          std::memcmp(held->get(), data.get(), size) == 0) {
+        return makeView(std::move(held));
+      }
+      ++it;
+    }
+    auto shared = std::make_shared<at::DataPtr>(std::move(data));
+    entries_.emplace(hash, Entry{shared, size});
+    return makeView(std::move(shared));
+  }
+
+ private:
+  struct Entry {
+    std::weak_ptr<at::DataPtr> data;
+    size_t size;
+  };
+
+  // A non-owning view whose context keeps the shared record alive; the same
+  // pattern the Unpickler uses for consolidated-record storages.
+  static at::DataPtr makeView(std::shared_ptr<at::DataPtr> record) {
+    void* ptr = record->get();
+    auto* ctx = new std::shared_ptr<at::DataPtr>(std::move(record));
+    return at::DataPtr(
+        ptr,
+        ctx,
+        [](void* ctx) {
+          delete static_cast<std::shared_ptr<at::DataPtr>*>(ctx);
+        },
+        at::DeviceType::CPU);
+  }
+
+  static uint64_t contentHash(const char* data, size_t size) {
+    // 64 bit FNV-1a; collisions are resolved by the memcmp above.
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+      hash = (hash ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+  std::mutex mutex_;
+  std::unordered_multimap<uint64_t, Entry> entries_;
+};
+
+} // namespace
+
 IValue readArchiveAndTensors(
     const std::string& archive_name,
     c10::optional<TypeResolver> type_resolver,
     c10::optional<ObjLoader> obj_loader,
     c10::optional<at::Device> device,
-    PyTorchStreamReader& stream_reader) {
+    PyTorchStreamReader& stream_reader,
+    bool share_weights) {
   std::string picklename = archive_name + ".pkl";
   at::DataPtr pickle_ptr;
   size_t pickle_size;
@@ -82,7 +163,14 @@ IValue readArchiveAndTensors(
   std::string archive_name_plus_slash = archive_name + "/";
   auto read_record = [&](const std::string& name) {
     std::string ss = archive_name_plus_slash + name;
-    return std::get<0>(stream_reader.getRecord(ss));
+    at::DataPtr record;
+    size_t record_size;
+    std::tie(record, record_size) = stream_reader.getRecord(ss);
+    if (share_weights) {
+      return SharedWeightRegistry::singleton().dedup(
+          std::move(record), record_size);
+    }
+    return record;
   };
 
   Unpickler unpickler(
@@ -120,14 +208,17 @@ class ScriptModuleDeserializer final {
 
   script::Module deserialize(
       c10::optional<at::Device> device,
-      script::ExtraFilesMap& extra_files);
+      script::ExtraFilesMap& extra_files,
+      bool share_weights = false);
 
  private:
   IValue readArchive(const std::string& archive_name);
+  void loadWarmStartProfiles(script::Module& module);
 
   std::shared_ptr<script::CompilationUnit> compilation_unit_;
   std::unique_ptr<PyTorchStreamReader> reader_;
   c10::optional<at::Device> device_;
+  bool share_weights_ = false;
   std::vector<at::Tensor> constants_table_;
   script::SourceImporter source_importer_;
   std::string export_prefix_ = "code/";
@@ -174,14 +265,21 @@ IValue ScriptModuleDeserializer::readArchive(const std::string& archive_name) {
   };
 
   return readArchiveAndTensors(
-      archive_name, type_resolver, obj_loader, device_, *reader_.get());
+      archive_name,
+      type_resolver,
+      obj_loader,
+      device_,
+      *reader_.get(),
+      share_weights_);
 }
 
 script::Module ScriptModuleDeserializer::deserialize(
     c10::optional<at::Device> device,
-    script::ExtraFilesMap& extra_files) {
+    script::ExtraFilesMap& extra_files,
+    bool share_weights) {
   C10_LOG_API_USAGE_ONCE("torch.script.load");
   device_ = device;
+  share_weights_ = share_weights;
   // Load extra files.
   for (const auto& kv : extra_files) {
     const std::string& key = "extra/" + kv.first;
@@ -205,7 +303,43 @@ script::Module ScriptModuleDeserializer::deserialize(
   for (auto constant : tuple->elements()) {
     constants_table_.push_back(constant.toTensor());
   }
-  return script::Module(readArchive("data").toObject());
+  auto module = script::Module(readArchive("data").toObject());
+  if (reader_->hasRecord("profiles.pkl")) {
+    loadWarmStartProfiles(module);
+  }
+  return module;
+}
+
+// Seed the module's executors with the runtime profiles the exporting
+// process gathered (see ScriptModuleSerializer::writeWarmStartProfiles), so
+// the profiling executor compiles optimized plans on the first call instead
+// of running slow profiling iterations. Stale or mismatched profiles are
+// skipped with a warning; the module still loads and simply profiles from
+// scratch.
+void ScriptModuleDeserializer::loadWarmStartProfiles(script::Module& module) {
+  std::unordered_map<std::string, IValue> by_qualname;
+  for (const auto& entry : readArchive("profiles").toTuple()->elements()) {
+    const auto& fields = entry.toTuple()->elements();
+    by_qualname.emplace(fields.at(0).toStringRef(), fields.at(1));
+  }
+  for (const script::Module& m : module.modules()) {
+    for (const auto& method : m.get_methods()) {
+      auto& fn = method.function();
+      auto it = by_qualname.find(fn.qualname().qualifiedName());
+      if (it == by_qualname.end()) {
+        continue;
+      }
+      try {
+        fn.get_executor().warmStartWithProfiles(it->second);
+      } catch (const std::exception& e) {
+        TORCH_WARN(
+            "ignoring warm-start profiles for ",
+            fn.qualname().qualifiedName(),
+            ": ",
+            e.what());
+      }
+    }
+  }
 }
 
 } // namespace
@@ -243,26 +377,37 @@ script::Module import_ir_module(
 script::Module load(
     std::istream& in,
     c10::optional<at::Device> device,
-    script::ExtraFilesMap& extra_files) {
+    script::ExtraFilesMap& extra_files,
+    bool share_weights) {
   std::unique_ptr<IStreamAdapter> rai =
       std::make_unique<IStreamAdapter>(&in);
-  auto module = load(std::move(rai), device, extra_files);
+  auto module = load(std::move(rai), device, extra_files, share_weights);
   return module;
 }
 
 script::Module load(
     const std::string& filename,
     c10::optional<at::Device> device,
-    script::ExtraFilesMap& extra_files) {
-  std::unique_ptr<FileAdapter> rai = std::make_unique<FileAdapter>(filename);
-  auto module = load(std::move(rai), device, extra_files);
+    script::ExtraFilesMap& extra_files,
+    bool use_mmap,
+    bool share_weights) {
+  std::unique_ptr<ReadAdapterInterface> rai;
+  if (use_mmap) {
+    // PyTorchStreamReader recognizes the mmap adapter and hands out tensor
+    // storages that alias the mapped pages; see getRecord.
+    rai = std::make_unique<MmapFileAdapter>(filename);
+  } else {
+    rai = std::make_unique<FileAdapter>(filename);
+  }
+  auto module = load(std::move(rai), device, extra_files, share_weights);
   return module;
 }
 
 script::Module load(
     std::unique_ptr<ReadAdapterInterface> rai,
     c10::optional<c10::Device> device,
-    script::ExtraFilesMap& extra_files) {
+    script::ExtraFilesMap& extra_files,
+    bool share_weights) {
   // Verify that we're loading a zip archive and not a torch.save pickle archive
   // (marked by the 0x80 0x02 bytes at the start)
   uint8_t first_short[2];
@@ -288,7 +433,7 @@ script::Module load(
   auto cu = std::make_shared<script::CompilationUnit>();
 
   ScriptModuleDeserializer deserializer(std::move(cu), std::move(reader));
-  return deserializer.deserialize(device, extra_files);
+  return deserializer.deserialize(device, extra_files, share_weights);
 }
 
 } // namespace jit
@@ -40,20 +40,43 @@ TORCH_API script::Module import_ir_module(
 ///
 /// The istream must contain a serialized `script::Module`, exported via
 /// `torch::jit::ExportModule` in C++.
+///
+/// When `share_weights` is true, CPU tensor storages are deduplicated
+/// through a process-wide content-addressed registry: a record whose bytes
+/// match one loaded earlier (by this or any other `share_weights` load)
+/// reuses the already-resident storage instead of getting its own copy, so
+/// N sessions over the same model keep one set of weights in memory. Shared
+/// storages must be treated as read-only -- mutating a parameter of one
+/// module would be visible in every module sharing its storage.
 TORCH_API script::Module load(
     std::istream& in,
     c10::optional<c10::Device> device = c10::nullopt,
-    script::ExtraFilesMap& extra_files = default_extra_files);
+    script::ExtraFilesMap& extra_files = default_extra_files,
+    bool share_weights = false);
 
 /// Loads a serialized `script::Module` from the given `filename`.
 ///
 /// The file stored at the location given in `filename` must contain a
 /// serialized `script::Module`, exported either via `ScriptModule.save()` in
 /// Python or `torch::jit::ExportModule` in C++.
+///
+/// When `use_mmap` is true the archive is memory-mapped instead of read into
+/// allocated buffers; CPU tensor storages then alias the mapped pages
+/// (read-only, copy-on-write), so the data is paged in lazily on first use
+/// and peak memory during loading stays close to the live model size. The
+/// archive must have been written uncompressed (the default for
+/// `ScriptModule.save()` / `torch::jit::ExportModule`). Not supported on
+/// Windows.
+/// `share_weights` deduplicates identical CPU tensor records against a
+/// process-wide registry; see the `istream` overload for the aliasing
+/// caveats. For sharing across processes, load the same file with
+/// `use_mmap` instead -- the kernel then shares the mapped pages.
 TORCH_API script::Module load(
     const std::string& filename,
     c10::optional<c10::Device> device = c10::nullopt,
-    script::ExtraFilesMap& extra_files = default_extra_files);
+    script::ExtraFilesMap& extra_files = default_extra_files,
+    bool use_mmap = false,
+    bool share_weights = false);
 
 /// Loads a serialized `script::Module` from the given `rai`.
 ///
@@ -63,14 +86,16 @@ TORCH_API script::Module load(
 TORCH_API script::Module load(
     std::unique_ptr<caffe2::serialize::ReadAdapterInterface> rai,
     c10::optional<c10::Device> device = c10::nullopt,
-    script::ExtraFilesMap& extra_files = default_extra_files);
+    script::ExtraFilesMap& extra_files = default_extra_files,
+    bool share_weights = false);
 
 TORCH_API IValue readArchiveAndTensors(
     const std::string& archive_name,
     c10::optional<TypeResolver> type_resolver,
     c10::optional<ObjLoader> obj_loader,
     c10::optional<at::Device> device,
-    caffe2::serialize::PyTorchStreamReader& stream_reader);
+    caffe2::serialize::PyTorchStreamReader& stream_reader,
+    bool share_weights = false);
 
 } // namespace jit
 } // namespace torch
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -28,5 +29,14 @@ std::shared_ptr<Source> findSourceInArchiveFromQualifier(
     const std::string& export_prefix,
     const std::string& qualifier);
 
+// Layout constants for the lazily-parsed mobile bytecode index record
+// ("bytecode.lazy.index"). The record is a flat binary: this magic, the
+// format version, the method count, then one length-prefixed qualified
+// name per method, in archive order. Method i is stored as its own
+// archive under "bytecode.lazy/<i>". Shared between export_module.cpp
+// and torch/csrc/jit/mobile/import.cpp.
+constexpr uint64_t kLazyByteCodeIndexMagic = 0x58444943424c5450ULL; // PTLBCIDX
+constexpr uint64_t kLazyByteCodeIndexVersion = 1;
+
 } // namespace jit
 } // namespace torch
@@ -18,6 +18,8 @@
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
 #include <torch/csrc/jit/passes/decompose_ops.h>
 #include <torch/csrc/jit/passes/erase_number_types.h>
+#include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/passes/mkldnn_prepack.h>
 #include <torch/csrc/jit/passes/fuse_linear.h>
 #include <torch/csrc/jit/passes/graph_fuser.h>
 #include <torch/csrc/jit/passes/inline_fork_wait.h>
@@ -25,6 +27,8 @@
 #include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_graph.h>
 #include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/memoize_subgraphs.h>
+#include <torch/csrc/jit/passes/memory_planning.h>
 #include <torch/csrc/jit/passes/onnx.h>
 #include <torch/csrc/jit/passes/onnx/cast_all_constant_to_floating.h>
 #include <torch/csrc/jit/passes/onnx/constant_fold.h>
@@ -40,8 +44,10 @@
 #include <torch/csrc/jit/passes/remove_expands.h>
 #include <torch/csrc/jit/passes/remove_inplace_ops.h>
 #include <torch/csrc/jit/passes/shape_analysis.h>
+#include <torch/csrc/jit/passes/shape_interpreter.h>
 #include <torch/csrc/jit/passes/specialize_autogradzero.h>
 #include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include <torch/csrc/jit/passes/tensor_core_advisor.h>
 #include <torch/csrc/jit/passes/tensorexpr_fuser.h>
 #include <torch/csrc/jit/passes/utils/check_alias_annotation.h>
 #include <torch/csrc/jit/print_handler.h>
@@ -197,7 +203,10 @@ void initJITBindings(PyObject* module) {
           "_jit_pass_quant_fusion",
           [](std::shared_ptr<Graph>& g) { return QuantFusion(g); })
       .def("_jit_pass_fold_convbn", &FoldConvBatchNorm2d)
+      .def("_jit_freeze_module", &FreezeModule)
+      .def("_jit_pass_mkldnn_prepack", &PrepackMKLDNNWeights)
       .def("_jit_pass_fuse_linear", &FuseLinear)
+      .def("_jit_pass_fuse_addmm_activation", &FuseAddmmActivation)
       .def(
           "_jit_pass_fold_quantize",
           [](script::Module& module, const std::string& method_name) {
@@ -236,6 +245,10 @@ void initJITBindings(PyObject* module) {
           "_jit_pass_remove_inplace_ops",
           [](std::shared_ptr<Graph> g) { return RemoveInplaceOps(g); })
       .def("_jit_pass_constant_pooling", ConstantPooling)
+      .def("_jit_pass_memoize_graph", MemoizeGraph)
+      .def(
+          "_jit_pass_plan_memory",
+          [](const std::shared_ptr<Graph>& g) { return PlanMemory(g); })
       .def(
           "_jit_pass_peephole",
           [](const std::shared_ptr<Graph>& g, bool addmm_fusion_enabled) {
@@ -269,6 +282,11 @@ void initJITBindings(PyObject* module) {
             }
             PropagateInputShapes(graph);
           })
+      .def(
+          "_jit_infer_shapes",
+          [](std::shared_ptr<Graph>& graph,
+             const std::vector<c10::optional<std::vector<int64_t>>>&
+                 input_shapes) { return InferShapes(*graph, input_shapes); })
       .def("_jit_pass_remove_expands", RemoveExpands)
       .def("_jit_pass_erase_number_types", EraseNumberTypes)
       .def("_jit_pass_inline_fork_wait", InlineForkWait)
@@ -280,6 +298,7 @@ void initJITBindings(PyObject* module) {
             return LowerGraph(*graph, self._ivalue());
           })
       .def("_jit_pass_loop_unrolling", UnrollLoops)
+      .def("_jit_pass_unroll_profiled_loops", UnrollProfiledLoops)
       .def(
           "_jit_pass_constant_propagation",
           [](std::shared_ptr<Graph>& g) { return ConstantPropagation(g); })
@@ -342,6 +361,45 @@ void initJITBindings(PyObject* module) {
             auto stack = toTraceableStack(args);
             checkAliasAnnotation(g, std::move(stack), unqualified_op_name);
           })
+      .def(
+          "_jit_set_fastmath_enabled",
+          [](bool enabled) {
+            bool oldState = graphFastMathEnabled();
+            setGraphFastMathEnabled(enabled);
+            return oldState;
+          })
+      .def("_jit_fastmath_enabled", &graphFastMathEnabled)
+      .def(
+          "_jit_tensor_core_advisor",
+          [](std::shared_ptr<Graph> g) {
+            std::vector<std::tuple<std::string, std::string, std::string>>
+                entries;
+            for (auto& advisory : TensorCoreAdvisor(g)) {
+              entries.emplace_back(
+                  std::move(advisory.node_kind),
+                  std::move(advisory.category),
+                  std::move(advisory.message));
+            }
+            return entries;
+          })
+      .def(
+          "_jit_set_batch_bucketing",
+          [](const std::string& mode, std::vector<int64_t> pinned_sizes) {
+            if (mode == "none") {
+              setBatchBucketing(BatchBucketingMode::None);
+            } else if (mode == "pow2") {
+              setBatchBucketing(BatchBucketingMode::PowerOfTwo);
+            } else if (mode == "pinned") {
+              setBatchBucketing(
+                  BatchBucketingMode::Pinned, std::move(pinned_sizes));
+            } else {
+              throw std::runtime_error(
+                  "expected batch bucketing mode 'none', 'pow2' or 'pinned', got " +
+                  mode);
+            }
+          },
+          py::arg("mode"),
+          py::arg("pinned_sizes") = std::vector<int64_t>())
       .def(
           "_jit_set_profiling_mode",
           [](bool profiling_flag) {
@@ -2,6 +2,9 @@
 
 #include <ATen/Parallel.h>
 #include <ATen/core/ivalue.h>
+#include <ATen/detail/CUDAHooksInterface.h>
+#include <c10/core/Event.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
 #include <c10/core/thread_pool.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/autograd/edge.h>
@@ -66,6 +69,48 @@ TensorTypePtr tensorTypeInCurrentExecutionContext(const at::Tensor& t) {
 
 namespace {
 
+// Note [Stream assignment for forked branches]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// prim::fork tasks run on the inter-op pool, but CUDA kernels they launch
+// would all land on the default stream of the worker thread and serialize
+// against each other and the parent. When CUDA is available, each forked
+// branch is assigned a stream from the per-device pool, made current for
+// the whole branch (including resumptions after inner aten::wait) by
+// InterpreterContinuation. When the branch's future completes, an event
+// recorded on the branch stream is blocked on by the stream that was
+// current at the fork point; the completion callback runs before any
+// aten::wait consumer resumes, so work enqueued after the join is
+// correctly ordered without host synchronization.
+//
+// Streams are thread-local, so a suspended interpreter also captures its
+// current stream and restores it when resuming on another worker thread.
+
+c10::optional<c10::Stream> currentStreamIfCUDA() {
+  const auto& hooks = at::detail::getCUDAHooks();
+  if (!hooks.hasCUDA()) {
+    return c10::nullopt;
+  }
+  const int64_t device_index = hooks.current_device();
+  if (device_index < 0) {
+    return c10::nullopt;
+  }
+  c10::impl::VirtualGuardImpl impl(c10::DeviceType::CUDA);
+  return impl.getStream(
+      c10::Device(c10::DeviceType::CUDA, device_index));
+}
+
+c10::optional<c10::Stream> streamForForkedBranch() {
+  const auto& hooks = at::detail::getCUDAHooks();
+  if (!hooks.hasCUDA()) {
+    return c10::nullopt;
+  }
+  int64_t device_index = hooks.current_device();
+  if (device_index < 0) {
+    device_index = 0;
+  }
+  return hooks.getStreamFromPool(static_cast<c10::DeviceIndex>(device_index));
+}
+
 // insert Drop nodes to kill references for anything unused:
 // this can happen in a few places, e.g. when a node returns
 // many values but only one is used
@@ -867,11 +912,29 @@ struct CodeImpl {
 };
 
 // InterpreterState state that and used to compute a Code
+//
+// Note [Interpreter buffer recycling]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// For small scripted models the cost of growing `registers` and `frames`
+// from empty on every invocation is measurable. Both vectors are therefore
+// leased from a small per-thread cache: on destruction they are cleared
+// (still dropping IValue references as eagerly as before) and their heap
+// buffers are handed back, so in steady state a caller that repeatedly runs
+// the same code reuses buffers that already have peak capacity and the
+// interpreter performs no allocations of its own.
 struct InterpreterStateImpl : c10::intrusive_ptr_target {
   InterpreterStateImpl(const Code& code) {
+    acquireBuffers();
+    // the common case never recurses past the entry frame, so sizing the
+    // register file for it up front makes the first run cheap too
+    registers.reserve(code.pImpl->register_size_);
     enterFrame(code, 0);
   }
 
+  ~InterpreterStateImpl() override {
+    releaseBuffers();
+  }
+
  private:
   // if we need to suspend, where do we reset the stack?
   // answer: to where it was when we were called, not
@@ -928,6 +991,48 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
 
   std::vector<Frame> frames;
 
+  // See Note [Interpreter buffer recycling]. The caches are bounded so that
+  // a burst of deeply nested interpreters cannot pin memory forever.
+  static constexpr size_t kMaxCachedBuffers = 4;
+
+  static std::vector<std::vector<IValue>>& registerBufferCache() {
+    static thread_local std::vector<std::vector<IValue>> cache;
+    return cache;
+  }
+
+  static std::vector<std::vector<Frame>>& frameBufferCache() {
+    static thread_local std::vector<std::vector<Frame>> cache;
+    return cache;
+  }
+
+  void acquireBuffers() {
+    auto& register_cache = registerBufferCache();
+    if (!register_cache.empty()) {
+      registers = std::move(register_cache.back());
+      register_cache.pop_back();
+    }
+    auto& frame_cache = frameBufferCache();
+    if (!frame_cache.empty()) {
+      frames = std::move(frame_cache.back());
+      frame_cache.pop_back();
+    }
+  }
+
+  void releaseBuffers() {
+    // clear() destroys any leftover IValues but keeps the capacity that this
+    // run established, which is exactly what the next run wants
+    registers.clear();
+    auto& register_cache = registerBufferCache();
+    if (register_cache.size() < kMaxCachedBuffers) {
+      register_cache.emplace_back(std::move(registers));
+    }
+    frames.clear();
+    auto& frame_cache = frameBufferCache();
+    if (frame_cache.size() < kMaxCachedBuffers) {
+      frame_cache.emplace_back(std::move(frames));
+    }
+  }
+
   c10::intrusive_ptr<InterpreterStateImpl> intrusive_from_this() {
     c10::raw::intrusive_ptr::incref(this);
     return c10::intrusive_ptr<InterpreterStateImpl>::reclaim(this);
@@ -1124,17 +1229,24 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
                 Callback(
                     c10::intrusive_ptr<InterpreterStateImpl> state,
                     Stack stack)
-                    : state_(std::move(state)), stack_(std::move(stack)) {}
+                    : state_(std::move(state)),
+                      stack_(std::move(stack)),
+                      // the resumption may run on a different worker
+                      // thread; restore this thread's stream there (see
+                      // Note [Stream assignment for forked branches])
+                      stream_(currentStreamIfCUDA()) {}
                 void operator()() {
                   at::launch(InterpreterContinuation(
                       state_,
                       std::move(stack_),
-                      autograd::GradMode::is_enabled()));
+                      autograd::GradMode::is_enabled(),
+                      stream_));
                 }
 
                private:
                 InterpreterState state_;
                 Stack stack_;
+                c10::optional<c10::Stream> stream_;
               };
 
               // we are suspending, so we need to reset the stack to where we
@@ -1244,12 +1356,31 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             // Move inputs to a separate stack
             InterpreterState forked_interpreter(
                 frames.back().function->code_table_.at(inst.X));
+            auto fork_stream = streamForForkedBranch();
             InterpreterContinuation continuation(
                 forked_interpreter,
                 Stack(stack.end() - inst.N, stack.end()),
-                autograd::GradMode::is_enabled());
+                autograd::GradMode::is_enabled(),
+                fork_stream);
             drop(stack, inst.N);
-            push(stack, forked_interpreter.getFuture());
+            auto forked_future = forked_interpreter.getFuture();
+            if (fork_stream) {
+              // event-based join: order the forking thread's stream after
+              // the branch stream once the branch completes (see Note
+              // [Stream assignment for forked branches]); this callback is
+              // registered before any aten::wait consumer's
+              auto parent_stream = currentStreamIfCUDA();
+              if (parent_stream && *parent_stream != *fork_stream) {
+                c10::Stream branch_stream = *fork_stream;
+                c10::Stream join_stream = *parent_stream;
+                forked_future->addCallback([branch_stream, join_stream]() {
+                  c10::Event event(branch_stream.device_type());
+                  event.record(branch_stream);
+                  event.block(join_stream);
+                });
+              }
+            }
+            push(stack, std::move(forked_future));
             at::launch(std::move(continuation));
             ++af.pc;
           } break;
@@ -1425,7 +1556,20 @@ InterpreterState::InterpreterState(
 
 void InterpreterContinuation::operator()() {
   autograd::AutoGradMode grad_mode(grad_mode_enabled);
-  state.runAsync(stack);
+  if (stream) {
+    c10::impl::VirtualGuardImpl impl(stream->device_type());
+    const c10::Stream prev_stream = impl.getStream(stream->device());
+    impl.exchangeStream(*stream);
+    try {
+      state.runAsync(stack);
+    } catch (...) {
+      impl.exchangeStream(prev_stream);
+      throw;
+    }
+    impl.exchangeStream(prev_stream);
+  } else {
+    state.runAsync(stack);
+  }
 }
 } // namespace jit
 } // namespace torch
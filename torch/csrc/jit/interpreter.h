@@ -1,4 +1,5 @@
 #pragma once
+#include <c10/core/Stream.h>
 #include <c10/util/Optional.h>
 #include <memory>
 #include <vector>
@@ -93,10 +94,12 @@ struct InterpreterContinuation {
   InterpreterContinuation(
       InterpreterState state_,
       Stack stack_,
-      bool grad_mode_enabled_)
+      bool grad_mode_enabled_,
+      c10::optional<c10::Stream> stream_ = c10::nullopt)
       : state(state_),
         stack(std::move(stack_)),
-        grad_mode_enabled(grad_mode_enabled_) {}
+        grad_mode_enabled(grad_mode_enabled_),
+        stream(stream_) {}
 
   void operator()();
 
@@ -104,6 +107,10 @@ struct InterpreterContinuation {
   InterpreterState state;
   Stack stack;
   bool grad_mode_enabled;
+  // when set, the continuation runs with this stream current, so forked
+  // subgraphs launch their kernels on their assigned pool stream and
+  // resumed interpreters keep the stream they were suspended on
+  c10::optional<c10::Stream> stream;
 };
 
 // what is the tensors type, including state from the current execution context
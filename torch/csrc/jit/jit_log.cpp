@@ -1,6 +1,7 @@
 
 #include <cstdlib>
 #include <iomanip>
+#include <iostream>
 #include <sstream>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/python_print.h>
 #include <torch/csrc/jit/script/error_report.h>
+#include <torch/csrc/jit/script/logging.h>
 
 namespace torch {
 namespace jit {
@@ -112,6 +114,51 @@ std::string jit_log_prefix(
   return jit_log_prefix(prefix_ss.str(), in_str);
 }
 
+bool jit_pass_timing_enabled() {
+  static const bool enabled =
+      std::getenv("PYTORCH_JIT_PASS_TIMING") != nullptr;
+  return enabled;
+}
+
+namespace {
+size_t countNodes(const Block* block) {
+  size_t n = 0;
+  for (const Node* node : block->nodes()) {
+    n++;
+    for (const Block* b : node->blocks()) {
+      n += countNodes(b);
+    }
+  }
+  return n;
+}
+} // namespace
+
+JitPassTimer::JitPassTimer(
+    const char* pass_name,
+    const std::shared_ptr<Graph>& graph)
+    : pass_name_(pass_name), graph_(graph.get()) {
+  if (!jit_pass_timing_enabled()) {
+    return;
+  }
+  nodes_before_ = countNodes(graph_->block());
+  start_ = std::chrono::steady_clock::now();
+}
+
+JitPassTimer::~JitPassTimer() {
+  if (!jit_pass_timing_enabled()) {
+    return;
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start_)
+                .count();
+  size_t nodes_after = countNodes(graph_->block());
+  std::cerr << "[PASS " << pass_name_ << "] " << us << "us, " << nodes_before_
+            << " -> " << nodes_after << " nodes" << std::endl;
+  logging::getLogger()->addStatValue(
+      std::string("pytorch.graph_executor.pass_time_us.") + pass_name_,
+      static_cast<int64_t>(us));
+}
+
 std::ostream& operator<<(std::ostream& out, JitLoggingLevels level) {
   switch (level) {
     case JitLoggingLevels::GRAPH_DUMP:
@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 #include <memory>
 #include <string>
 #include <torch/csrc/WindowsTorchApiMacro.h>
@@ -66,6 +67,35 @@ TORCH_API std::string jit_log_prefix(
 
 TORCH_API bool is_enabled(const char *cfname, JitLoggingLevels level);
 
+// Pass timing is a separate switch from the per-file log levels above: set
+// `PYTORCH_JIT_PASS_TIMING=1` to print one line per optimization pass with
+// its wall time and the change in graph size. The cumulative per-pass times
+// are also exported through `logging::getLogger()` under
+// `pytorch.graph_executor.pass_time_us.<pass>`, so a custom logger can
+// collect them in deployment.
+TORCH_API bool jit_pass_timing_enabled();
+
+// RAII guard that times a single optimization pass over a graph. Construct
+// it right before running the pass; the report is emitted when the guard
+// goes out of scope. Does no work unless jit_pass_timing_enabled().
+struct TORCH_API JitPassTimer {
+  JitPassTimer(const char* pass_name, const std::shared_ptr<Graph>& graph);
+  ~JitPassTimer();
+
+ private:
+  const char* pass_name_;
+  Graph* graph_;
+  size_t nodes_before_ = 0;
+  std::chrono::time_point<std::chrono::steady_clock> start_;
+};
+
+// Runs a statement that executes one pass over GRAPH under a JitPassTimer.
+#define JIT_TIMED_PASS(NAME, GRAPH, ...)            \
+  {                                                 \
+    ::torch::jit::JitPassTimer timer(NAME, GRAPH);  \
+    __VA_ARGS__;                                    \
+  }
+
 TORCH_API std::ostream& operator<<(std::ostream& out, JitLoggingLevels level);
 
 #define JIT_LOG(level, ...)                                                    \
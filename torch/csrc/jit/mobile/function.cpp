@@ -4,11 +4,38 @@
 #include <torch/csrc/jit/vararg_functions.h>
 #include <ATen/core/op_registration/op_registration.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace torch{
 namespace jit{
 
 char const * toString(OpCode op);
 namespace mobile {
+namespace {
+// Operator resolution through Dispatcher::findSchema is string-hash bound and
+// shows up prominently in model load time. Operators are statically registered
+// on mobile, so resolved handles stay valid for the process lifetime and can
+// be cached, making each distinct operator resolve at most once no matter how
+// many methods or models reference it. Failed lookups are not cached so that
+// an operator registered later (e.g. from a custom op library) is still found.
+c10::optional<c10::OperatorHandle> findCachedSchema(
+    const c10::OperatorName& opname) {
+  static std::mutex mutex;
+  static std::unordered_map<c10::OperatorName, c10::OperatorHandle> cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = cache.find(opname);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  auto op = c10::Dispatcher::singleton().findSchema(opname);
+  if (op.has_value()) {
+    cache.emplace(opname, *op);
+  }
+  return op;
+}
+} // namespace
+
 Function::Function(c10::QualifiedName name)
     : name_(name), code_(std::make_shared<Code>()) {}
 
@@ -28,7 +55,7 @@ void Function::append_operator(const std::string& name,
   if (opname.name != "aten::Int") {
     opname.name = "_" + opname.name;
   }
-  auto op = c10::Dispatcher::singleton().findSchema(opname);
+  auto op = findCachedSchema(opname);
   TORCH_CHECK(op.has_value(), opname.name, ".", opname.overload_name, " cannot be found.");
   // TODO: operator.h now does not depend on Node* so we can also look up operators from
   // that registry for use in mobile as a way to share implementations.
@@ -50,7 +77,22 @@ void Function::set_register_size(size_t size) {
   code_->register_size_ = size;
 }
 
+void Function::set_lazy_loader(std::function<void(Function&)> loader) {
+  lazy_loader_ = std::move(loader);
+}
+
+void Function::ensure_loaded() const {
+  if (lazy_loader_) {
+    // Clear the loader only after it succeeds, so a failed parse (e.g. a
+    // missing operator) surfaces again on the next call instead of running
+    // a half-filled function.
+    lazy_loader_(*const_cast<Function*>(this));
+    lazy_loader_ = nullptr;
+  }
+}
+
 bool Function::run(Stack& stack) const {
+  ensure_loaded();
   InterpreterState interp_state(code_);
   return interp_state.run(stack);
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <ATen/core/ivalue.h>
 //#include <aten/src/Aten/core/operator_name.h>
+#include <functional>
 #include <vector>
 
 namespace torch{
@@ -25,9 +26,19 @@ class Function{
 
   void set_register_size(size_t size);
 
+  // A function registered from the lazily-parsed bytecode format carries a
+  // loader instead of parsed code. The loader runs once, on the first call,
+  // and fills the function in through the append_* methods above; functions
+  // that are never called are never parsed.
+  void set_lazy_loader(std::function<void(Function&)> loader);
+  void ensure_loaded() const;
+
  private:
   c10::QualifiedName name_;
   std::shared_ptr<Code> code_;
+  // mutable so run() can stay const; parsing is an implementation detail of
+  // the first call, not an observable mutation.
+  mutable std::function<void(Function&)> lazy_loader_;
 };
 
 } // namespace mobile
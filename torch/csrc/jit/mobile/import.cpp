@@ -3,10 +3,13 @@
 #include <torch/csrc/jit/script/compilation_unit.h>
 #include <torch/csrc/jit/unpickler.h>
 #include <caffe2/serialize/inline_container.h>
+#include <torch/csrc/jit/import_export_helpers.h>
 #include <torch/csrc/jit/instruction.h>
 #include <torch/csrc/jit/mobile/type_parser.h>
 
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -32,6 +35,14 @@
 // This format and process need to be revisted and redesigned if we want to
 // support backward compatibility in future.
 
+// Files written by newer exporters additionally contain a lazily-parseable
+// layout of the same methods: a flat "bytecode.lazy.index" record (see
+// import_export_helpers.h for the layout) plus one archive per method under
+// "bytecode.lazy/<i>". When the index is present, methods are registered as
+// stubs carrying only their name, and each one is unpickled on its first
+// call. An app that loads many models but calls few of them this way pays
+// the parse cost only for the methods it actually runs.
+
 namespace torch {
 namespace jit {
 using caffe2::serialize::PyTorchStreamReader;
@@ -47,61 +58,72 @@ IValue expect_field(IValue tup, const std::string& expected_name, size_t entry){
   return row->elements().at(1);
 }
 
-void parseMethods(const std::vector<IValue>& vals, mobile::CompilationUnit& mcu) {
-  for (const auto& element : vals) {
-    const auto& m_tuple = element.toTuple()->elements();
-    const std::string& function_name = m_tuple[0].toStringRef();
-    IValue table = m_tuple[1];
+void parseMethod(const IValue& element, mobile::Function& function) {
+  const auto& m_tuple = element.toTuple()->elements();
+  IValue table = m_tuple[1];
 
-    auto function = std::unique_ptr<mobile::Function>(
-        new mobile::Function(c10::QualifiedName(function_name)));
+  const auto& ins_list = expect_field(table, "instructions", 0).toTuple()->elements();
+  const auto& ops_list = expect_field(table, "operators", 1).toTuple()->elements();
+  const auto& consts_list = expect_field(table, "constants", 2).toTuple()->elements();
+  const auto& types_list = expect_field(table, "types", 3).toTuple()->elements();
+  const auto& register_size = expect_field(table, "register_size", 4).toInt();
 
-    const auto& ins_list = expect_field(table, "instructions", 0).toTuple()->elements();
-    const auto& ops_list = expect_field(table, "operators", 1).toTuple()->elements();
-    const auto& consts_list = expect_field(table, "constants", 2).toTuple()->elements();
-    const auto& types_list = expect_field(table, "types", 3).toTuple()->elements();
-    const auto& register_size = expect_field(table, "register_size", 4).toInt();
-
-    for (const auto& ins : ins_list) {
-      auto ins_item = ins.toTuple()->elements();
-      TORCH_CHECK(ins_item.size() == 3,
-                  "There should be three parts in an instruction.");
-      OpCode op_code = parseOpCode(ins_item[0].toString()->string().c_str());
-      int X = ins_item[1].toInt();
-      int N = ins_item[2].toInt();
-      function->append_instruction(op_code, X, N);
-    }
+  for (const auto& ins : ins_list) {
+    auto ins_item = ins.toTuple()->elements();
+    TORCH_CHECK(ins_item.size() == 3,
+                "There should be three parts in an instruction.");
+    OpCode op_code = parseOpCode(ins_item[0].toString()->string().c_str());
+    int X = ins_item[1].toInt();
+    int N = ins_item[2].toInt();
+    function.append_instruction(op_code, X, N);
+  }
 
-    for (const auto& op : ops_list) {
-      auto op_item = op.toTuple()->elements();
-      TORCH_CHECK(op_item.size() == 2,
-                  "There should be two parts in an operator name.");
-      function->append_operator(op_item[0].toString()->string(),
-                           op_item[1].toString()->string());
-    }
+  for (const auto& op : ops_list) {
+    auto op_item = op.toTuple()->elements();
+    TORCH_CHECK(op_item.size() == 2,
+                "There should be two parts in an operator name.");
+    function.append_operator(op_item[0].toString()->string(),
+                        op_item[1].toString()->string());
+  }
 
-    for (const auto& constant : consts_list) {
-      function->append_constant(constant);
-    }
+  for (const auto& constant : consts_list) {
+    function.append_constant(constant);
+  }
 
-    for (const auto& t : types_list) {
-      function->append_type(c10::parseType(t.toStringRef()));
-    }
+  for (const auto& t : types_list) {
+    function.append_type(c10::parseType(t.toStringRef()));
+  }
 
-    function->set_register_size(register_size);
+  function.set_register_size(register_size);
+}
 
+void parseMethods(const std::vector<IValue>& vals, mobile::CompilationUnit& mcu) {
+  for (const auto& element : vals) {
+    const std::string& function_name =
+        element.toTuple()->elements().at(0).toStringRef();
+    auto function = std::unique_ptr<mobile::Function>(
+        new mobile::Function(c10::QualifiedName(function_name)));
+    parseMethod(element, *function);
     mcu.register_function(std::move(function));
   }
 }
 
 // The deserializer class which loads the bytecode package from bc files.
-class BytecodeDeserializer final {
+//
+// When the file carries the lazy bytecode layout, the function stubs it
+// registers hold loaders that read from reader_, so the deserializer must be
+// owned by a shared_ptr and stays alive (captured by the loaders) for as long
+// as any unparsed method remains reachable.
+class BytecodeDeserializer final
+    : public std::enable_shared_from_this<BytecodeDeserializer> {
  public:
   explicit BytecodeDeserializer(std::unique_ptr<PyTorchStreamReader> reader);
   mobile::Module deserialize(c10::optional<at::Device> device);
 
  private:
   c10::IValue readArchive(const std::string& archive_name);
+  std::vector<std::string> parseLazyIndex();
+  void parseLazyMethods(mobile::CompilationUnit& mcu);
   std::shared_ptr<script::CompilationUnit> compilation_unit_;
   std::unordered_set<std::string> imported_libs_;
   std::unique_ptr<PyTorchStreamReader> reader_;
@@ -113,13 +135,73 @@ BytecodeDeserializer::BytecodeDeserializer(std::unique_ptr<PyTorchStreamReader>
 
 mobile::Module BytecodeDeserializer::deserialize(c10::optional<at::Device> device) {
   device_ = device;
-  auto bvals = readArchive("bytecode").toTuple()->elements();
   auto mcu = std::make_shared<mobile::CompilationUnit>();
-  parseMethods(bvals, *mcu);
+  if (reader_->hasRecord("bytecode.lazy.index")) {
+    parseLazyMethods(*mcu);
+  } else {
+    auto bvals = readArchive("bytecode").toTuple()->elements();
+    parseMethods(bvals, *mcu);
+  }
 
   return mobile::Module(readArchive("data").toObject(), mcu);
 }
 
+// Parses the flat index record of the lazy bytecode layout (see
+// import_export_helpers.h) into the list of method qualified names, in
+// archive order.
+std::vector<std::string> BytecodeDeserializer::parseLazyIndex() {
+  at::DataPtr index_ptr;
+  size_t index_size;
+  std::tie(index_ptr, index_size) = reader_->getRecord("bytecode.lazy.index");
+  auto data = reinterpret_cast<const char*>(index_ptr.get());
+
+  size_t pos = 0;
+  auto read_uint64 = [&]() -> uint64_t {
+    TORCH_CHECK(
+        pos + sizeof(uint64_t) <= index_size,
+        "Truncated lazy bytecode index.");
+    uint64_t value;
+    std::memcpy(&value, data + pos, sizeof(value));
+    pos += sizeof(value);
+    return value;
+  };
+
+  TORCH_CHECK(
+      read_uint64() == kLazyByteCodeIndexMagic,
+      "Corrupt lazy bytecode index.");
+  TORCH_CHECK(
+      read_uint64() == kLazyByteCodeIndexVersion,
+      "Unsupported lazy bytecode index version.");
+  const auto count = read_uint64();
+
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    const auto length = read_uint64();
+    TORCH_CHECK(
+        pos + length <= index_size, "Truncated lazy bytecode index.");
+    names.emplace_back(data + pos, length);
+    pos += length;
+  }
+  return names;
+}
+
+// Registers one stub per indexed method; the stub carries only the name plus
+// a loader that unpickles "bytecode.lazy/<i>" on the method's first call.
+void BytecodeDeserializer::parseLazyMethods(mobile::CompilationUnit& mcu) {
+  const auto names = parseLazyIndex();
+  auto self = shared_from_this();
+  for (size_t i = 0; i < names.size(); ++i) {
+    auto function = std::unique_ptr<mobile::Function>(
+        new mobile::Function(c10::QualifiedName(names[i])));
+    function->set_lazy_loader([self, i](mobile::Function& fn) {
+      auto element = self->readArchive("bytecode.lazy/" + c10::to_string(i));
+      parseMethod(element, fn);
+    });
+    mcu.register_function(std::move(function));
+  }
+}
+
 c10::IValue BytecodeDeserializer::readArchive(const std::string& archive_name) {
   std::stringstream picklename;
   picklename << archive_name << ".pkl";
@@ -196,8 +278,9 @@ mobile::Module _load_for_mobile(
     std::unique_ptr<ReadAdapterInterface> rai,
     c10::optional<c10::Device> device) {
   auto reader = torch::make_unique<PyTorchStreamReader>(std::move(rai));
-  BytecodeDeserializer deserializer(std::move(reader));
-  return deserializer.deserialize(device);
+  auto deserializer =
+      std::make_shared<BytecodeDeserializer>(std::move(reader));
+  return deserializer->deserialize(device);
 }
 
 } // namespace jit
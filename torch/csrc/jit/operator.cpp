@@ -34,16 +34,29 @@ struct OperatorRegistry {
   std::unordered_map<const char*, std::shared_ptr<Operator>>
       operators_by_sig_literal;
 
+  // operators that are in the name index already but whose canonical
+  // signature string has not been computed; computing it forces a full parse
+  // of the schema, so it is deferred until a literal lookup actually needs
+  // the signature index (most processes never do)
+  std::vector<std::shared_ptr<Operator>> to_sig_index;
+
   // XXX - caller must be holding lock
   void registerPendingOperators() {
     for (const auto& op : to_register) {
-      Symbol sym = Symbol::fromQualString(op->schema().name());
-      operators[sym].push_back(op);
-      operators_by_sig[canonicalSchemaString(op->schema())] = op;
+      operators[op->schemaNameSymbol()].push_back(op);
+      to_sig_index.push_back(op);
     }
     to_register.clear();
   }
 
+  // XXX - caller must be holding lock
+  void indexPendingSignatures() {
+    for (const auto& op : to_sig_index) {
+      operators_by_sig[canonicalSchemaString(op->schema())] = op;
+    }
+    to_sig_index.clear();
+  }
+
  public:
   void registerOperator(Operator&& op) {
     std::lock_guard<std::mutex> guard(lock);
@@ -55,6 +68,7 @@ struct OperatorRegistry {
     registerPendingOperators();
     auto it = operators_by_sig_literal.find(name);
     if (it == operators_by_sig_literal.end()) {
+      indexPendingSignatures();
       auto op_ptr_it =
           operators_by_sig.find(canonicalSchemaString(parseSchema(name)));
       // Handy debugging code that dumps all operators we know about on mismatch
@@ -171,6 +185,7 @@ bool printerHasSpecialCaseFor(Symbol sym) {
       prim::AutogradAdd, // temporarily inserted by autograd
       prim::ConstantChunk, // optimization pass adds it
       prim::DifferentiableGraph, // optimization pass adds it
+      prim::MemoizedGraph, // optimization pass adds it
       prim::BroadcastSizes, // optimization pass (fuser) adds it
       prim::ChunkSizes, // optimization pass (fuser) adds it
       prim::Drop, // used in interpreter only
@@ -207,6 +222,7 @@ bool aliasAnalysisHasSpecialCaseFor(Symbol symbol) {
       prim::Loop,
       prim::FusionGroup,
       prim::DifferentiableGraph,
+      prim::MemoizedGraph,
       prim::Constant,
       prim::Uninitialized,
       prim::DictConstruct,
@@ -118,6 +118,21 @@ struct TORCH_API Operator {
     return *schema_;
   }
 
+  // Qualified name of this operator (no overload), without forcing a full
+  // parse of the schema string; the registry indexes operators by name long
+  // before most of their schemas are ever needed.
+  Symbol schemaNameSymbol() const {
+    if (schema_) {
+      return Symbol::fromQualString(schema_->name());
+    }
+    const std::string& s = schema_string_.value();
+    size_t start = s.find_first_not_of(' ');
+    // the name ends at the argument list or at an overload name
+    size_t end = s.find_first_of(".(", start);
+    AT_ASSERT(end != std::string::npos);
+    return Symbol::fromQualString(s.substr(start, end - start));
+  }
+
   bool isC10Op() const {
     return c10Handle_.has_value();
   }
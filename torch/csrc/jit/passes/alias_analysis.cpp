@@ -319,6 +319,7 @@ void AliasDb::analyzeImpl(Node* node) {
       return analyzeLoop(node);
     case prim::FusionGroup:
     case prim::DifferentiableGraph:
+    case prim::MemoizedGraph:
       return analyzeSubgraph(node);
     case prim::fork:
       return analyzeFork(node);
@@ -1217,6 +1218,38 @@ void AliasDb::move(Node* toMove, Node* movePoint, MoveSide moveSide) {
   }
 }
 
+void AliasDb::analyzeNewNode(Node* node) {
+  analyze(node);
+  // analysis may have added points-to edges to elements whose memory
+  // locations were already queried and cached
+  memoryDAG_->invalidateMemoryLocationCaches();
+  isWriteCacheStale_ = true;
+}
+
+void AliasDb::removeNode(Node* node) {
+  for (Block* block : node->blocks()) {
+    for (Node* inner : block->nodes()) {
+      removeNode(inner);
+    }
+  }
+  writeIndex_.erase(node);
+  for (Value* output : node->outputs()) {
+    removeValue(output);
+  }
+  isWriteCacheStale_ = true;
+}
+
+void AliasDb::removeValue(const Value* v) {
+  auto it = elementMap_.find(v);
+  if (it == elementMap_.end()) {
+    return;
+  }
+  // The Element stays in the points-to graph, keeping queries about other
+  // values conservative, but it must not refer to the dying Value.
+  it->second->value = nullptr;
+  elementMap_.erase(it);
+}
+
 bool AliasDb::writesToWildcard(Node* n) const {
   if (!writeIndex_.count(n)) {
     return false;
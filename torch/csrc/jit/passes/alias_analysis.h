@@ -105,6 +105,25 @@ class AliasDb {
   bool couldMoveAfterTopologically(Node* n, Node* movePoint);
   bool couldMoveBeforeTopologically(Node* n, Node* movePoint);
 
+  /**
+   * Incremental update API
+   *
+   * Rebuilding the AliasDb from scratch after every graph mutation makes an
+   * optimization pipeline quadratic in graph size. Passes that only insert
+   * and delete nodes can instead keep one AliasDb alive and notify it:
+   *  - call analyzeNewNode(n) after inserting `n`; its inputs must already
+   *    be part of the graph this db was built over.
+   *  - call removeNode(n) just before destroying `n` (and removeValue(v)
+   *    before erasing an individual output, e.g. a dead block output).
+   *
+   * Removal is conservative: the memory locations of the deleted node's
+   * outputs stay in the points-to graph, which can only make later queries
+   * more conservative, never wrong.
+   */
+  TORCH_API void analyzeNewNode(Node* n);
+  TORCH_API void removeNode(Node* n);
+  TORCH_API void removeValue(const Value* v);
+
   // For debugging: print alias db state to stdout
   TORCH_API void dump() const;
   TORCH_API std::string toString() const;
@@ -0,0 +1,299 @@
+#include <torch/csrc/jit/passes/batch_parallel_chains.h>
+
+#include <torch/csrc/jit/constants.h>
+
+#include <map>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// Note [Horizontal chain batching]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Multi-head models frequently apply the same small tower - a matmul,
+// optionally a bias add and a couple of elementwise activations - to many
+// independent feature groups. batch_mm.cpp only treats trees of raw mm
+// nodes, so the bias add or the activation in the middle of each tower
+// breaks its pattern and the matmuls execute serially.
+//
+// This pass detects groups of structurally identical chains of the form
+//
+//   mm/addmm -> [add(_, bias)] -> [relu/sigmoid/tanh/gelu]*
+//
+// whose operands all have complete, matching tensor types, and whose
+// external inputs are all available before the first chain of the group.
+// Each group is rewritten into a single batched computation: the operands
+// at every position are stacked along a new leading dimension, the matmul
+// becomes a bmm, 1-D biases are stacked and unsqueezed so they broadcast
+// across rows, activations apply to the batched tensor directly, and each
+// original output is recovered with an aten::select (the outputs are
+// disjoint slices of the batched buffer, so downstream mutation of one
+// output cannot observe another).
+//
+// The transform is only applied when complete shapes are known (i.e. after
+// shape propagation on traced or profiled graphs), since stacking requires
+// every chain to agree on operand sizes, dtype and device.
+
+namespace {
+
+// Matches the reduction threshold used by batch_mm: batching fewer chains
+// than this is unlikely to pay for the stack/select glue.
+constexpr size_t kMinChainsToBatch = 4;
+
+struct Chain {
+  // nodes[0] is the mm/addmm root; subsequent entries form the single-use
+  // elementwise tail, in execution order.
+  std::vector<Node*> nodes;
+
+  Node* root() const {
+    return nodes.front();
+  }
+  Value* output() const {
+    return nodes.back()->output();
+  }
+};
+
+bool isConstantOne(Value* v) {
+  auto ival = toIValue(v);
+  if (!ival) {
+    return false;
+  }
+  if (ival->isInt()) {
+    return ival->toInt() == 1;
+  }
+  if (ival->isDouble()) {
+    return ival->toDouble() == 1.0;
+  }
+  return false;
+}
+
+// Appends dtype/device/sizes of v to the signature stream; fails when the
+// type is incomplete or does not have the expected dimensionality.
+bool appendOperand(std::ostream& sig, Value* v, size_t expected_dim) {
+  auto type = v->type()->cast<TensorType>();
+  if (!type) {
+    return false;
+  }
+  auto sizes = type->sizes().concrete_sizes();
+  auto scalar_type = type->scalarType();
+  auto device = type->device();
+  if (!sizes || !scalar_type || !device || sizes->size() != expected_dim) {
+    return false;
+  }
+  sig << toString(*scalar_type) << "/" << *device;
+  for (auto size : *sizes) {
+    sig << "x" << size;
+  }
+  sig << ";";
+  return true;
+}
+
+bool isChainRoot(Node* node) {
+  if (node->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
+    return true;
+  }
+  // addmm with beta == alpha == 1 is just bias + mm, which we know how to
+  // batch; any other scaling is left alone.
+  return node->matches(
+             "aten::addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta, Scalar alpha) -> Tensor") &&
+      isConstantOne(node->inputs()[3]) && isConstantOne(node->inputs()[4]);
+}
+
+bool isUnaryActivation(Node* node) {
+  return node->matches("aten::relu(Tensor self) -> Tensor") ||
+      node->matches("aten::sigmoid(Tensor self) -> Tensor") ||
+      node->matches("aten::tanh(Tensor self) -> Tensor") ||
+      node->matches("aten::gelu(Tensor self) -> Tensor");
+}
+
+// A bias add extending the chain: the chain value must be the first
+// argument and the added tensor a 1-D external value, so that the stacked
+// bias broadcasts the same way the original per-chain add did.
+bool isBiasAdd(Node* node, Value* chain_value) {
+  return node->matches(
+             "aten::add(Tensor self, Tensor other, *, Scalar alpha) -> Tensor") &&
+      node->inputs()[0] == chain_value && isConstantOne(node->inputs()[2]);
+}
+
+// Builds the structural signature of a chain, or nullopt if some operand
+// type is incomplete. Chains batch together iff their signatures match.
+c10::optional<std::string> chainSignature(const Chain& chain) {
+  std::ostringstream sig;
+  Node* root = chain.root();
+  sig << root->kind().toQualString() << ":";
+  if (root->kind() == aten::addmm) {
+    if (!appendOperand(sig, root->inputs()[0], 1) ||
+        !appendOperand(sig, root->inputs()[1], 2) ||
+        !appendOperand(sig, root->inputs()[2], 2)) {
+      return c10::nullopt;
+    }
+  } else {
+    if (!appendOperand(sig, root->inputs()[0], 2) ||
+        !appendOperand(sig, root->inputs()[1], 2)) {
+      return c10::nullopt;
+    }
+  }
+  for (size_t i = 1; i < chain.nodes.size(); ++i) {
+    Node* node = chain.nodes[i];
+    sig << node->kind().toQualString() << ":";
+    if (node->kind() == aten::add &&
+        !appendOperand(sig, node->inputs()[1], 1)) {
+      return c10::nullopt;
+    }
+  }
+  return sig.str();
+}
+
+// The external tensor operands the rewrite will stack: everything else a
+// chain consumes is a scalar constant we have already checked equals 1.
+std::vector<Value*> stackedOperands(const Chain& chain) {
+  std::vector<Value*> operands;
+  Node* root = chain.root();
+  size_t num_root_operands = root->kind() == aten::addmm ? 3 : 2;
+  for (size_t i = 0; i < num_root_operands; ++i) {
+    operands.push_back(root->inputs()[i]);
+  }
+  for (size_t i = 1; i < chain.nodes.size(); ++i) {
+    if (chain.nodes[i]->kind() == aten::add) {
+      operands.push_back(chain.nodes[i]->inputs()[1]);
+    }
+  }
+  return operands;
+}
+
+void rewriteGroup(Graph* graph, const std::vector<Chain>& chains) {
+  WithInsertPoint insert_guard{chains[0].root()};
+
+  // Stacks the operand at the given position of the given chain node.
+  auto stack_operands = [&](size_t depth, size_t offset) -> Value* {
+    std::vector<Value*> operands;
+    operands.reserve(chains.size());
+    for (const auto& chain : chains) {
+      operands.push_back(chain.nodes[depth]->inputs()[offset]);
+    }
+    Value* list =
+        graph->insertNode(graph->createList(TensorType::get(), operands))
+            ->output();
+    return graph->insert(aten::stack, {list, graph->insertConstant(0)});
+  };
+
+  auto add_stacked_bias = [&](Value* batched, Value* bias) -> Value* {
+    // The stacked bias is [N, K]; unsqueezing to [N, 1, K] makes it
+    // broadcast across rows within each slice, exactly as the original
+    // per-chain [K] bias did.
+    Value* unsqueezed =
+        graph->insert(aten::unsqueeze, {bias, graph->insertConstant(1)});
+    return graph->insert(aten::add, {batched, unsqueezed});
+  };
+
+  Node* root = chains[0].root();
+  Value* batched;
+  if (root->kind() == aten::addmm) {
+    batched = graph->insert(
+        aten::bmm, {stack_operands(0, 1), stack_operands(0, 2)});
+    batched = add_stacked_bias(batched, stack_operands(0, 0));
+  } else {
+    batched = graph->insert(
+        aten::bmm, {stack_operands(0, 0), stack_operands(0, 1)});
+  }
+  for (size_t depth = 1; depth < chains[0].nodes.size(); ++depth) {
+    Node* node = chains[0].nodes[depth];
+    if (node->kind() == aten::add) {
+      batched = add_stacked_bias(batched, stack_operands(depth, 1));
+    } else {
+      batched = graph->insert(node->kind(), {batched});
+    }
+  }
+
+  Value* zero = graph->insertConstant(0);
+  for (size_t i = 0; i < chains.size(); ++i) {
+    Value* out = graph->insert(
+        aten::select, {batched, zero, graph->insertConstant(int64_t(i))});
+    chains[i].output()->replaceAllUsesWith(out);
+  }
+  for (const auto& chain : chains) {
+    for (auto it = chain.nodes.rbegin(); it != chain.nodes.rend(); ++it) {
+      (*it)->destroy();
+    }
+  }
+}
+
+void BatchParallelChainsInBlock(Block* block) {
+  Graph* graph = block->owningGraph();
+
+  std::vector<Chain> chains;
+  std::unordered_set<Node*> claimed;
+  for (Node* node : block->nodes()) {
+    for (Block* sub_block : node->blocks()) {
+      BatchParallelChainsInBlock(sub_block);
+    }
+    if (claimed.count(node) || !isChainRoot(node)) {
+      continue;
+    }
+    Chain chain;
+    chain.nodes.push_back(node);
+    Node* cur = node;
+    // Extend through the single-use elementwise tail.
+    while (cur->output()->uses().size() == 1) {
+      Node* user = cur->output()->uses()[0].user;
+      if (user->owningBlock() != block ||
+          !(isUnaryActivation(user) || isBiasAdd(user, cur->output()))) {
+        break;
+      }
+      chain.nodes.push_back(user);
+      cur = user;
+    }
+    for (Node* n : chain.nodes) {
+      claimed.insert(n);
+    }
+    chains.push_back(std::move(chain));
+  }
+
+  // Group chains by structural signature, preserving block order within a
+  // group; std::map keeps the rewrite order deterministic across groups.
+  std::map<std::string, std::vector<Chain>> groups;
+  for (auto& chain : chains) {
+    if (auto sig = chainSignature(chain)) {
+      groups[*sig].push_back(std::move(chain));
+    }
+  }
+
+  for (auto& group : groups) {
+    auto& candidates = group.second;
+    if (candidates.size() < kMinChainsToBatch) {
+      continue;
+    }
+    // The batched computation is inserted before the first chain's root, so
+    // every stacked operand must be produced before that point. Chains that
+    // (transitively) depend on another chain in the group fail this test and
+    // are simply left unbatched.
+    Node* insert_node = candidates[0].root();
+    std::vector<Chain> batchable;
+    for (auto& chain : candidates) {
+      bool independent = true;
+      for (Value* operand : stackedOperands(chain)) {
+        if (!operand->node()->isBefore(insert_node)) {
+          independent = false;
+          break;
+        }
+      }
+      if (independent) {
+        batchable.push_back(std::move(chain));
+      }
+    }
+    if (batchable.size() >= kMinChainsToBatch) {
+      rewriteGroup(graph, batchable);
+    }
+  }
+}
+
+} // anonymous namespace
+
+void BatchParallelChains(std::shared_ptr<Graph>& graph) {
+  BatchParallelChainsInBlock(graph->block());
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Batches groups of structurally identical, independent matmul chains
+// (mm/addmm optionally followed by a bias add and elementwise activations)
+// into a single bmm-based computation. See the note in the .cpp for details.
+TORCH_API void BatchParallelChains(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -1,9 +1,24 @@
 #include <torch/csrc/jit/passes/canonicalize_ops.h>
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
 
+#include <atomic>
+#include <cmath>
+
 namespace torch {
 namespace jit {
 
+namespace {
+std::atomic<bool> fastmath_enabled{false};
+}
+
+void setGraphFastMathEnabled(bool enabled) {
+  fastmath_enabled.store(enabled);
+}
+
+bool graphFastMathEnabled() {
+  return fastmath_enabled.load();
+}
+
 struct ChunkOutput {
   ChunkOutput(Value* v, size_t o) : val(v), offset(o){};
   Value* val;
@@ -61,6 +76,51 @@ static void CanonicalizeOps(Block* block) {
           it->output()->replaceAllUsesWith(new_output);
         }
       }
+    } else if (it->matches(
+                   "aten::div(Tensor self, Scalar other) -> Tensor",
+                   /*const_inputs=*/attr::other)) {
+      // Strength reduction: division by a constant scalar becomes
+      // multiplication by its reciprocal. Division throughput is several
+      // times worse than multiplication, but the product can differ from
+      // the division in the last bit, so this is only done under the
+      // fast-math toggle.
+      if (graphFastMathEnabled()) {
+        auto other = it->get(attr::other);
+        if (other && other->isDouble()) {
+          double divisor = other->toDouble();
+          if (divisor != 0.0 && std::isfinite(divisor) &&
+              std::isfinite(1.0 / divisor)) {
+            WithInsertPoint insert_guard{*it};
+            auto graph = it->owningGraph();
+            auto reciprocal = graph->insertConstant(1.0 / divisor);
+            Node* mul = graph->create(
+                aten::mul, {it->namedInput(attr::self), reciprocal});
+            Value* new_output = graph->insertNode(mul)->output();
+            new_output->copyMetadata(it->output());
+            it->output()->replaceAllUsesWith(new_output);
+          }
+        }
+      }
+    } else if (it->matches(
+                   "aten::pow(Tensor self, Scalar exponent) -> Tensor",
+                   /*const_inputs=*/attr::exponent)) {
+      // Strength reduction: small integer exponents become repeated
+      // multiplication. Exact, so no fast-math gate; besides skipping the
+      // pow kernel this exposes plain muls to the fuser.
+      auto exp = it->get(attr::exponent);
+      if (exp && exp->isInt() && (exp->toInt() == 2 || exp->toInt() == 3)) {
+        WithInsertPoint insert_guard{*it};
+        auto graph = it->owningGraph();
+        Value* self = it->namedInput(attr::self);
+        Node* mul = graph->create(aten::mul, {self, self});
+        Value* new_output = graph->insertNode(mul)->output();
+        if (exp->toInt() == 3) {
+          Node* mul2 = graph->create(aten::mul, {new_output, self});
+          new_output = graph->insertNode(mul2)->output();
+        }
+        new_output->copyMetadata(it->output());
+        it->output()->replaceAllUsesWith(new_output);
+      }
     } else if (it->matches(
                    "aten::chunk(Tensor self, int chunks, int dim) -> Tensor[]",
                    /*const_inputs=*/{attr::chunks, attr::dim})) {
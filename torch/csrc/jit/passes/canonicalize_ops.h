@@ -7,5 +7,12 @@ namespace jit {
 
 TORCH_API void CanonicalizeOps(const std::shared_ptr<Graph>& graph);
 
+// When enabled, CanonicalizeOps additionally applies value-changing
+// strength reductions (division by a constant scalar becomes
+// multiplication by its reciprocal, which can differ in the last bit).
+// Exact rewrites such as integer-exponent pow are applied regardless.
+TORCH_API void setGraphFastMathEnabled(bool enabled);
+TORCH_API bool graphFastMathEnabled();
+
 }
 } // namespace torch
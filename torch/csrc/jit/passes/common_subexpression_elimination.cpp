@@ -15,7 +15,7 @@ namespace {
 // Since the nodes are visited in topological order, one pass is enough.
 void EliminateCommonSubexpression(
     Block* block,
-    const AliasDb& aliasDb,
+    AliasDb& aliasDb,
     std::function<Node*(Node*)> parent_lookup_fn) {
   std::unordered_set<Node*, HashNode, EqualNode> subexprs;
   for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
@@ -61,6 +61,7 @@ void EliminateCommonSubexpression(
 
       GRAPH_UPDATE("Replacing\n", *node, "with\n", *parent_lookup);
       node->replaceAllUsesWith(parent_lookup);
+      aliasDb.removeNode(node);
       it.destroyCurrent();
       continue;
     }
@@ -81,6 +82,7 @@ void EliminateCommonSubexpression(
       GRAPH_UPDATE("Replacing\n", *node, "with\n", *existing);
       node->replaceAllUsesWith(existing);
       // Destroy the node.
+      aliasDb.removeNode(node);
       it.destroyCurrent();
     }
   }
@@ -89,6 +91,12 @@ void EliminateCommonSubexpression(
 
 void EliminateCommonSubexpression(const std::shared_ptr<Graph>& graph) {
   AliasDb aliasDb(graph);
+  EliminateCommonSubexpression(graph, aliasDb);
+}
+
+void EliminateCommonSubexpression(
+    const std::shared_ptr<Graph>& graph,
+    AliasDb& aliasDb) {
   GRAPH_DUMP("Before CSE", graph);
   EliminateCommonSubexpression(
       graph->block(), aliasDb, [](Node*) { return nullptr; });
@@ -5,7 +5,16 @@
 namespace torch {
 namespace jit {
 
+class AliasDb;
+
 TORCH_API void EliminateCommonSubexpression(
     const std::shared_ptr<Graph>& graph);
+
+// Uses a caller-provided AliasDb instead of building a fresh one, and keeps
+// it up to date (see the AliasDb incremental update API), so a pipeline of
+// passes can share one db instead of rebuilding it per pass.
+TORCH_API void EliminateCommonSubexpression(
+    const std::shared_ptr<Graph>& graph,
+    AliasDb& aliasDb);
 }
 } // namespace torch
@@ -20,6 +20,10 @@ class DeadCodeEliminator {
       : sideEffectPolicy_(sideEffectPolicy), aliasDb_(torch::make_unique<AliasDb>(std::move(graph))) {}
   DeadCodeEliminator(DCESideEffectPolicy sideEffectPolicy)
   : sideEffectPolicy_(sideEffectPolicy) {}
+  // Uses (and incrementally maintains) a caller-owned AliasDb instead of
+  // building a fresh one.
+  DeadCodeEliminator(AliasDb* aliasDb, DCESideEffectPolicy sideEffectPolicy)
+      : sideEffectPolicy_(sideEffectPolicy), externalAliasDb_(aliasDb) {}
 
   // The algorithm is an inverse mark-and-sweep. Starting from the return node,
   // we mark "live" nodes that are necessary for the output. Nodes that have
@@ -215,8 +219,8 @@ class DeadCodeEliminator {
       }
     }
 
-    if (aliasDb_) {
-      if (aliasDb_->writesToAlias(node, liveValues_)) {
+    if (aliasDb()) {
+      if (aliasDb()->writesToAlias(node, liveValues_)) {
         return mark(node);
       }
     }
@@ -280,13 +284,16 @@ class DeadCodeEliminator {
             (node->outputs().size() > 0 ? node->outputs().at(0)->debugName()
                                         : "n/a"),
             " will be removed");
+        if (externalAliasDb_) {
+          externalAliasDb_->removeNode(node);
+        }
         it.destroyCurrent();
       }
     }
   }
 
   bool hasUntrackedMutation(Node* node) {
-    if (!aliasDb_) {
+    if (!aliasDb()) {
       // If we don't have alias information, all mutable ops have unknown
       // effects and can't be considered for elimination.
       if (!node->kind().is_aten() && !node->kind().is_prim()) {
@@ -298,7 +305,7 @@ class DeadCodeEliminator {
       auto schema = node->maybeSchema();
       return schema && schema->is_mutable();
     } else {
-      return aliasDb_->writesToWildcard(node);
+      return aliasDb()->writesToWildcard(node);
     }
   }
 
@@ -337,6 +344,9 @@ class DeadCodeEliminator {
             " of node ",
             node->kind().toQualString(),
             " will be removed");
+        if (externalAliasDb_) {
+          externalAliasDb_->removeValue(node->outputs().at(i));
+        }
         node->eraseOutput(i);
         for (Block* b : node->blocks()) {
           GRAPH_UPDATE(
@@ -362,6 +372,10 @@ class DeadCodeEliminator {
       if (!node->outputs().at(i)->hasUses() &&
           !loop_body->inputs().at(loop_body_offset + i)->hasUses()) {
         logDeadLoopOutputs(node, i, loop_input_offset, loop_body_offset);
+        if (externalAliasDb_) {
+          externalAliasDb_->removeValue(node->outputs().at(i));
+          externalAliasDb_->removeValue(loop_body->inputs().at(loop_body_offset + i));
+        }
         node->eraseOutput(i);
         node->removeInput(loop_input_offset + i);
         loop_body->eraseInput(loop_body_offset + i);
@@ -402,8 +416,14 @@ class DeadCodeEliminator {
         " will be removed");
   }
 
+  AliasDb* aliasDb() const {
+    return externalAliasDb_ ? externalAliasDb_ : aliasDb_.get();
+  }
+
   DCESideEffectPolicy sideEffectPolicy_;
   std::unique_ptr<AliasDb> aliasDb_ = nullptr;
+  // Non-owning; when set, it is kept up to date as nodes are destroyed.
+  AliasDb* externalAliasDb_ = nullptr;
   std::unordered_map<Node*, bool> memo_;
   std::unordered_set<Node*> marked_;
   std::unordered_set<const Value*> liveValues_;
@@ -416,6 +436,15 @@ void EliminateDeadCode(const std::shared_ptr<Graph>& graph, DCESideEffectPolicy
   GRAPH_DUMP("After EliminateDeadCode: ", graph);
 }
 
+void EliminateDeadCode(
+    const std::shared_ptr<Graph>& graph,
+    AliasDb& aliasDb,
+    DCESideEffectPolicy sideEffectPolicy) {
+  DeadCodeEliminator(&aliasDb, sideEffectPolicy)
+      .run(graph->block(), /*recurse=*/true);
+  GRAPH_DUMP("After EliminateDeadCode: ", graph);
+}
+
 void EliminateDeadCode(Block* block, bool recurse, DCESideEffectPolicy sideEffectPolicy) {
   DeadCodeEliminator(sideEffectPolicy).run(block, recurse);
 }
@@ -21,7 +21,17 @@ enum class DCESideEffectPolicy : uint8_t {
   ALLOW_DELETING_NODES_WITH_SIDE_EFFECTS
 };
 
+class AliasDb;
+
 TORCH_API void EliminateDeadCode(const std::shared_ptr<Graph>& graph, DCESideEffectPolicy sideEffectPolicy = DCESideEffectPolicy::DONT_DELETE_NODES_WITH_SIDE_EFFECTS);
+
+// Uses a caller-provided AliasDb instead of building a fresh one, and keeps
+// it up to date (see the AliasDb incremental update API), so a pipeline of
+// passes can share one db instead of rebuilding it per pass.
+TORCH_API void EliminateDeadCode(
+    const std::shared_ptr<Graph>& graph,
+    AliasDb& aliasDb,
+    DCESideEffectPolicy sideEffectPolicy = DCESideEffectPolicy::DONT_DELETE_NODES_WITH_SIDE_EFFECTS);
 TORCH_API void EliminateDeadCode(Block* block, bool recurse = true, DCESideEffectPolicy sideEffectPolicy = DCESideEffectPolicy::DONT_DELETE_NODES_WITH_SIDE_EFFECTS);
 
 // Invoke the user-provided callback on all live values before deleting anything
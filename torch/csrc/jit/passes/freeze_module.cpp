@@ -0,0 +1,196 @@
+#include <torch/csrc/jit/passes/freeze_module.h>
+
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+#include <torch/csrc/jit/passes/constant_pooling.h>
+#include <torch/csrc/jit/passes/constant_propagation.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/inliner.h>
+
+#include <stack>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+class AttributePropagator {
+ public:
+  explicit AttributePropagator(script::Module& module) : module_(module) {}
+
+  void run(std::shared_ptr<Graph>& graph) {
+    Inline(*graph);
+    recordMutableAttrs();
+    propagateAttributes(graph);
+    ConstantPropagation(graph);
+    EliminateDeadCode(graph);
+    ConstantPooling(graph);
+  }
+
+ private:
+  static std::string attrKey(
+      const c10::ClassTypePtr& type,
+      const std::string& name) {
+    return type->name()->qualifiedName() + "." + name;
+  }
+
+  // Walks the chain of GetAttrs producing `input` back to the method's
+  // `self` and resolves it against `root`. Returns nullopt if the value is
+  // not a (sub)module reachable from `self`.
+  static c10::optional<script::Module> resolveModule(
+      Value* input,
+      Value* self,
+      const script::Module& root) {
+    std::vector<std::string> names;
+    while (input != self) {
+      Node* node = input->node();
+      if (node->kind() != prim::GetAttr) {
+        return c10::nullopt;
+      }
+      names.push_back(node->s(attr::name));
+      input = node->input(0);
+    }
+    script::Module module = root;
+    for (auto it = names.rbegin(); it != names.rend(); ++it) {
+      IValue attr = module.attr(*it);
+      if (!attr.isObject() || !attr.toObject()->type()->is_module()) {
+        return c10::nullopt;
+      }
+      module = script::Module(attr.toObject());
+    }
+    return module;
+  }
+
+  // Attributes assigned to by any method of the module or a submodule must
+  // stay attributes: folding them would bake a stale value into the graph.
+  void recordMutableAttrs() {
+    for (const script::Module& module : module_.modules()) {
+      for (Function* function : module.type()->methods()) {
+        auto graph = function->graph();
+        std::stack<Block*> blocks({graph->block()});
+        while (!blocks.empty()) {
+          Block* block = blocks.top();
+          blocks.pop();
+          for (Node* n : block->nodes()) {
+            for (Block* sub_block : n->blocks()) {
+              blocks.push(sub_block);
+            }
+            if (n->kind() != prim::SetAttr) {
+              continue;
+            }
+            auto target =
+                resolveModule(n->input(0), graph->inputs()[0], module);
+            if (target) {
+              mutableAttrs_.insert(
+                  attrKey(target->type(), n->s(attr::name)));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void propagateAttributes(std::shared_ptr<Graph>& graph) {
+    AliasDb aliasDb(graph);
+    Value* self = graph->inputs()[0];
+    std::stack<Block*> blocks({graph->block()});
+    while (!blocks.empty()) {
+      Block* block = blocks.top();
+      blocks.pop();
+      for (Node* n : block->nodes()) {
+        for (Block* sub_block : n->blocks()) {
+          blocks.push(sub_block);
+        }
+        if (n->kind() != prim::GetAttr) {
+          continue;
+        }
+        auto module = resolveModule(n->input(0), self, module_);
+        if (!module) {
+          continue;
+        }
+        const std::string& name = n->s(attr::name);
+        IValue attr = module->attr(name);
+        if (attr.isObject()) {
+          // Submodules are resolved through resolveModule at their uses;
+          // their GetAttr chains become dead once the leaves are folded.
+          continue;
+        }
+        if (mutableAttrs_.count(attrKey(module->type(), name)) ||
+            aliasDb.hasWriters(n->output())) {
+          continue;
+        }
+        if (attr.isTensor() && attr.toTensor().requires_grad()) {
+          // Frozen graphs are inference-only; constants must not require
+          // gradients.
+          attr = attr.toTensor().detach();
+        }
+        WithInsertPoint guard(n);
+        if (auto value = tryInsertConstant(*graph, attr)) {
+          n->output()->replaceAllUsesWith(*value);
+        }
+      }
+    }
+  }
+
+  script::Module& module_;
+  std::unordered_set<std::string> mutableAttrs_;
+};
+
+// Marks every tensor the frozen module can still reach - its remaining
+// attribute slots and the constants the propagator baked into the graph -
+// as inference-frozen, so in-place ops on them skip version-counter bumps
+// (see NOTE [ Inference-frozen tensors ] in c10/core/TensorImpl.h).
+// FreezeModule's clone shares tensors with the source module, so each one
+// is replaced by a detached alias first: only the frozen module's view of
+// the weight stops version counting, and the source module can still train.
+void freezeReachableTensors(
+    script::Module& module,
+    const std::shared_ptr<Graph>& graph) {
+  auto freeze = [](const at::Tensor& t) {
+    at::Tensor frozen = t.detach();
+    frozen.unsafeGetTensorImpl()->set_inference_frozen(true);
+    return frozen;
+  };
+  for (script::Module m : module.modules()) {
+    const size_t num_attributes = m.type()->numAttributes();
+    for (size_t i = 0; i < num_attributes; ++i) {
+      IValue slot = m._ivalue()->getSlot(i);
+      if (slot.isTensor() && slot.toTensor().defined()) {
+        m._ivalue()->setSlot(i, IValue(freeze(slot.toTensor())));
+      }
+    }
+  }
+  std::stack<Block*> blocks({graph->block()});
+  while (!blocks.empty()) {
+    Block* block = blocks.top();
+    blocks.pop();
+    for (Node* n : block->nodes()) {
+      for (Block* sub : n->blocks()) {
+        blocks.push(sub);
+      }
+      if (n->kind() == prim::Constant && n->hasAttribute(attr::value) &&
+          n->kindOf(attr::value) == AttributeKind::t) {
+        n->t_(attr::value, freeze(n->t(attr::value)));
+      }
+    }
+  }
+}
+
+} // namespace
+
+script::Module FreezeModule(const script::Module& module) {
+  script::Module frozen = module.clone();
+  TORCH_CHECK(
+      !frozen.hasattr("training") || !frozen.is_training(),
+      "Freezing is currently only supported for modules in eval mode. "
+      "Call .eval() before freezing.");
+  script::Method forward = frozen.get_method("forward");
+  std::shared_ptr<Graph> graph = forward.graph();
+  AttributePropagator propagator(frozen);
+  propagator.run(graph);
+  freezeReachableTensors(frozen, graph);
+  return frozen;
+}
+
+} // namespace jit
+} // namespace torch
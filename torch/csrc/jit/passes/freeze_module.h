@@ -0,0 +1,28 @@
+/** \brief This file defines freezing of TorchScript modules.
+ *
+ * Freezing clones a module and specializes its forward graph for
+ * inference: parameters and attributes become graph constants, constant
+ * propagation then folds computation on them — including
+ * `if self.training` branches, since `training` is false for a module in
+ * eval mode — and the attribute accesses left behind are removed as dead
+ * code.
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/script/module.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Freeze a module for inference.
+ *
+ * The module must be in eval mode. The returned module is a clone; the
+ * input module is untouched. Attributes that any method of the module (or
+ * of a submodule) assigns to, or that are written to through an alias in
+ * the forward graph, stay attributes instead of being folded.
+ */
+TORCH_API script::Module FreezeModule(const script::Module& module);
+
+} // namespace jit
+} // namespace torch
@@ -48,5 +48,41 @@ void FuseLinear(std::shared_ptr<Graph>& graph) {
       matmul_pattern, fused_linear_bias_none);
   matmul_to_linear.runOnGraph(graph);
 }
+
+void FuseAddmmActivation(std::shared_ptr<Graph>& graph) {
+  std::string addmm_relu_pattern = R"IR(
+    graph(%bias, %input, %weight, %4):
+        %res = aten::addmm(%bias, %input, %weight, %4, %4)
+        %out = aten::relu(%res)
+        return (%out))IR";
+  std::string fused_addmm_relu = R"IR(
+    graph(%bias, %input, %weight, %4):
+        %use_gelu : bool = prim::Constant[value=0]()
+        %out = aten::_addmm_activation(%bias, %input, %weight, %4, %4, %use_gelu)
+        return (%out))IR";
+
+  std::string addmm_gelu_pattern = R"IR(
+    graph(%bias, %input, %weight, %4):
+        %res = aten::addmm(%bias, %input, %weight, %4, %4)
+        %out = aten::gelu(%res)
+        return (%out))IR";
+  std::string fused_addmm_gelu = R"IR(
+    graph(%bias, %input, %weight, %4):
+        %use_gelu : bool = prim::Constant[value=1]()
+        %out = aten::_addmm_activation(%bias, %input, %weight, %4, %4, %use_gelu)
+        return (%out))IR";
+
+  // replace addmm + relu pattern to fused addmm with relu epilogue
+  SubgraphRewriter addmm_relu_to_fused;
+  addmm_relu_to_fused.RegisterRewritePattern(
+      addmm_relu_pattern, fused_addmm_relu);
+  addmm_relu_to_fused.runOnGraph(graph);
+
+  // replace addmm + gelu pattern to fused addmm with gelu epilogue
+  SubgraphRewriter addmm_gelu_to_fused;
+  addmm_gelu_to_fused.RegisterRewritePattern(
+      addmm_gelu_pattern, fused_addmm_gelu);
+  addmm_gelu_to_fused.runOnGraph(graph);
+}
 } // namespace jit
 } // namespace torch
@@ -13,5 +13,13 @@ namespace jit {
  * This pass can be deleted once the JIT can emit the aten::linear in the future
  */
 TORCH_API void FuseLinear(std::shared_ptr<Graph>& graph);
+
+/** \brief Rewrite addmm followed by relu or gelu into at::_addmm_activation,
+ * which applies the activation in the same pass that adds the bias.
+ * The fused op has no derivative formula, so this pass is meant for
+ * inference graphs (e.g. after freezing), before FuseLinear rewrites the
+ * addmm away.
+ */
+TORCH_API void FuseAddmmActivation(std::shared_ptr<Graph>& graph);
 } // namespace jit
 } // namespace torch
@@ -5,6 +5,7 @@
 
 #include <torch/csrc/jit/constants.h>
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/profiling_record.h>
 
 namespace torch {
 namespace jit {
@@ -210,6 +211,93 @@ void unroll(Node* loop) {
            graph->insert(aten::mul, {unrolled_iter_count, kUnrollFactor})}));
 }
 
+// Returns the trip count observed during profiling if the loop's trip count
+// input was annotated by the profiler and agreed across all profiling runs.
+c10::optional<int64_t> profiledTripCount(Node* loop) {
+  Node* producer = loop->inputs().at(0)->node();
+  if (producer->kind() != prim::profile ||
+      !producer->hasAttribute(profiledTripCountAttr())) {
+    return c10::nullopt;
+  }
+  auto count = producer->i(profiledTripCountAttr());
+  if (count < 0 || count >= kMaxBodyRepeats) {
+    return c10::nullopt;
+  }
+  return count;
+}
+
+// Specializes a loop whose trip count was runtime-stable during profiling:
+//
+//   %y = prim::Loop(%n, %true, %x)
+//
+// becomes
+//
+//   %hit = aten::eq(%n, <profiled count>)
+//   %y = prim::If(%hit)
+//     block0(): <fully unrolled copy with a constant trip count>
+//     block1(): <the original loop, for when the count changes>
+//
+// The runtime check is a single integer comparison; when it fails we simply
+// fall back to the loop we would have run anyway.
+void specializeProfiledLoop(Node* loop, int64_t count) {
+  Graph* graph = loop->owningGraph();
+  Value* trip_count = loop->inputs().at(0);
+  WithInsertPoint insert_point_guard{loop};
+
+  Value* expected = graph->insertConstant(count);
+  Value* matches = graph->insert(aten::eq, {trip_count, expected});
+  Node* versions = graph->insertNode(graph->create(prim::If, {matches}, 0));
+  Block* specialized = versions->addBlock();
+  Block* fallback = versions->addBlock();
+
+  {
+    WithInsertPoint guard{specialized};
+    Node* const_loop =
+        graph->insertNode(graph->createClone(loop, [](Value* v) { return v; }));
+    const_loop->replaceInput(0, expected);
+    for (Value* output : const_loop->outputs()) {
+      specialized->registerOutput(output);
+    }
+    // The trip count is a constant below kMaxBodyRepeats, so this fully
+    // inlines the body.
+    unroll(const_loop);
+  }
+  {
+    WithInsertPoint guard{fallback};
+    Node* dynamic_loop =
+        graph->insertNode(graph->createClone(loop, [](Value* v) { return v; }));
+    for (Value* output : dynamic_loop->outputs()) {
+      fallback->registerOutput(output);
+    }
+  }
+
+  for (Value* output : loop->outputs()) {
+    versions->addOutput()->setType(output->type());
+  }
+  for (size_t i = 0; i < loop->outputs().size(); ++i) {
+    loop->outputs()[i]->replaceAllUsesWith(versions->outputs()[i]);
+  }
+  loop->destroy();
+}
+
+void UnrollProfiledLoops(Block* block) {
+  for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+    // XXX: specialization destroys the current node, so we need to
+    // pre-increment the iterator
+    Node* node = *it;
+    ++it;
+    for (Block* subblock : node->blocks()) {
+      UnrollProfiledLoops(subblock);
+    }
+    if (!isForLoop(node) || !isSmallBlock(node->blocks().at(0))) {
+      continue;
+    }
+    if (auto count = profiledTripCount(node)) {
+      specializeProfiledLoop(node, *count);
+    }
+  }
+}
+
 void UnrollLoops(Block* block) {
   for (auto it = block->nodes().begin(); it != block->nodes().end();) {
     // XXX: unroll might destroy the current node, so we need to pre-increment
@@ -232,5 +320,10 @@ void UnrollLoops(std::shared_ptr<Graph>& graph) {
   EliminateDeadCode(graph);
 }
 
+void UnrollProfiledLoops(std::shared_ptr<Graph>& graph) {
+  UnrollProfiledLoops(graph->block());
+  EliminateDeadCode(graph);
+}
+
 } // namespace jit
 } // namespace torch
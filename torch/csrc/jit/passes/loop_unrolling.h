@@ -7,5 +7,12 @@ namespace jit {
 
 TORCH_API void UnrollLoops(std::shared_ptr<Graph>& graph);
 
+// Specializes loops whose trip counts were observed to be runtime-stable by
+// the profiling executor (see ProfilingRecord::insertTripCountProfile) into a
+// fully unrolled version guarded by a trip count check, with the original
+// loop as the fallback. Must run while prim::profile nodes are still in the
+// graph, i.e. before InsertGuards.
+TORCH_API void UnrollProfiledLoops(std::shared_ptr<Graph>& graph);
+
 }
 } // namespace torch
@@ -0,0 +1,263 @@
+#include <torch/csrc/jit/passes/memoize_subgraphs.h>
+
+#include <torch/csrc/jit/custom_operator.h>
+#include <torch/csrc/jit/interpreter.h>
+#include <torch/csrc/jit/operator.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+#include <torch/csrc/jit/passes/utils/subgraph_utils.h>
+
+#include <mutex>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool isTensorValue(const Value* v) {
+  return v->type()->isSubtypeOf(TensorType::get());
+}
+
+bool blockIsPure(Block* block, const AliasDb& aliasDb) {
+  for (Node* node : block->nodes()) {
+    if (node->hasSideEffects() || node->isNondeterministic() ||
+        aliasDb.isMutable(node)) {
+      return false;
+    }
+    for (Block* subBlock : node->blocks()) {
+      if (!blockIsPure(subBlock, aliasDb)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// State of a tensor at the moment it entered the cache. Identity of the
+// tensor itself is established separately, by comparing TensorImpl pointers
+// against the previous arguments the cache holds strong references to (see
+// Cache::inputs); the fingerprint only detects in-place changes to a held
+// tensor since it was recorded. Content is never inspected.
+struct TensorFingerprint {
+  uint32_t version = 0;
+  bool defined = false;
+  std::vector<int64_t> sizes;
+  std::vector<int64_t> strides;
+
+  bool operator==(const TensorFingerprint& other) const {
+    return version == other.version && defined == other.defined &&
+        sizes == other.sizes && strides == other.strides;
+  }
+};
+
+c10::optional<TensorFingerprint> fingerprint(const at::Tensor& tensor) {
+  TensorFingerprint fp;
+  if (!tensor.defined()) {
+    return fp;
+  }
+  if (!tensor.unsafeGetTensorImpl()->has_storage()) {
+    return c10::nullopt;
+  }
+  fp.version =
+      tensor.unsafeGetTensorImpl()->version_counter().current_version();
+  fp.defined = true;
+  fp.sizes = tensor.sizes().vec();
+  fp.strides = tensor.strides().vec();
+  return fp;
+}
+
+// True when `tensor` is the very tensor the cache holds in `held`, still in
+// the state recorded by `fp`. Comparing impl pointers is only sound because
+// the cache keeps `held` alive: a freed impl could otherwise be reallocated
+// at the same address for a fresh tensor (which starts at version 0, like
+// an unmutated old input) and serve stale results.
+bool matchesHeld(
+    const at::Tensor& tensor,
+    const at::Tensor& held,
+    const TensorFingerprint& fp) {
+  if (!fp.defined) {
+    return !tensor.defined();
+  }
+  if (!tensor.defined() ||
+      tensor.unsafeGetTensorImpl() != held.unsafeGetTensorImpl()) {
+    return false;
+  }
+  return tensor.unsafeGetTensorImpl()->version_counter().current_version() ==
+      fp.version &&
+      tensor.sizes().equals(fp.sizes) && tensor.strides().equals(fp.strides);
+}
+
+struct MemoizedGraphOp {
+  explicit MemoizedGraphOp(std::shared_ptr<Graph> subgraph)
+      : f(subgraph),
+        num_inputs(subgraph->inputs().size()),
+        num_outputs(subgraph->outputs().size()),
+        cache_(std::make_shared<Cache>()) {}
+
+  int operator()(Stack& stack) const {
+    auto fps = fingerprintInputs(last(stack, num_inputs));
+    if (fps) {
+      std::lock_guard<std::mutex> lock(cache_->mutex);
+      if (cache_->valid && heldInputsMatch(last(stack, num_inputs)) &&
+          outputsUntouched()) {
+        drop(stack, num_inputs);
+        stack.insert(
+            stack.end(), cache_->outputs.begin(), cache_->outputs.end());
+        return 0;
+      }
+    }
+
+    // retained before the interpreter pops them; the cache must hold strong
+    // references to the inputs for its impl-identity check to be valid
+    std::vector<IValue> inputs;
+    if (fps) {
+      auto in = last(stack, num_inputs);
+      inputs.assign(in.begin(), in.end());
+    }
+
+    InterpreterState(f).run(stack);
+
+    if (fps) {
+      auto outputs = last(stack, num_outputs);
+      std::lock_guard<std::mutex> lock(cache_->mutex);
+      cache_->valid = false;
+      cache_->inputs.clear();
+      cache_->output_fingerprints.clear();
+      cache_->output_fingerprints.reserve(num_outputs);
+      for (const IValue& output : outputs) {
+        if (!output.isTensor()) {
+          return 0;
+        }
+        auto ofp = fingerprint(output.toTensor());
+        if (!ofp) {
+          return 0;
+        }
+        cache_->output_fingerprints.push_back(std::move(*ofp));
+      }
+      cache_->inputs = std::move(inputs);
+      cache_->input_fingerprints = std::move(*fps);
+      cache_->outputs.assign(outputs.begin(), outputs.end());
+      cache_->valid = true;
+    }
+    return 0;
+  }
+
+ private:
+  struct Cache {
+    std::mutex mutex;
+    bool valid = false;
+    // The previous call's inputs, held strongly so their impls cannot be
+    // freed and reallocated for a different tensor while the cache compares
+    // against them (the per-iteration batch tensor would otherwise hit).
+    std::vector<IValue> inputs;
+    std::vector<TensorFingerprint> input_fingerprints;
+    // Fingerprints of the outputs taken right after they were computed,
+    // used to detect callers mutating a returned tensor in place.
+    std::vector<TensorFingerprint> output_fingerprints;
+    std::vector<IValue> outputs;
+  };
+
+  c10::optional<std::vector<TensorFingerprint>> fingerprintInputs(
+      at::ArrayRef<IValue> inputs) const {
+    std::vector<TensorFingerprint> fps;
+    fps.reserve(inputs.size());
+    for (const IValue& input : inputs) {
+      if (!input.isTensor()) {
+        return c10::nullopt;
+      }
+      auto fp = fingerprint(input.toTensor());
+      if (!fp) {
+        return c10::nullopt;
+      }
+      fps.push_back(std::move(*fp));
+    }
+    return fps;
+  }
+
+  // caller must be holding cache_->mutex
+  bool heldInputsMatch(at::ArrayRef<IValue> inputs) const {
+    if (inputs.size() != cache_->inputs.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      if (!matchesHeld(
+              inputs[i].toTensor(),
+              cache_->inputs[i].toTensor(),
+              cache_->input_fingerprints[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The cached IValues share their TensorImpls with whatever the previous
+  // caller received, so an in-place update on a returned tensor bumps the
+  // version we recorded and forces a recompute instead of serving stale
+  // (or externally modified) results.
+  bool outputsUntouched() const {
+    for (size_t i = 0; i < cache_->outputs.size(); ++i) {
+      auto fp = fingerprint(cache_->outputs[i].toTensor());
+      if (!fp || !(*fp == cache_->output_fingerprints[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Code f;
+  const size_t num_inputs;
+  const size_t num_outputs;
+  std::shared_ptr<Cache> cache_;
+};
+
+c10::OperatorOptions aliasAnalysisInternalSpecialCase() {
+  c10::OperatorOptions options;
+  options.setAliasAnalysis(AliasAnalysisKind::INTERNAL_SPECIAL_CASE);
+  return options;
+}
+
+} // namespace
+
+void MemoizeGraph(std::shared_ptr<Graph>& graph) {
+  for (const Value* input : graph->inputs()) {
+    if (!isTensorValue(input)) {
+      return;
+    }
+  }
+  for (const Value* output : graph->outputs()) {
+    if (!isTensorValue(output)) {
+      return;
+    }
+  }
+  AliasDb aliasDb(graph);
+  if (!blockIsPure(graph->block(), aliasDb)) {
+    return;
+  }
+
+  std::vector<Node*> nodes;
+  for (Node* node : graph->block()->nodes()) {
+    nodes.push_back(node);
+  }
+  if (nodes.empty()) {
+    return;
+  }
+
+  // Fold the body into a single subgraph node from last to first;
+  // SubgraphUtils rewires inputs and registers outputs for uses that
+  // remain outside (i.e. the graph returns).
+  Node* subgraphNode =
+      SubgraphUtils::createSingletonSubgraph(nodes.back(), prim::MemoizedGraph);
+  for (auto it = nodes.rbegin() + 1; it != nodes.rend(); ++it) {
+    SubgraphUtils::mergeNodeIntoSubgraph(*it, subgraphNode);
+  }
+}
+
+RegisterOperators reg_memoized_graph_ops({Operator(
+    prim::MemoizedGraph,
+    [](const Node* n) -> Operation {
+      return MemoizedGraphOp(n->g(attr::Subgraph));
+    },
+    aliasAnalysisInternalSpecialCase())});
+
+} // namespace jit
+} // namespace torch
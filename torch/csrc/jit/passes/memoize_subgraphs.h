@@ -0,0 +1,20 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Wraps the body of a pure graph (no mutation, side effects, or
+// nondeterministic ops, with tensor-only inputs and outputs) in a single
+// prim::MemoizedGraph node. At runtime the node caches its most recent
+// outputs keyed on the identity of its inputs: a call hits only when it
+// passes the same tensors (same TensorImpl, held alive by the cache) at
+// the same version counter as the previous call; content is never
+// inspected and fresh tensors never match, even if allocated where a
+// previous input lived. Graphs that are not provably pure are left
+// unchanged.
+TORCH_API void MemoizeGraph(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
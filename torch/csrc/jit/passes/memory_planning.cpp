@@ -0,0 +1,286 @@
+#include <torch/csrc/jit/passes/memory_planning.h>
+
+#include <c10/core/ScalarType.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/alias_analysis.h>
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Note [Memory planning]
+// ~~~~~~~~~~~~~~~~~~~~~~
+// Per-request inference on a graph with stable shapes re-allocates every
+// intermediate on every run. This pass removes that allocator traffic by
+// carving intermediates out of one slab per (dtype, device):
+//
+//   %slab = aten::empty([total], dtype, ...)        (once, at graph start)
+//   %buf  = aten::as_strided(%slab, sizes, strides, offset)
+//   %y    = aten::mm(%a, %b, out=%buf)
+//
+// Offsets are assigned with the classic interval-overlap heuristic: values
+// are placed largest-first, and a value may occupy the same bytes as any
+// value whose [definition, last use] interval does not overlap its own.
+// Because the planned buffers are as_strided views of the slab, they keep
+// the slab storage alive for as long as any consumer holds them; no
+// interpreter changes are needed.
+//
+// A value is only planned when all of the following hold:
+//  - it is produced by a whitelisted op with an out= variant, at the top
+//    level of the graph (values crossing control-flow blocks are skipped);
+//  - its type is complete (known sizes, dtype and device);
+//  - it is not a graph output, is never written to, and none of its uses
+//    may alias it (an alias could outlive the planned interval).
+
+struct PlannedValue {
+  Value* value;
+  std::vector<int64_t> sizes;
+  size_t nbytes;
+  // [definition, last use] node indices in the top-level block
+  size_t def;
+  size_t last_use;
+  size_t offset = 0; // byte offset into the slab, filled in by assignOffsets
+};
+
+// Slab offsets are aligned like the CPU allocator so planned buffers keep
+// the alignment vectorized kernels expect.
+constexpr size_t kSlabAlignment = 64;
+
+size_t alignUp(size_t n) {
+  return (n + kSlabAlignment - 1) & ~(kSlabAlignment - 1);
+}
+
+// Functional schemas that have a matching out= variant taking the same
+// argument names. The rewrite passes every original argument by name, so
+// only ops whose out= variant keeps the argument names may be listed here.
+const std::vector<const char*>& plannableSchemas() {
+  static const std::vector<const char*> schemas = {
+      "aten::add(Tensor self, Tensor other, *, Scalar alpha=1) -> Tensor",
+      "aten::sub(Tensor self, Tensor other, *, Scalar alpha=1) -> Tensor",
+      "aten::mul(Tensor self, Tensor other) -> Tensor",
+      "aten::div(Tensor self, Tensor other) -> Tensor",
+      "aten::mm(Tensor self, Tensor mat2) -> Tensor",
+      "aten::matmul(Tensor self, Tensor other) -> Tensor",
+      "aten::addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta=1, Scalar alpha=1) -> Tensor",
+      "aten::sigmoid(Tensor self) -> Tensor",
+      "aten::tanh(Tensor self) -> Tensor",
+  };
+  return schemas;
+}
+
+bool matchesPlannableSchema(Node* node) {
+  for (const char* schema : plannableSchemas()) {
+    if (node->matches(schema)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<int64_t> contiguousStrides(const std::vector<int64_t>& sizes) {
+  std::vector<int64_t> strides(sizes.size());
+  int64_t stride = 1;
+  for (size_t i = sizes.size(); i > 0; --i) {
+    strides[i - 1] = stride;
+    stride *= sizes[i - 1];
+  }
+  return strides;
+}
+
+// Index of the use in the top-level block, walking out of nested blocks so
+// a use inside an If/Loop pins the value for the whole enclosing node.
+c10::optional<size_t> topLevelIndex(
+    Node* node,
+    Block* top,
+    const std::unordered_map<Node*, size_t>& node_index) {
+  while (node->owningBlock() != top) {
+    node = node->owningBlock()->owningNode();
+    if (!node) {
+      return c10::nullopt;
+    }
+  }
+  auto it = node_index.find(node);
+  if (it == node_index.end()) {
+    return c10::nullopt;
+  }
+  return it->second;
+}
+
+bool intervalsOverlap(const PlannedValue& a, const PlannedValue& b) {
+  return !(a.last_use < b.def || b.last_use < a.def);
+}
+
+// Largest-first placement: each value takes the lowest aligned offset that
+// does not collide with an already-placed value of overlapping lifetime.
+// Returns the slab size in bytes.
+size_t assignOffsets(std::vector<PlannedValue>& values) {
+  std::vector<PlannedValue*> order;
+  order.reserve(values.size());
+  for (auto& v : values) {
+    order.push_back(&v);
+  }
+  std::sort(order.begin(), order.end(), [](PlannedValue* a, PlannedValue* b) {
+    return a->nbytes > b->nbytes;
+  });
+
+  size_t slab_size = 0;
+  std::vector<PlannedValue*> placed;
+  for (PlannedValue* v : order) {
+    std::vector<PlannedValue*> conflicts;
+    for (PlannedValue* p : placed) {
+      if (intervalsOverlap(*v, *p)) {
+        conflicts.push_back(p);
+      }
+    }
+    std::sort(
+        conflicts.begin(), conflicts.end(), [](PlannedValue* a, PlannedValue* b) {
+          return a->offset < b->offset;
+        });
+    size_t offset = 0;
+    for (PlannedValue* p : conflicts) {
+      if (offset + v->nbytes <= p->offset) {
+        break;
+      }
+      offset = std::max(offset, alignUp(p->offset + p->nbytes));
+    }
+    v->offset = offset;
+    slab_size = std::max(slab_size, offset + v->nbytes);
+    placed.push_back(v);
+  }
+  return alignUp(slab_size);
+}
+
+} // namespace
+
+size_t PlanMemory(const std::shared_ptr<Graph>& graph) {
+  Block* top = graph->block();
+  std::unordered_map<Node*, size_t> node_index;
+  size_t index = 0;
+  for (Node* node : top->nodes()) {
+    node_index[node] = index++;
+  }
+
+  AliasDb alias_db(graph);
+
+  // Collect plannable values grouped by (dtype, device): each group shares
+  // one slab so offsets can be expressed in whole elements. A graph rarely
+  // has more than a couple of groups, so a flat list suffices.
+  struct SlabGroup {
+    at::ScalarType dtype;
+    at::Device device;
+    std::vector<PlannedValue> values;
+  };
+  std::vector<SlabGroup> groups;
+  auto group_for = [&](at::ScalarType dtype, at::Device device) -> SlabGroup& {
+    for (auto& group : groups) {
+      if (group.dtype == dtype && group.device == device) {
+        return group;
+      }
+    }
+    groups.push_back({dtype, device, {}});
+    return groups.back();
+  };
+  for (Node* node : top->nodes()) {
+    if (node->outputs().size() != 1 || !matchesPlannableSchema(node)) {
+      continue;
+    }
+    Value* value = node->output();
+    auto type = value->type()->cast<TensorType>();
+    if (!type || !type->isComplete()) {
+      continue;
+    }
+    auto sizes = type->sizes().concrete_sizes();
+    const auto dtype = type->scalarType();
+    const auto device = type->device();
+    int64_t numel = 1;
+    for (int64_t s : *sizes) {
+      numel *= s;
+    }
+    if (numel == 0 || alias_db.hasWriters(value)) {
+      continue;
+    }
+    bool eligible = true;
+    c10::optional<size_t> last_use;
+    for (const Use& use : value->uses()) {
+      if (use.user == graph->return_node() ||
+          alias_db.mayContainAlias({value}, use.user->outputs())) {
+        eligible = false;
+        break;
+      }
+      auto use_index = topLevelIndex(use.user, top, node_index);
+      if (!use_index) {
+        eligible = false;
+        break;
+      }
+      last_use = std::max(last_use.value_or(0), *use_index);
+    }
+    if (!eligible || !last_use) {
+      continue;
+    }
+    PlannedValue planned;
+    planned.value = value;
+    planned.sizes = *sizes;
+    planned.nbytes = numel * c10::elementSize(*dtype);
+    planned.def = node_index.at(node);
+    planned.last_use = *last_use;
+    group_for(*dtype, *device).values.push_back(std::move(planned));
+  }
+
+  size_t num_planned = 0;
+  for (auto& group : groups) {
+    const at::ScalarType dtype = group.dtype;
+    std::vector<PlannedValue>& values = group.values;
+    const size_t slab_bytes = assignOffsets(values);
+    const size_t itemsize = c10::elementSize(dtype);
+
+    Value* slab;
+    {
+      WithInsertPoint guard(*top->nodes().begin());
+      slab = graph->insert(
+          aten::empty,
+          {graph->insertConstant(
+              std::vector<int64_t>{(int64_t)(slab_bytes / itemsize)})},
+          {NamedValue("dtype", graph->insertConstant((int64_t)dtype)),
+           NamedValue("device", graph->insertConstant(group.device))});
+    }
+
+    for (PlannedValue& planned : values) {
+      Node* node = planned.value->node();
+      WithInsertPoint guard(node);
+      Value* buf = graph->insert(
+          aten::as_strided,
+          {slab,
+           graph->insertConstant(planned.sizes),
+           graph->insertConstant(contiguousStrides(planned.sizes)),
+           graph->insertConstant((int64_t)(planned.offset / itemsize))});
+      std::vector<NamedValue> kwargs;
+      const auto& arguments = node->schema().arguments();
+      for (size_t i = 0; i < node->inputs().size(); ++i) {
+        kwargs.emplace_back(arguments[i].name(), node->input(i));
+      }
+      kwargs.emplace_back("out", buf);
+      Value* planned_output = graph->insert(node->kind(), {}, kwargs);
+      planned_output->setType(planned.value->type());
+      planned.value->replaceAllUsesWith(planned_output);
+      node->destroy();
+      num_planned++;
+    }
+    GRAPH_UPDATE(
+        "Planned ",
+        values.size(),
+        " values into a ",
+        slab_bytes,
+        " byte slab for ",
+        toString(dtype));
+  }
+  return num_planned;
+}
+
+} // namespace jit
+} // namespace torch
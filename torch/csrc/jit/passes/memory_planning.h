@@ -0,0 +1,20 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Plans the memory of intermediate tensors for inference graphs with a
+// frozen shape profile (i.e. complete tensor types, as produced by tracing
+// or profiled shape propagation). Eligible intermediates are assigned
+// offsets within a single preallocated slab per (dtype, device), reusing
+// the bytes of values whose lifetimes do not overlap, and their producing
+// ops are rewritten to write into slab views through their out= variants.
+// See Note [Memory planning] in memory_planning.cpp for the exact
+// eligibility rules. Returns the number of values that were planned.
+TORCH_API size_t PlanMemory(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,171 @@
+#include <torch/csrc/jit/passes/mkldnn_prepack.h>
+
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/operator.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+
+#include <ATen/Context.h>
+
+#include <stack>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// A weight is prepackable when it is a float CPU constant: mkldnn only
+// holds fp32, and a non-constant weight could be mutated between calls.
+c10::optional<at::Tensor> prepackableWeight(Value* v) {
+  auto ivalue = toIValue(v);
+  if (!ivalue || !ivalue->isTensor()) {
+    return c10::nullopt;
+  }
+  at::Tensor t = ivalue->toTensor();
+  if (!t.defined() || t.device().type() != c10::DeviceType::CPU ||
+      t.layout() != c10::kStrided || t.scalar_type() != at::kFloat) {
+    return c10::nullopt;
+  }
+  return t;
+}
+
+// Bias for the mkldnn kernels: prepacked constant when present, None
+// otherwise. Returns nullopt when the bias can't be handled statically.
+c10::optional<IValue> prepackedBias(Value* v) {
+  if (v->node()->mustBeNone()) {
+    return IValue();
+  }
+  auto bias = prepackableWeight(v);
+  if (!bias) {
+    return c10::nullopt;
+  }
+  return IValue(bias->contiguous().to_mkldnn());
+}
+
+bool rewriteLinear(Node* n) {
+  auto weight = prepackableWeight(n->input(1));
+  if (!weight || weight->dim() != 2) {
+    return false;
+  }
+  auto bias = prepackedBias(n->input(2));
+  if (!bias) {
+    return false;
+  }
+
+  Graph* graph = n->owningGraph();
+  WithInsertPoint guard(n);
+  Value* packed_weight =
+      graph->insertConstant(weight->contiguous().to_mkldnn());
+  Value* packed_bias = graph->insertConstant(*bias);
+  Value* input = graph->insert(Symbol::aten("to_mkldnn"), {n->input(0)});
+  Value* output =
+      graph->insert(Symbol::aten("mkldnn_linear"), {input, packed_weight, packed_bias});
+  output = graph->insert(Symbol::aten("to_dense"), {output});
+  n->output()->replaceAllUsesWith(output);
+  return true;
+}
+
+bool rewriteConv2d(Node* n) {
+  auto weight = prepackableWeight(n->input(1));
+  if (!weight || weight->dim() != 4) {
+    return false;
+  }
+  auto bias = prepackedBias(n->input(2));
+  if (!bias) {
+    return false;
+  }
+  // The reorder needs the conv parameters at pass time.
+  auto stride = constant_as<c10::List<int64_t>>(n->input(3));
+  auto padding = constant_as<c10::List<int64_t>>(n->input(4));
+  auto dilation = constant_as<c10::List<int64_t>>(n->input(5));
+  auto groups = constant_as<int64_t>(n->input(6));
+  if (!stride || !padding || !dilation || !groups) {
+    return false;
+  }
+
+  at::Tensor packed = at::mkldnn_reorder_conv2d_weight(
+      weight->contiguous().to_mkldnn(),
+      padding->vec(),
+      stride->vec(),
+      dilation->vec(),
+      *groups);
+
+  Graph* graph = n->owningGraph();
+  WithInsertPoint guard(n);
+  Value* packed_weight = graph->insertConstant(packed);
+  Value* packed_bias = graph->insertConstant(*bias);
+  Value* input = graph->insert(Symbol::aten("to_mkldnn"), {n->input(0)});
+  // conv2d dispatches to the mkldnn kernel for mkldnn inputs and accepts
+  // the reordered (possibly 5d) weight; see _convolution.
+  Value* output = graph->insert(
+      Symbol::aten("conv2d"),
+      {input,
+       packed_weight,
+       packed_bias,
+       n->input(3),
+       n->input(4),
+       n->input(5),
+       n->input(6)});
+  output = graph->insert(Symbol::aten("to_dense"), {output});
+  n->output()->replaceAllUsesWith(output);
+  return true;
+}
+
+// Cancels the dense round trip between two rewritten ops: a to_mkldnn fed
+// by a to_dense forwards the mkldnn tensor directly.
+void cancelConversionPairs(Block* block) {
+  for (Node* n : block->nodes()) {
+    for (Block* sub : n->blocks()) {
+      cancelConversionPairs(sub);
+    }
+    if (n->kind() != Symbol::aten("to_mkldnn")) {
+      continue;
+    }
+    Node* producer = n->input(0)->node();
+    if (producer->kind() == Symbol::aten("to_dense")) {
+      n->output()->replaceAllUsesWith(producer->input(0));
+    }
+  }
+}
+
+} // namespace
+
+void PrepackMKLDNNWeights(std::shared_ptr<Graph>& graph) {
+  if (!at::hasMKLDNN()) {
+    return;
+  }
+
+  const OperatorSet prepackable_ops = {
+      "aten::linear(Tensor input, Tensor weight, Tensor? bias=None) -> Tensor",
+      "aten::conv2d(Tensor input, Tensor weight, Tensor? bias=None, int[2] stride=1, int[2] padding=0, int[2] dilation=1, int groups=1) -> Tensor",
+  };
+
+  std::vector<Node*> rewritten;
+  std::stack<Block*> blocks({graph->block()});
+  while (!blocks.empty()) {
+    Block* block = blocks.top();
+    blocks.pop();
+    for (Node* n : block->nodes()) {
+      for (Block* sub : n->blocks()) {
+        blocks.push(sub);
+      }
+      if (!n->isMemberOf(prepackable_ops)) {
+        continue;
+      }
+      const bool is_linear = n->kind() == Symbol::aten("linear");
+      if (is_linear ? rewriteLinear(n) : rewriteConv2d(n)) {
+        rewritten.push_back(n);
+      }
+    }
+  }
+  for (Node* n : rewritten) {
+    n->destroy();
+  }
+  if (!rewritten.empty()) {
+    cancelConversionPairs(graph->block());
+    EliminateDeadCode(graph);
+  }
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Rewrites fp32 aten::linear and aten::conv2d nodes whose weights are
+// constants (i.e. the forward graph of a frozen module) to compute through
+// MKL-DNN on weights prepacked into the backend-preferred blocked layout:
+//
+//   %y = aten::linear(%x, %w, %b)
+// becomes
+//   %xm = aten::to_mkldnn(%x)
+//   %ym = aten::mkldnn_linear(%xm, %wm, %bm)  # %wm, %bm prepacked constants
+//   %y = aten::to_dense(%ym)
+//
+// and conv2d weights are additionally reordered with
+// mkldnn_reorder_conv2d_weight into the layout the conv kernel would
+// otherwise produce with an implicit reorder on every call. Back-to-back
+// rewritten ops hand mkldnn tensors to each other directly (the
+// to_dense/to_mkldnn pair between them is cancelled), so a conv tower
+// converts at its boundaries only.
+//
+// The pass is a no-op when ATen was built without MKL-DNN, and it leaves
+// nodes alone when the weight is not a float CPU constant. Intended to run
+// after freezing, once per loaded module; exposed as
+// torch._C._jit_pass_mkldnn_prepack.
+TORCH_API void PrepackMKLDNNWeights(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -290,17 +290,47 @@ struct PythonPrintImpl {
     }
   }
 
+  // Cheap content hash used to bucket tensor constants. Colliding tensors
+  // are still rejected by the full equality check in getOrAddTensorConstant,
+  // so this only has to be discriminating, not collision-free.
+  static size_t hashTensorConstant(const at::Tensor& t) {
+    size_t hash = static_cast<size_t>(t.scalar_type());
+    for (int64_t s : t.sizes()) {
+      hash = hash * 31 + static_cast<size_t>(s);
+    }
+    if (t.defined() && !t.is_sparse() && t.device().is_cpu() &&
+        t.is_contiguous() && t.numel() > 0) {
+      const auto* data = static_cast<const unsigned char*>(t.data_ptr());
+      size_t nbytes =
+          std::min<size_t>(t.numel() * t.element_size(), 256);
+      for (size_t i = 0; i < nbytes; ++i) {
+        hash = hash * 31 + data[i];
+      }
+    }
+    return hash;
+  }
+
   size_t getOrAddTensorConstant(at::Tensor t) {
-    // XXX - N^2 warning. This code does the exact same thing as
-    // ConstantPool, which is also N^2 in the size of the constants,
-    // because it doesn't hash any information about the tensors.
-    // We will probably need to optimize this at some point using hashing.
-    for (size_t i = 0; i < tensor_table_.size(); ++i) {
-      if (t.options().type_equal(tensor_table_[i].options()) && t.equal(tensor_table_[i])) {
-        return i;
+    // Bucket lookups by content hash so that deduplicating against a large
+    // table does not degrade into an N^2 scan. Several PythonPrint instances
+    // share one table when a module is serialized, so first index any
+    // entries appended since the last call.
+    for (; tensors_bucketed_ < tensor_table_.size(); ++tensors_bucketed_) {
+      tensor_hash_buckets_.emplace(
+          hashTensorConstant(tensor_table_[tensors_bucketed_]),
+          tensors_bucketed_);
+    }
+    size_t hash = hashTensorConstant(t);
+    auto range = tensor_hash_buckets_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      const at::Tensor& existing = tensor_table_[it->second];
+      if (t.options().type_equal(existing.options()) && t.equal(existing)) {
+        return it->second;
       }
     }
     tensor_table_.emplace_back(std::move(t));
+    tensor_hash_buckets_.emplace(hash, tensor_table_.size() - 1);
+    tensors_bucketed_ = tensor_table_.size();
     return tensor_table_.size() - 1;
   }
 
@@ -1326,6 +1356,11 @@ struct PythonPrintImpl {
   // where N is the index into this table.
   std::vector<at::Tensor>& tensor_table_;
 
+  // content-hash buckets into tensor_table_, maintained lazily by
+  // getOrAddTensorConstant (the table may be shared with other printers)
+  std::unordered_multimap<size_t, size_t> tensor_hash_buckets_;
+  size_t tensors_bucketed_ = 0;
+
   // Any NamedTypes (classes, functions, NamedTuples) used are written to this
   // table.
   std::vector<c10::NamedTypePtr>& deps_table_;
@@ -63,11 +63,53 @@ graph(%packed_params, %a_quant, %r_scale, %r_zero_point, %r_dtype):
         %r = quantized::linear(%a_quant, %packed_params, %r_scale, %r_zero_point)
         return (%r) )";
 
+  // dequantize -> {unary op} -> quantize_per_tensor chains collapse into the
+  // fused int8 kernels, which apply the op on fp32 values widened in registers
+  // instead of materializing a dequantized tensor.
+  std::string relu = R"(
+graph(%a_quant, %r_scale, %r_zero_point, %r_dtype):
+        %a_dequant = aten::dequantize(%a_quant)
+        %r = aten::relu(%a_dequant)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string quantized_relu = R"(
+graph(%a_quant, %r_scale, %r_zero_point, %r_dtype):
+        %r_quant = quantized::relu(%a_quant, %r_scale, %r_zero_point)
+        return (%r_quant) )";
+
+  std::string sigmoid = R"(
+graph(%a_quant, %r_scale, %r_zero_point, %r_dtype):
+        %a_dequant = aten::dequantize(%a_quant)
+        %r = aten::sigmoid(%a_dequant)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string quantized_sigmoid = R"(
+graph(%a_quant, %r_scale, %r_zero_point, %r_dtype):
+        %r_quant = quantized::sigmoid(%a_quant, %r_scale, %r_zero_point)
+        return (%r_quant) )";
+
+  std::string tanh = R"(
+graph(%a_quant, %r_scale, %r_zero_point, %r_dtype):
+        %a_dequant = aten::dequantize(%a_quant)
+        %r = aten::tanh(%a_dequant)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string quantized_tanh = R"(
+graph(%a_quant, %r_scale, %r_zero_point, %r_dtype):
+        %r_quant = quantized::tanh(%a_quant, %r_scale, %r_zero_point)
+        return (%r_quant) )";
+
   return {
     {conv2d, quantized_conv2d},
     {addmm, quantized_linear},
     {matmul_with_bias, quantized_linear},
-    {matmul_no_bias, quantized_linear_no_bias}
+    {matmul_no_bias, quantized_linear_no_bias},
+    {relu, quantized_relu},
+    {sigmoid, quantized_sigmoid},
+    {tanh, quantized_tanh}
   };
 
 }
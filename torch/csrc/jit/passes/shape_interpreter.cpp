@@ -0,0 +1,457 @@
+#include <torch/csrc/jit/passes/shape_interpreter.h>
+
+#include <ATen/ExpandUtils.h>
+#include <torch/csrc/jit/constants.h>
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+struct ShapeFunctionRegistry {
+  std::mutex mutex;
+  std::unordered_map<Symbol, ShapeFunction> functions;
+};
+
+ShapeFunctionRegistry& registry() {
+  static ShapeFunctionRegistry r;
+  return r;
+}
+
+int64_t numelOf(const ShapeVec& shape) {
+  return std::accumulate(
+      shape.begin(), shape.end(), static_cast<int64_t>(1),
+      std::multiplies<int64_t>());
+}
+
+int64_t wrapDim(int64_t dim, int64_t ndim) {
+  return dim < 0 ? dim + ndim : dim;
+}
+
+c10::optional<std::vector<ShapeVec>> one(ShapeVec shape) {
+  return std::vector<ShapeVec>{std::move(shape)};
+}
+
+// The output of an elementwise unary op (and of ops like batch_norm or
+// dropout) has the shape of its first input.
+c10::optional<std::vector<ShapeVec>> passthrough(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto self = lookup(node->input(0));
+  if (!self) {
+    return c10::nullopt;
+  }
+  return one(*self);
+}
+
+// Broadcasting binary ops; the Tensor-Scalar overloads keep the shape of the
+// first input.
+c10::optional<std::vector<ShapeVec>> broadcastBinary(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto self = lookup(node->input(0));
+  if (!self) {
+    return c10::nullopt;
+  }
+  if (node->inputs().size() > 1 &&
+      node->input(1)->type()->isSubtypeOf(TensorType::get())) {
+    auto other = lookup(node->input(1));
+    if (!other) {
+      return c10::nullopt;
+    }
+    return one(at::infer_size(*self, *other));
+  }
+  return one(*self);
+}
+
+c10::optional<std::vector<ShapeVec>> mmShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto self = lookup(node->input(0));
+  auto other = lookup(node->input(1));
+  if (!self || !other || self->size() != 2 || other->size() != 2) {
+    return c10::nullopt;
+  }
+  return one({(*self)[0], (*other)[1]});
+}
+
+c10::optional<std::vector<ShapeVec>> bmmShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto self = lookup(node->input(0));
+  auto other = lookup(node->input(1));
+  if (!self || !other || self->size() != 3 || other->size() != 3) {
+    return c10::nullopt;
+  }
+  return one({(*self)[0], (*self)[1], (*other)[2]});
+}
+
+c10::optional<std::vector<ShapeVec>> addmmShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto mat1 = lookup(node->input(1));
+  auto mat2 = lookup(node->input(2));
+  if (!mat1 || !mat2 || mat1->size() != 2 || mat2->size() != 2) {
+    return c10::nullopt;
+  }
+  return one({(*mat1)[0], (*mat2)[1]});
+}
+
+c10::optional<std::vector<ShapeVec>> matmulShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto a = lookup(node->input(0));
+  auto b = lookup(node->input(1));
+  if (!a || !b || a->empty() || b->empty()) {
+    return c10::nullopt;
+  }
+  if (a->size() == 1 && b->size() == 1) {
+    return one({});
+  }
+  if (a->size() == 2 && b->size() == 1) {
+    return one({(*a)[0]});
+  }
+  if (a->size() == 1 && b->size() == 2) {
+    return one({(*b)[1]});
+  }
+  // batched case: broadcast the batch dimensions, then append the matrix
+  // dimensions (with 1-d operands promoted and squeezed as matmul does)
+  ShapeVec a_batch(a->begin(), a->end() - std::min<size_t>(2, a->size()));
+  ShapeVec b_batch(b->begin(), b->end() - std::min<size_t>(2, b->size()));
+  ShapeVec result = at::infer_size(a_batch, b_batch);
+  if (a->size() >= 2) {
+    result.push_back((*a)[a->size() - 2]);
+  }
+  if (b->size() >= 2) {
+    result.push_back(b->back());
+  }
+  return one(std::move(result));
+}
+
+c10::optional<std::vector<ShapeVec>> linearShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto input = lookup(node->input(0));
+  auto weight = lookup(node->input(1));
+  if (!input || !weight || input->empty() || weight->size() != 2) {
+    return c10::nullopt;
+  }
+  ShapeVec result = *input;
+  result.back() = (*weight)[0];
+  return one(std::move(result));
+}
+
+c10::optional<std::vector<ShapeVec>> tShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto self = lookup(node->input(0));
+  if (!self) {
+    return c10::nullopt;
+  }
+  ShapeVec result = *self;
+  if (result.size() == 2) {
+    std::swap(result[0], result[1]);
+  }
+  return one(std::move(result));
+}
+
+c10::optional<std::vector<ShapeVec>> transposeShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto self = lookup(node->input(0));
+  auto dim0 = node->get<int64_t>(attr::dim0);
+  auto dim1 = node->get<int64_t>(attr::dim1);
+  if (!self || !dim0 || !dim1) {
+    return c10::nullopt;
+  }
+  ShapeVec result = *self;
+  auto ndim = static_cast<int64_t>(result.size());
+  std::swap(result[wrapDim(*dim0, ndim)], result[wrapDim(*dim1, ndim)]);
+  return one(std::move(result));
+}
+
+c10::optional<std::vector<ShapeVec>> viewShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto self = lookup(node->input(0));
+  auto size = node->get<c10::List<int64_t>>(
+      node->kind() == aten::reshape ? attr::shape : attr::size);
+  if (!self || !size) {
+    return c10::nullopt;
+  }
+  ShapeVec result = size->vec();
+  int64_t known = 1;
+  int64_t infer_index = -1;
+  for (size_t i = 0; i < result.size(); i++) {
+    if (result[i] == -1) {
+      infer_index = i;
+    } else {
+      known *= result[i];
+    }
+  }
+  if (infer_index >= 0) {
+    if (known == 0) {
+      return c10::nullopt;
+    }
+    result[infer_index] = numelOf(*self) / known;
+  }
+  return one(std::move(result));
+}
+
+c10::optional<std::vector<ShapeVec>> flattenShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto self = lookup(node->input(0));
+  auto start = node->get<int64_t>(attr::start_dim);
+  auto end = node->get<int64_t>(attr::end_dim);
+  if (!self || !start || !end) {
+    return c10::nullopt;
+  }
+  auto ndim = static_cast<int64_t>(self->size());
+  if (ndim == 0) {
+    return one({1});
+  }
+  int64_t start_dim = wrapDim(*start, ndim);
+  int64_t end_dim = wrapDim(*end, ndim);
+  ShapeVec result(self->begin(), self->begin() + start_dim);
+  int64_t flat = 1;
+  for (int64_t i = start_dim; i <= end_dim; i++) {
+    flat *= (*self)[i];
+  }
+  result.push_back(flat);
+  result.insert(result.end(), self->begin() + end_dim + 1, self->end());
+  return one(std::move(result));
+}
+
+c10::optional<std::vector<ShapeVec>> catShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  Node* list = node->input(0)->node();
+  auto dim = node->get<int64_t>(attr::dim);
+  if (list->kind() != prim::ListConstruct || list->inputs().empty() || !dim) {
+    return c10::nullopt;
+  }
+  auto first = lookup(list->input(0));
+  if (!first || first->empty()) {
+    return c10::nullopt;
+  }
+  ShapeVec result = *first;
+  int64_t cat_dim = wrapDim(*dim, result.size());
+  for (size_t i = 1; i < list->inputs().size(); i++) {
+    auto shape = lookup(list->input(i));
+    if (!shape || shape->size() != result.size()) {
+      return c10::nullopt;
+    }
+    result[cat_dim] += (*shape)[cat_dim];
+  }
+  return one(std::move(result));
+}
+
+c10::optional<std::vector<ShapeVec>> conv2dShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto input = lookup(node->input(0));
+  auto weight = lookup(node->input(1));
+  auto stride = node->get<c10::List<int64_t>>(attr::stride);
+  auto padding = node->get<c10::List<int64_t>>(attr::padding);
+  auto dilation = node->get<c10::List<int64_t>>(attr::dilation);
+  if (!input || !weight || input->size() != 4 || weight->size() != 4 ||
+      !stride || !padding || !dilation) {
+    return c10::nullopt;
+  }
+  ShapeVec result = {(*input)[0], (*weight)[0], 0, 0};
+  for (int64_t i = 0; i < 2; i++) {
+    int64_t in = (*input)[2 + i];
+    int64_t kernel = (*weight)[2 + i];
+    result[2 + i] = (in + 2 * padding->get(i) -
+                     dilation->get(i) * (kernel - 1) - 1) /
+            stride->get(i) +
+        1;
+  }
+  return one(std::move(result));
+}
+
+c10::optional<std::vector<ShapeVec>> pool2dShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto input = lookup(node->input(0));
+  auto kernel = node->get<c10::List<int64_t>>(attr::kernel_size);
+  auto stride = node->get<c10::List<int64_t>>(attr::stride);
+  auto padding = node->get<c10::List<int64_t>>(attr::padding);
+  auto ceil_mode = node->get<bool>(attr::ceil_mode);
+  if (!input || (input->size() != 3 && input->size() != 4) || !kernel ||
+      !stride || !padding || !ceil_mode) {
+    return c10::nullopt;
+  }
+  c10::optional<c10::List<int64_t>> dilation;
+  if (node->kind() == aten::max_pool2d) {
+    dilation = node->get<c10::List<int64_t>>(attr::dilation);
+    if (!dilation) {
+      return c10::nullopt;
+    }
+  }
+  ShapeVec result = *input;
+  size_t offset = input->size() - 2;
+  for (int64_t i = 0; i < 2; i++) {
+    int64_t in = (*input)[offset + i];
+    int64_t k = kernel->get(i);
+    // an empty stride list means "stride = kernel_size"
+    int64_t s = stride->empty() ? k : stride->get(i);
+    int64_t d = dilation ? dilation->get(i) : 1;
+    int64_t numerator = in + 2 * padding->get(i) - d * (k - 1) - 1;
+    int64_t out = numerator / s + 1;
+    if (*ceil_mode && numerator % s != 0) {
+      out += 1;
+    }
+    result[offset + i] = out;
+  }
+  return one(std::move(result));
+}
+
+c10::optional<std::vector<ShapeVec>> adaptiveAvgPool2dShape(
+    Node* node,
+    const ShapeLookup& lookup) {
+  auto input = lookup(node->input(0));
+  auto output_size = node->get<c10::List<int64_t>>(attr::output_size);
+  if (!input || (input->size() != 3 && input->size() != 4) || !output_size ||
+      output_size->size() != 2) {
+    return c10::nullopt;
+  }
+  ShapeVec result = *input;
+  result[result.size() - 2] = output_size->get(0);
+  result[result.size() - 1] = output_size->get(1);
+  return one(std::move(result));
+}
+
+c10::optional<ShapeFunction> findShapeFunction(Symbol op) {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  auto it = r.functions.find(op);
+  if (it == r.functions.end()) {
+    return c10::nullopt;
+  }
+  return it->second;
+}
+
+struct RegisterBuiltinShapeFunctions {
+  RegisterBuiltinShapeFunctions() {
+    for (auto op :
+         {aten::add,        aten::sub,   aten::mul,  aten::div,
+          aten::pow,        aten::atan2, aten::fmod, aten::remainder}) {
+      RegisterShapeFunction(op, broadcastBinary);
+    }
+    for (auto op :
+         {aten::relu,        aten::sigmoid,    aten::tanh,
+          aten::exp,         aten::log,        aten::neg,
+          aten::abs,         aten::sqrt,       aten::rsqrt,
+          aten::erf,         aten::gelu,       aten::hardtanh,
+          aten::threshold,   aten::dropout,    aten::softmax,
+          aten::log_softmax, aten::clone,      aten::contiguous,
+          aten::detach,      aten::batch_norm, aten::layer_norm}) {
+      RegisterShapeFunction(op, passthrough);
+    }
+    RegisterShapeFunction(aten::mm, mmShape);
+    RegisterShapeFunction(aten::bmm, bmmShape);
+    RegisterShapeFunction(aten::addmm, addmmShape);
+    RegisterShapeFunction(aten::matmul, matmulShape);
+    RegisterShapeFunction(aten::linear, linearShape);
+    RegisterShapeFunction(aten::t, tShape);
+    RegisterShapeFunction(aten::transpose, transposeShape);
+    RegisterShapeFunction(aten::view, viewShape);
+    RegisterShapeFunction(aten::reshape, viewShape);
+    RegisterShapeFunction(aten::flatten, flattenShape);
+    RegisterShapeFunction(aten::cat, catShape);
+    RegisterShapeFunction(aten::conv2d, conv2dShape);
+    RegisterShapeFunction(aten::max_pool2d, pool2dShape);
+    RegisterShapeFunction(aten::avg_pool2d, pool2dShape);
+    RegisterShapeFunction(aten::adaptive_avg_pool2d, adaptiveAvgPool2dShape);
+  }
+};
+
+RegisterBuiltinShapeFunctions register_builtins;
+
+} // namespace
+
+void RegisterShapeFunction(Symbol op, ShapeFunction fn) {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.functions[op] = std::move(fn);
+}
+
+bool HasShapeFunction(Symbol op) {
+  return findShapeFunction(op).has_value();
+}
+
+std::vector<c10::optional<ShapeVec>> InferShapes(
+    Graph& graph,
+    const std::vector<c10::optional<ShapeVec>>& input_shapes) {
+  TORCH_CHECK(
+      input_shapes.size() == graph.inputs().size(),
+      "InferShapes: expected ",
+      graph.inputs().size(),
+      " input shapes, got ",
+      input_shapes.size());
+
+  std::unordered_map<const Value*, ShapeVec> env;
+  for (size_t i = 0; i < input_shapes.size(); i++) {
+    if (input_shapes[i]) {
+      env[graph.inputs()[i]] = *input_shapes[i];
+    }
+  }
+  ShapeLookup lookup = [&](const Value* value) -> c10::optional<ShapeVec> {
+    auto it = env.find(value);
+    if (it == env.end()) {
+      return c10::nullopt;
+    }
+    return it->second;
+  };
+
+  for (Node* node : graph.nodes()) {
+    if (node->kind() == prim::Constant) {
+      if (node->output()->type()->isSubtypeOf(TensorType::get())) {
+        if (auto ival = toIValue(node->output())) {
+          env[node->output()] = ival->toTensor().sizes().vec();
+        }
+      }
+      continue;
+    }
+    // control flow is not interpreted; its outputs stay unknown
+    if (!node->blocks().empty()) {
+      continue;
+    }
+    auto fn = findShapeFunction(node->kind());
+    if (!fn) {
+      continue;
+    }
+    c10::optional<std::vector<ShapeVec>> outputs;
+    try {
+      outputs = (*fn)(node, lookup);
+    } catch (const std::exception&) {
+      // a shape function observing inconsistent shapes (e.g. a failed
+      // broadcast) just yields unknown outputs
+      outputs = c10::nullopt;
+    }
+    if (!outputs) {
+      continue;
+    }
+    size_t n = std::min(outputs->size(), node->outputs().size());
+    for (size_t i = 0; i < n; i++) {
+      env[node->output(i)] = std::move((*outputs)[i]);
+    }
+  }
+
+  std::vector<c10::optional<ShapeVec>> result;
+  result.reserve(graph.outputs().size());
+  for (const Value* output : graph.outputs()) {
+    result.push_back(lookup(output));
+  }
+  return result;
+}
+
+} // namespace jit
+} // namespace torch
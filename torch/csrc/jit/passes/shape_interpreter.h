@@ -0,0 +1,53 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+#include <functional>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// The shape interpreter answers "what shapes do these outputs have for these
+// input shapes" without running any ops, so callers (e.g. a serving tier
+// doing admission control or output preallocation) can get an answer in
+// microseconds. It walks the graph once, evaluating shape functions from a
+// registry kept parallel to op registration; ops without a registered shape
+// function simply yield unknown shapes, which then propagate.
+//
+// This differs from PropagateInputShapes in two ways: it never executes an
+// op to discover an output shape, and it reports concrete shapes to the
+// caller instead of annotating the graph's types.
+
+using ShapeVec = std::vector<int64_t>;
+
+// Resolves the shape of a Value in the current evaluation, or nullopt if it
+// is not a tensor or its shape is unknown. Works for list elements too (e.g.
+// the inputs of a prim::ListConstruct feeding aten::cat).
+using ShapeLookup = std::function<c10::optional<ShapeVec>(const Value*)>;
+
+// A shape function computes the output shapes of a node from the shapes of
+// its tensor inputs, resolved through `lookup`. Constant non-tensor arguments
+// (strides, dims, ...) should be read off the node with Node::get. Returning
+// nullopt marks all outputs as unknown.
+using ShapeFunction = std::function<c10::optional<std::vector<ShapeVec>>(
+    Node* node,
+    const ShapeLookup& lookup)>;
+
+// Registers `fn` as the shape function for `op`, replacing any previous one.
+TORCH_API void RegisterShapeFunction(Symbol op, ShapeFunction fn);
+
+// Returns true if a shape function is registered for `op`.
+TORCH_API bool HasShapeFunction(Symbol op);
+
+// Evaluates shape functions over `graph` given shapes for the graph's tensor
+// inputs (nullopt for non-tensor inputs or unknown shapes). Returns one entry
+// per graph output: the inferred shape, or nullopt where it could not be
+// determined. Nodes with sub-blocks (control flow) are not interpreted and
+// yield unknown shapes.
+TORCH_API std::vector<c10::optional<ShapeVec>> InferShapes(
+    Graph& graph,
+    const std::vector<c10::optional<ShapeVec>>& input_shapes);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,203 @@
+#include <torch/csrc/jit/passes/tensor_core_advisor.h>
+
+#include <sstream>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Ops that cuBLAS/cuDNN can run on tensor cores when the dtype and shapes
+// cooperate.
+bool isGemmLike(Node* n) {
+  switch (n->kind()) {
+    case aten::mm:
+    case aten::bmm:
+    case aten::addmm:
+    case aten::baddbmm:
+    case aten::matmul:
+    case aten::linear:
+      return true;
+    default:
+      return n->kind() == aten::conv1d || n->kind() == aten::conv2d ||
+          n->kind() == aten::conv3d || n->kind() == aten::convolution ||
+          n->kind() == aten::_convolution;
+  }
+}
+
+bool isConvLike(Node* n) {
+  return n->kind() == aten::conv1d || n->kind() == aten::conv2d ||
+      n->kind() == aten::conv3d || n->kind() == aten::convolution ||
+      n->kind() == aten::_convolution;
+}
+
+bool isLayoutConversion(Node* n) {
+  return n->kind() == aten::t || n->kind() == aten::transpose ||
+      n->kind() == aten::permute || n->kind() == aten::contiguous;
+}
+
+// The profiled tensor type of a value, or nullptr if none was recorded.
+TensorTypePtr profiledType(Value* v) {
+  auto type = v->type()->cast<TensorType>();
+  if (!type || type == TensorType::get()) {
+    return nullptr;
+  }
+  return type;
+}
+
+bool isOnCuda(const TensorTypePtr& type) {
+  auto device = type->device();
+  return device && device->is_cuda();
+}
+
+std::string sizesStr(const TensorTypePtr& type) {
+  auto sizes = type->sizes().concrete_sizes();
+  if (!sizes) {
+    return "[unknown]";
+  }
+  std::ostringstream oss;
+  oss << '[';
+  for (size_t i = 0; i < sizes->size(); ++i) {
+    if (i != 0) {
+      oss << ", ";
+    }
+    oss << (*sizes)[i];
+  }
+  oss << ']';
+  return oss.str();
+}
+
+void addAdvisory(
+    std::vector<TensorCoreAdvisory>& report,
+    Node* n,
+    const char* category,
+    std::string message) {
+  report.push_back(
+      {n->kind().toQualString(), category, std::move(message)});
+}
+
+// Tensor cores need every GEMM dimension to be a multiple of 8 (fp16).
+// For matmuls the contraction and output dimensions are the last two dims
+// of each operand; for convolutions the channel dimension is what cuDNN
+// requires to be aligned.
+void checkAlignment(
+    Node* n,
+    std::vector<TensorCoreAdvisory>& report) {
+  for (size_t i = 0; i < n->inputs().size(); ++i) {
+    auto type = profiledType(n->input(i));
+    if (!type || !isOnCuda(type) ||
+        type->scalarType() != at::ScalarType::Half) {
+      continue;
+    }
+    auto sizes = type->sizes().concrete_sizes();
+    if (!sizes || sizes->empty()) {
+      continue;
+    }
+    std::vector<int64_t> misaligned;
+    if (isConvLike(n)) {
+      if (sizes->size() > 1 && (*sizes)[1] % 8 != 0) {
+        misaligned.push_back((*sizes)[1]);
+      }
+    } else {
+      size_t first = sizes->size() > 2 ? sizes->size() - 2 : 0;
+      for (size_t d = first; d < sizes->size(); ++d) {
+        if ((*sizes)[d] % 8 != 0) {
+          misaligned.push_back((*sizes)[d]);
+        }
+      }
+    }
+    if (misaligned.empty()) {
+      continue;
+    }
+    std::ostringstream oss;
+    oss << "fp16 input " << i << " has shape " << sizesStr(type)
+        << "; dimension";
+    oss << (misaligned.size() > 1 ? "s " : " ");
+    for (size_t d = 0; d < misaligned.size(); ++d) {
+      if (d != 0) {
+        oss << ", ";
+      }
+      oss << misaligned[d];
+    }
+    oss << (misaligned.size() > 1 ? " are" : " is")
+        << " not a multiple of 8, so tensor cores are not used";
+    addAdvisory(report, n, "tensor_core_alignment", oss.str());
+  }
+}
+
+void analyzeNode(Node* n, std::vector<TensorCoreAdvisory>& report) {
+  // the advisor reads profile information; profile nodes themselves are
+  // pass-throughs and not interesting
+  if (n->kind() == prim::profile) {
+    return;
+  }
+
+  auto out_type =
+      n->outputs().empty() ? nullptr : profiledType(n->output(0));
+
+  if (isGemmLike(n) && out_type && isOnCuda(out_type)) {
+    if (out_type->scalarType() == at::ScalarType::Float) {
+      addAdvisory(
+          report,
+          n,
+          "fp32_gemm",
+          std::string("runs in fp32 on ") + out_type->device()->str() +
+              " with output shape " + sizesStr(out_type) +
+              "; candidate for fp16 tensor cores");
+    } else if (out_type->scalarType() == at::ScalarType::Half) {
+      checkAlignment(n, report);
+    }
+  }
+
+  if (out_type && isOnCuda(out_type) &&
+      out_type->scalarType() == at::ScalarType::Float) {
+    for (size_t i = 0; i < n->inputs().size(); ++i) {
+      auto in_type = profiledType(n->input(i));
+      if (in_type && in_type->scalarType() == at::ScalarType::Half) {
+        addAdvisory(
+            report,
+            n,
+            "dtype_promotion",
+            "input " + std::to_string(i) +
+                " is fp16 but the output is promoted to fp32");
+        break;
+      }
+    }
+  }
+
+  if (isLayoutConversion(n) && out_type && isOnCuda(out_type)) {
+    for (auto& use : n->output(0)->uses()) {
+      if (isGemmLike(use.user)) {
+        addAdvisory(
+            report,
+            n,
+            "layout_conversion",
+            std::string("output ") + sizesStr(out_type) +
+                " feeds directly into " + use.user->kind().toQualString() +
+                "; the conversion runs on the hot path");
+        break;
+      }
+    }
+  }
+}
+
+void analyzeBlock(Block* block, std::vector<TensorCoreAdvisory>& report) {
+  for (auto n : block->nodes()) {
+    analyzeNode(n, report);
+    for (auto b : n->blocks()) {
+      analyzeBlock(b, report);
+    }
+  }
+}
+
+} // namespace
+
+std::vector<TensorCoreAdvisory> TensorCoreAdvisor(
+    const std::shared_ptr<Graph>& graph) {
+  std::vector<TensorCoreAdvisory> report;
+  analyzeBlock(graph->block(), report);
+  return report;
+}
+
+} // namespace jit
+} // namespace torch
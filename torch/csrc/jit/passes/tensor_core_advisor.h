@@ -0,0 +1,41 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// One finding of the tensor-core advisor. `node_kind` is the qualified
+// operator name of the node the advisory is about, `category` is one of:
+//
+//   "fp32_gemm"             a matmul/conv runs in fp32 on CUDA and is a
+//                           candidate for fp16/tensor cores
+//   "tensor_core_alignment" an fp16 matmul/conv has dimensions that are
+//                           not multiples of 8, so cuBLAS/cuDNN fall back
+//                           to non-tensor-core kernels
+//   "dtype_promotion"       a node mixes fp16 and fp32 tensor inputs and
+//                           promotes its result to fp32
+//   "layout_conversion"     a transpose/permute/contiguous feeds directly
+//                           into a matmul/conv
+//
+// `message` is a human-readable description including observed shapes.
+struct TensorCoreAdvisory {
+  std::string node_kind;
+  std::string category;
+  std::string message;
+};
+
+// Analyzes a graph whose values carry profiled tensor types (dtype, device
+// and sizes, as recorded by the profiling executor) and reports, per node,
+// missed tensor-core opportunities: fp32 gemms, misaligned fp16 gemm
+// shapes, fp32-forcing promotion chains and layout-conversion hotspots.
+// Values without a recorded CUDA device are skipped, so the report is only
+// as complete as the profiling information in the graph.
+TORCH_API std::vector<TensorCoreAdvisory> TensorCoreAdvisor(
+    const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
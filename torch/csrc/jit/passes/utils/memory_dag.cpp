@@ -106,6 +106,12 @@ void MemoryDAG::addToContainedElements(Element* elem, Element* container) {
   container->containedElements.set(elem->index);
 }
 
+void MemoryDAG::invalidateMemoryLocationCaches() {
+  for (const auto& element : indexToElementMap_) {
+    element->cachedMemoryLocations_.clear();
+  }
+}
+
 // Give `v` a fresh alias (i.e. it does not point to any value)
 Element* MemoryDAG::makeFreshValue(const Value* v) {
   indexToElementMap_.emplace_back(
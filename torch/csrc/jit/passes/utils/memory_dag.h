@@ -50,6 +50,12 @@ class TORCH_API MemoryDAG {
   // return it.
   Element* makeFreshValue(const Value* v);
 
+  // Drop every element's cached memory locations. Needed when edges are
+  // added after queries have already run and populated caches (see the
+  // AliasDb incremental update API); caches are rebuilt lazily on the next
+  // query.
+  void invalidateMemoryLocationCaches();
+
   // Do `a` and `b` potentially share a memory location?
   bool mayAlias(const Element* a, const Element* b) const;
   bool mayAlias(Element* a, Element* b) const;
@@ -35,7 +35,9 @@ std::vector<char> pickle(
 
 // This has to live here instead of the C++ API to mirror torch.save since the
 // mobile build excludes the C++ API
-std::vector<char> pickle_save(const at::IValue& ivalue) {
+std::vector<char> pickle_save(
+    const at::IValue& ivalue,
+    bool consolidate_small_tensors) {
 #ifndef C10_MOBILE
   // Pickle the IValue into an array of bytes
   std::vector<char> pickle_data;
@@ -44,7 +46,8 @@ std::vector<char> pickle_save(const at::IValue& ivalue) {
         pickle_data.insert(pickle_data.end(), buf, buf + size);
       },
       /*tensor_table=*/nullptr,
-      /*class_table=*/nullptr);
+      /*class_table=*/nullptr,
+      consolidate_small_tensors);
   pickler.protocol();
   pickler.pushIValue(ivalue);
   pickler.stop();
@@ -66,7 +69,8 @@ std::vector<char> pickle_save(const at::IValue& ivalue) {
       pickle_data.data(),
       pickle_data.size(),
       pickler.tensorData(),
-      writer);
+      writer,
+      &pickler.consolidatedTensorData());
   return container_data;
 #else
   AT_ERROR(
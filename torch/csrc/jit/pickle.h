@@ -55,7 +55,15 @@ TORCH_API std::vector<char> pickle(
 
 /// Save a `torch::IValue` in a format that can be loaded by both
 /// `torch::pickle_load` in C++ and `torch.load` in Python.
-TORCH_API std::vector<char> pickle_save(const IValue& ivalue);
+///
+/// With `consolidate_small_tensors` set, small tensor storages are coalesced
+/// into one shared record instead of one record each, which avoids the
+/// per-record container overhead when saving values that contain many tiny
+/// tensors. The resulting bytes can only be read back by
+/// `torch::pickle_load`.
+TORCH_API std::vector<char> pickle_save(
+    const IValue& ivalue,
+    bool consolidate_small_tensors = false);
 
 /// Deserialize a `torch::IValue` from bytes produced by either
 /// `torch::pickle_save` in C++ or `torch.save` in Python
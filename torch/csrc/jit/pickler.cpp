@@ -273,6 +273,11 @@ void Pickler::pushStorageOfTensor(const at::Tensor& tensor) {
     return;
   }
 
+  auto data = getWriteableTensorData(tensor);
+  const bool consolidate = consolidate_small_tensors_ &&
+      storage.device_type() == at::DeviceType::CPU &&
+      data.sizeInBytes() <= kSmallStorageMaxBytes;
+
   // Tuple for persistent_load
   push<PickleOpCode>(PickleOpCode::MARK);
   // typename
@@ -282,18 +287,34 @@ void Pickler::pushStorageOfTensor(const at::Tensor& tensor) {
     std::string(toString(tensor.scalar_type())).append("Storage");
   pushGlobal("torch", data_type);
   // root_key
-  pushString(c10::to_string(tensor_data_.size()));
+  pushString(
+      consolidate ? std::string(kConsolidatedStorageRecordName)
+                  : c10::to_string(tensor_data_.size()));
   // location
   pushString(tensor.device().str());
   // size
   pushInt(tensor.storage().size());
+  if (consolidate) {
+    // byte offset of this storage within the consolidated record; the
+    // 6-element tuple is what tells the unpickler to view into the shared
+    // record rather than read a record of its own
+    size_t offset = consolidated_tensor_data_.size();
+    offset += (kConsolidatedStorageAlignBytes -
+               offset % kConsolidatedStorageAlignBytes) %
+        kConsolidatedStorageAlignBytes;
+    consolidated_tensor_data_.resize(offset, '\0');
+    consolidated_tensor_data_.append(data.data(), data.sizeInBytes());
+    pushInt(static_cast<int64_t>(offset));
+  }
 
   push<PickleOpCode>(PickleOpCode::TUPLE);
   push<PickleOpCode>(PickleOpCode::BINPERSID);
 
   // TODO: Skip this if not writing tensors
   memoized_storage_map_[addr] = pushNextBinPut();
-  tensor_data_.push_back(getWriteableTensorData(tensor));
+  if (!consolidate) {
+    tensor_data_.push_back(std::move(data));
+  }
 }
 
 void Pickler::pushBytes(const std::string& string) {
@@ -116,10 +116,12 @@ class Pickler {
   Pickler(
       std::function<void(const char*, size_t)> writer,
       std::vector<at::Tensor>* tensor_table,
-      std::vector<c10::ClassTypePtr>* memorized_class_types = nullptr)
+      std::vector<c10::ClassTypePtr>* memorized_class_types = nullptr,
+      bool consolidate_small_tensors = false)
       : writer_(writer),
         tensor_table_(tensor_table),
-        memorized_class_types_(memorized_class_types) {}
+        memorized_class_types_(memorized_class_types),
+        consolidate_small_tensors_(consolidate_small_tensors) {}
   ~Pickler();
 
   // Push protocol onto the stack
@@ -137,6 +139,14 @@ class Pickler {
     return tensor_data_;
   }
 
+  // The coalesced data of all small storages written so far, non-empty only
+  // when the pickler was constructed with consolidate_small_tensors. The
+  // caller is responsible for writing it as a single record named
+  // kConsolidatedStorageRecordName next to the per-tensor records.
+  const std::string& consolidatedTensorData() const {
+    return consolidated_tensor_data_;
+  }
+
   void pushEmptyDict();
   void pushDict(const IValue& ivalue);
   void pushInt(int64_t value);
@@ -244,11 +254,29 @@ class Pickler {
   std::vector<WriteableTensorData> tensor_data_;
   std::unordered_map<const void*, uint32_t> memoized_storage_map_;
 
+  // When set, small CPU storages are appended to consolidated_tensor_data_
+  // and referenced by (offset, length) from the pickle stream instead of
+  // getting one record each. Writing 200k tiny tensors as individual records
+  // pays a zip header and alignment padding per tensor; one shared record
+  // amortizes that overhead.
+  bool consolidate_small_tensors_;
+  std::string consolidated_tensor_data_;
+  // Storages up to this size (bytes) are coalesced.
+  static constexpr size_t kSmallStorageMaxBytes = 4096;
+  // Each coalesced storage starts at a multiple of this within the record,
+  // matching the alignment PyTorchStreamWriter gives individual records.
+  static constexpr size_t kConsolidatedStorageAlignBytes = 64;
+
   std::unordered_map<std::string, uint32_t> memoized_globals_map_;
   std::unordered_map<std::string, uint32_t> memoized_strings_map_;
   std::unordered_map<std::string, uint32_t> memoized_devices_map_;
 };
 
+// The record name used for the coalesced small-tensor data of an archive
+// (see Pickler::consolidatedTensorData). It cannot collide with the
+// per-tensor records, whose names are decimal indices.
+constexpr const char* kConsolidatedStorageRecordName = "consolidated";
+
 // returns a (tensor, record_size) for a tensor, converting it to a CPU tensor
 // if necessary
 WriteableTensorData getWriteableTensorData(const at::Tensor& tensor);
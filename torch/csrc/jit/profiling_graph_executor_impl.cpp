@@ -13,6 +13,7 @@
 #include <torch/csrc/jit/passes/inline_autodiff_subgraphs.h>
 #include <torch/csrc/jit/passes/inplace_check.h>
 #include <torch/csrc/jit/passes/insert_guards.h>
+#include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_grad_of.h>
 #include <torch/csrc/jit/passes/peephole.h>
 #include <torch/csrc/jit/passes/remove_expands.h>
@@ -76,6 +77,9 @@ void ProfilingGraphExecutorImpl::runProfilingOptimizations(
     return;
   }
 
+  // Needs to run before InsertGuards removes the profile nodes carrying the
+  // observed trip counts.
+  UnrollProfiledLoops(copy);
   InsertGuards(copy);
   LowerGradOf(*copy);
   EliminateRedundantGuards(copy);
@@ -181,6 +185,30 @@ ExecutionPlan ProfilingGraphExecutorImpl::getPlanFor(
   return *optimized_plan_;
 }
 
+IValue ProfilingGraphExecutorImpl::serializeProfiles() {
+  std::lock_guard<std::mutex> lock(compile_mutex);
+  if (!pr_ || !pr_->ready()) {
+    return IValue();
+  }
+  return pr_->serializeProfiles();
+}
+
+void ProfilingGraphExecutorImpl::warmStartWithProfiles(
+    const IValue& profiles) {
+  std::lock_guard<std::mutex> lock(compile_mutex);
+  if (pr_ || optimized_plan_) {
+    // this executor has already gathered its own profiles (or compiled);
+    // they take precedence over the imported ones
+    return;
+  }
+  auto copy = graph->copy();
+  runProfilingInsensitiveOptimizations(copy);
+  pr_ = ProfilingRecord::instrumentGraph(copy);
+  // marks the record ready, so the next getPlanFor call compiles an
+  // optimized plan immediately instead of running profiling iterations
+  pr_->deserializeProfiles(profiles);
+}
+
 GraphExecutorState ProfilingGraphExecutorImpl::getDebugState() {
   GraphExecutorState state;
   TORCH_INTERNAL_ASSERT(optimized_plan_);
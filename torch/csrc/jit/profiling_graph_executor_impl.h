@@ -10,6 +10,8 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   ExecutionPlan getPlanFor(Stack& stack, size_t remaining_bailout_depth)
       override;
   GraphExecutorState getDebugState() override;
+  IValue serializeProfiles() override;
+  void warmStartWithProfiles(const IValue& profiles) override;
   ~ProfilingGraphExecutorImpl() override = default;
 
  private:
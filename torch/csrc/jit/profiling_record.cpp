@@ -6,6 +6,11 @@
 namespace torch {
 namespace jit {
 
+Symbol profiledTripCountAttr() {
+  static Symbol attr = Symbol::attr("profiled_trip_count");
+  return attr;
+}
+
 ProfilingRecord::ProfilingRecord(std::shared_ptr<Graph> g)
     : profiled_graph_(std::move(g)), profiling_count_(getNumProfiledRuns()) {}
 
@@ -84,6 +89,41 @@ void ProfilingRecord::insertShapeProfile(Node *n, Value *i) {
   n->replaceInputWith(i, pn->output());
 }
 
+void ProfilingRecord::insertTripCountProfile(Node* loop) {
+  Value* trip_count = loop->inputs().at(0);
+  // Constant trip counts are already handled by the unroller; there is
+  // nothing to learn about them at runtime.
+  if (trip_count->node()->kind() == prim::Constant ||
+      trip_count->node()->kind() == prim::profile) {
+    return;
+  }
+
+  auto pn = createProfileNode(nullptr, {trip_count});
+  auto pno = pn->addOutput();
+  pno->setType(IntType::get());
+  std::function<void(Stack&)> trip_count_profiler = [this, pn](Stack& stack) {
+    IValue v;
+    pop(stack, v);
+    if (v.isInt()) {
+      auto count = v.toInt();
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      if (!pn->hasAttribute(profiledTripCountAttr())) {
+        pn->i_(profiledTripCountAttr(), count);
+      } else if (pn->i(profiledTripCountAttr()) != count) {
+        // Profiling runs disagree, so the trip count isn't runtime-stable.
+        pn->i_(profiledTripCountAttr(), -1);
+      }
+    }
+
+    // passing v through
+    push(stack, v);
+  };
+
+  pn->setCallback(trip_count_profiler);
+  pn->insertBefore(loop);
+  loop->replaceInputWith(trip_count, pn->output());
+}
+
 void ProfilingRecord::instrumentBlock(Block *block) {
   for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
     auto n = *it;
@@ -96,12 +136,156 @@ void ProfilingRecord::instrumentBlock(Block *block) {
       insertShapeProfile(n, i);
     }
 
+    if (n->kind() == prim::Loop) {
+      insertTripCountProfile(n);
+    }
+
     for (auto b : n->blocks()) {
       instrumentBlock(b);
     }
   }
 }
 
+namespace {
+
+// Profile entries are matched up between processes by the position of their
+// profile node in this walk, so it must visit nodes in the same order as
+// instrumentBlock inserts them: each node in program order, then its
+// sub-blocks.
+void gatherProfileNodes(Block* block, std::vector<Node*>& profile_nodes) {
+  for (auto n : block->nodes()) {
+    if (n->kind() == prim::profile) {
+      profile_nodes.push_back(n);
+    }
+    for (auto b : n->blocks()) {
+      gatherProfileNodes(b, profile_nodes);
+    }
+  }
+}
+
+IValue encodeVaryingShape(const c10::VaryingShape& shape) {
+  const auto& dims = shape.sizes();
+  if (!dims) {
+    return IValue();
+  }
+  std::vector<IValue> elements;
+  for (const auto& d : *dims) {
+    elements.emplace_back(d ? IValue(*d) : IValue());
+  }
+  return c10::ivalue::Tuple::create(std::move(elements));
+}
+
+c10::VaryingShape decodeVaryingShape(const IValue& encoded) {
+  if (encoded.isNone()) {
+    return c10::VaryingShape();
+  }
+  std::vector<c10::optional<int64_t>> dims;
+  for (const auto& e : encoded.toTuple()->elements()) {
+    dims.emplace_back(
+        e.isNone() ? c10::optional<int64_t>() : c10::optional<int64_t>(e.toInt()));
+  }
+  return c10::VaryingShape(std::move(dims));
+}
+
+IValue encodeTensorType(const TensorTypePtr& type) {
+  auto scalar_type = type->scalarType();
+  auto device = type->device();
+  auto requires_grad = type->requiresGrad();
+  auto undefined = type->undefined();
+  return c10::ivalue::Tuple::create(
+      {scalar_type ? IValue(static_cast<int64_t>(*scalar_type)) : IValue(),
+       device ? IValue(device->str()) : IValue(),
+       requires_grad ? IValue(*requires_grad) : IValue(),
+       undefined ? IValue(*undefined) : IValue(),
+       encodeVaryingShape(type->sizes()),
+       encodeVaryingShape(type->strides())});
+}
+
+TensorTypePtr decodeTensorType(const IValue& encoded) {
+  const auto& fields = encoded.toTuple()->elements();
+  TORCH_CHECK(
+      fields.size() == 6, "malformed tensor type in warm-start profiles");
+  return TensorType::create(
+      fields[0].isNone()
+          ? c10::optional<at::ScalarType>()
+          : c10::optional<at::ScalarType>(
+                static_cast<at::ScalarType>(fields[0].toInt())),
+      fields[1].isNone() ? c10::optional<c10::Device>()
+                         : c10::optional<c10::Device>(
+                               c10::Device(fields[1].toStringRef())),
+      decodeVaryingShape(fields[4]),
+      decodeVaryingShape(fields[5]),
+      fields[2].isNone() ? c10::optional<bool>()
+                         : c10::optional<bool>(fields[2].toBool()),
+      fields[3].isNone() ? c10::optional<bool>()
+                         : c10::optional<bool>(fields[3].toBool()));
+}
+
+} // namespace
+
+IValue ProfilingRecord::serializeProfiles() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Node*> profile_nodes;
+  gatherProfileNodes(profiled_graph_->block(), profile_nodes);
+
+  std::vector<IValue> entries;
+  for (size_t i = 0; i < profile_nodes.size(); ++i) {
+    Node* n = profile_nodes[i];
+    if (n->hasAttribute(profiledTripCountAttr())) {
+      entries.push_back(c10::ivalue::Tuple::create(
+          {static_cast<int64_t>(i),
+           std::string("trip_count"),
+           n->i(profiledTripCountAttr())}));
+      continue;
+    }
+    if (n->outputs().size() != 1) {
+      continue;
+    }
+    auto type = n->output()->type()->cast<TensorType>();
+    // the unspecialized singleton means this node never observed a tensor
+    if (!type || type == TensorType::get()) {
+      continue;
+    }
+    entries.push_back(c10::ivalue::Tuple::create(
+        {static_cast<int64_t>(i),
+         std::string("tensor"),
+         encodeTensorType(type)}));
+  }
+  return c10::ivalue::Tuple::create(std::move(entries));
+}
+
+void ProfilingRecord::deserializeProfiles(const IValue& profiles) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Node*> profile_nodes;
+  gatherProfileNodes(profiled_graph_->block(), profile_nodes);
+
+  for (const auto& entry : profiles.toTuple()->elements()) {
+    const auto& fields = entry.toTuple()->elements();
+    TORCH_CHECK(
+        fields.size() == 3, "malformed entry in warm-start profiles");
+    auto index = static_cast<size_t>(fields[0].toInt());
+    const auto& kind = fields[1].toStringRef();
+    TORCH_CHECK(
+        index < profile_nodes.size(),
+        "warm-start profiles do not match this graph");
+    Node* n = profile_nodes[index];
+    if (kind == "trip_count") {
+      n->i_(profiledTripCountAttr(), fields[2].toInt());
+    } else if (kind == "tensor") {
+      TORCH_CHECK(
+          n->outputs().size() == 1 &&
+              n->output()->type()->cast<TensorType>(),
+          "warm-start profiles do not match this graph");
+      n->output()->setType(decodeTensorType(fields[2]));
+    } else {
+      TORCH_CHECK(false, "unknown warm-start profile entry kind: ", kind);
+    }
+  }
+  // the record starts out fully profiled, so the executor optimizes on the
+  // first call instead of running profiling iterations
+  profiling_count_ = 0;
+}
+
 std::unique_ptr<ProfilingRecord> ProfilingRecord::instrumentGraph(
     const std::shared_ptr<Graph>& graph) {
   auto new_g = graph->copy();
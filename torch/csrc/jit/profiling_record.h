@@ -15,6 +15,11 @@ namespace jit {
 
 using ::c10::TensorTypePtr;
 
+// Attribute used to annotate the profile node on a loop's max trip count
+// with the count observed during profiling runs. Set to -1 when profiling
+// runs disagree. Consumed by UnrollProfiledLoops.
+TORCH_API Symbol profiledTripCountAttr();
+
 struct ProfilingRecord {
   // N.B. ProfilingRecord's copy and move c-tor are disabled, so we won't
   // end up accidentally copying or moving ProfilingRecords whose addresses
@@ -33,12 +38,25 @@ struct ProfilingRecord {
   std::shared_ptr<Graph> graph() const {
     return profiled_graph_;
   }
+
+  // Snapshot the data gathered by the profile nodes (observed tensor types
+  // and loop trip counts) as a pickleable IValue, keyed by each profile
+  // node's position in a deterministic graph walk. The snapshot can be
+  // applied to a freshly instrumented copy of the same graph in another
+  // process via deserializeProfiles(), which marks the record as ready so
+  // the executor compiles optimized plans without re-profiling. Both sides
+  // must instrument the same graph (i.e. the same model and build), since
+  // entries are matched up by traversal position.
+  TORCH_API IValue serializeProfiles();
+  TORCH_API void deserializeProfiles(const IValue& profiles);
+
  private:
   ProfileOp* createProfileNode(
       const std::function<void(Stack&)>& fp,
       at::ArrayRef<Value*> inputs);
   void instrumentBlock(Block* block);
   void insertShapeProfile(Node *n, Value *i);
+  void insertTripCountProfile(Node* loop);
   ProfilingRecord(std::shared_ptr<Graph> g);
 };
 
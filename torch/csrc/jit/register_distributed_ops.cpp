@@ -7,6 +7,7 @@
 #include <torch/csrc/distributed/autograd/engine/dist_engine.h>
 
 #include <torch/csrc/distributed/rpc/rref_impl.h>
+#include <torch/csrc/distributed/rpc/torchscript_functions.h>
 
 using at::Scalar;
 using at::Tensor;
@@ -59,6 +60,45 @@ RegisterOperators reg_rpc_ops({
           return 0;
         },
         aliasAnalysisFromSchema()),
+    // Sends one rpc per destination worker in a single pass; the sends
+    // pipeline instead of waiting on each other, and the returned futures can
+    // be awaited together with aten::collect_all. Restricted to Tensor
+    // arguments and a Tensor return (the parameter-server use case) because
+    // generic script rpc would need schema resolution that is only available
+    // from the Python front end in this code base.
+    Operator(
+        "aten::rpc_async_batch(str[] dst_workers, str qualified_name, Tensor[][] args) -> Future(Tensor)[]",
+        [](Stack& stack) {
+          auto argLists = pop(stack);
+          auto qualifiedName = pop(stack);
+          auto dstWorkers = pop(stack);
+
+          std::vector<std::string> dstWorkerNames;
+          for (const auto& worker : dstWorkers.toListRef()) {
+            dstWorkerNames.push_back(worker.toStringRef());
+          }
+          std::vector<std::vector<c10::IValue>> stacks;
+          for (const auto& argList : argLists.toListRef()) {
+            auto tensors = argList.toTensorVector();
+            stacks.emplace_back(tensors.begin(), tensors.end());
+          }
+
+          auto futures = dist_rpc::rpcTorchscriptBatch(
+              dstWorkerNames,
+              c10::QualifiedName(qualifiedName.toStringRef()),
+              stacks,
+              TensorType::get());
+
+          c10::impl::GenericList result(
+              FutureType::create(TensorType::get()));
+          result.reserve(futures.size());
+          for (auto& future : futures) {
+            result.push_back(std::move(future));
+          }
+          push(stack, std::move(result));
+          return 0;
+        },
+        aliasAnalysisFromSchema()),
 });
 
 auto reg_distributed_ops =
@@ -29,6 +29,7 @@
 #include <c10/util/math_compat.h>
 
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <cctype>
 #include <cmath>
@@ -1045,6 +1046,60 @@ RegisterOperators reg(
            return 0;
          },
          aliasAnalysisSpecialCase()),
+     // Aggregates a list of futures into one future that completes when the
+     // last of them does. Waiting on the aggregate wakes the waiter exactly
+     // once, instead of once per element as a loop of aten::wait calls would.
+     Operator(
+         "aten::collect_all(Future(t)[] futures) -> Future(t[])",
+         [](Stack& stack) {
+           auto futuresIValue = pop(stack);
+           auto futureType = futuresIValue.toList()
+                                 .elementType()
+                                 ->expect<FutureType>();
+           auto elementType = futureType->getElementType();
+
+           auto children = std::make_shared<
+               std::vector<c10::intrusive_ptr<c10::ivalue::Future>>>();
+           for (const auto& child : futuresIValue.toListRef()) {
+             children->push_back(child.toFuture());
+           }
+
+           auto aggregate = c10::make_intrusive<c10::ivalue::Future>(
+               ListType::create(elementType));
+           if (children->empty()) {
+             aggregate->markCompleted(c10::impl::GenericList(elementType));
+           } else {
+             // The callback of whichever child completes last gathers the
+             // values; the others just decrement the counter, so the
+             // aggregate is completed (and its waiters notified) only once.
+             // Errors are deferred to the gather step, which surfaces the
+             // first one through the aggregate.
+             auto remaining =
+                 std::make_shared<std::atomic<size_t>>(children->size());
+             for (const auto& child : *children) {
+               child->addCallback([children, remaining, aggregate, elementType]() {
+                 if (remaining->fetch_sub(1) != 1) {
+                   return;
+                 }
+                 c10::impl::GenericList values(elementType);
+                 values.reserve(children->size());
+                 try {
+                   for (const auto& completedChild : *children) {
+                     values.push_back(completedChild->value());
+                   }
+                 } catch (c10::ivalue::Future::FutureError& error) {
+                   aggregate->markCompleted(c10::ivalue::Future::FutureError(
+                       std::string(error.what())));
+                   return;
+                 }
+                 aggregate->markCompleted(std::move(values));
+               });
+             }
+           }
+           push(stack, std::move(aggregate));
+           return 0;
+         },
+         aliasAnalysisSpecialCase()),
      Operator(
          "prim::Uninitialized() -> Any",
          [](Stack& stack) {
@@ -31,6 +31,11 @@ struct TORCH_API Method {
       std::vector<c10::IValue> stack,
       const Kwargs& kwargs = Kwargs());
 
+  // Calls the method without per-call schema validation; `self` is
+  // inserted by this wrapper and must not be part of the stack. See
+  // Function::invokeTrusted for the contract the caller must uphold.
+  c10::IValue invokeTrusted(std::vector<c10::IValue> stack);
+
   std::shared_ptr<Graph> graph() const {
     return function_->graph();
   }
@@ -8,6 +8,14 @@
 #include <torch/csrc/jit/script/error_report.h>
 #include <torch/csrc/jit/script/ir_emitter.h>
 #include <torch/csrc/jit/script/schema_matching.h>
+#include <torch/csrc/jit/script/weight_pager.h>
+#include <torch/csrc/utils/module_state_transfer.h>
+
+#include <c10/core/MappedAllocator.h>
+#include <c10/util/numa.h>
+
+#include <cstring>
+#include <unordered_map>
 
 namespace torch {
 namespace jit {
@@ -74,6 +82,13 @@ void Module::to(at::Device device, bool non_blocking) {
   to_impl(device, /*dtype=*/c10::nullopt, non_blocking);
 }
 
+void Module::ensure_weights_resident() const {
+  auto& pager = WeightPager::get();
+  if (pager.enabled()) {
+    pager.ensureResident(*this);
+  }
+}
+
 void module_state_to(
     autograd::Variable variable,
     const c10::optional<at::Device>& device,
@@ -92,10 +107,23 @@ void Module::to_impl(
     const c10::optional<at::Device>& device,
     const c10::optional<at::ScalarType>& dtype,
     bool non_blocking) {
+  std::vector<at::Tensor> state;
   for (at::Tensor e : parameters()) {
-    module_state_to(e, device, dtype, non_blocking);
+    state.push_back(std::move(e));
   }
   for (at::Tensor e : buffers()) {
+    state.push_back(std::move(e));
+  }
+  // Device moves batch small tensors through staging buffers and synchronize
+  // once (see torch/csrc/utils/module_state_transfer.h); other conversions
+  // take the per-tensor path below.
+  if (torch::utils::parallel_module_state_to(
+          state, device, dtype, non_blocking, [&](size_t i, at::Tensor data) {
+            state[i].set_data(std::move(data));
+          })) {
+    return;
+  }
+  for (const at::Tensor& e : state) {
     module_state_to(e, device, dtype, non_blocking);
   }
 }
@@ -116,6 +144,11 @@ IValue Method::operator()(std::vector<IValue> stack, const Kwargs& kwargs) {
   return (*function_)(std::move(stack), kwargs);
 }
 
+IValue Method::invokeTrusted(std::vector<IValue> stack) {
+  stack.insert(stack.begin(), owner()._ivalue());
+  return function_->invokeTrusted(std::move(stack));
+}
+
 void Module::clone_method(
     const Module& orig,
     const Function& method,
@@ -239,6 +272,72 @@ Module Module::clone_instance() const {
   return r;
 }
 
+namespace {
+// Copies `src` into fresh hugepage-backed memory bound to `numa_node`.
+// `replicated` maps source TensorImpls to their copies so tensors that
+// appear in several slots (tied parameters) are replicated once per node.
+// Non-CPU and empty tensors are returned unchanged.
+at::Tensor replicate_tensor_to_node(
+    const at::Tensor& src,
+    int numa_node,
+    std::unordered_map<c10::TensorImpl*, at::Tensor>& replicated) {
+  if (!src.defined() || src.device().type() != at::kCPU || src.numel() == 0) {
+    return src;
+  }
+  auto it = replicated.find(src.unsafeGetTensorImpl());
+  if (it != replicated.end()) {
+    return it->second;
+  }
+  at::Tensor contig = src.contiguous();
+  const size_t nbytes = contig.numel() * contig.element_size();
+  c10::MappedAllocatorOptions opts;
+  opts.hugepages = true;
+  at::DataPtr data_ptr = c10::MappedAllocator::makeDataPtr(nbytes, opts);
+  // Bind the still-untouched pages to the node first; the copy then faults
+  // them in, so they are allocated there rather than migrated afterwards.
+  c10::NUMAMove(data_ptr.get(), nbytes, numa_node);
+  std::memcpy(data_ptr.get(), contig.data_ptr(), nbytes);
+  c10::Storage storage(
+      contig.dtype(),
+      contig.numel(),
+      std::move(data_ptr),
+      /*allocator=*/nullptr,
+      /*resizable=*/false);
+  at::Tensor replica =
+      at::empty({0}, contig.options())
+          .set_(storage, 0, contig.sizes(), contig.strides());
+  replicated.emplace(src.unsafeGetTensorImpl(), replica);
+  return replica;
+}
+} // namespace
+
+std::vector<Module> Module::replicate_weights_per_numa_node() const {
+  const int num_nodes = c10::IsNUMAEnabled() ? c10::GetNumNUMANodes() : 1;
+  if (num_nodes <= 1) {
+    return {*this};
+  }
+  std::vector<Module> replicas;
+  replicas.reserve(num_nodes);
+  for (int node = 0; node < num_nodes; ++node) {
+    Module replica = clone_instance();
+    std::unordered_map<c10::TensorImpl*, at::Tensor> replicated;
+    for (Module m : replica.modules()) {
+      const auto& module_type = m.type();
+      const size_t num_attributes = module_type->numAttributes();
+      for (size_t i = 0; i < num_attributes; ++i) {
+        IValue slot = m._ivalue()->getSlot(i);
+        if (!slot.isTensor()) {
+          continue;
+        }
+        m._ivalue()->setSlot(
+            i, replicate_tensor_to_node(slot.toTensor(), node, replicated));
+      }
+    }
+    replicas.push_back(std::move(replica));
+  }
+  return replicas;
+}
+
 void Module::train(bool on) {
   for (Module m : modules()) {
     if (auto slot = m._ivalue()->type()->findAttributeSlot("training")) {
@@ -20,6 +20,7 @@
 #include <c10/util/Optional.h>
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <ostream>
@@ -110,9 +111,18 @@ struct TORCH_API Module : public Object {
   }
 
   IValue forward(std::vector<IValue> inputs) {
+    // Modules registered with the WeightPager may have their parameters
+    // evicted to host memory; page them back in before dispatching so the
+    // first op of forward sees resident weights. No-op when the pager is
+    // unused.
+    ensure_weights_resident();
     return get_method("forward")(std::move(inputs));
   }
 
+  // See weight_pager.h; declared here so forward() can prefetch without the
+  // header depending on the pager.
+  void ensure_weights_resident() const;
+
   // In script modules, buffers are Tensors attribute that are _not_ registered
   // as parameters. This is different than in nn.Module where there is a special
   // register_buffer method. With this simplification, we only need to track
@@ -206,6 +216,17 @@ struct TORCH_API Module : public Object {
   /// effect.
   void to(at::Device device, bool non_blocking = false);
 
+  // For read-only inference on multi-socket machines: returns one replica of
+  // this module per NUMA node, sharing methods and type with this instance
+  // (see clone_instance) but with every CPU tensor attribute copied into
+  // hugepage-backed memory bound to that node. Serving threads pinned to a
+  // node (see ATEN_NATIVE_NUMA_BIND in ATen/ParallelNative.cpp) should run
+  // the replica at index c10::GetCurrentNUMANode(), so weight reads never
+  // cross the socket interconnect. Tied parameters stay tied within each
+  // replica. When NUMA is unavailable or there is a single node, the result
+  // holds just this module.
+  std::vector<Module> replicate_weights_per_numa_node() const;
+
   void save(
       std::ostream& out,
       const ExtraFilesMap& extra_files = ExtraFilesMap()) const;
@@ -214,6 +235,14 @@ struct TORCH_API Module : public Object {
       const std::string& filename,
       const ExtraFilesMap& extra_files = ExtraFilesMap()) const;
 
+  // Saves the module on a background thread. Tensors are snapshotted before
+  // this returns, so the module may keep training while the checkpoint is
+  // written; the future completes when the file is on disk and rethrows any
+  // serialization error.
+  std::future<void> save_async(
+      const std::string& filename,
+      const ExtraFilesMap& extra_files = ExtraFilesMap()) const;
+
   void _save_for_mobile(
       std::ostream& out,
       const ExtraFilesMap& extra_files = ExtraFilesMap()) const;
@@ -14,6 +14,12 @@ void Module::save(const std::string& filename, const ExtraFilesMap& extra_files)
   ExportModule(*this, filename, extra_files, false);
 }
 
+std::future<void> Module::save_async(
+    const std::string& filename,
+    const ExtraFilesMap& extra_files) const {
+  return ExportModuleAsync(*this, filename, extra_files, false);
+}
+
 void Module::_save_for_mobile(
     std::ostream& out,
     const ExtraFilesMap& extra_files) const {
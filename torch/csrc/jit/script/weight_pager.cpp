@@ -0,0 +1,161 @@
+#include <torch/csrc/jit/script/weight_pager.h>
+
+namespace torch {
+namespace jit {
+namespace script {
+
+WeightPager& WeightPager::get() {
+  static WeightPager pager;
+  return pager;
+}
+
+void WeightPager::setBudget(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = bytes;
+  if (budget_ > 0 && resident_bytes_ > budget_) {
+    reclaimLocked(0, nullptr);
+  }
+}
+
+size_t WeightPager::budget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return budget_;
+}
+
+size_t WeightPager::residentBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return resident_bytes_;
+}
+
+bool WeightPager::isRegistered(const Module& module) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.count(module._ivalue().get()) > 0;
+}
+
+void WeightPager::registerModule(const Module& module) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key = module._ivalue().get();
+  if (entries_.count(key)) {
+    return;
+  }
+  Entry entry;
+  for (Module m : module.modules()) {
+    const size_t num_attributes = m.type()->numAttributes();
+    for (size_t i = 0; i < num_attributes; ++i) {
+      IValue slot = m._ivalue()->getSlot(i);
+      if (!slot.isTensor()) {
+        continue;
+      }
+      at::Tensor t = slot.toTensor();
+      if (!t.defined() || t.device().is_cpu() || t.numel() == 0) {
+        continue;
+      }
+      ParamSlot param;
+      param.owner = m._ivalue();
+      param.slot = i;
+      param.device = t.device();
+      entry.params.push_back(std::move(param));
+      entry.nbytes += t.storage().capacity();
+    }
+  }
+  entry.last_use = ++tick_;
+  resident_bytes_ += entry.nbytes;
+  entries_.emplace(key, std::move(entry));
+  num_registered_.fetch_add(1, std::memory_order_relaxed);
+  if (budget_ > 0 && resident_bytes_ > budget_) {
+    reclaimLocked(0, &entries_.at(key));
+  }
+}
+
+void WeightPager::unregisterModule(const Module& module) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(module._ivalue().get());
+  if (it == entries_.end()) {
+    return;
+  }
+  if (!it->second.resident) {
+    pageInLocked(it->second);
+  }
+  resident_bytes_ -= it->second.nbytes;
+  entries_.erase(it);
+  num_registered_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void WeightPager::ensureResident(const Module& module) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(module._ivalue().get());
+  if (it == entries_.end()) {
+    return;
+  }
+  it->second.last_use = ++tick_;
+  if (it->second.resident) {
+    return;
+  }
+  if (budget_ > 0) {
+    reclaimLocked(it->second.nbytes, &it->second);
+  }
+  pageInLocked(it->second);
+}
+
+void WeightPager::evict(const Module& module) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(module._ivalue().get());
+  if (it != entries_.end() && it->second.resident) {
+    evictLocked(it->second);
+  }
+}
+
+// Evicts least recently used resident entries (other than `keep`) until
+// `needed` more bytes fit under the budget, or nothing evictable remains.
+void WeightPager::reclaimLocked(size_t needed, const Entry* keep) {
+  while (resident_bytes_ + needed > budget_) {
+    Entry* victim = nullptr;
+    for (auto& kv : entries_) {
+      if (!kv.second.resident || &kv.second == keep) {
+        continue;
+      }
+      if (victim == nullptr || kv.second.last_use < victim->last_use) {
+        victim = &kv.second;
+      }
+    }
+    if (victim == nullptr) {
+      break;
+    }
+    evictLocked(*victim);
+  }
+}
+
+void WeightPager::evictLocked(Entry& entry) {
+  for (ParamSlot& param : entry.params) {
+    at::Tensor t = param.owner->getSlot(param.slot).toTensor();
+    // Pinned staging memory makes the later page-in copy asynchronous. The
+    // eviction copy itself is synchronous so the device storage is safe to
+    // release as soon as the slot drops it.
+    param.host = at::empty(
+        t.sizes(), t.options().device(at::kCPU).pinned_memory(true));
+    param.host.copy_(t, /*non_blocking=*/false);
+    // Dropping the slot's reference releases the device storage back to the
+    // caching allocator (the pager holds no other reference to it).
+    param.owner->setSlot(param.slot, IValue(param.host));
+  }
+  entry.resident = false;
+  resident_bytes_ -= entry.nbytes;
+}
+
+void WeightPager::pageInLocked(Entry& entry) {
+  for (ParamSlot& param : entry.params) {
+    // Non-blocking host-to-device copy from pinned memory; issued on the
+    // calling thread's current stream, so a caller that sets up a transfer
+    // stream gets copy/compute overlap. The staging buffer stays alive in
+    // the entry until the next eviction, so the async read is safe.
+    at::Tensor t = param.host.to(param.device, /*non_blocking=*/true);
+    param.owner->setSlot(param.slot, IValue(std::move(t)));
+    param.host.reset();
+  }
+  entry.resident = true;
+  resident_bytes_ += entry.nbytes;
+}
+
+} // namespace script
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,92 @@
+#pragma once
+#include <torch/csrc/jit/script/module.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+namespace script {
+
+// Weight paging for serving more models than fit in accelerator memory.
+//
+// A process serving many script modules on one device either keeps them all
+// resident (and OOMs) or reloads whole models from disk on demand. The pager
+// makes oversubscription first-class instead: registered modules have their
+// device parameter storages tracked, and when bringing one module in would
+// exceed the configured budget, the least recently used modules are evicted
+// to pinned host memory. Paging a module back in copies from pinned memory
+// with non-blocking transfers, so the copies overlap with host-side work and
+// with kernels on other streams; a serving layer that wants a dedicated
+// transfer stream can make one current around ensureResident(), since the
+// copies are issued on the calling thread's current stream.
+//
+// Module::forward() consults the pager before dispatching, so a registered
+// module's first op always sees resident weights. Running an evicted
+// module's methods by other means without calling ensureResident() first
+// will fail with the usual device-mismatch errors.
+struct TORCH_API WeightPager {
+  static WeightPager& get();
+
+  // Device-byte budget across all registered modules; 0 (the default) means
+  // eviction happens only via evict().
+  void setBudget(size_t bytes);
+  size_t budget() const;
+  size_t residentBytes() const;
+
+  // Starts tracking the module's non-CPU tensor attributes. The module is
+  // resident when registered; registering a module whose weights do not fit
+  // the budget evicts older modules immediately.
+  void registerModule(const Module& module);
+  // Stops tracking; an evicted module is paged back in first so it is left
+  // usable.
+  void unregisterModule(const Module& module);
+  bool isRegistered(const Module& module) const;
+
+  // Pages the module's parameters back onto their recorded device, evicting
+  // least recently used registered modules as needed, and marks it most
+  // recently used. No-op for unregistered or already-resident modules.
+  void ensureResident(const Module& module);
+  // Copies the module's device parameters to pinned host memory and releases
+  // the device storages.
+  void evict(const Module& module);
+
+  // Cheap check used by Module::forward() to skip pager lookup entirely when
+  // nothing is registered.
+  bool enabled() const {
+    return num_registered_.load(std::memory_order_relaxed) > 0;
+  }
+
+ private:
+  WeightPager() = default;
+
+  struct ParamSlot {
+    ModulePtr owner; // submodule object holding the slot
+    size_t slot;
+    c10::Device device{c10::kCPU}; // where the tensor lives when resident
+    at::Tensor host; // pinned staging copy; defined only while evicted
+  };
+  struct Entry {
+    std::vector<ParamSlot> params;
+    size_t nbytes = 0;
+    bool resident = true;
+    uint64_t last_use = 0;
+  };
+
+  void evictLocked(Entry& entry);
+  void pageInLocked(Entry& entry);
+  void reclaimLocked(size_t needed, const Entry* keep);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<c10::ivalue::Object*, Entry> entries_;
+  std::atomic<size_t> num_registered_{0};
+  size_t budget_ = 0;
+  size_t resident_bytes_ = 0;
+  uint64_t tick_ = 0;
+};
+
+} // namespace script
+} // namespace jit
+} // namespace torch
@@ -156,21 +156,22 @@ IValue Unpickler::parse_ivalue() {
   return stack_[0];
 }
 
-double Unpickler::readFloat() {
+// Pickle floats are big endian, so reverse the bytes
+static double fromBigEndian(double big_endian) {
   AT_ASSERT(sizeof(double) == 8);
-  double big_endian = read<double>();
   double little_endian;
-
-  // Pickle floats are big endian, so reverse the bytes
   auto big_endian_ptr = reinterpret_cast<const char*>(&big_endian);
   std::reverse_copy(
       big_endian_ptr,
       big_endian_ptr + sizeof(big_endian),
       reinterpret_cast<char*>(&little_endian));
-
   return little_endian;
 }
 
+double Unpickler::readFloat() {
+  return fromBigEndian(read<double>());
+}
+
 void Unpickler::run() {
   // Expect a PROTO opcode and protocol number at the start of blob
   auto opcode = readOpCode();
@@ -269,20 +270,36 @@ PickleOpCode Unpickler::readInstruction() {
     case PickleOpCode::BININT1: {
       uint8_t value = read<uint8_t>();
       stack_.emplace_back(int64_t(value));
+      readOpCodeRun<uint8_t>(opcode, [](uint8_t v) { return int64_t(v); });
     } break;
     case PickleOpCode::BININT2: {
       uint16_t value = read<uint16_t>();
       stack_.emplace_back(int64_t(value));
+      readOpCodeRun<uint16_t>(opcode, [](uint16_t v) { return int64_t(v); });
     } break;
     case PickleOpCode::BININT: {
       int32_t value = read<int32_t>();
       stack_.emplace_back(int64_t(value));
+      readOpCodeRun<int32_t>(opcode, [](int32_t v) { return int64_t(v); });
     } break;
     case PickleOpCode::LONG1: {
       // Only read LONG1s with 8 as the length
       uint8_t length = read<uint8_t>();
       TORCH_CHECK(length == 8, "Expected length to be 8, got ", int(length));
       stack_.emplace_back(int64_t(read<int64_t>()));
+      // Batch any further 8-byte LONG1s waiting in the buffer. The payload
+      // here is a length byte (which must be 8) plus the value, so this
+      // cannot go through readOpCodeRun.
+      while (buffer_remaining_ >= 10 &&
+             static_cast<PickleOpCode>(static_cast<uint8_t>(
+                 buffer_[buffer_pos_])) == PickleOpCode::LONG1 &&
+             static_cast<uint8_t>(buffer_[buffer_pos_ + 1]) == 8) {
+        int64_t value;
+        memcpy(&value, buffer_.data() + buffer_pos_ + 2, sizeof(value));
+        buffer_pos_ += 10;
+        buffer_remaining_ -= 10;
+        stack_.emplace_back(value);
+      }
     } break;
     case PickleOpCode::BINUNICODE: {
       uint32_t length = read<uint32_t>();
@@ -290,6 +307,7 @@ PickleOpCode Unpickler::readInstruction() {
     } break;
     case PickleOpCode::BINFLOAT:
       stack_.emplace_back(readFloat());
+      readOpCodeRun<double>(opcode, fromBigEndian);
       break;
     case PickleOpCode::TUPLE: {
       size_t start = marks_.back();
@@ -390,7 +408,28 @@ PickleOpCode Unpickler::readInstruction() {
       if (device_) {
         device = *device_;
       }
-      at::DataPtr storage_ptr = read_record_(key);
+      at::DataPtr storage_ptr;
+      if (args.size() == 6) {
+        // (record, offset) reference into a consolidated record holding many
+        // small storages (see Pickler::pushStorageOfTensor). The record is
+        // read once and every storage becomes a view into it, kept alive by
+        // a shared handle in the DataPtr's context.
+        int64_t offset = args.at(5).toInt();
+        auto& record = consolidated_records_[key];
+        if (record == nullptr) {
+          record = std::make_shared<at::DataPtr>(read_record_(key));
+        }
+        auto* ctx = new std::shared_ptr<at::DataPtr>(record);
+        storage_ptr = at::DataPtr(
+            static_cast<char*>(record->get()) + offset,
+            ctx,
+            [](void* ctx) {
+              delete static_cast<std::shared_ptr<at::DataPtr>*>(ctx);
+            },
+            at::DeviceType::CPU);
+      } else {
+        storage_ptr = read_record_(key);
+      }
       int64_t numel = args.at(4).toInt();
       at::Storage storage(
           at::CPU(type).typeMeta(),
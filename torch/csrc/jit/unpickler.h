@@ -75,6 +75,25 @@ class Unpickler {
   void readSlowWithBuffer(char *dest, size_t sz);
   std::string readBytes(size_t num_bytes);
 
+  // Decode a run of repeats of the same fixed-payload opcode straight out
+  // of the lookahead buffer, pushing one converted value per repeat onto
+  // the stack. Stops at the buffer edge or at the first different opcode;
+  // the main instruction switch handles whatever follows. Long homogeneous
+  // runs (e.g. a large list of ints) mostly skip the per-element trip
+  // through readInstruction this way.
+  template <typename T, typename F>
+  void readOpCodeRun(PickleOpCode op, const F& convert) {
+    while (buffer_remaining_ >= sizeof(T) + 1 &&
+           static_cast<PickleOpCode>(
+               static_cast<uint8_t>(buffer_[buffer_pos_])) == op) {
+      T value;
+      memcpy(&value, buffer_.data() + buffer_pos_ + 1, sizeof(T));
+      buffer_pos_ += sizeof(T) + 1;
+      buffer_remaining_ -= sizeof(T) + 1;
+      stack_.emplace_back(convert(value));
+    }
+  }
+
   double readFloat();
   void readGlobal(
       const std::string& module_name,
@@ -95,8 +114,10 @@ class Unpickler {
   // Returns the number of bytes read. This should statefully
   // remember the position. Don't call reader_ directly.
   std::function<size_t(char*, size_t)> reader_;
-  // Small buffer to avoid calling reader_ on a per-byte basis.
-  std::array<char, 256> buffer_;
+  // Lookahead buffer: avoids calling reader_ on a per-byte basis and lets
+  // readOpCodeRun batch-decode homogeneous opcode runs. reader_ must (and
+  // does) tolerate being asked for more bytes than the stream has left.
+  std::array<char, 1024> buffer_;
   size_t buffer_pos_{0};
   size_t buffer_remaining_{0};
 
@@ -115,6 +136,10 @@ class Unpickler {
   IValue empty_tuple_;
 
   std::function<at::DataPtr(const std::string&)> read_record_;
+  // Records holding many coalesced small storages, read once and shared by
+  // all storages that reference into them (see Pickler's consolidated mode).
+  std::unordered_map<std::string, std::shared_ptr<at::DataPtr>>
+      consolidated_records_;
   c10::optional<at::Device> device_;
 };
 
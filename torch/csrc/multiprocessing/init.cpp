@@ -1,4 +1,5 @@
 #include <torch/csrc/python_headers.h>
+#include <torch/csrc/multiprocessing/tensor_queue.h>
 #include <torch/csrc/utils/object_ptr.h>
 #include <torch/csrc/utils/pybind.h>
 
@@ -34,6 +35,53 @@ PyObject* multiprocessing_init(PyObject* _unused, PyObject *noargs) {
 #endif
   });
 
+  py::class_<TensorQueue, std::shared_ptr<TensorQueue>>(
+      module,
+      "TensorQueue",
+      R"(A fixed-capacity queue of CPU tensors in POSIX shared memory.
+
+Unlike :class:`multiprocessing.Queue`, tensors are copied directly into a
+shared arena instead of being pickled through a pipe, so processes on the
+same host exchange them at memory bandwidth. Tensors must fit in a slot
+(``slot_bytes``) and have at most 8 dimensions; ``get`` returns a copy that
+does not alias the sender's tensor. Queue objects pickle as their name and
+re-attach on the receiving side, so they can be passed to child processes.)")
+      .def_static(
+          "create",
+          &TensorQueue::create,
+          py::arg("name"),
+          py::arg("slots"),
+          py::arg("slot_bytes"))
+      .def_static("attach", &TensorQueue::attach, py::arg("name"))
+      .def(
+          "put",
+          &TensorQueue::put,
+          py::arg("tensor"),
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "try_put",
+          &TensorQueue::try_put,
+          py::arg("tensor"),
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "get",
+          &TensorQueue::get,
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "try_get",
+          &TensorQueue::try_get,
+          py::call_guard<py::gil_scoped_release>())
+      .def_property_readonly("name", &TensorQueue::name)
+      .def_property_readonly("slots", &TensorQueue::slots)
+      .def_property_readonly("slot_bytes", &TensorQueue::slot_bytes)
+      .def(py::pickle(
+          [](const TensorQueue& queue) {
+            return py::make_tuple(queue.name());
+          },
+          [](py::tuple state) {
+            return TensorQueue::attach(state[0].cast<std::string>());
+          }));
+
   Py_RETURN_TRUE;
 }
 
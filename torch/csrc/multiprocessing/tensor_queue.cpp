@@ -0,0 +1,370 @@
+#include <torch/csrc/multiprocessing/tensor_queue.h>
+
+#include <TH/THAllocator.h>
+#include <c10/util/Exception.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace torch {
+namespace multiprocessing {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x544f52434854515eULL; // "TORCHTQ^"
+constexpr size_t kCacheLine = 64;
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Descriptor at the front of every cell; the payload region follows it
+// within the same cell, so one cell is one contiguous producer-owned span.
+struct alignas(kCacheLine) Cell {
+  std::atomic<uint64_t> sequence;
+  int32_t dtype;
+  int32_t ndim;
+  int64_t nbytes;
+  int64_t sizes[TensorQueue::kMaxDims];
+};
+
+char* cellPayload(Cell* cell) {
+  return reinterpret_cast<char*>(cell) + sizeof(Cell);
+}
+
+#ifndef _WIN32
+sem_t* openSemaphore(const std::string& name, bool create, unsigned value) {
+  sem_t* sem = create
+      ? sem_open(name.c_str(), O_CREAT | O_EXCL, (mode_t)0600, value)
+      : sem_open(name.c_str(), 0);
+  if (sem == SEM_FAILED) {
+    AT_ERROR(
+        "unable to open semaphore <", name, ">: ", std::strerror(errno));
+  }
+  return sem;
+}
+
+void semWait(void* sem) {
+  int rv;
+  do {
+    rv = sem_wait(static_cast<sem_t*>(sem));
+  } while (rv == -1 && errno == EINTR);
+  if (rv == -1) {
+    AT_ERROR("sem_wait failed: ", std::strerror(errno));
+  }
+}
+
+bool semTryWait(void* sem) {
+  int rv;
+  do {
+    rv = sem_trywait(static_cast<sem_t*>(sem));
+  } while (rv == -1 && errno == EINTR);
+  if (rv == -1) {
+    if (errno == EAGAIN) {
+      return false;
+    }
+    AT_ERROR("sem_trywait failed: ", std::strerror(errno));
+  }
+  return true;
+}
+
+void semPost(void* sem) {
+  if (sem_post(static_cast<sem_t*>(sem)) == -1) {
+    AT_ERROR("sem_post failed: ", std::strerror(errno));
+  }
+}
+#endif
+
+} // namespace
+
+struct alignas(kCacheLine) TensorQueue::Header {
+  std::atomic<uint64_t> magic; // set (release) after everything else
+  int64_t slots;
+  int64_t slot_bytes;
+  // On separate cache lines: producers only contend on enqueue_pos and
+  // consumers only on dequeue_pos.
+  alignas(kCacheLine) std::atomic<uint64_t> enqueue_pos;
+  alignas(kCacheLine) std::atomic<uint64_t> dequeue_pos;
+};
+
+std::shared_ptr<TensorQueue> TensorQueue::create(
+    const std::string& name,
+    int64_t slots,
+    int64_t slot_bytes) {
+  return std::shared_ptr<TensorQueue>(
+      new TensorQueue(name, slots, slot_bytes, /*create=*/true));
+}
+
+std::shared_ptr<TensorQueue> TensorQueue::attach(const std::string& name) {
+  return std::shared_ptr<TensorQueue>(
+      new TensorQueue(name, /*slots=*/0, /*slot_bytes=*/0, /*create=*/false));
+}
+
+TensorQueue::TensorQueue(
+    const std::string& name,
+    int64_t slots,
+    int64_t slot_bytes,
+    bool create)
+    : name_(name), creator_(create) {
+#ifdef _WIN32
+  AT_ERROR("TensorQueue is not supported on Windows");
+#else
+  TORCH_CHECK(
+      !name.empty() && name.find('/') == std::string::npos,
+      "queue name must be non-empty and must not contain '/', got '",
+      name,
+      "'");
+  const std::string shm_name = "/" + name;
+
+  int fd = shm_open(
+      shm_name.c_str(),
+      create ? (O_RDWR | O_CREAT | O_EXCL) : O_RDWR,
+      (mode_t)0600);
+  if (fd == -1) {
+    AT_ERROR(
+        "unable to open shared memory object <",
+        shm_name,
+        ">: ",
+        std::strerror(errno));
+  }
+
+  size_t total = 0;
+  if (create) {
+    TORCH_CHECK(slots > 0, "slots must be positive, got ", slots);
+    TORCH_CHECK(
+        slot_bytes > 0, "slot_bytes must be positive, got ", slot_bytes);
+    cell_stride_ = alignUp(sizeof(Cell) + slot_bytes, kCacheLine);
+    total = sizeof(Header) + slots * cell_stride_;
+    if (ftruncate(fd, total) == -1) {
+      ::close(fd);
+      shm_unlink(shm_name.c_str());
+      AT_ERROR(
+          "unable to resize shared memory object <",
+          shm_name,
+          "> to ",
+          total,
+          " bytes: ",
+          std::strerror(errno));
+    }
+  } else {
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1) {
+      ::close(fd);
+      AT_ERROR(
+          "unable to stat shared memory object <",
+          shm_name,
+          ">: ",
+          std::strerror(errno));
+    }
+    total = file_stat.st_size;
+    TORCH_CHECK(
+        total >= sizeof(Header),
+        "shared memory object <",
+        shm_name,
+        "> is too small to be a TensorQueue");
+  }
+
+  // FROMFD hands the descriptor to the allocator (which closes it after
+  // mapping) and keeps close() from unlinking the name, so attached
+  // processes can close in any order; the creator unlinks explicitly.
+  size_t actual_size = 0;
+  map_ = THMapAllocator::makeDataPtr(
+      WITH_FD,
+      shm_name.c_str(),
+      fd,
+      TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_FROMFD,
+      total,
+      &actual_size);
+  header_ = static_cast<Header*>(map_.get());
+
+  if (create) {
+    header_->slots = slots;
+    header_->slot_bytes = slot_bytes;
+    header_->enqueue_pos.store(0, std::memory_order_relaxed);
+    header_->dequeue_pos.store(0, std::memory_order_relaxed);
+    cells_ = reinterpret_cast<char*>(header_ + 1);
+    for (int64_t i = 0; i < slots; ++i) {
+      reinterpret_cast<Cell*>(cells_ + i * cell_stride_)
+          ->sequence.store(i, std::memory_order_relaxed);
+    }
+    header_->magic.store(kMagic, std::memory_order_release);
+  } else {
+    TORCH_CHECK(
+        header_->magic.load(std::memory_order_acquire) == kMagic,
+        "shared memory object <",
+        shm_name,
+        "> is not a TensorQueue arena");
+    cell_stride_ = alignUp(sizeof(Cell) + header_->slot_bytes, kCacheLine);
+    TORCH_CHECK(
+        total == sizeof(Header) + header_->slots * cell_stride_,
+        "TensorQueue arena <",
+        shm_name,
+        "> has an inconsistent size");
+    cells_ = reinterpret_cast<char*>(header_ + 1);
+  }
+
+  items_sem_ = openSemaphore(shm_name + "-items", create, 0);
+  spaces_sem_ =
+      openSemaphore(shm_name + "-spaces", create, header_->slots);
+#endif
+}
+
+TensorQueue::~TensorQueue() {
+#ifndef _WIN32
+  if (items_sem_) {
+    sem_close(static_cast<sem_t*>(items_sem_));
+  }
+  if (spaces_sem_) {
+    sem_close(static_cast<sem_t*>(spaces_sem_));
+  }
+  if (creator_) {
+    // Best effort: a forked child that inherited the creator object may
+    // have unlinked the names already.
+    const std::string shm_name = "/" + name_;
+    sem_unlink((shm_name + "-items").c_str());
+    sem_unlink((shm_name + "-spaces").c_str());
+    shm_unlink(shm_name.c_str());
+  }
+#endif
+}
+
+int64_t TensorQueue::slots() const {
+  return header_->slots;
+}
+
+int64_t TensorQueue::slot_bytes() const {
+  return header_->slot_bytes;
+}
+
+// Validates and flattens before any slot is claimed, so a rejected tensor
+// never consumes a space credit.
+at::Tensor TensorQueue::prepare(const at::Tensor& tensor) const {
+  TORCH_CHECK(
+      tensor.device().is_cpu(), "TensorQueue only holds CPU tensors");
+  TORCH_CHECK(
+      tensor.layout() == at::kStrided,
+      "TensorQueue only holds strided tensors");
+  TORCH_CHECK(
+      tensor.dim() <= kMaxDims,
+      "TensorQueue holds tensors of at most ",
+      kMaxDims,
+      " dimensions, got ",
+      tensor.dim());
+  at::Tensor prepared = tensor.contiguous();
+  const int64_t nbytes = prepared.numel() * prepared.element_size();
+  TORCH_CHECK(
+      nbytes <= header_->slot_bytes,
+      "tensor of ",
+      nbytes,
+      " bytes does not fit in a slot of ",
+      header_->slot_bytes,
+      " bytes");
+  return prepared;
+}
+
+void TensorQueue::writeSlot(const at::Tensor& prepared) {
+  uint64_t pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+  Cell* cell;
+  for (;;) {
+    cell = reinterpret_cast<Cell*>(
+        cells_ + (pos % header_->slots) * cell_stride_);
+    if (cell->sequence.load(std::memory_order_acquire) == pos &&
+        header_->enqueue_pos.compare_exchange_weak(
+            pos, pos + 1, std::memory_order_relaxed)) {
+      break;
+    }
+    pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+  }
+  cell->dtype = static_cast<int32_t>(prepared.scalar_type());
+  cell->ndim = static_cast<int32_t>(prepared.dim());
+  cell->nbytes = prepared.numel() * prepared.element_size();
+  for (int64_t d = 0; d < prepared.dim(); ++d) {
+    cell->sizes[d] = prepared.size(d);
+  }
+  std::memcpy(cellPayload(cell), prepared.data_ptr(), cell->nbytes);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+}
+
+at::Tensor TensorQueue::readSlot() {
+  uint64_t pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+  Cell* cell;
+  for (;;) {
+    cell = reinterpret_cast<Cell*>(
+        cells_ + (pos % header_->slots) * cell_stride_);
+    if (cell->sequence.load(std::memory_order_acquire) == pos + 1 &&
+        header_->dequeue_pos.compare_exchange_weak(
+            pos, pos + 1, std::memory_order_relaxed)) {
+      break;
+    }
+    pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+  }
+  const auto dtype = static_cast<at::ScalarType>(cell->dtype);
+  std::vector<int64_t> sizes(cell->sizes, cell->sizes + cell->ndim);
+  at::Tensor out = at::empty(sizes, at::TensorOptions().dtype(dtype));
+  AT_ASSERT(out.numel() * out.element_size() == cell->nbytes);
+  std::memcpy(out.data_ptr(), cellPayload(cell), cell->nbytes);
+  cell->sequence.store(pos + header_->slots, std::memory_order_release);
+  return out;
+}
+
+void TensorQueue::put(const at::Tensor& tensor) {
+#ifdef _WIN32
+  AT_ERROR("TensorQueue is not supported on Windows");
+#else
+  at::Tensor prepared = prepare(tensor);
+  semWait(spaces_sem_);
+  writeSlot(prepared);
+  semPost(items_sem_);
+#endif
+}
+
+bool TensorQueue::try_put(const at::Tensor& tensor) {
+#ifdef _WIN32
+  AT_ERROR("TensorQueue is not supported on Windows");
+#else
+  at::Tensor prepared = prepare(tensor);
+  if (!semTryWait(spaces_sem_)) {
+    return false;
+  }
+  writeSlot(prepared);
+  semPost(items_sem_);
+  return true;
+#endif
+}
+
+at::Tensor TensorQueue::get() {
+#ifdef _WIN32
+  AT_ERROR("TensorQueue is not supported on Windows");
+#else
+  semWait(items_sem_);
+  at::Tensor out = readSlot();
+  semPost(spaces_sem_);
+  return out;
+#endif
+}
+
+c10::optional<at::Tensor> TensorQueue::try_get() {
+#ifdef _WIN32
+  AT_ERROR("TensorQueue is not supported on Windows");
+#else
+  if (!semTryWait(items_sem_)) {
+    return c10::nullopt;
+  }
+  at::Tensor out = readSlot();
+  semPost(spaces_sem_);
+  return out;
+#endif
+}
+
+} // namespace multiprocessing
+} // namespace torch
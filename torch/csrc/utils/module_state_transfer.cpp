@@ -0,0 +1,128 @@
+#include <torch/csrc/utils/module_state_transfer.h>
+
+#include <torch/csrc/utils/tensor_flatten.h>
+#include <ATen/core/grad_mode.h>
+
+#include <unordered_map>
+
+namespace torch {
+namespace utils {
+
+namespace {
+
+// Tensors up to this size are coalesced into a staging buffer; launching an
+// individual copy per small parameter is dominated by per-copy overhead.
+constexpr int64_t kSmallTensorBytes = 1024 * 1024;
+// Upper bound on a single staging buffer, so flattening a model with many
+// small parameters does not transiently allocate unbounded pinned memory.
+constexpr int64_t kStagingChunkBytes = 64 * 1024 * 1024;
+
+} // namespace
+
+bool parallel_module_state_to(
+    const std::vector<at::Tensor>& state,
+    const c10::optional<at::Device>& device,
+    const c10::optional<at::ScalarType>& dtype,
+    bool non_blocking,
+    const std::function<void(size_t, at::Tensor)>& set_data) {
+  if (!device || !device->is_cuda()) {
+    return false;
+  }
+
+  // Like python's Module._apply, compute the replacement data without
+  // recording autograd history; set_data installs it on the original
+  // variables.
+  at::AutoGradMode grad_guard(false);
+
+  // Small dense CPU tensors are grouped by scalar type (flattening requires
+  // a homogeneous dtype); everything else transfers individually.
+  std::unordered_map<at::ScalarType, std::vector<size_t>> batches;
+  std::vector<size_t> individual;
+  for (size_t i = 0; i < state.size(); ++i) {
+    const auto& tensor = state[i];
+    if (!tensor.defined()) {
+      continue;
+    }
+    const auto target_dtype = dtype.value_or(tensor.scalar_type());
+    if (tensor.device() == *device && tensor.scalar_type() == target_dtype) {
+      continue;
+    }
+    if (tensor.device().is_cpu() && tensor.layout() == at::kStrided &&
+        tensor.numel() * tensor.element_size() <= kSmallTensorBytes) {
+      batches[tensor.scalar_type()].push_back(i);
+    } else {
+      individual.push_back(i);
+    }
+  }
+
+  // Any tensor produced by the copies below; reading it back at the end is
+  // stream-ordered after everything issued before it.
+  at::Tensor sync_probe;
+
+  // Kick off the big copies first so their DMA overlaps the host-side
+  // flattening below.
+  for (auto i : individual) {
+    auto moved = state[i].to(
+        *device,
+        dtype.value_or(state[i].scalar_type()),
+        /*non_blocking=*/true);
+    if (moved.numel() > 0) {
+      sync_probe = moved;
+    }
+    set_data(i, std::move(moved));
+  }
+
+  // The staging buffers must stay alive until the transfers out of them have
+  // completed, i.e. until the synchronization at the end of this function.
+  std::vector<at::Tensor> pinned_chunks;
+  for (auto& batch : batches) {
+    const auto& indices = batch.second;
+    size_t begin = 0;
+    while (begin < indices.size()) {
+      std::vector<at::Tensor> chunk;
+      int64_t chunk_bytes = 0;
+      size_t end = begin;
+      for (; end < indices.size(); ++end) {
+        const auto& tensor = state[indices[end]];
+        const int64_t bytes = tensor.numel() * tensor.element_size();
+        if (!chunk.empty() && chunk_bytes + bytes > kStagingChunkBytes) {
+          break;
+        }
+        chunk.push_back(tensor);
+        chunk_bytes += bytes;
+      }
+
+      auto pinned = flatten_dense_tensors(chunk).pin_memory();
+      pinned_chunks.push_back(pinned);
+      auto on_device = pinned.to(*device, /*non_blocking=*/true);
+      if (dtype && *dtype != batch.first) {
+        // Convert on the device, where it is asynchronous and fast, rather
+        // than on the host before the copy.
+        on_device = on_device.to(*dtype);
+      }
+      auto outputs = unflatten_dense_tensors(on_device, chunk);
+      for (size_t j = 0; j < outputs.size(); ++j) {
+        // Clone so every parameter keeps its own storage instead of a view
+        // into the staging allocation.
+        auto out = outputs[j].clone();
+        if (out.numel() > 0) {
+          sync_probe = out;
+        }
+        set_data(indices[begin + j], std::move(out));
+      }
+      begin = end;
+    }
+  }
+
+  // One synchronization for the whole transfer: a blocking host read is
+  // stream-ordered after every copy issued above. Even when non_blocking was
+  // requested this cannot be skipped if staging buffers are in use, since
+  // they are released when this function returns.
+  if (sync_probe.defined() && !(non_blocking && pinned_chunks.empty())) {
+    sync_probe.reshape({-1}).narrow(0, 0, 1).cpu();
+  }
+  return true;
+}
+
+} // namespace utils
+} // namespace torch
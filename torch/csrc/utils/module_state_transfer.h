@@ -0,0 +1,32 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <ATen/ATen.h>
+#include <c10/util/Optional.h>
+
+#include <functional>
+#include <vector>
+
+namespace torch {
+namespace utils {
+
+// Moves module state (parameters and buffers) to a new device/dtype the way
+// Module::to does, but batched: small dense CPU tensors are coalesced into
+// pinned staging buffers and transferred with one asynchronous copy per
+// buffer, large tensors are transferred individually with non-blocking
+// copies, and the target device is synchronized once at the end instead of
+// once per tensor. `set_data(i, t)` is invoked with the moved replacement for
+// `state[i]`; tensors that already match the target are skipped.
+//
+// Returns false when the fast path does not apply (no target device, or a
+// non-CUDA target, e.g. dtype-only conversions); callers then fall back to
+// the usual per-tensor loop.
+TORCH_API bool parallel_module_state_to(
+    const std::vector<at::Tensor>& state,
+    const c10::optional<at::Device>& device,
+    const c10::optional<at::ScalarType>& dtype,
+    bool non_blocking,
+    const std::function<void(size_t, at::Tensor)>& set_data);
+
+} // namespace utils
+} // namespace torch
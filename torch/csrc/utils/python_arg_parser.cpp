@@ -713,6 +713,7 @@ PythonArgParser::PythonArgParser(std::vector<std::string> fmts, bool traceable)
   if (signatures_.size() > 0) {
     function_name = signatures_[0].name;
   }
+  cached_arg_types_.resize(max_args, nullptr);
 
   // Check deprecated signatures last
   std::stable_partition(signatures_.begin(), signatures_.end(),
@@ -747,11 +748,56 @@ PythonArgs PythonArgParser::raw_parse(PyObject* args, PyObject* kwargs, PyObject
     return PythonArgs(traceable, signature, parsed_args);
   }
 
+  // The memoized overload may only be tried first when the outcome of the
+  // matching loop is determined by the argument types alone. Keyword calls,
+  // container arguments (the contents of a list/tuple can steer a call to a
+  // different overload without changing the outer types) and 0-dim tensors
+  // (which match Number parameters depending on dtype and requires_grad)
+  // fall through to the full loop.
+  auto nargs = PyTuple_GET_SIZE(args);
+  bool cacheable = !kwargs && nargs <= (ssize_t)cached_arg_types_.size();
+  if (cacheable) {
+    for (ssize_t i = 0; i < nargs; i++) {
+      PyObject* obj = PyTuple_GET_ITEM(args, i);
+      if (PyTuple_Check(obj) || PyList_Check(obj) || PyDict_Check(obj) ||
+          (THPVariable_Check(obj) && ((THPVariable*)obj)->cdata.dim() == 0)) {
+        cacheable = false;
+        break;
+      }
+    }
+  }
+
+  if (cacheable && cached_signature_ >= 0 && nargs == cached_nargs_) {
+    bool types_match = true;
+    for (ssize_t i = 0; i < nargs; i++) {
+      if (Py_TYPE(PyTuple_GET_ITEM(args, i)) != cached_arg_types_[i]) {
+        types_match = false;
+        break;
+      }
+    }
+    if (types_match) {
+      auto& signature = signatures_[cached_signature_];
+      if (signature.parse(args, kwargs, parsed_args, false)) {
+        check_deprecated(signature);
+        return PythonArgs(traceable, signature, parsed_args);
+      }
+    }
+  }
+
+  int i = 0;
   for (auto& signature : signatures_) {
     if (signature.parse(args, kwargs, parsed_args, false)) {
       check_deprecated(signature);
+      if (cacheable) {
+        cached_signature_ = i;
+        cached_nargs_ = nargs;
+        for (ssize_t arg = 0; arg < nargs; arg++) {
+          cached_arg_types_[arg] = Py_TYPE(PyTuple_GET_ITEM(args, arg));
+        }
+      }
       return PythonArgs(traceable, signature, parsed_args);
     }
+    i++;
   }
 
   print_error(args, kwargs, parsed_args);
@@ -111,6 +111,15 @@ private:
   std::string function_name;
   ssize_t max_args;
   bool traceable;
+  // Overload memoization: each parser is a per-callsite static, and repeat
+  // calls at a callsite overwhelmingly pass the same argument types, so
+  // raw_parse remembers the signature that matched last time together with a
+  // fingerprint of the positional argument types and tries it first. The
+  // cache is invalidated simply by the fingerprint no longer matching.
+  // Parsing runs under the GIL, so no synchronization is needed.
+  int cached_signature_ = -1;
+  ssize_t cached_nargs_ = -1;
+  std::vector<PyTypeObject*> cached_arg_types_;
 };
 
 struct PYBIND11_EXPORT FunctionSignature {
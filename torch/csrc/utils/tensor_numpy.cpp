@@ -7,6 +7,9 @@ namespace torch { namespace utils {
 PyObject* tensor_to_numpy(const at::Tensor& tensor) {
   throw std::runtime_error("PyTorch was compiled without NumPy support");
 }
+PyObject* tensor_to_numpy_consume(at::Tensor&& tensor) {
+  throw std::runtime_error("PyTorch was compiled without NumPy support");
+}
 at::Tensor tensor_from_numpy(PyObject* obj) {
   throw std::runtime_error("PyTorch was compiled without NumPy support");
 }
@@ -125,6 +128,68 @@ PyObject* tensor_to_numpy(const at::Tensor& tensor) {
   return array.release();
 }
 
+static const char* kDonatedBufferCapsuleName = "torch.donated_buffer";
+
+static void donated_buffer_capsule_destructor(PyObject* capsule) {
+  auto* data_ptr = static_cast<at::DataPtr*>(
+      PyCapsule_GetPointer(capsule, kDonatedBufferCapsuleName));
+  delete data_ptr;
+}
+
+PyObject* tensor_to_numpy_consume(at::Tensor&& tensor) {
+  if (tensor.device().type() != DeviceType::CPU) {
+    throw TypeError(
+      "can't convert non-cpu tensor to numpy. Use Tensor.cpu() to "
+      "copy the tensor to host memory first.");
+  }
+  if (tensor.layout() != Layout::Strided) {
+      throw TypeError(
+        "can't convert non-strided tensor to numpy."
+        "convert the tensor to a strided layout first.");
+  }
+  auto dtype = aten_to_numpy_dtype(tensor.scalar_type());
+  auto sizes = to_numpy_shape(tensor.sizes());
+  auto strides = to_numpy_shape(tensor.strides());
+  // NumPy strides use bytes. Torch strides use element counts.
+  auto element_size_in_bytes = tensor.element_size();
+  for (auto& stride : strides) {
+    stride *= element_size_in_bytes;
+  }
+
+  // This checks the release_storage preconditions (contiguity, zero storage
+  // offset, unique ownership, no grad) and leaves `tensor` undefined, so the
+  // buffer is owned exclusively by the DataPtr from here on.
+  auto data_ptr =
+      std::unique_ptr<at::DataPtr>(new at::DataPtr(tensor.release_storage()));
+
+  auto array = THPObjectPtr(PyArray_New(
+      &PyArray_Type,
+      static_cast<int>(sizes.size()),
+      sizes.data(),
+      dtype,
+      strides.data(),
+      data_ptr->get(),
+      0,
+      NPY_ARRAY_ALIGNED | NPY_ARRAY_WRITEABLE,
+      nullptr));
+  if (!array) return nullptr;
+
+  // The ndarray owns the buffer through a capsule holding the DataPtr; the
+  // storage's original deleter runs when the array is collected.
+  auto capsule = THPObjectPtr(PyCapsule_New(
+      data_ptr.get(),
+      kDonatedBufferCapsuleName,
+      donated_buffer_capsule_destructor));
+  if (!capsule) return nullptr;
+  data_ptr.release();
+  if (PyArray_SetBaseObject(
+          (PyArrayObject*)array.get(), capsule.release()) == -1) {
+    return nullptr;
+  }
+
+  return array.release();
+}
+
 at::Tensor tensor_from_numpy(PyObject* obj) {
   if (!PyArray_Check(obj)) {
     throw TypeError("expected np.ndarray (got %s)", Py_TYPE(obj)->tp_name);
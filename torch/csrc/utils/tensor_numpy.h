@@ -8,6 +8,13 @@ namespace torch { namespace utils {
 PyObject* tensor_to_numpy(const at::Tensor& tensor);
 at::Tensor tensor_from_numpy(PyObject* obj);
 
+// Like tensor_to_numpy, but donates the tensor's buffer to the returned
+// ndarray instead of keeping the tensor alive as its base object. The tensor
+// must satisfy the Tensor::release_storage preconditions (CPU, contiguous,
+// sole owner of its storage) and is left undefined on success; the ndarray
+// frees the buffer with the storage's original deleter when it is collected.
+PyObject* tensor_to_numpy_consume(at::Tensor&& tensor);
+
 int aten_to_numpy_dtype(const at::ScalarType scalar_type);
 at::ScalarType numpy_dtype_to_aten(int dtype);
 
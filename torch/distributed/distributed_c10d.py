@@ -1567,3 +1567,66 @@ def new_group(ranks=None, timeout=default_pg_timeout, backend=None):
     }
 
     return pg
+
+
+def _new_hierarchical_allreduce_group(ranks_per_node,
+                                      timeout=default_pg_timeout,
+                                      backend=None):
+    """
+    Creates a process group whose allreduce is hierarchical: a reduce-scatter
+    within each node, an allreduce of the shards across nodes, and an
+    allgather within each node. On clusters where the intra-node interconnect
+    (e.g. NVLink) is much faster than the inter-node link this sends only
+    ``1 / ranks_per_node`` of the data across nodes. All other collectives are
+    issued on the default (flat) process group.
+
+    Like :func:`new_group`, this function must be called by all processes in
+    the default group, and ``world_size`` must be divisible by
+    ``ranks_per_node``. Ranks are assumed to be laid out node-major, i.e.
+    ranks ``[i * ranks_per_node, (i + 1) * ranks_per_node)`` share node ``i``,
+    which matches the rank assignment of the common one-process-per-GPU
+    launchers.
+
+    Arguments:
+        ranks_per_node (int): Number of ranks co-located on each node.
+        timeout (timedelta, optional): Timeout for operations executed against
+            the subgroups. See :func:`new_group`.
+        backend (str or Backend, optional): The backend to use for the
+            subgroups. See :func:`new_group`.
+
+    Returns:
+        A handle of distributed group that can be given to collective calls.
+    """
+    _check_default_pg()
+
+    world_size = _default_pg.size()
+    if ranks_per_node < 1 or world_size % ranks_per_node != 0:
+        raise ValueError("world_size ({}) must be divisible by "
+                         "ranks_per_node ({})".format(world_size,
+                                                      ranks_per_node))
+    num_nodes = world_size // ranks_per_node
+    rank = _default_pg.rank()
+    node = rank // ranks_per_node
+    local_rank = rank % ranks_per_node
+
+    # Groups must be created in the same order on every process, so build
+    # all of them and keep the two this rank belongs to.
+    intra_group = None
+    for i in range(num_nodes):
+        group = new_group(
+            list(range(i * ranks_per_node, (i + 1) * ranks_per_node)),
+            timeout=timeout,
+            backend=backend)
+        if i == node:
+            intra_group = group
+    inter_group = None
+    for i in range(ranks_per_node):
+        group = new_group(
+            [n * ranks_per_node + i for n in range(num_nodes)],
+            timeout=timeout,
+            backend=backend)
+        if i == local_rank:
+            inter_group = group
+
+    return torch.distributed._hierarchical_process_group(
+        _default_pg, intra_group, inter_group)
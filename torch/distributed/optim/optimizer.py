@@ -1,9 +1,46 @@
+import torch
 import torch.distributed.rpc as rpc
 import torch.distributed.autograd as dist_autograd
 
 from collections import defaultdict
 from threading import Lock
 
+import hashlib
+import io
+
+
+# Checkpoint payloads are delta encoded at the serialized-bytes level: each
+# worker hashes fixed-size chunks of its torch.save output and only ships the
+# chunks whose hash changed since the previous checkpoint epoch. For the
+# typical parameter-server cadence most of the state is byte-identical
+# between epochs, so this cuts RPC checkpoint traffic roughly proportionally
+# to the fraction of state that actually changed.
+_CHECKPOINT_CHUNK_SIZE = 64 * 1024
+
+
+def _checkpoint_chunk_hashes(data):
+    return [
+        hashlib.sha1(data[begin:begin + _CHECKPOINT_CHUNK_SIZE]).digest()
+        for begin in range(0, len(data), _CHECKPOINT_CHUNK_SIZE)
+    ]
+
+
+def _apply_checkpoint_delta(payload, base):
+    # Reassembles the serialized state dict from a checkpoint payload:
+    # chunks present in the payload are new, missing chunks are unchanged
+    # and taken from the previous epoch's bytes at the same offsets.
+    size = payload['size']
+    chunks = payload['chunks']
+    data = bytearray(size)
+    for i in range((size + _CHECKPOINT_CHUNK_SIZE - 1) // _CHECKPOINT_CHUNK_SIZE):
+        begin = i * _CHECKPOINT_CHUNK_SIZE
+        end = min(begin + _CHECKPOINT_CHUNK_SIZE, size)
+        chunk = chunks.get(i)
+        if chunk is None:
+            chunk = base[begin:end]
+        data[begin:end] = chunk
+    return bytes(data)
+
 
 class _LocalOptimizer:
     # Ideally we would only need to share a lock for instances of
@@ -20,6 +57,10 @@ class _LocalOptimizer:
             [rref.local_value() for rref in local_params_rref],
             *args,
             **kwargs)
+        # epoch of the last checkpoint taken from this optimizer, and the
+        # per-chunk hashes of its serialized bytes (see _CHECKPOINT_CHUNK_SIZE)
+        self._checkpoint_epoch = 0
+        self._checkpoint_hashes = None
 
     def step(self, autograd_ctx_id):
         all_local_grads = dist_autograd.get_gradients(autograd_ctx_id)
@@ -29,6 +70,42 @@ class _LocalOptimizer:
                 param.grad = grad
             self.optim.step()
 
+    def checkpoint(self, base_epoch):
+        # Serializes the local optimizer state and delta encodes it against
+        # the checkpoint epoch the caller already holds. When base_epoch does
+        # not match the last epoch produced here (first checkpoint, or the
+        # caller restarted), a full payload is returned instead.
+        with _LocalOptimizer.global_lock:
+            buffer = io.BytesIO()
+            torch.save(self.optim.state_dict(), buffer)
+        data = buffer.getvalue()
+        hashes = _checkpoint_chunk_hashes(data)
+        chunks = {}
+        if base_epoch == self._checkpoint_epoch and self._checkpoint_hashes is not None:
+            prev_hashes = self._checkpoint_hashes
+            for i, digest in enumerate(hashes):
+                if i >= len(prev_hashes) or digest != prev_hashes[i]:
+                    begin = i * _CHECKPOINT_CHUNK_SIZE
+                    chunks[i] = data[begin:begin + _CHECKPOINT_CHUNK_SIZE]
+            payload_base = base_epoch
+        else:
+            for i in range(len(hashes)):
+                begin = i * _CHECKPOINT_CHUNK_SIZE
+                chunks[i] = data[begin:begin + _CHECKPOINT_CHUNK_SIZE]
+            payload_base = None
+        self._checkpoint_epoch += 1
+        self._checkpoint_hashes = hashes
+        return {
+            'epoch': self._checkpoint_epoch,
+            'base_epoch': payload_base,
+            'size': len(data),
+            'chunks': chunks,
+        }
+
+    def load_state_dict(self, state_dict):
+        with _LocalOptimizer.global_lock:
+            self.optim.load_state_dict(state_dict)
+
 
 def _new_local_optimizer(optim_cls, local_params_rref, *args, **kwargs):
     return rpc.RRef(
@@ -40,6 +117,14 @@ def _local_optimizer_step(local_optim_rref, autograd_ctx_id):
     local_optim.step(autograd_ctx_id)
 
 
+def _local_optimizer_checkpoint(local_optim_rref, base_epoch):
+    return local_optim_rref.local_value().checkpoint(base_epoch)
+
+
+def _local_optimizer_load_state_dict(local_optim_rref, state_dict):
+    local_optim_rref.local_value().load_state_dict(state_dict)
+
+
 def _wait_for_all(rpc_futs):
     # TODO: improve error propagation
     exception = None
@@ -121,6 +206,9 @@ class DistributedOptimizer:
             remote_optim_futs.append(remote_optim_rref_fut)
 
         self.remote_optimizers = _wait_for_all(remote_optim_futs)
+        # per worker: (epoch, serialized bytes) of the last checkpoint, used
+        # as the base for delta-encoded checkpoints in state_dict()
+        self._checkpoint_cache = {}
 
     def step(self, context_id):
         """
@@ -144,3 +232,60 @@ class DistributedOptimizer:
                 args=(optim, context_id),
             ))
         _wait_for_all(rpc_futs)
+
+    def state_dict(self):
+        """
+        Returns the state of the optimizer as a dict mapping each worker name
+        to the :meth:`torch.optim.Optimizer.state_dict` of the local optimizer
+        on that worker.
+
+        Workers serialize their shard in parallel, and each shard is delta
+        encoded against the previous call on this instance: only the chunks of
+        the serialized state that changed since the last checkpoint travel
+        over RPC. The returned dict is always fully materialized and can be
+        saved with :func:`torch.save` and restored with
+        :meth:`~torch.distributed.optim.DistributedOptimizer.load_state_dict`.
+        """
+        owner_names = []
+        rpc_futs = []
+        for optim in self.remote_optimizers:
+            name = optim.owner().name
+            cached = self._checkpoint_cache.get(name)
+            owner_names.append(name)
+            rpc_futs.append(rpc.rpc_async(
+                optim.owner(),
+                _local_optimizer_checkpoint,
+                args=(optim, cached[0] if cached is not None else 0),
+            ))
+        state_dict = {}
+        for name, payload in zip(owner_names, _wait_for_all(rpc_futs)):
+            cached = self._checkpoint_cache.get(name)
+            base = cached[1] if cached is not None else b''
+            data = _apply_checkpoint_delta(payload, base)
+            self._checkpoint_cache[name] = (payload['epoch'], data)
+            state_dict[name] = torch.load(io.BytesIO(data))
+        return state_dict
+
+    def load_state_dict(self, state_dict):
+        """
+        Restores the optimizer state on each worker from a dict produced by
+        :meth:`~torch.distributed.optim.DistributedOptimizer.state_dict`, and
+        blocks until all workers have loaded their shard.
+
+        Args:
+            state_dict (dict): dict mapping worker names to local optimizer
+                states. It must contain an entry for every worker this
+                instance holds parameters on.
+        """
+        rpc_futs = []
+        for optim in self.remote_optimizers:
+            name = optim.owner().name
+            if name not in state_dict:
+                raise ValueError(
+                    "state_dict is missing an entry for worker {}".format(name))
+            rpc_futs.append(rpc.rpc_async(
+                optim.owner(),
+                _local_optimizer_load_state_dict,
+                args=(optim, state_dict[name]),
+            ))
+        _wait_for_all(rpc_futs)
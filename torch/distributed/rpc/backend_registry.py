@@ -142,3 +142,45 @@ register_backend(
     _process_group_construct_rpc_backend_options_handler,
     _process_group_init_backend_handler,
 )
+
+
+def _tcp_construct_rpc_backend_options_handler(
+    rpc_timeout,
+    init_method,
+    num_worker_threads=rpc_constants.DEFAULT_NUM_SEND_RECV_THREADS,
+    **kwargs
+):
+    from . import TcpRpcBackendOptions
+
+    rpc_backend_options = TcpRpcBackendOptions()
+    rpc_backend_options.rpc_timeout = rpc_timeout
+    rpc_backend_options.init_method = init_method
+    rpc_backend_options.num_worker_threads = num_worker_threads
+    return rpc_backend_options
+
+
+def _tcp_init_backend_handler(store, name, rank, world_size, rpc_backend_options):
+    import torch.distributed.rpc as rpc
+
+    if not hasattr(rpc, "TcpRpcAgent"):
+        raise RuntimeError(
+            "The TCP RPC agent is only available on Linux."
+        )
+    # Unlike the PROCESS_GROUP backend, the TCP agent talks to its peers over
+    # its own sockets and only uses the store for rendezvous and
+    # join/sync bookkeeping.
+    return rpc.TcpRpcAgent(
+        name,
+        rank,
+        world_size,
+        store,
+        rpc_backend_options.num_worker_threads,
+        rpc_backend_options.rpc_timeout,
+    )
+
+
+register_backend(
+    "TCP",
+    _tcp_construct_rpc_backend_options_handler,
+    _tcp_init_backend_handler,
+)
@@ -0,0 +1,181 @@
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import time
+
+import torch
+import torch.distributed.rpc as rpc
+from torch.autograd.profiler import EventList
+
+from .api import _get_current_rpc_agent
+
+
+# Name of the synthetic event every worker records immediately after its
+# profiler starts. Each marker's profiler timestamp is paired with a wall
+# clock reading taken at the same instant, which is what lets the merge step
+# express all workers' events on the coordinator's profiler clock.
+_MARKER_NAME = "__rpc_profiler_clock_marker__"
+
+# Profiler started on this worker by a remote coordinator, if any.
+_remote_profiler = None
+
+
+def _record_clock_marker():
+    # Wall clock is sampled on both sides of the marker and averaged so the
+    # pairing error is bounded by half the record_function overhead.
+    wall_begin = time.time()
+    with torch.autograd.profiler.record_function(_MARKER_NAME):
+        pass
+    wall_end = time.time()
+    return (wall_begin + wall_end) / 2.0
+
+
+def _enable_remote_profiler(record_shapes):
+    global _remote_profiler
+    if _remote_profiler is not None:
+        raise RuntimeError("RPC profiler is already enabled on this worker")
+    prof = torch.autograd.profiler.profile(record_shapes=record_shapes)
+    prof.__enter__()
+    _remote_profiler = prof
+    return _record_clock_marker()
+
+
+def _disable_remote_profiler():
+    global _remote_profiler
+    prof = _remote_profiler
+    _remote_profiler = None
+    if prof is None:
+        raise RuntimeError("RPC profiler is not enabled on this worker")
+    prof.__exit__(None, None, None)
+    return prof.function_events
+
+
+def _marker_time(events, worker_name):
+    for event in events:
+        if event.name == _MARKER_NAME:
+            return event.cpu_interval.start
+    raise RuntimeError(
+        "no profiler clock marker in the events from {}".format(worker_name))
+
+
+class profile(object):
+    """Profiles the current worker and every peer it is connected over RPC
+    with, and merges the results into one clock-aligned timeline.
+
+    On ``__enter__`` the autograd profiler is started locally and, via RPC,
+    on all other workers known to the current agent. On ``__exit__`` the
+    remote event lists are collected and every remote timestamp is rebased
+    onto this worker's profiler clock, using per-worker clock markers paired
+    with wall clock readings; gaps where one worker waits on another are then
+    directly visible in a single chrome trace. Remote event names are
+    prefixed with their worker name and remote threads get fresh thread ids,
+    so per-worker breakdowns survive ``key_averages()``.
+
+    Alignment accuracy across hosts is bounded by how well their wall clocks
+    are synchronized (typically NTP); on a single host it is limited only by
+    the marker recording overhead.
+
+    Must run under an initialized RPC agent, and only one coordinator may
+    profile a given set of workers at a time.
+
+    Example::
+
+        >>> from torch.distributed.rpc.profiler import profile
+        >>> with profile() as prof:
+        >>>     rpc.rpc_sync("worker1", torch.add, args=(x, y))
+        >>> prof.export_chrome_trace("trace.json")
+    """
+
+    def __init__(self, record_shapes=False):
+        self.record_shapes = record_shapes
+        self.function_events = None
+        self._local_profiler = None
+        self._workers = None
+        self._marker_walls = None
+
+    def __enter__(self):
+        agent = _get_current_rpc_agent()
+        self_name = agent.get_worker_info().name
+        self._workers = sorted(
+            info.name
+            for info in agent.get_worker_infos()
+            if info.name != self_name
+        )
+
+        self._local_profiler = torch.autograd.profiler.profile(
+            record_shapes=self.record_shapes)
+        self._local_profiler.__enter__()
+        local_wall = _record_clock_marker()
+
+        futs = [
+            rpc.rpc_async(
+                worker, _enable_remote_profiler, args=(self.record_shapes,))
+            for worker in self._workers
+        ]
+        self._marker_walls = {self_name: local_wall}
+        for worker, fut in zip(self._workers, futs):
+            self._marker_walls[worker] = fut.wait()
+        self._self_name = self_name
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        futs = [
+            rpc.rpc_async(worker, _disable_remote_profiler)
+            for worker in self._workers
+        ]
+        self._local_profiler.__exit__(None, None, None)
+        local_events = self._local_profiler.function_events
+        local_marker = _marker_time(local_events, self._self_name)
+        local_wall = self._marker_walls[self._self_name]
+
+        merged = [e for e in local_events if e.name != _MARKER_NAME]
+        # local threads keep their ids; remote (worker, thread) pairs are
+        # remapped to fresh ids above every local one
+        thread_ids = {}
+        next_thread = max((e.thread for e in merged), default=0) + 1
+        for worker, fut in zip(self._workers, futs):
+            events = fut.wait()
+            marker = _marker_time(events, worker)
+            # shift taking event timestamps on `worker` to the local
+            # profiler clock, through the paired wall clock readings
+            shift = (
+                local_marker - marker +
+                (self._marker_walls[worker] - local_wall) * 1e6)
+            for event in events:
+                if event.name == _MARKER_NAME:
+                    continue
+                event.name = "{}/{}".format(worker, event.name)
+                event.cpu_interval.start += shift
+                event.cpu_interval.end += shift
+                for kernel in event.kernels:
+                    kernel.interval.start += shift
+                    kernel.interval.end += shift
+                key = (worker, event.thread)
+                if key not in thread_ids:
+                    thread_ids[key] = next_thread
+                    next_thread += 1
+                event.thread = thread_ids[key]
+                merged.append(event)
+
+        self.function_events = EventList(merged, use_cuda=False)
+        self.function_events.populate_cpu_children()
+        return False
+
+    def _check_finish(self):
+        if self.function_events is None:
+            raise RuntimeError("can't export a trace that didn't finish running")
+
+    def table(self, sort_by=None, row_limit=100, header=None):
+        self._check_finish()
+        return self.function_events.table(
+            sort_by=sort_by, row_limit=row_limit, header=header)
+    table.__doc__ = EventList.table.__doc__
+
+    def export_chrome_trace(self, path):
+        self._check_finish()
+        return self.function_events.export_chrome_trace(path)
+    export_chrome_trace.__doc__ = EventList.export_chrome_trace.__doc__
+
+    def key_averages(self, group_by_input_shape=False):
+        self._check_finish()
+        return self.function_events.key_averages(group_by_input_shape)
+    key_averages.__doc__ = EventList.key_averages.__doc__
@@ -71,6 +71,7 @@ derivative would be as follows::
     loss.backward()
 """
 
+from .alias_multinomial import AliasMultinomial
 from .bernoulli import Bernoulli
 from .beta import Beta
 from .binomial import Binomial
@@ -112,6 +113,7 @@ from .von_mises import VonMises
 from .weibull import Weibull
 
 __all__ = [
+    'AliasMultinomial',
     'Bernoulli',
     'Beta',
     'Binomial',
@@ -0,0 +1,56 @@
+import torch
+
+
+class AliasMultinomial(object):
+    r"""
+    Draws samples from a fixed categorical distribution in constant time per
+    sample using the alias method (Walker, 1977).
+
+    :func:`torch.multinomial` runs a binary search over the CDF for every
+    sample, which is wasteful when the same distribution is sampled many
+    times between updates (for example action sampling during rollouts).
+    This object builds the alias table once at construction - an O(K) setup
+    for `K` categories - and every subsequent draw only needs one uniform
+    variate, one table lookup and one comparison per sample.
+
+    Example::
+
+        >>> sampler = AliasMultinomial(torch.tensor([0.1, 0.2, 0.7]))
+        >>> sampler.draw(4)
+        tensor([2, 2, 1, 2])
+
+    Args:
+        probs (Tensor): 1-D tensor of relative probabilities. It is
+            normalized internally and does not need to sum to one. Samples
+            are drawn on the same device as :attr:`probs`.
+    """
+
+    def __init__(self, probs):
+        if probs.dim() != 1:
+            raise ValueError("probs must be one-dimensional, got {} dimensions"
+                             .format(probs.dim()))
+        if probs.numel() == 0:
+            raise ValueError("probs must contain at least one category")
+        probs = probs.detach()
+        if not torch.isfinite(probs).all() or (probs < 0).any():
+            raise ValueError("probs must be non-negative and finite")
+        total = probs.sum()
+        if total <= 0:
+            raise ValueError("probs must have a non-zero sum")
+        self.probs = probs / total
+        self._J, self._q = torch._multinomial_alias_setup(self.probs)
+
+    @property
+    def num_categories(self):
+        return self.probs.size(0)
+
+    def draw(self, num_samples=1, generator=None):
+        r"""
+        Returns a 1-D int64 tensor of :attr:`num_samples` category indices
+        sampled with replacement from the cached distribution.
+        """
+        if num_samples < 0:
+            raise ValueError("num_samples must be non-negative, got {}"
+                             .format(num_samples))
+        return torch._multinomial_alias_draw(
+            self._J, self._q, num_samples, generator=generator)
@@ -12,6 +12,10 @@
 #include <gloo/transport/uv/device.h>
 #endif
 
+#if GLOO_HAVE_TRANSPORT_IBVERBS
+#include <gloo/transport/ibverbs/device.h>
+#endif
+
 // On Linux, check that the tcp transport is available.
 #ifdef __linux__
 #if !GLOO_HAVE_TRANSPORT_TCP
@@ -84,6 +88,32 @@ C10_REGISTER_CREATOR(GlooDeviceRegistry, APPLE, makeUVDevice);
 C10_REGISTER_CREATOR(GlooDeviceRegistry, UV, makeUVDevice);
 #endif
 
+#if GLOO_HAVE_TRANSPORT_IBVERBS
+static std::shared_ptr<::gloo::transport::Device> makeIbverbsDevice(
+    const std::string& interface,
+    const std::string& /* unused */) {
+  TORCH_CHECK(
+      !interface.empty(),
+      "GlooDeviceFactory::makeIbverbsDevice(): interface can't be empty. "
+      "For the ibverbs transport it must name the HCA to use (e.g. mlx5_0); "
+      "set it through GLOO_SOCKET_IFNAME.");
+
+  ::gloo::transport::ibverbs::attr attr;
+  attr.name = interface;
+  attr.port = 1;
+  attr.index = 0;
+  return ::gloo::transport::ibverbs::CreateDevice(attr);
+}
+
+// Only registered under `IBVERBS`, never under a platform key: RDMA has to
+// be an explicit opt-in through GLOO_DEVICE_TRANSPORT because the
+// interface string selects an HCA rather than a network interface. The
+// transport registers memory regions per buffer and caches them for the
+// lifetime of the buffer, so the reducer's persistent gradient buckets
+// are registered once and reused across iterations.
+C10_REGISTER_CREATOR(GlooDeviceRegistry, IBVERBS, makeIbverbsDevice);
+#endif
+
 static const char* glooDeviceTransport = getenv("GLOO_DEVICE_TRANSPORT");
 
 std::shared_ptr<::gloo::transport::Device> GlooDeviceFactory::
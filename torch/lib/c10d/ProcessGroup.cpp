@@ -4,6 +4,20 @@
 
 namespace c10d {
 
+namespace {
+
+std::string exceptionMessage(const std::exception_ptr& exception) {
+  try {
+    std::rethrow_exception(exception);
+  } catch (const std::exception& e) {
+    return e.what();
+  } catch (...) {
+    return "Unknown exception type";
+  }
+}
+
+} // namespace
+
 ProcessGroup::Work::~Work() {}
 
 bool ProcessGroup::Work::isCompleted() {
@@ -48,12 +62,215 @@ void ProcessGroup::Work::abort() {
   TORCH_CHECK(false, "ProcessGroup::Work::abort not implemented.")
 }
 
+c10::intrusive_ptr<c10::ivalue::Future> ProcessGroup::Work::getFuture() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!future_) {
+    future_ =
+        c10::make_intrusive<c10::ivalue::Future>(c10::ListType::ofTensors());
+    if (completed_) {
+      // The work finished before anyone asked for a future; complete it
+      // here instead of in finish().
+      auto future = future_;
+      auto exception = exception_;
+      lock.unlock();
+      completeFuture(std::move(future), exception);
+      return future_;
+    }
+  }
+  return future_;
+}
+
+void ProcessGroup::Work::addCallback(std::function<void()> callback) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (completed_) {
+    lock.unlock();
+    callback();
+    return;
+  }
+  callbacks_.push_back(std::move(callback));
+}
+
+void ProcessGroup::Work::completeFuture(
+    c10::intrusive_ptr<c10::ivalue::Future> future,
+    std::exception_ptr exception) {
+  if (exception) {
+    future->markCompleted(
+        c10::ivalue::Future::FutureError(exceptionMessage(exception)));
+    return;
+  }
+  std::vector<at::Tensor> outputs;
+  try {
+    outputs = result();
+  } catch (const std::exception&) {
+    // Not every work object implements result(); such futures resolve
+    // with an empty tensor list.
+  }
+  future->markCompleted(
+      at::IValue(c10::List<at::Tensor>(at::ArrayRef<at::Tensor>(outputs))));
+}
+
 void ProcessGroup::Work::finish(std::exception_ptr exception) {
   std::unique_lock<std::mutex> lock(mutex_);
   completed_ = true;
   exception_ = exception;
+  auto future = future_;
+  std::vector<std::function<void()>> callbacks;
+  callbacks.swap(callbacks_);
   lock.unlock();
   cv_.notify_all();
+  if (future) {
+    completeFuture(std::move(future), exception);
+  }
+  for (auto& callback : callbacks) {
+    callback();
+  }
+}
+
+// One Work handle shared by every call captured in a coalescing scope. The
+// flat collectives are attached by end_coalescing(); wait() drains them and
+// scatters the reduced values back into the original tensors.
+class CoalescedWork : public ProcessGroup::Work {
+ public:
+  struct Group {
+    std::shared_ptr<ProcessGroup::Work> work;
+    at::Tensor flat;
+    std::vector<at::Tensor> tensors; // scatter-back destinations, in order
+  };
+
+  void setGroups(std::vector<Group> groups) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    groups_ = std::move(groups);
+    issued_ = true;
+  }
+
+  bool wait() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      TORCH_CHECK(
+          issued_,
+          "cannot wait() on a coalesced Work before end_coalescing() has "
+          "issued the collectives");
+      if (completed_) {
+        if (exception_) {
+          std::rethrow_exception(exception_);
+        }
+        return true;
+      }
+    }
+    std::exception_ptr eptr;
+    try {
+      for (auto& group : groups_) {
+        group.work->wait();
+      }
+      for (auto& group : groups_) {
+        int64_t offset = 0;
+        for (auto& tensor : group.tensors) {
+          const auto numel = tensor.numel();
+          tensor.copy_(
+              group.flat.narrow(0, offset, numel).view(tensor.sizes()));
+          offset += numel;
+        }
+      }
+    } catch (...) {
+      eptr = std::current_exception();
+    }
+    finish(eptr);
+    if (eptr) {
+      std::rethrow_exception(eptr);
+    }
+    return true;
+  }
+
+ private:
+  bool issued_ = false;
+  std::vector<Group> groups_;
+};
+
+struct ProcessGroup::CoalescingState {
+  struct PendingOp {
+    std::vector<at::Tensor> tensors;
+    AllreduceOptions opts;
+  };
+  std::vector<PendingOp> pending;
+  std::shared_ptr<CoalescedWork> work;
+};
+
+void ProcessGroup::start_coalescing() {
+  std::lock_guard<std::mutex> lock(coalescing_mutex_);
+  TORCH_CHECK(
+      !coalescing_state_,
+      "start_coalescing() called while a coalescing scope is already active");
+  coalescing_state_ = std::make_shared<CoalescingState>();
+  coalescing_state_->work = std::make_shared<CoalescedWork>();
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroup::coalesced_allreduce(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  {
+    std::lock_guard<std::mutex> lock(coalescing_mutex_);
+    if (coalescing_state_) {
+      for (const auto& tensor : tensors) {
+        TORCH_CHECK(
+            tensor.defined() && tensor.layout() == at::kStrided,
+            "coalesced_allreduce only supports defined dense tensors");
+      }
+      coalescing_state_->pending.push_back({tensors, opts});
+      return coalescing_state_->work;
+    }
+  }
+  return allreduce(tensors, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroup::end_coalescing() {
+  std::shared_ptr<CoalescingState> state;
+  {
+    std::lock_guard<std::mutex> lock(coalescing_mutex_);
+    TORCH_CHECK(
+        coalescing_state_,
+        "end_coalescing() called without an active coalescing scope");
+    state = std::move(coalescing_state_);
+  }
+
+  // Pack pending tensors into one flat buffer per (device, dtype, op)
+  // group, preserving capture order within each group.
+  std::vector<CoalescedWork::Group> groups;
+  std::vector<AllreduceOptions> group_opts;
+  std::unordered_map<std::string, size_t> group_index;
+  for (auto& op : state->pending) {
+    for (auto& tensor : op.tensors) {
+      const std::string key = tensor.device().str() + "/" +
+          std::to_string(static_cast<int>(tensor.scalar_type())) + "/" +
+          std::to_string(static_cast<uint8_t>(op.opts.reduceOp));
+      auto it = group_index.find(key);
+      if (it == group_index.end()) {
+        it = group_index.emplace(key, groups.size()).first;
+        groups.emplace_back();
+        group_opts.push_back(op.opts);
+      }
+      groups[it->second].tensors.push_back(tensor);
+    }
+  }
+
+  for (size_t i = 0; i < groups.size(); ++i) {
+    auto& group = groups[i];
+    int64_t total = 0;
+    for (const auto& tensor : group.tensors) {
+      total += tensor.numel();
+    }
+    group.flat = at::empty({total}, group.tensors.front().options());
+    int64_t offset = 0;
+    for (const auto& tensor : group.tensors) {
+      const auto numel = tensor.numel();
+      group.flat.narrow(0, offset, numel).view(tensor.sizes()).copy_(tensor);
+      offset += numel;
+    }
+    std::vector<at::Tensor> flat_vec = {group.flat};
+    group.work = allreduce(flat_vec, group_opts[i]);
+  }
+
+  state->work->setGroups(std::move(groups));
+  return state->work;
 }
 
 ProcessGroup::ProcessGroup(int rank, int size) : rank_(rank), size_(size) {
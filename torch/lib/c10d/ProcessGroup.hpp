@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -8,6 +9,7 @@
 #include <vector>
 
 #include <ATen/ATen.h>
+#include <ATen/core/ivalue.h>
 
 #include <c10d/Types.hpp>
 
@@ -87,6 +89,20 @@ class ProcessGroup {
 
     virtual void abort();
 
+    // Returns a Future that becomes ready when the work completes and
+    // then holds the result() tensors (an empty list for operations
+    // without a result). If the work fails, the future is marked with
+    // an error instead. The future and its callbacks are triggered from
+    // the thread that completes the work, so callbacks must not block.
+    // This allows queueing several independent collectives and chaining
+    // continuations without a blocked thread per operation.
+    virtual c10::intrusive_ptr<c10::ivalue::Future> getFuture();
+
+    // Registers a callback that runs when the work completes, or
+    // immediately if it already has. Like future callbacks, it is
+    // invoked from the thread that completes the work.
+    void addCallback(std::function<void()> callback);
+
    protected:
     void finish(std::exception_ptr exception = nullptr);
 
@@ -94,6 +110,16 @@ class ProcessGroup {
     std::condition_variable cv_;
     bool completed_ = false;
     std::exception_ptr exception_;
+
+   private:
+    // Marks `future` ready (or errored) according to `exception` and the
+    // work's result. Must be called without holding mutex_.
+    void completeFuture(
+        c10::intrusive_ptr<c10::ivalue::Future> future,
+        std::exception_ptr exception);
+
+    std::vector<std::function<void()>> callbacks_;
+    c10::intrusive_ptr<c10::ivalue::Future> future_;
   };
 
   explicit ProcessGroup(int rank, int size);
@@ -115,6 +141,29 @@ class ProcessGroup {
       std::vector<at::Tensor>& data,
       const AllreduceOptions& opts = AllreduceOptions()) = 0;
 
+  // Coalescing scope for many small allreduces. Between start_coalescing()
+  // and end_coalescing(), coalesced_allreduce() captures the requested
+  // reductions instead of issuing them; end_coalescing() groups the pending
+  // tensors by device, dtype and reduce op, packs each group into one flat
+  // buffer, runs a single allreduce per group through the backend, and
+  // scatters the results back into the original tensors. Dozens of small
+  // reductions then pay one launch and algorithm setup per group - the same
+  // idea as the Reducer's gradient bucketing, but available to arbitrary
+  // callers.
+  //
+  // Every captured call returns the scope's shared Work handle, which is
+  // also what end_coalescing() returns. The handle only becomes waitable
+  // once end_coalescing() has issued the collectives (waiting earlier
+  // throws), and the scatter-back happens in wait(). Scopes do not nest and
+  // a scope must be driven from a single thread.
+  void start_coalescing();
+  std::shared_ptr<ProcessGroup::Work> end_coalescing();
+  // Inside a scope, captures the reduction as described above; outside a
+  // scope this is identical to allreduce().
+  std::shared_ptr<ProcessGroup::Work> coalesced_allreduce(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts = AllreduceOptions());
+
   // This will be moved out of ProcessGroup, do not add dependencies on this
   // function.
   virtual std::shared_ptr<ProcessGroup::Work> allreduce_coalesced(
@@ -182,6 +231,11 @@ class ProcessGroup {
  protected:
   const int rank_;
   const int size_;
+
+ private:
+  struct CoalescingState;
+  std::mutex coalescing_mutex_;
+  std::shared_ptr<CoalescingState> coalescing_state_;
 };
 
 } // namespace c10d
@@ -333,16 +333,17 @@ ProcessGroupGloo::SendWork::SendWork(
 
 bool ProcessGroupGloo::SendWork::wait() {
   bool sendCompleted = false;
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::exception_ptr exception;
   try {
     sendCompleted = buffer_->waitSend();
   } catch (...) {
-    exception_ = std::current_exception();
+    exception = std::current_exception();
   }
 
-  completed_ = true;
-  if (exception_) {
-    std::rethrow_exception(exception_);
+  // Completes the work object and fires its future/callbacks.
+  finish(exception);
+  if (exception) {
+    std::rethrow_exception(exception);
   }
   return sendCompleted;
 }
@@ -363,16 +364,18 @@ int ProcessGroupGloo::RecvWork::sourceRank() const {
 
 bool ProcessGroupGloo::RecvWork::wait() {
   bool recvCompleted = false;
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::exception_ptr exception;
   try {
+    std::lock_guard<std::mutex> lock(mutex_);
     recvCompleted = buffer_->waitRecv(&srcRank_);
   } catch (...) {
-    exception_ = std::current_exception();
+    exception = std::current_exception();
   }
 
-  completed_ = true;
-  if (exception_) {
-    std::rethrow_exception(exception_);
+  // Completes the work object and fires its future/callbacks.
+  finish(exception);
+  if (exception) {
+    std::rethrow_exception(exception);
   }
   return recvCompleted;
 }
@@ -0,0 +1,191 @@
+#include <c10d/ProcessGroupHierarchical.hpp>
+
+namespace c10d {
+
+ProcessGroupHierarchical::ProcessGroupHierarchical(
+    int rank,
+    int size,
+    std::shared_ptr<ProcessGroup> globalGroup,
+    std::shared_ptr<ProcessGroup> intraGroup,
+    std::shared_ptr<ProcessGroup> interGroup)
+    : ProcessGroup(rank, size),
+      globalGroup_(std::move(globalGroup)),
+      intraGroup_(std::move(intraGroup)),
+      interGroup_(std::move(interGroup)) {
+  TORCH_CHECK(globalGroup_ != nullptr);
+  TORCH_CHECK(intraGroup_ != nullptr);
+  TORCH_CHECK(interGroup_ != nullptr);
+  TORCH_CHECK(globalGroup_->getRank() == rank_);
+  TORCH_CHECK(globalGroup_->getSize() == size_);
+  // Every rank must belong to exactly one intra-node group and one
+  // inter-node group, so the two group sizes factor the world.
+  TORCH_CHECK(
+      intraGroup_->getSize() * interGroup_->getSize() == size_,
+      "intra-node group size (",
+      intraGroup_->getSize(),
+      ") times inter-node group size (",
+      interGroup_->getSize(),
+      ") must equal the world size (",
+      size_,
+      ")");
+}
+
+ProcessGroupHierarchical::~ProcessGroupHierarchical() {}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::broadcast(
+    std::vector<at::Tensor>& tensors,
+    const BroadcastOptions& opts) {
+  return globalGroup_->broadcast(tensors, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::allreduce(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  // With a single node (or a single rank per node) one of the phases spans
+  // the full world and the other is a no-op; issue a flat allreduce on the
+  // non-trivial group directly.
+  if (interGroup_->getSize() == 1) {
+    return intraGroup_->allreduce(tensors, opts);
+  }
+  if (intraGroup_->getSize() == 1) {
+    return interGroup_->allreduce(tensors, opts);
+  }
+
+  const int64_t intraSize = intraGroup_->getSize();
+  if (tensors.size() != 1 || !tensors[0].is_contiguous() ||
+      tensors[0].numel() < intraSize) {
+    return globalGroup_->allreduce(tensors, opts);
+  }
+
+  auto& tensor = tensors[0];
+  const int64_t numel = tensor.numel();
+  const int64_t shardNumel = (numel + intraSize - 1) / intraSize;
+
+  // Reduce-scatter requires the tensor to split into intraSize equal
+  // shards; pad into a scratch buffer when it does not. When no padding is
+  // needed the shards are views into the caller's tensor and the allgather
+  // below writes the result in place.
+  const bool padded = (numel % intraSize) != 0;
+  at::Tensor flat;
+  if (padded) {
+    flat = at::zeros({shardNumel * intraSize}, tensor.options());
+    flat.narrow(0, 0, numel).copy_(tensor.view({numel}));
+  } else {
+    flat = tensor.view({numel});
+  }
+
+  std::vector<at::Tensor> shards;
+  shards.reserve(intraSize);
+  for (int64_t i = 0; i < intraSize; ++i) {
+    shards.push_back(flat.narrow(0, i * shardNumel, shardNumel));
+  }
+
+  // Phase 1: reduce-scatter inside the node. Each intra-node rank ends up
+  // with the node-local sum of its shard.
+  std::vector<at::Tensor> myShard = {shards[intraGroup_->getRank()]};
+  std::vector<std::vector<at::Tensor>> shardLists = {shards};
+  ReduceScatterOptions reduceScatterOpts;
+  reduceScatterOpts.reduceOp = opts.reduceOp;
+  reduceScatterOpts.timeout = opts.timeout;
+  intraGroup_->reduce_scatter(myShard, shardLists, reduceScatterOpts)->wait();
+
+  // Phase 2: allreduce each shard across nodes. Only 1/intraSize of the
+  // tensor crosses the inter-node link.
+  AllreduceOptions allreduceOpts;
+  allreduceOpts.reduceOp = opts.reduceOp;
+  allreduceOpts.timeout = opts.timeout;
+  interGroup_->allreduce(myShard, allreduceOpts)->wait();
+
+  // Phase 3: allgather the globally reduced shards inside the node.
+  AllgatherOptions allgatherOpts;
+  allgatherOpts.timeout = opts.timeout;
+  auto work = intraGroup_->allgather(shardLists, myShard, allgatherOpts);
+  if (padded) {
+    work->wait();
+    tensor.view({numel}).copy_(flat.narrow(0, 0, numel));
+  }
+  return work;
+}
+
+std::shared_ptr<ProcessGroup::Work>
+ProcessGroupHierarchical::allreduce_coalesced(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceCoalescedOptions& opts) {
+  return globalGroup_->allreduce_coalesced(tensors, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::reduce(
+    std::vector<at::Tensor>& tensors,
+    const ReduceOptions& opts) {
+  return globalGroup_->reduce(tensors, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::allgather(
+    std::vector<std::vector<at::Tensor>>& outputs,
+    std::vector<at::Tensor>& inputs,
+    const AllgatherOptions& opts) {
+  return globalGroup_->allgather(outputs, inputs, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::allgather_base(
+    at::Tensor& outputBuffer,
+    at::Tensor& inputBuffer,
+    const AllgatherOptions& opts) {
+  return globalGroup_->allgather_base(outputBuffer, inputBuffer, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work>
+ProcessGroupHierarchical::allgather_coalesced(
+    std::vector<std::vector<at::Tensor>>& outputTensorLists,
+    std::vector<at::Tensor>& inputTensors,
+    const AllgatherOptions& opts) {
+  return globalGroup_->allgather_coalesced(outputTensorLists, inputTensors, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::gather(
+    std::vector<std::vector<at::Tensor>>& outputs,
+    std::vector<at::Tensor>& inputs,
+    const GatherOptions& opts) {
+  return globalGroup_->gather(outputs, inputs, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::scatter(
+    std::vector<at::Tensor>& outputs,
+    std::vector<std::vector<at::Tensor>>& inputs,
+    const ScatterOptions& opts) {
+  return globalGroup_->scatter(outputs, inputs, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::reduce_scatter(
+    std::vector<at::Tensor>& outputs,
+    std::vector<std::vector<at::Tensor>>& inputs,
+    const ReduceScatterOptions& opts) {
+  return globalGroup_->reduce_scatter(outputs, inputs, opts);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::send(
+    std::vector<at::Tensor>& tensors,
+    int dstRank,
+    int tag) {
+  return globalGroup_->send(tensors, dstRank, tag);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::recv(
+    std::vector<at::Tensor>& tensors,
+    int srcRank,
+    int tag) {
+  return globalGroup_->recv(tensors, srcRank, tag);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::recvAnysource(
+    std::vector<at::Tensor>& tensors,
+    int tag) {
+  return globalGroup_->recvAnysource(tensors, tag);
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupHierarchical::barrier(
+    const BarrierOptions& opts) {
+  return globalGroup_->barrier(opts);
+}
+
+} // namespace c10d
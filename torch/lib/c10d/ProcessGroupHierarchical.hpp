@@ -0,0 +1,112 @@
+#pragma once
+
+#include <memory>
+
+#include <c10d/ProcessGroup.hpp>
+
+namespace c10d {
+
+// ProcessGroupHierarchical implements a bandwidth-optimal allreduce for
+// multi-node clusters where intra-node links (e.g. NVLink) are much faster
+// than the inter-node interconnect.
+//
+// It is constructed from three process groups that share this process's
+// global rank assignment:
+//  - a global group spanning all ranks, used for every collective other
+//    than allreduce;
+//  - an intra-node group spanning the ranks on this process's node;
+//  - an inter-node group spanning the ranks that hold the same intra-node
+//    rank on every node.
+// The global world must factor exactly into intraGroup->getSize() nodes of
+// interGroup->getSize() ranks each.
+//
+// Allreduce is decomposed into a reduce-scatter inside the node, an
+// allreduce of the resulting shard across nodes, and an allgather inside
+// the node. Only 1/intraSize of the data crosses the inter-node link,
+// instead of the full tensor as with a flat ring spanning all ranks.
+//
+// As with ProcessGroupRoundRobin, all functions of the class are expected
+// to be called in the same order across all processes in the process group.
+//
+class ProcessGroupHierarchical final : public ProcessGroup {
+ public:
+  explicit ProcessGroupHierarchical(
+      int rank,
+      int size,
+      std::shared_ptr<ProcessGroup> globalGroup,
+      std::shared_ptr<ProcessGroup> intraGroup,
+      std::shared_ptr<ProcessGroup> interGroup);
+
+  ~ProcessGroupHierarchical() override;
+
+  std::shared_ptr<ProcessGroup::Work> broadcast(
+      std::vector<at::Tensor>& tensors,
+      const BroadcastOptions& opts = BroadcastOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> allreduce(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts = AllreduceOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> allreduce_coalesced(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceCoalescedOptions& opts =
+          AllreduceCoalescedOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> reduce(
+      std::vector<at::Tensor>& tensors,
+      const ReduceOptions& opts = ReduceOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> allgather(
+      std::vector<std::vector<at::Tensor>>& outputs,
+      std::vector<at::Tensor>& inputs,
+      const AllgatherOptions& opts = AllgatherOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> allgather_base(
+      at::Tensor& outputBuffer,
+      at::Tensor& inputBuffer,
+      const AllgatherOptions& opts = AllgatherOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> allgather_coalesced(
+      std::vector<std::vector<at::Tensor>>& outputTensorLists,
+      std::vector<at::Tensor>& inputTensors,
+      const AllgatherOptions& opts = AllgatherOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> gather(
+      std::vector<std::vector<at::Tensor>>& outputs,
+      std::vector<at::Tensor>& inputs,
+      const GatherOptions& opts = GatherOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> scatter(
+      std::vector<at::Tensor>& outputs,
+      std::vector<std::vector<at::Tensor>>& inputs,
+      const ScatterOptions& opts = ScatterOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> reduce_scatter(
+      std::vector<at::Tensor>& outputs,
+      std::vector<std::vector<at::Tensor>>& inputs,
+      const ReduceScatterOptions& opts = ReduceScatterOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> send(
+      std::vector<at::Tensor>& tensors,
+      int dstRank,
+      int tag) override;
+
+  std::shared_ptr<ProcessGroup::Work> recv(
+      std::vector<at::Tensor>& tensors,
+      int srcRank,
+      int tag) override;
+
+  std::shared_ptr<ProcessGroup::Work> recvAnysource(
+      std::vector<at::Tensor>& tensors,
+      int tag) override;
+
+  std::shared_ptr<ProcessGroup::Work> barrier(
+      const BarrierOptions& opts = BarrierOptions()) override;
+
+ private:
+  std::shared_ptr<ProcessGroup> globalGroup_;
+  std::shared_ptr<ProcessGroup> intraGroup_;
+  std::shared_ptr<ProcessGroup> interGroup_;
+};
+
+} // namespace c10d
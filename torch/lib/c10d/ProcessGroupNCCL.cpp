@@ -1,5 +1,6 @@
 #include <c10d/ProcessGroupNCCL.hpp>
 
+#include <algorithm>
 #include <map>
 #include <tuple>
 #include <unordered_set>
@@ -286,6 +287,26 @@ ProcessGroupNCCL::ProcessGroupNCCL(
         std::string(NCCL_BLOCKING_WAIT));
   }
 
+  char* highPriorityStreams = getenv(NCCL_HIGH_PRIORITY_STREAMS);
+  try {
+    if (highPriorityStreams != nullptr) {
+      auto val = std::stoi(highPriorityStreams);
+      if (val == 1) {
+        // Launch all collectives of this process group on high priority
+        // streams so they can overlap with concurrently running compute.
+        isHighPriorityStream_ = true;
+      } else if (val != 0) {
+        throw std::runtime_error(
+            "Invalid value for environment variable: " +
+            std::string(NCCL_HIGH_PRIORITY_STREAMS));
+      }
+    }
+  } catch (std::exception& e) {
+    throw std::runtime_error(
+        "Invalid value for environment variable: " +
+        std::string(NCCL_HIGH_PRIORITY_STREAMS));
+  }
+
 #ifdef ENABLE_NCCL_ERROR_CHECKING
   ncclCommWatchdogThread_ =
       std::thread(&ProcessGroupNCCL::ncclCommWatchdog, this);
@@ -455,6 +476,32 @@ void ProcessGroupNCCL::broadcastUniqueNCCLID(ncclUniqueId* ncclID) {
   }
 }
 
+void ProcessGroupNCCL::broadcastUniqueNCCLIDs(
+    std::vector<ncclUniqueId>* ncclIDs) {
+  // Same scheme as broadcastUniqueNCCLID, except that the IDs of a whole
+  // batch of communicators travel through a single store entry, so that
+  // eagerly bootstrapping many communicators costs one round trip.
+  std::string storeKey = std::to_string(ncclCommCounter_++);
+  if (rank_ == 0) {
+    std::vector<uint8_t> vec;
+    vec.reserve(ncclIDs->size() * NCCL_UNIQUE_ID_BYTES);
+    for (const auto& ncclID : *ncclIDs) {
+      const auto* bytes = reinterpret_cast<const uint8_t*>(&ncclID);
+      vec.insert(vec.end(), bytes, bytes + NCCL_UNIQUE_ID_BYTES);
+    }
+    store_->set(storeKey, vec);
+  } else {
+    auto vec = store_->get(storeKey);
+    AT_CHECK(vec.size() == ncclIDs->size() * NCCL_UNIQUE_ID_BYTES);
+    for (size_t i = 0; i < ncclIDs->size(); ++i) {
+      std::memcpy(
+          &(*ncclIDs)[i],
+          vec.data() + i * NCCL_UNIQUE_ID_BYTES,
+          NCCL_UNIQUE_ID_BYTES);
+    }
+  }
+}
+
 std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
     const std::string& devicesKey,
     const std::vector<at::Device>& devices) {
@@ -478,8 +525,6 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
   }
 
   // NCCL communicator not cached, create a new entry
-  std::vector<std::shared_ptr<NCCLComm>> ncclComms;
-  ncclComms.resize(devices.size());
 
   // Create the unique NCCL ID and broadcast it
   ncclUniqueId ncclID;
@@ -491,6 +536,16 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
   // Broadcast so that each process can have a unique NCCL ID
   broadcastUniqueNCCLID(&ncclID);
 
+  return createNCCLComm(devicesKey, devices, ncclID);
+}
+
+std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::createNCCLComm(
+    const std::string& devicesKey,
+    const std::vector<at::Device>& devices,
+    const ncclUniqueId& ncclID) {
+  std::vector<std::shared_ptr<NCCLComm>> ncclComms;
+  ncclComms.resize(devices.size());
+
   at::cuda::OptionalCUDAGuard gpuGuard;
 
   std::vector<at::cuda::CUDAStream> streamVal;
@@ -507,8 +562,10 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
     gpuGuard.set_index(devices[i].index());
     ncclComms[i] = NCCLComm::create(numRanks, rank, ncclID);
 
-    // Creates the NCCL streams
-    streamVal.push_back(at::cuda::getStreamFromPool());
+    // Creates the NCCL streams. Taking them from the high priority pool (when
+    // requested) lets the communication kernels preempt compute kernels,
+    // improving overlap of e.g. bucket allreduces with backward compute.
+    streamVal.push_back(at::cuda::getStreamFromPool(isHighPriorityStream_));
   }
 
   C10D_NCCL_CHECK(ncclGroupEnd());
@@ -535,6 +592,58 @@ std::vector<std::shared_ptr<NCCLComm>>& ProcessGroupNCCL::getNCCLComm(
   return devNCCLCommMap_[devicesKey];
 }
 
+void ProcessGroupNCCL::initComms(
+    const std::vector<std::vector<at::Device>>& deviceLists) {
+  // Collect the device sets that do not have communicators yet. Every rank
+  // runs this over the same lists, so they all agree on what to bootstrap.
+  std::vector<std::string> keys;
+  std::vector<const std::vector<at::Device>*> sets;
+  for (const auto& devices : deviceLists) {
+    if (devices.empty()) {
+      throw std::runtime_error(
+          "ProcessGroupNCCL::initComms: device lists must be non-empty");
+    }
+    auto key = getKeyFromDevices(devices);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (devNCCLCommMap_.find(key) != devNCCLCommMap_.end()) {
+        continue;
+      }
+    }
+    if (std::find(keys.begin(), keys.end(), key) != keys.end()) {
+      continue;
+    }
+    keys.push_back(std::move(key));
+    sets.push_back(&devices);
+  }
+  if (sets.empty()) {
+    return;
+  }
+
+  // Exchange the unique IDs for all new communicators in one store round
+  // trip, instead of one per device set.
+  std::vector<ncclUniqueId> ncclIDs(sets.size());
+  if (rank_ == 0) {
+    for (auto& ncclID : ncclIDs) {
+      C10D_NCCL_CHECK(ncclGetUniqueId(&ncclID));
+    }
+  }
+  broadcastUniqueNCCLIDs(&ncclIDs);
+
+  // Wrapping all creations in one group lets NCCL bootstrap the
+  // communicators together; the inner groups opened per device set nest
+  // inside this one and only the outermost end flushes.
+  C10D_NCCL_CHECK(ncclGroupStart());
+  for (size_t i = 0; i < sets.size(); ++i) {
+    createNCCLComm(keys[i], *sets[i], ncclIDs[i]);
+  }
+  C10D_NCCL_CHECK(ncclGroupEnd());
+}
+
+void ProcessGroupNCCL::initComms(const std::vector<at::Device>& devices) {
+  initComms(std::vector<std::vector<at::Device>>{devices});
+}
+
 namespace {
 
 // Check that all `tensors' have the same type and shape and are distributed
@@ -17,6 +17,14 @@ namespace c10d {
 // non-blocking.
 constexpr const char* NCCL_BLOCKING_WAIT = "NCCL_BLOCKING_WAIT";
 
+// Environment variable which controls whether the NCCL streams created for
+// each communicator come from the high priority CUDA stream pool. Running
+// collectives at elevated priority lets communication kernels preempt
+// compute kernels on the SMs, which improves compute/communication overlap
+// when collectives (e.g. DDP gradient bucket allreduces) are issued
+// concurrently with backward compute.
+constexpr const char* NCCL_HIGH_PRIORITY_STREAMS = "NCCL_HIGH_PRIORITY_STREAMS";
+
 // ProcessGroupNCCL implements NCCL bindings for c10d.
 //
 // All functions of the class are expected to be called in the same order
@@ -226,18 +234,45 @@ class ProcessGroupNCCL : public ProcessGroup {
       std::vector<at::Tensor>& tensors,
       int tag) override;
 
+  // Eagerly bootstraps the NCCL communicators for the given device sets,
+  // instead of paying the multi-second initialization cost when the first
+  // collective fires. Each inner vector is one device set exactly as it will
+  // later be passed to a collective (one communicator per device). The
+  // unique IDs of all sets are exchanged through a single store round trip
+  // and the communicators are created inside one NCCL group, so they
+  // bootstrap together rather than serially per device set.
+  //
+  // This is a collective call: every rank of the process group must invoke
+  // it with the same device sets in the same order. Device sets that already
+  // have communicators are skipped.
+  void initComms(const std::vector<std::vector<at::Device>>& deviceLists);
+
+  // Convenience overload for a single device set.
+  void initComms(const std::vector<at::Device>& devices);
+
   static const int64_t kProcessGroupNCCLOpTimeoutMillis;
 
  protected:
   // Helper that broadcasts nccl unique ID to all ranks through the store
   void broadcastUniqueNCCLID(ncclUniqueId* ncclID);
 
+  // Helper that broadcasts a batch of nccl unique IDs to all ranks through
+  // a single store entry (see initComms)
+  void broadcastUniqueNCCLIDs(std::vector<ncclUniqueId>* ncclIDs);
+
   // Helper that either looks up the cached NCCL communicators or creates
   // a new set of NCCL communicators as a cache entry
   std::vector<std::shared_ptr<NCCLComm>>& getNCCLComm(
       const std::string& devicesKey,
       const std::vector<at::Device>& devices);
 
+  // Helper that creates and caches the NCCL communicators (plus their
+  // streams and events) for one device set from an agreed-upon unique ID
+  std::vector<std::shared_ptr<NCCLComm>>& createNCCLComm(
+      const std::string& devicesKey,
+      const std::vector<at::Device>& devices,
+      const ncclUniqueId& ncclID);
+
   // Wrapper method which can be overridden for tests.
   virtual std::exception_ptr checkForNCCLErrors(
       const std::vector<std::shared_ptr<NCCLComm>>& ncclComms);
@@ -369,6 +404,10 @@ class ProcessGroupNCCL : public ProcessGroup {
   // for the operation to complete.
   bool blockingWait_ = false;
 
+  // Whether streams created for NCCL communicators are taken from the high
+  // priority CUDA stream pool.
+  bool isHighPriorityStream_ = false;
+
   // Timeout for operations. This is only used when blockingWait_ is enabled.
   std::chrono::milliseconds opTimeout_;
 
@@ -2,6 +2,10 @@
 
 #include <poll.h>
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 #include <unistd.h>
 #include <algorithm>
 #include <system_error>
@@ -267,6 +271,341 @@ bool TCPStoreDaemon::checkKeys(const std::vector<std::string>& keys) const {
   });
 }
 
+#ifdef __linux__
+
+// ShardedTCPStoreDaemon class methods
+ShardedTCPStoreDaemon::ShardedTCPStoreDaemon(
+    int storeListenSocket,
+    int numThreads)
+    : storeListenSocket_(storeListenSocket) {
+  if (numThreads < 1) {
+    throw std::runtime_error(
+        "ShardedTCPStoreDaemon needs at least one I/O thread");
+  }
+  // Use control pipe to signal instance destruction to all server threads.
+  if (pipe(controlPipeFd_.data()) == -1) {
+    throw std::runtime_error(
+        "Failed to create the control pipe to start the "
+        "ShardedTCPStoreDaemon run");
+  }
+  epollFds_.resize(numThreads);
+  for (int i = 0; i < numThreads; i++) {
+    epollFds_[i] = ::epoll_create1(0);
+    if (epollFds_[i] == -1) {
+      throw std::system_error(
+          errno, std::system_category(), "epoll_create1 failed");
+    }
+    // Every I/O thread also watches the read end of the control pipe so
+    // that closing the write end wakes all of them up for shutdown.
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = controlPipeFd_[0];
+    SYSCHECK_ERR_RETURN_NEG1(
+        ::epoll_ctl(epollFds_[i], EPOLL_CTL_ADD, controlPipeFd_[0], &ev));
+  }
+  for (int i = 0; i < numThreads; i++) {
+    ioThreads_.emplace_back(&ShardedTCPStoreDaemon::ioLoop, this, i);
+  }
+  acceptThread_ = std::thread(&ShardedTCPStoreDaemon::acceptLoop, this);
+}
+
+ShardedTCPStoreDaemon::~ShardedTCPStoreDaemon() {
+  stop();
+  join();
+  {
+    std::lock_guard<std::mutex> lock(socketsMutex_);
+    for (auto socket : sockets_) {
+      if (socket != -1) {
+        ::close(socket);
+      }
+    }
+  }
+  for (auto fd : epollFds_) {
+    ::close(fd);
+  }
+  for (auto fd : controlPipeFd_) {
+    if (fd != -1) {
+      ::close(fd);
+    }
+  }
+}
+
+void ShardedTCPStoreDaemon::join() {
+  if (acceptThread_.joinable()) {
+    acceptThread_.join();
+  }
+  for (auto& thread : ioThreads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+void ShardedTCPStoreDaemon::stop() {
+  if (controlPipeFd_[1] != -1) {
+    // close the write end of the pipe
+    ::close(controlPipeFd_[1]);
+    controlPipeFd_[1] = -1;
+  }
+}
+
+ShardedTCPStoreDaemon::Shard& ShardedTCPStoreDaemon::shardFor(
+    const std::string& key) {
+  return shards_[std::hash<std::string>{}(key) % kNumShards];
+}
+
+void ShardedTCPStoreDaemon::acceptLoop() {
+  std::vector<struct pollfd> fds;
+  fds.push_back({.fd = storeListenSocket_, .events = POLLIN});
+  // The read end of the pipe signals the stopping of the daemon.
+  fds.push_back({.fd = controlPipeFd_[0], .events = POLLHUP});
+
+  while (true) {
+    fds[0].revents = 0;
+    fds[1].revents = 0;
+
+    SYSCHECK_ERR_RETURN_NEG1(::poll(fds.data(), fds.size(), -1));
+
+    if (fds[1].revents != 0) {
+      // Will be POLLUP when the pipe is closed
+      if (fds[1].revents ^ POLLHUP) {
+        throw std::system_error(
+            ECONNABORTED,
+            std::system_category(),
+            "Unexpected poll revent on the control pipe's reading fd: " +
+                std::to_string(fds[1].revents));
+      }
+      break;
+    }
+    if (fds[0].revents != 0) {
+      if (fds[0].revents ^ POLLIN) {
+        throw std::system_error(
+            ECONNABORTED,
+            std::system_category(),
+            "Unexpected poll revent on the master's listening socket: " +
+                std::to_string(fds[0].revents));
+      }
+      int sockFd = std::get<0>(tcputil::accept(storeListenSocket_));
+      {
+        std::lock_guard<std::mutex> lock(socketsMutex_);
+        sockets_.push_back(sockFd);
+      }
+      // Hand the connection to one I/O thread for its entire lifetime so
+      // that queries on it are processed in order by a single thread.
+      struct epoll_event ev = {};
+      ev.events = EPOLLIN;
+      ev.data.fd = sockFd;
+      SYSCHECK_ERR_RETURN_NEG1(::epoll_ctl(
+          epollFds_[nextThread_++ % epollFds_.size()],
+          EPOLL_CTL_ADD,
+          sockFd,
+          &ev));
+    }
+  }
+}
+
+void ShardedTCPStoreDaemon::ioLoop(size_t threadIndex) {
+  std::array<struct epoll_event, 64> events;
+  while (true) {
+    int numEvents;
+    SYSCHECK_ERR_RETURN_NEG1(
+        numEvents = ::epoll_wait(
+            epollFds_[threadIndex], events.data(), events.size(), -1));
+    for (int i = 0; i < numEvents; i++) {
+      if (events[i].data.fd == controlPipeFd_[0]) {
+        // The write end of the control pipe was closed; shut down.
+        return;
+      }
+      try {
+        query(events[i].data.fd);
+      } catch (...) {
+        // See the corresponding comment in TCPStoreDaemon::run. Closing
+        // the socket also removes it from this thread's epoll set.
+        removeSocket(events[i].data.fd);
+        ::close(events[i].data.fd);
+        std::lock_guard<std::mutex> lock(socketsMutex_);
+        sockets_.erase(
+            std::remove(sockets_.begin(), sockets_.end(), events[i].data.fd),
+            sockets_.end());
+      }
+    }
+  }
+}
+
+void ShardedTCPStoreDaemon::query(int socket) {
+  QueryType qt;
+  tcputil::recvBytes<QueryType>(socket, &qt, 1);
+
+  if (qt == QueryType::SET) {
+    setHandler(socket);
+
+  } else if (qt == QueryType::ADD) {
+    addHandler(socket);
+
+  } else if (qt == QueryType::GET) {
+    getHandler(socket);
+
+  } else if (qt == QueryType::CHECK) {
+    checkHandler(socket);
+
+  } else if (qt == QueryType::WAIT) {
+    waitHandler(socket);
+
+  } else {
+    throw std::runtime_error("Unexpected query type");
+  }
+}
+
+void ShardedTCPStoreDaemon::notifySockets(const std::vector<int>& sockets) {
+  std::vector<int> ready;
+  {
+    std::lock_guard<std::mutex> lock(waitMutex_);
+    for (int socket : sockets) {
+      auto it = keysAwaited_.find(socket);
+      if (it == keysAwaited_.end()) {
+        // The socket disconnected while waiting.
+        continue;
+      }
+      if (--it->second == 0) {
+        keysAwaited_.erase(it);
+        ready.push_back(socket);
+      }
+    }
+  }
+  for (int socket : ready) {
+    try {
+      tcputil::sendValue<WaitResponseType>(
+          socket, WaitResponseType::STOP_WAITING);
+    } catch (...) {
+      // The waiter went away; its owning I/O thread will clean it up.
+    }
+  }
+}
+
+void ShardedTCPStoreDaemon::removeSocket(int socket) {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto it = shard.waitingSockets.begin();
+         it != shard.waitingSockets.end();) {
+      auto& waiters = it->second;
+      waiters.erase(
+          std::remove(waiters.begin(), waiters.end(), socket), waiters.end());
+      if (waiters.empty()) {
+        it = shard.waitingSockets.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lock(waitMutex_);
+  keysAwaited_.erase(socket);
+}
+
+void ShardedTCPStoreDaemon::setHandler(int socket) {
+  std::string key = tcputil::recvString(socket);
+  auto value = tcputil::recvVector<uint8_t>(socket);
+  auto& shard = shardFor(key);
+  std::vector<int> waiters;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.data[key] = std::move(value);
+    auto it = shard.waitingSockets.find(key);
+    if (it != shard.waitingSockets.end()) {
+      waiters = std::move(it->second);
+      shard.waitingSockets.erase(it);
+    }
+  }
+  // On "set", wake up all clients that have been waiting
+  notifySockets(waiters);
+}
+
+void ShardedTCPStoreDaemon::addHandler(int socket) {
+  std::string key = tcputil::recvString(socket);
+  int64_t addVal = tcputil::recvValue<int64_t>(socket);
+
+  auto& shard = shardFor(key);
+  std::vector<int> waiters;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto dataIt = shard.data.find(key);
+    if (dataIt != shard.data.end()) {
+      auto buf = reinterpret_cast<const char*>(dataIt->second.data());
+      auto len = dataIt->second.size();
+      addVal += std::stoll(std::string(buf, len));
+    }
+    auto addValStr = std::to_string(addVal);
+    shard.data[key] = std::vector<uint8_t>(addValStr.begin(), addValStr.end());
+    auto it = shard.waitingSockets.find(key);
+    if (it != shard.waitingSockets.end()) {
+      waiters = std::move(it->second);
+      shard.waitingSockets.erase(it);
+    }
+  }
+  // Now send the new value
+  tcputil::sendValue<int64_t>(socket, addVal);
+  // On "add", wake up all clients that have been waiting
+  notifySockets(waiters);
+}
+
+void ShardedTCPStoreDaemon::getHandler(int socket) {
+  std::string key = tcputil::recvString(socket);
+  std::vector<uint8_t> data;
+  {
+    auto& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    data = shard.data.at(key);
+  }
+  tcputil::sendVector<uint8_t>(socket, data);
+}
+
+void ShardedTCPStoreDaemon::checkHandler(int socket) {
+  SizeType nargs;
+  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
+  bool ready = true;
+  for (size_t i = 0; i < nargs; i++) {
+    std::string key = tcputil::recvString(socket);
+    auto& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    ready = ready && shard.data.count(key) > 0;
+  }
+  if (ready) {
+    tcputil::sendValue<CheckResponseType>(socket, CheckResponseType::READY);
+  } else {
+    tcputil::sendValue<CheckResponseType>(socket, CheckResponseType::NOT_READY);
+  }
+}
+
+void ShardedTCPStoreDaemon::waitHandler(int socket) {
+  SizeType nargs;
+  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
+  std::vector<std::string> keys(nargs);
+  for (size_t i = 0; i < nargs; i++) {
+    keys[i] = tcputil::recvString(socket);
+  }
+  // Publish the awaited count before registering with any shard: a setter
+  // that finds this socket registered must find the count as well, or its
+  // wakeup would be lost.
+  {
+    std::lock_guard<std::mutex> lock(waitMutex_);
+    keysAwaited_[socket] = keys.size();
+  }
+  // Keys that are already present count as immediately notified; the
+  // decrement happens through the same path a setter would take.
+  std::vector<int> selfNotifications;
+  for (auto& key : keys) {
+    auto& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.data.count(key) > 0) {
+      selfNotifications.push_back(socket);
+    } else {
+      shard.waitingSockets[key].push_back(socket);
+    }
+  }
+  notifySockets(selfNotifications);
+}
+
+#endif // __linux__
+
 // TCPStore class methods
 TCPStore::TCPStore(
     const std::string& masterAddr,
@@ -274,7 +613,8 @@ TCPStore::TCPStore(
     int numWorkers,
     bool isServer,
     const std::chrono::milliseconds& timeout,
-    bool waitWorkers)
+    bool waitWorkers,
+    int numServerThreads)
     : Store(timeout),
       isServer_(isServer),
       tcpStoreAddr_(masterAddr),
@@ -286,8 +626,18 @@ TCPStore::TCPStore(
     // Opening up the listening socket
     std::tie(masterListenSocket_, tcpStorePort_) = tcputil::listen(masterPort);
     // Now start the daemon
-    tcpStoreDaemon_ = std::unique_ptr<TCPStoreDaemon>(
-        new TCPStoreDaemon(masterListenSocket_));
+#ifdef __linux__
+    if (numServerThreads > 1) {
+      tcpStoreDaemon_ = std::unique_ptr<StoreDaemon>(
+          new ShardedTCPStoreDaemon(masterListenSocket_, numServerThreads));
+    }
+#endif
+    if (!tcpStoreDaemon_) {
+      // Either a single server thread was requested or the sharded daemon
+      // is not available on this platform.
+      tcpStoreDaemon_ = std::unique_ptr<StoreDaemon>(
+          new TCPStoreDaemon(masterListenSocket_));
+    }
   }
   // Connect to the daemon
   storeSocket_ = tcputil::connect(
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 
@@ -9,12 +11,21 @@
 
 namespace c10d {
 
-class TCPStoreDaemon {
+// Lifetime interface shared by the store daemon implementations below.
+// The server-side TCPStore owns its daemon through this interface.
+class StoreDaemon {
+ public:
+  virtual ~StoreDaemon() = default;
+
+  virtual void join() = 0;
+};
+
+class TCPStoreDaemon : public StoreDaemon {
  public:
   explicit TCPStoreDaemon(int storeListenSocket);
-  ~TCPStoreDaemon();
+  ~TCPStoreDaemon() override;
 
-  void join();
+  void join() override;
 
  protected:
   void run();
@@ -43,6 +54,77 @@ class TCPStoreDaemon {
   std::vector<int> controlPipeFd_{-1, -1};
 };
 
+#ifdef __linux__
+
+// Multi-threaded store daemon for large-scale rendezvous. A single
+// accept thread hands incoming connections out round-robin to a pool of
+// epoll-driven I/O threads, so each connection is serviced by exactly one
+// thread and queries on a connection stay ordered. The key space is
+// sharded with one lock per shard, so set/get/add traffic on unrelated
+// keys proceeds in parallel instead of funneling through one loop.
+// Wait notifications are collected under the shard lock and sent in a
+// batch after it is released.
+//
+// The wire protocol is identical to TCPStoreDaemon's, so clients cannot
+// tell the two servers apart.
+class ShardedTCPStoreDaemon : public StoreDaemon {
+ public:
+  ShardedTCPStoreDaemon(int storeListenSocket, int numThreads);
+  ~ShardedTCPStoreDaemon() override;
+
+  void join() override;
+
+ protected:
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::vector<uint8_t>> data;
+    // From key -> the list of sockets waiting on it
+    std::unordered_map<std::string, std::vector<int>> waitingSockets;
+  };
+
+  Shard& shardFor(const std::string& key);
+
+  void acceptLoop();
+  void ioLoop(size_t threadIndex);
+  void stop();
+
+  void query(int socket);
+
+  void setHandler(int socket);
+  void addHandler(int socket);
+  void getHandler(int socket);
+  void checkHandler(int socket);
+  void waitHandler(int socket);
+
+  // Decrements the awaited key count of every socket in `sockets` and
+  // sends STOP_WAITING to those that reached zero.
+  void notifySockets(const std::vector<int>& sockets);
+  // Drops all wait bookkeeping for a disconnected socket.
+  void removeSocket(int socket);
+
+  std::array<Shard, kNumShards> shards_;
+
+  // Guards keysAwaited_. Always acquired after a shard mutex, never before.
+  std::mutex waitMutex_;
+  // From socket -> number of keys awaited
+  std::unordered_map<int, size_t> keysAwaited_;
+
+  std::thread acceptThread_;
+  std::vector<std::thread> ioThreads_;
+  std::vector<int> epollFds_;
+  size_t nextThread_ = 0;
+
+  std::mutex socketsMutex_;
+  std::vector<int> sockets_;
+
+  int storeListenSocket_;
+  std::vector<int> controlPipeFd_{-1, -1};
+};
+
+#endif // __linux__
+
 class TCPStore : public Store {
  public:
   explicit TCPStore(
@@ -51,7 +133,8 @@ class TCPStore : public Store {
       int numWorkers,
       bool isServer = false,
       const std::chrono::milliseconds& timeout = kDefaultTimeout,
-      bool waitWorkers = true);
+      bool waitWorkers = true,
+      int numServerThreads = 1);
 
   virtual ~TCPStore();
 
@@ -93,8 +176,10 @@ class TCPStore : public Store {
   const std::string initKey_;
   const std::string regularPrefix_;
 
-  // Only needs to be launched as the server
-  std::unique_ptr<TCPStoreDaemon> tcpStoreDaemon_ = nullptr;
+  // Only needs to be launched as the server. With `numServerThreads > 1`
+  // this holds a ShardedTCPStoreDaemon on Linux; otherwise the
+  // single-threaded TCPStoreDaemon.
+  std::unique_ptr<StoreDaemon> tcpStoreDaemon_ = nullptr;
 };
 
 } // namespace c10d
@@ -3,6 +3,7 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <iostream>
 #include <mutex>
@@ -190,6 +191,93 @@ void testAllreduce(const std::string& path, const at::DeviceType b) {
   }
 }
 
+void testAllreduceFutures(const std::string& path) {
+  const auto size = 4;
+  auto tests = CollectiveTest::initialize(path, size);
+
+  // Generate inputs
+  std::vector<std::vector<at::Tensor>> inputs(size);
+  for (auto i = 0; i < size; i++) {
+    auto tensor = at::ones({16, 16}) * i;
+    inputs[i] = std::vector<at::Tensor>({tensor});
+  }
+
+  // Kick off work, register completion callbacks, and block on the
+  // futures instead of the work objects.
+  std::atomic<int> callbackCount(0);
+  std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>> work(size);
+  std::vector<c10::intrusive_ptr<c10::ivalue::Future>> futures(size);
+  for (auto i = 0; i < size; i++) {
+    work[i] = tests[i].getProcessGroup().allreduce(inputs[i]);
+    work[i]->addCallback([&callbackCount] { callbackCount++; });
+    futures[i] = work[i]->getFuture();
+  }
+  for (auto i = 0; i < size; i++) {
+    futures[i]->wait();
+    // The future resolving implies the work completed.
+    EXPECT_TRUE(work[i]->isCompleted());
+    EXPECT_TRUE(work[i]->isSuccess());
+  }
+  EXPECT_EQ(callbackCount.load(), size);
+
+  // Verify outputs
+  const auto expected = (size * (size - 1)) / 2;
+  auto outputs = copyTensors(inputs);
+  for (auto i = 0; i < size; i++) {
+    auto& tensor = outputs[i][0];
+    auto data = tensor.data_ptr<float>();
+    for (auto j = 0; j < tensor.numel(); j++) {
+      EXPECT_EQ(data[j], expected);
+    }
+  }
+}
+
+void testCoalescedAllreduce(const std::string& path) {
+  const auto size = 4;
+  const auto numTensors = 8;
+  auto tests = CollectiveTest::initialize(path, size);
+
+  // Many small tensors per rank, mixed dtypes so the scope has to build one
+  // flat collective per dtype group.
+  std::vector<std::vector<at::Tensor>> inputs(size);
+  for (auto i = 0; i < size; i++) {
+    for (auto j = 0; j < numTensors; j++) {
+      auto dtype = (j % 2 == 0) ? at::kFloat : at::kDouble;
+      inputs[i].push_back(at::ones({4, 4}, dtype) * (i + j));
+    }
+  }
+
+  std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>> work(size);
+  for (auto i = 0; i < size; i++) {
+    auto& pg = tests[i].getProcessGroup();
+    pg.start_coalescing();
+    std::shared_ptr<::c10d::ProcessGroup::Work> captured;
+    for (auto j = 0; j < numTensors; j++) {
+      std::vector<at::Tensor> one = {inputs[i][j]};
+      captured = pg.coalesced_allreduce(one);
+    }
+    work[i] = pg.end_coalescing();
+    // every captured call hands back the scope's shared handle
+    EXPECT_EQ(captured, work[i]);
+  }
+  for (auto i = 0; i < size; i++) {
+    work[i]->wait();
+  }
+
+  // Element j on every rank held (i + j), so the allreduced value is
+  // sum_i(i) + size * j.
+  for (auto i = 0; i < size; i++) {
+    for (auto j = 0; j < numTensors; j++) {
+      const auto expected = size * (size - 1) / 2 + size * j;
+      auto tensor = inputs[i][j].cpu().to(at::kDouble);
+      auto data = tensor.data_ptr<double>();
+      for (auto k = 0; k < tensor.numel(); k++) {
+        EXPECT_EQ(data[k], expected);
+      }
+    }
+  }
+}
+
 void testBroadcast(const std::string& path, const at::DeviceType b) {
   const auto size = 2;
   const auto stride = 2;
@@ -382,6 +470,20 @@ TEST(ProcessGroupGlooTest, testAllReduceCPU) {
   }
 }
 
+TEST(ProcessGroupGlooTest, testAllReduceFutures) {
+  {
+    TemporaryFile file;
+    testAllreduceFutures(file.path);
+  }
+}
+
+TEST(ProcessGroupGlooTest, testCoalescedAllreduce) {
+  {
+    TemporaryFile file;
+    testCoalescedAllreduce(file.path);
+  }
+}
+
 TEST(ProcessGroupGlooTest, testBroadcastCPU) {
   {
     TemporaryFile file;
@@ -10,7 +10,7 @@
 #include <c10d/TCPStore.hpp>
 
 // Different ports for different tests.
-void testHelper(const std::string& prefix = "") {
+void testHelper(const std::string& prefix = "", int numServerThreads = 1) {
   const auto numThreads = 16;
   const auto numWorkers = numThreads + 1;
 
@@ -20,7 +20,8 @@ void testHelper(const std::string& prefix = "") {
       numWorkers,
       true,
       std::chrono::seconds(30),
-      /* wait */ false);
+      /* wait */ false,
+      numServerThreads);
 
   auto serverStore =
       std::make_unique<c10d::PrefixStore>(prefix, serverTCPStore);
@@ -116,3 +117,13 @@ TEST(TCPStoreTest, testHelper) {
 TEST(TCPStoreTest, testHelperPrefix) {
   testHelper("testPrefix");
 }
+
+#ifdef __linux__
+TEST(TCPStoreTest, testHelperSharded) {
+  testHelper("", /* numServerThreads */ 4);
+}
+
+TEST(TCPStoreTest, testHelperShardedPrefix) {
+  testHelper("testPrefix", /* numServerThreads */ 4);
+}
+#endif
@@ -309,12 +309,13 @@ class MinMaxObserver(_ObserverBase):
         x = x_orig.detach()  # avoid keeping autograd tape
         min_val = self.min_val
         max_val = self.max_val
+        x_min, x_max = torch._min_max(x)
         if min_val.numel() == 0 or max_val.numel() == 0:
-            min_val = torch.min(x)
-            max_val = torch.max(x)
+            min_val = x_min
+            max_val = x_max
         else:
-            min_val = torch.min(torch.min(x), min_val)
-            max_val = torch.max(torch.max(x), max_val)
+            min_val = torch.min(x_min, min_val)
+            max_val = torch.max(x_max, max_val)
         self.min_val = min_val
         self.max_val = max_val
         return x_orig
@@ -400,12 +401,13 @@ class MovingAverageMinMaxObserver(MinMaxObserver):
         x = x_orig.detach()  # avoid keeping autograd tape
         min_val = self.min_val
         max_val = self.max_val
+        x_min, x_max = torch._min_max(x)
         if min_val.numel() == 0 or max_val.numel() == 0:
-            min_val = torch.min(x)
-            max_val = torch.max(x)
+            min_val = x_min
+            max_val = x_max
         else:
-            min_val = min_val + self.averaging_constant * (torch.min(x) - min_val)
-            max_val = max_val + self.averaging_constant * (torch.max(x) - max_val)
+            min_val = min_val + self.averaging_constant * (x_min - min_val)
+            max_val = max_val + self.averaging_constant * (x_max - max_val)
         self.min_val = min_val
         self.max_val = max_val
         return x_orig
@@ -777,11 +779,11 @@ class HistogramObserver(_ObserverBase):
         min_val = self.min_val
         max_val = self.max_val
         if min_val.numel() == 0 or max_val.numel() == 0:
-            min_val = torch.min(x)
-            max_val = torch.max(x)
+            # fused single-pass min/max + parallel histogram
+            histogram, min_val, max_val = torch._histc_with_min_max(x, self.bins)
             self.min_val = min_val
             self.max_val = max_val
-            self.histogram = torch.histc(x, self.bins, min=min_val, max=max_val)
+            self.histogram = histogram
         else:
             new_min = torch.min(x)
             new_max = torch.max(x)
@@ -792,10 +794,14 @@ class HistogramObserver(_ObserverBase):
             # and then downsampling the histogram efficiently
             combined_min, combined_max, downsample_rate, start_idx = \
                 self._adjust_min_max(combined_min, combined_max, self.upsample_rate)
-            combined_histogram = torch.histc(x, self.bins, min=combined_min, max=combined_max)
             if combined_min == min_val and combined_max == max_val:
-                combined_histogram += self.histogram
+                # common case: the range did not grow, so the bin grid is
+                # unchanged and the new observations can be accumulated into
+                # the running histogram in place
+                torch._histc_add_(self.histogram, x, combined_min, combined_max)
             else:
+                combined_histogram = torch._histc_add_(
+                    torch.zeros_like(self.histogram), x, combined_min, combined_max)
                 combined_histogram = self._combine_histograms(
                     combined_histogram,
                     self.histogram,
@@ -803,8 +809,7 @@ class HistogramObserver(_ObserverBase):
                     downsample_rate,
                     start_idx,
                     self.bins)
-
-            self.histogram = combined_histogram
+                self.histogram = combined_histogram
             self.min_val = combined_min
             self.max_val = combined_max
         return x
@@ -199,3 +199,55 @@ class DistOptimizerTest(RpcAgentTestFixture):
             # ensure local equals remote
             self.assertEqual(new_w1, module1.get_w())
             self.assertEqual(new_w2, module2.get_w())
+
+    @dist_init()
+    def test_dist_optim_state_dict(self):
+        owner1 = "worker%d" % ((self.rank + 1) % self.world_size)
+        owner2 = "worker%d" % ((self.rank + 2) % self.world_size)
+
+        remote_module1 = rpc.remote(owner1, MyModule)
+        remote_module2 = rpc.remote(owner2, MyModule)
+        remote_param1 = remote_method(MyModule.get_w, remote_module1)
+        remote_param2 = remote_method(MyModule.get_w, remote_module2)
+
+        # momentum gives each worker non-trivial optimizer state
+        dist_optim = DistributedOptimizer(
+            optim.SGD, [remote_param1, remote_param2], lr=0.05, momentum=0.9
+        )
+
+        def run_step():
+            with dist_autograd.context() as context_id:
+                torch.manual_seed(0)
+                t1 = torch.rand((3, 3), requires_grad=True)
+                t2 = torch.rand((3, 3), requires_grad=True)
+                output1 = rpc_async_method(MyModule.forward, remote_module1, t2)
+                output2 = rpc_async_method(
+                    MyModule.forward, remote_module2, output1.wait()
+                )
+                loss = torch.add(output2.wait(), t1)
+                dist_autograd.backward(context_id, [loss.sum()])
+                dist_optim.step(context_id)
+
+        def momentum_buffer(state, owner):
+            return list(state[owner]["state"].values())[0]["momentum_buffer"]
+
+        run_step()
+        state1 = dist_optim.state_dict()
+        self.assertEqual(sorted(state1.keys()), sorted([owner1, owner2]))
+        for local_state in state1.values():
+            self.assertIn("state", local_state)
+            self.assertIn("param_groups", local_state)
+
+        # a second checkpoint with no step in between travels as a pure
+        # delta and must reassemble to the same state
+        self.assertEqual(state1, dist_optim.state_dict())
+
+        run_step()
+        state2 = dist_optim.state_dict()
+        self.assertNotEqual(
+            momentum_buffer(state1, owner1), momentum_buffer(state2, owner1)
+        )
+
+        # restore the first checkpoint; a fresh checkpoint must match it
+        dist_optim.load_state_dict(state1)
+        self.assertEqual(state1, dist_optim.state_dict())
@@ -1,4 +1,5 @@
 import concurrent.futures
+import json
 import sys
 import time
 import unittest
@@ -13,7 +14,7 @@ import torch.testing._internal.dist_utils as dist_utils
 from torch.distributed.rpc import RRef, _get_debug_info, _rref_context_get_debug_info
 from torch.distributed.rpc.api import _use_rpc_pickler
 from torch.distributed.rpc.internal import PythonUDF, RPCExecMode, _internal_rpc_pickler
-from torch.testing._internal.common_utils import IS_MACOS, load_tests
+from torch.testing._internal.common_utils import IS_MACOS, TemporaryFileName, load_tests
 from torch.testing._internal.dist_utils import (
     dist_init,
     get_shutdown_error_regex,
@@ -679,6 +680,36 @@ class RpcTest(RpcAgentTestFixture):
             RPCExecMode.ASYNC, torch.add, args=(torch.ones(1), torch.ones(1))
         )
 
+    @dist_init
+    def test_distributed_profiler(self):
+        from torch.distributed.rpc import profiler as rpc_profiler
+
+        # only rank 0 coordinates; the other ranks serve RPCs.
+        if self.rank == 0:
+            dst = "worker{}".format((self.rank + 1) % self.world_size)
+            with rpc_profiler.profile() as prof:
+                rpc.rpc_sync(dst, torch.add, args=(torch.ones(2), torch.ones(2)))
+            events = prof.function_events
+
+            # the remote execution of add shows up under the dst worker's name
+            remote_adds = [e for e in events if e.name == "{}/add".format(dst)]
+            self.assertTrue(len(remote_adds) >= 1)
+            # remote timestamps were rebased onto the local profiler clock
+            remote_add = remote_adds[0]
+            self.assertTrue(remote_add.cpu_interval.end > remote_add.cpu_interval.start)
+            # local events are present unprefixed, clock markers are dropped,
+            # and every merged event has an integer thread id
+            self.assertTrue(any("/" not in e.name for e in events))
+            self.assertTrue(
+                all(rpc_profiler._MARKER_NAME not in e.name for e in events)
+            )
+            self.assertTrue(all(isinstance(e.thread, int) for e in events))
+
+            with TemporaryFileName() as fname:
+                prof.export_chrome_trace(fname)
+                with open(fname) as f:
+                    json.load(f)
+
     @dist_init
     def test_profiler_with_remote_udf(self):
         self._profiler_test_with_rpc(RPCExecMode.REMOTE, my_sleep_func, args=(1,))
@@ -8,10 +8,11 @@ static methods.
 import torch
 from torch._six import queue, container_abcs, string_classes
 from . import MP_STATUS_CHECK_INTERVAL
+from . import shm_transport
 from torch._utils import ExceptionWrapper
 
 
-def _pin_memory_loop(in_queue, out_queue, device_id, done_event):
+def _pin_memory_loop(in_queue, out_queue, device_id, done_event, shm_rings=None):
     # This setting is thread local, and prevents the copy in pin_memory from
     # consuming all CPU cores.
     torch.set_num_threads(1)
@@ -26,6 +27,11 @@ def _pin_memory_loop(in_queue, out_queue, device_id, done_event):
         except queue.Empty:
             continue
         idx, data = r
+        if shm_rings is not None and isinstance(data, shm_transport._ShmBatch):
+            # Rebuild the batch over the ring slot before pinning; the slot
+            # is recycled once the wrapped tensors (and hence their pinned
+            # copies' sources) are collected.
+            data = shm_rings[data.worker_id].wrap(data)
         if not done_event.is_set() and not isinstance(data, ExceptionWrapper):
             try:
                 data = pin_memory(data)
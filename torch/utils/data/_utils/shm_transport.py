@@ -0,0 +1,234 @@
+r"""Shared-memory ring transport for worker-to-main batch handoff.
+
+The regular worker path pickles every batch through the result queue, which
+allocates a fresh shared-memory segment per tensor and passes a file
+descriptor for each one. The ring transport instead gives every worker a
+fixed arena, allocated by the main process before the workers fork, that is
+divided into equally sized slots:
+
+  * flow control is credit based: a queue of free slot indices is the credit
+    channel. The worker takes a slot index before writing; the main process
+    returns it once every tensor wrapped over the slot has been garbage
+    collected.
+  * the worker copies batch tensors into its slot (its only copy); the main
+    process wraps tensors directly over the arena memory, so there is no
+    receive-side copy and no per-batch segment allocation or fd transfer.
+  * batches that do not fit in a slot, contain non-CPU/sparse/quantized
+    tensors, or arrive when no credit is available fall back to the regular
+    queue path, so the transport is never required for progress.
+
+Because wrapped tensors alias ring memory, a slot is recycled only when all
+tensors wrapped over it are dead. Holding on to a *view* of a yielded batch
+without holding the batch itself can therefore let the slot be reused under
+the view; clone tensors that must outlive the iteration step.
+"""
+
+import weakref
+
+import torch
+from torch._six import queue, container_abcs, string_classes
+
+# Slot layout is aligned generously so every dtype's element size divides
+# the offsets and wrapped rows start on cache-line boundaries.
+_ALIGNMENT = 64
+
+DEFAULT_NUM_SLOTS = 4
+DEFAULT_SLOT_BYTES = 64 * 1024 * 1024
+
+
+class _Ineligible(Exception):
+    pass
+
+
+class _TensorPlaceholder(object):
+    r"""Marks where the i-th flattened tensor goes in the batch structure."""
+    __slots__ = ['index']
+
+    def __init__(self, index):
+        self.index = index
+
+    def __getstate__(self):
+        return self.index
+
+    def __setstate__(self, state):
+        self.index = state
+
+
+class _ShmBatch(object):
+    r"""Queue message describing a batch that lives in a ring slot."""
+    __slots__ = ['worker_id', 'slot', 'layout', 'spec']
+
+    def __init__(self, worker_id, slot, layout, spec):
+        self.worker_id = worker_id
+        self.slot = slot
+        # layout: one (dtype, sizes, byte offset within the slot) per tensor
+        self.layout = layout
+        self.spec = spec
+
+    def __getstate__(self):
+        return (self.worker_id, self.slot, self.layout, self.spec)
+
+    def __setstate__(self, state):
+        self.worker_id, self.slot, self.layout, self.spec = state
+
+
+def _flatten(data):
+    r"""Splits a batch into its tensors and a structure with placeholders.
+
+    Returns ``(None, None)`` when the batch contains tensors the ring cannot
+    carry (CUDA, sparse, quantized, or autograd-connected ones). Non-tensor
+    leaves stay embedded in the structure and ride through the queue as
+    usual.
+    """
+    flat = []
+
+    def walk(d):
+        if isinstance(d, torch.Tensor):
+            if (d.is_cuda or d.is_sparse or getattr(d, 'is_quantized', False)
+                    or d.requires_grad):
+                raise _Ineligible
+            flat.append(d)
+            return _TensorPlaceholder(len(flat) - 1)
+        if isinstance(d, string_classes):
+            return d
+        if isinstance(d, container_abcs.Mapping):
+            return {k: walk(v) for k, v in d.items()}
+        if isinstance(d, tuple) and hasattr(d, '_fields'):  # namedtuple
+            return type(d)(*(walk(v) for v in d))
+        if isinstance(d, container_abcs.Sequence):
+            return [walk(v) for v in d]
+        return d
+
+    try:
+        spec = walk(data)
+    except _Ineligible:
+        return None, None
+    return flat, spec
+
+
+def _unflatten(tensors, spec):
+    if isinstance(spec, _TensorPlaceholder):
+        return tensors[spec.index]
+    if isinstance(spec, string_classes):
+        return spec
+    if isinstance(spec, container_abcs.Mapping):
+        return {k: _unflatten(tensors, v) for k, v in spec.items()}
+    if isinstance(spec, tuple) and hasattr(spec, '_fields'):  # namedtuple
+        return type(spec)(*(_unflatten(tensors, v) for v in spec))
+    if isinstance(spec, container_abcs.Sequence):
+        return [_unflatten(tensors, v) for v in spec]
+    return spec
+
+
+def _contiguous_strides(sizes):
+    strides = [1] * len(sizes)
+    for i in range(len(sizes) - 2, -1, -1):
+        strides[i] = strides[i + 1] * sizes[i + 1]
+    return strides
+
+
+def _align(offset):
+    return (offset + _ALIGNMENT - 1) & ~(_ALIGNMENT - 1)
+
+
+class ShmRing(object):
+    r"""One worker's share of the transport: an arena plus its credits.
+
+    Created in the main process before the worker forks; the arena storage
+    and the free-slot queue are inherited (or fd-shared under spawn) so both
+    sides address the same pages. The worker is the only producer and the
+    main process the only consumer, so slot indices are the entire protocol.
+    """
+
+    def __init__(self, worker_id, num_slots, slot_size, multiprocessing_context):
+        self.worker_id = worker_id
+        self._num_slots = num_slots
+        self._slot_size = _align(slot_size)
+        self._arena = torch.ByteStorage._new_shared(num_slots * self._slot_size)
+        self._free_slots = multiprocessing_context.Queue()
+        # Never block interpreter exit on unflushed credits.
+        self._free_slots.cancel_join_thread()
+        for slot in range(num_slots):
+            self._free_slots.put(slot)
+        # per-process cache of typed storages aliasing the arena
+        self._typed = {}
+
+    def __getstate__(self):
+        return (self.worker_id, self._num_slots, self._slot_size,
+                self._arena, self._free_slots)
+
+    def __setstate__(self, state):
+        (self.worker_id, self._num_slots, self._slot_size,
+         self._arena, self._free_slots) = state
+        self._typed = {}
+
+    def _typed_storage(self, dtype):
+        # Maps the arena's shm fd again under the requested dtype, so any
+        # tensor can be wrapped over arena bytes without a copy.
+        storage = self._typed.get(dtype)
+        if storage is None:
+            example = torch.empty(0, dtype=dtype)
+            fd, _ = self._arena._share_fd_()
+            storage = type(example.storage())._new_shared_fd(
+                fd, self._arena.size() // example.element_size())
+            self._typed[dtype] = storage
+        return storage
+
+    def _wrap_slot_tensor(self, dtype, sizes, byte_offset):
+        t = torch.empty(0, dtype=dtype)
+        t.set_(self._typed_storage(dtype),
+               byte_offset // t.element_size(),
+               sizes,
+               _contiguous_strides(sizes))
+        return t
+
+    def try_put(self, data):
+        r"""Worker side: stages ``data`` in a free slot.
+
+        Returns the ``_ShmBatch`` message to send instead of the batch, or
+        ``None`` when the batch is ineligible, does not fit, or no credit is
+        immediately available (the caller then uses the regular queue path).
+        """
+        flat, spec = _flatten(data)
+        if flat is None or len(flat) == 0:
+            return None
+        layout = []
+        offset = 0
+        for t in flat:
+            offset = _align(offset)
+            layout.append((t.dtype, list(t.size()), offset))
+            offset += t.numel() * t.element_size()
+        if offset > self._slot_size:
+            return None
+        try:
+            slot = self._free_slots.get_nowait()
+        except queue.Empty:
+            return None
+        base = slot * self._slot_size
+        for t, (dtype, sizes, byte_offset) in zip(flat, layout):
+            self._wrap_slot_tensor(dtype, sizes, base + byte_offset).copy_(t)
+        return _ShmBatch(self.worker_id, slot, layout, spec)
+
+    def wrap(self, msg):
+        r"""Main side: rebuilds the batch as views over the slot memory.
+
+        The slot's credit is returned when every wrapped tensor has been
+        garbage collected.
+        """
+        base = msg.slot * self._slot_size
+        tensors = [
+            self._wrap_slot_tensor(dtype, sizes, base + byte_offset)
+            for dtype, sizes, byte_offset in msg.layout
+        ]
+        state = {'remaining': len(tensors)}
+        free_slots = self._free_slots
+        slot = msg.slot
+
+        def release_credit():
+            state['remaining'] -= 1
+            if state['remaining'] == 0:
+                free_slots.put(slot)
+
+        for t in tensors:
+            weakref.finalize(t, release_credit)
+        return _unflatten(tensors, msg.spec)
@@ -106,7 +106,7 @@ _IterableDatasetStopIteration = namedtuple('_IterableDatasetStopIteration', ['wo
 
 def _worker_loop(dataset_kind, dataset, index_queue, data_queue, done_event,
                  auto_collation, collate_fn, drop_last, seed, init_fn, worker_id,
-                 num_workers):
+                 num_workers, shm_ring=None):
     # See NOTE [ Data Loader Multiprocessing Shutdown Logic ] for details on the
     # logic of this function.
 
@@ -189,6 +189,14 @@ def _worker_loop(dataset_kind, dataset, index_queue, data_queue, done_event,
                         # See NOTE [ Python Traceback Reference Cycle Problem ]
                         data = ExceptionWrapper(
                             where="in DataLoader worker process {}".format(worker_id))
+            if shm_ring is not None and not isinstance(
+                    data, (ExceptionWrapper, _IterableDatasetStopIteration)):
+                # Stage the batch in the shared-memory ring when a slot is
+                # free and the batch fits; otherwise the batch goes through
+                # the queue as usual.
+                shm_data = shm_ring.try_put(data)
+                if shm_data is not None:
+                    data = shm_data
             data_queue.put((idx, data))
             del data, idx, index, r  # save memory
     except KeyboardInterrupt:
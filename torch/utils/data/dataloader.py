@@ -98,6 +98,13 @@ class DataLoader(object):
         worker_init_fn (callable, optional): If not ``None``, this will be called on each
             worker subprocess with the worker id (an int in ``[0, num_workers - 1]``) as
             input, after seeding and before data loading. (default: ``None``)
+        shm_transport (bool, optional): If ``True``, worker processes hand
+            batches of CPU tensors to the main process through fixed
+            shared-memory ring buffers instead of allocating a fresh shared
+            segment per batch, removing the receive-side copy and per-batch
+            fd transfer. Batches that do not fit a ring slot or contain
+            non-CPU tensors silently use the regular path. Only meaningful
+            with ``num_workers > 0``. (default: ``False``)
 
 
     .. warning:: If the ``spawn`` start method is used, :attr:`worker_init_fn`
@@ -120,7 +127,8 @@ class DataLoader(object):
     def __init__(self, dataset, batch_size=1, shuffle=False, sampler=None,
                  batch_sampler=None, num_workers=0, collate_fn=None,
                  pin_memory=False, drop_last=False, timeout=0,
-                 worker_init_fn=None, multiprocessing_context=None):
+                 worker_init_fn=None, multiprocessing_context=None,
+                 shm_transport=False):
         torch._C._log_api_usage_once("python.data_loader")
 
         if num_workers < 0:
@@ -136,6 +144,8 @@ class DataLoader(object):
         self.timeout = timeout
         self.worker_init_fn = worker_init_fn
         self.multiprocessing_context = multiprocessing_context
+        # Single-process loading has no worker-to-main handoff to speed up.
+        self.shm_transport = shm_transport and num_workers > 0
 
         # Arg-check dataset related before checking samplers because we want to
         # tell users that iterable-style datasets are incompatible with custom
@@ -693,6 +703,19 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
         self._tasks_outstanding = 0  # always equal to count(v for v in task_info.values() if len(v) == 1)
         self._workers_done_event = multiprocessing_context.Event()
 
+        if loader.shm_transport:
+            # One ring per worker, allocated here so the arenas are shared
+            # with the workers by inheritance (or fd passing under spawn).
+            self._shm_rings = [
+                _utils.shm_transport.ShmRing(
+                    i,
+                    _utils.shm_transport.DEFAULT_NUM_SLOTS,
+                    _utils.shm_transport.DEFAULT_SLOT_BYTES,
+                    multiprocessing_context)
+                for i in range(self._num_workers)]
+        else:
+            self._shm_rings = None
+
         self._index_queues = []
         self._workers = []
         # A list of booleans representing whether each worker still has work to
@@ -708,7 +731,8 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
                 args=(self._dataset_kind, self._dataset, index_queue,
                       self._worker_result_queue, self._workers_done_event,
                       self._auto_collation, self._collate_fn, self._drop_last,
-                      self._base_seed + i, self._worker_init_fn, i, self._num_workers))
+                      self._base_seed + i, self._worker_init_fn, i, self._num_workers,
+                      self._shm_rings[i] if self._shm_rings is not None else None))
             w.daemon = True
             # NB: Process.start() actually take some time as it needs to
             #     start a process and pass the arguments over via a pipe.
@@ -728,7 +752,8 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
                 target=_utils.pin_memory._pin_memory_loop,
                 args=(self._worker_result_queue, self._data_queue,
                       torch.cuda.current_device(),
-                      self._pin_memory_thread_done_event))
+                      self._pin_memory_thread_done_event,
+                      self._shm_rings))
             pin_memory_thread.daemon = True
             pin_memory_thread.start()
             # Similar to workers (see comment above), we only register
@@ -759,6 +784,12 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
         #   (bool: whether successfully get data, any: data if successful else None)
         try:
             data = self._data_queue.get(timeout=timeout)
+            if self._shm_rings is not None and isinstance(
+                    data[1], _utils.shm_transport._ShmBatch):
+                # Without pin_memory this is the first point in the main
+                # process that sees the message; rebuild the batch over the
+                # ring slot (with pin_memory the pin thread already did).
+                data = (data[0], self._shm_rings[data[1].worker_id].wrap(data[1]))
             return (True, data)
         except Exception as e:
             # At timeout and error, we manually check whether any worker has
@@ -150,3 +150,26 @@ def to_mkldnn(module):
         return new_m
 
     return m_fn_rec(module)
+
+
+def prewarm(module, sample_input, batch_sizes):
+    r"""Pre-create MKL-DNN primitives for a set of expected batch sizes.
+
+    MKL-DNN creates (and caches) one primitive per input shape, so the first
+    call at each batch size pays the primitive creation cost. For
+    latency-sensitive serving with dynamic batch sizes, run this once at
+    startup to move that cost out of the request path.
+
+    `sample_input` is an example input for `module` whose first dimension is
+    the batch dimension; a forward pass is run for every size in
+    `batch_sizes`.
+    """
+    with torch.no_grad():
+        for batch_size in batch_sizes:
+            shape = list(sample_input.shape)
+            shape[0] = batch_size
+            if sample_input.is_mkldnn:
+                x = torch.zeros(shape, dtype=sample_input.dtype).to_mkldnn()
+            else:
+                x = sample_input.new_zeros(shape)
+            module(x)